@@ -134,9 +134,10 @@ cal_version(const uint64_t major, const uint64_t minor, const uint64_t major_pat
 #define CLUSTER_VERSION_4_3_2_1 (oceanbase::common::cal_version(4, 3, 2, 1))
 #define CLUSTER_VERSION_4_3_3_0 (oceanbase::common::cal_version(4, 3, 3, 0))
 #define CLUSTER_VERSION_4_3_4_0 (oceanbase::common::cal_version(4, 3, 4, 0))
+#define CLUSTER_VERSION_4_3_5_0 (oceanbase::common::cal_version(4, 3, 5, 0))
 //!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!!
 //TODO: If you update the above version, please update CLUSTER_CURRENT_VERSION.
-#define CLUSTER_CURRENT_VERSION CLUSTER_VERSION_4_3_4_0
+#define CLUSTER_CURRENT_VERSION CLUSTER_VERSION_4_3_5_0
 
 // ATTENSION !!!!!!!!!!!!!!!!!!!!!!!!!!!
 // 1. After 4.0, each cluster_version is corresponed to a data version.
@@ -170,7 +171,8 @@ cal_version(const uint64_t major, const uint64_t minor, const uint64_t major_pat
 #define DATA_VERSION_4_3_2_1 (oceanbase::common::cal_version(4, 3, 2, 1))
 #define DATA_VERSION_4_3_3_0 (oceanbase::common::cal_version(4, 3, 3, 0))
 #define DATA_VERSION_4_3_4_0 (oceanbase::common::cal_version(4, 3, 4, 0))
-#define DATA_CURRENT_VERSION DATA_VERSION_4_3_4_0
+#define DATA_VERSION_4_3_5_0 (oceanbase::common::cal_version(4, 3, 5, 0))
+#define DATA_CURRENT_VERSION DATA_VERSION_4_3_5_0
 // ATTENSION !!!!!!!!!!!!!!!!!!!!!!!!!!!
 // LAST_BARRIER_DATA_VERSION should be the latest barrier data version before DATA_CURRENT_VERSION
 #define LAST_BARRIER_DATA_VERSION DATA_VERSION_4_2_1_0
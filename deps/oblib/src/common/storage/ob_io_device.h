@@ -182,7 +182,8 @@ private:
 enum ObIOCBType : uint8_t
 {
   IOCB_TYPE_LOCAL = 0,
-  IOCB_TYPE_LOCAL_CACHE = 1
+  IOCB_TYPE_LOCAL_CACHE = 1,
+  IOCB_TYPE_LOCAL_URING = 2
 };
 
 class ObIOCB
@@ -198,7 +199,8 @@ public:
 enum ObIOContextType : uint8_t
 {
   IO_CONTEXT_TYPE_LOCAL = 0,
-  IO_CONTEXT_TYPE_LOCAL_CACHE = 1
+  IO_CONTEXT_TYPE_LOCAL_CACHE = 1,
+  IO_CONTEXT_TYPE_LOCAL_URING = 2
 };
 
 class ObIOContext
@@ -212,7 +214,8 @@ public:
 enum ObIOEventsType : uint8_t
 {
   IO_EVENTS_TYPE_LOCAL = 0,
-  IO_EVENTS_TYPE_LOCAL_CACHE = 1
+  IO_EVENTS_TYPE_LOCAL_CACHE = 1,
+  IO_EVENTS_TYPE_LOCAL_URING = 2
 };
 
 class ObIOEvents
@@ -15,6 +15,9 @@
 #include "lib/ob_define.h"
 #include "isa-l/crc64.h"
 #include "isa-l/crc.h"
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#endif
 
 namespace oceanbase
 {
@@ -1155,6 +1158,145 @@ uint64_t crc64_sse42_dispatch(uint64_t crc, const char *buf, int64_t len)
 
 ObCRC64Func ob_crc64_sse42_func = &crc64_sse42_dispatch;
 
+/*
+ * A single crc32 instruction has a latency of 3 cycles but a throughput of 1 per cycle, so the
+ * checksum of one small buffer is bounded by the dependency chain of its crc register. The batch
+ * interface below feeds the words of CRC64_BATCH_LANE_NUM independent buffers in lockstep to keep
+ * the crc unit busy. Large buffers are left to ob_crc64_sse42, which already folds several streams
+ * of one buffer with PCLMULQDQ when ISA-L is used.
+ */
+static const int64_t CRC64_BATCH_LANE_NUM = 4;
+static const int64_t CRC64_BATCH_MAX_INTERLEAVE_SIZE = 4096;
+
+#if defined(__x86_64__)
+#define CRC64_BATCH_FUNCTION_ATTRIBUTE __attribute__((target("sse4.2")))
+#define CRC64_BATCH_U64(crc, v) _mm_crc32_u64(crc, v)
+#define CRC64_BATCH_U32(crc, v) _mm_crc32_u32(static_cast<uint32_t>(crc), v)
+#define CRC64_BATCH_U8(crc, v) _mm_crc32_u8(static_cast<uint32_t>(crc), v)
+#elif defined(__aarch64__)
+#define CRC64_BATCH_FUNCTION_ATTRIBUTE
+#define CRC64_BATCH_U64(crc, v) __crc32cd(static_cast<uint32_t>(crc), v)
+#define CRC64_BATCH_U32(crc, v) __crc32cw(static_cast<uint32_t>(crc), v)
+#define CRC64_BATCH_U8(crc, v) __crc32cb(static_cast<uint32_t>(crc), v)
+#endif
+
+static bool crc64_batch_interleave_supported()
+{
+  bool bret = false;
+#if defined(__x86_64__)
+  uint32_t a = 0;
+  uint32_t b = 0;
+  uint32_t c = 0;
+  uint32_t d = 0;
+  asm("cpuid" : "=a"(a), "=b"(b), "=c"(c), "=d"(d) : "0"(1));
+  bret = (c & (1 << 20)) != 0;
+#elif defined(__aarch64__)
+  bret = true;
+#endif
+  return bret;
+}
+
+#if defined(__x86_64__) || defined(__aarch64__)
+CRC64_BATCH_FUNCTION_ATTRIBUTE static inline uint64_t crc64_batch_tail(uint64_t crc, const char *buf, int64_t len)
+{
+  uint64_t word = 0;
+  uint32_t half_word = 0;
+  while (len >= 8) {
+    MEMCPY(&word, buf, sizeof(word));
+    crc = CRC64_BATCH_U64(crc, word);
+    buf += 8;
+    len -= 8;
+  }
+  if (len >= 4) {
+    MEMCPY(&half_word, buf, sizeof(half_word));
+    crc = CRC64_BATCH_U32(crc, half_word);
+    buf += 4;
+    len -= 4;
+  }
+  while (len > 0) {
+    crc = CRC64_BATCH_U8(crc, static_cast<uint8_t>(*buf));
+    ++buf;
+    --len;
+  }
+  return crc;
+}
+
+CRC64_BATCH_FUNCTION_ATTRIBUTE static void crc64_batch_interleave(
+    const char *const *bufs,
+    const int64_t *lens,
+    uint64_t *crcs)
+{
+  uint64_t crc0 = crcs[0];
+  uint64_t crc1 = crcs[1];
+  uint64_t crc2 = crcs[2];
+  uint64_t crc3 = crcs[3];
+  const int64_t common_len = std::min(std::min(lens[0], lens[1]), std::min(lens[2], lens[3])) & ~7L;
+  uint64_t word0 = 0;
+  uint64_t word1 = 0;
+  uint64_t word2 = 0;
+  uint64_t word3 = 0;
+  for (int64_t pos = 0; pos < common_len; pos += 8) {
+    MEMCPY(&word0, bufs[0] + pos, sizeof(uint64_t));
+    MEMCPY(&word1, bufs[1] + pos, sizeof(uint64_t));
+    MEMCPY(&word2, bufs[2] + pos, sizeof(uint64_t));
+    MEMCPY(&word3, bufs[3] + pos, sizeof(uint64_t));
+    crc0 = CRC64_BATCH_U64(crc0, word0);
+    crc1 = CRC64_BATCH_U64(crc1, word1);
+    crc2 = CRC64_BATCH_U64(crc2, word2);
+    crc3 = CRC64_BATCH_U64(crc3, word3);
+  }
+  crcs[0] = crc64_batch_tail(crc0, bufs[0] + common_len, lens[0] - common_len);
+  crcs[1] = crc64_batch_tail(crc1, bufs[1] + common_len, lens[1] - common_len);
+  crcs[2] = crc64_batch_tail(crc2, bufs[2] + common_len, lens[2] - common_len);
+  crcs[3] = crc64_batch_tail(crc3, bufs[3] + common_len, lens[3] - common_len);
+}
+#endif
+
+void ob_crc64_sse42_batch(
+    const int64_t count,
+    const char *const *bufs,
+    const int64_t *lens,
+    uint64_t *crcs)
+{
+  static const bool interleave_supported = crc64_batch_interleave_supported();
+  if (count <= 0 || NULL == bufs || NULL == lens || NULL == crcs) {
+  } else if (!interleave_supported) {
+    for (int64_t i = 0; i < count; ++i) {
+      crcs[i] = ob_crc64_sse42(crcs[i], bufs[i], lens[i]);
+    }
+  } else {
+#if defined(__x86_64__) || defined(__aarch64__)
+    const char *lane_bufs[CRC64_BATCH_LANE_NUM];
+    int64_t lane_lens[CRC64_BATCH_LANE_NUM];
+    uint64_t lane_crcs[CRC64_BATCH_LANE_NUM];
+    int64_t lane_idxs[CRC64_BATCH_LANE_NUM];
+    int64_t lane_cnt = 0;
+    for (int64_t i = 0; i < count; ++i) {
+      if (NULL == bufs[i] || lens[i] <= 0) {
+        // keep the crc unchanged, the same as ob_crc64_sse42
+      } else if (lens[i] >= CRC64_BATCH_MAX_INTERLEAVE_SIZE) {
+        crcs[i] = ob_crc64_sse42(crcs[i], bufs[i], lens[i]);
+      } else {
+        lane_bufs[lane_cnt] = bufs[i];
+        lane_lens[lane_cnt] = lens[i];
+        lane_crcs[lane_cnt] = crcs[i];
+        lane_idxs[lane_cnt] = i;
+        if (CRC64_BATCH_LANE_NUM == ++lane_cnt) {
+          crc64_batch_interleave(lane_bufs, lane_lens, lane_crcs);
+          for (int64_t j = 0; j < CRC64_BATCH_LANE_NUM; ++j) {
+            crcs[lane_idxs[j]] = lane_crcs[j];
+          }
+          lane_cnt = 0;
+        }
+      }
+    }
+    for (int64_t j = 0; j < lane_cnt; ++j) {
+      crcs[lane_idxs[j]] = crc64_batch_tail(lane_crcs[j], lane_bufs[j], lane_lens[j]);
+    }
+#endif
+  }
+}
+
 OB_DEF_SERIALIZE(ObBatchChecksum)
 {
   int ret = OB_SUCCESS;
@@ -68,6 +68,17 @@ inline uint64_t ob_crc64_sse42(const void *pv, int64_t cb)
   return (*ob_crc64_sse42_func)(0, static_cast<const char *>(pv), cb);
 }
 
+/**
+  * Calculate CRC64 with CPU instructions for a batch of independent memory blocks.
+  * The result of each block is the same as ob_crc64_sse42(crcs[i], bufs[i], lens[i]).
+  *
+  * @param   count   Number of memory blocks.
+  * @param   bufs    Pointers to the memory blocks.
+  * @param   lens    Sizes of the memory blocks in bytes.
+  * @param   crcs    Intermediate CRC64 values as input, CRC64 values of the memory blocks as output.
+  */
+void ob_crc64_sse42_batch(const int64_t count, const char *const *bufs, const int64_t *lens, uint64_t *crcs);
+
 uint64_t ob_crc64_isal(uint64_t uCRC64, const char* buf, int64_t cb);
 uint64_t crc64_sse42(uint64_t uCRC64, const char* buf, int64_t len);
 uint64_t crc64_sse42_manually(uint64_t crc, const char *buf, int64_t len);
@@ -34,6 +34,7 @@ enum ObCompressorType : uint8_t
   STREAM_ZSTD_COMPRESSOR         = 9,//used for clog rpc compress
   STREAM_ZSTD_1_3_8_COMPRESSOR   = 10,//used for clog rpc compress
   ZLIB_LITE_COMPRESSOR           = 11,//Composed of qpl+zlib
+  ZSTD_1_3_8_DICT_COMPRESSOR     = 12,//zstd_1.3.8 referencing a neighbour micro block as dictionary
 
   MAX_COMPRESSOR
 };
@@ -52,6 +53,7 @@ const char *const all_compressor_name[] =
   "stream_zstd_1.0",
   "stream_zstd_1.3.8",
   "zlib_lite_1.0",
+  "zstd_dict_1.3.8",
 };
 
 STATIC_ASSERT(ARRAYSIZEOF(all_compressor_name) == ObCompressorType::MAX_COMPRESSOR, "compressor count mismatch");
@@ -68,6 +70,7 @@ const char *const compress_funcs[] =
   "zstd_1.3.8",
   "lz4_1.9.1",
   "zlib_lite_1.0",
+  "zstd_dict_1.3.8",
 };
 
 const char *const perf_compress_funcs[] =
@@ -25,6 +25,7 @@ ObCompressorPool::ObCompressorPool()
      zlib_compressor(),
      zstd_compressor(allocator_),
      zstd_compressor_1_3_8(allocator_),
+     zstd_dict_compressor_1_3_8(allocator_),
      zlib_lite_compressor(),
      lz4_stream_compressor(),
      zstd_stream_compressor(allocator_),
@@ -84,6 +85,9 @@ int ObCompressorPool::get_compressor(const ObCompressorType &compressor_type,
     case ZLIB_LITE_COMPRESSOR:
       compressor = &zlib_lite_compressor;
       break;
+    case ZSTD_1_3_8_DICT_COMPRESSOR:
+      compressor = &zstd_dict_compressor_1_3_8;
+      break;
     default:
       compressor = NULL;
       ret = OB_NOT_SUPPORTED;
@@ -121,6 +125,8 @@ int ObCompressorPool::get_compressor_type(const char *compressor_name,
     compressor_type = STREAM_ZSTD_1_3_8_COMPRESSOR;
   } else if (!strcmp(compressor_name, "zlib_lite_1.0")) {
     compressor_type = ZLIB_LITE_COMPRESSOR;
+  } else if (!STRCASECMP(compressor_name, "zstd_dict_1.3.8")) {
+    compressor_type = ZSTD_1_3_8_DICT_COMPRESSOR;
   }
   else {
     ret = OB_NOT_SUPPORTED;
@@ -195,6 +201,7 @@ int ObCompressorPool::get_max_overflow_size(const int64_t src_data_size, int64_t
   int64_t zlib_overflow_size = 0;
   int64_t zstd_overflow_size = 0;
   int64_t zstd_138_overflow_size = 0;
+  int64_t zstd_dict_138_overflow_size = 0;
   int64_t zlib_lite_overflow_size = 0;
 
   if (OB_FAIL(lz4_compressor.get_max_overflow_size(src_data_size, lz4_overflow_size))) {
@@ -209,6 +216,8 @@ int ObCompressorPool::get_max_overflow_size(const int64_t src_data_size, int64_t
       LIB_LOG(WARN, "failed to get_max_overflow_size of zstd", K(ret), K(src_data_size));
   } else if (OB_FAIL(zstd_compressor_1_3_8.get_max_overflow_size(src_data_size, zstd_138_overflow_size))) {
     LIB_LOG(WARN, "failed to get_max_overflow_size of zstd_138", K(ret), K(src_data_size));
+  } else if (OB_FAIL(zstd_dict_compressor_1_3_8.get_max_overflow_size(src_data_size, zstd_dict_138_overflow_size))) {
+    LIB_LOG(WARN, "failed to get_max_overflow_size of zstd_dict_138", K(ret), K(src_data_size));
   } else if (OB_FAIL(zlib_lite_compressor.get_max_overflow_size(src_data_size, zlib_lite_overflow_size))) {
     LIB_LOG(WARN, "failed to get_max_overflow_size of zlib_lite", K(ret), K(src_data_size));
   }
@@ -218,6 +227,7 @@ int ObCompressorPool::get_max_overflow_size(const int64_t src_data_size, int64_t
     max_overflow_size = std::max(max_overflow_size, zlib_overflow_size);
     max_overflow_size = std::max(max_overflow_size, zstd_overflow_size);
     max_overflow_size = std::max(max_overflow_size, zstd_138_overflow_size);
+    max_overflow_size = std::max(max_overflow_size, zstd_dict_138_overflow_size);
     max_overflow_size = std::max(max_overflow_size, zlib_lite_overflow_size);
   }
   return ret;
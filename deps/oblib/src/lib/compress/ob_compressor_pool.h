@@ -24,6 +24,7 @@
 #include "zstd/ob_zstd_compressor.h"
 #include "zstd/ob_zstd_stream_compressor.h"
 #include "zstd_1_3_8/ob_zstd_compressor_1_3_8.h"
+#include "zstd_1_3_8/ob_zstd_dict_compressor_1_3_8.h"
 #include "zstd_1_3_8/ob_zstd_stream_compressor_1_3_8.h"
 #include "zlib_lite/ob_zlib_lite_compressor.h"
 
@@ -71,6 +72,7 @@ private:
   ObZlibCompressor zlib_compressor;
   zstd::ObZstdCompressor zstd_compressor;
   zstd_1_3_8::ObZstdCompressor_1_3_8 zstd_compressor_1_3_8;
+  zstd_1_3_8::ObZstdDictCompressor_1_3_8 zstd_dict_compressor_1_3_8;
   ZLIB_LITE::ObZlibLiteCompressor zlib_lite_compressor;
 
   //stream compressor
@@ -0,0 +1,211 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "ob_zstd_dict_compressor_1_3_8.h"
+
+#include "lib/ob_errno.h"
+#include "lib/oblog/ob_log_module.h"
+#include "ob_zstd_wrapper.h"
+
+using namespace oceanbase;
+using namespace common;
+using namespace zstd_1_3_8;
+
+/**
+ * ----------------------------ObZstdCompressDict---------------------------
+ */
+ObZstdCompressDict_1_3_8::ObZstdCompressDict_1_3_8(ObIAllocator &allocator)
+  : allocator_(allocator),
+    cdict_(nullptr),
+    dict_size_(0)
+{
+}
+
+ObZstdCompressDict_1_3_8::~ObZstdCompressDict_1_3_8()
+{
+  reset();
+}
+
+int ObZstdCompressDict_1_3_8::init(const char *dict_buf, const int64_t dict_size)
+{
+  int ret = OB_SUCCESS;
+  OB_ZSTD_customMem zstd_mem = {ob_zstd_malloc, ob_zstd_free, &allocator_};
+  reset();
+  if (OB_ISNULL(dict_buf) || OB_UNLIKELY(dict_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LIB_LOG(WARN, "invalid dict argument", K(ret), KP(dict_buf), K(dict_size));
+  } else if (OB_FAIL(ObZstdWrapper::create_cdict(zstd_mem, dict_buf, static_cast<size_t>(dict_size), cdict_))) {
+    LIB_LOG(WARN, "failed to create zstd cdict", K(ret), K(dict_size));
+  } else {
+    dict_size_ = dict_size;
+  }
+  return ret;
+}
+
+void ObZstdCompressDict_1_3_8::reset()
+{
+  if (nullptr != cdict_) {
+    ObZstdWrapper::free_cdict(cdict_);
+    cdict_ = nullptr;
+  }
+  dict_size_ = 0;
+}
+
+/**
+ * ----------------------------ObZstdDictCompressor---------------------------
+ */
+int ObZstdDictCompressor_1_3_8::compress(const char *src_buffer,
+                                         const int64_t src_data_size,
+                                         char *dst_buffer,
+                                         const int64_t dst_buffer_size,
+                                         int64_t &dst_data_size)
+{
+  return compress(src_buffer, src_data_size, dst_buffer, dst_buffer_size, dst_data_size, nullptr);
+}
+
+int ObZstdDictCompressor_1_3_8::decompress(const char *src_buffer,
+                                           const int64_t src_data_size,
+                                           char *dst_buffer,
+                                           const int64_t dst_buffer_size,
+                                           int64_t &dst_data_size)
+{
+  return decompress(src_buffer, src_data_size, dst_buffer, dst_buffer_size, dst_data_size, nullptr, 0);
+}
+
+int ObZstdDictCompressor_1_3_8::compress(const char *src_buffer,
+                                         const int64_t src_data_size,
+                                         char *dst_buffer,
+                                         const int64_t dst_buffer_size,
+                                         int64_t &dst_data_size,
+                                         const ObZstdCompressDict_1_3_8 *dict)
+{
+  int ret = OB_SUCCESS;
+  int64_t max_overflow_size = 0;
+  size_t compress_ret_size = 0;
+  OB_ZSTD_customMem zstd_mem = {ob_zstd_malloc, ob_zstd_free, &allocator_};
+  const bool use_dict = nullptr != dict && dict->is_valid();
+  dst_data_size = 0;
+
+  if (NULL == src_buffer
+      || 0 >= src_data_size
+      || NULL == dst_buffer
+      || 0 >= dst_buffer_size) {
+    ret = OB_INVALID_ARGUMENT;
+    LIB_LOG(WARN, "invalid compress argument, ",
+        K(ret), KP(src_buffer), K(src_data_size), KP(dst_buffer), K(dst_buffer_size));
+  } else if (OB_FAIL(get_max_overflow_size(src_data_size, max_overflow_size))) {
+    LIB_LOG(WARN, "fail to get max_overflow_size, ", K(ret), K(src_data_size));
+  } else if ((src_data_size + max_overflow_size) > dst_buffer_size) {
+    ret = OB_BUF_NOT_ENOUGH;
+    LIB_LOG(WARN, "dst buffer not enough, ",
+        K(ret), K(src_data_size), K(max_overflow_size), K(dst_buffer_size));
+  } else if (use_dict && OB_FAIL(ObZstdWrapper::compress_using_cdict(zstd_mem,
+                                                                    dict->get_cdict(),
+                                                                    src_buffer,
+                                                                    static_cast<size_t>(src_data_size),
+                                                                    dst_buffer + FRAME_FLAG_SIZE,
+                                                                    static_cast<size_t>(dst_buffer_size - FRAME_FLAG_SIZE),
+                                                                    compress_ret_size))) {
+    LIB_LOG(WARN, "failed to compress zstd with dict", K(ret), K(compress_ret_size), KPC(dict),
+        KP(src_buffer), K(src_data_size), KP(dst_buffer), K(dst_buffer_size));
+  } else if (!use_dict && OB_FAIL(ObZstdWrapper::compress(zstd_mem,
+                                                         src_buffer,
+                                                         static_cast<size_t>(src_data_size),
+                                                         dst_buffer + FRAME_FLAG_SIZE,
+                                                         static_cast<size_t>(dst_buffer_size - FRAME_FLAG_SIZE),
+                                                         compress_ret_size))) {
+    LIB_LOG(WARN, "failed to compress zstd", K(ret), K(compress_ret_size),
+        KP(src_buffer), K(src_data_size), KP(dst_buffer), K(dst_buffer_size));
+  } else {
+    dst_buffer[0] = static_cast<char>(use_dict ? FRAME_WITH_DICT : FRAME_WITHOUT_DICT);
+    dst_data_size = compress_ret_size + FRAME_FLAG_SIZE;
+  }
+
+  return ret;
+}
+
+int ObZstdDictCompressor_1_3_8::decompress(const char *src_buffer,
+                                           const int64_t src_data_size,
+                                           char *dst_buffer,
+                                           const int64_t dst_buffer_size,
+                                           int64_t &dst_data_size,
+                                           const char *dict_buf,
+                                           const int64_t dict_size)
+{
+  int ret = OB_SUCCESS;
+  size_t decompress_ret_size = 0;
+  OB_ZSTD_customMem zstd_mem = {ob_zstd_malloc, ob_zstd_free, &allocator_};
+  dst_data_size = 0;
+
+  if (NULL == src_buffer
+      || FRAME_FLAG_SIZE >= src_data_size
+      || NULL == dst_buffer
+      || 0 >= dst_buffer_size) {
+    ret = OB_INVALID_ARGUMENT;
+    LIB_LOG(WARN, "invalid decompress argument, ",
+        K(ret), KP(src_buffer), K(src_data_size), KP(dst_buffer), K(dst_buffer_size));
+  } else if (FRAME_WITHOUT_DICT == static_cast<uint8_t>(src_buffer[0])) {
+    if (OB_FAIL(ObZstdWrapper::decompress(zstd_mem,
+                                          src_buffer + FRAME_FLAG_SIZE,
+                                          src_data_size - FRAME_FLAG_SIZE,
+                                          dst_buffer,
+                                          dst_buffer_size,
+                                          decompress_ret_size))) {
+      LIB_LOG(WARN, "failed to decompress zstd", K(ret), K(decompress_ret_size),
+          KP(src_buffer), K(src_data_size), KP(dst_buffer), K(dst_buffer_size));
+    }
+  } else if (OB_UNLIKELY(FRAME_WITH_DICT != static_cast<uint8_t>(src_buffer[0]))) {
+    ret = OB_ERR_COMPRESS_DECOMPRESS_DATA;
+    LIB_LOG(WARN, "unexpected zstd dict frame flag", K(ret), "flag", static_cast<uint8_t>(src_buffer[0]));
+  } else if (OB_ISNULL(dict_buf) || OB_UNLIKELY(dict_size <= 0)) {
+    ret = OB_ERR_COMPRESS_DECOMPRESS_DATA;
+    LIB_LOG(WARN, "dict is required to decompress the frame", K(ret), KP(dict_buf), K(dict_size));
+  } else if (OB_FAIL(ObZstdWrapper::decompress_using_dict(zstd_mem,
+                                                         dict_buf,
+                                                         static_cast<size_t>(dict_size),
+                                                         src_buffer + FRAME_FLAG_SIZE,
+                                                         src_data_size - FRAME_FLAG_SIZE,
+                                                         dst_buffer,
+                                                         dst_buffer_size,
+                                                         decompress_ret_size))) {
+    LIB_LOG(WARN, "failed to decompress zstd with dict", K(ret), K(decompress_ret_size), K(dict_size),
+        KP(src_buffer), K(src_data_size), KP(dst_buffer), K(dst_buffer_size));
+  }
+
+  if (OB_SUCC(ret)) {
+    dst_data_size = decompress_ret_size;
+  }
+  return ret;
+}
+
+const char *ObZstdDictCompressor_1_3_8::get_compressor_name() const
+{
+  return all_compressor_name[ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR];
+}
+
+ObCompressorType ObZstdDictCompressor_1_3_8::get_compressor_type() const
+{
+  return ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR;
+}
+
+int ObZstdDictCompressor_1_3_8::get_max_overflow_size(const int64_t src_data_size,
+                                                      int64_t &max_overflow_size) const
+{
+  int ret = OB_SUCCESS;
+  if (src_data_size < 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LIB_LOG(WARN, "invalid argument, ", K(ret), K(src_data_size));
+  } else {
+    max_overflow_size = (src_data_size >> 7) + 512 + 12 + FRAME_FLAG_SIZE;
+  }
+  return ret;
+}
@@ -0,0 +1,105 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_COMMON_COMPRESS_ZSTD_1_3_8_DICT_COMPRESSOR_
+#define OCEANBASE_COMMON_COMPRESS_ZSTD_1_3_8_DICT_COMPRESSOR_
+#include "lib/compress/ob_compressor.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+namespace zstd_1_3_8
+{
+
+// Digested raw content dictionary used by ObZstdDictCompressor_1_3_8 to compress,
+// the dictionary content is copied, so the caller's buffer can be reused after init.
+class __attribute__((visibility ("default"))) ObZstdCompressDict_1_3_8
+{
+public:
+  explicit ObZstdCompressDict_1_3_8(ObIAllocator &allocator);
+  ~ObZstdCompressDict_1_3_8();
+  int init(const char *dict_buf, const int64_t dict_size);
+  void reset();
+  inline bool is_valid() const { return nullptr != cdict_; }
+  inline const void *get_cdict() const { return cdict_; }
+  inline int64_t get_dict_size() const { return dict_size_; }
+  TO_STRING_KV(KP_(cdict), K_(dict_size));
+private:
+  ObIAllocator &allocator_;
+  void *cdict_;
+  int64_t dict_size_;
+  DISALLOW_COPY_AND_ASSIGN(ObZstdCompressDict_1_3_8);
+};
+
+/**
+ * zstd 1.3.8 compressor which can reference a raw content dictionary, e.g. a neighbour
+ * block of similar data. Every output buffer starts with one flag byte telling whether the
+ * zstd frame after it references a dictionary. Frames compressed without dictionary can
+ * always be decompressed alone, the caller must give the same dictionary content to
+ * decompress a frame compressed with one.
+ */
+class __attribute__((visibility ("default"))) ObZstdDictCompressor_1_3_8 : public ObCompressor
+{
+public:
+  enum FrameFlag : uint8_t
+  {
+    FRAME_WITHOUT_DICT = 0,
+    FRAME_WITH_DICT = 1,
+  };
+  static const int64_t FRAME_FLAG_SIZE = sizeof(uint8_t);
+public:
+  explicit ObZstdDictCompressor_1_3_8(ObIAllocator &allocator)
+    : allocator_(allocator) {}
+  virtual ~ObZstdDictCompressor_1_3_8() {}
+  int compress(const char *src_buffer,
+               const int64_t src_data_size,
+               char *dst_buffer,
+               const int64_t dst_buffer_size,
+               int64_t &dst_data_size) override;
+  int decompress(const char *src_buffer,
+                 const int64_t src_data_size,
+                 char *dst_buffer,
+                 const int64_t dst_buffer_size,
+                 int64_t &dst_data_size) override;
+  // @dict can be null or invalid, then the frame is compressed without dictionary
+  int compress(const char *src_buffer,
+               const int64_t src_data_size,
+               char *dst_buffer,
+               const int64_t dst_buffer_size,
+               int64_t &dst_data_size,
+               const ObZstdCompressDict_1_3_8 *dict);
+  // @dict_buf can be null if the frame is known to be compressed without dictionary
+  int decompress(const char *src_buffer,
+                 const int64_t src_data_size,
+                 char *dst_buffer,
+                 const int64_t dst_buffer_size,
+                 int64_t &dst_data_size,
+                 const char *dict_buf,
+                 const int64_t dict_size);
+  static bool is_dict_frame(const char *buf, const int64_t size)
+  {
+    return nullptr != buf && size > FRAME_FLAG_SIZE && FRAME_WITH_DICT == static_cast<uint8_t>(buf[0]);
+  }
+  const char *get_compressor_name() const;
+  ObCompressorType get_compressor_type() const;
+  int get_max_overflow_size(const int64_t src_data_size,
+                            int64_t &max_overflow_size) const;
+private:
+  ObIAllocator &allocator_;
+};
+} // namespace zstd_1_3_8
+} //namespace common
+} //namespace oceanbase
+#endif //OCEANBASE_COMMON_COMPRESS_ZSTD_1_3_8_DICT_COMPRESSOR_
@@ -296,3 +296,136 @@ int ObZstdWrapper::decompress_stream(void *ctx, const char *src, const size_t sr
   }
   return ret;
 }
+
+int ObZstdWrapper::create_cdict(OB_ZSTD_customMem &ob_zstd_mem, const void *dict, const size_t dict_size, void *&cdict)
+{
+  int ret = OB_SUCCESS;
+  ZSTD_CDict *zstd_cdict = NULL;
+  ZSTD_customMem zstd_mem;
+  zstd_mem.customAlloc = ob_zstd_mem.customAlloc;
+  zstd_mem.customFree = ob_zstd_mem.customFree;
+  zstd_mem.opaque = ob_zstd_mem.opaque;
+  cdict = NULL;
+
+  if (NULL == dict || 0 >= dict_size) {
+    ret = OB_INVALID_ARGUMENT;
+  } else if (NULL == (zstd_cdict = ZSTD_createCDict_advanced(dict,
+                                                             dict_size,
+                                                             ZSTD_dlm_byCopy,
+                                                             ZSTD_dct_rawContent,
+                                                             ZSTD_getCParams(OB_ZSTD_COMPRESS_LEVEL, 0, dict_size),
+                                                             zstd_mem))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else {
+    cdict = zstd_cdict;
+  }
+  return ret;
+}
+
+void ObZstdWrapper::free_cdict(void *&cdict)
+{
+  ZSTD_CDict *zstd_cdict = static_cast<ZSTD_CDict *>(cdict);
+  ZSTD_freeCDict(zstd_cdict);
+  cdict = NULL;
+}
+
+int ObZstdWrapper::compress_using_cdict(
+    OB_ZSTD_customMem &ob_zstd_mem,
+    const void *cdict,
+    const char *src_buffer,
+    const size_t src_data_size,
+    char *dst_buffer,
+    const size_t dst_buffer_size,
+    size_t &compress_ret_size)
+{
+  int ret = OB_SUCCESS;
+  ZSTD_CCtx *zstd_cctx = NULL;
+  ZSTD_customMem zstd_mem;
+  zstd_mem.customAlloc = ob_zstd_mem.customAlloc;
+  zstd_mem.customFree = ob_zstd_mem.customFree;
+  zstd_mem.opaque = ob_zstd_mem.opaque;
+
+  if (NULL == cdict
+      || NULL == src_buffer
+      || 0 >= src_data_size
+      || NULL == dst_buffer
+      || 0 >= dst_buffer_size) {
+    ret = OB_INVALID_ARGUMENT;
+  } else if (NULL == (zstd_cctx = ZSTD_createCCtx_advanced(zstd_mem))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else {
+    compress_ret_size = ZSTD_compress_usingCDict(zstd_cctx,
+                                                 dst_buffer,
+                                                 dst_buffer_size,
+                                                 src_buffer,
+                                                 src_data_size,
+                                                 static_cast<const ZSTD_CDict *>(cdict));
+    if (0 != ZSTD_isError(compress_ret_size)) {
+      ret = OB_ERR_COMPRESS_DECOMPRESS_DATA;
+    }
+  }
+
+  if (NULL != zstd_cctx) {
+    ZSTD_freeCCtx(zstd_cctx);
+    zstd_cctx = NULL;
+  }
+  return ret;
+}
+
+int ObZstdWrapper::decompress_using_dict(
+    OB_ZSTD_customMem &ob_zstd_mem,
+    const void *dict,
+    const size_t dict_size,
+    const char *src_buffer,
+    const size_t src_data_size,
+    char *dst_buffer,
+    const size_t dst_buffer_size,
+    size_t &dst_data_size)
+{
+  int ret = OB_SUCCESS;
+  ZSTD_DCtx *zstd_dctx = NULL;
+  ZSTD_DDict *zstd_ddict = NULL;
+  ZSTD_customMem zstd_mem;
+  zstd_mem.customAlloc = ob_zstd_mem.customAlloc;
+  zstd_mem.customFree = ob_zstd_mem.customFree;
+  zstd_mem.opaque = ob_zstd_mem.opaque;
+  dst_data_size = 0;
+
+  if (NULL == dict
+      || 0 >= dict_size
+      || NULL == src_buffer
+      || 0 >= src_data_size
+      || NULL == dst_buffer
+      || 0 >= dst_buffer_size) {
+    ret = OB_INVALID_ARGUMENT;
+  } else if (NULL == (zstd_dctx = ZSTD_createDCtx_advanced(zstd_mem))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else if (NULL == (zstd_ddict = ZSTD_createDDict_advanced(dict,
+                                                             dict_size,
+                                                             ZSTD_dlm_byRef,
+                                                             ZSTD_dct_rawContent,
+                                                             zstd_mem))) {
+    // referenced raw content ddict only keeps the dict pointer, creating it is cheap
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else {
+    dst_data_size = ZSTD_decompress_usingDDict(zstd_dctx,
+                                               dst_buffer,
+                                               dst_buffer_size,
+                                               src_buffer,
+                                               src_data_size,
+                                               zstd_ddict);
+    if (0 != ZSTD_isError(dst_data_size)) {
+      ret = OB_ERR_COMPRESS_DECOMPRESS_DATA;
+    }
+  }
+
+  if (NULL != zstd_ddict) {
+    ZSTD_freeDDict(zstd_ddict);
+    zstd_ddict = NULL;
+  }
+  if (NULL != zstd_dctx) {
+    ZSTD_freeDCtx(zstd_dctx);
+    zstd_dctx = NULL;
+  }
+  return ret;
+}
@@ -65,6 +65,27 @@ public:
   static void free_stream_dctx(void *&ctx);
   static int decompress_stream(void *ctx, const char *src, const size_t src_size, size_t &consumed_size,
                                   char *dest, const size_t dest_capacity, size_t &decompressed_size);
+
+  // for raw content dictionary
+  static int create_cdict(OB_ZSTD_customMem &ob_zstd_mem, const void *dict, const size_t dict_size, void *&cdict);
+  static void free_cdict(void *&cdict);
+  static int compress_using_cdict(
+      OB_ZSTD_customMem &zstd_mem,
+      const void *cdict,
+      const char *src_buffer,
+      const size_t src_data_size,
+      char *dst_buffer,
+      const size_t dst_buffer_size,
+      size_t &compress_ret_size);
+  static int decompress_using_dict(
+      OB_ZSTD_customMem &zstd_mem,
+      const void *dict,
+      const size_t dict_size,
+      const char *src_buffer,
+      const size_t src_data_size,
+      char *dst_buffer,
+      const size_t dst_buffer_size,
+      size_t &dst_data_size);
 };
 
 #undef OB_PUBLIC_API
@@ -51,6 +51,10 @@ public:
   // query immediately.
   virtual bool need_retry() const { return false; }
   virtual void resume() {}
+  // The longest time a blocking wait may hold this worker. A wait beyond
+  // it should give up and let the scheduler reprocess the request by retry,
+  // so that the worker can serve other requests in the meantime.
+  virtual int64_t get_yield_wait_us() const { return INT64_MAX; }
 
   // This function is called before worker waiting for some resources
   // and starting to give cpu out so that Multi-Tenancy would be aware
@@ -76,7 +80,7 @@ public:
 
   void set_req_flag(const rpc::ObRequest *cur_request) { cur_request_ = cur_request; }
   bool has_req_flag() { return OB_NOT_NULL(cur_request_); }
-  const rpc::ObRequest *get_cur_request() { return cur_request_; }
+  const rpc::ObRequest *get_cur_request() const { return cur_request_; }
   OB_INLINE void set_worker_level(const int32_t level) { worker_level_ = level; }
   OB_INLINE int32_t get_worker_level() const { return worker_level_; }
 
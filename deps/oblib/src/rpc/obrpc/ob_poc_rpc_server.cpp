@@ -343,6 +343,15 @@ int ObPocRpcServer::update_tcp_keepalive_params(int64_t user_timeout) {
   return ret;
 }
 
+int ObPocRpcServer::update_zerocopy_threshold(int64_t threshold) {
+  int ret = OB_SUCCESS;
+  if (pn_set_zerocopy_threshold(threshold) != threshold) {
+    ret = OB_INVALID_ARGUMENT;
+    RPC_LOG(WARN, "invalid zerocopy threshold", K(threshold));
+  }
+  return ret;
+}
+
 int ObPocRpcServer::update_server_standby_fetch_log_bandwidth_limit(int64_t value) {
   int ret = OB_SUCCESS;
   int tmp_err = -1;
@@ -74,6 +74,7 @@ public:
   void destroy();
   bool has_start() {return has_start_;}
   int update_tcp_keepalive_params(int64_t user_timeout);
+  int update_zerocopy_threshold(int64_t threshold);
   int update_server_standby_fetch_log_bandwidth_limit(int64_t value);
   bool client_use_pkt_nio();
   int64_t get_ratelimit();
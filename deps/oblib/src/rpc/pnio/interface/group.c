@@ -51,6 +51,7 @@ static pn_listen_t pn_listen_array[MAX_PN_LISTEN];
 static pn_grp_t* pn_grp_array[MAX_PN_GRP];
 static int pn_has_listened = 0;
 int64_t pnio_keepalive_timeout;
+int64_t pnio_zerocopy_threshold;
 int64_t pnio_read_bytes;
 int64_t pnio_write_bytes;
 
@@ -66,6 +67,14 @@ PN_API int64_t pn_set_keepalive_timeout(int64_t user_timeout) {
   }
   return pnio_keepalive_timeout;
 }
+
+// writes no smaller than threshold are sent by MSG_ZEROCOPY, 0 means disabled
+PN_API int64_t pn_set_zerocopy_threshold(int64_t threshold) {
+  if (threshold >= 0) {
+    STORE(&pnio_zerocopy_threshold, threshold);
+  }
+  return LOAD(&pnio_zerocopy_threshold);
+}
 static pn_listen_t* locate_listen(int idx)
 {
   return pn_listen_array + idx;
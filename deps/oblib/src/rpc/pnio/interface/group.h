@@ -73,6 +73,7 @@ typedef struct pn_pkt_t
 } pn_pkt_t;
 
 PN_API int64_t pn_set_keepalive_timeout(int64_t user_timeout);
+PN_API int64_t pn_set_zerocopy_threshold(int64_t threshold);
 PN_API int pn_listen(int port, serve_cb_t cb);
 // if listen_id == -1,  act as client only
 // make sure grp != 0
@@ -91,6 +92,7 @@ PN_API int pn_get_fd(uint64_t req_id);
 PN_API int64_t pn_get_pkt_id(uint64_t req_id);
 PN_API int pn_terminate_pkt(uint64_t gtid, uint32_t pkt_id);
 extern int64_t pnio_keepalive_timeout;
+extern int64_t pnio_zerocopy_threshold;
 extern int64_t pnio_read_bytes;
 extern int64_t pnio_write_bytes;
 void reset_pnio_statistics(int64_t *read_bytes, int64_t *write_bytes);
@@ -19,6 +19,7 @@ struct epoll_event *__make_epoll_event(struct epoll_event *event, uint32_t event
 int eloop_init(eloop_t* ep) {
   ep->fd = epoll_create1(EPOLL_CLOEXEC);
   dlink_init(&ep->ready_link);
+  dlink_init(&ep->zc_linger_list);
   // dlink_init(&ep->rl_ready_link);
   return (ep->fd < 0)? errno: 0;
 }
@@ -63,7 +64,12 @@ static void eloop_refire(eloop_t* ep, int64_t timeout) {
   int cnt = ob_epoll_wait(ep->fd, events, maxevents, timeout);
   for(int i = 0; i < cnt; i++) {
     sock_t* s = (sock_t*)events[i].data.ptr;
-    s->mask |= events[i].events;
+    uint32_t mask = events[i].events;
+    if ((mask & EPOLLERR) && s->zc_on && 0 == sk_handle_zerocopy_notify(s)) {
+      // only zerocopy completions were queued, fire the sock to release the flushed reqs
+      mask &= ~EPOLLERR;
+    }
+    s->mask |= mask;
     rk_debug("eloop fire: %p mask=%x", s, s->mask);
     eloop_fire(ep, s);
   }
@@ -78,7 +84,17 @@ static void sock_destroy(sock_t* s) {
       rk_warn("epoll_ctl delete fd faild, s=%p, s->fd=%d, errno=%d", s, s->fd, errno);
     }
   }
-  if (s->fd >= 0) {
+  if (s->zc_on) {
+    IGNORE_RETURN sk_handle_zerocopy_notify(s);
+  }
+  if (s->fd < 0) {
+  } else if (sk_zerocopy_pending(s)) {
+    // the fd is taken over by a zc_linger_t in fty->destroy, the peer sees the connection
+    // closed after the pending data
+    if (0 != shutdown(s->fd, SHUT_RDWR)) {
+      rk_warn("shutdown sock fd faild, s=%p, s->fd=%d, errno=%d", s, s->fd, errno);
+    }
+  } else {
     err = ussl_close(s->fd);
     if (0 != err) {
       rk_warn("close sock fd faild, s=%p, s->fd=%d, errno=%d", s, s->fd, errno);
@@ -89,6 +105,31 @@ static void sock_destroy(sock_t* s) {
   }
 }
 
+#define ZC_LINGER_TIMEOUT_US (10 * 1000 * 1000)
+void eloop_zc_linger(eloop_t* ep, zc_linger_t* l) {
+  l->expire_us = rk_get_us() + ZC_LINGER_TIMEOUT_US;
+  dlink_insert(&ep->zc_linger_list, &l->link);
+}
+
+static void eloop_check_zc_linger(eloop_t* ep) {
+  int64_t cur_time_us = rk_get_us();
+  dlink_for(&ep->zc_linger_list, p) {
+    zc_linger_t* l = structof(p, zc_linger_t, link);
+    int err = sk_handle_zerocopy_notify(&l->sk);
+    if (0 == err && sk_zerocopy_pending(&l->sk) && cur_time_us < l->expire_us) {
+      // wait for the completions
+    } else {
+      if (sk_zerocopy_pending(&l->sk)) {
+        rk_warn("zerocopy sends are not completed, reset the connection: fd=%d, zc_sent=%u, zc_done=%u, err=%d",
+                l->sk.fd, l->sk.zc_sent, l->sk.zc_done, err);
+      }
+      dlink_delete(p);
+      sk_zerocopy_close(&l->sk);
+      l->release(l);
+    }
+  }
+}
+
 static void eloop_handle_sock_event(sock_t* s) {
   int err = 0;
   if (skt(s, ERR) || skt(s, HUP)) {
@@ -127,6 +168,9 @@ int eloop_run(eloop_t* ep) {
     dlink_for(&ep->ready_link, p) {
       eloop_handle_sock_event(structof(p, sock_t, ready_link));
     }
+    if (unlikely(!dlink_is_empty(&ep->zc_linger_list)) && PNIO_REACH_TIME_INTERVAL(10 * 1000)) {
+      eloop_check_zc_linger(ep);
+    }
 
     PNIO_DELAY_WARN(eloop_delay_warn(start_us, ELOOP_WARN_US));
     if (unlikely(PNIO_REACH_TIME_INTERVAL(1000000))) {
@@ -10,10 +10,22 @@
  * See the Mulan PubL v2 for more details.
  */
 
+// a destroyed sock whose MSG_ZEROCOPY sends are not completed yet, its fd and the reqs
+// sent by them are kept until the kernel has done with their pages
+typedef struct zc_linger_t {
+  sock_t sk;
+  dlink_t link;
+  dlink_t reqs;
+  int64_t expire_us;
+  void* io;
+  void (*release)(struct zc_linger_t* l);
+} zc_linger_t;
+
 typedef struct eloop_t {
   int fd;
   dlink_t ready_link;
   rl_impl_t rl_impl;
+  dlink_t zc_linger_list;
 } eloop_t;
 
 extern int eloop_init(eloop_t* ep);
@@ -22,3 +34,4 @@ extern int eloop_run(eloop_t* ep);
 extern int eloop_unregist(eloop_t* ep, sock_t* s);
 extern int eloop_regist(eloop_t* ep, sock_t* s, uint32_t eflag);
 extern void eloop_fire(eloop_t* ep, sock_t* s);
+extern void eloop_zc_linger(eloop_t* ep, zc_linger_t* l);
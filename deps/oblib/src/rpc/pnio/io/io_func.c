@@ -137,3 +137,14 @@ ssize_t uintr_writev(int fd, struct iovec* iov, int cnt) {
     ;
   return bytes;
 }
+
+ssize_t uintr_sendmsg(int fd, struct iovec* iov, int cnt, int flags) {
+  ssize_t bytes = 0;
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = cnt;
+  while((bytes = ussl_sendmsg(fd, &msg, flags)) < 0 && EINTR == errno)
+    ;
+  return bytes;
+}
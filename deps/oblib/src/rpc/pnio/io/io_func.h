@@ -28,3 +28,4 @@ extern ssize_t uintr_read(int fd, char* buf, size_t size);
 extern ssize_t uintr_readv(int fd, struct iovec* iov, int cnt);
 extern ssize_t uintr_write(int fd, const char* buf, size_t size);
 extern ssize_t uintr_writev(int fd, struct iovec* iov, int cnt);
+extern ssize_t uintr_sendmsg(int fd, struct iovec* iov, int cnt, int flags);
@@ -23,4 +23,8 @@ void sk_init(sock_t* s, sf_t* sf, void* handle_event, int fd) {
   s->fty = sf;
   s->handle_event = (typeof(s->handle_event))handle_event;
   s->fd = fd;
+  s->zc_sent = 0;
+  s->zc_done = 0;
+  s->zc_on = 0;
+  s->zc_off = 0;
 }
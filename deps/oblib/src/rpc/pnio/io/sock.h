@@ -31,7 +31,11 @@ typedef int (*handle_event_t)(struct sock_t*);
   int ep_fd;                                    \
   addr_t peer;                                  \
   uint32_t mask;                                \
-  uint8_t conn_ok:1
+  uint32_t zc_sent;                             \
+  uint32_t zc_done;                             \
+  uint8_t conn_ok:1;                            \
+  uint8_t zc_on:1;                              \
+  uint8_t zc_off:1
 
 typedef struct sock_t {
   SOCK_COMMON;
@@ -62,7 +62,110 @@ int sk_write(sock_t* s, const char* buf, size_t size, ssize_t* wbytes) {
   return sk_after_write(s, buf, (*wbytes = uintr_write(s->fd, buf, size)));
 }
 
+extern inline bool sk_zerocopy_pending(sock_t* s);
+
+static bool sk_zerocopy_prepare(sock_t* s, struct iovec* iov, int cnt) {
+  bool ret = false;
+  int64_t threshold = LOAD(&pnio_zerocopy_threshold);
+  int64_t bytes = 0;
+  for(int i = 0; i < cnt; i++) {
+    bytes += iov[i].iov_len;
+  }
+  if (threshold <= 0 || s->zc_off || bytes < threshold) {
+    // pinning pages and reading the completion cost more than copying small payloads
+  } else if (s->zc_on) {
+    ret = true;
+  } else {
+    int on = 1;
+    if (0 != setsockopt(s->fd, SOL_SOCKET, SO_ZEROCOPY, &on, sizeof(on))) {
+      s->zc_off = 1;
+      rk_info("set SO_ZEROCOPY failed, write by copy: s=%p, fd=%d, errno=%d", s, s->fd, errno);
+    } else {
+      s->zc_on = 1;
+      ret = true;
+    }
+  }
+  return ret;
+}
+
 int sk_writev(sock_t* s, struct iovec* iov, int cnt, ssize_t* wbytes) {
   PNIO_DELAY_WARN(STAT_TIME_GUARD(eloop_write_count, eloop_write_time));
-  return sk_after_writev(s, iov, cnt, (*wbytes = uintr_writev(s->fd, iov, cnt)));
+  if (!sk_zerocopy_prepare(s, iov, cnt)) {
+    *wbytes = uintr_writev(s->fd, iov, cnt);
+  } else if ((*wbytes = uintr_sendmsg(s->fd, iov, cnt, MSG_ZEROCOPY)) > 0) {
+    s->zc_sent++;
+  } else if (*wbytes < 0 && (ENOBUFS == errno || EOPNOTSUPP == errno)) {
+    // ENOBUFS: optmem of the socket is exhausted by uncompleted sends, just copy this time.
+    // EOPNOTSUPP: connection is encrypted by ussl, never try again.
+    if (EOPNOTSUPP == errno) {
+      s->zc_off = 1;
+    }
+    *wbytes = uintr_writev(s->fd, iov, cnt);
+  }
+  return sk_after_writev(s, iov, cnt, *wbytes);
+}
+
+int sk_handle_zerocopy_notify(sock_t* s) {
+  int err = 0;
+  char control[CMSG_SPACE(sizeof(struct sock_extended_err) + sizeof(struct sockaddr_in6))];
+  while(0 == err) {
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(s->fd, &msg, MSG_ERRQUEUE) < 0) {
+      if (EAGAIN == errno || EWOULDBLOCK == errno) {
+        break;
+      } else if (EINTR != errno) {
+        err = errno;
+      }
+    } else {
+      struct cmsghdr* cm = CMSG_FIRSTHDR(&msg);
+      struct sock_extended_err* serr = NULL;
+      if (NULL == cm || !((SOL_IP == cm->cmsg_level && IP_RECVERR == cm->cmsg_type)
+                          || (SOL_IPV6 == cm->cmsg_level && IPV6_RECVERR == cm->cmsg_type))) {
+        err = EIO;
+      } else if (NULL == (serr = (struct sock_extended_err*)CMSG_DATA(cm))) {
+        err = EIO;
+      } else if (0 != serr->ee_errno || SO_EE_ORIGIN_ZEROCOPY != serr->ee_origin) {
+        err = serr->ee_errno?: EIO;
+      } else {
+        // the notification covers sends [ee_info, ee_data], tcp completes them in order
+        uint32_t done = serr->ee_data + 1;
+        if ((int32_t)(done - s->zc_done) > 0) {
+          s->zc_done = done;
+        }
+        if ((serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) && !s->zc_off) {
+          // the device can not send from user pages (e.g. loopback), kernel has copied the payload anyway
+          s->zc_off = 1;
+          rk_info("zerocopy send fell back to copy, disable it: s=%p, fd=%d", s, s->fd);
+        }
+      }
+    }
+  }
+  if (0 == err) {
+    int so_err = 0;
+    socklen_t len = sizeof(so_err);
+    if (0 != getsockopt(s->fd, SOL_SOCKET, SO_ERROR, &so_err, &len)) {
+      err = errno;
+    } else {
+      err = so_err;
+    }
+  }
+  return err;
+}
+
+void sk_zerocopy_close(sock_t* s) {
+  if (sk_zerocopy_pending(s)) {
+    struct linger lg;
+    lg.l_onoff = 1;
+    lg.l_linger = 0;
+    if (0 != setsockopt(s->fd, SOL_SOCKET, SO_LINGER, &lg, sizeof(lg))) {
+      rk_warn("set SO_LINGER failed: s=%p, fd=%d, errno=%d", s, s->fd, errno);
+    }
+  }
+  if (0 != ussl_close(s->fd)) {
+    rk_warn("close sock fd faild, s=%p, s->fd=%d, errno=%d", s, s->fd, errno);
+  }
+  s->fd = -1;
 }
@@ -14,3 +14,24 @@ extern int sk_read(sock_t* s, char* buf, size_t size, ssize_t* rbytes);
 extern int sk_readv(sock_t* s, struct iovec* iov, int cnt, ssize_t* rbytes);
 extern int sk_write(sock_t* s, const char* buf, size_t size, ssize_t* wbytes);
 extern int sk_writev(sock_t* s, struct iovec* iov, int cnt, ssize_t* wbytes);
+
+#include <linux/errqueue.h>
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+// sendmsg with MSG_ZEROCOPY returns before the kernel has done with the user pages,
+// the payload can only be released after its completion is read from the error queue.
+inline bool sk_zerocopy_pending(sock_t* s) { return (int32_t)(s->zc_sent - s->zc_done) > 0; }
+extern int sk_handle_zerocopy_notify(sock_t* s);
+// close the fd, the connection is reset if zerocopy sends are still pending, so that the kernel
+// drops their data instead of sending it from the pages later
+extern void sk_zerocopy_close(sock_t* s);
@@ -78,6 +78,9 @@ void wq_init(write_queue_t* wq) {
   wq->cnt = 0;
   wq->sz = 0;
   memset(wq->categ_count_bucket, 0, sizeof(wq->categ_count_bucket));
+  dlink_init(&wq->zc_wait);
+  wq->zc_batch_start = 0;
+  wq->zc_batch_end = 0;
 }
 
 inline void wq_push(write_queue_t* wq, dlink_t* l) {
@@ -100,6 +103,37 @@ inline int wq_delete(write_queue_t* wq, dlink_t* l) {
   return err;
 }
 
+// seq is the count of zerocopy sends issued when the req is flushed,
+// the req can be released after the kernel completes them all.
+void wq_zc_defer(write_queue_t* wq, dlink_t* l, uint32_t seq) {
+  int64_t batch_cnt = wq->zc_batch_end - wq->zc_batch_start;
+  zc_batch_t* last = batch_cnt > 0? wq->zc_batch + (wq->zc_batch_end - 1) % ZC_BATCH_COUNT: NULL;
+  if (NULL != last && (last->seq == seq || batch_cnt >= ZC_BATCH_COUNT)) {
+    // merging into the last batch only delays the release
+    last->seq = seq;
+    last->cnt++;
+  } else {
+    zc_batch_t* b = wq->zc_batch + wq->zc_batch_end % ZC_BATCH_COUNT;
+    b->seq = seq;
+    b->cnt = 1;
+    wq->zc_batch_end++;
+  }
+  dlink_insert_before(&wq->zc_wait, l);
+}
+
+int64_t wq_zc_reclaim(write_queue_t* wq, uint32_t done) {
+  int64_t cnt = 0;
+  while(wq->zc_batch_start < wq->zc_batch_end) {
+    zc_batch_t* b = wq->zc_batch + wq->zc_batch_start % ZC_BATCH_COUNT;
+    if ((int32_t)(done - b->seq) < 0) {
+      break;
+    }
+    cnt += b->cnt;
+    wq->zc_batch_start++;
+  }
+  return cnt;
+}
+
 int wq_flush(sock_t* s, write_queue_t* wq, dlink_t** old_head) {
   int err = 0;
   int64_t wbytes = 0;
@@ -11,15 +11,29 @@
  */
 
 #define BUCKET_SIZE    1024
+#define ZC_BATCH_COUNT 16
+typedef struct zc_batch_t {
+  uint32_t seq;
+  int32_t cnt;
+} zc_batch_t;
+
 typedef struct write_queue_t {
   dqueue_t queue;
   int64_t pos;
   int64_t cnt;
   int64_t sz;
   int16_t categ_count_bucket[BUCKET_SIZE];
+  // flushed reqs waiting for the completion of MSG_ZEROCOPY sends, grouped by the send seq
+  dlink_t zc_wait;
+  int64_t zc_batch_start;
+  int64_t zc_batch_end;
+  zc_batch_t zc_batch[ZC_BATCH_COUNT];
 } write_queue_t;
 
 extern void wq_init(write_queue_t* wq);
 extern void wq_push(write_queue_t* wq, dlink_t* l);
 extern int wq_flush(sock_t* s, write_queue_t* wq, dlink_t** old_head);
+// the caller must not delete a req waiting for zerocopy completion, see zc_waiting of the req
 extern int wq_delete(write_queue_t* wq, dlink_t* l);
+extern void wq_zc_defer(write_queue_t* wq, dlink_t* l, uint32_t seq);
+extern int64_t wq_zc_reclaim(write_queue_t* wq, uint32_t done);
@@ -28,6 +28,9 @@
 #define my_sk_do_flush tns(_sk_do_flush)
 #define my_sk_flush tns(_sk_flush)
 #define my_write_queue_on_sk_destroy tns(_write_queue_on_sk_destroy)
+#define my_write_queue_on_zerocopy_done tns(_write_queue_on_zerocopy_done)
+#define my_zc_linger_release tns(_zc_linger_release)
+#define my_zc_linger_create tns(_zc_linger_create)
 #define my_sk_consume tns(_sk_consume)
 #define my_wq_flush tns(_wq_flush)
 #else
@@ -49,6 +52,9 @@
 #undef my_sk_do_flush
 #undef my_sk_flush
 #undef my_write_queue_on_sk_destroy
+#undef my_write_queue_on_zerocopy_done
+#undef my_zc_linger_release
+#undef my_zc_linger_create
 #undef my_sk_consume
 #undef my_wq_flush
 #endif
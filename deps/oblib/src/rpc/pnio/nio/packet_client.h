@@ -35,6 +35,7 @@ struct pktc_req_t {
   pktc_flush_cb_func_t flush_cb;
   pktc_cb_t* resp_cb;
   addr_t dest;
+  uint8_t zc_waiting; // flushed but the zerocopy sends of it are not completed
   int64_t categ_id; // ATTENTION! Cannot add new structure field from categ_id!
   dlink_t link;
   str_t msg;
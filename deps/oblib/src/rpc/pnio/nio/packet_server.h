@@ -25,6 +25,7 @@ typedef struct pkts_cfg_t {
 typedef struct pkts_req_t {
   int64_t ctime_us;
   int errcode;
+  uint8_t zc_waiting; // flushed but the zerocopy sends of it are not completed
   pkts_flush_cb_func_t flush_cb;
   uint64_t sock_id;
   int64_t expire_us;
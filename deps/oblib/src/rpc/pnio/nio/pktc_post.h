@@ -71,6 +71,7 @@ static int pktc_do_post(pktc_t* io, pktc_sk_t* sk, pktc_req_t* r) {
       ihash_insert(&io->cb_map, &cb->hash_link);
       tw_regist(&io->cb_tw, &cb->timer_dlink);
     }
+    r->zc_waiting = 0;
     wq_push(&sk->wq, &r->link);
   }
   return err;
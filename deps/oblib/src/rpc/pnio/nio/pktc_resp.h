@@ -19,7 +19,7 @@ static void pktc_do_cb_exception(pktc_t* io, pktc_cb_t* cb) {
   if (req) {
     // pktc_flush_cb hasn't be executed
     pktc_sk_t* sk = req->sk;
-    if (NULL != sk && PNIO_OK == wq_delete(&sk->wq, &req->link)) {
+    if (NULL != sk && !req->zc_waiting && PNIO_OK == wq_delete(&sk->wq, &req->link)) {
       rk_warn("pktc_req hasn't be flushed before callback, pkt_id=%ld, sock=%p, code=%d", cb->id, sk, cb->errcode);
       // reset the error code to indicate that the request has not been sent out
       if (cb->errcode == PNIO_DISCONNECT) {
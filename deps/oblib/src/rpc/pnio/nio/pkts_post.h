@@ -16,6 +16,7 @@ static void pkts_post_io(pkts_t* io, pkts_req_t* r) {
     if (sk->wq.cnt >= MAX_WRITE_QUEUE_COUNT && PNIO_REACH_TIME_INTERVAL(500*1000)) {
       rk_warn("too many requests in pkts write queue, wq_cnt=%ld, wq_sz=%ld, sock_id=%ld, sk=%p", sk->wq.cnt, sk->wq.sz, r->sock_id, sk);
     }
+    r->zc_waiting = 0;
     wq_push(&sk->wq, &r->link);
     eloop_fire(io->ep, (sock_t*)sk);
   } else {
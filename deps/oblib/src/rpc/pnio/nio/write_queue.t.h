@@ -14,10 +14,82 @@ static void my_flush_cb_exception(my_t* io, my_req_t* r) {
   return my_flush_cb(io, r);
 }
 
+static void my_flush_cb_after_flush(my_t* io, my_req_t* r) {
+  return my_flush_cb(io, r);
+}
+
+static void my_write_queue_on_zerocopy_done(my_t* io, my_sk_t* s) {
+  int64_t cnt = wq_zc_reclaim(&s->wq, s->zc_done);
+  while(cnt-- > 0) {
+    dlink_t* l = s->wq.zc_wait.next;
+    my_req_t* req = structof(l, my_req_t, link);
+    dlink_delete(l);
+    req->zc_waiting = 0;
+    my_flush_cb_after_flush(io, req);
+  }
+}
+
+static void my_zc_linger_release(zc_linger_t* l) {
+  my_t* io = (my_t*)l->io;
+  dlink_for(&l->reqs, p) {
+    my_req_t* req = structof(p, my_req_t, link);
+    req->zc_waiting = 0;
+    my_flush_cb_after_flush(io, req);
+  }
+  sfree(l);
+}
+
+// the fd of s is not closed by sock_destroy if zerocopy sends are pending, it is taken over here
+static zc_linger_t* my_zc_linger_create(my_t* io, my_sk_t* s) {
+  zc_linger_t* l = (zc_linger_t*)salloc(sizeof(*l));
+  if (NULL == l) {
+    rk_warn("alloc zc_linger failed, reset the connection: s=%p, fd=%d", s, s->fd);
+    sk_zerocopy_close((sock_t*)s);
+  } else {
+    memset(l, 0, sizeof(*l));
+    l->sk.fd = s->fd;
+    l->sk.zc_sent = s->zc_sent;
+    l->sk.zc_done = s->zc_done;
+    l->sk.zc_on = 1;
+    dlink_init(&l->reqs);
+    l->io = io;
+    l->release = my_zc_linger_release;
+    s->fd = -1;
+  }
+  return l;
+}
+
 static void my_write_queue_on_sk_destroy(my_t* io, my_sk_t* s) {
+  zc_linger_t* l = NULL;
+  my_write_queue_on_zerocopy_done(io, s);
+  if (sk_zerocopy_pending((sock_t*)s)) {
+    l = my_zc_linger_create(io, s);
+  }
   dlink_for(&(s->wq.queue.head), p) {
     my_req_t* req = structof(p, my_req_t, link);
-    my_flush_cb_exception(io, req);
+    if (NULL != l && p == dqueue_top(&s->wq.queue) && s->wq.pos > 0) {
+      // partially written, maybe by a pending zerocopy send
+      req->zc_waiting = 1;
+      dlink_delete(p);
+      dlink_insert_before(&l->reqs, p);
+    } else {
+      my_flush_cb_exception(io, req);
+    }
+  }
+  // the pages of the flushed reqs are still read by the kernel until the completions,
+  // unless the connection is reset
+  dlink_for(&s->wq.zc_wait, p) {
+    my_req_t* req = structof(p, my_req_t, link);
+    if (NULL != l) {
+      dlink_delete(p);
+      dlink_insert_before(&l->reqs, p);
+    } else {
+      req->zc_waiting = 0;
+      my_flush_cb_after_flush(io, req);
+    }
+  }
+  if (NULL != l) {
+    eloop_zc_linger(io->ep, l);
   }
 }
 
@@ -25,14 +97,11 @@ static void my_flush_cb_on_post_fail(my_t* io, my_req_t* r) {
   return my_flush_cb_exception(io, r);
 }
 
-static void my_flush_cb_after_flush(my_t* io, my_req_t* r) {
-  return my_flush_cb(io, r);
-}
-
 static int my_sk_do_flush(my_sk_t* s, int64_t* remain) {
   dlink_t* h = NULL;
-  int err = my_wq_flush((sock_t*)s, &s->wq, &h);
   my_t* io = structof(s->fty, my_t, sf);
+  my_write_queue_on_zerocopy_done(io, s);
+  int err = my_wq_flush((sock_t*)s, &s->wq, &h);
   int64_t flushed_time_us = rk_get_us();
   if (0 == err && NULL != h) {
     dlink_t* stop = dqueue_top(&s->wq.queue);
@@ -42,7 +111,12 @@ static int my_sk_do_flush(my_sk_t* s, int64_t* remain) {
       s->sk_diag_info.write_cnt ++;
       s->sk_diag_info.write_size += req->msg.s;
       s->sk_diag_info.write_wait_time += (flushed_time_us - req->ctime_us);
-      my_flush_cb_after_flush(io, req);
+      if (sk_zerocopy_pending((sock_t*)s)) {
+        req->zc_waiting = 1;
+        wq_zc_defer(&s->wq, &req->link, s->zc_sent);
+      } else {
+        my_flush_cb_after_flush(io, req);
+      }
     }
   }
   *remain = !dqueue_empty(&s->wq.queue);
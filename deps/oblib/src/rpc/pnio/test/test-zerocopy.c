@@ -0,0 +1,176 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+const char* usage = "./usage:\n"
+                    "size=4194304 count=4096 zc_threshold=0 ./test-zerocopy all\n"
+                    "size=4194304 count=4096 zc_threshold=65536 ./test-zerocopy all\n"
+                    "io_port=8042 io_thread=1 ./test-zerocopy server\n"
+                    "dest=127.0.0.1 io_port=8042 stress_thread=4 window=16 zc_threshold=65536 ./test-zerocopy client\n"
+                    "note: loopback makes the kernel copy MSG_ZEROCOPY payloads anyway,\n"
+                    "      run server and client on different hosts to measure the saved copy.\n";
+#include "pkt-nio.h"
+#include <pthread.h>
+#include <sys/resource.h>
+#include <signal.h>
+
+#define cfg(k, v) (getenv(k)?:v)
+#define cfgi(k, v) atol(getenv(k)?:v)
+#define streq(s1, s2) (0 == strcmp(s1, s2))
+
+int grp = 1;
+struct sockaddr_storage dest_addr;
+int64_t handle_cnt;
+int64_t err_cnt;
+
+// the response is empty, so the client measures sending large requests through pnio
+int serve_cb(int grp, const char* b, int64_t sz, uint64_t req_id)
+{
+  FAA(&handle_cnt, 1);
+  pn_resp(req_id, b, 0, rk_get_us() + 10 * 1000 * 1000);
+  return 0;
+}
+
+typedef struct client_cond {
+  int cond;
+} client_cond;
+
+int client_cb(void* arg, int error, const char* b, int64_t sz)
+{
+  client_cond* pcond = (typeof(pcond))arg;
+  if (0 != error) {
+    FAA(&err_cnt, 1);
+  }
+  AAF(&pcond->cond, 1);
+  rk_futex_wake(&pcond->cond, 1);
+  return 0;
+}
+
+typedef struct stress_arg {
+  int64_t tid;
+  int64_t count;
+  int64_t size;
+  int64_t window;
+} stress_arg;
+
+void* stress_thread(void* arg)
+{
+  stress_arg* sa = (typeof(sa))arg;
+  client_cond cond = { 0 };
+  char* msg = (char*)malloc(sa->size);
+  memset(msg, 'a' + sa->tid, sa->size);
+  for(int64_t i = 0; i < sa->count; i++) {
+    int cur_cond = 0;
+    // keep at most window reqs in flight, so the send buffer stays busy but bounded
+    while(i - (cur_cond = LOAD(&cond.cond)) >= sa->window) {
+      rk_futex_wait(&cond.cond, cur_cond, NULL);
+    }
+    pn_pkt_t pkt = {
+      .buf = msg,
+      .sz = sa->size,
+      .expire_us = rk_get_us() + 10 * 1000 * 1000,
+      .categ_id = 0,
+      .cb = client_cb,
+      .arg = &cond
+    };
+    if (PNIO_OK != pn_send(((uint64_t)grp<<32) + sa->tid, &dest_addr, &pkt, NULL)) {
+      i--;
+      usleep(1000);
+    }
+  }
+  int cur_cond = 0;
+  while((cur_cond = LOAD(&cond.cond)) < sa->count) {
+    rk_futex_wait(&cond.cond, cur_cond, NULL);
+  }
+  free(msg);
+  return NULL;
+}
+
+static int64_t process_cpu_us(int64_t* sys_us)
+{
+  struct rusage ru;
+  getrusage(RUSAGE_SELF, &ru);
+  *sys_us = ru.ru_stime.tv_sec * 1000000 + ru.ru_stime.tv_usec;
+  return ru.ru_utime.tv_sec * 1000000 + ru.ru_utime.tv_usec;
+}
+
+static void run_client()
+{
+  int64_t size = cfgi("size", "4194304");
+  int64_t count = cfgi("count", "4096");
+  int64_t stress_count = cfgi("stress_thread", "4");
+  int64_t window = cfgi("window", "16");
+  pthread_t thd[1024];
+  stress_arg args[1024];
+  if (stress_count > 1024) {
+    stress_count = 1024;
+  }
+  int64_t start_sys_us = 0;
+  int64_t start_user_us = process_cpu_us(&start_sys_us);
+  int64_t start_us = rk_get_us();
+  for(int64_t i = 0; i < stress_count; i++) {
+    args[i].tid = i;
+    args[i].count = count / stress_count;
+    args[i].size = size;
+    args[i].window = window;
+    pthread_create(thd + i, NULL, stress_thread, args + i);
+  }
+  for(int64_t i = 0; i < stress_count; i++) {
+    pthread_join(thd[i], NULL);
+  }
+  int64_t cost_us = rk_get_us() - start_us;
+  int64_t end_sys_us = 0;
+  int64_t end_user_us = process_cpu_us(&end_sys_us);
+  int64_t sent = count / stress_count * stress_count;
+  format_t f;
+  format_init(&f, sizeof(f.buf));
+  mod_report(&f);
+  printf("size=%ld count=%ld zc_threshold=%ld: %.2lf MB/s, user=%ldms sys=%ldms, err=%ld handle=%ld\n",
+         size, sent, LOAD(&pnio_zerocopy_threshold),
+         ((double)size * sent) / cost_us * 0.95367431640625,
+         (end_user_us - start_user_us)/1000, (end_sys_us - start_sys_us)/1000,
+         LOAD(&err_cnt), LOAD(&handle_cnt));
+  printf("alloc: %s\n", format_gets(&f));
+}
+
+int main(int argc, char** argv)
+{
+  if (argc != 2) {
+    fprintf(stderr, "%s\n", usage);
+    return 1;
+  }
+  signal(SIGPIPE, SIG_IGN);
+  const char* mode = argv[1];
+  int port = cfgi("io_port", "8042");
+  int lfd = -1;
+  pn_set_zerocopy_threshold(cfgi("zc_threshold", "0"));
+  if (streq(mode, "server") || streq(mode, "all")) {
+    lfd = pn_listen(port, serve_cb);
+  }
+  int cnt = pn_provision(lfd, grp, cfgi("io_thread", "1"));
+  if (cnt <= 0) {
+    printf("pn_provision failed, cnt = %d\n", cnt);
+    exit(-1);
+  }
+  if (streq(mode, "client") || streq(mode, "all")) {
+    addr_t dest;
+    make_sockaddr(&dest_addr, *addr_init(&dest, cfg("dest", "127.0.0.1"), port));
+    run_client();
+  } else {
+    while(1) {
+      usleep(1000 * 1000);
+      printf("handle: %ld\n", LOAD(&handle_cnt));
+    }
+  }
+  return 0;
+}
+
+#include "pkt-nio.c"
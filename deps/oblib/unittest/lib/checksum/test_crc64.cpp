@@ -98,6 +98,74 @@ TEST(TestCrc64, test_speed)
   }
 }
 
+TEST(TestCrc64, batch)
+{
+  const int64_t BUF_COUNT = 1000;
+  const int64_t MAX_LEN = 8192;
+  char *tmp_str = new char[MAX_LEN + 8];
+  const char *bufs[BUF_COUNT];
+  int64_t lens[BUF_COUNT];
+  uint64_t crcs[BUF_COUNT];
+  uint64_t expected_crcs[BUF_COUNT];
+  memset(tmp_str, 0, MAX_LEN + 8);
+  rand_str(tmp_str, MAX_LEN);
+  for (int64_t round = 0; round < 100; ++round) {
+    for (int64_t i = 0; i < BUF_COUNT; ++i) {
+      // mix small, large, unaligned and empty buffers
+      bufs[i] = tmp_str + rand() % 8;
+      lens[i] = 0 == i % 97 ? rand() % MAX_LEN : rand() % 300 - 10;
+      crcs[i] = rand();
+      expected_crcs[i] = ob_crc64_sse42(crcs[i], bufs[i], lens[i]);
+    }
+    ob_crc64_sse42_batch(BUF_COUNT, bufs, lens, crcs);
+    for (int64_t i = 0; i < BUF_COUNT; ++i) {
+      ASSERT_EQ(expected_crcs[i], crcs[i]) << "i=" << i << " len=" << lens[i];
+    }
+  }
+  delete [] tmp_str;
+}
+
+TEST(TestCrc64, test_batch_speed)
+{
+  const int64_t BUF_COUNT = 1024;
+  const int64_t COUNT = 10000;
+  const int64_t MAX_LEN = 1024;
+  char *tmp_str = new char[BUF_COUNT * MAX_LEN];
+  const char *bufs[BUF_COUNT];
+  int64_t lens[BUF_COUNT];
+  uint64_t crcs[BUF_COUNT];
+  rand_str(tmp_str, BUF_COUNT * MAX_LEN - 2);
+
+  for (int64_t len = 4; len <= MAX_LEN; len *= 4) {
+    for (int64_t i = 0; i < BUF_COUNT; ++i) {
+      bufs[i] = tmp_str + i * MAX_LEN;
+      lens[i] = len;
+      crcs[i] = 0;
+    }
+    const double total_GB = static_cast<double>(COUNT * BUF_COUNT * len) / (1024 * 1024 * 1024);
+
+    int64_t start = get_current_time_us();
+    for (int64_t j = 0; j < COUNT; ++j) {
+      for (int64_t i = 0; i < BUF_COUNT; ++i) {
+        crcs[i] = ob_crc64_sse42(crcs[i], bufs[i], lens[i]);
+      }
+    }
+    int64_t end = get_current_time_us();
+    cout << "      ob_crc64_sse42, len = " << len << ", cost_us = " << end - start
+         << ", GB/s = " << total_GB * 1000000 / std::max(end - start, 1L) << endl;
+
+    start = get_current_time_us();
+    for (int64_t j = 0; j < COUNT; ++j) {
+      ob_crc64_sse42_batch(BUF_COUNT, bufs, lens, crcs);
+    }
+    end = get_current_time_us();
+    cout << "ob_crc64_sse42_batch, len = " << len << ", cost_us = " << end - start
+         << ", GB/s = " << total_GB * 1000000 / std::max(end - start, 1L) << endl;
+    cout << endl;
+  }
+  delete [] tmp_str;
+}
+
 int main(int argc, char **argv)
 {
   testing::InitGoogleTest(&argc,argv);
@@ -380,6 +380,52 @@ TEST_F(ObCompressorTest, test_zstd)
   test_normal(zstd_compressor);
 }
 
+TEST_F(ObCompressorTest, test_zstd_dict)
+{
+  int ret = OB_SUCCESS;
+  zstd_1_3_8::ObZstdDictCompressor_1_3_8 dict_compressor(alloc);
+  zstd_1_3_8::ObZstdCompressDict_1_3_8 dict(alloc);
+  const char *dict_data =
+      "OceanBase is a distributed relational database, the first without shared storage.";
+  const int64_t src_len = static_cast<int64_t>(strlen(src_data));
+  int64_t plain_size = 0;
+  int64_t dict_size = 0;
+
+  // without dict, the frame decompresses alone
+  test_invalid_argument(dict_compressor);
+  test_overflow_size(dict_compressor);
+  test_normal(dict_compressor);
+  ASSERT_FALSE(zstd_1_3_8::ObZstdDictCompressor_1_3_8::is_dict_frame(compress_buffer, dst_data_size));
+  plain_size = dst_data_size;
+
+  // with dict
+  ret = dict.init(NULL, 10);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, ret);
+  ret = dict.init(dict_data, static_cast<int64_t>(strlen(dict_data)));
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_TRUE(dict.is_valid());
+  ret = dict_compressor.compress(src_data, src_len, compress_buffer, buffer_size, dict_size, &dict);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_TRUE(zstd_1_3_8::ObZstdDictCompressor_1_3_8::is_dict_frame(compress_buffer, dict_size));
+  ASSERT_LT(dict_size, plain_size);
+
+  memset(decompress_buffer, '\0', buffer_size);
+  ret = dict_compressor.decompress(compress_buffer, dict_size, decompress_buffer, src_len, dst_data_size);
+  ASSERT_EQ(OB_ERR_COMPRESS_DECOMPRESS_DATA, ret);
+  ret = dict_compressor.decompress(compress_buffer, dict_size, decompress_buffer, src_len, dst_data_size,
+                                   dict_data, static_cast<int64_t>(strlen(dict_data)));
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(src_len, dst_data_size);
+  ASSERT_EQ(0, strcmp(src_data, decompress_buffer));
+
+  // a reset dict falls back to plain frames
+  dict.reset();
+  ASSERT_FALSE(dict.is_valid());
+  ret = dict_compressor.compress(src_data, src_len, compress_buffer, buffer_size, dst_data_size, &dict);
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_FALSE(zstd_1_3_8::ObZstdDictCompressor_1_3_8::is_dict_frame(compress_buffer, dst_data_size));
+}
+
 TEST(ObCompressorStress, compress_stable)
 {
   int ret = OB_SUCCESS;
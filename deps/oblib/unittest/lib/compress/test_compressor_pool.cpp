@@ -76,6 +76,7 @@ TEST(ObCompressorPool, test_normal_compressor)
   test_normal("zstd_1.0");
   test_normal("zstd_1.3.8");
   test_normal("lz4_1.9.1");
+  test_normal("zstd_dict_1.3.8");
 }
 
 TEST(ObCompressorPool, test_stream_compressor)
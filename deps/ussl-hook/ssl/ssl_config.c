@@ -857,6 +857,21 @@ ssize_t writev_regard_ssl(int fildes, const struct iovec *iov, int iovcnt)
   return wbytes;
 }
 
+ssize_t sendmsg_regard_ssl(int fildes, const struct msghdr *msg, int flags)
+{
+  ssize_t wbytes = -1;
+  if (fildes < 0 || fildes >= FD_MAX) {
+    errno = EINVAL;
+  } else if (NULL == gs_fd_ssl_array[fildes].ssl) {
+    wbytes = libc_sendmsg(fildes, msg, flags);
+  } else {
+    // data of ssl connection is encrypted into openssl's own buffer, the
+    // flags of sendmsg (such as MSG_ZEROCOPY) make no sense for it.
+    errno = EOPNOTSUPP;
+  }
+  return wbytes;
+}
+
 SSL_CTX* ussl_get_server_ctx(int ctx_id)
 {
   SSL_CTX *ctx = NULL;
@@ -29,3 +29,4 @@ SSL_CTX* ussl_get_server_ctx(int ctx_id);
 ssize_t read_regard_ssl(int fd, char *buf, size_t nbytes);
 ssize_t write_regard_ssl(int fd, const void *buf, size_t nbytes);
 ssize_t writev_regard_ssl(int fildes, const struct iovec *iov, int iovcnt);
+ssize_t sendmsg_regard_ssl(int fildes, const struct msghdr *msg, int flags);
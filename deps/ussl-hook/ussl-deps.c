@@ -30,6 +30,7 @@ static __attribute__((constructor(101))) void init_libc_func_ptr()
   INIT_LIBC_FUNC_PTR(write);
   INIT_LIBC_FUNC_PTR(close);
   INIT_LIBC_FUNC_PTR(writev);
+  INIT_LIBC_FUNC_PTR(sendmsg);
 }
 
 int make_socket_non_blocking(int fd)
@@ -156,6 +156,7 @@ static int (*libc_close)(int fd);
 static ssize_t (*libc_read)(int fd, void *buf, size_t count);
 static ssize_t (*libc_write)(int fd, const void *buf, size_t count);
 static ssize_t (*libc_writev)(int fildes, const struct iovec *iov, int iovcnt);
+static ssize_t (*libc_sendmsg)(int sockfd, const struct msghdr *msg, int flags);
 
 int make_socket_non_blocking(int fd);
 
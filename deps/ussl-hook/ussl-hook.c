@@ -289,6 +289,11 @@ ssize_t ussl_writev(int fildes, const struct iovec *iov, int iovcnt)
   return writev_regard_ssl(fildes, iov, iovcnt);
 }
 
+ssize_t ussl_sendmsg(int fildes, const struct msghdr *msg, int flags)
+{
+  return sendmsg_regard_ssl(fildes, msg, flags);
+}
+
 #include "ussl-deps.c"
 #include "loop/auth-methods.c"
 #include "loop/ussl_eloop.c"
@@ -63,6 +63,7 @@ int ussl_epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
 ssize_t ussl_read(int fd, char *buf, size_t nbytes);
 ssize_t ussl_write(int fd, const void *buf, size_t nbytes);
 ssize_t ussl_writev(int fildes, const struct iovec *iov, int iovcnt);
+ssize_t ussl_sendmsg(int fildes, const struct msghdr *msg, int flags);
 int ussl_close(int fd);
 
 typedef struct ssl_config_item_t
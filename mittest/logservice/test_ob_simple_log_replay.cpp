@@ -12,6 +12,7 @@
 
 #include <cstdio>
 #include <gtest/gtest.h>
+#include <map>
 #include <signal.h>
 #define private public
 #define protected public
@@ -54,6 +55,20 @@ public:
     retry_count_ = 0;
     pre_barrier_scn_.set_min();
     rp_st_ = NULL;
+    need_check_hint_order_ = false;
+  }
+
+  // tasks with the same replay hint must be replayed in log order
+  void check_hint_order(const ObLogReplayTask &replay_task)
+  {
+    ObSpinLockGuard guard(hint_lock_);
+    std::map<int64_t, int64_t>::iterator iter = hint_lsn_map_.find(replay_task.replay_hint_);
+    if (hint_lsn_map_.end() != iter) {
+      EXPECT_LT(iter->second, (int64_t)replay_task.lsn_.val_);
+      iter->second = replay_task.lsn_.val_;
+    } else {
+      hint_lsn_map_[replay_task.replay_hint_] = replay_task.lsn_.val_;
+    }
   }
 
   int replay(ObLogReplayTask *replay_task)
@@ -80,6 +95,9 @@ public:
       if (replay_task->is_pre_barrier_) {
         pre_barrier_scn_.atomic_set(replay_task->scn_);
       }
+      if (need_check_hint_order_) {
+        check_hint_order(*replay_task);
+      }
       if (replay_task->is_post_barrier_) {
         //尽量让后向barrier回放慢,如果有没卡住的后向barrier之后的日志就会增大回放的概率
         usleep(1000);
@@ -104,6 +122,9 @@ public:
   int64_t retry_count_;
   share::SCN pre_barrier_scn_;
   ObReplayStatus *rp_st_;
+  bool need_check_hint_order_;
+  ObSpinLock hint_lock_;
+  std::map<int64_t, int64_t> hint_lsn_map_;
 };
 
 int64_t ObSimpleLogClusterTestBase::member_cnt_ = 1;
@@ -214,6 +235,77 @@ TEST_F(TestObSimpleLogReplayFunc, basic_replay)
   CLOG_LOG(INFO, "test replay finish", K(id));
 }
 
+TEST_F(TestObSimpleLogReplayFunc, dependency_dispatch_replay)
+{
+  SET_CASE_LOG_FILE(TEST_NAME, "dependency_dispatch_replay");
+  const int64_t task_count = 1024;
+  const int64_t id = ATOMIC_AAF(&palf_id_, 1);
+  ObLSID ls_id(id);
+  int64_t leader_idx = 0;
+  LSN basic_lsn(0);
+  PalfHandleImplGuard leader;
+  share::SCN basic_scn = share::SCN::min_scn();
+  CLOG_LOG(INFO, "test dependency dispatch replay begin", K(id));
+  EXPECT_EQ(OB_SUCCESS, create_paxos_group(id, leader_idx, leader));
+  MockLSAdapter ls_adapter;
+  ls_adapter.init((ObLSService *)(0x1));
+  ls_adapter.need_check_hint_order_ = true;
+  ObLogReplayService rp_sv;
+  ObReplayStatus *rp_st = NULL;
+  PalfEnv *palf_env;
+  EXPECT_EQ(OB_SUCCESS, get_palf_env(leader_idx, palf_env));
+  rp_sv.init(palf_env, &ls_adapter, get_cluster()[0]->get_allocator());
+  rp_sv.enable_dependency_dispatch_ = true;
+  rp_sv.start();
+  get_cluster()[0]->get_tenant_base()->update_thread_cnt(10);
+  EXPECT_EQ(OB_SUCCESS, rp_sv.add_ls(ls_id));
+  EXPECT_EQ(OB_SUCCESS, rp_sv.enable(ls_id, basic_lsn, basic_scn));
+  {
+    ObReplayStatusGuard guard;
+    EXPECT_EQ(OB_SUCCESS, rp_sv.get_replay_status_(ls_id, guard));
+    rp_st = guard.get_replay_status();
+    ls_adapter.rp_st_ = rp_st;
+  }
+  LSN unused_lsn;
+  share::SCN unused_scn;
+  for (int i = 0; i < task_count; i++) {
+    EXPECT_EQ(OB_SUCCESS, submit_log(leader, unused_lsn, unused_scn));
+  }
+  ls_adapter.wait_replay_done(task_count);
+  bool is_done = false;
+  LSN end_lsn = leader.palf_handle_impl_->get_end_lsn();
+  while (!is_done) {
+    rp_sv.is_replay_done(ls_id, end_lsn, is_done);
+  }
+  EXPECT_EQ(0, rp_sv.get_pending_task_size());
+  // retried tasks are bypassed by later tasks, all of them are replayed finally
+  EXPECT_LT(0, rp_st->stall_cnt_[REPLAY_STALL_RETRY]);
+  ReplayDiagnoseInfo diagnose_info;
+  EXPECT_EQ(OB_SUCCESS, rp_sv.diagnose(ls_id, diagnose_info));
+  EXPECT_EQ(0, diagnose_info.deferred_task_cnt_);
+  EXPECT_EQ(0, diagnose_info.replay_parallelism_);
+  CLOG_LOG(INFO, "diagnose replay", K(diagnose_info), K(diagnose_info.diagnose_str_));
+  // turn off dependency dispatch while replaying, deferred tasks are drained before later tasks
+  for (int i = 0; i < task_count; i++) {
+    EXPECT_EQ(OB_SUCCESS, submit_log(leader, unused_lsn, unused_scn));
+    if (task_count / 2 == i) {
+      rp_sv.enable_dependency_dispatch_ = false;
+    }
+  }
+  ls_adapter.wait_replay_done(2 * task_count);
+  is_done = false;
+  end_lsn = leader.palf_handle_impl_->get_end_lsn();
+  while (!is_done) {
+    rp_sv.is_replay_done(ls_id, end_lsn, is_done);
+  }
+  EXPECT_EQ(0, rp_sv.get_pending_task_size());
+  EXPECT_EQ(OB_SUCCESS, rp_sv.remove_ls(ls_id));
+  rp_sv.stop();
+  rp_sv.wait();
+  rp_sv.destroy();
+  CLOG_LOG(INFO, "test dependency dispatch replay finish", K(id));
+}
+
 TEST_F(TestObSimpleLogReplayFunc, test_flashback_to_padding)
 {
   SET_CASE_LOG_FILE(TEST_NAME, "flashback_to_padding");
@@ -978,7 +978,7 @@ int MockTenantModuleEnv::start_()
       palf::LogIOWorkerConfig new_config;
       const int64_t mock_tenant_id = 1;
       gc_svr->stop_create_new_gc_task_ = true;
-      palf_env_impl->init_log_io_worker_config_(1, mock_tenant_id, new_config);
+      palf_env_impl->init_log_io_worker_config_(1, 0, mock_tenant_id, new_config);
       new_config.io_worker_num_ = 4;
       log_iow_wrapper.destory_and_free_log_io_workers_();
       if (OB_FAIL(log_iow_wrapper.create_and_init_log_io_workers_(
@@ -242,6 +242,7 @@ TEST_F(TestObMicroBlockCache, test_block_cache)
   ASSERT_EQ(OB_SUCCESS, data_idx_info.row_header_->fill_micro_des_meta(false, micro_des_meta));
   ASSERT_EQ(OB_SUCCESS, data_block_cache_->load_block(
       micro_block_id,
+      data_idx_info.nested_offset_,
       micro_des_meta,
       data_idx_info.get_logic_micro_id(),
       data_idx_info.get_data_checksum(),
@@ -268,6 +269,7 @@ TEST_F(TestObMicroBlockCache, test_block_cache)
   ASSERT_EQ(OB_SUCCESS, micro_idx_info.row_header_->fill_micro_des_meta(false, micro_des_meta));
   ASSERT_EQ(OB_SUCCESS, index_block_cache_->load_block(
       micro_block_id,
+      micro_idx_info.nested_offset_,
       micro_des_meta,
       data_idx_info.get_logic_micro_id(),
       data_idx_info.get_data_checksum(),
@@ -0,0 +1,197 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+
+#include "storage/access/ob_sstable_row_scanner.h"
+#include "storage/blocksstable/ob_micro_block_dict_cache.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
+#include "ob_index_block_data_prepare.h"
+
+namespace oceanbase
+{
+using namespace storage;
+using namespace common;
+namespace blocksstable
+{
+// The small sstable of mini merge is written into a shared macro block, so its dict is located
+// by the nested offset rather than the head of the macro block.
+class TestMicroBlockDictCache : public TestIndexBlockDataPrepare
+{
+public:
+  TestMicroBlockDictCache();
+  virtual ~TestMicroBlockDictCache() {}
+  static void SetUpTestCase();
+  static void TearDownTestCase();
+  virtual void SetUp();
+  virtual void TearDown();
+  virtual void prepare_schema() override;
+  void get_data_macro_id(MacroBlockId &macro_id);
+  void scan_all_rows(int64_t &row_count);
+};
+
+TestMicroBlockDictCache::TestMicroBlockDictCache()
+  : TestIndexBlockDataPrepare(
+      "Test micro block dict cache",
+      MINI_MERGE,
+      false,
+      OB_DEFAULT_MACRO_BLOCK_SIZE,
+      10000,
+      10)
+{
+}
+
+void TestMicroBlockDictCache::SetUpTestCase()
+{
+  TestIndexBlockDataPrepare::SetUpTestCase();
+}
+
+void TestMicroBlockDictCache::TearDownTestCase()
+{
+  TestIndexBlockDataPrepare::TearDownTestCase();
+}
+
+void TestMicroBlockDictCache::SetUp()
+{
+  TestIndexBlockDataPrepare::SetUp();
+  ObLSID ls_id(ls_id_);
+  ObTabletID tablet_id(tablet_id_);
+  ObLSHandle ls_handle;
+  ObLSService *ls_svr = MTL(ObLSService*);
+  ASSERT_EQ(OB_SUCCESS, ls_svr->get_ls(ls_id, ls_handle, ObLSGetMod::STORAGE_MOD));
+  ASSERT_EQ(OB_SUCCESS, ls_handle.get_ls()->get_tablet(tablet_id, tablet_handle_));
+}
+
+void TestMicroBlockDictCache::TearDown()
+{
+  tablet_handle_.reset();
+  TestIndexBlockDataPrepare::TearDown();
+}
+
+void TestMicroBlockDictCache::prepare_schema()
+{
+  TestIndexBlockDataPrepare::prepare_schema();
+  table_schema_.set_compress_func_name("zstd_dict_1.3.8");
+  index_schema_.set_compress_func_name("zstd_dict_1.3.8");
+}
+
+void TestMicroBlockDictCache::get_data_macro_id(MacroBlockId &macro_id)
+{
+  ObMacroIdIterator id_iterator;
+  ASSERT_EQ(OB_SUCCESS, sstable_.meta_->macro_info_.get_data_block_iter(id_iterator));
+  ASSERT_EQ(OB_SUCCESS, id_iterator.get_next_macro_id(macro_id));
+}
+
+void TestMicroBlockDictCache::scan_all_rows(int64_t &row_count)
+{
+  ObDatumRange range;
+  const ObDatumRow *prow = nullptr;
+  ObSSTableRowScanner<> scanner;
+  range.set_whole_range();
+  row_count = 0;
+  prepare_query_param(false);
+  ASSERT_EQ(OB_SUCCESS, scanner.init(iter_param_, context_, &sstable_, &range));
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(scanner.inner_get_next_row(prow))) {
+    ++row_count;
+  }
+  ASSERT_EQ(OB_ITER_END, ret);
+  scanner.reset();
+  destroy_query_param();
+}
+
+TEST_F(TestMicroBlockDictCache, test_dict_of_shared_macro_block)
+{
+  ObMicroBlockDictCache &dict_cache = OB_STORE_CACHE.get_micro_block_dict_cache();
+  const int64_t nested_offset = sstable_.meta_->macro_info_.nested_offset_;
+  MacroBlockId macro_id;
+  get_data_macro_id(macro_id);
+  ASSERT_TRUE(sstable_.is_small_sstable());
+  ASSERT_LT(0, nested_offset);
+
+  ObMicroBlockDictHandle handle;
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().erase_cache(tenant_id_, "micro_block_dict_cache"));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, dict_cache.get_cached_dict(tenant_id_, macro_id, nested_offset, handle));
+  ASSERT_FALSE(handle.is_valid());
+  // the head of shared macro block is not the sstable
+  ASSERT_NE(OB_SUCCESS, dict_cache.get_dict(tenant_id_, macro_id, 0, handle));
+  ASSERT_FALSE(handle.is_valid());
+
+  // sync load at the nested offset
+  ASSERT_EQ(OB_SUCCESS, dict_cache.get_dict(tenant_id_, macro_id, nested_offset, handle));
+  ASSERT_TRUE(handle.is_valid());
+  ASSERT_LT(0, handle.get_dict_size());
+  ObMicroBlockDictHandle cached_handle;
+  ASSERT_EQ(OB_SUCCESS, dict_cache.get_cached_dict(tenant_id_, macro_id, nested_offset, cached_handle));
+  ASSERT_EQ(handle.get_dict_size(), cached_handle.get_dict_size());
+  ASSERT_EQ(0, MEMCMP(handle.get_dict_buf(), cached_handle.get_dict_buf(), handle.get_dict_size()));
+
+  // put the dict parsed from a buffer read from the nested offset
+  ObArenaAllocator allocator;
+  ObStorageObjectReadInfo read_info;
+  ObStorageObjectHandle object_handle;
+  read_info.macro_block_id_ = macro_id;
+  read_info.offset_ = nested_offset;
+  read_info.size_ = sstable_.meta_->macro_info_.nested_size_;
+  read_info.io_desc_.set_mode(ObIOMode::READ);
+  read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
+  read_info.io_timeout_ms_ = DEFAULT_IO_WAIT_TIME_MS;
+  read_info.mtl_tenant_id_ = MTL_ID();
+  ASSERT_NE(nullptr, read_info.buf_ = static_cast<char *>(allocator.alloc(read_info.size_)));
+  ASSERT_EQ(OB_SUCCESS, ObObjectManager::read_object(read_info, object_handle));
+  ObMicroBlockDictHandle put_handle;
+  ASSERT_EQ(OB_SUCCESS, dict_cache.put_dict(tenant_id_, macro_id, nested_offset,
+      object_handle.get_buffer(), object_handle.get_data_size(), put_handle));
+  ASSERT_EQ(handle.get_dict_size(), put_handle.get_dict_size());
+  ASSERT_EQ(0, MEMCMP(handle.get_dict_buf(), put_handle.get_dict_buf(), handle.get_dict_size()));
+  // a buffer without the whole first micro block is rejected
+  ASSERT_NE(OB_SUCCESS, dict_cache.put_dict(tenant_id_, macro_id, nested_offset,
+      object_handle.get_buffer(), DIO_READ_ALIGN_SIZE / 8, put_handle));
+}
+
+TEST_F(TestMicroBlockDictCache, test_scan_with_cold_cache)
+{
+  ObMicroBlockDictCache &dict_cache = OB_STORE_CACHE.get_micro_block_dict_cache();
+  const int64_t nested_offset = sstable_.meta_->macro_info_.nested_offset_;
+  MacroBlockId macro_id;
+  ObMicroBlockDictHandle handle;
+  int64_t row_count = 0;
+  get_data_macro_id(macro_id);
+  ASSERT_LT(0, nested_offset);
+
+  // the dict is read along with the prefetched micro blocks, without sync io
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().erase_cache(tenant_id_, "micro_block_dict_cache"));
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().erase_cache(tenant_id_, "user_block_cache"));
+  scan_all_rows(row_count);
+  ASSERT_EQ(row_cnt_, row_count);
+  ASSERT_EQ(OB_SUCCESS, dict_cache.get_cached_dict(tenant_id_, macro_id, nested_offset, handle));
+  ASSERT_TRUE(handle.is_valid());
+
+  // scan again with the dict cached
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().erase_cache(tenant_id_, "user_block_cache"));
+  scan_all_rows(row_count);
+  ASSERT_EQ(row_cnt_, row_count);
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_micro_block_dict_cache.log*");
+  OB_LOGGER.set_file_name("test_micro_block_dict_cache.log", true, true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
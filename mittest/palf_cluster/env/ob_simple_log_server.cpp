@@ -45,6 +45,8 @@ using namespace palf;
 using namespace palf::election;
 using namespace logservice;
 
+int64_t log_writer_batch_latency_target_us_arg = 0;
+
 uint32_t get_local_addr(const char *dev_name)
 {
   int fd, intrface;
@@ -249,6 +251,7 @@ int ObSimpleLogServer::init_log_service_(const std::string &cluster_name)
   opts.disk_options_.log_disk_throttling_percentage_ = 100;
   opts.disk_options_.log_disk_throttling_maximum_duration_ = 2 * 3600 * 1000 * 1000L;
   opts.disk_options_.log_writer_parallelism_ = 2;
+  opts.disk_options_.log_writer_batch_latency_target_us_ = log_writer_batch_latency_target_us_arg;
 
   std::string clog_dir = clog_dir_ + "/tenant_1";
   allocator_ = OB_NEW(ObTenantMutilAllocator, "TestBase", node_id_);
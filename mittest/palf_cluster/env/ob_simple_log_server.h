@@ -63,6 +63,8 @@ using namespace oceanbase::share;
 
 uint32_t get_local_addr(const char *dev_name);
 std::string get_local_ip();
+// latency target of LogIOWorker batches, 0 means batching as many logs as possible
+extern int64_t log_writer_batch_latency_target_us_arg;
 
 struct LossConfig
 {
@@ -3,6 +3,8 @@ TEST_MACHINE1='SERVER_IP1'
 TEST_MACHINE2='SERVER_IP2'
 TEST_MACHINE3='SERVER_IP3'
 USER_NAME='USERNAME'
+# latency target(us) of LogIOWorker batches, 0 means batching as many logs as possible
+BATCH_LATENCY_TARGET_US=0
 # use your own data dir path
 TARGET_PATH='/yourworkdir'
 
@@ -68,17 +70,17 @@ function startserver
 ssh $USERNAME@$TEST_MACHINE1 bash -s << EOF
     export LD_LIBRARY_PATH=$TARGET_PATH;
     cd $TARGET_PATH;
-    ./test_palf_bench_server $1 $2 > /dev/null 2>&1 &
+    ./test_palf_bench_server $1 $2 $BATCH_LATENCY_TARGET_US > /dev/null 2>&1 &
 EOF
 ssh $USERNAME@$TEST_MACHINE2 bash -s << EOF
     export LD_LIBRARY_PATH=$TARGET_PATH;
     cd $TARGET_PATH;
-    ./test_palf_bench_server $1 $2 > /dev/null 2>&1 &
+    ./test_palf_bench_server $1 $2 $BATCH_LATENCY_TARGET_US > /dev/null 2>&1 &
 EOF
 ssh $USERNAME@$TEST_MACHINE3 bash -s << EOF
     export LD_LIBRARY_PATH=$TARGET_PATH;
     cd $TARGET_PATH;
-    ./test_palf_bench_server $1 $2 > /dev/null 2>&1 &
+    ./test_palf_bench_server $1 $2 $BATCH_LATENCY_TARGET_US > /dev/null 2>&1 &
 EOF
   sleep 5
   echo "startserver success"
@@ -131,6 +133,7 @@ result_dir_name="palf_raw_result_"$5
 append_result_name=$result_dir_name"/palf_append_"$1"_"$2"_"$3"_"$4".result"
 io_result_name=$result_dir_name"/palf_io_"$1"_"$2"_"$3"_"$4".result"
 group_result_name=$result_dir_name"/palf_group_"$1"_"$2"_"$3"_"$4".result"
+io_batch_result_name=$result_dir_name"/palf_io_batch_"$1"_"$2"_"$3"_"$4".result"
 
 ssh $USERNAME@$TEST_MACHINE1 bash -s << EOF
     cd $TARGET_PATH;
@@ -138,6 +141,7 @@ ssh $USERNAME@$TEST_MACHINE1 bash -s << EOF
     grep l_append palf_cluster_bench_server/palf_cluster_bench_server.log | grep -v 'append_cnt=[0-9],'  > $append_result_name;
     grep inner_write_impl_ palf_cluster_bench_server/palf_cluster_bench_server.log | grep -v 'l_io_cnt=[0-9],'  > $io_result_name;
     grep 'GROUP LOG INFO' palf_cluster_bench_server/palf_cluster_bench_server.log | grep -v 'total_group_log_cnt=[0-9],'  > $group_result_name;
+    grep 'IO BATCH HISTOGRAM' palf_cluster_bench_server/palf_cluster_bench_server.log > $io_batch_result_name;
 EOF
 ssh $USERNAME@$TEST_MACHINE2 bash -s << EOF
     cd $TARGET_PATH;
@@ -145,6 +149,7 @@ ssh $USERNAME@$TEST_MACHINE2 bash -s << EOF
     grep l_append palf_cluster_bench_server/palf_cluster_bench_server.log | grep -v 'append_cnt=[0-9],'  > $append_result_name;
     grep inner_write_impl_ palf_cluster_bench_server/palf_cluster_bench_server.log | grep -v 'l_io_cnt=[0-9],'  > $io_result_name;
     grep 'GROUP LOG INFO' palf_cluster_bench_server/palf_cluster_bench_server.log | grep -v 'total_group_log_cnt=[0-9],'  > $group_result_name;
+    grep 'IO BATCH HISTOGRAM' palf_cluster_bench_server/palf_cluster_bench_server.log > $io_batch_result_name;
 EOF
 ssh $USERNAME@$TEST_MACHINE3 bash -s << EOF
     cd $TARGET_PATH;
@@ -152,6 +157,7 @@ ssh $USERNAME@$TEST_MACHINE3 bash -s << EOF
     grep l_append palf_cluster_bench_server/palf_cluster_bench_server.log | grep -v 'append_cnt=[0-9],'  > $append_result_name;
     grep inner_write_impl_ palf_cluster_bench_server/palf_cluster_bench_server.log | grep -v 'l_io_cnt=[0-9],'  > $io_result_name;
     grep 'GROUP LOG INFO' palf_cluster_bench_server/palf_cluster_bench_server.log | grep -v 'total_group_log_cnt=[0-9],'  > $group_result_name;
+    grep 'IO BATCH HISTOGRAM' palf_cluster_bench_server/palf_cluster_bench_server.log > $io_batch_result_name;
 EOF
 }
 
@@ -350,6 +356,31 @@ function experiment5
   # run_experiment_once_with_failure $thread_num $log_size 1 3 1000 exp5_follower_failure follower
 }
 
+# p99 commit latency against throughput, static batching vs adaptive group commit of LogIOWorker
+function experiment6
+{
+  send_server_binary
+  log_size_array=(512)
+  thread_numbers=(1 10 50 100 500 1000 2000 5000)
+  latency_targets=(0 2000)
+
+  run_round=1
+  for latency_target in ${latency_targets[@]}
+  do
+    BATCH_LATENCY_TARGET_US=$latency_target
+    for thread_num in ${thread_numbers[@]}
+    do
+      for log_size in ${log_size_array[@]}
+      do
+        echo "start run experiment6, round: " $run_round ", thread_num: " $thread_num "log_size: " $log_size "latency_target: " $latency_target
+        run_experiment_once $thread_num $log_size 1 3 1000 exp6_batch_latency_target_$latency_target
+        let run_round++
+      done;
+    done;
+  done;
+  BATCH_LATENCY_TARGET_US=0
+}
+
 function main
 {
   # run_experiment_once 100 16 1 3 1000 exp_test_bw
@@ -358,6 +389,7 @@ function main
   # experiment4
   # experiment1_less_clients
   # experiment5
+  # experiment6
   run_experiment_once 1500 512 1 3 1000 exp_test
 }
 
@@ -140,5 +140,8 @@ int main(int argc, char **argv)
     oceanbase::unittest::thread_num_arg = strtol(argv[1], NULL, 10);
     oceanbase::unittest::nbytes_arg = strtol(argv[2], NULL, 10);
   }
+  if (argc > 3) {
+    oceanbase::unittest::log_writer_batch_latency_target_us_arg = strtol(argv[3], NULL, 10);
+  }
   RUN_SIMPLE_LOG_CLUSTER_TEST(TEST_NAME);
 }
\ No newline at end of file
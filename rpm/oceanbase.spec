@@ -1,4 +1,4 @@
 Name: %NAME
-Version:4.3.4.0
+Version:4.3.5.0
 Release: %RELEASE
 BuildRequires: binutils = 2.30
@@ -301,6 +301,7 @@ int ObCdcFetcher::do_fetch_log_(const ObCdcLSFetchLogReq &req,
   bool reach_max_lsn = false;
   int64_t scan_round_count = 0;        // epoch of fetching
   int64_t fetched_log_count = 0;       // count of log fetched
+  ObCdcTabletFilter tablet_filter;
   // The start LSN of the next RPC request.
   // 1. The initial value is start LSN of the current request. So next RPC request will retry even if without fetching one log.
   // 2. We will update next_req_lsn when fetching log, in order to help next RPC request.
@@ -309,8 +310,16 @@ int ObCdcFetcher::do_fetch_log_(const ObCdcLSFetchLogReq &req,
   resp.set_next_req_lsn(req.get_start_lsn());
   resp.set_ls_id(ls_id);
 
+  // logs of sys LS are always needed by the client
+  if (req.need_filter_tablet() && ! ls_id.is_sys_ls()) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(tablet_filter.init(req.get_tablet_white_list(), req.get_max_filter_tablet_id()))) {
+      LOG_WARN("init tablet filter failed, fetch log without filter", K(tmp_ret), K(ls_id));
+    }
+  }
+
   // execute specific logging logic
-  if (OB_FAIL(ls_fetch_log_(ls_id, end_tstamp, fetch_flag, resp, frt, reach_upper_limit,
+  if (OB_FAIL(ls_fetch_log_(ls_id, end_tstamp, fetch_flag, tablet_filter, resp, frt, reach_upper_limit,
           reach_max_lsn, scan_round_count, fetched_log_count, ctx, fetch_time_stat))) {
     LOG_WARN("ls_fetch_log_ error", KR(ret), K(ls_id), K(frt));
   } else { }
@@ -516,6 +525,7 @@ FetchMode ObCdcFetcher::get_fetch_mode_when_fetching_log_(const ClientLSCtx &ctx
 int ObCdcFetcher::ls_fetch_log_(const ObLSID &ls_id,
     const int64_t end_tstamp,
     const int8_t fetch_flag,
+    const ObCdcTabletFilter &tablet_filter,
     obrpc::ObCdcLSFetchLogResp &resp,
     FetchRunTime &frt,
     bool &reach_upper_limit,
@@ -679,7 +689,18 @@ int ObCdcFetcher::ls_fetch_log_(const ObLSID &ls_id,
       resp.set_progress(ctx.get_progress());
       // There is reserved space for the last log group entry, so we assume that the buffer is always enough here,
       // So we could fill response buffer without checking buffer full
-      if (OB_FAIL(prefill_resp_with_group_entry_(ls_id, lsn, log_group_entry, resp, fetch_time_stat))) {
+      bool is_filtered = false;
+      if (tablet_filter.is_enabled()) {
+        filter_resp_with_group_entry_(ls_id, lsn, log_group_entry, tablet_filter, resp, is_filtered);
+      }
+      if (is_filtered) {
+        // only the position of the LogGroupEntry is returned
+        fetched_log_count++;
+        if (resp.filtered_log_reach_threshold()) {
+          frt.stop("FilteredLogReachThreshold");
+        }
+        LOG_TRACE("LS filter a log", K(ls_id), K(lsn), K(fetched_log_count), K(frt));
+      } else if (OB_FAIL(prefill_resp_with_group_entry_(ls_id, lsn, log_group_entry, resp, fetch_time_stat))) {
         if (OB_BUF_NOT_ENOUGH == ret) {
           handle_when_buffer_full_(frt); // stop
           ret = OB_SUCCESS;
@@ -771,6 +792,37 @@ void ObCdcFetcher::check_next_group_entry_(const LSN &next_lsn,
   }
 }
 
+void ObCdcFetcher::filter_resp_with_group_entry_(const ObLSID &ls_id,
+    const LSN &lsn,
+    const LogGroupEntry &log_group_entry,
+    const ObCdcTabletFilter &tablet_filter,
+    obrpc::ObCdcLSFetchLogResp &resp,
+    bool &is_filtered)
+{
+  int ret = OB_SUCCESS;
+  const int64_t entry_size = log_group_entry.get_serialize_size();
+  ObCdcLSFetchLogResp::FilteredRedoArray filtered_redo_arr;
+  ObCdcLSFetchLogResp::FilteredGroup filtered_group;
+  is_filtered = false;
+
+  if (OB_FAIL(tablet_filter.filter_group_entry(lsn, log_group_entry, is_filtered, filtered_redo_arr))) {
+    LOG_WARN("filter_group_entry fail", KR(ret), K(ls_id), K(lsn), K(tablet_filter));
+  } else if (! is_filtered) {
+    // the LogGroupEntry is needed by the client
+  } else if (FALSE_IT(filtered_group.reset(lsn, entry_size,
+      log_group_entry.get_scn().get_val_for_logservice()))) {
+  } else if (OB_FAIL(resp.append_filtered_group(filtered_group, filtered_redo_arr))) {
+    LOG_WARN("append_filtered_group fail", KR(ret), K(ls_id), K(filtered_group));
+  } else {
+    // the client moves its progress over the LogGroupEntry as if it is fetched
+    resp.set_next_req_lsn(lsn + entry_size);
+  }
+
+  if (OB_FAIL(ret)) {
+    is_filtered = false;
+  }
+}
+
 int ObCdcFetcher::prefill_resp_with_group_entry_(const ObLSID &ls_id,
     const LSN &lsn,
     LogGroupEntry &log_group_entry,
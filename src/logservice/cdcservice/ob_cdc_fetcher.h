@@ -23,6 +23,7 @@
 #include "ob_cdc_raw_log_req.h"
 #include "ob_cdc_define.h"
 #include "ob_cdc_struct.h"                      // ClientLSCtx
+#include "ob_cdc_tablet_filter.h"               // ObCdcTabletFilter
 #include "logservice/archiveservice/large_buffer_pool.h" // LargeBufferPool
 #include "logservice/ob_log_handler.h" // PalfGroupBufferIterator
 
@@ -93,6 +94,7 @@ private:
   int ls_fetch_log_(const ObLSID &ls_id,
       const int64_t end_tstamp,
       const int8_t fetch_flag,
+      const ObCdcTabletFilter &tablet_filter,
       obrpc::ObCdcLSFetchLogResp &resp,
       FetchRunTime &frt,
       bool &reach_upper_limit,
@@ -187,6 +189,14 @@ private:
       LogGroupEntry &log_group_entry,
       obrpc::ObCdcLSFetchLogResp &resp,
       ObCdcFetchLogTimeStats &fetch_time_stat);
+  // Elide the LogGroupEntry which only holds redo of unsubscribed tablets, see ObCdcTabletFilter.
+  // Shipping the LogGroupEntry is always correct, so is_filtered is false if failed.
+  void filter_resp_with_group_entry_(const ObLSID &ls_id,
+      const LSN &lsn,
+      const LogGroupEntry &log_group_entry,
+      const ObCdcTabletFilter &tablet_filter,
+      obrpc::ObCdcLSFetchLogResp &resp,
+      bool &is_filtered);
   void handle_when_buffer_full_(FetchRunTime &frt);
   // lsn of ls_id wantted does not exist on this server, feed this information back to CDC Connector,
   // CDC Connector needs to change search server.
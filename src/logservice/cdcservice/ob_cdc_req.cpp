@@ -248,7 +248,10 @@ OB_DEF_DESERIALIZE(ObCdcReqStartLSNByTsResp)
  *
  */
 OB_SERIALIZE_MEMBER(ObCdcLSFetchLogReq, rpc_ver_, ls_id_, start_lsn_, upper_limit_ts_, client_pid_,
-                    client_id_, progress_, flag_, compressor_type_, tenant_id_, client_type_);
+                    client_id_, progress_, flag_, compressor_type_, tenant_id_, client_type_,
+                    tablet_white_list_, max_filter_tablet_id_);
+OB_SERIALIZE_MEMBER(ObCdcLSFetchLogResp::FilteredGroup, lsn_, group_size_, submit_ts_);
+OB_SERIALIZE_MEMBER(ObCdcLSFetchLogResp::FilteredRedo, lsn_, tx_id_, cluster_id_);
 OB_SERIALIZE_MEMBER(ObCdcFetchStatus,
                     is_reach_max_lsn_,
                     is_reach_upper_limit_ts_,
@@ -274,7 +277,7 @@ OB_DEF_SERIALIZE(ObCdcLSFetchLogResp)
       pos += pos_;
     }
   }
-  LST_DO_CODE(OB_UNIS_ENCODE, server_progress_);
+  LST_DO_CODE(OB_UNIS_ENCODE, server_progress_, filtered_group_arr_, filtered_redo_arr_);
 
   return ret;
 }
@@ -290,7 +293,7 @@ OB_DEF_SERIALIZE_SIZE(ObCdcLSFetchLogResp)
                 log_num_, pos_);
     len += pos_;
 
-    LST_DO_CODE(OB_UNIS_ADD_LEN, server_progress_);
+    LST_DO_CODE(OB_UNIS_ADD_LEN, server_progress_, filtered_group_arr_, filtered_redo_arr_);
   } else {
     tmp_ret = OB_NOT_SUPPORTED;
     EXTLOG_LOG_RET(ERROR, tmp_ret, "get serialize size error, version not match",
@@ -318,7 +321,10 @@ OB_DEF_DESERIALIZE(ObCdcLSFetchLogResp)
       pos += pos_;
     }
 
-    LST_DO_CODE(OB_UNIS_DECODE, server_progress_);
+    // the filtered arrays are absent in the response of old server
+    filtered_group_arr_.reset();
+    filtered_redo_arr_.reset();
+    LST_DO_CODE(OB_UNIS_DECODE, server_progress_, filtered_group_arr_, filtered_redo_arr_);
   } else {
     ret = OB_NOT_SUPPORTED;
     EXTLOG_LOG(ERROR, "deserialize error, version not match",
@@ -341,10 +347,13 @@ void ObCdcLSFetchLogReq::reset()
   tenant_id_ = OB_INVALID_TENANT_ID;
   compressor_type_ = ObCompressorType::INVALID_COMPRESSOR;
   client_type_ = ObCdcClientType::CLIENT_TYPE_UNKNOWN;
+  tablet_white_list_.reset();
+  max_filter_tablet_id_.reset();
 }
 
 ObCdcLSFetchLogReq& ObCdcLSFetchLogReq::operator=(const ObCdcLSFetchLogReq &other)
 {
+  int tmp_ret = OB_SUCCESS;
   rpc_ver_ = other.rpc_ver_;
   ls_id_ = other.ls_id_;
   start_lsn_ = other.start_lsn_;
@@ -356,6 +365,12 @@ ObCdcLSFetchLogReq& ObCdcLSFetchLogReq::operator=(const ObCdcLSFetchLogReq &othe
   tenant_id_ = other.tenant_id_;
   compressor_type_ = other.compressor_type_;
   client_type_ = other.client_type_;
+  if (OB_SUCCESS != (tmp_ret = tablet_white_list_.assign(other.tablet_white_list_))) {
+    // without white list all logs are fetched, which is always correct
+    tablet_white_list_.reset();
+    EXTLOG_LOG_RET(WARN, tmp_ret, "assign tablet_white_list failed, tablet filter is disabled", K(tmp_ret));
+  }
+  max_filter_tablet_id_ = other.max_filter_tablet_id_;
   return *this;
 }
 
@@ -371,7 +386,9 @@ bool ObCdcLSFetchLogReq::operator==(const ObCdcLSFetchLogReq &that) const
     && flag_ == that.flag_
     && tenant_id_ == that.tenant_id_
     && compressor_type_ == that.compressor_type_
-    && client_type_ == that.client_type_;
+    && client_type_ == that.client_type_
+    && is_array_equal(tablet_white_list_, that.tablet_white_list_)
+    && max_filter_tablet_id_ == that.max_filter_tablet_id_;
 }
 
 bool ObCdcLSFetchLogReq::operator!=(const ObCdcLSFetchLogReq &that) const
@@ -411,6 +428,22 @@ int ObCdcLSFetchLogReq::set_upper_limit_ts(const int64_t ts)
   return ret;
 }
 
+int ObCdcLSFetchLogReq::set_tablet_white_list(const TabletWhiteList &tablet_white_list,
+    const common::ObTabletID &max_filter_tablet_id)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_FAIL(tablet_white_list_.assign(tablet_white_list))) {
+    tablet_white_list_.reset();
+    max_filter_tablet_id_.reset();
+    EXTLOG_LOG(WARN, "assign tablet_white_list failed", K(ret), "count", tablet_white_list.count());
+  } else {
+    max_filter_tablet_id_ = max_filter_tablet_id;
+  }
+
+  return ret;
+}
+
 /*
 int ObCdcRespBuf::append_log_group_entry(const LogGroupEntry &entry)
 {
@@ -463,6 +496,32 @@ int ObCdcLSFetchLogResp::assign(const ObCdcLSFetchLogResp &other)
     if (log_num_ > 0 && pos_ > 0) {
       (void)MEMCPY(log_entry_buf_, other.log_entry_buf_, pos_);
     }
+
+    if (OB_FAIL(filtered_group_arr_.assign(other.filtered_group_arr_))) {
+      EXTLOG_LOG(WARN, "assign filtered_group_arr failed", K(ret));
+    } else if (OB_FAIL(filtered_redo_arr_.assign(other.filtered_redo_arr_))) {
+      EXTLOG_LOG(WARN, "assign filtered_redo_arr failed", K(ret));
+    }
+  }
+
+  return ret;
+}
+
+int ObCdcLSFetchLogResp::append_filtered_group(const FilteredGroup &group,
+    const FilteredRedoArray &redo_arr)
+{
+  int ret = OB_SUCCESS;
+  const int64_t redo_count = filtered_redo_arr_.count();
+
+  if (OB_FAIL(filtered_group_arr_.push_back(group))) {
+    EXTLOG_LOG(WARN, "push back filtered group failed", K(ret), K(group));
+  } else if (OB_FAIL(append(filtered_redo_arr_, redo_arr))) {
+    EXTLOG_LOG(WARN, "append filtered redo failed", K(ret), K(group), "count", redo_arr.count());
+    // keep the arrays consistent, the group will be filled in log_entry_buf_ by caller
+    filtered_group_arr_.pop_back();
+    while (filtered_redo_arr_.count() > redo_count) {
+      filtered_redo_arr_.pop_back();
+    }
   }
 
   return ret;
@@ -481,6 +540,40 @@ void ObCdcLSFetchLogResp::reset()
   pos_ = 0;
   log_entry_buf_[0] = '\0';
   server_progress_ = OB_INVALID_TIMESTAMP;
+  filtered_group_arr_.reset();
+  filtered_redo_arr_.reset();
+}
+
+void ObCdcLSFetchLogResp::FilteredGroup::reset()
+{
+  lsn_.reset();
+  group_size_ = 0;
+  submit_ts_ = OB_INVALID_TIMESTAMP;
+}
+
+void ObCdcLSFetchLogResp::FilteredGroup::reset(const LSN &lsn,
+    const int64_t group_size,
+    const int64_t submit_ts)
+{
+  lsn_ = lsn;
+  group_size_ = group_size;
+  submit_ts_ = submit_ts;
+}
+
+void ObCdcLSFetchLogResp::FilteredRedo::reset()
+{
+  lsn_.reset();
+  tx_id_ = 0;
+  cluster_id_ = 0;
+}
+
+void ObCdcLSFetchLogResp::FilteredRedo::reset(const LSN &lsn,
+    const int64_t tx_id,
+    const uint64_t cluster_id)
+{
+  lsn_ = lsn;
+  tx_id_ = tx_id;
+  cluster_id_ = cluster_id;
 }
 
 /*
@@ -15,6 +15,7 @@
 
 #include "observer/ob_server_struct.h"          // GCTX
 #include "share/ob_ls_id.h"                     // ObLSID
+#include "common/ob_tablet_id.h"                // ObTabletID
 #include "lib/compress/ob_compress_util.h"      // ObCompressorType
 #include "logservice/palf/lsn.h"                // LSN
 #include "ob_cdc_req_struct.h"
@@ -152,6 +153,8 @@ private:
 class ObCdcLSFetchLogReq
 {
   static const int64_t CUR_RPC_VER = 1;
+public:
+  typedef common::ObSEArray<common::ObTabletID, 16> TabletWhiteList;
 public:
   ObCdcLSFetchLogReq() { reset(); }
   ~ObCdcLSFetchLogReq() {}
@@ -193,6 +196,12 @@ public:
   void set_compressor_type(const common::ObCompressorType &compressor_type) { compressor_type_ = compressor_type; }
   common::ObCompressorType get_compressor_type() const { return compressor_type_; }
 
+  int set_tablet_white_list(const TabletWhiteList &tablet_white_list,
+      const common::ObTabletID &max_filter_tablet_id);
+  const TabletWhiteList &get_tablet_white_list() const { return tablet_white_list_; }
+  const common::ObTabletID &get_max_filter_tablet_id() const { return max_filter_tablet_id_; }
+  bool need_filter_tablet() const { return tablet_white_list_.count() > 0 && max_filter_tablet_id_.is_valid(); }
+
   TO_STRING_KV(K_(rpc_ver),
       K_(ls_id),
       K_(start_lsn),
@@ -202,7 +211,9 @@ public:
       K_(progress),
       K_(flag),
       K_(compressor_type),
-      K_(tenant_id));
+      K_(tenant_id),
+      "tablet_white_list_count", tablet_white_list_.count(),
+      K_(max_filter_tablet_id));
 
   OB_UNIS_VERSION(1);
 
@@ -224,6 +235,11 @@ private:
   common::ObCompressorType compressor_type_;
   uint64_t tenant_id_;
   ObCdcClientType client_type_;
+  // the tablets subscribed by the client, empty means all tablets are subscribed.
+  // the server elides the LogGroupEntry which only holds redo of other user tablets, see ObCdcTabletFilter.
+  TabletWhiteList tablet_white_list_;
+  // only the user tablets not greater than it can be elided, the client may not know the tablets created later
+  common::ObTabletID max_filter_tablet_id_;
 };
 
 // Statistics for LS
@@ -281,6 +297,35 @@ struct ObCdcFetchStatus
 class ObCdcLSFetchLogResp
 {
   static const int64_t CUR_RPC_VER = 1;
+public:
+  // LogGroupEntry elided by the tablet filter of the request, which is not filled in log_entry_buf_.
+  // The client has to move its progress over it.
+  struct FilteredGroup
+  {
+    LSN lsn_;
+    int64_t group_size_;
+    int64_t submit_ts_;
+
+    void reset();
+    void reset(const LSN &lsn, const int64_t group_size, const int64_t submit_ts);
+    TO_STRING_KV(K_(lsn), K_(group_size), K_(submit_ts));
+    OB_UNIS_VERSION(1);
+  };
+  // Redo LogEntry in the elided LogGroupEntry, the client marks it as fetched
+  // in its transaction so that the commit won't wait for it.
+  struct FilteredRedo
+  {
+    LSN lsn_;
+    int64_t tx_id_;
+    uint64_t cluster_id_;
+
+    void reset();
+    void reset(const LSN &lsn, const int64_t tx_id, const uint64_t cluster_id);
+    TO_STRING_KV(K_(lsn), K_(tx_id), K_(cluster_id));
+    OB_UNIS_VERSION(1);
+  };
+  typedef common::ObSEArray<FilteredGroup, 16> FilteredGroupArray;
+  typedef common::ObSEArray<FilteredRedo, 16> FilteredRedoArray;
 public:
   ObCdcLSFetchLogResp() { reset(); }
   ~ObCdcLSFetchLogResp() { reset(); }
@@ -358,6 +403,17 @@ public:
   bool log_reach_threshold() const {
     return pos_ > FETCH_BUF_THRESHOLD;
   }
+
+  // For Fetch GroupLogEntry with tablet filter
+  // Filtered groups are in the order of LSN, and the LogGroupEntries filled in log_entry_buf_ are
+  // the ones between them.
+  int append_filtered_group(const FilteredGroup &group, const FilteredRedoArray &redo_arr);
+  const FilteredGroupArray &get_filtered_group_arr() const { return filtered_group_arr_; }
+  const FilteredRedoArray &get_filtered_redo_arr() const { return filtered_redo_arr_; }
+  bool filtered_log_reach_threshold() const {
+    return filtered_group_arr_.count() >= FILTERED_ITEM_CNT_LMT
+        || filtered_redo_arr_.count() >= FILTERED_ITEM_CNT_LMT;
+  }
   bool is_valid() const
   {
     return pos_ >= 0 && pos_ <= FETCH_BUF_LEN;
@@ -372,12 +428,15 @@ public:
       K_(fetch_status),
       K_(next_req_lsn),
       K_(log_num),
-      K_(pos));
+      K_(pos),
+      "filtered_group_count", filtered_group_arr_.count(),
+      "filtered_redo_count", filtered_redo_arr_.count());
   OB_UNIS_VERSION(1);
 
 public:
   static const int64_t FETCH_BUF_LEN = 17L << 20; // 17MB
   static const int64_t FETCH_BUF_THRESHOLD = FETCH_BUF_LEN - palf::MAX_LOG_BUFFER_SIZE;
+  static const int64_t FILTERED_ITEM_CNT_LMT = 10000; // Around 400kb for cur version.
 
 private:
   int64_t rpc_ver_;
@@ -391,6 +450,8 @@ private:
   int64_t pos_;
   char log_entry_buf_[FETCH_BUF_LEN];
   int64_t server_progress_;
+  FilteredGroupArray filtered_group_arr_;
+  FilteredRedoArray filtered_redo_arr_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObCdcLSFetchLogResp);
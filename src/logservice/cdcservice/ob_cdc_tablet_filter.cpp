@@ -0,0 +1,223 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX EXTLOG
+#include "ob_cdc_tablet_filter.h"
+#include "lib/utility/ob_sort.h"                  // ob_sort
+#include "logservice/ob_log_base_header.h"        // ObLogBaseHeader
+#include "storage/tx/ob_tx_log.h"                 // ObTxLogBlock
+#include "storage/memtable/ob_memtable_mutator.h" // ObMemtableMutatorMeta
+#include "storage/memtable/ob_memtable_context.h" // ObTransRowFlag
+
+namespace oceanbase
+{
+using namespace obrpc;
+using namespace oceanbase::palf;
+
+namespace cdc
+{
+int ObCdcTabletFilter::init(const ObCdcLSFetchLogReq::TabletWhiteList &tablet_white_list,
+    const common::ObTabletID &max_tablet_id)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(! max_tablet_id.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid max tablet id", KR(ret), K(max_tablet_id));
+  } else if (OB_FAIL(tablet_ids_.assign(tablet_white_list))) {
+    LOG_WARN("assign tablet white list failed", KR(ret), "count", tablet_white_list.count());
+  } else {
+    lib::ob_sort(tablet_ids_.begin(), tablet_ids_.end());
+    max_tablet_id_ = max_tablet_id;
+  }
+
+  if (OB_FAIL(ret)) {
+    reset();
+  }
+
+  return ret;
+}
+
+int ObCdcTabletFilter::filter_group_entry(const LSN &group_lsn,
+    const LogGroupEntry &group_entry,
+    bool &is_filtered,
+    ObCdcLSFetchLogResp::FilteredRedoArray &filtered_redo_arr) const
+{
+  int ret = OB_SUCCESS;
+  const char *buf = group_entry.get_data_buf();
+  const int64_t data_len = group_entry.get_data_len();
+  const LSN data_start_lsn = group_lsn + group_entry.get_header_size();
+  int64_t pos = 0;
+  is_filtered = is_enabled()
+      && ! group_entry.get_header().is_padding_log()
+      && NULL != buf
+      && data_len > 0;
+  filtered_redo_arr.reset();
+
+  while (OB_SUCC(ret) && is_filtered && pos < data_len) {
+    LogEntry log_entry;
+    const int64_t entry_pos = pos;
+    int64_t tx_id = 0;
+    uint64_t cluster_id = 0;
+    ObCdcLSFetchLogResp::FilteredRedo filtered_redo;
+
+    if (OB_FAIL(log_entry.deserialize(buf, data_len, pos))) {
+      LOG_WARN("LogEntry deserialize failed", KR(ret), K(group_lsn), K(data_len), K(pos));
+    } else if (OB_FAIL(filter_log_entry_(log_entry, is_filtered, tx_id, cluster_id))) {
+      LOG_WARN("filter_log_entry_ failed", KR(ret), K(group_lsn), K(entry_pos));
+    } else if (is_filtered) {
+      filtered_redo.reset(data_start_lsn + entry_pos, tx_id, cluster_id);
+      if (OB_FAIL(filtered_redo_arr.push_back(filtered_redo))) {
+        LOG_WARN("push back filtered redo failed", KR(ret), K(filtered_redo));
+      }
+    }
+  }
+
+  if (OB_FAIL(ret) || ! is_filtered) {
+    is_filtered = false;
+    filtered_redo_arr.reset();
+  }
+
+  return ret;
+}
+
+int ObCdcTabletFilter::filter_log_entry_(const LogEntry &log_entry,
+    bool &is_filtered,
+    int64_t &tx_id,
+    uint64_t &cluster_id) const
+{
+  int ret = OB_SUCCESS;
+  const char *buf = log_entry.get_data_buf();
+  const int64_t buf_len = log_entry.get_data_len();
+  int64_t pos = 0;
+  logservice::ObLogBaseHeader base_header;
+  is_filtered = false;
+
+  if (OB_FAIL(base_header.deserialize(buf, buf_len, pos))) {
+    LOG_WARN("ObLogBaseHeader deserialize failed", KR(ret), K(buf_len), K(pos));
+  } else if (logservice::ObLogBaseType::TRANS_SERVICE_LOG_BASE_TYPE != base_header.get_log_type()
+      || base_header.is_compressed()) {
+    // not a transaction log, or can't be parsed without decompression
+  } else {
+    transaction::ObTxLogBlock tx_log_block;
+    transaction::ObTxLogHeader tx_header;
+    bool has_redo = false;
+    is_filtered = true;
+
+    if (OB_FAIL(tx_log_block.init_for_replay(buf, buf_len, static_cast<int>(pos)))) {
+      LOG_WARN("ObTxLogBlock init_for_replay failed", KR(ret), K(buf_len), K(pos));
+    }
+
+    while (OB_SUCC(ret) && is_filtered) {
+      if (OB_FAIL(tx_log_block.get_next_log(tx_header))) {
+        if (OB_ITER_END != ret && OB_LOG_ALREADY_SPLIT != ret) {
+          LOG_WARN("ObTxLogBlock get_next_log failed", KR(ret), K(tx_header));
+        }
+      } else if (transaction::ObTxLogType::TX_REDO_LOG != tx_header.get_tx_log_type()) {
+        is_filtered = false;
+      } else {
+        transaction::ObTxRedoLogTempRef tmp_ref;
+        transaction::ObTxRedoLog redo_log(tmp_ref);
+
+        if (OB_FAIL(tx_log_block.deserialize_log_body(redo_log))) {
+          LOG_WARN("deserialize ObTxRedoLog failed", KR(ret), K(tx_header));
+        } else if (OB_FAIL(filter_mutator_(redo_log.get_replay_mutator_buf(),
+            redo_log.get_mutator_size(), is_filtered))) {
+          LOG_WARN("filter_mutator_ failed", KR(ret), K(redo_log));
+        } else {
+          has_redo = true;
+        }
+      }
+    }
+
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+      is_filtered = is_filtered && has_redo;
+    } else if (OB_LOG_ALREADY_SPLIT == ret) {
+      // big segment log is reassembled by the client, keep it
+      ret = OB_SUCCESS;
+      is_filtered = false;
+    }
+
+    if (OB_SUCC(ret) && is_filtered) {
+      tx_id = tx_log_block.get_header().get_tx_id().get_id();
+      cluster_id = tx_log_block.get_header().get_org_cluster_id();
+    }
+  }
+
+  return ret;
+}
+
+int ObCdcTabletFilter::filter_mutator_(const char *buf,
+    const int64_t buf_len,
+    bool &is_filtered) const
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  memtable::ObMemtableMutatorMeta meta;
+  is_filtered = false;
+
+  if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid mutator buf", KR(ret), KP(buf), K(buf_len));
+  } else if (OB_FAIL(meta.deserialize(buf, buf_len, pos))) {
+    LOG_WARN("ObMemtableMutatorMeta deserialize failed", KR(ret), K(buf_len), K(pos));
+  } else if (! memtable::ObTransRowFlag::is_normal_row(meta.get_flags())) {
+    // big row is split into several redo logs, keep it
+  } else {
+    is_filtered = true;
+
+    while (OB_SUCC(ret) && is_filtered && pos < buf_len) {
+      memtable::ObMutatorRowHeader row_header;
+      int64_t row_pos = 0;
+      int32_t row_size = 0;
+
+      if (OB_FAIL(row_header.deserialize(buf, buf_len, pos))) {
+        LOG_WARN("ObMutatorRowHeader deserialize failed", KR(ret), K(buf_len), K(pos));
+      } else if (FALSE_IT(row_pos = pos)) {
+      } else if (OB_FAIL(serialization::decode_i32(buf, buf_len, row_pos, &row_size))) {
+        LOG_WARN("decode row size failed", KR(ret), K(buf_len), K(row_pos));
+      } else if (OB_UNLIKELY(row_size <= 0 || pos + row_size > buf_len)) {
+        ret = OB_INVALID_DATA;
+        LOG_WARN("invalid row size", KR(ret), K(row_size), K(pos), K(buf_len), K(row_header));
+      } else if (memtable::MutatorType::MUTATOR_TABLE_LOCK != row_header.mutator_type_
+          && is_subscribed_(row_header.tablet_id_)) {
+        is_filtered = false;
+      } else {
+        // the size of row body is encoded at its beginning
+        pos += row_size;
+      }
+    }
+  }
+
+  return ret;
+}
+
+bool ObCdcTabletFilter::is_subscribed_(const common::ObTabletID &tablet_id) const
+{
+  bool bool_ret = true;
+
+  // inner tablets are always sent, the client needs them to build its schema and data dictionary.
+  // the tablets created after the client built the white list are sent too, the client may not
+  // have handled their DDL yet.
+  if (tablet_id.is_valid() && tablet_id.is_user_tablet() && tablet_id <= max_tablet_id_) {
+    const common::ObTabletID *begin = tablet_ids_.get_data();
+    const common::ObTabletID *end = begin + tablet_ids_.count();
+    const common::ObTabletID *iter = std::lower_bound(begin, end, tablet_id);
+    bool_ret = (end != iter && *iter == tablet_id);
+  }
+
+  return bool_ret;
+}
+
+} // namespace cdc
+} // namespace oceanbase
@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_LOGSERVICE_OB_CDC_TABLET_FILTER_H_
+#define OCEANBASE_LOGSERVICE_OB_CDC_TABLET_FILTER_H_
+
+#include "common/ob_tablet_id.h"                // ObTabletID
+#include "logservice/palf/lsn.h"                // LSN
+#include "logservice/palf/log_group_entry.h"    // LogGroupEntry
+#include "logservice/palf/log_entry.h"          // LogEntry
+#include "ob_cdc_req.h"                         // ObCdcLSFetchLogReq, ObCdcLSFetchLogResp
+
+namespace oceanbase
+{
+namespace cdc
+{
+// Elide the LogGroupEntry which is useless for the client of CDC service.
+//
+// A LogGroupEntry is elided as a whole, because the client verifies the LSN continuity and the
+// accumulated checksum of LogGroupEntries, so that LogEntries can't be removed from a LogGroupEntry.
+// A LogGroupEntry is elided only if each LogEntry of it is a transaction log which only
+// holds redo of user tablets out of the white list and not greater than max_tablet_id, any other log (e.g. commit info, multi data
+// source, big segment, big row) is always sent to the client to keep the transaction boundary.
+// The LSN of each elided redo is returned with its transaction, the client treats the redo as fetched.
+class ObCdcTabletFilter
+{
+public:
+  ObCdcTabletFilter() : tablet_ids_(), max_tablet_id_() {}
+  ~ObCdcTabletFilter() { reset(); }
+  // @param [in]  tablet_white_list  the subscribed user tablets
+  // @param [in]  max_tablet_id      the user tablets greater than it are unknown to the client, they are always sent
+  int init(const obrpc::ObCdcLSFetchLogReq::TabletWhiteList &tablet_white_list,
+      const common::ObTabletID &max_tablet_id);
+  void reset() { tablet_ids_.reset(); max_tablet_id_.reset(); }
+  bool is_enabled() const { return tablet_ids_.count() > 0 && max_tablet_id_.is_valid(); }
+
+  // @param [in]  group_lsn          LSN of the LogGroupEntry
+  // @param [in]  group_entry        LogGroupEntry to check
+  // @param [out] is_filtered        whether the LogGroupEntry can be elided
+  // @param [out] filtered_redo_arr  redo LogEntries of the LogGroupEntry, valid if is_filtered is true
+  int filter_group_entry(const palf::LSN &group_lsn,
+      const palf::LogGroupEntry &group_entry,
+      bool &is_filtered,
+      obrpc::ObCdcLSFetchLogResp::FilteredRedoArray &filtered_redo_arr) const;
+
+  TO_STRING_KV("tablet_count", tablet_ids_.count(), K_(max_tablet_id), K_(tablet_ids));
+
+private:
+  int filter_log_entry_(const palf::LogEntry &log_entry,
+      bool &is_filtered,
+      int64_t &tx_id,
+      uint64_t &cluster_id) const;
+  int filter_mutator_(const char *buf, const int64_t buf_len, bool &is_filtered) const;
+  bool is_subscribed_(const common::ObTabletID &tablet_id) const;
+
+private:
+  // sorted in ascending order
+  common::ObSEArray<common::ObTabletID, 16> tablet_ids_;
+  common::ObTabletID max_tablet_id_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObCdcTabletFilter);
+};
+
+} // namespace cdc
+} // namespace oceanbase
+
+#endif
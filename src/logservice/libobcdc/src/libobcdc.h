@@ -52,6 +52,31 @@ struct ObCDCError
 
 typedef void (* ERROR_CALLBACK) (const ObCDCError &err);
 
+// DML rows of a table in the Arrow output mode (enable_output_arrow_format=1)
+struct ObCDCArrowBatch
+{
+  uint64_t tenant_id_;            ///< tenant id
+  uint64_t table_id_;             ///< table id
+  const char *db_name_;           ///< database name
+  const char *table_name_;        ///< table name
+  int64_t schema_version_;        ///< schema version of the table
+  int64_t row_count_;             ///< number of rows
+  int64_t min_commit_version_;    ///< min commit version of rows
+  int64_t max_commit_version_;    ///< max commit version of rows
+  const char *data_;              ///< Arrow IPC stream of the schema and one record batch, valid only during callback
+  int64_t data_len_;              ///< length of data_
+};
+
+/*
+ * Arrow record batch callback, the first three columns of the record batch are
+ * __record_type(EINSERT/EUPDATE/EDELETE/EPUT), __commit_version and __trans_id,
+ * followed by user columns of the table, and then __old_<column name> for each rowkey column,
+ * which holds the rowkey before UPDATE and is NULL for other record types.
+ * @retval OB_SUCCESS       success
+ * @retval other errorcode  libobcdc stops with the error
+ */
+typedef int (* ARROW_BATCH_CALLBACK) (const ObCDCArrowBatch &batch, void *cb_arg);
+
 class IObCDCInstance
 {
 public:
@@ -138,6 +163,16 @@ public:
   /// @retval OB_SUCCESS      success
   /// @retval other value     fail
   virtual int get_tenant_ids(std::vector<uint64_t> &tenant_ids) = 0;
+
+  /*
+   * set callback of Arrow record batch, must be called before launch if enable_output_arrow_format=1.
+   * In the Arrow output mode, DML rows are delivered by the callback instead of next_record, and
+   * next_record only returns DDL and HEARTBEAT records. All pending record batches are delivered
+   * before the HEARTBEAT record.
+   * @param cb       callback function pointer
+   * @param cb_arg   argument of callback
+   */
+  virtual int set_arrow_batch_callback(ARROW_BATCH_CALLBACK cb, void *cb_arg) = 0;
 };
 
 class ObCDCFactory
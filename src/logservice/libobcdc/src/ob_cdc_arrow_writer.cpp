@@ -0,0 +1,679 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * Arrow Writer: accumulate DML rows of committed transactions into Arrow record batches per table
+ */
+
+#define USING_LOG_PREFIX OBLOG
+
+#include "ob_cdc_arrow_writer.h"
+
+#include <arrow/api.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/writer.h>
+
+#include "lib/charset/ob_charset.h"                 // ObCharset
+#include "lib/worker.h"                             // is_oracle_mode
+#include "sql/engine/table/ob_parquet_table_row_iter.h" // ObArrowMemPool
+#include "ob_log_binlog_record.h"                   // ObLogBR
+#include "ob_log_utils.h"                           // print_record_type
+
+namespace oceanbase
+{
+using namespace common;
+using sql::ObArrowMemPool;
+
+namespace libobcdc
+{
+// Columns filled by libobcdc, followed by user columns in the order of the table meta,
+// and then the rowkey columns before UPDATE named with ARROW_OLD_ROWKEY_COLUMN_PREFIX
+static const char *ARROW_RECORD_TYPE_COLUMN = "__record_type";
+static const char *ARROW_COMMIT_VERSION_COLUMN = "__commit_version";
+static const char *ARROW_TRANS_ID_COLUMN = "__trans_id";
+static const int64_t ARROW_META_COLUMN_NUM = 3;
+static const char *ARROW_OLD_ROWKEY_COLUMN_PREFIX = "__old_";
+// String data of a record batch is limited to 2G by the 32-bit offsets of binary arrays,
+// flush the batch much earlier
+static const int64_t ARROW_BATCH_DATA_SIZE_LIMIT = 64 * _M_;
+static const int64_t ARROW_IPC_BUF_INIT_SIZE = 64 * _K_;
+
+static int arrow_status_to_ret(const arrow::Status &status)
+{
+  int ret = OB_SUCCESS;
+
+  if (status.ok()) {
+    ret = OB_SUCCESS;
+  } else if (status.IsOutOfMemory()) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else if (status.IsCapacityError()) {
+    ret = OB_SIZE_OVERFLOW;
+  } else {
+    ret = OB_ERR_UNEXPECTED;
+  }
+
+  return ret;
+}
+
+static bool is_utf8_collation(const ObCollationType collation_type)
+{
+  return CHARSET_UTF8MB4 == ObCharset::charset_type_by_coll(collation_type);
+}
+
+// Get the Arrow type of the column, column which has no native Arrow type is converted to string
+static std::shared_ptr<arrow::DataType> get_arrow_type(const ObObjMeta &meta)
+{
+  std::shared_ptr<arrow::DataType> type;
+
+  switch (meta.get_type()) {
+    case ObTinyIntType: type = arrow::int8(); break;
+    case ObSmallIntType: type = arrow::int16(); break;
+    case ObMediumIntType:
+    case ObInt32Type: type = arrow::int32(); break;
+    case ObIntType: type = arrow::int64(); break;
+    case ObUTinyIntType: type = arrow::uint8(); break;
+    case ObUSmallIntType: type = arrow::uint16(); break;
+    case ObUMediumIntType:
+    case ObUInt32Type: type = arrow::uint32(); break;
+    case ObUInt64Type:
+    case ObBitType: type = arrow::uint64(); break;
+    case ObFloatType:
+    case ObUFloatType: type = arrow::float32(); break;
+    case ObDoubleType:
+    case ObUDoubleType: type = arrow::float64(); break;
+    // local datetime without time zone
+    case ObDateTimeType: type = arrow::timestamp(arrow::TimeUnit::MICRO); break;
+    // mysql timestamp is stored in UTC
+    case ObTimestampType: type = arrow::timestamp(arrow::TimeUnit::MICRO, "UTC"); break;
+    case ObDateType: type = arrow::date32(); break;
+    // mysql time is in [-838:59:59, 838:59:59], out of the range of time of day
+    case ObTimeType: type = arrow::duration(arrow::TimeUnit::MICRO); break;
+    case ObVarcharType:
+    case ObCharType:
+    case ObTinyTextType:
+    case ObTextType:
+    case ObMediumTextType:
+    case ObLongTextType:
+      // string of other charsets is output as it is stored
+      type = is_utf8_collation(meta.get_collation_type()) ? arrow::utf8() : arrow::binary();
+      break;
+    case ObHexStringType:
+    case ObRawType: type = arrow::binary(); break;
+    default: type = arrow::utf8(); break;
+  }
+
+  return type;
+}
+
+struct ObCDCArrowWriter::TableBatch
+{
+  TableKey key_;
+  int64_t table_schema_version_;
+  std::string db_name_;
+  std::string table_name_;
+  std::shared_ptr<arrow::Schema> schema_;
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> builders_;
+  int64_t row_count_;
+  int64_t data_size_;
+  int64_t min_commit_version_;
+  int64_t max_commit_version_;
+
+  TableBatch() :
+      key_(),
+      table_schema_version_(OB_INVALID_VERSION),
+      db_name_(),
+      table_name_(),
+      schema_(),
+      builders_(),
+      row_count_(0),
+      data_size_(0),
+      min_commit_version_(OB_INVALID_VERSION),
+      max_commit_version_(OB_INVALID_VERSION)
+  {}
+
+  void reuse()
+  {
+    row_count_ = 0;
+    data_size_ = 0;
+    min_commit_version_ = OB_INVALID_VERSION;
+    max_commit_version_ = OB_INVALID_VERSION;
+  }
+
+  TO_STRING_KV(K_(key), K_(table_schema_version), "db_name", db_name_.c_str(),
+      "table_name", table_name_.c_str(), K_(row_count), K_(data_size),
+      K_(min_commit_version), K_(max_commit_version));
+};
+
+ObCDCArrowWriter::ObCDCArrowWriter() :
+    inited_(false),
+    batch_row_count_(0),
+    cb_(NULL),
+    cb_arg_(NULL),
+    pool_(NULL),
+    batch_map_(),
+    batches_(),
+    lock_()
+{
+}
+
+ObCDCArrowWriter::~ObCDCArrowWriter()
+{
+  destroy();
+}
+
+int ObCDCArrowWriter::init(const int64_t batch_row_count)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_ERROR("ObCDCArrowWriter init twice", KR(ret));
+  } else if (OB_UNLIKELY(batch_row_count <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("invalid argument", KR(ret), K(batch_row_count));
+  } else if (OB_FAIL(batch_map_.create(BATCH_MAP_BUCKET_NUM, "CDCArrowBatch"))) {
+    LOG_ERROR("create batch_map_ failed", KR(ret));
+  } else if (OB_ISNULL(pool_ = OB_NEW(ObArrowMemPool, "CDCArrowPool"))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_ERROR("allocate ObArrowMemPool failed", KR(ret));
+  } else {
+    pool_->init(OB_SERVER_TENANT_ID);
+    batch_row_count_ = batch_row_count;
+    inited_ = true;
+    LOG_INFO("ObCDCArrowWriter init succ", K(batch_row_count));
+  }
+
+  return ret;
+}
+
+void ObCDCArrowWriter::destroy()
+{
+  for (int64_t idx = 0; idx < batches_.count(); idx++) {
+    TableBatch *batch = batches_.at(idx);
+
+    if (NULL != batch) {
+      if (batch->row_count_ > 0) {
+        LOG_WARN_RET(OB_SUCCESS, "discard pending arrow record batch", KPC(batch));
+      }
+      OB_DELETE(TableBatch, "CDCArrowBatch", batch);
+    }
+  }
+  batches_.reset();
+  (void)batch_map_.destroy();
+
+  // builders allocate memory from pool_, release it after all batches
+  if (NULL != pool_) {
+    OB_DELETE(ObArrowMemPool, "CDCArrowPool", pool_);
+    pool_ = NULL;
+  }
+
+  inited_ = false;
+  batch_row_count_ = 0;
+  cb_ = NULL;
+  cb_arg_ = NULL;
+}
+
+void ObCDCArrowWriter::set_callback(ARROW_BATCH_CALLBACK cb, void *cb_arg)
+{
+  lib::ObMutexGuard guard(lock_);
+  cb_ = cb;
+  cb_arg_ = cb_arg;
+}
+
+void ObCDCArrowWriter::configure(const int64_t batch_row_count)
+{
+  if (batch_row_count > 0) {
+    ATOMIC_STORE(&batch_row_count_, batch_row_count);
+  }
+}
+
+bool ObCDCArrowWriter::is_native_type(const ObObjMeta &meta)
+{
+  bool bool_ret = false;
+
+  switch (meta.get_type()) {
+    case ObTinyIntType:
+    case ObSmallIntType:
+    case ObMediumIntType:
+    case ObInt32Type:
+    case ObIntType:
+    case ObUTinyIntType:
+    case ObUSmallIntType:
+    case ObUMediumIntType:
+    case ObUInt32Type:
+    case ObUInt64Type:
+    case ObBitType:
+    case ObFloatType:
+    case ObUFloatType:
+    case ObDoubleType:
+    case ObUDoubleType:
+    case ObDateTimeType:
+    case ObTimestampType:
+    case ObDateType:
+    case ObTimeType:
+    case ObVarcharType:
+    case ObTinyTextType:
+    case ObTextType:
+    case ObMediumTextType:
+    case ObLongTextType:
+    case ObHexStringType:
+    case ObRawType:
+      bool_ret = true;
+      break;
+    // char of oracle mode is padded with spaces by ObObj2strHelper
+    case ObCharType:
+      bool_ret = ! lib::is_oracle_mode();
+      break;
+    default:
+      bool_ret = false;
+      break;
+  }
+
+  return bool_ret;
+}
+
+int ObCDCArrowWriter::append(ObLogBR &br, const transaction::ObTransID &trans_id)
+{
+  int ret = OB_SUCCESS;
+  const ObCDCArrowRow *row = br.get_arrow_row();
+  TableBatch *batch = NULL;
+  lib::ObMutexGuard guard(lock_);
+
+  if (OB_UNLIKELY(! inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_ERROR("ObCDCArrowWriter has not been initialized", KR(ret));
+  } else if (OB_ISNULL(row) || OB_ISNULL(row->cells_) || OB_UNLIKELY(row->column_num_ <= 0)
+      || OB_UNLIKELY(row->rowkey_num_ < 0)
+      || (row->rowkey_num_ > 0 && (OB_ISNULL(row->rowkey_idxs_) || OB_ISNULL(row->old_rowkey_cells_)))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("invalid arrow row", KR(ret), KPC(row), K(br));
+  } else if (OB_FAIL(get_table_batch_(br, *row, batch))) {
+    if (OB_IN_STOP_STATE != ret) {
+      LOG_ERROR("get_table_batch_ failed", KR(ret), KPC(row));
+    }
+  } else if (OB_FAIL(append_row_(*row, br.get_commit_version(), trans_id, *batch))) {
+    LOG_ERROR("append_row_ failed", KR(ret), KPC(row), K(trans_id), KPC(batch));
+  } else if (batch->row_count_ >= ATOMIC_LOAD(&batch_row_count_)
+      || batch->data_size_ >= ARROW_BATCH_DATA_SIZE_LIMIT) {
+    if (OB_FAIL(flush_batch_(*batch))) {
+      LOG_ERROR("flush_batch_ failed", KR(ret), KPC(batch));
+    }
+  }
+
+  return ret;
+}
+
+int ObCDCArrowWriter::flush()
+{
+  int ret = OB_SUCCESS;
+  lib::ObMutexGuard guard(lock_);
+
+  if (OB_UNLIKELY(! inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_ERROR("ObCDCArrowWriter has not been initialized", KR(ret));
+  } else {
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < batches_.count(); idx++) {
+      TableBatch *batch = batches_.at(idx);
+
+      if (OB_ISNULL(batch)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_ERROR("table batch is NULL", KR(ret), K(idx));
+      } else if (OB_FAIL(flush_batch_(*batch))) {
+        LOG_ERROR("flush_batch_ failed", KR(ret), KPC(batch));
+      }
+    }
+  }
+
+  return ret;
+}
+
+int ObCDCArrowWriter::get_table_batch_(ObLogBR &br, const ObCDCArrowRow &row, TableBatch *&batch)
+{
+  int ret = OB_SUCCESS;
+  const TableKey key(br.get_tenant_id(), row.table_id_);
+  batch = NULL;
+
+  if (OB_FAIL(batch_map_.get_refactored(key, batch))) {
+    if (OB_HASH_NOT_EXIST != ret) {
+      LOG_ERROR("get table batch failed", KR(ret), K(key));
+    } else if (OB_ISNULL(batch = OB_NEW(TableBatch, "CDCArrowBatch"))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_ERROR("allocate TableBatch failed", KR(ret), K(key));
+    } else if (FALSE_IT(batch->key_ = key)) {
+    } else if (OB_FAIL(init_table_batch_(br, row, *batch))) {
+      LOG_ERROR("init_table_batch_ failed", KR(ret), K(key), K(row));
+    } else if (OB_FAIL(batches_.push_back(batch))) {
+      LOG_ERROR("push back table batch failed", KR(ret), K(key));
+    } else if (OB_FAIL(batch_map_.set_refactored(key, batch))) {
+      LOG_ERROR("set table batch failed", KR(ret), K(key));
+      batches_.pop_back();
+    }
+
+    if (OB_FAIL(ret) && NULL != batch) {
+      OB_DELETE(TableBatch, "CDCArrowBatch", batch);
+      batch = NULL;
+    }
+  } else if (OB_ISNULL(batch)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("table batch is NULL", KR(ret), K(key));
+  } else if (batch->table_schema_version_ != row.table_schema_version_) {
+    // rows of different table schema can't be put into the same record batch
+    if (OB_FAIL(flush_batch_(*batch))) {
+      LOG_ERROR("flush_batch_ before table schema changes failed", KR(ret), KPC(batch), K(row));
+    } else if (OB_FAIL(init_table_batch_(br, row, *batch))) {
+      LOG_ERROR("init_table_batch_ failed", KR(ret), KPC(batch), K(row));
+    }
+  }
+
+  return ret;
+}
+
+int ObCDCArrowWriter::init_table_batch_(ObLogBR &br, const ObCDCArrowRow &row, TableBatch &batch)
+{
+  int ret = OB_SUCCESS;
+  IBinlogRecord *br_data = br.get_data();
+  ITableMeta *table_meta = NULL;
+  arrow::FieldVector fields;
+  std::vector<std::unique_ptr<arrow::ArrayBuilder>> builders;
+
+  if (OB_ISNULL(br_data)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("binlog record data is NULL", KR(ret), K(br));
+  } else if (OB_UNLIKELY(0 != br_data->getTableMeta(table_meta)) || OB_ISNULL(table_meta)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("get table meta of binlog record failed", KR(ret), K(br), KP(table_meta));
+  } else if (OB_UNLIKELY(table_meta->getColCount() != row.column_num_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("column count of table meta is not equal to the row", KR(ret),
+        "table_meta_column_count", table_meta->getColCount(), K(row));
+  } else {
+    fields.reserve(ARROW_META_COLUMN_NUM + row.column_num_ + row.rowkey_num_);
+    fields.push_back(arrow::field(ARROW_RECORD_TYPE_COLUMN, arrow::int8(), false));
+    fields.push_back(arrow::field(ARROW_COMMIT_VERSION_COLUMN, arrow::int64(), false));
+    fields.push_back(arrow::field(ARROW_TRANS_ID_COLUMN, arrow::int64(), false));
+
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < row.column_num_; idx++) {
+      IColMeta *col_meta = table_meta->getCol(static_cast<int>(idx));
+      const char *col_name = NULL;
+
+      if (OB_ISNULL(col_meta) || OB_ISNULL(col_name = col_meta->getName())) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_ERROR("invalid column meta", KR(ret), K(idx), KP(col_meta), K(row));
+      } else {
+        fields.push_back(arrow::field(col_name, get_arrow_type(row.cells_[idx].meta_)));
+      }
+    }
+
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < row.rowkey_num_; idx++) {
+      const int64_t column_idx = row.rowkey_idxs_[idx];
+      IColMeta *col_meta = NULL;
+      const char *col_name = NULL;
+
+      if (OB_UNLIKELY(column_idx < 0 || column_idx >= row.column_num_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_ERROR("invalid rowkey column index", KR(ret), K(idx), K(column_idx), K(row));
+      } else if (OB_ISNULL(col_meta = table_meta->getCol(static_cast<int>(column_idx)))
+          || OB_ISNULL(col_name = col_meta->getName())) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_ERROR("invalid column meta", KR(ret), K(column_idx), KP(col_meta), K(row));
+      } else {
+        fields.push_back(arrow::field(std::string(ARROW_OLD_ROWKEY_COLUMN_PREFIX) + col_name,
+            get_arrow_type(row.cells_[column_idx].meta_)));
+      }
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    std::shared_ptr<arrow::Schema> schema = arrow::schema(fields);
+    builders.resize(fields.size());
+
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < fields.size(); idx++) {
+      arrow::Status status = arrow::MakeBuilder(pool_, fields[idx]->type(), &builders[idx]);
+
+      if (OB_UNLIKELY(! status.ok())) {
+        ret = arrow_status_to_ret(status);
+        LOG_ERROR("make arrow builder failed", KR(ret), K(idx), "status", status.ToString().c_str());
+      }
+    }
+
+    if (OB_SUCC(ret)) {
+      const char *db_name = br_data->dbname();
+      const char *table_name = br_data->tbname();
+      batch.table_schema_version_ = row.table_schema_version_;
+      batch.db_name_.assign(NULL == db_name ? "" : db_name);
+      batch.table_name_.assign(NULL == table_name ? "" : table_name);
+      batch.schema_ = schema;
+      batch.builders_.swap(builders);
+      batch.reuse();
+      LOG_INFO("init arrow table batch", K(batch), "schema", schema->ToString().c_str());
+    }
+  }
+
+  return ret;
+}
+
+int ObCDCArrowWriter::append_row_(const ObCDCArrowRow &row,
+    const int64_t commit_version,
+    const transaction::ObTransID &trans_id,
+    TableBatch &batch)
+{
+  int ret = OB_SUCCESS;
+  arrow::Status status;
+
+  if (OB_UNLIKELY(batch.builders_.size() != ARROW_META_COLUMN_NUM + row.column_num_ + row.rowkey_num_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("column count of record batch is not equal to the row", KR(ret),
+        "builder_count", batch.builders_.size(), K(row), K(batch));
+  } else if (OB_UNLIKELY(! (status = static_cast<arrow::Int8Builder *>(batch.builders_[0].get())->Append(
+      static_cast<int8_t>(row.record_type_))).ok())
+      || OB_UNLIKELY(! (status = static_cast<arrow::Int64Builder *>(batch.builders_[1].get())->Append(
+      commit_version)).ok())
+      || OB_UNLIKELY(! (status = static_cast<arrow::Int64Builder *>(batch.builders_[2].get())->Append(
+      trans_id.get_id())).ok())) {
+    ret = arrow_status_to_ret(status);
+    LOG_ERROR("append meta columns failed", KR(ret), K(row), K(commit_version), K(trans_id),
+        "status", status.ToString().c_str());
+  } else {
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < row.column_num_; idx++) {
+      if (OB_FAIL(append_cell_(row.cells_[idx], ARROW_META_COLUMN_NUM + idx, batch))) {
+        LOG_ERROR("append_cell_ failed", KR(ret), K(idx), "cell", row.cells_[idx], K(row));
+      }
+    }
+
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < row.rowkey_num_; idx++) {
+      if (OB_FAIL(append_cell_(row.old_rowkey_cells_[idx], ARROW_META_COLUMN_NUM + row.column_num_ + idx, batch))) {
+        LOG_ERROR("append_cell_ of old rowkey failed", KR(ret), K(idx), "cell", row.old_rowkey_cells_[idx], K(row));
+      }
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    batch.row_count_++;
+    if (OB_INVALID_VERSION == batch.min_commit_version_) {
+      batch.min_commit_version_ = commit_version;
+    }
+    batch.max_commit_version_ = commit_version;
+  } else {
+    // the builders may be left with a partial row, discard the whole batch rather than output it
+    batch.table_schema_version_ = OB_INVALID_VERSION;
+  }
+
+  return ret;
+}
+
+int ObCDCArrowWriter::append_cell_(const ObCDCArrowRow::Cell &cell,
+    const int64_t column_idx,
+    TableBatch &batch)
+{
+  int ret = OB_SUCCESS;
+  arrow::ArrayBuilder *builder = batch.builders_[column_idx].get();
+  const ObObj *obj = cell.obj_;
+  arrow::Status status;
+
+  if ((NULL == obj && NULL == cell.str_) || (NULL != obj && obj->is_null())) {
+    status = builder->AppendNull();
+  } else if (arrow::Type::STRING == builder->type()->id() || arrow::Type::BINARY == builder->type()->id()) {
+    const ObString str = (NULL != cell.str_) ? *cell.str_ : obj->get_string();
+    status = static_cast<arrow::BinaryBuilder *>(builder)->Append(str.ptr(), str.length());
+    batch.data_size_ += str.length();
+  } else if (OB_ISNULL(obj) || OB_UNLIKELY(NULL != cell.str_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("native value of column is invalid", KR(ret), K(cell), K(column_idx),
+        "type", builder->type()->ToString().c_str());
+  } else {
+    switch (builder->type()->id()) {
+      case arrow::Type::INT8:
+        status = static_cast<arrow::Int8Builder *>(builder)->Append(static_cast<int8_t>(obj->get_int()));
+        break;
+      case arrow::Type::INT16:
+        status = static_cast<arrow::Int16Builder *>(builder)->Append(static_cast<int16_t>(obj->get_int()));
+        break;
+      case arrow::Type::INT32:
+        status = static_cast<arrow::Int32Builder *>(builder)->Append(static_cast<int32_t>(obj->get_int()));
+        break;
+      case arrow::Type::INT64:
+        status = static_cast<arrow::Int64Builder *>(builder)->Append(obj->get_int());
+        break;
+      case arrow::Type::UINT8:
+        status = static_cast<arrow::UInt8Builder *>(builder)->Append(static_cast<uint8_t>(obj->get_uint64()));
+        break;
+      case arrow::Type::UINT16:
+        status = static_cast<arrow::UInt16Builder *>(builder)->Append(static_cast<uint16_t>(obj->get_uint64()));
+        break;
+      case arrow::Type::UINT32:
+        status = static_cast<arrow::UInt32Builder *>(builder)->Append(static_cast<uint32_t>(obj->get_uint64()));
+        break;
+      case arrow::Type::UINT64:
+        status = static_cast<arrow::UInt64Builder *>(builder)->Append(
+            obj->is_bit() ? obj->get_bit() : obj->get_uint64());
+        break;
+      case arrow::Type::FLOAT:
+        status = static_cast<arrow::FloatBuilder *>(builder)->Append(obj->get_float());
+        break;
+      case arrow::Type::DOUBLE:
+        status = static_cast<arrow::DoubleBuilder *>(builder)->Append(obj->get_double());
+        break;
+      case arrow::Type::TIMESTAMP:
+        status = static_cast<arrow::TimestampBuilder *>(builder)->Append(
+            obj->is_timestamp() ? obj->get_timestamp() : obj->get_datetime());
+        break;
+      case arrow::Type::DATE32:
+        // days since 1970-01-01
+        status = static_cast<arrow::Date32Builder *>(builder)->Append(obj->get_date());
+        break;
+      case arrow::Type::DURATION:
+        status = static_cast<arrow::DurationBuilder *>(builder)->Append(obj->get_time());
+        break;
+      default:
+        ret = OB_NOT_SUPPORTED;
+        LOG_ERROR("arrow type not supported", KR(ret), K(cell), K(column_idx),
+            "type", builder->type()->ToString().c_str());
+        break;
+    }
+  }
+
+  if (OB_SUCC(ret) && OB_UNLIKELY(! status.ok())) {
+    ret = arrow_status_to_ret(status);
+    LOG_ERROR("append arrow value failed", KR(ret), K(cell), K(column_idx),
+        "status", status.ToString().c_str());
+  }
+
+  return ret;
+}
+
+int ObCDCArrowWriter::flush_batch_(TableBatch &batch)
+{
+  int ret = OB_SUCCESS;
+  arrow::Status status;
+  arrow::ArrayVector arrays;
+  std::shared_ptr<arrow::Buffer> ipc_buf;
+
+  if (batch.row_count_ <= 0) {
+    // nothing to flush
+  } else if (OB_ISNULL(cb_)) {
+    ret = OB_NOT_INIT;
+    LOG_ERROR("arrow batch callback is not set", KR(ret), K(batch));
+  } else if (OB_UNLIKELY(OB_INVALID_VERSION == batch.table_schema_version_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("table batch holds a partial row and can't be flushed", KR(ret), K(batch));
+  } else {
+    arrays.resize(batch.builders_.size());
+
+    for (int64_t idx = 0; OB_SUCC(ret) && idx < batch.builders_.size(); idx++) {
+      if (OB_UNLIKELY(! (status = batch.builders_[idx]->Finish(&arrays[idx])).ok())) {
+        ret = arrow_status_to_ret(status);
+        LOG_ERROR("finish arrow array failed", KR(ret), K(idx), K(batch), "status", status.ToString().c_str());
+      }
+    }
+
+    if (OB_SUCC(ret)) {
+      std::shared_ptr<arrow::RecordBatch> record_batch =
+          arrow::RecordBatch::Make(batch.schema_, batch.row_count_, arrays);
+      arrow::ipc::IpcWriteOptions options = arrow::ipc::IpcWriteOptions::Defaults();
+      options.memory_pool = pool_;
+      arrow::Result<std::shared_ptr<arrow::io::BufferOutputStream>> sink =
+          arrow::io::BufferOutputStream::Create(ARROW_IPC_BUF_INIT_SIZE, pool_);
+
+      if (OB_UNLIKELY(! sink.ok())) {
+        status = sink.status();
+      } else {
+        arrow::Result<std::shared_ptr<arrow::ipc::RecordBatchWriter>> writer =
+            arrow::ipc::MakeStreamWriter(sink.ValueUnsafe().get(), batch.schema_, options);
+
+        if (OB_UNLIKELY(! writer.ok())) {
+          status = writer.status();
+        } else if (! (status = writer.ValueUnsafe()->WriteRecordBatch(*record_batch)).ok()) {
+        } else if (! (status = writer.ValueUnsafe()->Close()).ok()) {
+        } else {
+          arrow::Result<std::shared_ptr<arrow::Buffer>> buf = sink.ValueUnsafe()->Finish();
+
+          if (OB_UNLIKELY(! buf.ok())) {
+            status = buf.status();
+          } else {
+            ipc_buf = buf.ValueUnsafe();
+          }
+        }
+      }
+
+      if (OB_UNLIKELY(! status.ok())) {
+        ret = arrow_status_to_ret(status);
+        LOG_ERROR("write arrow ipc stream failed", KR(ret), K(batch), "status", status.ToString().c_str());
+      }
+    }
+
+    if (OB_SUCC(ret)) {
+      ObCDCArrowBatch arrow_batch;
+      arrow_batch.tenant_id_ = batch.key_.tenant_id_;
+      arrow_batch.table_id_ = batch.key_.table_id_;
+      arrow_batch.db_name_ = batch.db_name_.c_str();
+      arrow_batch.table_name_ = batch.table_name_.c_str();
+      arrow_batch.schema_version_ = batch.table_schema_version_;
+      arrow_batch.row_count_ = batch.row_count_;
+      arrow_batch.min_commit_version_ = batch.min_commit_version_;
+      arrow_batch.max_commit_version_ = batch.max_commit_version_;
+      arrow_batch.data_ = reinterpret_cast<const char *>(ipc_buf->data());
+      arrow_batch.data_len_ = ipc_buf->size();
+      int cb_ret = cb_(arrow_batch, cb_arg_);
+
+      if (OB_UNLIKELY(OB_SUCCESS != cb_ret)) {
+        ret = cb_ret;
+        LOG_ERROR("arrow batch callback failed", KR(ret), K(batch), "data_len", arrow_batch.data_len_);
+      } else {
+        LOG_DEBUG("flush arrow record batch", K(batch), "data_len", arrow_batch.data_len_);
+        batch.reuse();
+      }
+    }
+  }
+
+  return ret;
+}
+
+} // namespace libobcdc
+} // namespace oceanbase
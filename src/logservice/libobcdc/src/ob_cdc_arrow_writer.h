@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ *
+ * Arrow Writer: accumulate DML rows of committed transactions into Arrow record batches per table
+ */
+
+#ifndef OCEANBASE_LIBOBCDC_ARROW_WRITER_H_
+#define OCEANBASE_LIBOBCDC_ARROW_WRITER_H_
+
+#include "common/object/ob_object.h"              // ObObj, ObObjMeta
+#include "lib/hash/ob_hashmap.h"                  // ObHashMap
+#include "lib/hash_func/murmur_hash.h"            // murmurhash
+#include "lib/container/ob_se_array.h"            // ObSEArray
+#include "lib/lock/ob_mutex.h"                    // ObMutex
+#include "storage/tx/ob_trans_define.h"           // ObTransID
+
+#include "libobcdc.h"                             // ObCDCArrowBatch, ARROW_BATCH_CALLBACK
+
+namespace oceanbase
+{
+namespace sql
+{
+class ObArrowMemPool;
+}
+
+namespace libobcdc
+{
+class ObLogBR;
+
+// Column values of a DML row in the Arrow output mode, built by the formatter.
+// Values are not converted to string unless the column type has no native Arrow type.
+struct ObCDCArrowRow
+{
+  struct Cell
+  {
+    common::ObObjMeta meta_;          // column type
+    const common::ObObj *obj_;        // value of in row column, NULL for out row lob column
+    const common::ObString *str_;     // value converted to string or value of out row lob column,
+                                      // NULL if obj_ is output directly
+
+    TO_STRING_KV(K_(meta), KPC_(obj), KPC_(str));
+  };
+
+  uint64_t table_id_;
+  int64_t table_schema_version_;
+  int record_type_;                   // EINSERT/EUPDATE/EDELETE/EPUT
+  int64_t column_num_;                // number of user columns
+  Cell *cells_;                       // indexed by user column index
+  int64_t rowkey_num_;                // number of rowkey columns
+  int64_t *rowkey_idxs_;              // user column index of rowkey columns
+  Cell *old_rowkey_cells_;            // rowkey before UPDATE, NULL values for other record types
+
+  TO_STRING_KV(K_(table_id), K_(table_schema_version), K_(record_type), K_(column_num), K_(rowkey_num));
+};
+
+class ObCDCArrowWriter
+{
+public:
+  ObCDCArrowWriter();
+  virtual ~ObCDCArrowWriter();
+
+public:
+  int init(const int64_t batch_row_count);
+  void destroy();
+  void set_callback(ARROW_BATCH_CALLBACK cb, void *cb_arg);
+  bool is_callback_set() const { return NULL != cb_; }
+  void configure(const int64_t batch_row_count);
+
+  // Whether the column type is mapped to an Arrow type without converting the value to string
+  static bool is_native_type(const common::ObObjMeta &meta);
+
+  // Append the DML row of br into the record batch of its table, the values are copied and
+  // br could be recycled after this call. The record batch is delivered by the callback once it
+  // reaches the batch row count or the schema of the table changes.
+  int append(ObLogBR &br, const transaction::ObTransID &trans_id);
+
+  // Deliver all pending record batches by the callback
+  int flush();
+
+  TO_STRING_KV(K_(inited), K_(batch_row_count), KP_(cb), "table_count", batches_.count());
+
+private:
+  struct TableKey
+  {
+    uint64_t tenant_id_;
+    uint64_t table_id_;
+
+    TableKey() : tenant_id_(common::OB_INVALID_TENANT_ID), table_id_(common::OB_INVALID_ID) {}
+    TableKey(const uint64_t tenant_id, const uint64_t table_id) : tenant_id_(tenant_id), table_id_(table_id) {}
+    uint64_t hash() const
+    {
+      uint64_t hash_val = 0;
+      hash_val = common::murmurhash(&tenant_id_, sizeof(tenant_id_), hash_val);
+      hash_val = common::murmurhash(&table_id_, sizeof(table_id_), hash_val);
+      return hash_val;
+    }
+    int hash(uint64_t &hash_val) const { hash_val = hash(); return common::OB_SUCCESS; }
+    bool operator==(const TableKey &other) const
+    {
+      return tenant_id_ == other.tenant_id_ && table_id_ == other.table_id_;
+    }
+    TO_STRING_KV(K_(tenant_id), K_(table_id));
+  };
+  struct TableBatch;
+  typedef common::hash::ObHashMap<TableKey, TableBatch *> TableBatchMap;
+
+  int get_table_batch_(ObLogBR &br, const ObCDCArrowRow &row, TableBatch *&batch);
+  int init_table_batch_(ObLogBR &br, const ObCDCArrowRow &row, TableBatch &batch);
+  int append_row_(const ObCDCArrowRow &row,
+      const int64_t commit_version,
+      const transaction::ObTransID &trans_id,
+      TableBatch &batch);
+  int append_cell_(const ObCDCArrowRow::Cell &cell, const int64_t column_idx, TableBatch &batch);
+  int flush_batch_(TableBatch &batch);
+
+private:
+  static const int64_t BATCH_MAP_BUCKET_NUM = 1024;
+
+  bool                inited_;
+  int64_t             batch_row_count_;
+  ARROW_BATCH_CALLBACK cb_;
+  void                *cb_arg_;
+  sql::ObArrowMemPool *pool_;
+  TableBatchMap       batch_map_;
+  common::ObSEArray<TableBatch *, 16> batches_;
+  // the committer thread appends rows while the heartbeat thread flushes batches
+  lib::ObMutex        lock_;
+
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObCDCArrowWriter);
+};
+
+} // namespace libobcdc
+} // namespace oceanbase
+
+#endif
@@ -259,6 +259,39 @@ int ObCDCPartTransResolver::read(
   return ret;
 }
 
+int ObCDCPartTransResolver::read_filtered_redo(
+    const transaction::ObTransID &tx_id,
+    const uint64_t org_cluster_id,
+    const palf::LSN &lsn)
+{
+  int ret = OB_SUCCESS;
+  bool is_cluster_id_served = false;
+  PartTransTask *task = NULL;
+
+  if (OB_UNLIKELY(! tx_id.is_valid() || ! lsn.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("invalid filtered redo", KR(ret), K_(tls_id), K(tx_id), K(lsn));
+  } else if (OB_FAIL(cluster_id_filter_.check_is_served(org_cluster_id, is_cluster_id_served))) {
+    LOG_ERROR("check_cluster_id_served failed", KR(ret), K_(tls_id), K(lsn), K(org_cluster_id));
+  } else if (OB_UNLIKELY(! is_cluster_id_served)) {
+    LOG_DEBUG("[STAT] [FETCHER] [TRANS_NOT_SERVE]", K_(tls_id), K(is_cluster_id_served), K(lsn));
+  } else if (OB_FAIL(obtain_task_(tx_id, task, false/*is_resolving_miss_log*/))) {
+    LOG_ERROR("obtain_task_ fail", KR(ret), K_(tls_id), K(tx_id), K(lsn));
+  } else if (OB_FAIL(push_fetched_log_entry_(lsn, *task))) {
+    if (OB_ENTRY_EXIST == ret) {
+      LOG_WARN("redo already fetched, ignore", KR(ret), K_(tls_id), K(tx_id), K(lsn),
+          "task_sorted_log_entry_info", task->get_sorted_log_entry_info());
+      ret = OB_SUCCESS;
+    } else {
+      LOG_ERROR("push_fetched_log_entry failed", KR(ret), K_(tls_id), K(tx_id), K(lsn), KPC(task));
+    }
+  } else {
+    LOG_DEBUG("read filtered redo succ", K_(tls_id), K(tx_id), K(lsn));
+  }
+
+  return ret;
+}
+
 int ObCDCPartTransResolver::dispatch(volatile bool &stop_flag, int64_t &pending_task_count)
 {
   int ret = OB_SUCCESS;
@@ -184,6 +184,19 @@ public:
       MissingLogInfo &missing_log_info,
       logfetcher::TransStatInfo &tsi) = 0;
 
+  /// read redo log entry filtered by observer, which only holds redo of unsubscribed tablets
+  /// the log entry is regarded as fetched, so that the trans won't wait for it as missing log
+  /// @param [in]   tx_id                 trans of the redo
+  /// @param [in]   org_cluster_id        org_cluster_id of the tx_log_block
+  /// @param [in]   lsn                   lsn of the log_entry
+  ///
+  /// @retval OB_SUCCESS          success
+  /// @retval other_err_code      unexpected error
+  virtual int read_filtered_redo(
+      const transaction::ObTransID &tx_id,
+      const uint64_t org_cluster_id,
+      const palf::LSN &lsn) = 0;
+
   /// dispatch ready PartTransTask. READY means:
   /// 1. Trans(DML/DDL) that already handle commit log and all redo of trans have persisted if working_mode is storage
   /// 2. all kinds of other type of PartTransTask(LS_HEARTBEAT/LS_OFFLINED/GLOBAL_HEARTBEAT)
@@ -244,6 +257,11 @@ public:
       MissingLogInfo &missing_log_info,
       logfetcher::TransStatInfo &tsi);
 
+  virtual int read_filtered_redo(
+      const transaction::ObTransID &tx_id,
+      const uint64_t org_cluster_id,
+      const palf::LSN &lsn);
+
   virtual int dispatch(volatile bool &stop_flag, int64_t &pending_task_count);
 
   virtual int offline(volatile bool &stop_flag);
@@ -253,6 +253,13 @@ public:
   /// @retval OB_SUCCESS          remove success
   /// @retval other ERROR         remove fail
   int remove_tablet_table_info(const common::ObTabletID &tablet_id);
+
+  /// iterate all tablet_id->table_info pairs
+  ///
+  /// @param [in] fn              bool operator()(const ObTabletID &tablet_id, ObCDCTableInfo &table_info),
+  ///                             iteration stops if fn returns false
+  template <typename Function>
+  int for_each(Function &fn) { return tablet_to_table_map_.for_each(fn); }
   // TODO: need support Tablet Transfer(wait OBServer imply)
 public:
   TO_STRING_KV(K_(tenant_id), K_(is_inited), "tablet_to_table_count", tablet_to_table_map_.count());
@@ -33,6 +33,7 @@ ObLogBR::ObLogBR() : ObLogResourceRecycleTask(ObLogResourceRecycleTask::BINLOG_R
                      data_(nullptr),
                      host_(nullptr),
                      stmt_task_(nullptr),
+                     arrow_row_(nullptr),
                      next_br_(nullptr),
                      valid_(true),
                      tenant_id_(OB_INVALID_TENANT_ID),
@@ -93,6 +94,7 @@ void ObLogBR::reset()
 
   host_ = nullptr;
   stmt_task_ = nullptr;
+  arrow_row_ = nullptr;
   next_br_ = nullptr;
   valid_ = true;
   tenant_id_ = OB_INVALID_TENANT_ID;
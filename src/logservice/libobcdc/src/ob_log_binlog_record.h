@@ -34,6 +34,7 @@ namespace oceanbase
 {
 namespace libobcdc
 {
+struct ObCDCArrowRow;
 
 class ObLogBR : public ObLogResourceRecycleTask, public common::ObLink
 {
@@ -94,6 +95,10 @@ public:
   inline void *get_stmt_task() { return stmt_task_; }
   void set_stmt_task(void *stmt_task) { stmt_task_ = stmt_task; }
 
+  // Only set in the Arrow output mode, memory is allocated from ObLogEntryTask
+  const ObCDCArrowRow *get_arrow_row() const { return arrow_row_; }
+  void set_arrow_row(const ObCDCArrowRow *arrow_row) { arrow_row_ = arrow_row; }
+
   uint64_t get_tenant_id() const { return tenant_id_; }
   int64_t get_schema_version() const { return schema_version_; }
   uint64_t get_row_index() const { return row_index_; }
@@ -122,6 +127,7 @@ private:
   IBinlogRecord *data_;               ///< real BinlogRecord
   void          *host_;               ///< record corresponsding ObLogEntryTask
   void          *stmt_task_;          // StmtTask
+  const ObCDCArrowRow *arrow_row_;    // row of DML in the Arrow output mode
   ObLogBR       *next_br_;
   bool          valid_;               ///< statement is valid or not
 
@@ -88,7 +88,9 @@ ObLogCommitter::ObLogCommitter() :
     global_heartbeat_info_queue_(),
     dml_part_trans_task_count_(0),
     ddl_part_trans_task_count_(0),
-    dml_trans_count_(0)
+    dml_trans_count_(0),
+    enable_output_arrow_format_(false),
+    arrow_writer_()
 {
 }
 
@@ -103,7 +105,9 @@ int ObLogCommitter::init(const int64_t start_seq,
     IObLogBRPool *tag_br_alloc,
     IObLogTransCtxMgr *trans_ctx_mgr,
     IObLogTransStatMgr *trans_stat_mgr,
-    IObLogErrHandler *err_handler)
+    IObLogErrHandler *err_handler,
+    const bool enable_output_arrow_format,
+    const int64_t arrow_batch_row_count)
 {
   int ret = OB_SUCCESS;
 
@@ -130,6 +134,8 @@ int ObLogCommitter::init(const int64_t start_seq,
       CHECKPOINT_QUEUE_ALLOCATOR_HOLD_LIMIT,
       CHECKPOINT_QUEUE_ALLOCATOR_PAGE_SIZE))) {
     LOG_ERROR("init checkpoint_queue_allocator_ fail", KR(ret));
+  } else if (enable_output_arrow_format && OB_FAIL(arrow_writer_.init(arrow_batch_row_count))) {
+    LOG_ERROR("init arrow_writer_ fail", KR(ret), K(arrow_batch_row_count));
   } else {
     checkpoint_queue_allocator_.set_label(ObModIds::OB_LOG_COMMITTER_CHECKPOINT_QUEUE);
     last_output_checkpoint_ = OB_INVALID_VERSION;
@@ -139,10 +145,11 @@ int ObLogCommitter::init(const int64_t start_seq,
     dml_part_trans_task_count_ = 0;
     ddl_part_trans_task_count_ = 0;
     dml_trans_count_ = 0;
+    enable_output_arrow_format_ = enable_output_arrow_format;
     stop_flag_ = true;
     inited_ = true;
 
-    LOG_INFO("init committer succ", K(start_seq));
+    LOG_INFO("init committer succ", K(start_seq), K(enable_output_arrow_format), K(arrow_batch_row_count));
   }
 
   return ret;
@@ -175,6 +182,8 @@ void ObLogCommitter::destroy()
   dml_part_trans_task_count_ = 0;
   ddl_part_trans_task_count_ = 0;
   dml_trans_count_ = 0;
+  enable_output_arrow_format_ = false;
+  arrow_writer_.destroy();
 }
 
 int ObLogCommitter::start()
@@ -185,6 +194,9 @@ int ObLogCommitter::start()
   if (OB_UNLIKELY(! inited_)) {
     LOG_ERROR("committer has not been initialized");
     ret = OB_NOT_INIT;
+  } else if (OB_UNLIKELY(enable_output_arrow_format_ && ! arrow_writer_.is_callback_set())) {
+    ret = OB_NOT_INIT;
+    LOG_ERROR("arrow batch callback should be set before start in the Arrow output mode", KR(ret));
   } else if (stop_flag_) {
     stop_flag_ = false;
 
@@ -685,6 +697,9 @@ int ObLogCommitter::dispatch_heartbeat_binlog_record_(const int64_t heartbeat_ti
     LOG_ERROR("init HEARTBEAT binlog record fail", KR(ret), K(heartbeat_timestamp),
         K(cluster_id), K(tenant_id), K(row_index), K(ddl_schema_version), K(trace_id), K(trace_info),
         K(unique_id));
+  } else if (OB_FAIL(flush_arrow_batch_())) {
+    // rows committed before the heartbeat should be delivered before it
+    LOG_ERROR("flush_arrow_batch_ fail", KR(ret), K(heartbeat_timestamp));
   } else if (OB_FAIL(push_br_queue_(br))) {
     if (OB_IN_STOP_STATE != ret) {
       LOG_ERROR("push_br_queue_ fail", KR(ret));
@@ -964,7 +979,10 @@ int ObLogCommitter::handle_ddl_stmt_(DdlStmtTask &stmt_task)
     // DDL push to the next element in the BRQueue, the next element in the chain is empty
     br->set_next(NULL);
 
-    if (OB_FAIL(push_br_queue_(br))) {
+    // rows of the old table schema should be delivered before DDL
+    if (OB_FAIL(flush_arrow_batch_())) {
+      LOG_ERROR("flush_arrow_batch_ fail", KR(ret), K(stmt_task));
+    } else if (OB_FAIL(push_br_queue_(br))) {
       if (OB_IN_STOP_STATE != ret) {
         LOG_ERROR("push_br_queue_ fail", KR(ret), K(br));
       }
@@ -1265,6 +1283,13 @@ int ObLogCommitter::commit_binlog_record_list_(TransCtx &trans_ctx,
     } else {
       LOG_ERROR("failed to wait for valid br", KR(ret), K(trans_ctx));
     }
+  } else if (enable_output_arrow_format_) {
+    // DML rows are output by Arrow record batch, without BEGIN and COMMIT
+    if (OB_FAIL(commit_arrow_row_list_(trans_ctx))) {
+      if (OB_IN_STOP_STATE != ret) {
+        LOG_ERROR("commit_arrow_row_list_ fail", KR(ret), K(trans_ctx));
+      }
+    }
   } else {
     ObLogBR *begin_br = NULL;
     ObLogBR *commit_br = NULL;
@@ -1363,6 +1388,61 @@ int ObLogCommitter::commit_binlog_record_list_(TransCtx &trans_ctx,
   return ret;
 }
 
+int ObLogCommitter::commit_arrow_row_list_(TransCtx &trans_ctx)
+{
+  int ret = OB_SUCCESS;
+  const ObTransID &trans_id = trans_ctx.get_trans_id();
+  uint64_t retry_count = 0;
+
+  while (! stop_flag_ && OB_SUCC(ret) && ! trans_ctx.is_all_br_committed()) {
+    ObLogBR *br_task = NULL;
+
+    if (OB_FAIL(next_ready_br_task_(trans_ctx, br_task))) {
+      if (OB_EAGAIN == ret) {
+        ob_usleep(10*1000);
+        ret = OB_SUCCESS;
+        if (OB_UNLIKELY(0 == (++retry_count) % 100)) {
+          LOG_DEBUG("waiting for next ready br", KR(ret), K(trans_ctx));
+        }
+      } else {
+        LOG_ERROR("next_ready_br_task_ fail", KR(ret), KPC(br_task));
+      }
+    } else if (OB_FAIL(arrow_writer_.append(*br_task, trans_id))) {
+      LOG_ERROR("append row to arrow_writer_ fail", KR(ret), K(trans_id), KPC(br_task));
+    }
+    // values of the row are copied by arrow_writer_, recycle the binlog record directly
+    else if (OB_FAIL(revert_binlog_record_(br_task))) {
+      if (OB_IN_STOP_STATE != ret) {
+        LOG_ERROR("revert_binlog_record_ fail", KR(ret), K(br_task));
+      }
+    } else {
+      trans_ctx.inc_committed_br_count();
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    if (stop_flag_) {
+      ret = OB_IN_STOP_STATE;
+    } else if (trans_ctx.get_total_br_count() != trans_ctx.get_committed_br_count()) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_ERROR("expected all br commit but not", KR(ret), K(trans_ctx));
+    }
+  }
+
+  return ret;
+}
+
+int ObLogCommitter::flush_arrow_batch_()
+{
+  int ret = OB_SUCCESS;
+
+  if (enable_output_arrow_format_ && OB_FAIL(arrow_writer_.flush())) {
+    LOG_ERROR("flush arrow_writer_ fail", KR(ret), K_(arrow_writer));
+  }
+
+  return ret;
+}
+
 int ObLogCommitter::next_ready_br_task_(TransCtx &trans_ctx, ObLogBR *&br_task)
 {
   int ret = OB_SUCCESS;
@@ -1442,6 +1522,18 @@ void ObLogCommitter::configure(const ObLogConfig &cfg)
 
   ATOMIC_STORE(&g_output_heartbeat_interval, output_heartbeat_interval_msec * _MSEC_);
   LOG_INFO("[CONFIG]", K(output_heartbeat_interval_msec));
+
+  if (enable_output_arrow_format_) {
+    const int64_t arrow_batch_row_count = cfg.arrow_batch_row_count;
+    arrow_writer_.configure(arrow_batch_row_count);
+    LOG_INFO("[CONFIG]", K(arrow_batch_row_count));
+  }
+}
+
+void ObLogCommitter::set_arrow_batch_callback(ARROW_BATCH_CALLBACK cb, void *cb_arg)
+{
+  arrow_writer_.set_callback(cb, cb_arg);
+  LOG_INFO("set arrow batch callback", KP(cb), KP(cb_arg), K_(enable_output_arrow_format));
 }
 
 } // namespace libobcdc
@@ -22,6 +22,7 @@
 #include "ob_log_utils.h"                         // _SEC_
 #include "ob_log_part_trans_task.h"               // PartTransTask, DdlStmtTask
 #include "ob_log_trans_ctx.h"                     // TransCtx
+#include "ob_cdc_arrow_writer.h"                  // ObCDCArrowWriter
 
 namespace oceanbase
 {
@@ -62,6 +63,8 @@ public:
   // update config of committer
   virtual void configure(const ObLogConfig &cfg) = 0;
 
+  // set callback of Arrow record batch, used if enable_output_arrow_format=1
+  virtual void set_arrow_batch_callback(ARROW_BATCH_CALLBACK cb, void *cb_arg) = 0;
 };
 
 ///////////////////////////////////////////////////////////////////////////////////////
@@ -108,6 +111,7 @@ public:
   void get_part_trans_task_count(int64_t &ddl_part_trans_task_count,
       int64_t &dml_part_trans_task_count) const;
   void configure(const ObLogConfig &cfg);
+  void set_arrow_batch_callback(ARROW_BATCH_CALLBACK cb, void *cb_arg);
 
 public:
   int init(const int64_t start_seq,
@@ -116,7 +120,9 @@ public:
       IObLogBRPool *tag_br_alloc,
       IObLogTransCtxMgr *trans_ctx_mgr,
       IObLogTransStatMgr *trans_stat_mgr,
-      IObLogErrHandler *err_handler);
+      IObLogErrHandler *err_handler,
+      const bool enable_output_arrow_format = false,
+      const int64_t arrow_batch_row_count = 0);
   void destroy();
   void commit_routine();
   void heartbeat_routine();
@@ -152,6 +158,8 @@ private:
       const int64_t part_trans_task_count,
       const uint64_t tenant_id,
       const int64_t trans_commit_version);
+  int commit_arrow_row_list_(TransCtx &trans_ctx);
+  int flush_arrow_batch_();
   int push_br_queue_(ObLogBR *br);
   int handle_offline_checkpoint_task_(CheckpointTask &task);
   int recycle_task_directly_(PartTransTask &task, const bool can_async_recycle = true);
@@ -250,6 +258,10 @@ private:
   int64_t                   ddl_part_trans_task_count_;
   int64_t                   dml_trans_count_;
 
+  // DML rows are output by arrow_writer_ instead of br_queue_ in the Arrow output mode
+  bool                      enable_output_arrow_format_;
+  ObCDCArrowWriter          arrow_writer_;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(ObLogCommitter);
 };
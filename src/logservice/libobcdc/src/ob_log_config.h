@@ -324,6 +324,13 @@ public:
   DEF_STR(sql_server_blacklist, OB_CLUSTER_PARAMETER, "|", "sql server black list");
 
   T_DEF_INT_INFT(fetch_log_rpc_timeout_sec, OB_CLUSTER_PARAMETER, 15, 1, "fetch log rpc timeout in seconds");
+  // send the user tablets of the tables selected by tb_white_list and tb_black_list (with their LOB aux tables)
+  // to observer with the fetch log rpc, observer skips the LogGroupEntry which only holds redo of other tablets.
+  // The list is refreshed after DDL. Tablets created after start are always fetched.
+  // NOTICE: the changes of a table renamed into tb_white_list (or a partition exchanged into a selected table)
+  // may be skipped until the DDL is handled, don't enable it if the selected tables can change that way.
+  // Only take effect if enable_white_black_list=1
+  T_DEF_BOOL(enable_fetch_log_tablet_filter, OB_CLUSTER_PARAMETER, 0, "0:disabled, 1:enabled");
 
   // Upper limit of progress difference between partitions, in seconds
   T_DEF_INT_INFT(progress_limit_sec_for_dml, OB_CLUSTER_PARAMETER, 30, 1, "dml progress limit in seconds");
@@ -369,6 +376,8 @@ public:
   // Print RPC chain statistics logs if this limit is exceeded
   T_DEF_INT_INFT(rpc_process_handler_time_upper_limit_msec, OB_CLUSTER_PARAMETER, 200, 1,
       "observer fetch log rpc process handler timer upper limit");
+  // compressor of the fetch log rpc result, e.g. lz4_1.0, zstd_1.3.8, none means not compressed
+  DEF_STR(rpc_result_compress_func, OB_CLUSTER_PARAMETER, "none", "fetch log rpc result compressor");
 
   // Survival time of server to blacklist, in seconds
   T_DEF_INT_INFT(blacklist_survival_time_sec, OB_CLUSTER_PARAMETER, 30, 1, "blacklist-server surival time in seconds");
@@ -534,6 +543,12 @@ public:
   // 2. Backup is on by default
   T_DEF_BOOL(enable_output_hidden_primary_key, OB_CLUSTER_PARAMETER, 0, "0:disabled, 1:enabled");
 
+  // Whether to output DML rows as Arrow record batches by ARROW_BATCH_CALLBACK
+  // Off by default; only supported in memory working mode, next_record then only outputs DDL and HEARTBEAT
+  T_DEF_BOOL(enable_output_arrow_format, OB_CLUSTER_PARAMETER, 0, "0:disabled, 1:enabled");
+  // Max row count of an Arrow record batch, a record batch is also delivered before each HEARTBEAT and DDL
+  T_DEF_INT_INFT(arrow_batch_row_count, OB_CLUSTER_PARAMETER, 8192, 1, "max row count of arrow record batch");
+
   // Ignore inconsistencies in the number of HBase mode put columns or not
   // Do not skip by default
   T_DEF_BOOL(skip_hbase_mode_put_column_count_not_consistency, OB_CLUSTER_PARAMETER, 0, "0:disabled, 1:enabled");
@@ -60,6 +60,8 @@ void ObLogFormatter::RowValue::reset()
   (void)memset(new_columns_, 0, sizeof(new_columns_));
   (void)memset(old_columns_, 0, sizeof(old_columns_));
   (void)memset(orig_default_value_, 0, sizeof(orig_default_value_));
+  (void)memset(new_objs_, 0, sizeof(new_objs_));
+  (void)memset(old_objs_, 0, sizeof(old_objs_));
   (void)memset(is_rowkey_, 0, sizeof(is_rowkey_));
   (void)memset(is_changed_, 0, sizeof(is_changed_));
   (void)memset(is_null_lob_columns_, 0, sizeof(is_null_lob_columns_));
@@ -78,6 +80,8 @@ int ObLogFormatter::RowValue::init(const int64_t column_num, const bool contain_
     (void)memset(new_columns_, 0, column_num * sizeof(new_columns_[0]));
     (void)memset(old_columns_, 0, column_num * sizeof(old_columns_[0]));
     (void)memset(orig_default_value_, 0, column_num * sizeof(orig_default_value_[0]));
+    (void)memset(new_objs_, 0, column_num * sizeof(new_objs_[0]));
+    (void)memset(old_objs_, 0, column_num * sizeof(old_objs_[0]));
     (void)memset(is_rowkey_, 0, column_num * sizeof(is_rowkey_[0]));
     (void)memset(is_changed_, 0, column_num * sizeof(is_changed_[0]));
     (void)memset(is_null_lob_columns_, 0, column_num * sizeof(is_null_lob_columns_[0]));
@@ -104,6 +108,7 @@ ObLogFormatter::ObLogFormatter() : inited_(false),
                                    hbase_util_(NULL),
                                    skip_hbase_mode_put_column_count_not_consistency_(false),
                                    enable_output_hidden_primary_key_(false),
+                                   enable_output_arrow_format_(false),
                                    log_entry_task_count_(0),
                                    stmt_in_lob_merger_count_(0)
 
@@ -128,7 +133,8 @@ int ObLogFormatter::init(const int64_t thread_num,
       const bool enable_hbase_mode,
       ObLogHbaseUtil &hbase_util,
       const bool skip_hbase_mode_put_column_count_not_consistency,
-      const bool enable_output_hidden_primary_key)
+      const bool enable_output_hidden_primary_key,
+      const bool enable_output_arrow_format)
 {
   int ret = OB_SUCCESS;
 
@@ -165,11 +171,12 @@ int ObLogFormatter::init(const int64_t thread_num,
     hbase_util_ = &hbase_util;
     skip_hbase_mode_put_column_count_not_consistency_ = skip_hbase_mode_put_column_count_not_consistency;
     enable_output_hidden_primary_key_ = enable_output_hidden_primary_key;
+    enable_output_arrow_format_ = enable_output_arrow_format;
     log_entry_task_count_ = 0;
     stmt_in_lob_merger_count_ = 0;
     inited_ = true;
     LOG_INFO("Formatter init succ", K(working_mode_), "working_mode", print_working_mode(working_mode_),
-        K(thread_num), K(queue_size));
+        K(thread_num), K(queue_size), K(enable_output_arrow_format));
   }
 
   return ret;
@@ -197,6 +204,7 @@ void ObLogFormatter::destroy()
   hbase_util_ = NULL;
   skip_hbase_mode_put_column_count_not_consistency_ = false;
   enable_output_hidden_primary_key_ = false;
+  enable_output_arrow_format_ = false;
   log_entry_task_count_ = 0;
   stmt_in_lob_merger_count_ = 0;
 }
@@ -764,13 +772,20 @@ int ObLogFormatter::format_row_(
     LOG_ERROR("build_row_value_ fail", KR(ret), K(tenant_id), K(dml_stmt_task), K(row_value),
         K(new_column_cnt), K(cur_stmt_need_callback));
   } else if (! cur_stmt_need_callback) {
-    if (OB_FAIL(build_binlog_record_(
+    if (enable_output_arrow_format_) {
+      if (OB_FAIL(build_arrow_row_(&br, &row_value, dml_stmt_task, &table_schema))) {
+        LOG_ERROR("build_arrow_row_ fail", KR(ret), K(br), K(row_value), K(dml_stmt_task));
+      }
+    } else if (OB_FAIL(build_binlog_record_(
         &br,
         &row_value,
         new_column_cnt,
         dml_stmt_task.get_dml_flag(),
         &table_schema))) {
       LOG_ERROR("build_binlog_record_ fail", KR(ret), K(br), K(row_value), K(new_column_cnt), K(dml_stmt_task));
+    }
+
+    if (OB_FAIL(ret)) {
     } else if (OB_UNLIKELY(!br.is_valid())) {
       // 1. not found valid column(heap table with all column virtual generated)
       // 2. dml_falg is DF_LOCK
@@ -1114,7 +1129,8 @@ int ObLogFormatter::build_row_value_(
       LOG_INFO("no valid column is found", "table_name", simple_table_schema->get_table_name(),
           "table_id", simple_table_schema->get_table_id());
     } else if (! is_cur_stmt_task_cb_progress && OB_FAIL(stmt_task->parse_cols(
-        obj2str_helper_,
+        // values are converted to string on demand in the Arrow output mode
+        enable_output_arrow_format_ ? NULL : obj2str_helper_,
         tb_schema_info,
         tz_info_wrap,
         enable_output_hidden_primary_key_))) {
@@ -1146,8 +1162,8 @@ int ObLogFormatter::build_row_value_(
       else if (OB_FAIL(fill_normal_cols_(*stmt_task, rv, *old_cols, *new_lob_ctx_cols, simple_table_schema,
           *tb_schema_info, tz_info_wrap, false))) {
         LOG_ERROR("fill normal old columns fail", KR(ret), K(rv), KPC(old_cols));
-      } else if (OB_FAIL(fill_rowkey_cols_(rv, *rowkey_cols, simple_table_schema,
-              *tb_schema_info))) {
+      } else if (OB_FAIL(fill_rowkey_cols_(*stmt_task, rv, *rowkey_cols, simple_table_schema,
+              *tb_schema_info, tz_info_wrap))) {
         LOG_ERROR("fill_rowkey_cols_ fail", KR(ret), K(rv), KPC(rowkey_cols),
             "stmt_task", *stmt_task, K(simple_table_schema));
       } else if (OB_FAIL(fill_orig_default_value_(rv, simple_table_schema, *tb_schema_info,
@@ -1302,6 +1318,12 @@ int ObLogFormatter::fill_normal_cols_(
         } else if (is_new_value) {
           if (! cv->is_out_row_) {
             rv->new_columns_[usr_column_idx] = &cv->string_value_;
+            rv->new_objs_[usr_column_idx] = &cv->value_;
+
+            if (enable_output_arrow_format_
+                && OB_FAIL(fill_arrow_col_value_(stmt_task, *column_schema_info, tz_info_wrap, *cv))) {
+              LOG_ERROR("fill_arrow_col_value_ fail", KR(ret), K(column_id), KPC(cv));
+            }
           } else {
             ObLobDataGetCtx *lob_data_get_ctx = nullptr;
             ObString *new_col_str = nullptr;
@@ -1352,6 +1374,12 @@ int ObLogFormatter::fill_normal_cols_(
               rv->is_old_col_nop_[usr_column_idx] = true;
             } else {
               rv->old_columns_[usr_column_idx] = &cv->string_value_;
+              rv->old_objs_[usr_column_idx] = &cv->value_;
+
+              if (enable_output_arrow_format_
+                  && OB_FAIL(fill_arrow_col_value_(stmt_task, *column_schema_info, tz_info_wrap, *cv))) {
+                LOG_ERROR("fill_arrow_col_value_ fail", KR(ret), K(column_id), KPC(cv));
+              }
             }
           } else {
             ObLobDataGetCtx *lob_data_get_ctx = nullptr;
@@ -1413,10 +1441,12 @@ int ObLogFormatter::fill_normal_cols_(
 
 template<class TABLE_SCHEMA>
 int ObLogFormatter::fill_rowkey_cols_(
+    DmlStmtTask &stmt_task,
     RowValue *rv,
     ColValueList &rowkey_cols,
     const TABLE_SCHEMA *simple_table_schema,
-    const TableSchemaInfo &tb_schema_info)
+    const TableSchemaInfo &tb_schema_info,
+    const ObTimeZoneInfoWrap *tz_info_wrap)
 {
   int ret = OB_SUCCESS;
 
@@ -1455,16 +1485,26 @@ int ObLogFormatter::fill_rowkey_cols_(
             K(tb_schema_info), K(rowkey_index), K(column_schema_info), KPC(simple_table_schema));
       } else {
         const int16_t rowkey_usr_index = column_schema_info->get_usr_column_idx();
-        // If the primary key column has been modified, the value after the modification is used, otherwise the value before the modification is used
-        if (NULL == rv->new_columns_[rowkey_usr_index]) {
-          rv->new_columns_[rowkey_usr_index] = &(cv_node->string_value_);
-        }
+        const bool need_fill_new = (NULL == rv->new_columns_[rowkey_usr_index]);
+        const bool need_fill_old = (rv->contain_old_column_ && NULL == rv->old_columns_[rowkey_usr_index]);
+
+        if (enable_output_arrow_format_ && (need_fill_new || need_fill_old)
+            && OB_FAIL(fill_arrow_col_value_(stmt_task, *column_schema_info, tz_info_wrap, *cv_node))) {
+          LOG_ERROR("fill_arrow_col_value_ fail", KR(ret), K(rowkey_index), KPC(cv_node));
+        } else {
+          // If the primary key column has been modified, the value after the modification is used, otherwise the value before the modification is used
+          if (need_fill_new) {
+            rv->new_columns_[rowkey_usr_index] = &(cv_node->string_value_);
+            rv->new_objs_[rowkey_usr_index] = &(cv_node->value_);
+          }
 
-        rv->is_rowkey_[rowkey_usr_index] = true;
-        rv->is_changed_[rowkey_usr_index] = (1 != cv_node->is_col_nop_);
+          rv->is_rowkey_[rowkey_usr_index] = true;
+          rv->is_changed_[rowkey_usr_index] = (1 != cv_node->is_col_nop_);
 
-        if (rv->contain_old_column_ && NULL == rv->old_columns_[rowkey_usr_index]) {
-          rv->old_columns_[rowkey_usr_index] = &(cv_node->string_value_);
+          if (need_fill_old) {
+            rv->old_columns_[rowkey_usr_index] = &(cv_node->string_value_);
+            rv->old_objs_[rowkey_usr_index] = &(cv_node->value_);
+          }
         }
       }
     } // for
@@ -1473,6 +1513,26 @@ int ObLogFormatter::fill_rowkey_cols_(
   return ret;
 }
 
+int ObLogFormatter::fill_arrow_col_value_(
+    DmlStmtTask &stmt_task,
+    const ColumnSchemaInfo &column_schema_info,
+    const ObTimeZoneInfoWrap *tz_info_wrap,
+    ColValue &cv)
+{
+  int ret = OB_SUCCESS;
+
+  if (column_schema_info.is_udt_column()) {
+    // value of udt column has been built by group_udt_column_values_
+  } else if (ObCDCArrowWriter::is_native_type(column_schema_info.get_meta_type())) {
+    // output value of ObObj directly
+  } else if (OB_FAIL(stmt_task.parse_col(stmt_task.get_tenant_id(), cv.column_id_, column_schema_info,
+      tz_info_wrap, *obj2str_helper_, cv))) {
+    LOG_ERROR("stmt_task parse_col failed", KR(ret), K(stmt_task), K(column_schema_info), K(cv));
+  }
+
+  return ret;
+}
+
 template<class TABLE_SCHEMA>
 int ObLogFormatter::fill_orig_default_value_(
     RowValue *rv,
@@ -1690,6 +1750,192 @@ int ObLogFormatter::build_binlog_record_(
   return ret;
 }
 
+template<class TABLE_SCHEMA>
+int ObLogFormatter::build_arrow_row_(
+    ObLogBR *br,
+    RowValue *rv,
+    DmlStmtTask &stmt_task,
+    const TABLE_SCHEMA *simple_table_schema)
+{
+  int ret = OB_SUCCESS;
+  IBinlogRecord *br_data = NULL;
+  TableSchemaInfo *tb_schema_info = NULL;
+  const ObDmlRowFlag &dml_flag = stmt_task.get_dml_flag();
+
+  if (OB_UNLIKELY(! inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_ERROR("ObLogFormatter has not been initialized", KR(ret));
+  } else if (OB_ISNULL(br) || OB_ISNULL(rv) || OB_ISNULL(simple_table_schema)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("invalid argument", KR(ret), K(br), K(rv), K(simple_table_schema));
+  } else if (OB_ISNULL(br_data = br->get_data())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("binlog record data is invalid", KR(ret), K(br));
+  } else if (OB_FAIL(set_src_category_(br_data, rv, dml_flag, false/*is_hbase_mode_put*/))) {
+    LOG_ERROR("set_src_category_ fail", KR(ret), K(br_data), K(rv), K(dml_flag));
+  } else if (rv->column_num_ <= 0) {
+    LOG_INFO("[IGNORE_DATA] ignore non-user-column table", "table_name", simple_table_schema->get_table_name(),
+        "table_id", simple_table_schema->get_table_id());
+    br->set_is_valid(false);
+  } else if (OB_UNLIKELY(! dml_flag.is_delete() && ! dml_flag.is_delete_insert()
+      && ! dml_flag.is_insert() && ! dml_flag.is_update())) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_ERROR("unknown DML type, not supported", KR(ret), K(dml_flag));
+  } else if (OB_FAIL(meta_manager_->get_table_schema_meta(
+      simple_table_schema->get_schema_version(),
+      simple_table_schema->get_tenant_id(),
+      simple_table_schema->get_table_id(),
+      tb_schema_info))) {
+    LOG_ERROR("meta_manager_ get_table_schema_meta fail", KR(ret),
+        "version", simple_table_schema->get_schema_version(),
+        "tenant_id", simple_table_schema->get_tenant_id(),
+        "table_id", simple_table_schema->get_table_id());
+  } else if (OB_ISNULL(tb_schema_info)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("tb_schema_info is null", KR(ret), K(tb_schema_info));
+  } else {
+    ObLogEntryTask &log_entry_task = stmt_task.get_redo_log_entry_task();
+    const int64_t column_num = rv->column_num_;
+    // UPDATE outputs the rowkey before update as extra columns, the rowkey may be changed
+    const bool is_update = dml_flag.is_update();
+    int64_t rowkey_num = 0;
+    ObCDCArrowRow *arrow_row = NULL;
+    ObCDCArrowRow::Cell *cells = NULL;
+    int64_t *rowkey_idxs = NULL;
+    ObCDCArrowRow::Cell *old_rowkey_cells = NULL;
+
+    for (int64_t idx = 0; idx < column_num; idx++) {
+      if (rv->is_rowkey_[idx]) {
+        rowkey_num++;
+      }
+    }
+
+    if (OB_ISNULL(arrow_row = static_cast<ObCDCArrowRow *>(log_entry_task.alloc(sizeof(ObCDCArrowRow))))
+        || OB_ISNULL(cells = static_cast<ObCDCArrowRow::Cell *>(
+            log_entry_task.alloc(sizeof(ObCDCArrowRow::Cell) * column_num)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_ERROR("allocate memory for arrow row fail", KR(ret), K(column_num));
+    } else if (rowkey_num > 0
+        && (OB_ISNULL(rowkey_idxs = static_cast<int64_t *>(log_entry_task.alloc(sizeof(int64_t) * rowkey_num)))
+        || OB_ISNULL(old_rowkey_cells = static_cast<ObCDCArrowRow::Cell *>(
+            log_entry_task.alloc(sizeof(ObCDCArrowRow::Cell) * rowkey_num))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_ERROR("allocate memory for old rowkey of arrow row fail", KR(ret), K(rowkey_num));
+    }
+
+    for (int64_t idx = 0, rowkey_idx = 0; OB_SUCC(ret) && idx < column_num; idx++) {
+      ColumnSchemaInfo *column_schema_info = NULL;
+      const ObObj *obj = NULL;
+      const ObString *str = NULL;
+
+      if (OB_UNLIKELY(rv->is_diff_[idx])) {
+        // partial update of json can't be output as a whole value
+        ret = OB_NOT_SUPPORTED;
+        LOG_ERROR("lob diff column is not supported in the Arrow output mode", KR(ret), K(idx),
+            "table_id", simple_table_schema->get_table_id());
+      } else if (OB_FAIL(tb_schema_info->get_column_schema_info(static_cast<int16_t>(idx),
+          false/*is_column_stored_idx*/, column_schema_info))) {
+        LOG_ERROR("get_column_schema_info fail", KR(ret), K(idx), KPC(tb_schema_info));
+      } else if (OB_ISNULL(column_schema_info)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_ERROR("column_schema_info is null", KR(ret), K(idx));
+      } else if (OB_FAIL(get_arrow_col_value_(*rv, *column_schema_info, idx, dml_flag, obj, str))) {
+        LOG_ERROR("get_arrow_col_value_ fail", KR(ret), K(idx), K(dml_flag));
+      } else {
+        fill_arrow_cell_(*column_schema_info, obj, str, cells[idx]);
+
+        if (rv->is_rowkey_[idx]) {
+          rowkey_idxs[rowkey_idx] = idx;
+
+          if (! is_update) {
+            fill_arrow_cell_(*column_schema_info, NULL, NULL, old_rowkey_cells[rowkey_idx]);
+          } else if (NULL != rv->old_columns_[idx]) {
+            fill_arrow_cell_(*column_schema_info, rv->old_objs_[idx], rv->old_columns_[idx],
+                old_rowkey_cells[rowkey_idx]);
+          } else {
+            // rowkey is filled into the new value by fill_rowkey_cols_ if old value is not logged
+            fill_arrow_cell_(*column_schema_info, rv->new_objs_[idx], rv->new_columns_[idx],
+                old_rowkey_cells[rowkey_idx]);
+          }
+          rowkey_idx++;
+        }
+      }
+    }
+
+    if (OB_SUCC(ret)) {
+      arrow_row->table_id_ = simple_table_schema->get_table_id();
+      arrow_row->table_schema_version_ = simple_table_schema->get_schema_version();
+      arrow_row->record_type_ = br_data->recordType();
+      arrow_row->column_num_ = column_num;
+      arrow_row->cells_ = cells;
+      arrow_row->rowkey_num_ = rowkey_num;
+      arrow_row->rowkey_idxs_ = rowkey_idxs;
+      arrow_row->old_rowkey_cells_ = old_rowkey_cells;
+      br->set_arrow_row(arrow_row);
+      br->set_is_valid(true);
+    }
+  }
+
+  return ret;
+}
+
+int ObLogFormatter::get_arrow_col_value_(
+    const RowValue &rv,
+    const ColumnSchemaInfo &column_schema_info,
+    const int64_t idx,
+    const ObDmlRowFlag &dml_flag,
+    const ObObj *&obj,
+    const ObString *&str)
+{
+  int ret = OB_SUCCESS;
+  // DELETE outputs the old value except the rowkey, UPDATE outputs the old value of unchanged
+  // columns, INSERT and PUT output the original default value of unchanged columns
+  const bool use_old_value = dml_flag.is_delete() ? ! rv.is_rowkey_[idx]
+      : (dml_flag.is_update() && ! rv.is_changed_[idx]);
+  bool use_default_value = (! dml_flag.is_delete() && ! dml_flag.is_update() && ! rv.is_changed_[idx]);
+  obj = NULL;
+  str = NULL;
+
+  if (use_old_value) {
+    if (NULL != rv.old_columns_[idx]) {
+      obj = rv.old_objs_[idx];
+      str = rv.old_columns_[idx];
+    } else if (! rv.contain_old_column_ || rv.is_old_col_nop_[idx] || rv.is_null_lob_columns_[idx]) {
+      // value is not logged, output NULL
+    } else {
+      // column added after the row is written
+      use_default_value = true;
+    }
+  } else if (! use_default_value) {
+    obj = rv.new_objs_[idx];
+    str = rv.new_columns_[idx];
+  }
+
+  if (use_default_value) {
+    if (OB_ISNULL(str = rv.orig_default_value_[idx])) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_ERROR("column original default value is NULL", KR(ret), K(idx), "column_num", rv.column_num_);
+    } else {
+      obj = column_schema_info.get_orig_default_obj();
+    }
+  }
+
+  return ret;
+}
+
+void ObLogFormatter::fill_arrow_cell_(
+    const ColumnSchemaInfo &column_schema_info,
+    const ObObj *obj,
+    const ObString *str,
+    ObCDCArrowRow::Cell &cell)
+{
+  cell.meta_ = column_schema_info.get_meta_type();
+  cell.obj_ = obj;
+  // value of native Arrow type is output by ObObj, others by string
+  cell.str_ = (NULL == obj || column_schema_info.is_udt_column()
+      || ! ObCDCArrowWriter::is_native_type(cell.meta_)) ? str : NULL;
+}
+
 int ObLogFormatter::is_hbase_mode_put_(const uint64_t table_id,
     const ObDmlRowFlag &dml_flag,
     const int64_t column_number,
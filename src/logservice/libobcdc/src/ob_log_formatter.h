@@ -32,6 +32,7 @@
 #include "ob_log_hbase_mode.h"                      // ObLogHbaseUtil
 #include "ob_log_schema_getter.h"                   // DBSchemaInfo
 #include "ob_log_work_mode.h"                       // WorkingMode
+#include "ob_cdc_arrow_writer.h"                    // ObCDCArrowRow, ObCDCArrowWriter
 
 namespace oceanbase
 {
@@ -120,7 +121,8 @@ public:
       const bool enable_hbase_mode,
       ObLogHbaseUtil &hbase_util,
       const bool skip_hbase_mode_put_column_count_not_consistency,
-      const bool enable_output_hidden_primary_key);
+      const bool enable_output_hidden_primary_key,
+      const bool enable_output_arrow_format = false);
   void destroy();
 
 private:
@@ -134,6 +136,10 @@ private:
     common::ObString *new_columns_[common::OB_MAX_COLUMN_NUMBER];
     common::ObString *old_columns_[common::OB_MAX_COLUMN_NUMBER];
     common::ObString *orig_default_value_[common::OB_MAX_COLUMN_NUMBER];
+    // value of in row column, new_columns_/old_columns_ only hold the converted string of
+    // the column which has no native Arrow type in the Arrow output mode
+    const common::ObObj *new_objs_[common::OB_MAX_COLUMN_NUMBER];
+    const common::ObObj *old_objs_[common::OB_MAX_COLUMN_NUMBER];
 
     bool is_rowkey_[common::OB_MAX_COLUMN_NUMBER];
     bool is_changed_[common::OB_MAX_COLUMN_NUMBER];
@@ -257,10 +263,18 @@ private:
       const bool is_new_value);
   template<class TABLE_SCHEMA>
   int fill_rowkey_cols_(
+      DmlStmtTask &stmt_task,
       RowValue *rv,
       ColValueList &rowkey_cols,
       const TABLE_SCHEMA *simple_table_schema,
-      const TableSchemaInfo &tb_schema_info);
+      const TableSchemaInfo &tb_schema_info,
+      const ObTimeZoneInfoWrap *tz_info_wrap);
+  // Convert the in row column value to string only if it has no native Arrow type
+  int fill_arrow_col_value_(
+      DmlStmtTask &stmt_task,
+      const ColumnSchemaInfo &column_schema_info,
+      const ObTimeZoneInfoWrap *tz_info_wrap,
+      ColValue &cv);
   template<class TABLE_SCHEMA>
   int build_binlog_record_(
       ObLogBR *br,
@@ -268,6 +282,27 @@ private:
       const int64_t new_column_cnt,
       const blocksstable::ObDmlRowFlag &dml_flag,
       const TABLE_SCHEMA *simple_table_schema);
+  // Build ObCDCArrowRow instead of filling columns of the binlog record in the Arrow output mode
+  template<class TABLE_SCHEMA>
+  int build_arrow_row_(
+      ObLogBR *br,
+      RowValue *rv,
+      DmlStmtTask &stmt_task,
+      const TABLE_SCHEMA *simple_table_schema);
+  // Get the value of column output in the Arrow record batch, which is the same as the value
+  // put into the binlog record by format_dml_xxx_, obj and str are NULL if the value is not logged
+  int get_arrow_col_value_(
+      const RowValue &rv,
+      const ColumnSchemaInfo &column_schema_info,
+      const int64_t idx,
+      const blocksstable::ObDmlRowFlag &dml_flag,
+      const common::ObObj *&obj,
+      const common::ObString *&str);
+  void fill_arrow_cell_(
+      const ColumnSchemaInfo &column_schema_info,
+      const common::ObObj *obj,
+      const common::ObString *str,
+      ObCDCArrowRow::Cell &cell);
   // HBase mode put
   // 1. hbase table
   // 2. update type
@@ -361,6 +396,7 @@ private:
   ObLogHbaseUtil             *hbase_util_;
   bool                       skip_hbase_mode_put_column_count_not_consistency_;
   bool                       enable_output_hidden_primary_key_;
+  bool                       enable_output_arrow_format_;
   int64_t                    log_entry_task_count_;
   int64_t                    stmt_in_lob_merger_count_;
 
@@ -740,6 +740,7 @@ int ObLogInstance::init_components_(const uint64_t start_tstamp_ns)
   bool skip_hbase_mode_put_column_count_not_consistency = (TCONF.skip_hbase_mode_put_column_count_not_consistency != 0);
   bool enable_convert_timestamp_to_unix_timestamp = (TCONF.enable_convert_timestamp_to_unix_timestamp != 0);
   bool enable_output_hidden_primary_key = (TCONF.enable_output_hidden_primary_key != 0);
+  bool enable_output_arrow_format = (TCONF.enable_output_arrow_format != 0);
   bool enable_oracle_mode_match_case_sensitive = (TCONF.enable_oracle_mode_match_case_sensitive != 0);
   const char *rs_list = TCONF.rootserver_list.str();
   const char *tg_white_list = TCONF.tablegroup_white_list.str();
@@ -784,6 +785,18 @@ int ObLogInstance::init_components_(const uint64_t start_tstamp_ns)
     LOG_INFO("set working mode", K(working_mode_str), K(working_mode_), "working_mode", print_working_mode(working_mode_));
   }
 
+  if (OB_SUCC(ret) && enable_output_arrow_format) {
+    // DML rows are recycled once copied into Arrow record batch, which is not compatible with storage working mode
+    if (OB_UNLIKELY(! is_memory_working_mode(working_mode_))) {
+      ret = OB_INVALID_CONFIG;
+      LOG_ERROR("enable_output_arrow_format is only supported in memory working mode", KR(ret),
+          "working_mode", print_working_mode(working_mode_));
+    } else if (OB_UNLIKELY(enable_hbase_mode)) {
+      ret = OB_INVALID_CONFIG;
+      LOG_ERROR("enable_output_arrow_format is not supported with enable_hbase_mode", KR(ret));
+    }
+  }
+
   if (OB_SUCC(ret)) {
     if (OB_UNLIKELY(! is_refresh_mode_valid(refresh_mode))) {
       ret = OB_INVALID_CONFIG;
@@ -984,7 +997,8 @@ int ObLogInstance::init_components_(const uint64_t start_tstamp_ns)
       CDC_CFG_MGR.get_msg_sorter_task_count_upper_limit(), *trans_stat_mgr_, err_handler);
 
   INIT(committer_, ObLogCommitter, start_seq, &br_queue_, resource_collector_,
-      br_pool_, trans_ctx_mgr_, trans_stat_mgr_, err_handler);
+      br_pool_, trans_ctx_mgr_, trans_stat_mgr_, err_handler, enable_output_arrow_format,
+      TCONF.arrow_batch_row_count);
 
   INIT(storager_, ObLogStorager, TCONF.storager_thread_num, CDC_CFG_MGR.get_storager_queue_length(), *store_service_, *err_handler);
 
@@ -996,7 +1010,7 @@ int ObLogInstance::init_components_(const uint64_t start_tstamp_ns)
   INIT(formatter_, ObLogFormatter, TCONF.formatter_thread_num, CDC_CFG_MGR.get_formatter_queue_length(), working_mode_,
       &obj2str_helper_, br_pool_, meta_manager_, schema_getter_, storager_, err_handler,
       skip_dirty_data, enable_hbase_mode, hbase_util_, skip_hbase_mode_put_column_count_not_consistency,
-      enable_output_hidden_primary_key);
+      enable_output_hidden_primary_key, enable_output_arrow_format);
 
   INIT(lob_data_merger_, ObCDCLobDataMerger, TCONF.lob_data_merger_thread_num,
       TCONF.lob_data_merger_queue_length, *err_handler);
@@ -1596,6 +1610,29 @@ int ObLogInstance::get_tenant_ids(std::vector<uint64_t> &tenant_ids)
   return ret;
 }
 
+int ObLogInstance::set_arrow_batch_callback(ARROW_BATCH_CALLBACK cb, void *cb_arg)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(! inited_)) {
+    LOG_ERROR("instance has not been initialized");
+    ret = OB_NOT_INIT;
+  } else if (OB_ISNULL(cb)) {
+    LOG_ERROR("invalid arrow batch callback", KP(cb));
+    ret = OB_INVALID_ARGUMENT;
+  } else if (OB_UNLIKELY(is_running_)) {
+    LOG_ERROR("arrow batch callback should be set before launch", K_(is_running));
+    ret = OB_STATE_NOT_MATCH;
+  } else if (OB_ISNULL(committer_)) {
+    LOG_ERROR("committer_ is null", K(committer_));
+    ret = OB_ERR_UNEXPECTED;
+  } else {
+    committer_->set_arrow_batch_callback(cb, cb_arg);
+  }
+
+  return ret;
+}
+
 void ObLogInstance::mark_stop_flag(const char *stop_reason)
 {
   stop_flag_ = true;
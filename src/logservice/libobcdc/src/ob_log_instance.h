@@ -141,6 +141,7 @@ public:
   virtual int launch();
   virtual void stop();
   virtual int get_tenant_ids(std::vector<uint64_t> &tenant_ids);
+  virtual int set_arrow_batch_callback(ARROW_BATCH_CALLBACK cb, void *cb_arg);
 
 public:
   void mark_stop_flag(const char *stop_reason);
@@ -644,6 +644,56 @@ int LSFetchCtx::update_progress(
   return ret;
 }
 
+int LSFetchCtx::read_filtered_redo(
+    const transaction::ObTransID &tx_id,
+    const uint64_t org_cluster_id,
+    const palf::LSN &lsn)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_ISNULL(part_trans_resolver_)) {
+    ret = OB_INVALID_ERROR;
+    LOG_ERROR("invalid part trans resolver", KR(ret), K_(part_trans_resolver));
+  } else if (OB_FAIL(part_trans_resolver_->read_filtered_redo(tx_id, org_cluster_id, lsn))) {
+    LOG_ERROR("read_filtered_redo failed", KR(ret), K_(tls_id), K(tx_id), K(org_cluster_id), K(lsn));
+  }
+
+  return ret;
+}
+
+int LSFetchCtx::skip_filtered_group(
+    const palf::LSN &group_entry_lsn,
+    const int64_t group_entry_size,
+    const int64_t submit_ts)
+{
+  int ret = OB_SUCCESS;
+
+  // Verifying log continuity
+  if (OB_UNLIKELY(progress_.get_next_lsn() != group_entry_lsn)) {
+    ret = OB_LOG_NOT_SYNC;
+    LOG_ERROR("log not sync", KR(ret), "next_log_lsn", progress_.get_next_lsn(),
+        "filtered_log_lsn", group_entry_lsn, K(group_entry_size));
+  } else if (OB_UNLIKELY(group_entry_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_ERROR("invalid filtered group entry size", KR(ret), K_(tls_id), K(group_entry_lsn), K(group_entry_size));
+  } else {
+    const palf::LSN next_lsn = group_entry_lsn + group_entry_size;
+
+    // the memory storage can't cross the filtered group entry
+    reset_memory_storage();
+
+    if (OB_FAIL(progress_.update_log_progress(next_lsn, group_entry_size, submit_ts))) {
+      LOG_ERROR("update log progress fail", KR(ret), K(next_lsn), K(group_entry_size), K(submit_ts),
+          K(progress_));
+    } else {
+      LOG_DEBUG("skip filtered group entry and update progress success", K_(tls_id), K(group_entry_lsn),
+          K(group_entry_size), K_(progress));
+    }
+  }
+
+  return ret;
+}
+
 int LSFetchCtx::handle_offline_ls_log_(const palf::LogEntry &log_entry,
     volatile bool &stop_flag)
 {
@@ -160,6 +160,30 @@ public:
       const palf::LogGroupEntry &group_entry,
       const palf::LSN &group_entry_lsn);
 
+  /// Read redo log entry filtered by observer, see ObCdcTabletFilter
+  ///
+  /// @param [in]   tx_id             trans of the redo
+  /// @param [in]   org_cluster_id    org_cluster_id of the redo
+  /// @param [in]   lsn               LSN of the redo log entry
+  ///
+  /// @retval OB_SUCCESS            success
+  /// @retval Other error codes     fail
+  int read_filtered_redo(
+      const transaction::ObTransID &tx_id,
+      const uint64_t org_cluster_id,
+      const palf::LSN &lsn);
+
+  /// Move progress over the group entry filtered by observer, the group entries after it
+  /// should be appended into a new memory storage.
+  ///
+  /// @retval OB_SUCCESS            success
+  /// @retval OB_LOG_NOT_SYNC       the filtered group entry is not the next log
+  /// @retval Other error codes     fail
+  int skip_filtered_group(
+      const palf::LSN &group_entry_lsn,
+      const int64_t group_entry_size,
+      const int64_t submit_ts);
+
   /// Offline LS, clear all unexported tasks and issue OFFLINE type tasks
   ///
   /// @retval OB_SUCCESS          success
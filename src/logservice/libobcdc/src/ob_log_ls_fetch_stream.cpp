@@ -1185,7 +1185,7 @@ int FetchStream::handle_fetch_log_result_(
         is_stream_valid = true;
 
         // When the fetched log is empty, it needs to sleep for a while
-        if (resp.get_log_num() <= 0) {
+        if (resp.get_log_num() <= 0 && resp.get_filtered_group_arr().count() <= 0) {
           need_hibernate = true;
         }
 
@@ -1391,9 +1391,15 @@ int FetchStream::read_log_(
   } else if (OB_ISNULL(ls_fetch_ctx_)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_ERROR("invalid ls_fetch_ctx", KR(ret), K(ls_fetch_ctx_));
-  } else if (0 == log_cnt) {
+  } else if (0 == log_cnt && resp.get_filtered_group_arr().count() <= 0) {
     // Ignore 0 logs
     LOG_DEBUG("fetch 0 log", K_(svr), "fetch_status", resp.get_fetch_status());
+  } else if (resp.get_filtered_group_arr().count() > 0) {
+    if (OB_FAIL(read_filtered_log_(resp, stop_flag, kick_out_info, decode_log_entry_time, tsi))) {
+      if (OB_IN_STOP_STATE != ret && OB_NEED_RETRY != ret && OB_LOG_NOT_SYNC != ret) {
+        LOG_ERROR("read filtered log failed", KR(ret), K_(ls_fetch_ctx), K(resp));
+      }
+    }
   } else if (OB_FAIL(ls_fetch_ctx_->append_log(buf, len))) {
     LOG_ERROR("append log to LSFetchCtx failed", KR(ret), KPC(ls_fetch_ctx_), K(resp));
   } else {
@@ -1440,6 +1446,131 @@ int FetchStream::read_log_(
   return ret;
 }
 
+int FetchStream::read_filtered_log_(
+    const obrpc::ObCdcLSFetchLogResp &resp,
+    volatile bool &stop_flag,
+    KickOutInfo &kick_out_info,
+    int64_t &decode_log_entry_time,
+    logfetcher::TransStatInfo &tsi)
+{
+  int ret = OB_SUCCESS;
+  const char *buf = resp.get_log_entry_buf();
+  const int64_t len = resp.get_pos();
+  const int64_t log_cnt = resp.get_log_num();
+  const ObCdcLSFetchLogResp::FilteredGroupArray &filtered_group_arr = resp.get_filtered_group_arr();
+  const ObCdcLSFetchLogResp::FilteredRedoArray &filtered_redo_arr = resp.get_filtered_redo_arr();
+  int64_t pos = 0;
+  int64_t read_log_cnt = 0;
+  int64_t redo_idx = 0;
+
+  // The group entries in buf are the ones around the filtered group entries, read them segment by segment.
+  // Each segment starts at the next LSN of LS, and ends at the next filtered group entry or the end of buf.
+  for (int64_t group_idx = 0; OB_SUCC(ret) && group_idx <= filtered_group_arr.count(); ++group_idx) {
+    const bool is_last_segment = (filtered_group_arr.count() == group_idx);
+    const palf::LSN next_lsn = ls_fetch_ctx_->get_next_lsn();
+    int64_t segment_len = len - pos;
+
+    if (! is_last_segment) {
+      const palf::LSN &filtered_lsn = filtered_group_arr.at(group_idx).lsn_;
+      if (OB_UNLIKELY(filtered_lsn < next_lsn)) {
+        ret = OB_LOG_NOT_SYNC;
+        LOG_ERROR("log not sync", KR(ret), K(next_lsn), K(filtered_lsn), K(group_idx), K(resp));
+      } else {
+        segment_len = static_cast<int64_t>(filtered_lsn - next_lsn);
+      }
+    }
+
+    if (OB_FAIL(ret)) {
+    } else if (OB_UNLIKELY(pos + segment_len > len)) {
+      ret = OB_LOG_NOT_SYNC;
+      LOG_ERROR("log not sync, filtered group entry is beyond the log buf", KR(ret), K(next_lsn),
+          K(pos), K(segment_len), K(len), K(group_idx), K(resp));
+    } else if (segment_len > 0 && OB_FAIL(read_log_segment_(buf + pos, segment_len, next_lsn + segment_len,
+        read_log_cnt, stop_flag, kick_out_info, decode_log_entry_time, tsi))) {
+      if (OB_IN_STOP_STATE != ret && OB_NEED_RETRY != ret && OB_LOG_NOT_SYNC != ret) {
+        LOG_ERROR("read log segment failed", KR(ret), K(next_lsn), K(pos), K(segment_len), K(group_idx));
+      }
+    } else if (FALSE_IT(pos += segment_len)) {
+    } else if (! is_last_segment) {
+      const ObCdcLSFetchLogResp::FilteredGroup &filtered_group = filtered_group_arr.at(group_idx);
+      const palf::LSN group_end_lsn = filtered_group.lsn_ + filtered_group.group_size_;
+
+      // redo of the filtered group entry are treated as fetched by their trans
+      for (; OB_SUCC(ret) && redo_idx < filtered_redo_arr.count()
+          && filtered_redo_arr.at(redo_idx).lsn_ < group_end_lsn; ++redo_idx) {
+        const ObCdcLSFetchLogResp::FilteredRedo &filtered_redo = filtered_redo_arr.at(redo_idx);
+
+        if (OB_FAIL(ls_fetch_ctx_->read_filtered_redo(transaction::ObTransID(filtered_redo.tx_id_),
+            filtered_redo.cluster_id_, filtered_redo.lsn_))) {
+          LOG_ERROR("read filtered redo failed", KR(ret), K(filtered_redo), K(filtered_group));
+        }
+      }
+
+      if (OB_SUCC(ret) && OB_FAIL(ls_fetch_ctx_->skip_filtered_group(filtered_group.lsn_,
+          filtered_group.group_size_, filtered_group.submit_ts_))) {
+        if (OB_LOG_NOT_SYNC != ret) {
+          LOG_ERROR("skip filtered group failed", KR(ret), K(filtered_group));
+        }
+      }
+    }
+  }
+
+  if (OB_SUCC(ret) && OB_UNLIKELY(read_log_cnt != log_cnt || redo_idx != filtered_redo_arr.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("log count not match with response", KR(ret), K(read_log_cnt), K(log_cnt), K(redo_idx),
+        "filtered_redo_count", filtered_redo_arr.count(), K(resp));
+  }
+
+  return ret;
+}
+
+int FetchStream::read_log_segment_(
+    const char *buf,
+    const int64_t len,
+    const palf::LSN &end_lsn,
+    int64_t &read_log_cnt,
+    volatile bool &stop_flag,
+    KickOutInfo &kick_out_info,
+    int64_t &decode_log_entry_time,
+    logfetcher::TransStatInfo &tsi)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_FAIL(ls_fetch_ctx_->append_log(buf, len))) {
+    LOG_ERROR("append log to LSFetchCtx failed", KR(ret), KPC(ls_fetch_ctx_), K(len));
+  }
+
+  while (OB_SUCC(ret) && ls_fetch_ctx_->get_next_lsn() < end_lsn) {
+    int64_t begin_time = get_timestamp();
+    palf::LSN group_start_lsn;
+    palf::LogGroupEntry group_entry;
+
+    if (OB_FAIL(ls_fetch_ctx_->get_next_group_entry(group_entry, group_start_lsn))) {
+      if (OB_ITER_END == ret) {
+        ret = OB_ERR_UNEXPECTED;
+      }
+      LOG_ERROR("get next_group_entry failed", KR(ret), K_(ls_fetch_ctx), K(end_lsn));
+    } else {
+      // GroupLogEntry deserialize time
+      decode_log_entry_time += (get_timestamp() - begin_time);
+      if (OB_FAIL(read_group_entry_(group_entry, group_start_lsn,
+          stop_flag, kick_out_info, tsi))) {
+        if (OB_IN_STOP_STATE != ret && OB_NEED_RETRY != ret) {
+          LOG_ERROR("read group entry failed", KR(ret), KPC(this));
+        } else if (OB_NEED_RETRY == ret) {
+          ls_fetch_ctx_->reset_memory_storage();
+        }
+      } else if (OB_FAIL(ls_fetch_ctx_->update_progress(group_entry, group_start_lsn))) {
+        LOG_ERROR("ls_fetch_ctx_ update_progress failed", KR(ret), K(group_entry), K(group_start_lsn));
+      } else {
+        read_log_cnt++;
+      }
+    }
+  }
+
+  return ret;
+}
+
 int FetchStream::kick_out_task_(const KickOutInfo &kick_out_info)
 {
   int ret = OB_SUCCESS;
@@ -240,6 +240,23 @@ private:
       int64_t &read_log_time,
       int64_t &decode_log_entry_time,
       logfetcher::TransStatInfo &tsi);
+  // read the response with group entries filtered by observer
+  int read_filtered_log_(
+      const obrpc::ObCdcLSFetchLogResp &resp,
+      volatile bool &stop_flag,
+      KickOutInfo &kick_out_info,
+      int64_t &decode_log_entry_time,
+      logfetcher::TransStatInfo &tsi);
+  // read the continuous group entries in buf, which end at end_lsn
+  int read_log_segment_(
+      const char *buf,
+      const int64_t len,
+      const palf::LSN &end_lsn,
+      int64_t &read_log_cnt,
+      volatile bool &stop_flag,
+      KickOutInfo &kick_out_info,
+      int64_t &decode_log_entry_time,
+      logfetcher::TransStatInfo &tsi);
 
   KickOutReason get_feedback_reason_(const Feedback &feedback) const;
   int check_feedback_(
@@ -20,6 +20,7 @@
 #include "share/schema/ob_schema_struct.h"            // USER_TABLE
 #include "share/inner_table/ob_inner_table_schema.h"  // OB_ALL_DDL_OPERATION_TID
 #include "share/schema/ob_part_mgr_util.h"            // ObTablePartitionKeyIter
+#include "lib/utility/ob_sort.h"                      // ob_sort
 
 #include "ob_log_schema_getter.h"                     // IObLogSchemaGetter, ObLogSchemaGuard
 #include "ob_log_utils.h"                             // is_ddl_table
@@ -122,6 +123,10 @@ void ObLogPartMgr::reset()
   global_normal_index_table_cache_ = NULL;
   tablet_to_table_info_.destroy();
   table_id_cache_.destroy();
+  served_tablet_version_ = 0;
+  served_tablet_ids_version_ = OB_INVALID_VERSION;
+  served_tablet_ids_.reset();
+  max_start_tablet_id_.reset();
   cur_schema_version_ = OB_INVALID_VERSION;
   enable_oracle_mode_match_case_sensitive_ = false;
   enable_check_schema_version_ = false;
@@ -240,9 +245,12 @@ int ObLogPartMgr::insert_tablet_table_info_(
 
     if (OB_FAIL(tablet_to_table_info_.insert_tablet_table_info(tablet_id, table_info))) {
       LOG_ERROR("insert_tablet_table_info failed", KR(ret), K(tablet_id), K(table_info));
+    } else if (tablet_id.is_user_tablet() && tablet_id > max_start_tablet_id_) {
+      max_start_tablet_id_ = tablet_id;
     }
   }
 
+  mark_served_tablets_changed_();
   return ret;
 }
 
@@ -871,6 +879,7 @@ int ObLogPartMgr::insert_table_id_into_cache(const uint64_t table_id, const uint
       LOG_ERROR("insert table_id into cache failed", KR(ret), K(table_id), K(database_id));
     }
   }
+  mark_served_tablets_changed_();
   return ret;
 }
 
@@ -886,6 +895,7 @@ int ObLogPartMgr::delete_table_id_from_cache(const uint64_t table_id)
       LOG_ERROR("delete table_id from cache failed", KR(ret), K(table_id));
     }
   }
+  mark_served_tablets_changed_();
   return ret;
 }
 
@@ -896,6 +906,7 @@ int ObLogPartMgr::delete_db_from_cache(const uint64_t database_id)
   if (OB_FAIL(table_id_cache_.remove_if(table_info_eraser_by_database))) {
     LOG_ERROR("delete db from cache failed", KR(ret), K(database_id));
   }
+  mark_served_tablets_changed_();
   return ret;
 }
 
@@ -1320,6 +1331,7 @@ int ObLogPartMgr::apply_create_tablet_change(const ObCDCTabletChangeInfo &tablet
     }
   }
 
+  mark_served_tablets_changed_();
   return ret;
 }
 
@@ -1348,6 +1360,7 @@ int ObLogPartMgr::apply_delete_tablet_change(const ObCDCTabletChangeInfo &tablet
     }
   }
 
+  mark_served_tablets_changed_();
   return ret;
 }
 
@@ -1380,9 +1393,77 @@ int ObLogPartMgr::apply_exchange_tablet_change(const ObCDCTabletChangeInfo &tabl
     }
   }
 
+  mark_served_tablets_changed_();
   return ret;
 }
 
+int ObLogPartMgr::get_served_tablet_ids(
+    common::ObIArray<common::ObTabletID> &tablet_ids,
+    common::ObTabletID &max_tablet_id)
+{
+  int ret = OB_SUCCESS;
+  tablet_ids.reset();
+  max_tablet_id.reset();
+
+  if (OB_UNLIKELY(! inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_ERROR("PartMgr has not been initialized", KR(ret));
+  } else if (! enable_white_black_list_) {
+    // all tables are served
+  } else {
+    ObSpinLockGuard guard(served_tablet_lock_);
+    const int64_t served_tablet_version = ATOMIC_LOAD(&served_tablet_version_);
+
+    // the changes during collecting bump served_tablet_version_ again, the list will be rebuilt next time
+    if (served_tablet_version != served_tablet_ids_version_) {
+      ServedTabletCollector collector(*this);
+
+      if (OB_FAIL(tablet_to_table_info_.for_each(collector))) {
+        LOG_ERROR("iterate tablet_to_table_info failed", KR(ret), K_(tenant_id));
+      } else if (OB_FAIL(collector.ret_)) {
+        LOG_ERROR("collect served tablets failed", KR(ret), K_(tenant_id));
+      } else if (FALSE_IT(lib::ob_sort(collector.tablet_ids_.begin(), collector.tablet_ids_.end()))) {
+      } else if (OB_FAIL(served_tablet_ids_.assign(collector.tablet_ids_))) {
+        LOG_ERROR("assign served tablet ids failed", KR(ret), K_(tenant_id));
+      } else {
+        served_tablet_ids_version_ = served_tablet_version;
+        ISTAT("[SERVED_TABLET_IDS] [REBUILD]", K_(tenant_id), K(served_tablet_version),
+            "served_tablet_count", served_tablet_ids_.count(), K_(max_start_tablet_id),
+            K_(tablet_to_table_info));
+      }
+    }
+
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(tablet_ids.assign(served_tablet_ids_))) {
+      LOG_ERROR("assign tablet ids failed", KR(ret), K_(tenant_id));
+    } else {
+      max_tablet_id = max_start_tablet_id_;
+    }
+  }
+
+  return ret;
+}
+
+bool ObLogPartMgr::ServedTabletCollector::operator()(
+    const common::ObTabletID &tablet_id,
+    ObCDCTableInfo &table_info)
+{
+  bool is_served = false;
+  const bool is_global_normal_index = false;
+
+  // rows of index tables are never output, the inner tablets are always sent by observer.
+  // LOB aux tables are in TableIDCache together with their primary tables.
+  if (! tablet_id.is_user_tablet() || table_info.is_index_table()) {
+  } else if (OB_SUCCESS != (ret_ = part_mgr_.is_exist_table_id_cache_(table_info.get_table_id(),
+      is_global_normal_index, is_served))) {
+    LOG_ERROR_RET(ret_, "check is_exist_table_id_cache_ failed", K(ret_), K(tablet_id), K(table_info));
+  } else if (is_served && OB_SUCCESS != (ret_ = tablet_ids_.push_back(tablet_id))) {
+    LOG_ERROR_RET(ret_, "push back served tablet failed", K(ret_), K(tablet_id), K(table_info));
+  }
+
+  return common::OB_SUCCESS == ret_;
+}
+
 // @retval OB_SUCCESS                   success
 // @retval OB_TIMEOUT                   timeout
 // @retval OB_TENANT_HAS_BEEN_DROPPED   caller should ignore error code if schema error like tenant/database not exist
@@ -2039,6 +2120,7 @@ int ObLogPartMgr::add_table_id_into_cache_(const ObSimpleTableSchemaV2 &tb_schem
     }
   }
 
+  mark_served_tablets_changed_();
   return ret;
 }
 
@@ -2087,6 +2169,7 @@ int ObLogPartMgr::remove_table_id_from_cache_(const ObSimpleTableSchemaV2 &tb_sc
     }
   }
 
+  mark_served_tablets_changed_();
   return ret;
 }
 
@@ -16,6 +16,7 @@
 #define OCEANBASE_LIBOBCDC_OB_LOG_PART_MGR_H_
 
 #include "lib/lock/ob_thread_cond.h"            // ObThreadCond
+#include "lib/lock/ob_spin_lock.h"              // ObSpinLock
 #include "share/schema/ob_schema_struct.h"      // PartitionStatus
 #include "logservice/data_dictionary/ob_data_dict_struct.h"  // ObDictTableMeta
 #include "ob_log_table_id_cache.h"              // GIndexCache, TableIDCache
@@ -258,6 +259,20 @@ public:
   virtual int delete_table_id_from_cache(const uint64_t table_id) = 0;
   virtual int delete_db_from_cache(const uint64_t database_id) = 0;
   virtual int apply_exchange_tablet_change(const ObCDCTabletChangeInfo &tablet_change_info) = 0;
+
+  /// Get the user tablets of the tables in TableIDCache, the fetch log rpc carries them as the
+  /// tablet white list, so that the observer elides the redo of other tablets.
+  /// The list is rebuilt after the DDL or tablet change which modifies TableIDCache or TabletToTableInfo.
+  ///
+  /// @param [out] tablet_ids     served user tablets in ascending order, empty if all tables are served
+  /// @param [out] max_tablet_id  the max user tablet known when the tables are loaded at start, the tablets
+  ///                             created after it may be handled by DDL later, so they can't be elided
+  ///
+  /// @retval OB_SUCCESS          success
+  /// @retval other error code    fail
+  virtual int get_served_tablet_ids(
+      common::ObIArray<common::ObTabletID> &tablet_ids,
+      common::ObTabletID &max_tablet_id) = 0;
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -370,8 +385,24 @@ public:
   virtual int delete_table_id_from_cache(const uint64_t table_id);
   virtual int delete_db_from_cache(const uint64_t database_id);
   virtual int apply_exchange_tablet_change(const ObCDCTabletChangeInfo &tablet_change_info);
+  virtual int get_served_tablet_ids(
+      common::ObIArray<common::ObTabletID> &tablet_ids,
+      common::ObTabletID &max_tablet_id);
 
 private:
+  // collect the user tablets of the tables in TableIDCache
+  struct ServedTabletCollector
+  {
+    explicit ServedTabletCollector(ObLogPartMgr &part_mgr) :
+        part_mgr_(part_mgr), tablet_ids_(), ret_(common::OB_SUCCESS) {}
+    bool operator()(const common::ObTabletID &tablet_id, ObCDCTableInfo &table_info);
+
+    ObLogPartMgr &part_mgr_;
+    common::ObArray<common::ObTabletID> tablet_ids_;
+    int ret_;
+  };
+
+  void mark_served_tablets_changed_() { ATOMIC_INC(&served_tablet_version_); }
   template<class TableMeta>
   int insert_tablet_table_info_(
       TableMeta &table_meta,
@@ -645,6 +676,13 @@ private:
   TabletToTableInfo  tablet_to_table_info_; // TabletID->TableID
   TableIDCache       table_id_cache_;
 
+  // served user tablets, rebuilt from TableIDCache and TabletToTableInfo after served_tablet_version_ changes
+  int64_t            served_tablet_version_ CACHE_ALIGNED;
+  common::ObSpinLock served_tablet_lock_;
+  int64_t            served_tablet_ids_version_;
+  common::ObArray<common::ObTabletID> served_tablet_ids_;
+  common::ObTabletID max_start_tablet_id_;
+
   int64_t            cur_schema_version_ CACHE_ALIGNED;
 
   // Default whitelist match insensitive
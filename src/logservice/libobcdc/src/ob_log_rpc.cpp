@@ -19,6 +19,9 @@
 #include "lib/oblog/ob_log_module.h"      // LOG_ERROR
 
 #include "ob_log_config.h"                // ObLogConfig
+#include "ob_log_instance.h"              // TCTX
+#include "ob_log_tenant.h"                // ObLogTenantGuard
+#include "lib/compress/ob_compressor_pool.h" // ObCompressorPool
 #include "observer/ob_srv_network_frame.h"
 #ifdef OB_BUILD_TDE_SECURITY
 #include "share/ob_encrypt_kms.h"         // ObSSLClient
@@ -78,6 +81,7 @@ namespace libobcdc
 
 int64_t ObLogRpc::g_rpc_process_handler_time_upper_limit =
     ObLogConfig::default_rpc_process_handler_time_upper_limit_msec * _MSEC_;
+common::ObCompressorType ObLogRpc::g_rpc_result_compressor_type = common::INVALID_COMPRESSOR;
 
 ObLogRpc::ObLogRpc() :
     is_inited_(false),
@@ -122,6 +126,8 @@ int ObLogRpc::async_stream_fetch_log(const uint64_t tenant_id,
   if (1 == TCONF.test_mode_switch_fetch_mode) {
     req.set_flag(ObCdcRpcTestFlag::OBCDC_RPC_TEST_SWITCH_MODE);
   }
+  req.set_compressor_type(ATOMIC_LOAD(&g_rpc_result_compressor_type));
+  set_tablet_white_list_(tenant_id, req);
   SEND_RPC(async_stream_fetch_log, tenant_id, svr, timeout, req, &cb);
   LOG_DEBUG("rpc: async fetch stream log", KR(ret), K(svr), K(timeout), K(req));
   return ret;
@@ -138,6 +144,7 @@ int ObLogRpc::async_stream_fetch_missing_log(const uint64_t tenant_id,
   if (1 == TCONF.test_mode_force_fetch_archive) {
     req.set_flag(ObCdcRpcTestFlag::OBCDC_RPC_FETCH_ARCHIVE);
   }
+  req.set_compressor_type(ATOMIC_LOAD(&g_rpc_result_compressor_type));
   SEND_RPC(async_stream_fetch_miss_log, tenant_id, svr, timeout, req, &cb);
   LOG_DEBUG("rpc: async fetch stream missing_log", KR(ret), K(svr), K(timeout), K(req));
   return ret;
@@ -338,6 +345,17 @@ void ObLogRpc::configure(const ObLogConfig &cfg)
   ATOMIC_STORE(&g_rpc_process_handler_time_upper_limit,
       rpc_process_handler_time_upper_limit_msec * _MSEC_);
   LOG_INFO("[CONFIG]", K(rpc_process_handler_time_upper_limit_msec));
+
+  const char *rpc_result_compress_func = cfg.rpc_result_compress_func.str();
+  common::ObCompressorType rpc_result_compressor_type = common::INVALID_COMPRESSOR;
+  if (OB_SUCCESS != ObCompressorPool::get_instance().get_compressor_type(rpc_result_compress_func,
+      rpc_result_compressor_type)) {
+    LOG_ERROR_RET(OB_INVALID_CONFIG, "invalid rpc_result_compress_func, keep the old compressor",
+        K(rpc_result_compress_func), K(g_rpc_result_compressor_type));
+  } else {
+    ATOMIC_STORE(&g_rpc_result_compressor_type, rpc_result_compressor_type);
+    LOG_INFO("[CONFIG]", K(rpc_result_compress_func), K(rpc_result_compressor_type));
+  }
 }
 
 int ObLogRpc::init_client_id_() {
@@ -348,5 +366,38 @@ int ObLogRpc::init_client_id_() {
   return ret;
 }
 
+void ObLogRpc::set_tablet_white_list_(const uint64_t tenant_id, obrpc::ObCdcLSFetchLogReq &req)
+{
+  int ret = OB_SUCCESS;
+  obrpc::ObCdcLSFetchLogReq::TabletWhiteList tablet_white_list;
+  ObTabletID max_filter_tablet_id;
+
+  // logs of sys LS are never filtered by observer
+  if (1 != TCONF.enable_fetch_log_tablet_filter || req.get_ls_id().is_sys_ls()) {
+  } else {
+    ObLogTenantGuard guard;
+    ObLogTenant *tenant = NULL;
+
+    if (OB_FAIL(TCTX.get_tenant_guard(tenant_id, guard))) {
+      LOG_WARN("get tenant_guard failed, fetch log without tablet filter", KR(ret), K(tenant_id));
+    } else if (OB_ISNULL(tenant = guard.get_tenant())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("tenant is null, fetch log without tablet filter", KR(ret), K(tenant_id));
+    } else if (OB_FAIL(tenant->get_part_mgr().get_served_tablet_ids(tablet_white_list, max_filter_tablet_id))) {
+      LOG_WARN("get_served_tablet_ids failed, fetch log without tablet filter", KR(ret), K(tenant_id));
+    }
+
+    if (OB_FAIL(ret)) {
+      tablet_white_list.reset();
+      max_filter_tablet_id.reset();
+    }
+  }
+
+  // the request is reused by the fetch stream, the white list is refreshed by each rpc
+  if (OB_FAIL(req.set_tablet_white_list(tablet_white_list, max_filter_tablet_id))) {
+    LOG_WARN("set tablet white list failed, fetch log without tablet filter", KR(ret), K(tenant_id));
+  }
+}
+
 }
 }
@@ -66,6 +66,7 @@ class ObLogRpc : public IObLogRpc
 {
 public:
   static int64_t g_rpc_process_handler_time_upper_limit;
+  static common::ObCompressorType g_rpc_result_compressor_type;
   const char *const OB_CLIENT_SSL_CA_FILE = "wallet/ca.pem";
   const char *const OB_CLIENT_SSL_CERT_FILE = "wallet/client-cert.pem";
   const char *const OB_CLIENT_SSL_KEY_FILE = "wallet/client-key.pem";
@@ -102,6 +103,9 @@ public:
 
 private:
   int init_client_id_();
+  // attach the served tablets of the tenant to the request if enable_fetch_log_tablet_filter,
+  // the request is sent without filter if failed
+  void set_tablet_white_list_(const uint64_t tenant_id, obrpc::ObCdcLSFetchLogReq &req);
 
 private:
   bool                is_inited_;
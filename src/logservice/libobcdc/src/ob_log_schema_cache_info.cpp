@@ -41,6 +41,8 @@ ColumnSchemaInfo::ColumnSchemaInfo()
       accuracy_(),
       collation_type_(),
       orig_default_value_str_(NULL),
+      is_orig_default_obj_valid_(false),
+      orig_default_obj_(),
       extended_type_info_size_(0),
       extended_type_info_(NULL),
       is_rowkey_(false),
@@ -112,6 +114,11 @@ int ColumnSchemaInfo::init(
     accuracy_ = accuracy;
     collation_type_ =  collation_type;
     orig_default_value_str_ = orig_default_value_str;
+    // memory of the default value is held by the schema, only shallow copy the value without it
+    is_orig_default_obj_valid_ = ! column_table_schema.get_orig_default_value().need_deep_copy();
+    if (is_orig_default_obj_valid_) {
+      orig_default_obj_ = column_table_schema.get_orig_default_value();
+    }
     is_rowkey_ = column_table_schema.is_original_rowkey_column();
     udt_set_id_ = column_table_schema.get_udt_set_id();
     sub_type_ = column_table_schema.get_sub_data_type();
@@ -140,6 +147,8 @@ void ColumnSchemaInfo::reset()
     LOG_ERROR_RET(OB_ERR_UNEXPECTED, "orig_default_value_str_ should be null", K(orig_default_value_str_));
     orig_default_value_str_ = NULL;
   }
+  is_orig_default_obj_valid_ = false;
+  orig_default_obj_.reset();
 
   extended_type_info_size_ = 0;
   extended_type_info_ = NULL;
@@ -101,6 +101,10 @@ public:
     orig_default_value_str_ = &orig_default_value_str;
   }
   inline const common::ObString *get_orig_default_value_str() const { return orig_default_value_str_; }
+  // Original default value which holds no memory outside ObObj (e.g. integer and time types),
+  // NULL for the others which are only kept as string by orig_default_value_str_
+  inline const common::ObObj *get_orig_default_obj() const
+  { return is_orig_default_obj_valid_ ? &orig_default_obj_ : NULL; }
   // 1. To resolve the memory space, ObArrayHelper is not used directly to store information, get_extended_type_info returns size and an array of pointers directly
   // 2. call ObArrayHelper<ObString>(size, str_ptr, size) directly from the outer layer to construct a temporary array
   inline void get_extended_type_info(int64_t &size, common::ObString *&str_ptr) const
@@ -140,6 +144,8 @@ public:
       K_(accuracy),
       K_(collation_type),
       K_(orig_default_value_str),
+      K_(is_orig_default_obj_valid),
+      K_(orig_default_obj),
       K_(extended_type_info_size),
       K_(extended_type_info),
       K_(is_rowkey),
@@ -175,6 +181,9 @@ private:
   common::ObCollationType collation_type_;
   // TODO: There are no multiple versions of the default value, consider maintaining a copy
   common::ObString   *orig_default_value_str_;
+  // used by the Arrow output mode which outputs value of native type without converting it to string
+  bool               is_orig_default_obj_valid_;
+  common::ObObj      orig_default_obj_;
   // used for enum and set
   int64_t            extended_type_info_size_;
   common::ObString   *extended_type_info_;
@@ -0,0 +1,210 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+#define USING_LOG_PREFIX PALF
+
+#include "log_io_batch_controller.h"
+#include "lib/ob_errno.h"                             // OB_SUCCESS
+#include "lib/oblog/ob_log_module.h"                  // PALF_LOG
+
+namespace oceanbase
+{
+using namespace common;
+namespace palf
+{
+const int64_t LogIOBatchHistogram::LATENCY_BUCKET_BOUNDS[LATENCY_BUCKET_NUM] = {
+  50, 100, 200, 500, 1000, 2000, 5000, 10 * 1000, 20 * 1000, 50 * 1000, 100 * 1000, INT64_MAX
+};
+
+void LogIOBatchHistogram::reset()
+{
+  MEMSET(batch_size_buckets_, 0, sizeof(batch_size_buckets_));
+  MEMSET(io_cost_buckets_, 0, sizeof(io_cost_buckets_));
+  MEMSET(flush_latency_buckets_, 0, sizeof(flush_latency_buckets_));
+  batch_count_ = 0;
+  task_count_ = 0;
+  total_io_cost_ = 0;
+  max_io_cost_ = 0;
+}
+
+void LogIOBatchHistogram::record_batch(const int64_t task_count, const int64_t io_cost_us)
+{
+  if (0 < task_count && 0 <= io_cost_us) {
+    batch_size_buckets_[get_batch_size_bucket_(task_count)]++;
+    io_cost_buckets_[get_latency_bucket_(io_cost_us)]++;
+    batch_count_++;
+    task_count_ += task_count;
+    total_io_cost_ += io_cost_us;
+    max_io_cost_ = MAX(max_io_cost_, io_cost_us);
+  }
+}
+
+void LogIOBatchHistogram::record_flush_latency(const int64_t task_count, const int64_t latency_us)
+{
+  if (0 < task_count && 0 <= latency_us) {
+    flush_latency_buckets_[get_latency_bucket_(latency_us)] += task_count;
+  }
+}
+
+int64_t LogIOBatchHistogram::get_flush_latency_percentile(const int64_t percentile) const
+{
+  int64_t total_count = 0;
+  int64_t latency_us = 0;
+  for (int64_t i = 0; i < LATENCY_BUCKET_NUM; i++) {
+    total_count += flush_latency_buckets_[i];
+  }
+  if (0 < total_count && 0 < percentile && 100 >= percentile) {
+    // the rank of percentile, rounded up
+    const int64_t rank = (total_count * percentile + 99) / 100;
+    int64_t accum_count = 0;
+    for (int64_t i = 0; i < LATENCY_BUCKET_NUM && 0 == latency_us; i++) {
+      accum_count += flush_latency_buckets_[i];
+      if (accum_count >= rank) {
+        latency_us = LATENCY_BUCKET_BOUNDS[i];
+      }
+    }
+  }
+  return latency_us;
+}
+
+int64_t LogIOBatchHistogram::get_batch_size_bucket_(const int64_t task_count)
+{
+  int64_t bucket = 0;
+  int64_t count = task_count;
+  while (count > 1 && bucket < BATCH_SIZE_BUCKET_NUM - 1) {
+    count >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+int64_t LogIOBatchHistogram::get_latency_bucket_(const int64_t latency_us)
+{
+  int64_t bucket = 0;
+  while (latency_us > LATENCY_BUCKET_BOUNDS[bucket] && bucket < LATENCY_BUCKET_NUM - 1) {
+    bucket++;
+  }
+  return bucket;
+}
+
+LogIOBatchController::LogIOBatchController()
+  : latency_target_us_(0),
+    max_batch_size_(0),
+    batch_limit_(0),
+    avg_io_cost_us_(0),
+    baseline_io_cost_us_(OB_INVALID_TIMESTAMP),
+    avg_arrival_interval_us_(0),
+    last_arrival_ts_(OB_INVALID_TIMESTAMP),
+    is_inited_(false)
+{
+}
+
+LogIOBatchController::~LogIOBatchController()
+{
+  destroy();
+}
+
+int LogIOBatchController::init(const int64_t max_batch_size, const int64_t latency_target_us)
+{
+  int ret = OB_SUCCESS;
+  if (is_inited_) {
+    ret = OB_INIT_TWICE;
+    PALF_LOG(ERROR, "LogIOBatchController has been inited", K(ret));
+  } else if (0 >= max_batch_size || 0 > latency_target_us) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(ERROR, "invalid argument", K(ret), K(max_batch_size), K(latency_target_us));
+  } else {
+    latency_target_us_ = latency_target_us;
+    max_batch_size_ = max_batch_size;
+    // start from the most aggressive batching, which is the behavior without controller.
+    batch_limit_ = max_batch_size;
+    avg_io_cost_us_ = 0;
+    baseline_io_cost_us_ = OB_INVALID_TIMESTAMP;
+    // assume the arrival interval is long until tasks have arrived.
+    avg_arrival_interval_us_ = latency_target_us;
+    last_arrival_ts_ = OB_INVALID_TIMESTAMP;
+    is_inited_ = true;
+    PALF_LOG(INFO, "LogIOBatchController init success", KPC(this));
+  }
+  return ret;
+}
+
+void LogIOBatchController::destroy()
+{
+  is_inited_ = false;
+  latency_target_us_ = 0;
+  max_batch_size_ = 0;
+  batch_limit_ = 0;
+  avg_io_cost_us_ = 0;
+  baseline_io_cost_us_ = OB_INVALID_TIMESTAMP;
+  avg_arrival_interval_us_ = 0;
+  last_arrival_ts_ = OB_INVALID_TIMESTAMP;
+}
+
+void LogIOBatchController::on_arrival(const int64_t task_init_ts)
+{
+  if (is_enabled() && OB_INVALID_TIMESTAMP != task_init_ts) {
+    if (OB_INVALID_TIMESTAMP != last_arrival_ts_ && task_init_ts >= last_arrival_ts_) {
+      // the interval longer than latency target makes no difference, the batch will not wait
+      // anyway, truncate it to make the average converge quickly after idle.
+      const int64_t interval = MIN(task_init_ts - last_arrival_ts_, latency_target_us_);
+      update_moving_average_(interval, avg_arrival_interval_us_);
+    }
+    last_arrival_ts_ = MAX(last_arrival_ts_, task_init_ts);
+  }
+}
+
+void LogIOBatchController::on_batch_flushed(const int64_t task_count, const int64_t io_cost_us)
+{
+  if (is_enabled() && 0 < task_count && 0 <= io_cost_us) {
+    update_moving_average_(io_cost_us, avg_io_cost_us_);
+    if (OB_INVALID_TIMESTAMP == baseline_io_cost_us_ || io_cost_us < baseline_io_cost_us_) {
+      baseline_io_cost_us_ = io_cost_us;
+    } else {
+      baseline_io_cost_us_ += (io_cost_us - baseline_io_cost_us_) / BASELINE_RISE_FACTOR;
+    }
+    // only the cost beyond the baseline is driven by the batch size
+    if (io_cost_us - baseline_io_cost_us_ > latency_target_us_) {
+      // multiplicative decrease, smaller batch takes less time to write
+      batch_limit_ = MAX(MIN(MIN_BATCH_LIMIT, max_batch_size_), batch_limit_ / 2);
+    } else if (task_count >= batch_limit_) {
+      // additive increase, only when the batch has been limited
+      batch_limit_ = MIN(max_batch_size_, batch_limit_ + ADDITIVE_INCREASE_STEP);
+    }
+    PALF_LOG(TRACE, "on_batch_flushed", K(task_count), K(io_cost_us), KPC(this));
+  }
+}
+
+int64_t LogIOBatchController::get_wait_time_us(const int64_t task_count,
+                                               const int64_t oldest_task_init_ts,
+                                               const int64_t curr_ts) const
+{
+  int64_t wait_time_us = 0;
+  if (is_enabled() && 0 < task_count && task_count < batch_limit_
+      && OB_INVALID_TIMESTAMP != oldest_task_init_ts) {
+    const int64_t deadline = oldest_task_init_ts + latency_target_us_ - avg_io_cost_us_;
+    const int64_t remain_us = deadline - curr_ts;
+    // wait only when the next task is expected to arrive before deadline, and wait for two
+    // arrival intervals at most to tolerate the jitter of arrival.
+    if (avg_arrival_interval_us_ < remain_us) {
+      wait_time_us = MIN(remain_us, 2 * avg_arrival_interval_us_);
+    }
+  }
+  return wait_time_us;
+}
+
+void LogIOBatchController::update_moving_average_(const int64_t sample, int64_t &avg)
+{
+  avg = avg + (sample - avg) / MOVING_AVERAGE_FACTOR;
+}
+
+} // end namespace palf
+} // end namespace oceanbase
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_LOGSERVIVE_LOG_IO_BATCH_CONTROLLER_H
+#define OCEANBASE_LOGSERVIVE_LOG_IO_BATCH_CONTROLLER_H
+
+#include "lib/utility/ob_macro_utils.h"             // DISALLOW_COPY_AND_ASSIGN
+#include "lib/utility/ob_print_utils.h"             // TO_STRING_KV
+#include "lib/container/ob_array_wrap.h"            // ObArrayWrap
+
+namespace oceanbase
+{
+namespace palf
+{
+// Histograms of the batches flushed by LogIOWorker, only accessed by the LogIOWorker thread.
+// 1. batch size: count of LogIOFlushLogTask in each batch, bucket i holds [2^i, 2^(i+1));
+// 2. io cost: time cost of writing each batch;
+// 3. flush latency: time from a LogIOFlushLogTask has been created to it has been flushed.
+class LogIOBatchHistogram
+{
+public:
+  LogIOBatchHistogram() { reset(); }
+  ~LogIOBatchHistogram() { reset(); }
+  void reset();
+  void record_batch(const int64_t task_count, const int64_t io_cost_us);
+  void record_flush_latency(const int64_t task_count, const int64_t latency_us);
+  // return the upper bound of the bucket which contains the percentile of flush latency,
+  // return 0 if there is no record.
+  int64_t get_flush_latency_percentile(const int64_t percentile) const;
+  int64_t get_batch_count() const { return batch_count_; }
+  int64_t get_task_count() const { return task_count_; }
+  TO_STRING_KV(K_(batch_count),
+               K_(task_count),
+               "avg_batch_size", 0 == batch_count_ ? 0 : task_count_ / batch_count_,
+               "avg_io_cost", 0 == batch_count_ ? 0 : total_io_cost_ / batch_count_,
+               K_(max_io_cost),
+               "p50_flush_latency", get_flush_latency_percentile(50),
+               "p99_flush_latency", get_flush_latency_percentile(99),
+               "batch_size_hist", common::ObArrayWrap<int64_t>(batch_size_buckets_, BATCH_SIZE_BUCKET_NUM),
+               "io_cost_hist", common::ObArrayWrap<int64_t>(io_cost_buckets_, LATENCY_BUCKET_NUM),
+               "flush_latency_hist", common::ObArrayWrap<int64_t>(flush_latency_buckets_, LATENCY_BUCKET_NUM));
+public:
+  static const int64_t BATCH_SIZE_BUCKET_NUM = 16;
+  static const int64_t LATENCY_BUCKET_NUM = 12;
+  // upper bound(us) of each latency bucket, the last one is unbounded.
+  static const int64_t LATENCY_BUCKET_BOUNDS[LATENCY_BUCKET_NUM];
+private:
+  static int64_t get_batch_size_bucket_(const int64_t task_count);
+  static int64_t get_latency_bucket_(const int64_t latency_us);
+private:
+  int64_t batch_size_buckets_[BATCH_SIZE_BUCKET_NUM];
+  int64_t io_cost_buckets_[LATENCY_BUCKET_NUM];
+  int64_t flush_latency_buckets_[LATENCY_BUCKET_NUM];
+  int64_t batch_count_;
+  int64_t task_count_;
+  int64_t total_io_cost_;
+  int64_t max_io_cost_;
+};
+
+// LogIOBatchController decides how many LogIOFlushLogTasks are aggregated into one round of
+// flushing, only accessed by the LogIOWorker thread.
+//
+// A batch is sized to the latency target by tracking the moving average of io cost and of
+// the arrival interval of LogIOFlushLogTasks:
+// 1. batch limit(AIMD): halve the limit when the io cost of a batch, minus the baseline cost
+//    of writing a single task(mainly fsync), exceeds the latency target, and increase it
+//    additively when a batch reaches the limit within the target. The baseline does not depend
+//    on batch size, a slow disk should not shrink the batch;
+// 2. wait with deadline(Nagle): when 'queue_' becomes empty, wait for the next task only if
+//    it is expected to arrive before the deadline of the oldest task in batch, namely
+//    'create time of oldest task + latency target - average io cost'. At low load, the
+//    arrival interval is long and the batch is flushed immediately.
+//
+// The controller is disabled when the latency target is zero, the batch is limited by
+// 'batch_width' and 'batch_depth' only, and never waits.
+class LogIOBatchController
+{
+public:
+  LogIOBatchController();
+  ~LogIOBatchController();
+  int init(const int64_t max_batch_size, const int64_t latency_target_us);
+  void destroy();
+  bool is_enabled() const { return is_inited_ && 0 < latency_target_us_; }
+  // invoked when a LogIOFlushLogTask has been popped from 'queue_'
+  void on_arrival(const int64_t task_init_ts);
+  // invoked after a batch has been flushed
+  void on_batch_flushed(const int64_t task_count, const int64_t io_cost_us);
+  int64_t get_batch_limit() const { return batch_limit_; }
+  // return the time to wait for the next LogIOFlushLogTask before flushing current batch,
+  // return 0 if current batch needs to be flushed immediately.
+  int64_t get_wait_time_us(const int64_t task_count,
+                           const int64_t oldest_task_init_ts,
+                           const int64_t curr_ts) const;
+  int64_t get_baseline_io_cost_us() const { return baseline_io_cost_us_; }
+  TO_STRING_KV(K_(latency_target_us), K_(max_batch_size), K_(batch_limit), K_(avg_io_cost_us),
+      K_(baseline_io_cost_us), K_(avg_arrival_interval_us), K_(last_arrival_ts), K_(is_inited));
+private:
+  void update_moving_average_(const int64_t sample, int64_t &avg);
+private:
+  static const int64_t MIN_BATCH_LIMIT = 16;
+  static const int64_t ADDITIVE_INCREASE_STEP = 16;
+  // weight of the newest sample is 1/MOVING_AVERAGE_FACTOR
+  static const int64_t MOVING_AVERAGE_FACTOR = 8;
+  // the baseline follows the minimum io cost, and rises slowly to track the change of disk
+  static const int64_t BASELINE_RISE_FACTOR = 64;
+  int64_t latency_target_us_;
+  int64_t max_batch_size_;
+  int64_t batch_limit_;
+  int64_t avg_io_cost_us_;
+  int64_t baseline_io_cost_us_;
+  int64_t avg_arrival_interval_us_;
+  int64_t last_arrival_ts_;
+  bool is_inited_;
+private:
+  DISALLOW_COPY_AND_ASSIGN(LogIOBatchController);
+};
+} // end namespace palf
+} // end namespace oceanbase
+
+#endif
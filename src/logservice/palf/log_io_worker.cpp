@@ -43,6 +43,9 @@ LogIOWorker::LogIOWorker()
       purge_throttling_task_handled_seq_(0),
       need_ignoring_throttling_(false),
       wait_cost_stat_("[PALF STAT IO TASK IN QUEUE TIME]", PALF_STAT_PRINT_INTERVAL_US),
+      batch_controller_(),
+      batch_histogram_(),
+      print_batch_stat_time_(OB_INVALID_TIMESTAMP),
       is_inited_(false)
 {
 }
@@ -74,8 +77,12 @@ int LogIOWorker::init(const LogIOWorkerConfig &config,
   } else if (OB_FAIL(batch_io_task_mgr_.init(config.batch_width_,
                                              config.batch_depth_,
                                              allocator,
-                                             &wait_cost_stat_))) {
+                                             &wait_cost_stat_,
+                                             &batch_histogram_))) {
     PALF_LOG(ERROR, "BatchLogIOFlushLogTaskMgr init failed", K(ret), K(config));
+  } else if (OB_FAIL(batch_controller_.init(MAX(1, config.batch_width_ * config.batch_depth_),
+                                            config.batch_latency_target_us_))) {
+    PALF_LOG(ERROR, "LogIOBatchController init failed", K(ret), K(config));
   } else {
     share::ObThreadPool::set_run_wrapper(MTL_CTX());
     log_io_worker_num_ = config.io_worker_num_;
@@ -120,6 +127,9 @@ void LogIOWorker::destroy()
   log_io_worker_num_ = -1;
   queue_.destroy();
   batch_io_task_mgr_.destroy();
+  batch_controller_.destroy();
+  batch_histogram_.reset();
+  print_batch_stat_time_ = OB_INVALID_TIMESTAMP;
 }
 
 int LogIOWorker::submit_io_task(LogIOTask *io_task)
@@ -292,9 +302,15 @@ int LogIOWorker::reduce_io_task_(void *task)
   // termination conditions for aggregation:
   // 1. the top LogIOTask of 'queue_' can not be aggreated
   // 2. there is no usable BatchLogIOFlushLogTask in 'batch_io_task_mgr_'.
-  // 3. there is no LogIOTask in 'queue_'
+  // 3. there is no LogIOTask in 'queue_' and no LogIOTask arrives before the deadline of
+  //    'batch_controller_'
+  // 4. the count of aggregated LogIOFlushLogTask reaches the batch limit of 'batch_controller_',
+  //    the next LogIOTask is left in 'queue_' and starts the next batch.
   int tmp_ret = OB_SUCCESS;
-  while (OB_SUCCESS == tmp_ret && true == last_io_task_has_been_reduced) {
+  int64_t batch_task_count = 0;
+  int64_t oldest_task_init_ts = OB_INVALID_TIMESTAMP;
+  bool reach_batch_limit = false;
+  while (OB_SUCCESS == tmp_ret && true == last_io_task_has_been_reduced && false == reach_batch_limit) {
     io_task = reinterpret_cast<LogIOTask *>(task);
     BatchLogIOFlushLogTask *batch_io_flush_task = NULL;
     if (OB_ISNULL(io_task)) {
@@ -302,6 +318,7 @@ int LogIOWorker::reduce_io_task_(void *task)
       PALF_LOG(ERROR, "io task is nullptr, unexpected error!!!", K(ret));
     } else if (false == need_reduce_(io_task)) {
       last_io_task_has_been_reduced = false;
+    } else if (FALSE_IT(batch_controller_.on_arrival(io_task->get_init_task_ts()))) {
     } else {
       LogIOFlushLogTask *flush_log_task = reinterpret_cast<LogIOFlushLogTask *>(io_task);
       // When insert 'flush_log_task' to batch_io_task_mgr_ failed, need
@@ -311,17 +328,28 @@ int LogIOWorker::reduce_io_task_(void *task)
       if (OB_SUCCESS != (tmp_ret = batch_io_task_mgr_.insert(flush_log_task))) {
         last_io_task_has_been_reduced = false;
         PALF_LOG(TRACE, "batch_io_task_mgr_ insert failed", K(tmp_ret));
-      } else if (OB_SUCCESS == (tmp_ret = queue_.pop(task))) {
-      // When 'queue_' is empty, stop aggreating.
-        update_throttling_options_();
       } else {
+        const int64_t init_task_ts = flush_log_task->get_init_task_ts();
+        batch_task_count++;
+        oldest_task_init_ts = (OB_INVALID_TIMESTAMP == oldest_task_init_ts ?
+            init_task_ts : MIN(oldest_task_init_ts, init_task_ts));
+        // When reaching the batch limit or 'queue_' is empty, stop aggreating, check the limit
+        // before popping so that the next task is left to start the next batch.
+        if (batch_controller_.is_enabled() && batch_task_count >= batch_controller_.get_batch_limit()) {
+          reach_batch_limit = true;
+          PALF_LOG(TRACE, "reach batch limit", K(batch_task_count), K_(batch_controller));
+        } else if (OB_SUCCESS == (tmp_ret = pop_next_io_task_(batch_task_count, oldest_task_init_ts, task))) {
+          update_throttling_options_();
+        }
       }
     }
   }
 
+  const int64_t flush_start_ts = ObTimeUtility::current_time();
   if (OB_FAIL(batch_io_task_mgr_.handle(cb_thread_pool_tg_id_, palf_env_impl_))) {
     PALF_LOG(WARN, "batch_io_task_mgr_ handle failed", K(ret), K(batch_io_task_mgr_));
   }
+  after_batch_flushed_(batch_task_count, ObTimeUtility::current_time() - flush_start_ts);
 
   if (false == last_io_task_has_been_reduced && OB_NOT_NULL(io_task)) {
     ret = handle_io_task_(io_task);
@@ -340,9 +368,41 @@ int LogIOWorker::update_throttling_options_()
   return ret;
 }
 
+int LogIOWorker::pop_next_io_task_(const int64_t batch_task_count,
+                                   const int64_t oldest_task_init_ts,
+                                   void *&task)
+{
+  int ret = OB_SUCCESS;
+  int64_t wait_time_us = 0;
+  if (OB_SUCC(queue_.pop(task))) {
+  } else if (0 < (wait_time_us = batch_controller_.get_wait_time_us(batch_task_count,
+                                                                    oldest_task_init_ts,
+                                                                    ObTimeUtility::current_time()))) {
+    // 'queue_' is empty, the next LogIOFlushLogTask is expected to arrive before the deadline
+    // of current batch.
+    ret = queue_.pop(task, wait_time_us);
+    PALF_LOG(TRACE, "wait for next io task", K(ret), K(wait_time_us), K(batch_task_count));
+  }
+  return ret;
+}
+
+void LogIOWorker::after_batch_flushed_(const int64_t batch_task_count, const int64_t io_cost_us)
+{
+  if (0 < batch_task_count) {
+    batch_controller_.on_batch_flushed(batch_task_count, io_cost_us);
+    batch_histogram_.record_batch(batch_task_count, io_cost_us);
+  }
+  if (palf_reach_time_interval(PALF_STAT_PRINT_INTERVAL_US, print_batch_stat_time_)) {
+    if (0 < batch_histogram_.get_batch_count()) {
+      PALF_LOG(INFO, "[PALF STAT IO BATCH HISTOGRAM]", K_(batch_histogram), K_(batch_controller));
+    }
+    batch_histogram_.reset();
+  }
+}
+
 LogIOWorker::BatchLogIOFlushLogTaskMgr::BatchLogIOFlushLogTaskMgr()
   : handle_count_(0), usable_count_(0), batch_width_(0),
-    wait_cost_stat_(NULL)
+    wait_cost_stat_(NULL), batch_histogram_(NULL)
 {}
 
 LogIOWorker::BatchLogIOFlushLogTaskMgr::~BatchLogIOFlushLogTaskMgr()
@@ -353,7 +413,8 @@ LogIOWorker::BatchLogIOFlushLogTaskMgr::~BatchLogIOFlushLogTaskMgr()
 int LogIOWorker::BatchLogIOFlushLogTaskMgr::init(int64_t batch_width,
                                                  int64_t batch_depth,
                                                  ObIAllocator *allocator,
-                                                 ObMiniStat::ObStatItem *wait_cost_stat)
+                                                 ObMiniStat::ObStatItem *wait_cost_stat,
+                                                 LogIOBatchHistogram *batch_histogram)
 {
   int ret = OB_SUCCESS;
   batch_io_task_array_.set_allocator(allocator);
@@ -386,6 +447,7 @@ int LogIOWorker::BatchLogIOFlushLogTaskMgr::init(int64_t batch_width,
     }
     batch_width_ = usable_count_ = batch_width;
     wait_cost_stat_ = wait_cost_stat;
+    batch_histogram_ = batch_histogram;
   }
   if (OB_FAIL(ret)) {
     destroy();
@@ -405,6 +467,7 @@ void LogIOWorker::BatchLogIOFlushLogTaskMgr::destroy()
     }
   }
   wait_cost_stat_ = NULL;
+  batch_histogram_ = NULL;
   batch_io_task_array_.destroy();
 }
 
@@ -432,17 +495,26 @@ int LogIOWorker::BatchLogIOFlushLogTaskMgr::handle(const int64_t tg_id, IPalfEnv
   const int64_t first_handle_ts = ObTimeUtility::fast_current_time();
   for (int64_t i = 0; i < count; i++) {
     BatchLogIOFlushLogTask *io_task = batch_io_task_array_[i];
+    int64_t do_task_start_ts = OB_INVALID_TIMESTAMP;
     if (OB_ISNULL(io_task)) {
       ret = OB_ERR_UNEXPECTED;
       PALF_LOG(ERROR, "BatchLogIOFlushLogTask in batch_io_task_array_ is nullptr, unexpected error!!!",
                K(ret), KP(io_task), K(i));
     } else if (OB_FAIL(statistics_wait_cost_(first_handle_ts, io_task))) {
       PALF_LOG(WARN, "do statistics failed", K(ret));
+    } else if (FALSE_IT(do_task_start_ts = ObTimeUtility::current_time())) {
     } else if (OB_FAIL(io_task->do_task(tg_id, palf_env_impl))) {
       PALF_LOG(WARN, "do_task failed", K(ret), KP(io_task));
     } else {
+      const int64_t task_count = io_task->get_count();
       if (OB_NOT_NULL(wait_cost_stat_)) {
-        wait_cost_stat_->stat(io_task->get_count(), io_task->get_accum_in_queue_time());
+        wait_cost_stat_->stat(task_count, io_task->get_accum_in_queue_time());
+      }
+      if (OB_NOT_NULL(batch_histogram_) && 0 < task_count) {
+        // flush latency = average time in queue + time cost of writing
+        const int64_t io_cost_us = ObTimeUtility::current_time() - do_task_start_ts;
+        batch_histogram_->record_flush_latency(task_count,
+            io_task->get_accum_in_queue_time() / task_count + io_cost_us);
       }
       io_task->reset_accum_in_queue_time();
       PALF_LOG(TRACE, "BatchLogIOFlushLogTaskMgr::handle success", K(ret), K(handle_count_),
@@ -28,6 +28,7 @@
 #include "log_define.h"                             // PALF_SLIDING_WINDOW_SIZE
 #include "palf_options.h"                           // PalfThrottleOptions
 #include "log_throttle.h"                           // LogWritingThrottle
+#include "log_io_batch_controller.h"                // LogIOBatchController
 namespace oceanbase
 {
 namespace common
@@ -51,7 +52,8 @@ struct LogIOWorkerConfig
   }
   bool is_valid() const
   {
-    return 0 < io_worker_num_ && 0 < io_queue_capcity_ && 0 <= batch_width_ && 0 <= batch_depth_;
+    return 0 < io_worker_num_ && 0 < io_queue_capcity_ && 0 <= batch_width_ && 0 <= batch_depth_
+        && 0 <= batch_latency_target_us_;
   }
   void reset()
   {
@@ -59,12 +61,17 @@ struct LogIOWorkerConfig
     io_queue_capcity_ = 0;
     batch_width_ = 0;
     batch_depth_ = 0;
+    batch_latency_target_us_ = 0;
   }
   int64_t io_worker_num_;
   int64_t io_queue_capcity_;
   int64_t batch_width_;
   int64_t batch_depth_;
-  TO_STRING_KV(K_(io_worker_num), K_(io_queue_capcity), K_(batch_width), K_(batch_depth));
+  // the expected latency of flushing a LogIOFlushLogTask, used to size each batch adaptively,
+  // zero means aggregating as many LogIOFlushLogTasks as 'batch_width_' and 'batch_depth_' allowed.
+  int64_t batch_latency_target_us_;
+  TO_STRING_KV(K_(io_worker_num), K_(io_queue_capcity), K_(batch_width), K_(batch_depth),
+      K_(batch_latency_target_us));
 };
 
 class LogIOWorker : public share::ObThreadPool
@@ -94,6 +101,8 @@ private:
   int handle_io_task_(LogIOTask *io_task);
   int handle_io_task_with_throttling_(LogIOTask *io_task);
   int update_throttling_options_();
+  int pop_next_io_task_(const int64_t batch_task_count, const int64_t oldest_task_init_ts, void *&task);
+  void after_batch_flushed_(const int64_t batch_task_count, const int64_t io_cost_us);
   int run_loop_();
   int64_t inc_and_fetch_purge_throttling_submitted_seq_();
   void dec_purge_throttling_submitted_seq_();
@@ -106,7 +115,8 @@ private:
   public:
     BatchLogIOFlushLogTaskMgr();
     ~BatchLogIOFlushLogTaskMgr();
-    int init(int64_t batch_width, int64_t batch_depth, ObIAllocator *allocator, ObMiniStat::ObStatItem *wait_cost_stat);
+    int init(int64_t batch_width, int64_t batch_depth, ObIAllocator *allocator,
+             ObMiniStat::ObStatItem *wait_cost_stat, LogIOBatchHistogram *batch_histogram);
     void destroy();
     int insert(LogIOFlushLogTask *io_task);
     int handle(const int64_t tg_id, IPalfEnvImpl *palf_env_impl);
@@ -122,6 +132,7 @@ private:
     int64_t usable_count_;
     int64_t batch_width_;
     ObMiniStat::ObStatItem *wait_cost_stat_;
+    LogIOBatchHistogram *batch_histogram_;
   };
   typedef common::ObSpinLock SpinLock;
   typedef common::ObSpinLockGuard SpinLockGuard;
@@ -153,6 +164,9 @@ private:
   NeedPurgingThrottlingFunc need_purging_throttling_func_;
   SpinLock lock_;
   ObMiniStat::ObStatItem wait_cost_stat_;
+  LogIOBatchController batch_controller_;
+  LogIOBatchHistogram batch_histogram_;
+  int64_t print_batch_stat_time_;
   bool is_inited_;
 };
 } // end namespace palf
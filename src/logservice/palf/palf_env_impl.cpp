@@ -231,6 +231,7 @@ int PalfEnvImpl::init(
     PALF_LOG(ERROR, "invalid arguments", K(ret), KP(transport), KP(batch_rpc), K(base_dir), K(self), KP(transport),
              KP(log_alloc_mgr), KP(log_block_pool), KP(monitor));
   } else if (OB_FAIL(init_log_io_worker_config_(options.disk_options_.log_writer_parallelism_,
+                                                options.disk_options_.log_writer_batch_latency_target_us_,
                                                 tenant_id,
                                                 log_io_worker_config_))) {
     PALF_LOG(WARN, "init_log_io_worker_config_ failed", K(options));
@@ -1382,6 +1383,7 @@ void PalfEnvImpl::period_calc_disk_usage()
 }
 
 int PalfEnvImpl::init_log_io_worker_config_(const int log_writer_parallelism,
+                                            const int64_t log_writer_batch_latency_target_us,
                                             const int64_t tenant_id,
                                             LogIOWorkerConfig &config)
 {
@@ -1412,7 +1414,11 @@ int PalfEnvImpl::init_log_io_worker_config_(const int log_writer_parallelism,
   config.batch_width_ = MAX(default_min_batch_width,
                             tmp_upper_align_div(default_io_batch_width, real_log_writer_parallelism));
   config.batch_depth_ = PALF_SLIDING_WINDOW_SIZE;
-  PALF_LOG(INFO, "init_log_io_worker_config_ success", K(config), K(tenant_id), K(log_writer_parallelism));
+  // Each batch is sized adaptively to keep the time cost of writing within
+  // 'log_writer_batch_latency_target_us', zero means batching as many logs as possible.
+  config.batch_latency_target_us_ = log_writer_batch_latency_target_us;
+  PALF_LOG(INFO, "init_log_io_worker_config_ success", K(config), K(tenant_id), K(log_writer_parallelism),
+      K(log_writer_batch_latency_target_us));
   return ret;
 }
 
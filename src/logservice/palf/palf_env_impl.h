@@ -355,6 +355,7 @@ private:
   int remove_stale_incomplete_palf_();
 
   int init_log_io_worker_config_(const int log_writer_parallelism,
+                                 const int64_t log_writer_batch_latency_target_us,
                                  const int64_t tenant_id,
                                  LogIOWorkerConfig &config);
 
@@ -25,6 +25,8 @@ namespace palf
 // 3. log_disk_utilization_limit_threshold_, maximum of log disk usage percentage before stop submitting or receiving logs.
 // 4. log_disk_throttling_percentage_, the threshold of the size of the log disk when writing_limit will be triggered.
 // 5. log_writer_parallelism, the number of parallel log writer processes that can be used to write redo log entries to disk.
+// 6. log_writer_batch_latency_target_us, the expected latency of writing a batch of redo log entries, 0 means batching
+//    as many log entries as possible.
 struct PalfDiskOptions
 {
   PalfDiskOptions() : log_disk_usage_limit_size_(-1),
@@ -32,7 +34,8 @@ struct PalfDiskOptions
                       log_disk_utilization_limit_threshold_(-1),
                       log_disk_throttling_percentage_(-1),
                       log_disk_throttling_maximum_duration_(-1),
-                      log_writer_parallelism_(-1)
+                      log_writer_parallelism_(-1),
+                      log_writer_batch_latency_target_us_(0)
   {}
   ~PalfDiskOptions() { reset(); }
   static constexpr int64_t MB = 1024*1024ll;
@@ -47,12 +50,14 @@ struct PalfDiskOptions
   int64_t log_disk_throttling_percentage_;
   int64_t log_disk_throttling_maximum_duration_;
   int log_writer_parallelism_;
+  int64_t log_writer_batch_latency_target_us_;
   TO_STRING_KV("log_disk_size(MB)", log_disk_usage_limit_size_ / MB,
                "log_disk_utilization_threshold(%)", log_disk_utilization_threshold_,
                "log_disk_utilization_limit_threshold(%)", log_disk_utilization_limit_threshold_,
                "log_disk_throttling_percentage(%)", log_disk_throttling_percentage_,
                "log_disk_throttling_maximum_duration(s)", log_disk_throttling_maximum_duration_ / (1000 * 1000),
-               "log_writer_parallelism", log_writer_parallelism_);
+               "log_writer_parallelism", log_writer_parallelism_,
+               "log_writer_batch_latency_target(us)", log_writer_batch_latency_target_us_);
 };
 
 
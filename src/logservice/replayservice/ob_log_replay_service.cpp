@@ -128,6 +128,7 @@ void ReplayProcessStat::runTimerTask()
   int64_t estimate_time = 0;
   if (NULL == rp_sv_) {
     CLOG_LOG(ERROR, "rp_sv_ is NULL, unexpected error");
+  } else if (FALSE_IT(rp_sv_->update_replay_config())) {
   } else if (OB_FAIL(rp_sv_->stat_all_ls_replay_process(submitted_log_size, unsubmitted_log_size,
                                                         replayed_log_size, unreplayed_log_size))) {
     CLOG_LOG(WARN, "stat_all_ls_replay_process failed", K(ret));
@@ -196,6 +197,7 @@ ObLogReplayService::ObLogReplayService()
     replayable_point_(),
     replay_status_map_(),
     pending_replay_log_size_(0),
+    enable_dependency_dispatch_(false),
     wait_cost_stat_("[REPLAY STAT REPLAY TASK IN QUEUE TIME]", PALF_STAT_PRINT_INTERVAL_US),
     replay_cost_stat_("[REPLAY STAT REPLAY TASK EXECUTE COST TIME]", PALF_STAT_PRINT_INTERVAL_US)
 {}
@@ -233,6 +235,7 @@ int ObLogReplayService::init(PalfEnv *palf_env,
   } else {
     replayable_point_ = SCN::min_scn();
     pending_replay_log_size_ = 0;
+    enable_dependency_dispatch_ = tenant_config.is_valid() ? tenant_config->_enable_replay_dependency_dispatch : false;
     is_inited_ = true;
   }
   if ((OB_FAIL(ret)) && (OB_INIT_TWICE != ret)) {
@@ -314,6 +317,7 @@ void ObLogReplayService::destroy()
   replayable_point_.reset();
   replay_stat_.destroy();
   pending_replay_log_size_ = 0;
+  enable_dependency_dispatch_ = false;
   allocator_ = NULL;
   ls_adapter_ = NULL;
   palf_env_ = NULL;
@@ -850,6 +854,18 @@ int ObLogReplayService::stat_all_ls_replay_process(int64_t &submitted_log_size,
   return ret;
 }
 
+void ObLogReplayService::update_replay_config()
+{
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+  if (tenant_config.is_valid()) {
+    const bool enable_dependency_dispatch = tenant_config->_enable_replay_dependency_dispatch;
+    if (enable_dependency_dispatch != ATOMIC_LOAD(&enable_dependency_dispatch_)) {
+      ATOMIC_STORE(&enable_dependency_dispatch_, enable_dependency_dispatch);
+      CLOG_LOG(INFO, "update replay dependency dispatch", K(enable_dependency_dispatch));
+    }
+  }
+}
+
 void ObLogReplayService::inc_pending_task_size(const int64_t log_size)
 {
   ATOMIC_AAF(&pending_replay_log_size_, log_size);
@@ -980,6 +996,7 @@ int ObLogReplayService::do_replay_task_(ObLogReplayTask *replay_task,
     }
   } else if (OB_FAIL(replay_status->check_replay_barrier(replay_task, replay_log_buff,
                                                          need_replay, replay_queue_idx))) {
+    replay_status->inc_stall_count(REPLAY_STALL_PRE_BARRIER);
     if (REACH_TIME_INTERVAL(1000 * 1000)) {
       CLOG_LOG(INFO, "wait for barrier", K(ret), KPC(replay_status), KPC(replay_task));
     }
@@ -1005,6 +1022,7 @@ int ObLogReplayService::do_replay_task_(ObLogReplayTask *replay_task,
       replay_status->dec_pending_task(replay_task->get_replay_payload_size());
     }
   } else if (OB_FAIL(ls_adapter_->replay(replay_task))) {
+    replay_status->inc_stall_count(REPLAY_STALL_RETRY);
     CLOG_LOG(WARN, "ls do replay failed", K(ret), KPC(replay_task));
   }
   if (OB_SUCC(ret) && need_replay) {
@@ -1051,10 +1069,12 @@ int ObLogReplayService::check_can_submit_log_replay_task_(ObLogReplayTask *repla
       CLOG_LOG(ERROR, "failed to check_submit_barrier", K(ret), KPC(replay_status));
     } else {
       is_wait_barrier = true;
+      replay_status->inc_stall_count(REPLAY_STALL_POST_BARRIER);
     }
   } else if (OB_UNLIKELY(is_tenant_out_of_memory_())) {
     ret = OB_EAGAIN;
     is_tenant_out_of_mem = true;
+    replay_status->inc_stall_count(REPLAY_STALL_PENDING_LIMIT);
   }
   if (OB_EAGAIN == ret && REACH_TIME_INTERVAL(5 * 1000 * 1000)) {
     CLOG_LOG(INFO, "submit replay task need retry", K(ret), KPC(replay_status), KPC(replay_task),
@@ -1343,7 +1363,21 @@ int ObLogReplayService::handle_replay_task_(ObReplayServiceReplayTask *task_queu
     CLOG_LOG(ERROR, "replay status is NULL", KPC(task_queue), KPC(replay_status), KR(ret));
   } else {
     int64_t start_ts = ObTimeUtility::fast_current_time();
-    do {
+    const bool enable_dependency_dispatch = ATOMIC_LOAD(&enable_dependency_dispatch_);
+    if (0 < task_queue->get_deferred_count()) {
+      if (replay_status->try_rdlock()) {
+        if (!replay_status->is_enabled_without_lock()) {
+          is_queue_empty = true;
+        } else if (OB_FAIL(handle_deferred_replay_task_(*task_queue, *replay_status,
+                                                        enable_dependency_dispatch))) {
+          // deferred tasks are still blocked
+        }
+        replay_status->unlock();
+      } else {
+        ret = OB_EAGAIN;
+      }
+    }
+    while (OB_SUCC(ret) && (!is_queue_empty) && (!is_timeslice_run_out)) {
       int64_t replay_task_used = 0;
       int64_t destroy_task_used = 0;
       ObLink *link = NULL;
@@ -1351,18 +1385,48 @@ int ObLogReplayService::handle_replay_task_(ObReplayServiceReplayTask *task_queu
       ObLogReplayTask *replay_task = NULL;
       ObLogReplayTask *replay_task_to_destroy = NULL;
       if (replay_status->try_rdlock()) {
+        const int64_t deferred_cnt = task_queue->get_deferred_count();
         if (!replay_status->is_enabled_without_lock()) {
           is_queue_empty = true;
         } else if (NULL == (link = task_queue->top())) {
           //queue is empty
-          ret = OB_SUCCESS;
           is_queue_empty = true;
-          task_queue->clear_err_info();
+          if (0 < deferred_cnt) {
+            // push back to retry deferred tasks
+            ret = OB_EAGAIN;
+          } else {
+            ret = OB_SUCCESS;
+            task_queue->clear_err_info();
+          }
         } else if (OB_ISNULL(replay_task = static_cast<ObLogReplayTask *>(link))) {
           ret = OB_ERR_UNEXPECTED;
           CLOG_LOG(ERROR, "replay_task is NULL", KPC(replay_status), K(ret));
+        } else if (0 < deferred_cnt && (replay_task->is_pre_barrier_ || replay_task->is_post_barrier_)) {
+          // barrier log never bypasses former logs
+          ret = OB_EAGAIN;
+          replay_status->inc_stall_count(replay_task->is_pre_barrier_ ? REPLAY_STALL_PRE_BARRIER
+                                                                      : REPLAY_STALL_DEPENDENCY);
+        } else if (task_queue->has_deferred_dependency(deferred_cnt, replay_task->replay_hint_)) {
+          // keep log order with the deferred task of the same replay hint
+          replay_status->inc_stall_count(REPLAY_STALL_DEPENDENCY);
+          if (OB_FAIL(task_queue->defer_top())) {
+            if (OB_SIZE_OVERFLOW == ret) {
+              ret = OB_EAGAIN;
+            } else {
+              CLOG_LOG(ERROR, "failed to defer replay task", KPC(replay_task), K(ret));
+            }
+          }
         } else if (OB_FAIL(do_replay_task_(replay_task, replay_status, task_queue->idx()))) {
           (void)process_replay_ret_code_(ret, *replay_status, *task_queue, *replay_task);
+          if (enable_dependency_dispatch
+              && can_defer_replay_task_(ret, *replay_status, *task_queue, *replay_task)) {
+            // later tasks with other replay hints go ahead
+            if (OB_FAIL(task_queue->defer_top())) {
+              CLOG_LOG(ERROR, "failed to defer replay task", KPC(replay_task), K(ret));
+            } else {
+              CLOG_LOG(TRACE, "defer replay task", KPC(replay_task), KPC(task_queue));
+            }
+          }
         } else if (OB_FAIL(statistics_replay_cost_(replay_task->init_task_ts_, replay_task->first_handle_ts_))) {
           ret = OB_ERR_UNEXPECTED;
           CLOG_LOG(ERROR, "do statistics replay cost failed", KPC(replay_task), K(ret));
@@ -1399,11 +1463,66 @@ int ObLogReplayService::handle_replay_task_(ObReplayServiceReplayTask *task_queu
           CLOG_LOG(INFO, "try lock failed", KPC(replay_status), K(ret));
         }
       }
-    } while (OB_SUCC(ret) && (!is_queue_empty) && (!is_timeslice_run_out));
+    }
+  }
+  return ret;
+}
+
+// under replay status lock protection
+int ObLogReplayService::handle_deferred_replay_task_(ObReplayServiceReplayTask &task_queue,
+                                                     ObReplayStatus &replay_status,
+                                                     const bool enable_dependency_dispatch)
+{
+  int ret = OB_SUCCESS;
+  int64_t idx = 0;
+  while (OB_SUCC(ret) && idx < task_queue.get_deferred_count()) {
+    ObLogReplayTask *replay_task = task_queue.get_deferred_task(idx);
+    ObLogReplayTask *replay_task_to_destroy = NULL;
+    if (OB_ISNULL(replay_task)) {
+      ret = OB_ERR_UNEXPECTED;
+      CLOG_LOG(ERROR, "deferred replay task is NULL", K(idx), K(task_queue), K(ret));
+    } else if (task_queue.has_deferred_dependency(idx, replay_task->replay_hint_)) {
+      replay_status.inc_stall_count(REPLAY_STALL_DEPENDENCY);
+      idx++;
+    } else if (OB_FAIL(do_replay_task_(replay_task, &replay_status, task_queue.idx()))) {
+      (void)process_replay_ret_code_(ret, replay_status, task_queue, *replay_task);
+      if (!replay_status.is_fatal_error(ret)) {
+        ret = OB_SUCCESS;
+        idx++;
+      }
+    } else if (OB_FAIL(statistics_replay_cost_(replay_task->init_task_ts_, replay_task->first_handle_ts_))) {
+      ret = OB_ERR_UNEXPECTED;
+      CLOG_LOG(ERROR, "do statistics replay cost failed", KPC(replay_task), K(ret));
+    } else if (OB_ISNULL(replay_task_to_destroy = task_queue.remove_deferred(idx))) {
+      ret = OB_ERR_UNEXPECTED;
+      CLOG_LOG(ERROR, "failed to remove deferred task after replay", KPC(replay_task), K(idx), K(ret));
+      on_replay_error_(*replay_task, ret);
+    } else {
+      // barrier task is never deferred
+      replay_status.dec_pending_task(replay_task_to_destroy->get_replay_payload_size());
+      free_replay_task(replay_task_to_destroy);
+    }
+  }
+  if (OB_SUCC(ret) && 0 < task_queue.get_deferred_count() && !enable_dependency_dispatch) {
+    // dependency dispatch has been turned off, tasks in queue wait for deferred tasks
+    ret = OB_EAGAIN;
   }
   return ret;
 }
 
+bool ObLogReplayService::can_defer_replay_task_(const int ret_code,
+                                                ObReplayStatus &replay_status,
+                                                ObReplayServiceReplayTask &task_queue,
+                                                ObLogReplayTask &replay_task) const
+{
+  return !replay_task.is_pre_barrier_
+         && !replay_task.is_post_barrier_
+         && !replay_status.is_fatal_error(ret_code)
+         && !replay_status.has_fatal_error()
+         && !task_queue.is_deferred_full()
+         && OB_SUCCESS == replay_status.check_can_replay();
+}
+
 int ObLogReplayService::submit_log_replay_task_(ObLogReplayTask &replay_task,
                                                 ObReplayStatus &replay_status)
 {
@@ -178,6 +178,8 @@ public:
   void free_replay_task_log_buf(ObLogReplayTask *task);
   int has_fatal_error(const share::ObLSID &ls_id,
                       bool &bool_ret);
+  // reload _enable_replay_dependency_dispatch, called periodically by ReplayProcessStat
+  void update_replay_config();
 private:
   int get_replay_status_(const share::ObLSID &id,
                          ObReplayStatusGuard &guard);
@@ -208,6 +210,14 @@ private:
                           bool &is_timeslice_run_out);
   int handle_replay_task_(ObReplayServiceReplayTask *task_queue,
                           bool &is_timeslice_run_out);
+  // retry tasks bypassed by former rounds, the first deferred task of each replay hint is replayable
+  int handle_deferred_replay_task_(ObReplayServiceReplayTask &task_queue,
+                                   ObReplayStatus &replay_status,
+                                   const bool enable_dependency_dispatch);
+  bool can_defer_replay_task_(const int ret_code,
+                              ObReplayStatus &replay_status,
+                              ObReplayServiceReplayTask &task_queue,
+                              ObLogReplayTask &replay_task) const;
   int check_can_submit_log_replay_task_(ObLogReplayTask *replay_task,
                                         ObReplayStatus *replay_status);
   int do_replay_task_(ObLogReplayTask *replay_task,
@@ -268,6 +278,10 @@ private:
   // 考虑到迁出迁入场景, 不能只通过map管理replay status的生命周期
   common::ObLinearHashMap<share::ObLSID, ObReplayStatus*> replay_status_map_;
   int64_t pending_replay_log_size_;
+  // if true, a task blocked by retryable error can be bypassed by later tasks in the same
+  // task queue whose replay hint is different, tasks with the same replay hint
+  // (transaction or tablet) and barrier logs still replay in log order.
+  bool enable_dependency_dispatch_;
   ObMiniStat::ObStatItem wait_cost_stat_;
   ObMiniStat::ObStatItem replay_cost_stat_;
   DISALLOW_COPY_AND_ASSIGN(ObLogReplayService);
@@ -360,28 +360,38 @@ void ObReplayServiceReplayTask::reset()
   ObLink *top_item = NULL;
   if (NULL != replay_status_) {
     ObLockGuard<ObSpinLock> guard(lock_);
+    // deferred tasks are older than tasks in queue
+    for (int64_t i = 0; i < deferred_cnt_; ++i) {
+      free_task_(deferred_tasks_[i]);
+      deferred_tasks_[i] = NULL;
+    }
+    ATOMIC_STORE(&deferred_cnt_, 0);
     while (NULL != (top_item = pop_()))
     {
-      ObLogReplayTask *replay_task = static_cast<ObLogReplayTask *>(top_item);
-      //此处一定只能让引用计数归零的任务释放log_buff
-      if (replay_task->is_pre_barrier_) {
-        ObLogReplayBuffer *replay_buf = static_cast<ObLogReplayBuffer *>(replay_task->read_log_buf_);
-        if (NULL == replay_buf) {
-          CLOG_LOG_RET(ERROR, OB_ERR_UNEXPECTED, "replay_buf is NULL when reset", KPC(replay_task));
-        } else if (0 == replay_buf->dec_replay_ref()) {
-          replay_status_->free_replay_task_log_buf(replay_task);
-          replay_status_->dec_pending_task(replay_task->get_replay_payload_size());
-        }
-      } else {
-        replay_status_->dec_pending_task(replay_task->get_replay_payload_size());
-      }
-      replay_status_->free_replay_task(replay_task);
+      free_task_(static_cast<ObLogReplayTask *>(top_item));
     };
   }
   idx_ = -1;
   ObReplayServiceTask::reset();
 }
 
+void ObReplayServiceReplayTask::free_task_(ObLogReplayTask *replay_task)
+{
+  //此处一定只能让引用计数归零的任务释放log_buff
+  if (replay_task->is_pre_barrier_) {
+    ObLogReplayBuffer *replay_buf = static_cast<ObLogReplayBuffer *>(replay_task->read_log_buf_);
+    if (NULL == replay_buf) {
+      CLOG_LOG_RET(ERROR, OB_ERR_UNEXPECTED, "replay_buf is NULL when reset", KPC(replay_task));
+    } else if (0 == replay_buf->dec_replay_ref()) {
+      replay_status_->free_replay_task_log_buf(replay_task);
+      replay_status_->dec_pending_task(replay_task->get_replay_payload_size());
+    }
+  } else {
+    replay_status_->dec_pending_task(replay_task->get_replay_payload_size());
+  }
+  replay_status_->free_replay_task(replay_task);
+}
+
 void ObReplayServiceReplayTask::destroy()
 {
   reset();
@@ -405,7 +415,7 @@ int ObReplayServiceReplayTask::get_min_unreplayed_log_info(LSN &lsn,
   int ret = OB_SUCCESS;
   ObLockGuard<ObSpinLock> guard(lock_);
   ObLogReplayTask *replay_task = NULL;
-  ObLink *top_item = top();
+  ObLink *top_item = (0 < deferred_cnt_) ? deferred_tasks_[0] : top();
   if (NULL != top_item && NULL != (replay_task = static_cast<ObLogReplayTask *>(top_item))) {
     lsn = replay_task->lsn_;
     scn = replay_task->scn_;
@@ -433,6 +443,48 @@ void ObReplayServiceReplayTask::push(Link *p)
   queue_.push(p);
 }
 
+bool ObReplayServiceReplayTask::has_deferred_dependency(const int64_t end_idx,
+                                                        const int64_t replay_hint) const
+{
+  bool bool_ret = false;
+  for (int64_t i = 0; !bool_ret && i < end_idx && i < deferred_cnt_; ++i) {
+    bool_ret = (replay_hint == deferred_tasks_[i]->replay_hint_);
+  }
+  return bool_ret;
+}
+
+int ObReplayServiceReplayTask::defer_top()
+{
+  int ret = OB_SUCCESS;
+  ObLockGuard<ObSpinLock> guard(lock_);
+  ObLink *top_item = NULL;
+  if (MAX_DEFERRED_TASK_COUNT <= deferred_cnt_) {
+    ret = OB_SIZE_OVERFLOW;
+  } else if (OB_ISNULL(top_item = pop_())) {
+    ret = OB_ERR_UNEXPECTED;
+    CLOG_LOG(ERROR, "queue is empty when defer top task", K(ret), KPC(this));
+  } else {
+    deferred_tasks_[deferred_cnt_] = static_cast<ObLogReplayTask *>(top_item);
+    ATOMIC_STORE(&deferred_cnt_, deferred_cnt_ + 1);
+  }
+  return ret;
+}
+
+ObLogReplayTask *ObReplayServiceReplayTask::remove_deferred(const int64_t idx)
+{
+  ObLockGuard<ObSpinLock> guard(lock_);
+  ObLogReplayTask *replay_task = NULL;
+  if (idx >= 0 && idx < deferred_cnt_) {
+    replay_task = deferred_tasks_[idx];
+    for (int64_t i = idx; i < deferred_cnt_ - 1; ++i) {
+      deferred_tasks_[i] = deferred_tasks_[i + 1];
+    }
+    deferred_tasks_[deferred_cnt_ - 1] = NULL;
+    ATOMIC_STORE(&deferred_cnt_, deferred_cnt_ - 1);
+  }
+  return replay_task;
+}
+
 bool ObReplayServiceReplayTask::need_batch_push()
 {
   return need_batch_push_;
@@ -601,6 +653,7 @@ ObReplayStatus::ObReplayStatus():
     try_wrlock_debug_time_(OB_INVALID_TIMESTAMP),
     check_enable_debug_time_(OB_INVALID_TIMESTAMP)
 {
+  MEMSET(stall_cnt_, 0, sizeof(stall_cnt_));
 }
 
 ObReplayStatus::~ObReplayStatus()
@@ -772,6 +825,7 @@ int ObReplayStatus::disable_()
   }
   err_info_.reset();
   last_check_memstore_lsn_.reset();
+  MEMSET(stall_cnt_, 0, sizeof(stall_cnt_));
   get_log_info_debug_time_ = OB_INVALID_TIMESTAMP;
   ATOMIC_STORE(&post_barrier_lsn_.val_, LOG_INVALID_LSN_VAL);
   return ret;
@@ -1395,6 +1449,8 @@ int ObReplayStatus::diagnose(ReplayDiagnoseInfo &diagnose_info)
   int replay_ret = OB_SUCCESS;
   bool is_submit_err = false;
   diagnose_info.diagnose_str_.reset();
+  diagnose_info.replay_parallelism_ = 0;
+  diagnose_info.deferred_task_cnt_ = 0;
   if (IS_NOT_INIT) {
     ret = OB_NOT_INIT;
   } else if (!is_enabled_) {
@@ -1438,6 +1494,26 @@ int ObReplayStatus::diagnose(ReplayDiagnoseInfo &diagnose_info)
                                                        replay_cost, retry_cost, first_handle_time))) {
       CLOG_LOG(WARN, "append diagnose str failed", K(ret), K(replay_ret), K(min_unreplayed_lsn), K(min_unreplayed_scn),
                K(replay_hint), K(is_submit_err), K(replay_cost), K(retry_cost), K(first_handle_time));
+    } else if (is_enabled_) {
+      for (int64_t i = 0; i < REPLAY_TASK_QUEUE_SIZE; ++i) {
+        if (task_queues_[i].has_unreplayed_task()) {
+          diagnose_info.replay_parallelism_++;
+        }
+        diagnose_info.deferred_task_cnt_ += task_queues_[i].get_deferred_count();
+      }
+      if (OB_FAIL(diagnose_info.diagnose_str_.append_fmt(" replay_parallelism:%ld; "
+                                                         "deferred_task_cnt:%ld; "
+                                                         "stall_count:{pre_barrier:%ld, post_barrier:%ld, "
+                                                         "dependency:%ld, retry:%ld, pending_limit:%ld};",
+                                                         diagnose_info.replay_parallelism_,
+                                                         diagnose_info.deferred_task_cnt_,
+                                                         ATOMIC_LOAD(&stall_cnt_[REPLAY_STALL_PRE_BARRIER]),
+                                                         ATOMIC_LOAD(&stall_cnt_[REPLAY_STALL_POST_BARRIER]),
+                                                         ATOMIC_LOAD(&stall_cnt_[REPLAY_STALL_DEPENDENCY]),
+                                                         ATOMIC_LOAD(&stall_cnt_[REPLAY_STALL_RETRY]),
+                                                         ATOMIC_LOAD(&stall_cnt_[REPLAY_STALL_PENDING_LIMIT])))) {
+        CLOG_LOG(WARN, "append diagnose str failed", K(ret), K(diagnose_info));
+      }
     }
   }
   return ret;
@@ -57,6 +57,17 @@ enum class ObReplayServiceTaskType
   REPLAY_LOG_TASK = 2,
 };
 
+// reasons for which replay of a log stream can not make progress, counted for diagnose
+enum ObReplayStallReason
+{
+  REPLAY_STALL_PRE_BARRIER = 0, // pre barrier log waits for all former logs
+  REPLAY_STALL_POST_BARRIER = 1, // submit waits for the post barrier log
+  REPLAY_STALL_DEPENDENCY = 2, // task waits for former task with the same replay hint
+  REPLAY_STALL_RETRY = 3, // replay of ls returns retryable error
+  REPLAY_STALL_PENDING_LIMIT = 4, // pending replay tasks reach memory limit
+  REPLAY_STALL_MAX
+};
+
 //虚拟表统计
 struct LSReplayStat
 {
@@ -83,12 +94,20 @@ struct ReplayDiagnoseInfo
   ~ReplayDiagnoseInfo() { reset(); }
   palf::LSN max_replayed_lsn_;
   share::SCN max_replayed_scn_;
+  // count of task queues which have unreplayed tasks
+  int64_t replay_parallelism_;
+  // count of tasks bypassed by later independent tasks
+  int64_t deferred_task_cnt_;
   ObSqlString diagnose_str_;
   TO_STRING_KV(K(max_replayed_lsn_),
-               K(max_replayed_scn_));
+               K(max_replayed_scn_),
+               K(replay_parallelism_),
+               K(deferred_task_cnt_));
   void reset() {
     max_replayed_lsn_.reset();
     max_replayed_scn_.reset();
+    replay_parallelism_ = 0;
+    deferred_task_cnt_ = 0;
   }
 };
 
@@ -352,6 +371,7 @@ public:
     type_ = ObReplayServiceTaskType::REPLAY_LOG_TASK;
     idx_ = -1;
     need_batch_push_ = false;
+    deferred_cnt_ = 0;
   }
   ~ObReplayServiceReplayTask() { destroy(); }
   // use base_scn init min_unreplayed_scn
@@ -377,17 +397,46 @@ public:
                                   bool &is_queue_empty);
   bool need_batch_push();
   void set_batch_push_finish();
+  // deferred tasks are popped from queue_ but not replayed yet, they are older than tasks
+  // in queue_ and kept in log order. only the replay thread holding lease can modify them.
+  int64_t get_deferred_count() const
+  {
+    return ATOMIC_LOAD(&deferred_cnt_);
+  }
+  bool is_deferred_full() const
+  {
+    return MAX_DEFERRED_TASK_COUNT <= get_deferred_count();
+  }
+  ObLogReplayTask *get_deferred_task(const int64_t idx)
+  {
+    return deferred_tasks_[idx];
+  }
+  bool has_unreplayed_task() const
+  {
+    return NULL != queue_.top() || 0 < get_deferred_count();
+  }
+  // whether any of the first end_idx deferred tasks has the same replay hint
+  bool has_deferred_dependency(const int64_t end_idx, const int64_t replay_hint) const;
+  // move top of queue_ to the tail of deferred tasks
+  int defer_top();
+  // remove the idx-th deferred task after it is replayed
+  ObLogReplayTask *remove_deferred(const int64_t idx);
   INHERIT_TO_STRING_KV("ObReplayServiceReplayTask", ObReplayServiceTask,
-                       K(idx_));
+                       K(idx_), K(deferred_cnt_));
+public:
+  static const int64_t MAX_DEFERRED_TASK_COUNT = 32;
 private:
   Link *pop_()
   {
     return queue_.pop();
   }
+  void free_task_(ObLogReplayTask *replay_task);
 private:
   common::ObSpScLinkQueue queue_; //place ObLogReplayTask
   int64_t idx_; //热点行优化
   bool need_batch_push_; //batch push判断标志, 只有拉日志线程可以修改此值
+  int64_t deferred_cnt_;
+  ObLogReplayTask *deferred_tasks_[MAX_DEFERRED_TASK_COUNT];
 };
 
 class ObReplayFsCb : public palf::PalfFSCb
@@ -577,6 +626,12 @@ public:
   {
     last_check_memstore_lsn_ = lsn;
   }
+  void inc_stall_count(const ObReplayStallReason reason)
+  {
+    if (reason >= 0 && reason < REPLAY_STALL_MAX) {
+      ATOMIC_INC(&stall_cnt_[reason]);
+    }
+  }
 
   TO_STRING_KV(K(ls_id_),
                K(is_enabled_),
@@ -623,6 +678,8 @@ private:
   LSErrInfo err_info_;
   int64_t pending_task_count_;
   palf::LSN last_check_memstore_lsn_;
+  // stall count of each ObReplayStallReason since enabled
+  int64_t stall_cnt_[REPLAY_STALL_MAX];
   // protect is_enabled_ and submit_log_task_
   // 回放一条日志时会一直持有读锁直到回放完成
   // 保证拿写锁disable后一定不会有任何日志回放
@@ -2605,6 +2605,9 @@ typedef enum ObItemType
 
   T_PSEUDO_OLD_NEW_COL = 4742,
 
+  T_COL_SKIP_INDEX_BLOOM_FILTER = 4743,
+  T_COL_SKIP_INDEX_NGRAM_BLOOM_FILTER = 4744,
+
   T_MAX //Attention: add a new type before T_MAX
 } ObItemType;
 
@@ -198,11 +198,17 @@ int ObQueryDriver::response_query_result(ObResultSet &result,
   }
 
   const common::ColumnsFieldIArray *fields = NULL;
+  bool by_batch = false;
   if (OB_SUCC(ret)) {
     fields = result.get_field_columns();
     if (OB_ISNULL(fields)) {
       ret = OB_INVALID_ARGUMENT;
       LOG_WARN("fields is null", K(ret), KP(fields));
+    } else if (OB_FAIL(check_response_by_batch(result, is_ps_protocol, *fields, by_batch))) {
+      LOG_WARN("fail to check response by batch", K(ret));
+    } else if (by_batch) {
+      // returns OB_ITER_END after all rows are sent, same as the row by row path below
+      ret = response_query_result_by_batch(result, *fields, limit_count, has_more_result, can_retry, row_num);
     }
   }
   while (OB_SUCC(ret) && row_num < limit_count && !OB_FAIL(result.get_next_row(result_row)) ) {
@@ -318,6 +324,95 @@ int ObQueryDriver::response_query_result(ObResultSet &result,
   return ret;
 }
 
+int ObQueryDriver::check_response_by_batch(ObResultSet &result,
+                                           bool is_ps_protocol,
+                                           const ColumnsFieldIArray &fields,
+                                           bool &by_batch)
+{
+  int ret = OB_SUCCESS;
+  by_batch = false;
+  ObOperator *root = result.get_static_engine_root();
+  ObCharsetType result_charset = CHARSET_INVALID;
+  // binary protocol, packed plan and prexecute keep the row by row path
+  if (is_ps_protocol || is_prexecute_ || !lib::is_mysql_mode()
+      || NULL == result.get_physical_plan() || result.get_physical_plan()->is_packed()
+      || NULL == root || !root->get_spec().is_vectorized()
+      || fields.count() <= 0 || root->get_spec().output_.count() != fields.count()) {
+  } else if (OB_FAIL(session_.get_character_set_results(result_charset))) {
+    LOG_WARN("fail to get result charset", K(ret));
+  } else {
+    const ExprFixedArray &output = root->get_spec().output_;
+    by_batch = session_.is_enable_batch_result_encoding();
+    for (int64_t i = 0; by_batch && i < output.count(); ++i) {
+      by_batch = NULL != output.at(i)
+                 && ObSMBatchRow::is_supported(*output.at(i), fields.at(i), result_charset);
+    }
+  }
+  return ret;
+}
+
+int ObQueryDriver::response_query_result_by_batch(ObResultSet &result,
+                                                  const ColumnsFieldIArray &fields,
+                                                  const int64_t limit_count,
+                                                  bool has_more_result,
+                                                  bool &can_retry,
+                                                  int64_t &row_num)
+{
+  int ret = OB_SUCCESS;
+  ObOperator *root = result.get_static_engine_root();
+  const int64_t batch_size = root->get_spec().max_batch_size_;
+  ObArenaAllocator allocator("MysqlBatchRow", OB_MALLOC_NORMAL_BLOCK_SIZE,
+                             session_.get_effective_tenant_id());
+  ObSMBatchRow batch_row(allocator, root->get_spec().output_, fields, root->get_eval_ctx());
+  const ObBatchRows *brs = NULL;
+  bool iter_end = false;
+  while (OB_SUCC(ret) && !iter_end && row_num < limit_count) {
+    if (OB_FAIL(result.get_next_batch(MIN(batch_size, limit_count - row_num), brs))) {
+      LOG_WARN("fail to get next batch", K(ret), K(row_num), K(can_retry));
+    } else if (OB_FAIL(batch_row.encode_batch(*brs, limit_count - row_num))) {
+      LOG_WARN("fail to encode batch", K(ret), K(row_num));
+    } else {
+      iter_end = brs->end_;
+    }
+    if (OB_SUCC(ret) && 0 == row_num && batch_row.get_row_count() > 0) {
+      can_retry = false; // 已经获取到第一行数据，不再重试了
+#ifdef OB_BUILD_SPM
+      ObSqlCtx *sql_ctx = result.get_exec_context().get_sql_ctx();
+      if (OB_NOT_NULL(result.get_exec_context().get_physical_plan_ctx()) &&
+          OB_NOT_NULL(sql_ctx) && sql_ctx->spm_ctx_.need_spm_timeout_) {
+        LOG_TRACE("reset to origin timeout because result is returning to user");
+        result.get_exec_context().get_physical_plan_ctx()->set_spm_timeout_timestamp(0);
+      }
+#endif
+      if (OB_FAIL(response_query_header(result, has_more_result, false))) {
+        LOG_WARN("fail to response query header", K(ret), K(row_num), K(can_retry));
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < batch_row.get_row_count(); ++i) {
+      batch_row.set_cur_row(i);
+      OMPKRow rp(batch_row);
+      if (OB_FAIL(sender_.response_packet(rp, &result.get_session()))) {
+        LOG_WARN("response packet fail", K(ret), K(row_num), K(can_retry));
+      } else {
+        ++row_num;
+      }
+    }
+  }
+  if (result.is_calc_found_rows()) {
+    while (OB_SUCC(ret) && !iter_end) {
+      if (OB_FAIL(result.get_next_batch(batch_size, brs))) {
+        LOG_WARN("fail to get next batch", K(ret));
+      } else {
+        iter_end = brs->end_;
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
+    ret = OB_ITER_END;
+  }
+  return ret;
+}
+
 int ObQueryDriver::convert_field_charset(ObIAllocator& allocator,
                                          const ObCollationType& from_collation,
                                          const ObCollationType& dest_collation,
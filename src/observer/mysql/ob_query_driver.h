@@ -106,6 +106,17 @@ public:
                                         const sql::ObSQLSessionInfo *session_info,
                                         sql::ObExecContext *exec_ctx = nullptr);
 private:
+  int check_response_by_batch(sql::ObResultSet &result,
+                              bool is_ps_protocol,
+                              const ColumnsFieldIArray &fields,
+                              bool &by_batch);
+  // encode the vectorized output column by column instead of converting each row to ObNewRow
+  int response_query_result_by_batch(sql::ObResultSet &result,
+                                     const ColumnsFieldIArray &fields,
+                                     const int64_t limit_count,
+                                     bool has_more_result,
+                                     bool &can_retry,
+                                     int64_t &row_num);
   int convert_field_charset(common::ObIAllocator& allocator,
       const common::ObCollationType& from_collation,
       const common::ObCollationType& dest_collation,
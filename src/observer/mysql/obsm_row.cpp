@@ -10,11 +10,16 @@
  * See the Mulan PubL v2 for more details.
  */
 
+#define USING_LOG_PREFIX SERVER
+
 #include "obsm_row.h"
 
 #include "observer/mysql/obsm_utils.h"
 #include "common/ob_accuracy.h"
 #include "share/schema/ob_schema_getter_guard.h"
+#include "lib/utility/ob_fast_convert.h"
+#include "sql/engine/expr/ob_expr.h"
+#include "sql/engine/ob_batch_rows.h"
 
 using namespace oceanbase::share::schema;
 using namespace oceanbase::common;
@@ -71,3 +76,279 @@ int ObSMRow::encode_cell(
 
   return ret;
 }
+
+namespace
+{
+
+template <bool IS_UNSIGNED>
+struct ObSMIntCellEncoder
+{
+  OB_INLINE int operator()(const ObDatum &datum, char *buf, const int64_t len, int64_t &pos) const
+  {
+    int ret = OB_SUCCESS;
+    ObFastFormatInt ffi(datum.get_int(), IS_UNSIGNED);
+    // at most 9 bytes for the length
+    if (OB_UNLIKELY(len - pos < ffi.length() + 9)) {
+      ret = OB_SIZE_OVERFLOW;
+    } else if (OB_FAIL(ObMySQLUtil::store_length(buf, len, ffi.length(), pos))) {
+    } else {
+      MEMCPY(buf + pos, ffi.ptr(), ffi.length());
+      pos += ffi.length();
+    }
+    return ret;
+  }
+};
+
+struct ObSMNumberCellEncoder
+{
+  ObSMNumberCellEncoder(const ObScale scale) : scale_(scale) {}
+  OB_INLINE int operator()(const ObDatum &datum, char *buf, const int64_t len, int64_t &pos) const
+  {
+    return ObMySQLUtil::number_cell_str(buf, len, number::ObNumber(datum.get_number()), pos,
+                                        scale_, false, 0);
+  }
+  const ObScale scale_;
+};
+
+struct ObSMDecimalIntCellEncoder
+{
+  ObSMDecimalIntCellEncoder(const ObScale scale) : scale_(scale) {}
+  OB_INLINE int operator()(const ObDatum &datum, char *buf, const int64_t len, int64_t &pos) const
+  {
+    return ObMySQLUtil::decimalint_cell_str(buf, len, datum.get_decimal_int(), datum.get_int_bytes(),
+                                            scale_, pos, false, 0);
+  }
+  const ObScale scale_;
+};
+
+struct ObSMStringCellEncoder
+{
+  OB_INLINE int operator()(const ObDatum &datum, char *buf, const int64_t len, int64_t &pos) const
+  {
+    return ObMySQLUtil::varchar_cell_str(buf, len, datum.get_string(), false, pos);
+  }
+};
+
+} // end of anonymous namespace
+
+ObSMBatchRow::ObSMBatchRow(ObIAllocator &allocator,
+                           const ObIArray<sql::ObExpr *> &exprs,
+                           const ColumnsFieldIArray &fields,
+                           sql::ObEvalCtx &eval_ctx)
+    : ObMySQLRow(TEXT),
+      allocator_(allocator),
+      exprs_(exprs),
+      fields_(fields),
+      eval_ctx_(eval_ctx),
+      columns_(NULL),
+      row_idxs_(NULL),
+      capacity_(0),
+      row_cnt_(0),
+      cur_row_(0)
+{
+}
+
+bool ObSMBatchRow::is_supported(const sql::ObExpr &expr,
+                                const ObField &field,
+                                const ObCharsetType result_charset)
+{
+  bool supported = 0 == (field.flags_ & ZEROFILL_FLAG);
+  if (supported) {
+    switch (expr.obj_meta_.get_type_class()) {
+      case ObIntTC:
+      case ObUIntTC:
+      case ObNumberTC:
+      case ObDecimalIntTC:
+        break;
+      case ObStringTC: {
+        // same condition as ObObj::convert_string_value_charset, the string is sent as it is
+        const ObCollationType cs_type = expr.obj_meta_.get_collation_type();
+        supported = CS_TYPE_INVALID != cs_type
+            && (!ObCharset::is_valid_charset(result_charset)
+                || CHARSET_BINARY == result_charset
+                || CS_TYPE_BINARY == cs_type
+                || ObCharset::charset_type_by_coll(cs_type) == result_charset);
+        break;
+      }
+      default:
+        supported = false;
+        break;
+    }
+  }
+  return supported;
+}
+
+int ObSMBatchRow::prepare(const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t column_cnt = exprs_.count();
+  if (NULL == columns_) {
+    if (OB_ISNULL(columns_ = static_cast<EncodedColumn *>(
+                allocator_.alloc(sizeof(EncodedColumn) * column_cnt)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc memory failed", K(ret), K(column_cnt));
+    } else {
+      for (int64_t i = 0; i < column_cnt; ++i) {
+        new (&columns_[i]) EncodedColumn();
+      }
+    }
+  }
+  if (OB_SUCC(ret) && batch_size > capacity_) {
+    if (OB_ISNULL(row_idxs_ = static_cast<int64_t *>(allocator_.alloc(sizeof(int64_t) * batch_size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc memory failed", K(ret), K(batch_size));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_cnt; ++i) {
+      if (OB_ISNULL(columns_[i].offsets_ = static_cast<int64_t *>(
+                  allocator_.alloc(sizeof(int64_t) * (batch_size + 1))))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc memory failed", K(ret), K(batch_size));
+      } else if (OB_FAIL(expand_column(columns_[i], 0))) {
+        LOG_WARN("failed to expand column", K(ret), K(batch_size));
+      }
+    }
+    if (OB_SUCC(ret)) {
+      capacity_ = batch_size;
+    }
+  }
+  return ret;
+}
+
+int ObSMBatchRow::expand_column(EncodedColumn &column, const int64_t data_size)
+{
+  int ret = OB_SUCCESS;
+  const int64_t new_size = MAX(column.buf_size_ * 2, capacity_ * DEFAULT_CELL_SIZE);
+  char *new_buf = NULL;
+  if (OB_ISNULL(new_buf = static_cast<char *>(allocator_.alloc(new_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc memory failed", K(ret), K(new_size));
+  } else {
+    if (data_size > 0) {
+      MEMCPY(new_buf, column.buf_, data_size);
+    }
+    column.buf_ = new_buf;
+    column.buf_size_ = new_size;
+  }
+  return ret;
+}
+
+int ObSMBatchRow::encode_batch(const sql::ObBatchRows &brs, const int64_t max_row_cnt)
+{
+  int ret = OB_SUCCESS;
+  row_cnt_ = 0;
+  cur_row_ = 0;
+  if (OB_UNLIKELY(exprs_.count() != fields_.count() || exprs_.count() <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(exprs_.count()), K(fields_.count()));
+  } else if (OB_FAIL(prepare(brs.size_))) {
+    LOG_WARN("failed to prepare", K(ret), K(brs.size_));
+  } else {
+    for (int64_t i = 0; i < brs.size_ && row_cnt_ < max_row_cnt; ++i) {
+      if (!brs.skip_->at(i)) {
+        row_idxs_[row_cnt_++] = i;
+      }
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && row_cnt_ > 0 && i < exprs_.count(); ++i) {
+      if (OB_FAIL(encode_column(i))) {
+        LOG_WARN("failed to encode column", K(ret), K(i));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObSMBatchRow::encode_column(const int64_t col_idx)
+{
+  int ret = OB_SUCCESS;
+  const sql::ObExpr *expr = exprs_.at(col_idx);
+  if (OB_ISNULL(expr)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("expr is null", K(ret), K(col_idx));
+  } else {
+    // expressions are evaluated in get_next_batch(), get datum value directly
+    const ObDatum *datums = expr->locate_batch_datums(eval_ctx_);
+    const bool is_batch_result = expr->is_batch_result();
+    EncodedColumn &column = columns_[col_idx];
+    switch (expr->obj_meta_.get_type_class()) {
+      case ObIntTC:
+        ret = encode_column(ObSMIntCellEncoder<false>(), datums, is_batch_result, column);
+        break;
+      case ObUIntTC:
+        ret = encode_column(ObSMIntCellEncoder<true>(), datums, is_batch_result, column);
+        break;
+      case ObNumberTC:
+        ret = encode_column(ObSMNumberCellEncoder(fields_.at(col_idx).accuracy_.get_scale()),
+                            datums, is_batch_result, column);
+        break;
+      case ObDecimalIntTC:
+        ret = encode_column(ObSMDecimalIntCellEncoder(expr->obj_meta_.get_scale()),
+                            datums, is_batch_result, column);
+        break;
+      case ObStringTC:
+        ret = encode_column(ObSMStringCellEncoder(), datums, is_batch_result, column);
+        break;
+      default:
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected type class", K(ret), K(col_idx), K(expr->obj_meta_));
+        break;
+    }
+  }
+  return ret;
+}
+
+template <typename CellEncoder>
+int ObSMBatchRow::encode_column(const CellEncoder &encoder,
+                                const ObDatum *datums,
+                                const bool is_batch_result,
+                                EncodedColumn &column)
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  int64_t i = 0;
+  while (OB_SUCC(ret) && i < row_cnt_) {
+    const ObDatum &datum = datums[is_batch_result ? row_idxs_[i] : 0];
+    column.offsets_[i] = pos;
+    if (datum.is_null()) {
+      ret = ObMySQLUtil::store_null(column.buf_, column.buf_size_, pos);
+    } else {
+      ret = encoder(datum, column.buf_, column.buf_size_, pos);
+    }
+    if (OB_SUCCESS == ret) {
+      ++i;
+    } else if (OB_SIZE_OVERFLOW == ret || OB_BUF_NOT_ENOUGH == ret) {
+      // encode the cell again after the buffer is enlarged
+      pos = column.offsets_[i];
+      if (OB_FAIL(expand_column(column, pos))) {
+        LOG_WARN("failed to expand column", K(ret), K(pos));
+      }
+    } else {
+      LOG_WARN("failed to encode cell", K(ret), K(i), K(datum));
+    }
+  }
+  if (OB_SUCC(ret)) {
+    column.offsets_[row_cnt_] = pos;
+  }
+  return ret;
+}
+
+int ObSMBatchRow::encode_cell(
+    int64_t idx, char *buf,
+    int64_t len, int64_t &pos, char *bitmap) const
+{
+  UNUSED(bitmap);
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(idx < 0 || idx >= get_cells_cnt() || cur_row_ < 0 || cur_row_ >= row_cnt_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(idx), K_(cur_row), K_(row_cnt));
+  } else {
+    const EncodedColumn &column = columns_[idx];
+    const int64_t cell_len = column.offsets_[cur_row_ + 1] - column.offsets_[cur_row_];
+    if (OB_UNLIKELY(len - pos < cell_len)) {
+      ret = OB_SIZE_OVERFLOW;
+    } else {
+      MEMCPY(buf + pos, column.buf_ + column.offsets_[cur_row_], cell_len);
+      pos += cell_len;
+    }
+  }
+  return ret;
+}
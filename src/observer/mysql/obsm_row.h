@@ -29,8 +29,16 @@ class ObSchemaGetterGuard;
 }
 }
 
+namespace sql
+{
+struct ObExpr;
+struct ObEvalCtx;
+struct ObBatchRows;
+}
+
 namespace common
 {
+struct ObDatum;
 
 class ObSMRow
     : public obmysql::ObMySQLRow
@@ -66,6 +74,67 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObSMRow);
 }; // end of class OBMP
 
+// Text protocol rows of a vectorized batch. The cells are encoded column by column with one
+// type specialized loop per column, then each row is serialized by copying its encoded cells.
+class ObSMBatchRow
+    : public obmysql::ObMySQLRow
+{
+public:
+  static const int64_t DEFAULT_CELL_SIZE = 32;
+public:
+  ObSMBatchRow(common::ObIAllocator &allocator,
+               const common::ObIArray<sql::ObExpr *> &exprs,
+               const ColumnsFieldIArray &fields,
+               sql::ObEvalCtx &eval_ctx);
+  virtual ~ObSMBatchRow() {}
+  // whether the text encoding of the column needs nothing but the datum and the field,
+  // e.g. no charset conversion or lob locator processing
+  static bool is_supported(const sql::ObExpr &expr,
+                           const ObField &field,
+                           const ObCharsetType result_charset);
+  // encode the first max_row_cnt active rows of the batch
+  int encode_batch(const sql::ObBatchRows &brs, const int64_t max_row_cnt);
+  int64_t get_row_count() const { return row_cnt_; }
+  void set_cur_row(const int64_t row_idx) { cur_row_ = row_idx; }
+
+protected:
+  virtual int64_t get_cells_cnt() const { return exprs_.count(); }
+  virtual int encode_cell(
+      int64_t idx, char *buf,
+      int64_t len, int64_t &pos, char *bitmap) const;
+
+private:
+  struct EncodedColumn
+  {
+    EncodedColumn() : buf_(NULL), buf_size_(0), offsets_(NULL) {}
+    char *buf_;
+    int64_t buf_size_;
+    // offsets_[i] is the start of the cell of row i, offsets_[row_cnt_] is the end
+    int64_t *offsets_;
+  };
+  int prepare(const int64_t batch_size);
+  int expand_column(EncodedColumn &column, const int64_t data_size);
+  int encode_column(const int64_t col_idx);
+  template <typename CellEncoder>
+  int encode_column(const CellEncoder &encoder,
+                    const common::ObDatum *datums,
+                    const bool is_batch_result,
+                    EncodedColumn &column);
+
+private:
+  common::ObIAllocator &allocator_;
+  const common::ObIArray<sql::ObExpr *> &exprs_;
+  const ColumnsFieldIArray &fields_;
+  sql::ObEvalCtx &eval_ctx_;
+  EncodedColumn *columns_;
+  int64_t *row_idxs_;
+  int64_t capacity_;
+  int64_t row_cnt_;
+  int64_t cur_row_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObSMBatchRow);
+};
+
 } // end of namespace common
 } // end of namespace oceanbase
 
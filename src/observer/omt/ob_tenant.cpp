@@ -69,6 +69,7 @@ using namespace oceanbase::obrpc;
 #define EXPAND_INTERVAL (1 * 1000 * 1000)
 #define SHRINK_INTERVAL (1 * 1000 * 1000)
 #define SLEEP_INTERVAL (60 * 1000 * 1000)
+#define MIN_YIELD_WAIT_US (1 * 1000L)
 
 extern "C" {
 int ob_pthread_create(void **ptr, void *(*start_routine) (void *), void *arg);
@@ -778,7 +779,8 @@ ObTenant::ObTenant(const int64_t id,
       st_metrics_(),
       sql_limiter_(),
       worker_us_(0),
-      cpu_time_us_(0)
+      cpu_time_us_(0),
+      yield_wait_us_(INT64_MAX)
 {
   token_usage_check_ts_ = ObTimeUtility::current_time();
   lock_.set_diagnose(true);
@@ -885,6 +887,8 @@ int ObTenant::construct_mtl_init_ctx(const ObTenantMeta &meta, share::ObTenantMo
       ret = is_virtual_tenant_id(id_) ? OB_SUCCESS : OB_ENTRY_NOT_EXIST;
     } else {
       mtl_init_ctx_->palf_options_.disk_options_.log_writer_parallelism_ = tenant_config->_log_writer_parallelism;
+      mtl_init_ctx_->palf_options_.disk_options_.log_writer_batch_latency_target_us_ =
+          tenant_config->_log_writer_batch_latency_target;
       mtl_init_ctx_->palf_options_.enable_log_cache_ = tenant_config->_enable_log_cache;
     }
     LOG_INFO("construct_mtl_init_ctx success", "palf_options", mtl_init_ctx_->palf_options_.disk_options_);
@@ -1725,12 +1729,17 @@ void ObTenant::check_worker_count()
     int64_t token = 3;
     int64_t now = ObTimeUtility::current_time();
     bool enable_dynamic_worker = true;
+    bool enable_worker_yield = false;
     int64_t threshold = 3 * 1000;
     {
       ObTenantConfigGuard tenant_config(TENANT_CONF(id_));
       enable_dynamic_worker = tenant_config.is_valid() ? tenant_config->_ob_enable_dynamic_worker : true;
+      enable_worker_yield = tenant_config.is_valid() ? tenant_config->_enable_worker_yield_on_blocking_wait : false;
       threshold = tenant_config.is_valid() ? tenant_config->_stall_threshold_for_dynamic_worker : 3 * 1000;
     }
+    // a worker blocked longer than threshold makes the tenant acquire one more worker,
+    // so retryable requests yield the worker before that instead.
+    ATOMIC_STORE(&yield_wait_us_, enable_worker_yield ? std::max(threshold, MIN_YIELD_WAIT_US) : INT64_MAX);
     // assume that high priority and normal priority were busy.
     DLIST_FOREACH_REMOVESAFE(wnode, workers_) {
       const auto w = static_cast<ObThWorker*>(wnode->get_data());
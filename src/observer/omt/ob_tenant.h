@@ -418,6 +418,7 @@ public:
   void set_unit_max_cpu(double cpu);
   void set_unit_min_cpu(double cpu);
   OB_INLINE int64_t total_worker_cnt() const { return total_worker_cnt_; }
+  OB_INLINE int64_t get_yield_wait_us() const { return ATOMIC_LOAD(&yield_wait_us_); }
   int64_t cpu_quota_concurrency() const;
   int64_t min_worker_cnt() const;
   int64_t max_worker_cnt() const;
@@ -614,6 +615,8 @@ public:
   // idle time between two checkpoints
   int64_t worker_us_;
   int64_t cpu_time_us_ CACHE_ALIGNED;
+  // retryable requests give up blocking waits longer than it, refreshed in check_worker_count
+  int64_t yield_wait_us_;
 }; // end of class ObTenant
 
 OB_INLINE int64_t ObResourceGroup::min_worker_cnt() const
@@ -148,6 +148,32 @@ void ObThWorker::resume()
   run_cond_.signal();
 }
 
+int64_t ObThWorker::get_yield_wait_us() const
+{
+  const rpc::ObRequest *req = get_cur_request();
+  const int32_t retry_times = OB_NOT_NULL(req) ? req->get_retry_times() : 0;
+  return OB_ISNULL(tenant_) ? INT64_MAX
+      : calc_yield_wait_us(can_retry_, tenant_->get_yield_wait_us(), retry_times);
+}
+
+int64_t ObThWorker::calc_yield_wait_us(const bool can_retry,
+                                       const int64_t tenant_yield_wait_us,
+                                       const int32_t retry_times)
+{
+  int64_t wait_us = INT64_MAX;
+  // only requests that can be thrown back to the tenant queue are able to yield,
+  // and a request that keeps yielding falls back to a blocking wait so that a slow
+  // gts can not turn every statement into an endless packet retry
+  if (!can_retry || tenant_yield_wait_us <= 0 || INT64_MAX == tenant_yield_wait_us) {
+  } else if (retry_times < 0 || retry_times >= MAX_YIELD_RETRY_TIMES) {
+  } else if (tenant_yield_wait_us > (INT64_MAX >> retry_times)) {
+  } else {
+    // retries after the first one are also delayed by the tenant retry queue
+    wait_us = tenant_yield_wait_us << retry_times;
+  }
+  return wait_us;
+}
+
 
 RLOCAL(uint64_t, serving_tenant_id);
 
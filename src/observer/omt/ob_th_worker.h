@@ -63,6 +63,13 @@ public:
   virtual void unset_need_retry() override { need_retry_ = false; }
   virtual bool need_retry() const override { return need_retry_; }
   virtual void resume() override;
+  virtual int64_t get_yield_wait_us() const override;
+  // a request yields at most MAX_YIELD_RETRY_TIMES times, the wait threshold doubles
+  // on every retry and INT64_MAX (block) is returned once the budget is used up
+  static int64_t calc_yield_wait_us(const bool can_retry,
+                                    const int64_t tenant_yield_wait_us,
+                                    const int32_t retry_times);
+  static const int32_t MAX_YIELD_RETRY_TIMES = 3;
 
   int init();
   void destroy();
@@ -24,6 +24,26 @@ const char *const OB_LS_LOCATION_CACHE_NAME = "ls_location_cache";
 const char *const OB_TABLET_CACHE_NAME = "tablet_ls_cache";
 const char *const OB_TABLET_TABLE_CACHE_NAME = "tablet_table_cache";
 const char *const OB_VTABLE_CACHE_NAME = "vtable_cache";
+const char *const OB_INDEX_BLOCK_CACHE_NAME = "index_block_cache";
+const char *const OB_USER_BLOCK_CACHE_NAME = "user_block_cache";
+const char *const OB_USER_ROW_CACHE_NAME = "user_row_cache";
+const char *const OB_BF_CACHE_NAME = "bf_cache";
+const char *const OB_FUSE_ROW_CACHE_NAME = "fuse_row_cache";
+const char *const OB_MICRO_BLOCK_DICT_CACHE_NAME = "micro_block_dict_cache";
+
+// admission policy of kvcache, takes effect when _enable_kvcache_admission is on.
+// caches not listed here put every kvpair into the map.
+// see ObKVCacheAdmission for the policy names.
+struct ObKVCacheAdmissionDef
+{
+  const char *cache_name_;
+  const char *policy_name_;
+};
+const ObKVCacheAdmissionDef OB_KVCACHE_ADMISSION_DEFS[] = {
+  { OB_USER_BLOCK_CACHE_NAME, "tiny_lfu" },
+  { OB_USER_ROW_CACHE_NAME, "clock_pro" },
+  { OB_FUSE_ROW_CACHE_NAME, "clock_pro" },
+};
 }//end namespace share
 }//end namespace oceanbase
 
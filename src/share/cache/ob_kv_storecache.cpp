@@ -634,6 +634,9 @@ int ObKVGlobalCache::register_cache(
         configs_[cache_id].cache_name_[MAX_CACHE_NAME_LENGTH - 1] = '\0';
         configs_[cache_id].priority_ = priority;
         configs_[cache_id].mem_limit_pct_ = mem_limit_pct;
+        configs_[cache_id].admission_policy_ = common::ObServerConfig::get_instance()._enable_kvcache_admission
+            ? get_cache_admission_policy(cache_name)
+            : ADMISSION_NONE;
         configs_[cache_id].is_valid_ = true;
       }
     }
@@ -737,6 +740,26 @@ int ObKVGlobalCache::set_mem_limit_pct(const int64_t cache_id, const int64_t mem
   return ret;
 }
 
+int ObKVGlobalCache::set_admission_policy(const int64_t cache_id, const ObKVCacheAdmissionPolicy policy)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVGlobalCache has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(cache_id < 0) || OB_UNLIKELY(cache_id >= MAX_CACHE_NUM)
+      || OB_UNLIKELY(policy < ADMISSION_NONE) || OB_UNLIKELY(policy >= MAX_ADMISSION_POLICY)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "Invalid argument, ", K(cache_id), K(policy), K(ret));
+  } else if (ATOMIC_LOAD(&configs_[cache_id].admission_policy_) != policy) {
+    ATOMIC_STORE(&configs_[cache_id].admission_policy_, policy);
+    COMMON_LOG(INFO, "Succ to set admission policy", K(cache_id), "cache_name", configs_[cache_id].cache_name_,
+        "policy", get_kvcache_admission_policy_str(policy));
+  }
+
+  return ret;
+}
+
 void ObKVGlobalCache::wash()
 {
   if (OB_LIKELY(inited_ && !stopped_)) {
@@ -774,6 +797,22 @@ void ObKVGlobalCache::revert(ObKVMemBlockHandle *mb_handle)
   }
 }
 
+void ObKVGlobalCache::reload_admission_policy()
+{
+  int ret = OB_SUCCESS;
+  const bool enable_admission = common::ObServerConfig::get_instance()._enable_kvcache_admission;
+  for (int16_t i = 0; i < MAX_CACHE_NUM; ++i) {
+    if (configs_[i].is_valid_) {
+      const ObKVCacheAdmissionPolicy policy = enable_admission
+          ? get_cache_admission_policy(configs_[i].cache_name_)
+          : ADMISSION_NONE;
+      if (OB_FAIL(set_admission_policy(i, policy))) {
+        COMMON_LOG(WARN, "Fail to set admission policy, ", K(i), K(policy));
+      }
+    }
+  }
+}
+
 void ObKVGlobalCache::reload_priority()
 {
   int ret = OB_SUCCESS;
@@ -790,7 +829,8 @@ void ObKVGlobalCache::reload_priority()
         priority = common::ObServerConfig::get_instance().tablet_ls_cache_priority;
       } else if (0 == STRNCMP(configs_[i].cache_name_, "index_block_cache", MAX_CACHE_NAME_LENGTH)) {
         priority = common::ObServerConfig::get_instance().index_block_cache_priority;
-      } else if (0 == STRNCMP(configs_[i].cache_name_, "user_block_cache", MAX_CACHE_NAME_LENGTH)) {
+      } else if (0 == STRNCMP(configs_[i].cache_name_, "user_block_cache", MAX_CACHE_NAME_LENGTH)
+          || 0 == STRNCMP(configs_[i].cache_name_, "micro_block_dict_cache", MAX_CACHE_NAME_LENGTH)) {
         priority = common::ObServerConfig::get_instance().user_block_cache_priority;
       } else if (0 == STRNCMP(configs_[i].cache_name_, "user_row_cache", MAX_CACHE_NAME_LENGTH)) {
         priority = common::ObServerConfig::get_instance().user_row_cache_priority;
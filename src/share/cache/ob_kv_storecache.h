@@ -62,6 +62,7 @@ public:
   void destroy();
   int set_priority(const int64_t priority);
   int set_mem_limit_pct(const int64_t mem_limit_pct);
+  int set_admission_policy(const ObKVCacheAdmissionPolicy policy);
   virtual int put(const Key &key, const Value &value, bool overwrite = true);
   virtual int put_and_fetch(
     const Key &key,
@@ -140,6 +141,7 @@ public:
   void wait();
   void destroy();
   void reload_priority();
+  void reload_admission_policy();
   int reload_wash_interval();
   int64_t get_suitable_bucket_num();
   int get_cache_inst_info(const uint64_t tenant_id, ObIArray<ObKVCacheInstHandle> &inst_handles);
@@ -180,6 +182,7 @@ private:
   int delete_working_set(ObWorkingSet *working_set);
   int set_priority(const int64_t cache_id, const int64_t priority);
   int set_mem_limit_pct(const int64_t cache_id, const int64_t mem_limit_pct);
+  int set_admission_policy(const int64_t cache_id, const ObKVCacheAdmissionPolicy policy);
   int put(
     const int64_t cache_id,
     const ObIKVCacheKey &key,
@@ -482,6 +485,19 @@ int ObKVCache<Key, Value>::set_mem_limit_pct(const int64_t mem_limit_pct)
   return ret;
 }
 
+template <class Key, class Value>
+int ObKVCache<Key, Value>::set_admission_policy(const ObKVCacheAdmissionPolicy policy)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
+  } else if (OB_FAIL(ObKVGlobalCache::get_instance().set_admission_policy(cache_id_, policy))) {
+    COMMON_LOG(WARN, "Fail to set admission policy, ", K(ret), K(policy));
+  }
+  return ret;
+}
+
 template <class Key, class Value>
 int64_t ObKVCache<Key, Value>::size(const uint64_t tenant_id) const
 {
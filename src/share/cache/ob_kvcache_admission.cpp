@@ -0,0 +1,286 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "share/cache/ob_kvcache_admission.h"
+#include "share/cache/ob_cache_name_define.h"
+#include "lib/allocator/ob_malloc.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+static const char *kvcache_admission_policy_strs[] = {
+  "none",
+  "tiny_lfu",
+  "clock_pro",
+};
+
+const char *get_kvcache_admission_policy_str(const ObKVCacheAdmissionPolicy policy)
+{
+  STATIC_ASSERT(MAX_ADMISSION_POLICY == ARRAYSIZEOF(kvcache_admission_policy_strs),
+      "kvcache admission policy str len is mismatch");
+  const char *str = "invalid";
+  if (policy >= ADMISSION_NONE && policy < MAX_ADMISSION_POLICY) {
+    str = kvcache_admission_policy_strs[policy];
+  }
+  return str;
+}
+
+ObKVCacheAdmissionPolicy get_kvcache_admission_policy(const char *policy_str)
+{
+  ObKVCacheAdmissionPolicy policy = ADMISSION_NONE;
+  if (OB_NOT_NULL(policy_str)) {
+    for (int64_t i = 0; i < MAX_ADMISSION_POLICY; ++i) {
+      if (0 == STRCASECMP(policy_str, kvcache_admission_policy_strs[i])) {
+        policy = static_cast<ObKVCacheAdmissionPolicy>(i);
+        break;
+      }
+    }
+  }
+  return policy;
+}
+
+ObKVCacheAdmissionPolicy get_cache_admission_policy(const char *cache_name)
+{
+  ObKVCacheAdmissionPolicy policy = ADMISSION_NONE;
+  if (OB_NOT_NULL(cache_name)) {
+    for (int64_t i = 0; i < ARRAYSIZEOF(share::OB_KVCACHE_ADMISSION_DEFS); ++i) {
+      if (0 == STRCMP(cache_name, share::OB_KVCACHE_ADMISSION_DEFS[i].cache_name_)) {
+        policy = get_kvcache_admission_policy(share::OB_KVCACHE_ADMISSION_DEFS[i].policy_name_);
+        break;
+      }
+    }
+  }
+  return policy;
+}
+
+/*
+ * -------------------------------------------------------ObKVCacheAdmission-------------------------------------------------------
+ */
+ObKVCacheAdmission::ObKVCacheAdmission()
+  : state_(STATE_UNINIT),
+    policy_(ADMISSION_NONE),
+    window_put_cnt_(0),
+    is_aging_(false),
+    sketch_(nullptr),
+    doorkeeper_(nullptr),
+    ghosts_(nullptr),
+    ghost_hands_(nullptr)
+{
+}
+
+ObKVCacheAdmission::~ObKVCacheAdmission()
+{
+  destroy();
+}
+
+void ObKVCacheAdmission::destroy()
+{
+  if (nullptr != sketch_) {
+    ob_free(sketch_);
+    sketch_ = nullptr;
+  }
+  if (nullptr != doorkeeper_) {
+    ob_free(doorkeeper_);
+    doorkeeper_ = nullptr;
+  }
+  if (nullptr != ghosts_) {
+    ob_free(ghosts_);
+    ghosts_ = nullptr;
+  }
+  if (nullptr != ghost_hands_) {
+    ob_free(ghost_hands_);
+    ghost_hands_ = nullptr;
+  }
+  window_put_cnt_ = 0;
+  is_aging_ = false;
+  policy_ = ADMISSION_NONE;
+  state_ = STATE_UNINIT;
+}
+
+int ObKVCacheAdmission::init_(const uint64_t tenant_id, const ObKVCacheAdmissionPolicy policy)
+{
+  int ret = OB_SUCCESS;
+  ObMemAttr attr = SET_IGNORE_MEM_VERSION(ObMemAttr(tenant_id, "CacheAdmission"));
+  if (ADMISSION_TINY_LFU == policy) {
+    const int64_t sketch_size = SKETCH_DEPTH * SKETCH_WIDTH * sizeof(uint8_t);
+    const int64_t doorkeeper_size = DOORKEEPER_BITS / 8;
+    if (OB_ISNULL(sketch_ = static_cast<uint8_t *>(ob_malloc(sketch_size, attr)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      COMMON_LOG(WARN, "Fail to allocate count-min sketch", K(ret), K(sketch_size));
+    } else if (OB_ISNULL(doorkeeper_ = static_cast<uint64_t *>(ob_malloc(doorkeeper_size, attr)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      COMMON_LOG(WARN, "Fail to allocate doorkeeper", K(ret), K(doorkeeper_size));
+    } else {
+      MEMSET(sketch_, 0, sketch_size);
+      MEMSET(doorkeeper_, 0, doorkeeper_size);
+    }
+  } else if (ADMISSION_CLOCK_PRO == policy) {
+    const int64_t ghost_size = GHOST_SETS * GHOST_WAYS * sizeof(uint64_t);
+    const int64_t hand_size = GHOST_SETS * sizeof(uint8_t);
+    if (OB_ISNULL(ghosts_ = static_cast<uint64_t *>(ob_malloc(ghost_size, attr)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      COMMON_LOG(WARN, "Fail to allocate ghost entries", K(ret), K(ghost_size));
+    } else if (OB_ISNULL(ghost_hands_ = static_cast<uint8_t *>(ob_malloc(hand_size, attr)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      COMMON_LOG(WARN, "Fail to allocate ghost clock hands", K(ret), K(hand_size));
+    } else {
+      MEMSET(ghosts_, 0, ghost_size);
+      MEMSET(ghost_hands_, 0, hand_size);
+    }
+  } else {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "Invalid admission policy", K(ret), K(policy));
+  }
+
+  if (OB_SUCC(ret)) {
+    policy_ = policy;
+    window_put_cnt_ = 0;
+    is_aging_ = false;
+  }
+  return ret;
+}
+
+bool ObKVCacheAdmission::admit(
+    const uint64_t tenant_id,
+    const ObKVCacheAdmissionPolicy policy,
+    const uint64_t hash)
+{
+  bool admitted = true;
+  int64_t state = ATOMIC_LOAD(&state_);
+  if (OB_UNLIKELY(STATE_UNINIT == state) && ATOMIC_BCAS(&state_, STATE_UNINIT, STATE_INITING)) {
+    if (OB_SUCCESS != init_(tenant_id, policy)) {
+      destroy();
+    } else {
+      ATOMIC_STORE(&state_, STATE_READY);
+      COMMON_LOG(INFO, "Succ to init kvcache admission filter", K(tenant_id),
+          "policy", get_kvcache_admission_policy_str(policy));
+    }
+    state = ATOMIC_LOAD(&state_);
+  }
+  // admit everything until memory is ready, or the policy of cache has been changed
+  if (STATE_READY == state && policy == policy_) {
+    const uint64_t mixed_hash = mix_hash_(hash);
+    if (ADMISSION_TINY_LFU == policy) {
+      admitted = tiny_lfu_admit_(mixed_hash);
+    } else if (ADMISSION_CLOCK_PRO == policy) {
+      admitted = clock_pro_admit_(mixed_hash);
+    }
+  }
+  return admitted;
+}
+
+bool ObKVCacheAdmission::tiny_lfu_admit_(const uint64_t hash)
+{
+  int64_t estimate = 0;
+  if (test_and_set_doorkeeper_(hash)) {
+    // conservative update: only the smallest counters are increased
+    uint8_t min_count = SKETCH_MAX_COUNT;
+    for (int64_t i = 0; i < SKETCH_DEPTH; ++i) {
+      min_count = MIN(min_count, ATOMIC_LOAD(&sketch_[sketch_pos_(hash, i)]));
+    }
+    if (min_count < SKETCH_MAX_COUNT) {
+      for (int64_t i = 0; i < SKETCH_DEPTH; ++i) {
+        uint8_t *counter = &sketch_[sketch_pos_(hash, i)];
+        if (min_count == ATOMIC_LOAD(counter)) {
+          (void) ATOMIC_BCAS(counter, min_count, static_cast<uint8_t>(min_count + 1));
+        }
+      }
+      ++min_count;
+    }
+    estimate = 1 + min_count;
+  }
+  if (ATOMIC_AAF(&window_put_cnt_, 1) >= WINDOW_SIZE) {
+    try_age_();
+  }
+  return estimate >= ADMIT_FREQUENCY;
+}
+
+void ObKVCacheAdmission::try_age_()
+{
+  if (ATOMIC_BCAS(&is_aging_, false, true)) {
+    if (ATOMIC_LOAD(&window_put_cnt_) >= WINDOW_SIZE) {
+      for (int64_t i = 0; i < SKETCH_DEPTH * SKETCH_WIDTH; ++i) {
+        ATOMIC_STORE(&sketch_[i], static_cast<uint8_t>(ATOMIC_LOAD(&sketch_[i]) >> 1));
+      }
+      for (int64_t i = 0; i < DOORKEEPER_BITS / 64; ++i) {
+        ATOMIC_STORE(&doorkeeper_[i], 0);
+      }
+      ATOMIC_STORE(&window_put_cnt_, 0);
+    }
+    ATOMIC_STORE(&is_aging_, false);
+  }
+}
+
+bool ObKVCacheAdmission::test_and_set_doorkeeper_(const uint64_t hash)
+{
+  const uint64_t pos1 = hash % DOORKEEPER_BITS;
+  const uint64_t pos2 = (hash >> 32) % DOORKEEPER_BITS;
+  const uint64_t mask1 = 1ULL << (pos1 % 64);
+  const uint64_t mask2 = 1ULL << (pos2 % 64);
+  const uint64_t old1 = __atomic_fetch_or(&doorkeeper_[pos1 / 64], mask1, __ATOMIC_RELAXED);
+  const uint64_t old2 = __atomic_fetch_or(&doorkeeper_[pos2 / 64], mask2, __ATOMIC_RELAXED);
+  return 0 != (old1 & mask1) && 0 != (old2 & mask2);
+}
+
+uint64_t ObKVCacheAdmission::sketch_pos_(const uint64_t hash, const int64_t row) const
+{
+  const uint64_t h1 = hash & 0xFFFFFFFF;
+  const uint64_t h2 = (hash >> 32) | 1;
+  return row * SKETCH_WIDTH + ((h1 + row * h2) % SKETCH_WIDTH);
+}
+
+bool ObKVCacheAdmission::clock_pro_admit_(const uint64_t hash)
+{
+  bool admitted = false;
+  const uint64_t set_idx = (hash >> 32) % GHOST_SETS;
+  // signature never be 0, which marks an empty slot
+  const uint64_t signature = (hash & ~1ULL) | 2ULL;
+  uint64_t *ghost_set = ghosts_ + set_idx * GHOST_WAYS;
+  for (int64_t i = 0; !admitted && i < GHOST_WAYS; ++i) {
+    const uint64_t slot = ATOMIC_LOAD(&ghost_set[i]);
+    if ((slot & ~1ULL) == signature) {
+      // re-referenced during its test period, the key turns into a hot one and becomes resident
+      admitted = ATOMIC_BCAS(&ghost_set[i], slot, 0);
+    }
+  }
+  if (!admitted) {
+    // insert as a cold ghost, the clock hand gives referenced ghosts a second chance
+    bool inserted = false;
+    for (int64_t step = 0; !inserted && step < 2 * GHOST_WAYS; ++step) {
+      const uint8_t hand = ATOMIC_AAF(&ghost_hands_[set_idx], 1) % GHOST_WAYS;
+      const uint64_t slot = ATOMIC_LOAD(&ghost_set[hand]);
+      if (0 == (slot & 1ULL)) {
+        inserted = ATOMIC_BCAS(&ghost_set[hand], slot, signature | 1ULL);
+      } else {
+        (void) ATOMIC_BCAS(&ghost_set[hand], slot, slot & ~1ULL);
+      }
+    }
+  }
+  return admitted;
+}
+
+uint64_t ObKVCacheAdmission::mix_hash_(const uint64_t hash)
+{
+  // fmix64 of murmurhash3, cache keys often hash to nearby values
+  uint64_t h = hash;
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+}//end namespace common
+}//end namespace oceanbase
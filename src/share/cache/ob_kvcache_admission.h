@@ -0,0 +1,100 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_CACHE_OB_KVCACHE_ADMISSION_H_
+#define OCEANBASE_CACHE_OB_KVCACHE_ADMISSION_H_
+
+#include "lib/atomic/ob_atomic.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+enum ObKVCacheAdmissionPolicy
+{
+  ADMISSION_NONE = 0,      // every put is indexed by the map
+  ADMISSION_TINY_LFU = 1,  // count-min sketch frequency estimator behind a windowed doorkeeper
+  ADMISSION_CLOCK_PRO = 2, // cold keys are kept as ghost entries during their test period
+  MAX_ADMISSION_POLICY
+};
+
+const char *get_kvcache_admission_policy_str(const ObKVCacheAdmissionPolicy policy);
+ObKVCacheAdmissionPolicy get_kvcache_admission_policy(const char *policy_str);
+// admission policy selected for the cache in ob_cache_name_define.h
+ObKVCacheAdmissionPolicy get_cache_admission_policy(const char *cache_name);
+
+/**
+ * Admission filter of one cache instance, consulted before a kvpair is put into ObKVCacheMap.
+ * The kvcache washes whole memblocks, there is no single victim to compare with, so both
+ * policies decide by the history of the incoming key only:
+ *   TINY_LFU: the first put of a key in the current window only sets the doorkeeper,
+ *             later puts bump a count-min sketch, the key is admitted once its estimated
+ *             frequency reaches ADMIT_FREQUENCY. Sketch is halved and doorkeeper cleared
+ *             every WINDOW_SIZE puts, so the history of a finished scan fades out.
+ *   CLOCK_PRO: a rejected key stays as a non-resident cold ghost in a set-associative clock,
+ *              a put hitting its ghost within the test period (before the hand reclaims it)
+ *              is admitted.
+ * A key rejected here is still returned to the caller through its memblock handle, it just
+ * won't be found by later gets. Memory is allocated on the first admit() call, all the
+ * counters are updated without locks and tolerate lost updates.
+ */
+class ObKVCacheAdmission
+{
+public:
+  ObKVCacheAdmission();
+  ~ObKVCacheAdmission();
+  void destroy();
+  // return true if the key with @hash should be put into the map
+  bool admit(const uint64_t tenant_id, const ObKVCacheAdmissionPolicy policy, const uint64_t hash);
+  inline ObKVCacheAdmissionPolicy get_policy() const { return ATOMIC_LOAD(&policy_); }
+  TO_STRING_KV(K_(state), K_(policy), K_(window_put_cnt), KP_(sketch), KP_(doorkeeper), KP_(ghosts));
+public:
+  static const int64_t ADMIT_FREQUENCY = 2;
+  static const int64_t SKETCH_DEPTH = 4;
+  static const int64_t SKETCH_WIDTH = 1 << 14;
+  static const uint8_t SKETCH_MAX_COUNT = 15;
+  static const int64_t DOORKEEPER_BITS = 1 << 17;
+  static const int64_t WINDOW_SIZE = 8 * SKETCH_WIDTH;
+  static const int64_t GHOST_WAYS = 8;
+  static const int64_t GHOST_SETS = 1 << 12;
+private:
+  enum State
+  {
+    STATE_UNINIT = 0,
+    STATE_INITING = 1,
+    STATE_READY = 2,
+  };
+  int init_(const uint64_t tenant_id, const ObKVCacheAdmissionPolicy policy);
+  bool tiny_lfu_admit_(const uint64_t hash);
+  bool clock_pro_admit_(const uint64_t hash);
+  void try_age_();
+  inline bool test_and_set_doorkeeper_(const uint64_t hash);
+  inline uint64_t sketch_pos_(const uint64_t hash, const int64_t row) const;
+  static inline uint64_t mix_hash_(const uint64_t hash);
+private:
+  int64_t state_;
+  ObKVCacheAdmissionPolicy policy_;
+  int64_t window_put_cnt_;
+  bool is_aging_;
+  uint8_t *sketch_;        // SKETCH_DEPTH rows of SKETCH_WIDTH saturated counters
+  uint64_t *doorkeeper_;   // DOORKEEPER_BITS bits
+  uint64_t *ghosts_;       // GHOST_SETS * GHOST_WAYS key signatures, lowest bit is the reference bit
+  uint8_t *ghost_hands_;   // clock hand of each ghost set
+  DISALLOW_COPY_AND_ASSIGN(ObKVCacheAdmission);
+};
+
+}//end namespace common
+}//end namespace oceanbase
+
+#endif //OCEANBASE_CACHE_OB_KVCACHE_ADMISSION_H_
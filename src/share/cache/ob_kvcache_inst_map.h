@@ -85,6 +85,7 @@ struct ObKVCacheInst
   bool is_block_cache_;
   int64_t ref_cnt_;
   ObTenantMBListHandle mb_list_handle_; // list of tenant mbs
+  ObKVCacheAdmission admission_;
   ObKVCacheInst()
     : cache_id_(0),
       tenant_id_(0),
@@ -93,7 +94,8 @@ struct ObKVCacheInst
       is_delete_(false),
       is_block_cache_(false),
       ref_cnt_(0),
-      mb_list_handle_() { MEMSET(handles_, 0, sizeof(handles_)); }
+      mb_list_handle_(),
+      admission_() { MEMSET(handles_, 0, sizeof(handles_)); }
   bool can_destroy() const ;
   void reset() {
     cache_id_ = 0;
@@ -104,6 +106,7 @@ struct ObKVCacheInst
     is_block_cache_ = false;
     ref_cnt_ = 0;
     mb_list_handle_.reset();
+    admission_.destroy();
     MEMSET(handles_, 0, sizeof(handles_));
   }
   bool is_valid() const { return ref_cnt_ > 0; }
@@ -115,6 +118,13 @@ struct ObKVCacheInst
   inline int64_t get_memory_limit_pct() { return status_.get_memory_limit_pct(); }
   common::ObDLink *get_mb_list() { return mb_list_handle_.get_head(); }
 
+  // admission related
+  inline bool admit(const uint64_t hash)
+  {
+    const ObKVCacheAdmissionPolicy policy = status_.get_admission_policy();
+    return ADMISSION_NONE == policy || admission_.admit(tenant_id_, policy, hash);
+  }
+
   TO_STRING_KV(K_(cache_id), K_(tenant_id), K_(is_delete), K_(status), K_(is_block_cache), K_(ref_cnt));
 };
 
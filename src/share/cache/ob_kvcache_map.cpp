@@ -176,6 +176,7 @@ int ObKVCacheMap::put(
   Node *iter = NULL;
   Node *prev = NULL;
   uint64_t hash_code = 0;
+  bool is_admitted = false;
 
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
@@ -186,7 +187,12 @@ int ObKVCacheMap::put(
     COMMON_LOG(WARN, "Invalid argument, ", KP(kvpair), KP(mb_handle), K(ret));
   } else if (OB_FAIL(key.hash(hash_code))) {
     COMMON_LOG(WARN, "Failed to get kvcache key hash", K(ret));
+  } else if (FALSE_IT(is_admitted = inst.admit(hash_code))) {
+  } else if (!is_admitted && !overwrite) {
+    // rejected kvpair is only referenced by the caller's memblock handle, and washed with its memblock
+    inst.status_.admission_reject_cnt_.inc();
   } else {
+    // a rejected overwrite still goes through the bucket, the old kvpair must not be hit anymore
     uint64_t bucket_pos = hash_code % bucket_num_;
     hash_code += inst.cache_id_;
 
@@ -214,8 +220,16 @@ int ObKVCacheMap::put(
             } else if (is_equal) {
               if (!overwrite) {
                 ret = OB_ENTRY_EXIST;
+                store_->de_handle_ref(iter->mb_handle_);
+              } else if (!is_admitted) {
+                (void) ATOMIC_SAF(&iter->mb_handle_->kv_cnt_, 1);
+                (void) ATOMIC_SAF(&iter->mb_handle_->get_cnt_, iter->get_cnt_);
+                (void) ATOMIC_SAF(&iter->inst_->status_.kv_cnt_, 1);
+                store_->de_handle_ref(iter->mb_handle_);
+                internal_map_erase(hazard_guard, prev, iter, bucket_ptr);
+              } else {
+                store_->de_handle_ref(iter->mb_handle_);
               }
-              store_->de_handle_ref(iter->mb_handle_);
               break;
             }
           }
@@ -224,7 +238,10 @@ int ObKVCacheMap::put(
           iter = iter->next_;
         }
       }
-      if (OB_SUCC(ret)) {
+      if (OB_FAIL(ret)) {
+      } else if (!is_admitted) {
+        inst.status_.admission_reject_cnt_.inc();
+      } else {
         Node *new_node = NULL;
         void *buf = NULL;
         if (NULL == (buf = inst.node_allocator_.alloc(sizeof(Node)))) {
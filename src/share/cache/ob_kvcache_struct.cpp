@@ -21,7 +21,9 @@ namespace common
  */
 ObKVCacheConfig::ObKVCacheConfig()
   : is_valid_(false),
-    priority_(0)
+    priority_(0),
+    mem_limit_pct_(100),
+    admission_policy_(ADMISSION_NONE)
 {
   MEMSET(cache_name_, 0, MAX_CACHE_NAME_LENGTH);
 }
@@ -31,6 +33,7 @@ void ObKVCacheConfig::reset()
   is_valid_ = false;
   priority_ = 0;
   mem_limit_pct_ = 100;
+  admission_policy_ = ADMISSION_NONE;
   MEMSET(cache_name_, 0, MAX_CACHE_NAME_LENGTH);
 }
 
@@ -63,6 +66,7 @@ void ObKVCacheStatus::reset()
   lfu_mb_cnt_ = 0;
   total_put_cnt_.reset();
   total_hit_cnt_.reset();
+  admission_reject_cnt_.reset();
   total_miss_cnt_ = 0;
   last_hit_cnt_ = 0;
   base_mb_score_ = 0;
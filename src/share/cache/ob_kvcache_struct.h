@@ -22,6 +22,7 @@
 #include "lib/resource/ob_resource_mgr.h"
 #include "lib/allocator/ob_lf_fifo_allocator.h"
 #include "lib/metrics/ob_counter.h"
+#include "share/cache/ob_kvcache_admission.h"
 
 namespace oceanbase
 {
@@ -178,6 +179,7 @@ public:
   bool is_valid_;
   int64_t priority_;
   int64_t mem_limit_pct_;
+  ObKVCacheAdmissionPolicy admission_policy_;
   char cache_name_[MAX_CACHE_NAME_LENGTH];
 };
 
@@ -193,13 +195,19 @@ public:
   {
     return ATOMIC_LOAD(&config_->mem_limit_pct_);
   }
+  inline ObKVCacheAdmissionPolicy get_admission_policy() const
+  {
+    return NULL == config_ ? ADMISSION_NONE : ATOMIC_LOAD(&config_->admission_policy_);
+  }
   void reset();
   TO_STRING_KV(KP_(config), K_(kv_cnt), K_(store_size), K_(map_size), K_(lru_mb_cnt),
-      K_(lfu_mb_cnt), K_(base_mb_score), K_(hold_size));
+      K_(lfu_mb_cnt), K_(base_mb_score), K_(hold_size), "admission_reject_cnt", admission_reject_cnt_.value());
 
   const ObKVCacheConfig *config_;
   ObPCNonAtomicCounter total_put_cnt_;
   ObPCNonAtomicCounter total_hit_cnt_;
+  // puts refused by the admission filter of the cache instance
+  ObPCNonAtomicCounter admission_reject_cnt_;
   int64_t kv_cnt_;
   int64_t store_size_;
   int64_t lru_mb_cnt_;
@@ -643,6 +643,12 @@ bool ObConfigPublishSchemaModeChecker::check(const ObConfigItem& t) const
          || 0 == t.case_compare(PUBLISH_SCHEMA_MODE_ASYNC);
 }
 
+bool ObConfigLocalDeviceIOEngineChecker::check(const ObConfigItem& t) const
+{
+  return 0 == t.case_compare("aio")
+         || 0 == t.case_compare("io_uring");
+}
+
 bool ObConfigMemoryLimitChecker::check(const ObConfigItem &t) const
 {
   bool is_valid = false;
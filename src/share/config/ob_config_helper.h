@@ -657,6 +657,17 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObConfigPublishSchemaModeChecker);
 };
 
+class ObConfigLocalDeviceIOEngineChecker
+  : public ObConfigChecker
+{
+public:
+  ObConfigLocalDeviceIOEngineChecker() {}
+  virtual ~ObConfigLocalDeviceIOEngineChecker() {}
+  bool check(const ObConfigItem& t) const;
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObConfigLocalDeviceIOEngineChecker);
+};
+
 // config item container
 class ObConfigStringKey
 {
@@ -8228,6 +8228,7 @@ def_table_schema(
   ('total_hit_cnt', 'int', 'false'),
   ('total_miss_cnt', 'int', 'false'),
   ('hold_size', 'int', 'false'),
+  ('admission_reject_cnt', 'int', 'false'),
   ],
   vtable_route_policy = 'distributed',
   partition_columns = ['svr_ip', 'svr_port'],
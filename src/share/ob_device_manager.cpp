@@ -17,6 +17,7 @@
 #include "share/config/ob_server_config.h"
 #include "share/io/ob_io_manager.h"
 #include "share/ob_local_device.h"
+#include "share/ob_local_uring_device.h"
 #include "deps/oblib/src/lib/thread/thread.h"
 #ifdef OB_BUILD_SHARED_STORAGE
 #include "storage/shared_storage/ob_local_cache_device.h"
@@ -139,8 +140,17 @@ int parse_storage_info(common::ObString storage_type_prefix, ObIODevice*& device
 
   if (storage_type_prefix.prefix_match(OB_LOCAL_PREFIX)) {
     device_type = OB_STORAGE_LOCAL;
-    mem = allocator.alloc(sizeof(share::ObLocalDevice));
-    if (NULL != mem) {new(mem)share::ObLocalDevice();}
+    if (0 == GCONF._local_device_io_engine.case_compare("io_uring")) {
+      mem = allocator.alloc(sizeof(share::ObLocalUringDevice));
+      if (NULL != mem) {
+        share::ObLocalUringDevice *uring_device = new(mem)share::ObLocalUringDevice();
+        uring_device->set_use_sqpoll(GCONF._io_uring_sqpoll);
+        OB_LOG(INFO, "use io_uring for local device", "use_sqpoll", uring_device->is_use_sqpoll());
+      }
+    } else {
+      mem = allocator.alloc(sizeof(share::ObLocalDevice));
+      if (NULL != mem) {new(mem)share::ObLocalDevice();}
+    }
 #ifdef OB_BUILD_SHARED_STORAGE
   } else if (storage_type_prefix.prefix_match(OB_LOCAL_CACHE_PREFIX)) {
     device_type = OB_STORAGE_LOCAL_CACHE;
@@ -210,15 +210,17 @@ public:
 public:
   static const int64_t RESERVED_BLOCK_INDEX = 2; // the first 2 blocks is used for super block
 
+protected:
+  int64_t get_block_file_offset(const common::ObIOFd &fd, const int64_t offset);
+
 private:
   int get_data_disk_used_percentage_(
       const int64_t required_size,
       int64_t &percent) const;
   int resize_block_file(const int64_t new_size);
-  int64_t get_block_file_offset(const common::ObIOFd &fd, const int64_t offset);
   int try_punch_hole(const int64_t block_index);
 
-private:
+protected:
   static const int64_t DEFUALT_PRE_ALLOCATED_IOCB_COUNT = 32 * 512;// 32 thread * max_io_depth
 
   bool is_inited_;
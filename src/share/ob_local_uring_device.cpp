@@ -0,0 +1,751 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "share/ob_local_uring_device.h"
+#include "share/ob_errno.h"
+#include "share/ob_io_device_helper.h"
+#include "lib/thread/thread.h"
+
+#ifdef OB_HAS_IO_URING
+// syscall numbers are shared by x86_64 and aarch64
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+#endif
+
+using namespace oceanbase::common;
+
+namespace oceanbase {
+namespace share {
+
+#ifdef OB_HAS_IO_URING
+static inline int sys_io_uring_setup(const uint32_t entries, struct io_uring_params *p)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+static inline int sys_io_uring_enter(const int fd, const uint32_t to_submit, const uint32_t min_complete,
+                                     const uint32_t flags, const void *arg, const size_t arg_size)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, arg, arg_size));
+}
+
+static inline int sys_io_uring_register(const int fd, const uint32_t opcode, const void *arg, const uint32_t nr_args)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+#endif
+
+/**
+ * ---------------------------------------------ObLocalUringIOContext---------------------------------------------------
+ */
+ObLocalUringIOContext::ObLocalUringIOContext()
+  : ring_fd_(-1),
+    sq_entries_(0),
+    cq_entries_(0),
+    use_sqpoll_(false),
+    fixed_file_state_(FIXED_FILE_UNREGISTERED),
+    fixed_file_fd_(-1),
+    ring_ptr_(MAP_FAILED),
+    ring_size_(0),
+    sqes_ptr_(MAP_FAILED),
+    sqes_size_(0),
+    sq_head_(nullptr),
+    sq_tail_(nullptr),
+    sq_mask_(nullptr),
+    sq_flags_(nullptr),
+    sq_array_(nullptr),
+    cq_head_(nullptr),
+    cq_tail_(nullptr),
+    cq_mask_(nullptr),
+    cqes_(nullptr),
+    sq_lock_(),
+    to_submit_(0),
+    is_flushing_(false),
+    failed_lock_(),
+    failed_events_(nullptr),
+    failed_cnt_(0),
+    submit_syscall_cnt_(0),
+    submit_sqe_cnt_(0)
+{
+}
+
+ObLocalUringIOContext::~ObLocalUringIOContext()
+{
+}
+
+/**
+ * ---------------------------------------------ObLocalUringIOEvents---------------------------------------------------
+ */
+ObLocalUringIOEvents::ObLocalUringIOEvents()
+  : complete_io_cnt_(0),
+    io_events_(nullptr)
+{
+}
+
+ObLocalUringIOEvents::~ObLocalUringIOEvents()
+{
+}
+
+int64_t ObLocalUringIOEvents::get_complete_cnt() const
+{
+  return complete_io_cnt_;
+}
+
+int ObLocalUringIOEvents::get_ith_ret_code(const int64_t i) const
+{
+  int ret_code = -1;
+  if (nullptr != io_events_ && i < complete_io_cnt_) {
+    const int64_t res = io_events_[i].res_;
+    if (res >= 0) {
+      ret_code = 0;
+    } else {
+      ret_code = static_cast<int32_t>(-res);
+    }
+  } else {
+    SHARE_LOG_RET(WARN, ret_code, "invalid member", KP(io_events_), K(i), K(complete_io_cnt_));
+  }
+  return ret_code;
+}
+
+int ObLocalUringIOEvents::get_ith_ret_bytes(const int64_t i) const
+{
+  int ret_val = 0;
+  if (nullptr != io_events_ && i < complete_io_cnt_) {
+    const int64_t res = io_events_[i].res_;
+    ret_val = res >= 0 ? static_cast<int32_t>(res) : 0;
+  }
+  return ret_val;
+}
+
+void *ObLocalUringIOEvents::get_ith_data(const int64_t i) const
+{
+  return (nullptr != io_events_ && i < complete_io_cnt_) ? io_events_[i].data_ : nullptr;
+}
+
+/**
+ * ---------------------------------------------ObLocalUringDevice---------------------------------------------------
+ */
+ObLocalUringDevice::ObLocalUringDevice()
+  : ObLocalDevice(),
+    use_sqpoll_(false),
+    uring_iocb_pool_()
+{
+}
+
+ObLocalUringDevice::~ObLocalUringDevice()
+{
+  destroy();
+}
+
+int ObLocalUringDevice::init(const common::ObIODOpts &opts)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(ObLocalDevice::init(opts))) {
+    SHARE_LOG(WARN, "Fail to init local device", K(ret));
+  } else if (OB_FAIL(uring_iocb_pool_.init(allocator_, DEFUALT_PRE_ALLOCATED_IOCB_COUNT))) {
+    SHARE_LOG(WARN, "Fail to init uring iocb pool", K(ret));
+  }
+  if (OB_FAIL(ret)) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObLocalUringDevice::destroy()
+{
+  uring_iocb_pool_.reset();
+  use_sqpoll_ = false;
+  ObLocalDevice::destroy();
+}
+
+int ObLocalUringDevice::io_setup(
+    uint32_t max_events,
+    common::ObIOContext *&io_context)
+{
+  int ret = OB_SUCCESS;
+  void *buf = nullptr;
+  ObLocalUringIOContext *uring_context = nullptr;
+
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "The ObLocalUringDevice has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(0 == max_events)) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "Invalid argument, ", K(ret), K(max_events));
+  } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObLocalUringIOContext)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    SHARE_LOG(WARN, "Fail to allocate memory, ", K(ret));
+  } else if (FALSE_IT(uring_context = new (buf) ObLocalUringIOContext())) {
+  } else if (OB_FAIL(setup_ring_(max_events, *uring_context))) {
+    SHARE_LOG(WARN, "Fail to setup io_uring, ", K(ret), K(max_events), K_(use_sqpoll));
+  } else {
+    io_context = uring_context;
+    SHARE_LOG(INFO, "Succeed to setup io_uring", K(ret), KPC(uring_context));
+  }
+
+  if (OB_FAIL(ret) && nullptr != uring_context) {
+    destroy_ring_(*uring_context);
+    uring_context->~ObLocalUringIOContext();
+    allocator_.free(buf);
+  }
+  return ret;
+}
+
+int ObLocalUringDevice::setup_ring_(const uint32_t max_events, ObLocalUringIOContext &ctx)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  struct io_uring_params params;
+  MEMSET(&params, 0, sizeof(params));
+  if (use_sqpoll_) {
+    params.flags |= IORING_SETUP_SQPOLL;
+    params.sq_thread_idle = SQPOLL_IDLE_MS;
+  }
+  if ((ctx.ring_fd_ = sys_io_uring_setup(max_events, &params)) < 0) {
+    ret = ObIODeviceLocalFileOp::convert_sys_errno();
+    SHARE_LOG(WARN, "Fail to setup io_uring, check kernel version and io_uring_disabled sysctl",
+        K(ret), K(max_events), K_(use_sqpoll), KERRMSG);
+  } else if (OB_UNLIKELY(0 == (params.features & IORING_FEAT_SINGLE_MMAP)
+                         || 0 == (params.features & IORING_FEAT_NODROP)
+                         || 0 == (params.features & IORING_FEAT_EXT_ARG))) {
+    ret = OB_NOT_SUPPORTED;
+    SHARE_LOG(WARN, "io_uring of current kernel is too old, need linux 5.11 or later",
+        K(ret), "features", params.features);
+  } else {
+    const int64_t sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    const int64_t cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    ctx.ring_size_ = MAX(sq_ring_size, cq_ring_size);
+    ctx.sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    if (MAP_FAILED == (ctx.ring_ptr_ = ::mmap(nullptr, ctx.ring_size_, PROT_READ | PROT_WRITE,
+                                              MAP_SHARED | MAP_POPULATE, ctx.ring_fd_, IORING_OFF_SQ_RING))) {
+      ret = ObIODeviceLocalFileOp::convert_sys_errno();
+      SHARE_LOG(WARN, "Fail to mmap io_uring ring", K(ret), K(ctx), KERRMSG);
+    } else if (MAP_FAILED == (ctx.sqes_ptr_ = ::mmap(nullptr, ctx.sqes_size_, PROT_READ | PROT_WRITE,
+                                                     MAP_SHARED | MAP_POPULATE, ctx.ring_fd_, IORING_OFF_SQES))) {
+      ret = ObIODeviceLocalFileOp::convert_sys_errno();
+      SHARE_LOG(WARN, "Fail to mmap io_uring sqes", K(ret), K(ctx), KERRMSG);
+    } else if (OB_ISNULL(ctx.failed_events_ = static_cast<ObLocalUringEvent *>(
+        allocator_.alloc(params.sq_entries * sizeof(ObLocalUringEvent))))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      SHARE_LOG(WARN, "Fail to allocate failed events", K(ret), "sq_entries", params.sq_entries);
+    } else {
+      char *ring = static_cast<char *>(ctx.ring_ptr_);
+      ctx.sq_entries_ = params.sq_entries;
+      ctx.cq_entries_ = params.cq_entries;
+      ctx.use_sqpoll_ = use_sqpoll_;
+      ctx.sq_head_ = reinterpret_cast<uint32_t *>(ring + params.sq_off.head);
+      ctx.sq_tail_ = reinterpret_cast<uint32_t *>(ring + params.sq_off.tail);
+      ctx.sq_mask_ = reinterpret_cast<uint32_t *>(ring + params.sq_off.ring_mask);
+      ctx.sq_flags_ = reinterpret_cast<uint32_t *>(ring + params.sq_off.flags);
+      ctx.sq_array_ = reinterpret_cast<uint32_t *>(ring + params.sq_off.array);
+      ctx.cq_head_ = reinterpret_cast<uint32_t *>(ring + params.cq_off.head);
+      ctx.cq_tail_ = reinterpret_cast<uint32_t *>(ring + params.cq_off.tail);
+      ctx.cq_mask_ = reinterpret_cast<uint32_t *>(ring + params.cq_off.ring_mask);
+      ctx.cqes_ = ring + params.cq_off.cqes;
+      // sqe slot i is always published at sq array index i
+      for (uint32_t i = 0; i < ctx.sq_entries_; ++i) {
+        ctx.sq_array_[i] = i;
+      }
+      // io channels are usually set up before the block file is opened, otherwise the block
+      // file is registered by the first io on it.
+      if (block_fd_ > 0) {
+        register_block_file_(ctx, block_fd_);
+      }
+    }
+  }
+#else
+  UNUSED(max_events);
+  UNUSED(ctx);
+  ret = OB_NOT_SUPPORTED;
+  SHARE_LOG(WARN, "io_uring is not supported by this build", K(ret));
+#endif
+  return ret;
+}
+
+void ObLocalUringDevice::register_block_file_(ObLocalUringIOContext &ctx, const int block_fd)
+{
+#ifdef OB_HAS_IO_URING
+  // the block file is the target of almost all data io, register it so that kernel need not
+  // to look up and ref the file for every request. only one thread registers, io issued
+  // during registering uses the normal fd.
+  if (ATOMIC_BCAS(&ctx.fixed_file_state_, ObLocalUringIOContext::FIXED_FILE_UNREGISTERED,
+                  ObLocalUringIOContext::FIXED_FILE_REGISTERING)) {
+    int sys_ret = 0;
+    if (0 != (sys_ret = sys_io_uring_register(ctx.ring_fd_, IORING_REGISTER_FILES, &block_fd, 1))) {
+      ATOMIC_STORE(&ctx.fixed_file_state_, ObLocalUringIOContext::FIXED_FILE_UNAVAILABLE);
+      SHARE_LOG(WARN, "Fail to register block file to io_uring, use normal fd", K(sys_ret), K(block_fd), KERRMSG);
+    } else {
+      ctx.fixed_file_fd_ = block_fd;
+      ATOMIC_STORE_REL(&ctx.fixed_file_state_, ObLocalUringIOContext::FIXED_FILE_REGISTERED);
+      SHARE_LOG(INFO, "Succeed to register block file to io_uring", K(block_fd), K(ctx));
+    }
+  }
+#else
+  UNUSED(ctx);
+  UNUSED(block_fd);
+#endif
+}
+
+void ObLocalUringDevice::try_register_block_file_(ObLocalUringIOContext &ctx, const ObLocalUringIOCB &iocb)
+{
+  if (iocb.is_block_file_
+      && ObLocalUringIOContext::FIXED_FILE_UNREGISTERED == ATOMIC_LOAD(&ctx.fixed_file_state_)) {
+    register_block_file_(ctx, iocb.fd_);
+  }
+}
+
+void ObLocalUringDevice::destroy_ring_(ObLocalUringIOContext &ctx)
+{
+  if (MAP_FAILED != ctx.sqes_ptr_) {
+    ::munmap(ctx.sqes_ptr_, ctx.sqes_size_);
+    ctx.sqes_ptr_ = MAP_FAILED;
+  }
+  if (MAP_FAILED != ctx.ring_ptr_) {
+    ::munmap(ctx.ring_ptr_, ctx.ring_size_);
+    ctx.ring_ptr_ = MAP_FAILED;
+  }
+  if (ctx.ring_fd_ >= 0) {
+    ::close(ctx.ring_fd_);
+    ctx.ring_fd_ = -1;
+  }
+  if (nullptr != ctx.failed_events_) {
+    allocator_.free(ctx.failed_events_);
+    ctx.failed_events_ = nullptr;
+  }
+  ctx.failed_cnt_ = 0;
+  ctx.fixed_file_state_ = ObLocalUringIOContext::FIXED_FILE_UNREGISTERED;
+  ctx.fixed_file_fd_ = -1;
+}
+
+int ObLocalUringDevice::io_destroy(common::ObIOContext *io_context)
+{
+  int ret = OB_SUCCESS;
+  ObLocalUringIOContext *uring_context = nullptr;
+
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "The ObLocalUringDevice has not been inited, ", K(ret));
+  } else if (OB_ISNULL(io_context)) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "Invalid argument, ", KP(io_context));
+  } else if (OB_UNLIKELY(ObIOContextType::IO_CONTEXT_TYPE_LOCAL_URING != io_context->get_type())) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "Invalid io context pointer", K(ret), KP(io_context),
+              "io_context_type", io_context->get_type());
+  } else {
+    uring_context = static_cast<ObLocalUringIOContext *>(io_context);
+    SHARE_LOG(INFO, "destroy io_uring", KPC(uring_context));
+    destroy_ring_(*uring_context);
+    uring_context->~ObLocalUringIOContext();
+    allocator_.free(io_context);
+  }
+  return ret;
+}
+
+int ObLocalUringDevice::prepare_io_(
+    const ObIOFd &fd,
+    const bool is_read,
+    void *buf,
+    size_t count,
+    int64_t offset,
+    ObIOCB *iocb,
+    void *callback)
+{
+  int ret = OB_SUCCESS;
+  ObLocalUringIOCB *uring_iocb = nullptr;
+
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "The ObLocalUringDevice has not been inited, ", K(ret));
+  } else if (OB_ISNULL(buf) || OB_ISNULL(iocb)) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "Invalid argument, ", K(ret), KP(buf), KP(iocb));
+  } else if (OB_UNLIKELY(ObIOCBType::IOCB_TYPE_LOCAL_URING != iocb->get_type())) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "Invalid iocb pointer", K(ret), KP(iocb), "iocb_type", iocb->get_type());
+  } else if (OB_UNLIKELY(fd.is_super_block())) {
+    ret = OB_NOT_SUPPORTED;
+    SHARE_LOG(WARN, "server entry doesn't support AIO", K(ret), K(fd));
+  } else {
+    uring_iocb = static_cast<ObLocalUringIOCB *>(iocb);
+    if (fd.is_block_file()) {
+      uring_iocb->fd_ = block_fd_;
+      uring_iocb->is_block_file_ = true;
+      uring_iocb->offset_ = get_block_file_offset(fd, offset);
+    } else {
+      uring_iocb->fd_ = static_cast<int32_t>(fd.second_id_);
+      uring_iocb->is_block_file_ = false;
+      uring_iocb->offset_ = offset;
+    }
+    uring_iocb->is_read_ = is_read;
+    uring_iocb->buf_ = buf;
+    uring_iocb->count_ = count;
+    uring_iocb->data_ = callback;
+  }
+  return ret;
+}
+
+int ObLocalUringDevice::io_prepare_pwrite(
+    const ObIOFd &fd,
+    void *buf,
+    size_t count,
+    int64_t offset,
+    ObIOCB *iocb,
+    void *callback)
+{
+  return prepare_io_(fd, false/*is_read*/, buf, count, offset, iocb, callback);
+}
+
+int ObLocalUringDevice::io_prepare_pread(
+    const ObIOFd &fd,
+    void *buf,
+    size_t count,
+    int64_t offset,
+    ObIOCB *iocb,
+    void *callback)
+{
+  return prepare_io_(fd, true/*is_read*/, buf, count, offset, iocb, callback);
+}
+
+int ObLocalUringDevice::push_sqe_(ObLocalUringIOContext &ctx, const ObLocalUringIOCB &iocb)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  ObSpinLockGuard guard(ctx.sq_lock_);
+  // only submitters write sq tail, and they are serialized by sq_lock_
+  const uint32_t tail = *ctx.sq_tail_;
+  const uint32_t head = ATOMIC_LOAD_ACQ(ctx.sq_head_);
+  if (OB_UNLIKELY(tail - head + ATOMIC_LOAD(&ctx.failed_cnt_) >= ctx.sq_entries_)) {
+    ret = OB_EAGAIN;
+    SHARE_LOG(DEBUG, "io_uring submission queue is full", K(ret), K(head), K(tail), K(ctx));
+  } else {
+    struct io_uring_sqe *sqe = static_cast<struct io_uring_sqe *>(ctx.sqes_ptr_) + (tail & *ctx.sq_mask_);
+    MEMSET(sqe, 0, sizeof(*sqe));
+    sqe->opcode = iocb.is_read_ ? IORING_OP_READ : IORING_OP_WRITE;
+    if (iocb.is_block_file_
+        && ObLocalUringIOContext::FIXED_FILE_REGISTERED == ATOMIC_LOAD_ACQ(&ctx.fixed_file_state_)
+        && iocb.fd_ == ctx.fixed_file_fd_) {
+      sqe->fd = 0; // index in registered files
+      sqe->flags |= IOSQE_FIXED_FILE;
+    } else {
+      sqe->fd = iocb.fd_;
+    }
+    sqe->addr = reinterpret_cast<uint64_t>(iocb.buf_);
+    sqe->len = static_cast<uint32_t>(iocb.count_);
+    sqe->off = static_cast<uint64_t>(iocb.offset_);
+    sqe->user_data = reinterpret_cast<uint64_t>(iocb.data_);
+    ATOMIC_STORE_REL(ctx.sq_tail_, tail + 1);
+    ATOMIC_INC(&ctx.to_submit_);
+  }
+#else
+  UNUSED(ctx);
+  UNUSED(iocb);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int ObLocalUringDevice::flush_sqes_(ObLocalUringIOContext &ctx)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  if (ctx.use_sqpoll_) {
+    // kernel thread consumes sq by itself, wake it up only if it has gone idle. keep to_submit_
+    // if the wakeup fails, next io_submit or io_getevents will retry it.
+    const int64_t to_submit = ATOMIC_LOAD(&ctx.to_submit_);
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (0 != (ATOMIC_LOAD(ctx.sq_flags_) & IORING_SQ_NEED_WAKEUP)
+        && sys_io_uring_enter(ctx.ring_fd_, 0, 0, IORING_ENTER_SQ_WAKEUP, nullptr, 0) < 0) {
+      ret = ObIODeviceLocalFileOp::convert_sys_errno();
+      SHARE_LOG(WARN, "Fail to wakeup io_uring sq thread", K(ret), K(ctx), KERRMSG);
+    } else if (to_submit > 0) {
+      ATOMIC_SAF(&ctx.to_submit_, to_submit);
+    }
+  } else {
+    // whoever wins is_flushing_ submits the sqes pushed by all concurrent submitters in one syscall,
+    // the others return directly. re-check after releasing the flag to not strand any sqe.
+    while (OB_SUCC(ret) && ATOMIC_LOAD(&ctx.to_submit_) > 0 && ATOMIC_BCAS(&ctx.is_flushing_, false, true)) {
+      int64_t to_submit = 0;
+      while (OB_SUCC(ret) && (to_submit = ATOMIC_LOAD(&ctx.to_submit_)) > 0) {
+        const int sys_ret = sys_io_uring_enter(ctx.ring_fd_, static_cast<uint32_t>(to_submit), 0, 0, nullptr, 0);
+        const int sys_errno = errno;
+        if (sys_ret > 0) {
+          ATOMIC_SAF(&ctx.to_submit_, sys_ret);
+          ATOMIC_INC(&ctx.submit_syscall_cnt_);
+          ATOMIC_FAA(&ctx.submit_sqe_cnt_, sys_ret);
+        } else if (sys_ret < 0 && EINTR == sys_errno) {
+          // retry
+        } else if (0 == sys_ret || EAGAIN == sys_errno || EBUSY == sys_errno) {
+          // kernel is short of resource or cq is overflowed, sqes stay in the ring and are
+          // retried by next io_submit or io_getevents.
+          ret = OB_EAGAIN;
+          SHARE_LOG(DEBUG, "io_uring is busy, retry later", K(ret), K(sys_ret), K(to_submit), K(ctx));
+        } else {
+          ret = ObIODeviceLocalFileOp::convert_sys_errno(sys_errno);
+          SHARE_LOG(WARN, "Fail to submit io_uring sqes, fail all pending sqes", K(ret), K(sys_ret),
+              K(to_submit), K(ctx), KERRNOMSG(sys_errno));
+          fail_pending_sqes_(ctx, sys_errno);
+        }
+      }
+      ATOMIC_STORE(&ctx.is_flushing_, false);
+    }
+  }
+#else
+  UNUSED(ctx);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+void ObLocalUringDevice::fail_pending_sqes_(ObLocalUringIOContext &ctx, const int sys_errno)
+{
+#ifdef OB_HAS_IO_URING
+  // only called by the flushing thread without SQPOLL, kernel consumes sq only in io_uring_enter
+  // of this thread, so the sqes between head and tail can be taken back safely.
+  ObSpinLockGuard guard(ctx.sq_lock_);
+  const uint32_t head = ATOMIC_LOAD_ACQ(ctx.sq_head_);
+  const uint32_t tail = *ctx.sq_tail_;
+  const struct io_uring_sqe *sqes = static_cast<const struct io_uring_sqe *>(ctx.sqes_ptr_);
+  {
+    ObSpinLockGuard failed_guard(ctx.failed_lock_);
+    for (uint32_t i = head; i != tail; ++i) {
+      // push_sqe_ reserves slots for failed events, the array never overflows
+      ObLocalUringEvent &event = ctx.failed_events_[ctx.failed_cnt_];
+      event.res_ = -sys_errno;
+      event.data_ = reinterpret_cast<void *>(sqes[i & *ctx.sq_mask_].user_data);
+      ATOMIC_INC(&ctx.failed_cnt_);
+    }
+  }
+  ATOMIC_STORE_REL(ctx.sq_tail_, head);
+  ATOMIC_STORE(&ctx.to_submit_, 0);
+#else
+  UNUSED(ctx);
+  UNUSED(sys_errno);
+#endif
+}
+
+int64_t ObLocalUringDevice::pop_failed_events_(ObLocalUringIOContext &ctx, ObLocalUringIOEvents &events)
+{
+  int64_t cnt = 0;
+  if (ATOMIC_LOAD(&ctx.failed_cnt_) > 0) {
+    ObSpinLockGuard guard(ctx.failed_lock_);
+    cnt = MIN(ctx.failed_cnt_, events.max_event_cnt_ - events.complete_io_cnt_);
+    if (cnt > 0) {
+      MEMCPY(events.io_events_ + events.complete_io_cnt_, ctx.failed_events_, cnt * sizeof(ObLocalUringEvent));
+      MEMMOVE(ctx.failed_events_, ctx.failed_events_ + cnt, (ctx.failed_cnt_ - cnt) * sizeof(ObLocalUringEvent));
+      ATOMIC_SAF(&ctx.failed_cnt_, cnt);
+      events.complete_io_cnt_ += cnt;
+    }
+  }
+  return cnt;
+}
+
+int ObLocalUringDevice::io_submit(
+    common::ObIOContext *io_context,
+    common::ObIOCB *iocb)
+{
+  int ret = OB_SUCCESS;
+  ObTimeGuard time_guard("LocalUringDevice", 5000); //5ms
+  ObLocalUringIOContext *uring_context = nullptr;
+  ObLocalUringIOCB *uring_iocb = nullptr;
+
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "The ObLocalUringDevice has not been inited, ", K(ret));
+  } else if (OB_ISNULL(io_context) || OB_ISNULL(iocb)) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "Invalid argument, ", KP(io_context), KP(iocb));
+  } else if (OB_UNLIKELY((ObIOContextType::IO_CONTEXT_TYPE_LOCAL_URING != io_context->get_type())
+                         || (ObIOCBType::IOCB_TYPE_LOCAL_URING != iocb->get_type()))) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "Invalid io_context or iocb pointer", K(ret), KP(io_context), "io_context_type",
+             io_context->get_type(), KP(iocb), "iocb_type", iocb->get_type());
+  } else if (FALSE_IT(uring_context = static_cast<ObLocalUringIOContext *>(io_context))) {
+  } else if (FALSE_IT(uring_iocb = static_cast<ObLocalUringIOCB *>(iocb))) {
+  } else if (FALSE_IT(try_register_block_file_(*uring_context, *uring_iocb))) {
+  } else if (OB_FAIL(push_sqe_(*uring_context, *uring_iocb))) {
+    SHARE_LOG(WARN, "Fail to push sqe, ", K(ret), KPC(uring_iocb));
+  } else {
+    time_guard.click("LocalUringDevice_push");
+    int tmp_ret = OB_SUCCESS;
+    // the sqe is in the ring now and its completion is reported by io_getevents, even if
+    // kernel refuses it, so a failed flush must not fail this request.
+    if (OB_SUCCESS != (tmp_ret = flush_sqes_(*uring_context))) {
+      SHARE_LOG(WARN, "Fail to flush sqes, ", K(tmp_ret), KPC(uring_context));
+    }
+    time_guard.click("LocalUringDevice_submit");
+  }
+  return ret;
+}
+
+int ObLocalUringDevice::io_cancel(
+    common::ObIOContext *io_context,
+    common::ObIOCB *iocb)
+{
+  UNUSED(io_context);
+  UNUSED(iocb);
+  // IORING_OP_ASYNC_CANCEL is asynchronous and cannot report the cancel result here,
+  // behave like a kernel without aio cancel support.
+  return OB_NOT_SUPPORTED;
+}
+
+int ObLocalUringDevice::io_getevents(
+    common::ObIOContext *io_context,
+    int64_t min_nr,
+    common::ObIOEvents *events,
+    struct timespec *timeout)
+{
+  int ret = OB_SUCCESS;
+  ObLocalUringIOContext *uring_context = nullptr;
+  ObLocalUringIOEvents *uring_events = nullptr;
+
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "The ObLocalUringDevice has not been inited, ", K(ret));
+  } else if (OB_ISNULL(io_context) || OB_ISNULL(events)) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "Invalid argument, ", KP(io_context), KP(events));
+  } else if (OB_UNLIKELY((ObIOContextType::IO_CONTEXT_TYPE_LOCAL_URING != io_context->get_type())
+                         || (ObIOEventsType::IO_EVENTS_TYPE_LOCAL_URING != events->get_type()))) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "Invalid io_context or io_events pointer", K(ret), KP(io_context),
+      "io_context_type", io_context->get_type(), KP(events), "io_events_type", events->get_type());
+  } else {
+#ifdef OB_HAS_IO_URING
+    uring_context = static_cast<ObLocalUringIOContext *>(io_context);
+    uring_events = static_cast<ObLocalUringIOEvents *>(events);
+    uring_events->complete_io_cnt_ = 0;
+    int tmp_ret = OB_SUCCESS;
+    // retry the sqes left by a busy kernel, they may be the ones we are waiting for
+    if (ATOMIC_LOAD(&uring_context->to_submit_) > 0
+        && OB_SUCCESS != (tmp_ret = flush_sqes_(*uring_context))) {
+      SHARE_LOG(DEBUG, "Fail to flush sqes, ", K(tmp_ret), KPC(uring_context));
+    }
+    const int64_t failed_cnt = pop_failed_events_(*uring_context, *uring_events);
+    uint32_t head = *uring_context->cq_head_;
+    uint32_t tail = ATOMIC_LOAD_ACQ(uring_context->cq_tail_);
+    if (head == tail && min_nr > failed_cnt) {
+      struct __kernel_timespec ts;
+      struct io_uring_getevents_arg arg;
+      MEMSET(&ts, 0, sizeof(ts));
+      MEMSET(&arg, 0, sizeof(arg));
+      if (nullptr != timeout) {
+        ts.tv_sec = timeout->tv_sec;
+        ts.tv_nsec = timeout->tv_nsec;
+        arg.ts = reinterpret_cast<uint64_t>(&ts);
+      }
+      oceanbase::lib::Thread::WaitGuard guard(oceanbase::lib::Thread::WAIT_FOR_IO_EVENT);
+      const int sys_ret = sys_io_uring_enter(uring_context->ring_fd_, 0, static_cast<uint32_t>(min_nr - failed_cnt),
+          IORING_ENTER_GETEVENTS | IORING_ENTER_EXT_ARG, &arg, sizeof(arg));
+      if (sys_ret < 0 && EINTR != errno && ETIME != errno) {
+        ret = ObIODeviceLocalFileOp::convert_sys_errno();
+        SHARE_LOG(WARN, "Fail to wait io_uring events, ", K(ret), K(sys_ret), KERRMSG);
+      } else {
+        tail = ATOMIC_LOAD_ACQ(uring_context->cq_tail_);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      // only the get_events thread of the channel consumes cq, no lock needed
+      const struct io_uring_cqe *cqes = static_cast<const struct io_uring_cqe *>(uring_context->cqes_);
+      const uint32_t mask = *uring_context->cq_mask_;
+      int64_t cnt = uring_events->complete_io_cnt_;
+      while (head != tail && cnt < uring_events->max_event_cnt_) {
+        const struct io_uring_cqe &cqe = cqes[head & mask];
+        uring_events->io_events_[cnt].res_ = cqe.res;
+        uring_events->io_events_[cnt].data_ = reinterpret_cast<void *>(cqe.user_data);
+        ++cnt;
+        ++head;
+      }
+      ATOMIC_STORE_REL(uring_context->cq_head_, head);
+      uring_events->complete_io_cnt_ = cnt;
+    }
+#else
+    UNUSED(min_nr);
+    UNUSED(timeout);
+    UNUSED(uring_context);
+    UNUSED(uring_events);
+    ret = OB_NOT_SUPPORTED;
+#endif
+  }
+  return ret;
+}
+
+common::ObIOCB *ObLocalUringDevice::alloc_iocb(const uint64_t tenant_id)
+{
+  UNUSED(tenant_id);
+  ObLocalUringIOCB *iocb = nullptr;
+  ObLocalUringIOCB *buf = nullptr;
+  if (OB_LIKELY(is_inited_)) {
+    if (NULL != (buf = uring_iocb_pool_.alloc())) {
+      iocb = new (buf) ObLocalUringIOCB();
+    }
+  }
+  return iocb;
+}
+
+common::ObIOEvents *ObLocalUringDevice::alloc_io_events(const uint32_t max_events)
+{
+  ObLocalUringIOEvents *io_events = nullptr;
+  char *buf = nullptr;
+  int64_t size = 0;
+
+  if (OB_LIKELY(is_inited_)) {
+    size = sizeof(ObLocalUringIOEvents) + max_events * sizeof(ObLocalUringEvent);
+    if (NULL != (buf = (char*) allocator_.alloc(size))) {
+      MEMSET(buf, 0, size);
+      io_events = new (buf) ObLocalUringIOEvents();
+      io_events->max_event_cnt_ = max_events;
+      io_events->complete_io_cnt_ = 0;
+      io_events->io_events_ = reinterpret_cast<ObLocalUringEvent *>(buf + sizeof(ObLocalUringIOEvents));
+    }
+  }
+  return io_events;
+}
+
+void ObLocalUringDevice::free_iocb(common::ObIOCB *iocb)
+{
+  int ret = OB_SUCCESS;
+  if (OB_LIKELY(is_inited_)) {
+    ObLocalUringIOCB *uring_iocb = nullptr;
+    if (OB_ISNULL(iocb)) {
+      ret = OB_INVALID_ARGUMENT;
+      SHARE_LOG(WARN, "iocb is null", K(ret));
+    } else if (OB_UNLIKELY(ObIOCBType::IOCB_TYPE_LOCAL_URING != iocb->get_type())) {
+      ret = OB_INVALID_ARGUMENT;
+      SHARE_LOG(WARN, "Invalid iocb pointer", K(ret), KP(iocb), "iocb_type", iocb->get_type());
+    } else {
+      uring_iocb = static_cast<ObLocalUringIOCB *>(iocb);
+      uring_iocb->~ObLocalUringIOCB();
+      uring_iocb_pool_.free(uring_iocb);
+    }
+  }
+}
+
+void ObLocalUringDevice::free_io_events(common::ObIOEvents *io_event)
+{
+  if (OB_LIKELY(is_inited_)) {
+    allocator_.free(io_event);
+  }
+}
+
+} /* namespace share */
+} /* namespace oceanbase */
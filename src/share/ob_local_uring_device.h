@@ -0,0 +1,215 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef SRC_SHARE_OB_LOCAL_URING_DEVICE_H_
+#define SRC_SHARE_OB_LOCAL_URING_DEVICE_H_
+
+#include <sys/uio.h>
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+#include "share/ob_local_device.h"
+#include "lib/lock/ob_spin_lock.h"
+
+// io_uring needs IORING_ENTER_EXT_ARG (linux 5.11) for timed waits, build without it
+// and every async interface of ObLocalUringDevice returns OB_NOT_SUPPORTED.
+#if defined(IORING_ENTER_EXT_ARG) && defined(IORING_FEAT_EXT_ARG)
+#define OB_HAS_IO_URING 1
+#endif
+
+namespace oceanbase {
+namespace share {
+
+class ObLocalUringDevice;
+
+class ObLocalUringIOCB : public common::ObIOCB
+{
+public:
+  ObLocalUringIOCB()
+    : fd_(-1), is_block_file_(false), is_read_(false), buf_(nullptr), count_(0), offset_(0), data_(nullptr)
+  {}
+  virtual ~ObLocalUringIOCB() {}
+  virtual ObIOCBType get_type() const override
+  {
+    return ObIOCBType::IOCB_TYPE_LOCAL_URING;
+  }
+  TO_STRING_KV(K_(fd), K_(is_block_file), K_(is_read), KP_(buf), K_(count), K_(offset), KP_(data));
+private:
+  friend class ObLocalUringDevice;
+  int fd_;
+  bool is_block_file_; // block file may be registered in the ring, use fixed file index
+  bool is_read_;
+  void *buf_;
+  size_t count_;
+  int64_t offset_;
+  void *data_;
+};
+
+/**
+ * one io_uring instance, shared by the io sender threads (producers of sqe) and
+ * exactly one get_events thread of ObAsyncIOChannel (consumer of cqe).
+ * sqe is filled under sq_lock_, io_uring_enter is issued by whichever submitter
+ * wins is_flushing_, so concurrent submitters are batched into one syscall.
+ * sqes which kernel refuses are taken back from the ring and reported by io_getevents
+ * as failed events, so no request is stranded.
+ */
+struct ObLocalUringEvent
+{
+  int64_t res_;
+  void *data_;
+};
+
+class ObLocalUringIOContext : public common::ObIOContext
+{
+public:
+  ObLocalUringIOContext();
+  virtual ~ObLocalUringIOContext();
+  virtual ObIOContextType get_type() const override
+  {
+    return ObIOContextType::IO_CONTEXT_TYPE_LOCAL_URING;
+  }
+  TO_STRING_KV(K_(ring_fd), K_(sq_entries), K_(cq_entries), K_(use_sqpoll), K_(fixed_file_state),
+      K_(fixed_file_fd), K_(to_submit), K_(is_flushing), K_(failed_cnt), K_(submit_syscall_cnt),
+      K_(submit_sqe_cnt));
+private:
+  enum FixedFileState
+  {
+    FIXED_FILE_UNREGISTERED = 0,
+    FIXED_FILE_REGISTERING = 1,
+    FIXED_FILE_REGISTERED = 2,   // fixed_file_fd_ is valid only in this state
+    FIXED_FILE_UNAVAILABLE = 3,
+  };
+private:
+  friend class ObLocalUringDevice;
+  int ring_fd_;
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+  bool use_sqpoll_;
+  int64_t fixed_file_state_;
+  int fixed_file_fd_;
+  void *ring_ptr_;
+  int64_t ring_size_;
+  void *sqes_ptr_;
+  int64_t sqes_size_;
+  uint32_t *sq_head_;
+  uint32_t *sq_tail_;
+  uint32_t *sq_mask_;
+  uint32_t *sq_flags_;
+  uint32_t *sq_array_;
+  uint32_t *cq_head_;
+  uint32_t *cq_tail_;
+  uint32_t *cq_mask_;
+  void *cqes_;
+  common::ObSpinLock sq_lock_;
+  int64_t to_submit_;
+  bool is_flushing_;
+  // sqes failed to submit, they take up the slots of sq until reported by io_getevents
+  common::ObSpinLock failed_lock_;
+  ObLocalUringEvent *failed_events_;
+  int64_t failed_cnt_;
+  int64_t submit_syscall_cnt_;
+  int64_t submit_sqe_cnt_;
+};
+
+class ObLocalUringIOEvents : public common::ObIOEvents
+{
+public:
+  ObLocalUringIOEvents();
+  virtual ~ObLocalUringIOEvents();
+  virtual ObIOEventsType get_type() const override
+  {
+    return ObIOEventsType::IO_EVENTS_TYPE_LOCAL_URING;
+  }
+  virtual int64_t get_complete_cnt() const override;
+  virtual int get_ith_ret_code(const int64_t i) const override;
+  virtual int get_ith_ret_bytes(const int64_t i) const override;
+  virtual void *get_ith_data(const int64_t i) const override;
+private:
+  friend class ObLocalUringDevice;
+  int64_t complete_io_cnt_;
+  ObLocalUringEvent *io_events_;
+};
+
+/**
+ * local device which replaces libaio with io_uring, selected by _local_device_io_engine at startup.
+ * sync io, file and block management interfaces are inherited from ObLocalDevice.
+ */
+class ObLocalUringDevice : public ObLocalDevice
+{
+public:
+  ObLocalUringDevice();
+  virtual ~ObLocalUringDevice();
+  virtual int init(const common::ObIODOpts &opts) override;
+  virtual void destroy() override;
+
+  //async io interfaces
+  virtual int io_setup(
+    uint32_t max_events,
+    common::ObIOContext *&io_context) override;
+  virtual int io_destroy(common::ObIOContext *io_context) override;
+  virtual int io_prepare_pwrite(
+    const common::ObIOFd &fd,
+    void *buf,
+    size_t count,
+    int64_t offset,
+    common::ObIOCB *iocb,
+    void *callback) override;
+  virtual int io_prepare_pread(
+    const common::ObIOFd &fd,
+    void *buf,
+    size_t count,
+    int64_t offset,
+    common::ObIOCB *iocb,
+    void *callback) override;
+  virtual int io_submit(
+    common::ObIOContext *io_context,
+    common::ObIOCB *iocb) override;
+  virtual int io_cancel(
+    common::ObIOContext *io_context,
+    common::ObIOCB *iocb) override;
+  virtual int io_getevents(
+    common::ObIOContext *io_context,
+    int64_t min_nr,
+    common::ObIOEvents *events,
+    struct timespec *timeout) override;
+  virtual common::ObIOCB *alloc_iocb(const uint64_t tenant_id) override;
+  virtual common::ObIOEvents *alloc_io_events(const uint32_t max_events) override;
+  virtual void free_iocb(common::ObIOCB *iocb) override;
+  virtual void free_io_events(common::ObIOEvents *io_event) override;
+
+  void set_use_sqpoll(const bool use_sqpoll) { use_sqpoll_ = use_sqpoll; }
+  bool is_use_sqpoll() const { return use_sqpoll_; }
+
+private:
+  int prepare_io_(const common::ObIOFd &fd, const bool is_read, void *buf, size_t count,
+                  int64_t offset, common::ObIOCB *iocb, void *callback);
+  int setup_ring_(const uint32_t max_events, ObLocalUringIOContext &ctx);
+  void destroy_ring_(ObLocalUringIOContext &ctx);
+  void register_block_file_(ObLocalUringIOContext &ctx, const int block_fd);
+  void try_register_block_file_(ObLocalUringIOContext &ctx, const ObLocalUringIOCB &iocb);
+  int push_sqe_(ObLocalUringIOContext &ctx, const ObLocalUringIOCB &iocb);
+  int flush_sqes_(ObLocalUringIOContext &ctx);
+  void fail_pending_sqes_(ObLocalUringIOContext &ctx, const int sys_errno);
+  int64_t pop_failed_events_(ObLocalUringIOContext &ctx, ObLocalUringIOEvents &events);
+
+private:
+  static const uint32_t SQPOLL_IDLE_MS = 10;
+  bool use_sqpoll_;
+  ObIOCBPool<ObLocalUringIOCB> uring_iocb_pool_;
+};
+
+} /* namespace share */
+} /* namespace oceanbase */
+
+#endif /* SRC_SHARE_OB_LOCAL_URING_DEVICE_H_ */
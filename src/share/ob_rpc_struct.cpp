@@ -11801,10 +11801,15 @@ int ObEstBlockArgElement::assign(const ObEstBlockArgElement &other)
   tenant_id_ = other.tenant_id_;
   tablet_id_ = other.tablet_id_;
   ls_id_ = other.ls_id_;
-  return column_group_ids_.assign(other.column_group_ids_);
+  if (OB_FAIL(column_group_ids_.assign(other.column_group_ids_))) {
+    LOG_WARN("failed to assign", K(ret));
+  } else if (OB_FAIL(ndv_sketch_column_ids_.assign(other.ndv_sketch_column_ids_))) {
+    LOG_WARN("failed to assign", K(ret));
+  }
+  return ret;
 }
 
-OB_SERIALIZE_MEMBER(ObEstBlockArgElement, tenant_id_, tablet_id_, ls_id_, column_group_ids_);
+OB_SERIALIZE_MEMBER(ObEstBlockArgElement, tenant_id_, tablet_id_, ls_id_, column_group_ids_, ndv_sketch_column_ids_);
 
 
 int ObEstBlockArg::assign(const ObEstBlockArg &other)
@@ -11821,16 +11826,22 @@ int ObEstBlockResElement::assign(const ObEstBlockResElement &other)
   micro_block_count_ = other.micro_block_count_;
   sstable_row_count_ = other.sstable_row_count_;
   memtable_row_count_ = other.memtable_row_count_;
+  ndv_sketch_row_count_ = other.ndv_sketch_row_count_;
   if (OB_FAIL(cg_macro_cnt_arr_.assign(other.cg_macro_cnt_arr_))) {
     LOG_WARN("failed to assign", K(ret));
   } else if (OB_FAIL(cg_micro_cnt_arr_.assign(other.cg_micro_cnt_arr_))) {
     LOG_WARN("failed to assign");
+  } else if (OB_FAIL(ndv_sketch_column_ids_.assign(other.ndv_sketch_column_ids_))) {
+    LOG_WARN("failed to assign", K(ret));
+  } else if (OB_FAIL(column_ndv_sketches_.assign(other.column_ndv_sketches_))) {
+    LOG_WARN("failed to assign", K(ret));
   }
   return ret;
 }
 
 OB_SERIALIZE_MEMBER(ObEstBlockResElement, macro_block_count_, micro_block_count_,
-    sstable_row_count_, memtable_row_count_, cg_macro_cnt_arr_, cg_micro_cnt_arr_);
+    sstable_row_count_, memtable_row_count_, cg_macro_cnt_arr_, cg_micro_cnt_arr_,
+    ndv_sketch_column_ids_, column_ndv_sketches_, ndv_sketch_row_count_);
 
 int ObEstBlockRes::assign(const ObEstBlockRes &other)
 {
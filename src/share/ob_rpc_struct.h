@@ -11867,14 +11867,15 @@ struct ObEstBlockArgElement
 {
   OB_UNIS_VERSION(1);
 public:
-  ObEstBlockArgElement() : tenant_id_(0), tablet_id_(), ls_id_(), column_group_ids_() {}
+  ObEstBlockArgElement() : tenant_id_(0), tablet_id_(), ls_id_(), column_group_ids_(), ndv_sketch_column_ids_() {}
   bool is_valid() const { return tenant_id_ > 0 && tablet_id_.is_valid() && ls_id_.is_valid(); }
   int assign(const ObEstBlockArgElement &other);
   uint64_t tenant_id_;
   ObTabletID tablet_id_;
   share::ObLSID ls_id_;
   common::ObSEArray<uint64_t, 4> column_group_ids_;
-  TO_STRING_KV(K_(tenant_id), K_(tablet_id), K_(ls_id), K_(column_group_ids));
+  common::ObSEArray<uint64_t, 4> ndv_sketch_column_ids_; // columns whose ndv sketch of major sstable is required
+  TO_STRING_KV(K_(tenant_id), K_(tablet_id), K_(ls_id), K_(column_group_ids), K_(ndv_sketch_column_ids));
 };
 
 struct ObEstBlockArg
@@ -11898,11 +11899,17 @@ public:
   int64_t memtable_row_count_;
   common::ObSEArray<int64_t, 4> cg_macro_cnt_arr_;
   common::ObSEArray<int64_t, 4> cg_micro_cnt_arr_;
+  // columns having ndv sketch in major sstable and their sketch registers in order
+  common::ObSEArray<uint64_t, 4> ndv_sketch_column_ids_;
+  common::ObArray<uint8_t> column_ndv_sketches_;
+  int64_t ndv_sketch_row_count_; // row count of the major sstable which the sketch comes from
   bool is_valid() const { return true; }
   int assign(const ObEstBlockResElement &other);
-  ObEstBlockResElement() : macro_block_count_(0), micro_block_count_(0), sstable_row_count_(0), memtable_row_count_(0) {}
+  ObEstBlockResElement() : macro_block_count_(0), micro_block_count_(0), sstable_row_count_(0), memtable_row_count_(0),
+                           ndv_sketch_column_ids_(), column_ndv_sketches_(), ndv_sketch_row_count_(0) {}
   TO_STRING_KV(K(macro_block_count_), K(micro_block_count_),
-      K(sstable_row_count_), K(memtable_row_count_), K(cg_macro_cnt_arr_), K(cg_micro_cnt_arr_));
+      K(sstable_row_count_), K(memtable_row_count_), K(cg_macro_cnt_arr_), K(cg_micro_cnt_arr_),
+      K(ndv_sketch_column_ids_), K(ndv_sketch_row_count_));
 };
 
 struct ObEstBlockRes
@@ -62,6 +62,7 @@ const uint64_t ObUpgradeChecker::UPGRADE_PATH[] = {
   CALC_VERSION(4UL, 3UL, 2UL, 1UL),  // 4.3.2.1
   CALC_VERSION(4UL, 3UL, 3UL, 0UL),  // 4.3.3.0
   CALC_VERSION(4UL, 3UL, 4UL, 0UL),  // 4.3.4.0
+  CALC_VERSION(4UL, 3UL, 5UL, 0UL),  // 4.3.5.0
 };
 
 int ObUpgradeChecker::get_data_version_by_cluster_version(
@@ -96,6 +97,7 @@ int ObUpgradeChecker::get_data_version_by_cluster_version(
     CONVERT_CLUSTER_VERSION_TO_DATA_VERSION(CLUSTER_VERSION_4_3_2_1, DATA_VERSION_4_3_2_1)
     CONVERT_CLUSTER_VERSION_TO_DATA_VERSION(CLUSTER_VERSION_4_3_3_0, DATA_VERSION_4_3_3_0)
     CONVERT_CLUSTER_VERSION_TO_DATA_VERSION(CLUSTER_VERSION_4_3_4_0, DATA_VERSION_4_3_4_0)
+    CONVERT_CLUSTER_VERSION_TO_DATA_VERSION(CLUSTER_VERSION_4_3_5_0, DATA_VERSION_4_3_5_0)
 
 #undef CONVERT_CLUSTER_VERSION_TO_DATA_VERSION
     default: {
@@ -676,6 +678,7 @@ int ObUpgradeProcesserSet::init(
     INIT_PROCESSOR_BY_VERSION(4, 3, 2, 1);
     INIT_PROCESSOR_BY_VERSION(4, 3, 3, 0);
     INIT_PROCESSOR_BY_VERSION(4, 3, 4, 0);
+    INIT_PROCESSOR_BY_VERSION(4, 3, 5, 0);
 #undef INIT_PROCESSOR_BY_VERSION
     inited_ = true;
   }
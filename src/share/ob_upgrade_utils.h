@@ -174,7 +174,7 @@ public:
              const uint64_t cluster_version,
              uint64_t &data_version);
 public:
-  static const int64_t DATA_VERSION_NUM = 21;
+  static const int64_t DATA_VERSION_NUM = 22;
   static const uint64_t UPGRADE_PATH[];
 };
 
@@ -275,6 +275,7 @@ private:
 };
 
 DEF_SIMPLE_UPGRARD_PROCESSER(4, 3, 4, 0)
+DEF_SIMPLE_UPGRARD_PROCESSER(4, 3, 5, 0)
 
 /* =========== special upgrade processor end   ============= */
 
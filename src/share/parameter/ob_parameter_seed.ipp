@@ -397,6 +397,10 @@ DEF_BOOL(_enable_decimal_int_type, OB_TENANT_PARAMETER, "True",
 DEF_BOOL(_ob_enable_dynamic_worker, OB_TENANT_PARAMETER, "True",
          "specifies whether worker count increases when all workers were in blocking.",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_worker_yield_on_blocking_wait, OB_TENANT_PARAMETER, "False",
+         "specifies whether a retryable request gives its worker back to the tenant queue "
+         "instead of blocking on waits longer than _stall_threshold_for_dynamic_worker.",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_optimizer_ads_time_limit, OB_TENANT_PARAMETER, "10", "[0, 300]",
         "the maximum optimizer dynamic sampling time limit. Range: [0, 300]",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -484,6 +488,10 @@ DEF_BOOL(_px_message_compression, OB_TENANT_PARAMETER, "True",
         "Enable DTL send message with compression"
         "Value: True: enable compression False: disable compression",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_vector_message_encoding, OB_TENANT_PARAMETER, "False",
+        "Enable lightweight column encodings of vectorized DTL messages sent to remote servers. "
+        "Value: True: enable encoding False: disable encoding",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_px_chunklist_count_ratio, OB_CLUSTER_PARAMETER, "1", "[1, 128]",
         "the ratio of the dtl buffer manager list. Range: [1, 128]",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -507,6 +515,19 @@ DEF_INT(_enable_hash_join_processor, OB_TENANT_PARAMETER, "7", "[1, 7]",
          "which path to process for hash join, default 7 to auto choose "
          "1: nest loop, 2: recursive, 4: in-memory",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_memtable_key_head, OB_TENANT_PARAMETER, "False",
+         "whether the btree nodes of new memtables keep normalized key heads to reduce full rowkey compares. "
+         "Value: True: enable; False: disable",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_hash_join_radix_build, OB_TENANT_PARAMETER, "True",
+         "build the shared hash table of parallel hash join by radix partitions when the dop is high, "
+         "takes effect on newly generated plans. "
+         "Value: True: enable; False: disable",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_hash_join_tagged_table, OB_TENANT_PARAMETER, "False",
+         "use the tagged open addressing hash table for the hash join of normalized integer keys. "
+         "Value: True: enable; False: disable",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_pushdown_storage_level, OB_TENANT_PARAMETER, "4", "[0, 4]",
         "the level of storage pushdown. Range: [0, 4] "
         "0: disabled, 1:blockscan, 2: blockscan & filter, 3: blockscan & filter & aggregate, 4: blockscan & filter & aggregate & group by",
@@ -577,9 +598,9 @@ DEF_TIME(tablet_meta_table_check_interval, OB_CLUSTER_PARAMETER, "30m", "[1m,)",
          "the time interval that observer compares tablet meta table with local ls replica info "
          "and make adjustments to ensure the correctness of tablet meta table. Range: [1m,+∞)",
          ObParameterAttr(Section::ROOT_SERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
-DEF_STR(min_observer_version, OB_CLUSTER_PARAMETER, "4.3.4.0", "the min observer version",
+DEF_STR(min_observer_version, OB_CLUSTER_PARAMETER, "4.3.5.0", "the min observer version",
         ObParameterAttr(Section::ROOT_SERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
-DEF_VERSION(compatible, OB_TENANT_PARAMETER, "4.3.4.0", "compatible version for persisted data",
+DEF_VERSION(compatible, OB_TENANT_PARAMETER, "4.3.5.0", "compatible version for persisted data",
             ObParameterAttr(Section::ROOT_SERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_BOOL(enable_ddl, OB_CLUSTER_PARAMETER, "True", "specifies whether DDL operation is turned on. "
          "Value:  True:turned on;  False: turned off",
@@ -715,6 +736,12 @@ DEF_INT(_log_writer_parallelism, OB_TENANT_PARAMETER, "3",
        "[1,8]",
        "the number of parallel log writer threads that can be used to write redo log entries to disk. ",
        ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_TIME(_log_writer_batch_latency_target, OB_TENANT_PARAMETER, "0ms",
+        "[0ms,100ms]",
+        "the expected latency of writing a batch of redo log entries, log writer sizes each batch adaptively "
+        "to keep the latency within it. The value 0ms means batching as many log entries as possible. "
+        "Range: [0ms,100ms]",
+        ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 
 DEF_TIME(_ls_gc_wait_readonly_tx_time, OB_TENANT_PARAMETER, "24h",
         "[0s,)",
@@ -902,6 +929,10 @@ DEF_INT(rpc_memory_limit_percentage, OB_TENANT_PARAMETER, "0", "[0,100]",
 DEF_CAP(_max_rpc_packet_size, OB_CLUSTER_PARAMETER, "2047MB", "[2M,2047M]",
         "the max rpc packet size when sending RPC or responding RPC results",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_CAP(_rpc_zerocopy_threshold, OB_CLUSTER_PARAMETER, "0M", "[0M,)",
+        "pkt-nio sends the writes no smaller than this size by MSG_ZEROCOPY to save the copy into kernel, "
+        "and 0 means zerocopy is disabled",
+        ObParameterAttr(Section::RPC, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_CAP(standby_fetch_log_bandwidth_limit, OB_CLUSTER_PARAMETER, "0MB", "[0M,10000G]",
         "the max bandwidth in bytes per second that can be occupied by the sum of the synchronizing log from primary cluster of all servers in the standby cluster",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -960,6 +991,11 @@ DEF_INT(bf_cache_miss_count_threshold, OB_CLUSTER_PARAMETER, "100", "[0,)", "bf
 DEF_INT(fuse_row_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "fuse row cache priority. Range:[1, )", ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(storage_meta_cache_priority, OB_CLUSTER_PARAMETER, "10", "[1,)", "storage meta cache priority. Range:[1, )",
         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_kvcache_admission, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether the kvcache filters the put of cold kvpairs by the admission policy "
+         "defined for each cache, e.g. tiny_lfu for user_block_cache. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 // shared storage local disk cache config
 DEF_INT(_ss_major_compaction_prewarm_level, OB_TENANT_PARAMETER, "0", "[0, 2]",
@@ -1009,6 +1045,16 @@ DEF_INT(sync_io_thread_count, OB_CLUSTER_PARAMETER, "0",
 DEF_INT(_io_callback_thread_count, OB_TENANT_PARAMETER, "0", "[0,64]",
         "The number of io callback threads. The default value is 0. Range: [0,64] in integer. If not specified, The number of threads is dynamically configured according to the memory size",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_local_device_io_engine, OB_CLUSTER_PARAMETER, "aio",
+        common::ObConfigLocalDeviceIOEngineChecker,
+        "the async io engine of local data device. "
+        "Values: aio: use libaio; io_uring: use io_uring, need linux 5.11 or later",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_BOOL(_io_uring_sqpoll, OB_CLUSTER_PARAMETER, "False",
+        "specifies whether io_uring of local data device uses a kernel thread to poll submission queue, "
+        "only takes effect when _local_device_io_engine is io_uring. "
+        "Value: True:turned on;  False: turned off",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 
 DEF_BOOL(_enable_parallel_minor_merge, OB_TENANT_PARAMETER, "True",
          "specifies whether enable parallel minor merge. "
@@ -1403,6 +1449,10 @@ DEF_STR_WITH_CHECKER(_ob_plan_cache_gc_strategy, OB_CLUSTER_PARAMETER, "REPORT",
 DEF_BOOL(_enable_plan_cache_mem_diagnosis, OB_CLUSTER_PARAMETER, "False",
          "wether turn plan cache ref count diagnosis on",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_plan_cache_lock_free_lookup, OB_CLUSTER_PARAMETER, "False",
+         "whether plan cache hits bypass the bucket latch of the cache key map "
+         "through the lock free lookup slots",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_STR(external_kms_info, OB_TENANT_PARAMETER, "",
         "when using the external key management center, "
@@ -1934,6 +1984,12 @@ DEF_BOOL(_enable_column_store, OB_TENANT_PARAMETER, "True",
 DEF_BOOL(_enable_skip_index, OB_TENANT_PARAMETER, "True",
         "enable the skip index in storage engine",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_column_ndv_sketch, OB_TENANT_PARAMETER, "False",
+        "enable building the column ndv sketch in major compaction and using it in gathering optimizer statistics",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_batch_result_encoding, OB_TENANT_PARAMETER, "False",
+        "enable encoding the text protocol result set of vectorized plans column by column per batch",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_STR_WITH_CHECKER(_ob_ddl_temp_file_compress_func, OB_TENANT_PARAMETER, "AUTO",
         common::ObConfigTempStoreFormatChecker,
         "specific compression in ObTempBlockStore."\
@@ -2123,6 +2179,10 @@ DEF_BOOL(_allow_skip_replay_redo_after_detete_tablet, OB_TENANT_PARAMETER, "FALS
          "allow skip replay invalid redo log after tablet delete transaction is committed."
          "The default value is FALSE. Value: TRUE means we allow skip replaying this invalid redo log, False means we do not alow such behavior.",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_replay_dependency_dispatch, OB_TENANT_PARAMETER, "False",
+         "whether a replay task blocked by retryable error can be bypassed by later tasks of other transactions "
+         "or tablets in the same replay queue. Value: True: enable; False: disable",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 //check os params
 DEF_BOOL(strict_check_os_params, OB_CLUSTER_PARAMETER, "False",
@@ -3077,6 +3077,11 @@ int ObTableSqlService::gen_table_dml(
                  || 0 == strcasecmp(table.get_compress_func_name(), all_compressor_name[ObCompressorType::ZLIB_LITE_COMPRESSOR]))) {
     ret = OB_NOT_SUPPORTED;
     LOG_WARN("zlib_lite_1.0 not support before 4.3", K(ret), K(table));
+  } else if (data_version < DATA_VERSION_4_3_5_0
+             && (table.get_compressor_type() == ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR
+                 || 0 == strcasecmp(table.get_compress_func_name(), all_compressor_name[ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR]))) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("zstd_dict_1.3.8 not support before 4.3.5", K(ret), K(table));
   } else if ((data_version < MOCK_DATA_VERSION_4_2_3_0 ||
                 (data_version >= DATA_VERSION_4_3_0_0 && data_version < DATA_VERSION_4_3_2_0))
              && OB_UNLIKELY(0 != table.get_auto_increment_cache_size())) {
@@ -3293,6 +3298,11 @@ int ObTableSqlService::gen_table_options_dml(
                  || 0 == strcasecmp(table.get_compress_func_name(), all_compressor_name[ObCompressorType::ZLIB_LITE_COMPRESSOR]))) {
     ret = OB_NOT_SUPPORTED;
     LOG_WARN("zlib_lite_1.0 not support before 4.3", K(ret), K(table));
+  } else if (data_version < DATA_VERSION_4_3_5_0
+             && (table.get_compressor_type() == ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR
+                 || 0 == strcasecmp(table.get_compress_func_name(), all_compressor_name[ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR]))) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("zstd_dict_1.3.8 not support before 4.3.5", K(ret), K(table));
   } else if (data_version < DATA_VERSION_4_2_1_2
              && OB_UNLIKELY(OB_DEFAULT_LOB_INROW_THRESHOLD != table.get_lob_inrow_threshold())) {
     ret = OB_NOT_SUPPORTED;
@@ -18,6 +18,7 @@
 #include "sql/optimizer/ob_storage_estimator.h"
 #include "pl/sys_package/ob_dbms_stats.h"
 #include "share/stat/ob_topk_hist_estimator.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 namespace oceanbase
 {
 namespace common
@@ -57,6 +58,7 @@ int ObBasicStatsEstimator::estimate(const ObOptStatGatherParam &param,
   ObArenaAllocator allocator("ObBasicStatsEst", OB_MALLOC_NORMAL_BLOCK_SIZE, param.tenant_id_);
   ObSqlString raw_sql;
   int64_t duration_time = -1;
+  ObSEArray<bool, 4> use_ndv_sketch;
   // Note that there are dependences between different kinds of statistics
   //            1. RowCount should be added at the first
   //            2. NumDistinct should be estimated before TopKHist
@@ -129,12 +131,19 @@ int ObBasicStatsEstimator::estimate(const ObOptStatGatherParam &param,
   }
   for (int64_t i = 0; OB_SUCC(ret) && i < column_params.count(); ++i) {
     const ObColumnStatParam *col_param = &column_params.at(i);
-    if (OB_FAIL(add_stat_item(ObStatMaxValue(col_param, src_col_stats.at(i)))) ||
-        OB_FAIL(add_stat_item(ObStatMinValue(col_param, src_col_stats.at(i)))) ||
-        OB_FAIL(add_stat_item(ObStatNumNull(col_param, src_tab_stat, src_col_stats.at(i)))) ||
-        OB_FAIL(add_stat_item(ObStatNumDistinct(col_param, src_col_stats.at(i), param.need_approx_ndv_))) ||
-        OB_FAIL(add_stat_item(ObStatAvgLen(col_param, src_col_stats.at(i)))) ||
-        OB_FAIL(add_stat_item(ObStatLlcBitmap(col_param, src_col_stats.at(i))))) {
+    bool can_use_ndv_sketch = false;
+    if (OB_FAIL(check_can_use_ndv_sketch(param, dst_opt_stats, col_param->column_id_, can_use_ndv_sketch))) {
+      LOG_WARN("failed to check can use ndv sketch", K(ret));
+    } else if (OB_FAIL(use_ndv_sketch.push_back(can_use_ndv_sketch))) {
+      LOG_WARN("failed to push back", K(ret));
+    } else if (OB_FAIL(add_stat_item(ObStatMaxValue(col_param, src_col_stats.at(i)))) ||
+               OB_FAIL(add_stat_item(ObStatMinValue(col_param, src_col_stats.at(i)))) ||
+               OB_FAIL(add_stat_item(ObStatNumNull(col_param, src_tab_stat, src_col_stats.at(i)))) ||
+               (!can_use_ndv_sketch &&
+                OB_FAIL(add_stat_item(ObStatNumDistinct(col_param, src_col_stats.at(i), param.need_approx_ndv_)))) ||
+               OB_FAIL(add_stat_item(ObStatAvgLen(col_param, src_col_stats.at(i)))) ||
+               (!can_use_ndv_sketch &&
+                OB_FAIL(add_stat_item(ObStatLlcBitmap(col_param, src_col_stats.at(i)))))) {
       LOG_WARN("failed to add statistic item", K(ret));
     } else {/*do nothing*/}
   }
@@ -145,6 +154,8 @@ int ObBasicStatsEstimator::estimate(const ObOptStatGatherParam &param,
       LOG_WARN("failed to pack raw sql", K(ret));
     } else if (OB_FAIL(do_estimate(param.tenant_id_, raw_sql.string(), true, src_opt_stat, dst_opt_stats))) {
       LOG_WARN("failed to evaluate basic stats", K(ret));
+    } else if (OB_FAIL(set_ndv_by_sketch(param, use_ndv_sketch, dst_opt_stats))) {
+      LOG_WARN("failed to set ndv by sketch", K(ret));
     } else if (OB_FAIL(refine_basic_stats(param, dst_opt_stats))) {
       LOG_WARN("failed to refine basic stats", K(ret));
     } else {
@@ -168,6 +179,7 @@ int ObBasicStatsEstimator::estimate_block_count(ObExecContext &ctx,
   ObSEArray<EstimateBlockRes, 4> estimate_result;
   hash::ObHashMap<int64_t, int64_t> first_part_idx_map;
   ObArray<uint64_t> column_group_ids;
+  ObArray<uint64_t> ndv_sketch_column_ids;
   uint64_t table_id = share::is_oracle_mapping_real_virtual_table(param.table_id_) ?
                               share::get_real_table_mappings_tid(param.table_id_) : param.table_id_;
   use_column_store = false;
@@ -184,8 +196,11 @@ int ObBasicStatsEstimator::estimate_block_count(ObExecContext &ctx,
     LOG_WARN("failed to generate first part idx map", K(ret));
   } else if (OB_FAIL(generate_column_group_ids(param, column_group_ids))) {
     LOG_WARN("failed to generate column group ids", K(ret), K(param));
+  } else if (OB_FAIL(generate_ndv_sketch_column_ids(param, ndv_sketch_column_ids))) {
+    LOG_WARN("failed to generate ndv sketch column ids", K(ret), K(param));
   } else if (OB_FAIL(do_estimate_block_count(ctx, param.tenant_id_, table_id, tablet_ids,
-                                             partition_ids, column_group_ids, estimate_result))) {
+                                             partition_ids, column_group_ids,
+                                             ndv_sketch_column_ids, estimate_result))) {
     LOG_WARN("failed to do estimate block count", K(ret));
   } else {
     int64_t total_sstable_row_cnt = 0;
@@ -211,6 +226,9 @@ int ObBasicStatsEstimator::estimate_block_count(ObExecContext &ctx,
         if (OB_FAIL(block_num_stat->cg_macro_cnt_arr_.assign(estimate_result.at(i).cg_macro_cnt_arr_)) ||
             OB_FAIL(block_num_stat->cg_micro_cnt_arr_.assign(estimate_result.at(i).cg_micro_cnt_arr_))) {
           LOG_WARN("failed to assign", K(ret));
+        } else if (!ndv_sketch_column_ids.empty() &&
+                   OB_FAIL(fill_ndv_sketch(ndv_sketch_column_ids, estimate_result.at(i), *block_num_stat))) {
+          LOG_WARN("failed to fill ndv sketch", K(ret));
         } else if (OB_FAIL(id_block_map.set_refactored(partition_id, block_num_stat))) {
           LOG_WARN("failed to set refactored", K(ret));
         } else if (param.part_level_ == share::schema::PARTITION_LEVEL_ONE) {
@@ -222,6 +240,10 @@ int ObBasicStatsEstimator::estimate_block_count(ObExecContext &ctx,
                                           block_num_stat->sstable_row_cnt_,
                                           block_num_stat->memtable_row_cnt_))) {
             LOG_WARN("faild to add", K(ret));
+          } else if (!ndv_sketch_column_ids.empty() &&
+                     OB_FAIL(global_tab_stat.add_ndv_sketches(block_num_stat->ndv_sketch_column_ids_,
+                                                              block_num_stat->column_ndv_sketches_))) {
+            LOG_WARN("faild to add ndv sketches", K(ret));
           }
         } else if (param.part_level_ == share::schema::PARTITION_LEVEL_TWO) {
           int64_t cur_part_id = -1;
@@ -237,6 +259,10 @@ int ObBasicStatsEstimator::estimate_block_count(ObExecContext &ctx,
                                             block_num_stat->sstable_row_cnt_,
                                             block_num_stat->memtable_row_cnt_))) {
               LOG_WARN("faild to add", K(ret));
+            } else if (!ndv_sketch_column_ids.empty() &&
+                       OB_FAIL(global_tab_stat.add_ndv_sketches(block_num_stat->ndv_sketch_column_ids_,
+                                                                block_num_stat->column_ndv_sketches_))) {
+              LOG_WARN("faild to add ndv sketches", K(ret));
             } else {
               int64_t idx = 0;
               if (OB_FAIL(first_part_idx_map.get_refactored(cur_part_id, idx))) {
@@ -253,6 +279,10 @@ int ObBasicStatsEstimator::estimate_block_count(ObExecContext &ctx,
                                                                   block_num_stat->sstable_row_cnt_,
                                                                   block_num_stat->memtable_row_cnt_))) {
                 LOG_WARN("faild to add", K(ret));
+              } else if (!ndv_sketch_column_ids.empty() &&
+                         OB_FAIL(first_part_tab_stats.at(idx).add_ndv_sketches(block_num_stat->ndv_sketch_column_ids_,
+                                                                               block_num_stat->column_ndv_sketches_))) {
+                LOG_WARN("faild to add ndv sketches", K(ret));
               }
             }
           }
@@ -285,7 +315,9 @@ int ObBasicStatsEstimator::estimate_block_count(ObExecContext &ctx,
           block_num_stat->sstable_row_cnt_ = global_tab_stat.get_sstable_row_cnt();
           block_num_stat->memtable_row_cnt_ = global_tab_stat.get_memtable_row_cnt();
           if (OB_FAIL(block_num_stat->cg_macro_cnt_arr_.assign(global_tab_stat.get_cg_macro_arr())) ||
-              OB_FAIL(block_num_stat->cg_micro_cnt_arr_.assign(global_tab_stat.get_cg_micro_arr()))) {
+              OB_FAIL(block_num_stat->cg_micro_cnt_arr_.assign(global_tab_stat.get_cg_micro_arr())) ||
+              OB_FAIL(block_num_stat->ndv_sketch_column_ids_.assign(global_tab_stat.get_ndv_sketch_column_ids())) ||
+              OB_FAIL(block_num_stat->column_ndv_sketches_.assign(global_tab_stat.get_column_ndv_sketches()))) {
             LOG_WARN("failed to assign", K(ret));
           } else if (OB_FAIL(id_block_map.set_refactored(-1, block_num_stat))) {
             LOG_WARN("failed to set refactored", K(ret));
@@ -305,7 +337,9 @@ int ObBasicStatsEstimator::estimate_block_count(ObExecContext &ctx,
                 block_num_stat->sstable_row_cnt_ = first_part_tab_stats.at(i).get_sstable_row_cnt();
                 block_num_stat->memtable_row_cnt_ = first_part_tab_stats.at(i).get_memtable_row_cnt();
                 if (OB_FAIL(block_num_stat->cg_macro_cnt_arr_.assign(first_part_tab_stats.at(i).get_cg_macro_arr())) ||
-                    OB_FAIL(block_num_stat->cg_micro_cnt_arr_.assign(first_part_tab_stats.at(i).get_cg_micro_arr()))) {
+                    OB_FAIL(block_num_stat->cg_micro_cnt_arr_.assign(first_part_tab_stats.at(i).get_cg_micro_arr())) ||
+                    OB_FAIL(block_num_stat->ndv_sketch_column_ids_.assign(first_part_tab_stats.at(i).get_ndv_sketch_column_ids())) ||
+                    OB_FAIL(block_num_stat->column_ndv_sketches_.assign(first_part_tab_stats.at(i).get_column_ndv_sketches()))) {
                   LOG_WARN("failed to assign", K(ret));
                 } else if (OB_FAIL(id_block_map.set_refactored(param.all_part_infos_.at(i).part_id_, block_num_stat))) {
                   LOG_WARN("failed to set refactored", K(ret));
@@ -326,6 +360,7 @@ int ObBasicStatsEstimator::do_estimate_block_count(ObExecContext &ctx,
                                                    const ObIArray<ObTabletID> &tablet_ids,
                                                    const ObIArray<ObObjectID> &partition_ids,
                                                    const ObIArray<uint64_t> &column_group_ids,
+                                                   const ObIArray<uint64_t> &ndv_sketch_column_ids,
                                                    ObIArray<EstimateBlockRes> &estimate_res)
 {
   int ret = OB_SUCCESS;
@@ -336,7 +371,8 @@ int ObBasicStatsEstimator::do_estimate_block_count(ObExecContext &ctx,
       LOG_WARN("failed to check status", K(ret));
       retry_cnt = MAX_RETRY_CNT;
     } else if (OB_FAIL(do_estimate_block_count_and_row_count(ctx, tenant_id, table_id, tablet_ids,
-                                                             partition_ids, column_group_ids, estimate_res))) {
+                                                             partition_ids, column_group_ids,
+                                                             ndv_sketch_column_ids, estimate_res))) {
       LOG_WARN("failed to do estimate block count and row count", K(ret));
       if (DAS_CTX(ctx).get_location_router().is_refresh_location_error(ret)) {
         DAS_CTX(ctx).get_location_router().refresh_location_cache_by_errno(true, ret);
@@ -356,6 +392,7 @@ int ObBasicStatsEstimator::do_estimate_block_count_and_row_count(ObExecContext &
                                                                  const ObIArray<ObTabletID> &tablet_ids,
                                                                  const ObIArray<ObObjectID> &partition_ids,
                                                                  const ObIArray<uint64_t> &column_group_ids,
+                                                                 const ObIArray<uint64_t> &ndv_sketch_column_ids,
                                                                  ObIArray<EstimateBlockRes> &estimate_res)
 {
   int ret = OB_SUCCESS;
@@ -409,6 +446,8 @@ int ObBasicStatsEstimator::do_estimate_block_count_and_row_count(ObExecContext &
                 arg_element.ls_id_ = candi_tablet_locs.at(j).get_partition_location().get_ls_id();
                 if (OB_FAIL(arg_element.column_group_ids_.assign(column_group_ids))) {
                   LOG_WARN("failed to assign", K(ret));
+                } else if (OB_FAIL(arg_element.ndv_sketch_column_ids_.assign(ndv_sketch_column_ids))) {
+                  LOG_WARN("failed to assign", K(ret));
                 } else if (OB_FAIL(arg.tablet_params_arg_.push_back(arg_element))) {
                   LOG_WARN("failed to push back", K(ret));
                 } else if (OB_FAIL(skip_idx_set.add_member(j))) {//record
@@ -440,6 +479,12 @@ int ObBasicStatsEstimator::do_estimate_block_count_and_row_count(ObExecContext &
                     LOG_WARN("failed to assign", K(ret));
                   } else if (OB_FAIL(estimate_res.at(idx).cg_micro_cnt_arr_.assign(result.tablet_params_res_.at(i).cg_micro_cnt_arr_))) {
                     LOG_WARN("failed to assign", K(ret));
+                  } else if (OB_FAIL(estimate_res.at(idx).ndv_sketch_column_ids_.assign(result.tablet_params_res_.at(i).ndv_sketch_column_ids_))) {
+                    LOG_WARN("failed to assign", K(ret));
+                  } else if (OB_FAIL(estimate_res.at(idx).column_ndv_sketches_.assign(result.tablet_params_res_.at(i).column_ndv_sketches_))) {
+                    LOG_WARN("failed to assign", K(ret));
+                  } else {
+                    estimate_res.at(idx).ndv_sketch_row_count_ = result.tablet_params_res_.at(i).ndv_sketch_row_count_;
                   }
                 }
               }
@@ -1358,6 +1403,126 @@ int ObBasicStatsEstimator::generate_column_group_ids(const ObTableStatParam &par
   return ret;
 }
 
+int ObBasicStatsEstimator::generate_ndv_sketch_column_ids(const ObTableStatParam &param,
+                                                          ObIArray<uint64_t> &ndv_sketch_column_ids)
+{
+  int ret = OB_SUCCESS;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(param.tenant_id_));
+  // the ndv sketch built by major compaction is a synopsis of approx ndv
+  if (!param.need_approx_ndv_ || !tenant_config.is_valid() || !tenant_config->_enable_column_ndv_sketch) {
+    //do nothing
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < param.column_params_.count(); ++i) {
+      if (!param.column_params_.at(i).need_basic_stat()) {
+        //do nothing
+      } else if (OB_FAIL(ndv_sketch_column_ids.push_back(param.column_params_.at(i).column_id_))) {
+        LOG_WARN("failed to push back", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObBasicStatsEstimator::fill_ndv_sketch(const ObIArray<uint64_t> &ndv_sketch_column_ids,
+                                           const EstimateBlockRes &estimate_res,
+                                           BlockNumStat &block_num_stat)
+{
+  int ret = OB_SUCCESS;
+  const int64_t MAX_SKETCH_STALE_PERCENT = 10;
+  const int64_t total_row_cnt = estimate_res.sstable_row_count_ + estimate_res.memtable_row_count_;
+  const int64_t major_row_cnt = estimate_res.ndv_sketch_row_count_;
+  if (0 == total_row_cnt) {
+    // empty partition contributes nothing to the union
+    if (OB_FAIL(block_num_stat.ndv_sketch_column_ids_.assign(ndv_sketch_column_ids))) {
+      LOG_WARN("failed to assign", K(ret));
+    } else if (OB_FAIL(block_num_stat.column_ndv_sketches_.prepare_allocate(
+                          ndv_sketch_column_ids.count() * ObOptColumnStat::NUM_LLC_BUCKET))) {
+      LOG_WARN("failed to prepare allocate", K(ret));
+    } else {
+      for (int64_t i = 0; i < block_num_stat.column_ndv_sketches_.count(); ++i) {
+        block_num_stat.column_ndv_sketches_.at(i) = 0;
+      }
+    }
+  } else if (estimate_res.ndv_sketch_column_ids_.empty() ||
+             OB_UNLIKELY(estimate_res.column_ndv_sketches_.count() !=
+                         estimate_res.ndv_sketch_column_ids_.count() * ObOptColumnStat::NUM_LLC_BUCKET)) {
+    //do nothing
+  } else if (total_row_cnt - major_row_cnt > major_row_cnt * MAX_SKETCH_STALE_PERCENT / 100) {
+    // rows of minor sstables and memtables are not in the sketch, it is too stale to use
+    LOG_TRACE("ndv sketch is stale", K(estimate_res));
+  } else if (OB_FAIL(block_num_stat.ndv_sketch_column_ids_.assign(estimate_res.ndv_sketch_column_ids_))) {
+    LOG_WARN("failed to assign", K(ret));
+  } else if (OB_FAIL(block_num_stat.column_ndv_sketches_.assign(estimate_res.column_ndv_sketches_))) {
+    LOG_WARN("failed to assign", K(ret));
+  }
+  return ret;
+}
+
+int ObBasicStatsEstimator::check_can_use_ndv_sketch(const ObOptStatGatherParam &param,
+                                                    const ObIArray<ObOptStat> &dst_opt_stats,
+                                                    const uint64_t column_id,
+                                                    bool &can_use)
+{
+  int ret = OB_SUCCESS;
+  can_use = param.need_approx_ndv_ && NULL != param.partition_id_block_map_;
+  for (int64_t i = 0; OB_SUCC(ret) && can_use && i < dst_opt_stats.count(); ++i) {
+    BlockNumStat *block_num_stat = NULL;
+    if (OB_ISNULL(dst_opt_stats.at(i).table_stat_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("get unexpected null", K(ret));
+    } else if (OB_FAIL(param.partition_id_block_map_->get_refactored(
+                          dst_opt_stats.at(i).table_stat_->get_partition_id(), block_num_stat))) {
+      if (OB_HASH_NOT_EXIST == ret) {
+        ret = OB_SUCCESS;
+        can_use = false;
+      } else {
+        LOG_WARN("failed to get refactored", K(ret));
+      }
+    } else {
+      can_use = NULL != block_num_stat && NULL != block_num_stat->get_ndv_sketch(column_id);
+    }
+  }
+  return ret;
+}
+
+int ObBasicStatsEstimator::set_ndv_by_sketch(const ObOptStatGatherParam &param,
+                                             const ObIArray<bool> &use_ndv_sketch,
+                                             ObIArray<ObOptStat> &dst_opt_stats)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < dst_opt_stats.count(); ++i) {
+    ObOptStat &opt_stat = dst_opt_stats.at(i);
+    BlockNumStat *block_num_stat = NULL;
+    for (int64_t j = 0; OB_SUCC(ret) && j < use_ndv_sketch.count(); ++j) {
+      const char *sketch = NULL;
+      ObOptColumnStat *col_stat = NULL;
+      if (!use_ndv_sketch.at(j)) {
+        //do nothing
+      } else if (OB_ISNULL(opt_stat.table_stat_) || OB_ISNULL(param.partition_id_block_map_) ||
+                 OB_UNLIKELY(j >= opt_stat.column_stats_.count() || j >= param.column_params_.count()) ||
+                 OB_ISNULL(col_stat = opt_stat.column_stats_.at(j))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("get unexpected error", K(ret), K(j), K(opt_stat.column_stats_.count()));
+      } else if (NULL == block_num_stat &&
+                 OB_FAIL(param.partition_id_block_map_->get_refactored(
+                            opt_stat.table_stat_->get_partition_id(), block_num_stat))) {
+        LOG_WARN("failed to get refactored", K(ret));
+      } else if (OB_ISNULL(block_num_stat) ||
+                 OB_ISNULL(sketch = block_num_stat->get_ndv_sketch(param.column_params_.at(j).column_id_)) ||
+                 OB_ISNULL(col_stat->get_llc_bitmap()) ||
+                 OB_UNLIKELY(col_stat->get_llc_bitmap_size() < ObOptColumnStat::NUM_LLC_BUCKET)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("get unexpected error", K(ret), KPC(block_num_stat), KPC(col_stat));
+      } else {
+        MEMCPY(col_stat->get_llc_bitmap(), sketch, ObOptColumnStat::NUM_LLC_BUCKET);
+        col_stat->set_llc_bitmap_size(ObOptColumnStat::NUM_LLC_BUCKET);
+        col_stat->set_num_distinct(ObGlobalNdvEval::get_ndv_from_llc(col_stat->get_llc_bitmap()));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObBasicStatsEstimator::check_can_use_column_store_and_split_part_gather(const int64_t sstable_row_cnt,
                                                                             const int64_t memtable_row_cnt,
                                                                             const int64_t cg_cnt,
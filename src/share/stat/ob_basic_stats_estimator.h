@@ -31,7 +31,10 @@ struct EstimateBlockRes
     sstable_row_count_(0),
     memtable_row_count_(0),
     cg_macro_cnt_arr_(),
-    cg_micro_cnt_arr_()
+    cg_micro_cnt_arr_(),
+    ndv_sketch_column_ids_(),
+    column_ndv_sketches_(),
+    ndv_sketch_row_count_(0)
   {}
   ObObjectID part_id_;
   int64_t macro_block_count_;
@@ -40,13 +43,18 @@ struct EstimateBlockRes
   int64_t memtable_row_count_;
   ObArray<int64_t> cg_macro_cnt_arr_;
   ObArray<int64_t> cg_micro_cnt_arr_;
+  ObArray<uint64_t> ndv_sketch_column_ids_;
+  ObArray<uint8_t> column_ndv_sketches_;
+  int64_t ndv_sketch_row_count_;
   TO_STRING_KV(K(part_id_),
                K(macro_block_count_),
                K(micro_block_count_),
                K(sstable_row_count_),
                K(memtable_row_count_),
                K(cg_macro_cnt_arr_),
-               K(cg_micro_cnt_arr_));
+               K(cg_micro_cnt_arr_),
+               K(ndv_sketch_column_ids_),
+               K(ndv_sketch_row_count_));
 };
 
 class ObBasicStatsEstimator : public ObStatsEstimator
@@ -111,6 +119,7 @@ public:
                                      const ObIArray<ObTabletID> &tablet_ids,
                                      const ObIArray<ObObjectID> &partition_ids,
                                      const ObIArray<uint64_t> &column_group_ids,
+                                     const ObIArray<uint64_t> &ndv_sketch_column_ids,
                                      ObIArray<EstimateBlockRes> &estimate_res);
 
   static int do_estimate_block_count_and_row_count(ObExecContext &ctx,
@@ -119,6 +128,7 @@ public:
                                                    const ObIArray<ObTabletID> &tablet_ids,
                                                    const ObIArray<ObObjectID> &partition_ids,
                                                    const ObIArray<uint64_t> &column_group_ids,
+                                                   const ObIArray<uint64_t> &ndv_sketch_column_ids,
                                                    ObIArray<EstimateBlockRes> &estimate_res);
 
   static int get_tablet_locations(ObExecContext &ctx,
@@ -178,6 +188,22 @@ private:
   static int generate_column_group_ids(const ObTableStatParam &param,
                                        ObIArray<uint64_t> &column_group_ids);
 
+  static int generate_ndv_sketch_column_ids(const ObTableStatParam &param,
+                                            ObIArray<uint64_t> &ndv_sketch_column_ids);
+
+  static int fill_ndv_sketch(const ObIArray<uint64_t> &ndv_sketch_column_ids,
+                             const EstimateBlockRes &estimate_res,
+                             BlockNumStat &block_num_stat);
+
+  static int check_can_use_ndv_sketch(const ObOptStatGatherParam &param,
+                                      const ObIArray<ObOptStat> &dst_opt_stats,
+                                      const uint64_t column_id,
+                                      bool &can_use);
+
+  int set_ndv_by_sketch(const ObOptStatGatherParam &param,
+                        const ObIArray<bool> &use_ndv_sketch,
+                        ObIArray<ObOptStat> &dst_opt_stats);
+
   static int check_can_use_column_store_and_split_part_gather(const int64_t sstable_row_cnt,
                                                               const int64_t memtable_row_cnt,
                                                               const int64_t cg_cnt,
@@ -154,10 +154,25 @@ struct BlockNumStat
     cg_macro_cnt_arr_(),
     cg_micro_cnt_arr_(),
     sstable_row_cnt_(0),
-    memtable_row_cnt_(0)
+    memtable_row_cnt_(0),
+    ndv_sketch_column_ids_(),
+    column_ndv_sketches_()
   {
     cg_macro_cnt_arr_.set_attr(ObMemAttr(MTL_ID(), "BlockNumStat"));
     cg_micro_cnt_arr_.set_attr(ObMemAttr(MTL_ID(), "BlockNumStat"));
+    ndv_sketch_column_ids_.set_attr(ObMemAttr(MTL_ID(), "BlockNumStat"));
+    column_ndv_sketches_.set_attr(ObMemAttr(MTL_ID(), "BlockNumStat"));
+  }
+  // return the llc bitmap built by compaction, NULL if the column has no usable sketch
+  const char *get_ndv_sketch(const uint64_t column_id) const
+  {
+    const char *sketch = NULL;
+    for (int64_t i = 0; NULL == sketch && i < ndv_sketch_column_ids_.count(); ++i) {
+      if (column_id == ndv_sketch_column_ids_.at(i)) {
+        sketch = reinterpret_cast<const char *>(&column_ndv_sketches_.at(i * ObOptColumnStat::NUM_LLC_BUCKET));
+      }
+    }
+    return sketch;
   }
   int64_t tab_macro_cnt_;
   int64_t tab_micro_cnt_;
@@ -165,12 +180,15 @@ struct BlockNumStat
   ObSEArray<int64_t, 1, common::ModulePageAllocator, true> cg_micro_cnt_arr_;
   int64_t sstable_row_cnt_;
   int64_t memtable_row_cnt_;
+  ObSEArray<uint64_t, 1, common::ModulePageAllocator, true> ndv_sketch_column_ids_;
+  ObSEArray<uint8_t, 1, common::ModulePageAllocator, true> column_ndv_sketches_;
   TO_STRING_KV(K(tab_macro_cnt_),
                K(tab_micro_cnt_),
                K(cg_macro_cnt_arr_),
                K(cg_micro_cnt_arr_),
                K(sstable_row_cnt_),
-               K(memtable_row_cnt_));
+               K(memtable_row_cnt_),
+               K(ndv_sketch_column_ids_));
 };
 
 //TODO@jiangxiu.wt: improve the expression of PartInfo, use the map is better.
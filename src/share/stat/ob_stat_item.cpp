@@ -555,6 +555,49 @@ int ObGlobalTableStat::add(int64_t rc, int64_t rs, int64_t ds, int64_t mac, int6
   return ret;
 }
 
+int ObGlobalTableStat::add_ndv_sketches(const ObIArray<uint64_t> &column_ids,
+                                        const ObIArray<uint8_t> &sketches)
+{
+  int ret = OB_SUCCESS;
+  const int64_t num_llc_bucket = ObOptColumnStat::NUM_LLC_BUCKET;
+  if (OB_UNLIKELY(sketches.count() != column_ids.count() * num_llc_bucket)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("get invalid ndv sketches", K(ret), K(column_ids), K(sketches.count()));
+  } else if (0 == ndv_sketch_part_cnt_++) {
+    if (OB_FAIL(ndv_sketch_column_ids_.assign(column_ids))) {
+      LOG_WARN("failed to assign", K(ret));
+    } else if (OB_FAIL(column_ndv_sketches_.assign(sketches))) {
+      LOG_WARN("failed to assign", K(ret));
+    }
+  } else {
+    int64_t valid_cnt = 0;
+    for (int64_t i = 0; i < ndv_sketch_column_ids_.count(); ++i) {
+      int64_t idx = -1;
+      for (int64_t j = 0; idx < 0 && j < column_ids.count(); ++j) {
+        if (column_ids.at(j) == ndv_sketch_column_ids_.at(i)) {
+          idx = j;
+        }
+      }
+      if (idx >= 0) {
+        // keep the columns in place, registers of the same column are merged by max
+        ndv_sketch_column_ids_.at(valid_cnt) = ndv_sketch_column_ids_.at(i);
+        for (int64_t k = 0; k < num_llc_bucket; ++k) {
+          column_ndv_sketches_.at(valid_cnt * num_llc_bucket + k) =
+            MAX(column_ndv_sketches_.at(i * num_llc_bucket + k), sketches.at(idx * num_llc_bucket + k));
+        }
+        ++valid_cnt;
+      }
+    }
+    while (OB_SUCC(ret) && ndv_sketch_column_ids_.count() > valid_cnt) {
+      ndv_sketch_column_ids_.pop_back();
+    }
+    while (OB_SUCC(ret) && column_ndv_sketches_.count() > valid_cnt * num_llc_bucket) {
+      column_ndv_sketches_.pop_back();
+    }
+  }
+  return ret;
+}
+
 int64_t ObGlobalTableStat::get_row_count() const
 {
   return row_count_;
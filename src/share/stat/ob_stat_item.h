@@ -306,13 +306,16 @@ public:
     : row_count_(0), row_size_(0), data_size_(0),
       macro_block_count_(0), micro_block_count_(0), part_cnt_(0), last_analyzed_(0),
       cg_macro_cnt_arr_(), cg_micro_cnt_arr_(), stat_locked_(false), stale_stats_(false),
-      sstable_row_cnt_(0), memtable_row_cnt_(0)
+      sstable_row_cnt_(0), memtable_row_cnt_(0), ndv_sketch_part_cnt_(0),
+      ndv_sketch_column_ids_(), column_ndv_sketches_()
   {}
 
   void add(int64_t rc, int64_t rs, int64_t ds, int64_t mac, int64_t mic);
   int add(int64_t rc, int64_t rs, int64_t ds, int64_t mac, int64_t mic,
           ObIArray<int64_t> &cg_macro_arr, ObIArray<int64_t> &cg_micro_arr,
           int64_t scnt, int64_t mcnt);
+  // union the ndv sketches of partitions, only the columns having sketch in all partitions are kept
+  int add_ndv_sketches(const ObIArray<uint64_t> &column_ids, const ObIArray<uint8_t> &sketches);
 
   int64_t get_row_count() const;
   int64_t get_avg_row_size() const;
@@ -329,6 +332,8 @@ public:
   bool get_stale_stats() const { return stale_stats_; }
   int64_t get_sstable_row_cnt() const { return sstable_row_cnt_; }
   int64_t get_memtable_row_cnt() const { return memtable_row_cnt_; }
+  const ObIArray<uint64_t> &get_ndv_sketch_column_ids() const { return ndv_sketch_column_ids_; }
+  const ObIArray<uint8_t> &get_column_ndv_sketches() const { return column_ndv_sketches_; }
 
 
   TO_STRING_KV(K(row_count_),
@@ -343,7 +348,9 @@ public:
                K(stat_locked_),
                K(stale_stats_),
                K(sstable_row_cnt_),
-               K(memtable_row_cnt_));
+               K(memtable_row_cnt_),
+               K(ndv_sketch_part_cnt_),
+               K(ndv_sketch_column_ids_));
 
 private:
   int64_t row_count_;
@@ -359,6 +366,9 @@ private:
   bool stale_stats_;
   int64_t sstable_row_cnt_;
   int64_t memtable_row_cnt_;
+  int64_t ndv_sketch_part_cnt_;
+  ObArray<uint64_t> ndv_sketch_column_ids_;
+  ObArray<uint8_t> column_ndv_sketches_;
 };
 
 class ObGlobalNullEval
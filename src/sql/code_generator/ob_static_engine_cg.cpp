@@ -5955,6 +5955,15 @@ int ObStaticEngineCG::generate_spec(ObLogJoin &op, ObHashJoinVecSpec &spec, cons
     OX (spec.is_sna_ = op.get_join_path()->is_sna_);
   }
   spec.is_shared_ht_ = DIST_BC2HOST_NONE == op.get_join_distributed_method();
+  if (spec.is_shared_ht_ && op.use_radix_shared_hash_table()) {
+    // all the workers sharing the hash table must build it the same way, so the mode is
+    // decided once here rather than by each worker from the dynamic parameter
+    int64_t tenant_id = op.get_plan()->get_optimizer_context().get_session_info()->get_effective_tenant_id();
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id));
+    if (tenant_config.is_valid()) {
+      spec.use_radix_shared_ht_ = tenant_config->_enable_hash_join_radix_build;
+    }
+  }
   if (op.is_partition_wise()) {
     phy_plan_->set_is_wise_join(op.is_partition_wise()); // set is_wise_join
   }
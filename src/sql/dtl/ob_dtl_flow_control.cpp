@@ -62,6 +62,9 @@ int ObDtlFlowControl::init(uint64_t tenant_id, int64_t chan_cnt)
     if (tenant_config.is_valid() && true == tenant_config->_px_message_compression) {
       compressor_type_ = ObCompressorType::LZ4_COMPRESSOR;
     }
+    enable_vector_encoding_ = tenant_config.is_valid()
+                              && tenant_config->_px_vector_message_encoding
+                              && GET_MIN_CLUSTER_VERSION() >= CLUSTER_VERSION_4_3_5_0;
     is_init_ = true;
     tenant_id_ = tenant_id;
     timeout_ts_ = 0;
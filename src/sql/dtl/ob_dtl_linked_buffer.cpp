@@ -141,7 +141,7 @@ OB_DEF_SERIALIZE(ObDtlLinkedBuffer)
         if (OB_FAIL(serialize_vector(buf, pos, size_))) {
           SQL_DTL_LOG(WARN, "serialize vector failed", K(ret));
         }
-      } else if (PX_VECTOR_FIXED == msg_type_) {
+      } else if (PX_VECTOR_FIXED == msg_type_ && !is_vector_encoded()) {
         if (OB_FAIL(serialize_fixed_vector(buf, pos, size_))) {
           SQL_DTL_LOG(WARN, "serialize vector fixed failed", K(ret));
         }
@@ -239,7 +239,7 @@ OB_DEF_SERIALIZE_SIZE(ObDtlLinkedBuffer)
       SQL_DTL_LOG(TRACE, "unexpected encode leads size overflow", K(size_), K(new_size));
     }
     const_cast<int64_t &> (size_) = new_size;
-  } else if (PX_VECTOR_FIXED == msg_type_) {
+  } else if (PX_VECTOR_FIXED == msg_type_ && !is_vector_encoded()) {
     int64_t new_size = get_serialize_fixed_vector_size();
     if (OB_UNLIKELY(size_ < new_size)) {
       SQL_DTL_LOG(TRACE, "unexpected encode leads size overflow", K(size_), K(new_size));
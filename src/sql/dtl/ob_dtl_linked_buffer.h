@@ -23,6 +23,8 @@ namespace sql {
 namespace dtl {
 
 #define DTL_BROADCAST (1ULL)
+// payload of PX_VECTOR_FIXED is encoded by ObDtlVectorsCodec
+#define DTL_VECTOR_ENCODED (1ULL << 1)
 
 struct ObDtlMsgHeader;
 class ObDtlChannel;
@@ -362,6 +364,14 @@ public:
     remove_flag(DTL_BROADCAST);
   }
 
+  bool is_vector_encoded() const {
+    return has_flag(DTL_VECTOR_ENCODED);
+  }
+
+  void set_vector_encoded() {
+    add_flag(DTL_VECTOR_ENCODED);
+  }
+
   uint64_t enable_channel_sync() const { return enable_channel_sync_; }
   void set_enable_channel_sync(const bool enable_channel_sync) { enable_channel_sync_ = enable_channel_sync; }
 
@@ -177,7 +177,8 @@ ObDtlRpcChannel::ObDtlRpcChannel(
     const uint64_t id,
     const ObAddr &peer,
     DtlChannelType type)
-    : ObDtlBasicChannel(tenant_id, id, peer, type), recv_sqc_fin_res_(false)
+    : ObDtlBasicChannel(tenant_id, id, peer, type), recv_sqc_fin_res_(false), encode_stat_(),
+      encode_buf_(nullptr), encode_buf_size_(0)
 {}
 
 ObDtlRpcChannel::ObDtlRpcChannel(
@@ -186,13 +187,15 @@ ObDtlRpcChannel::ObDtlRpcChannel(
     const ObAddr &peer,
     const int64_t hash_val,
     DtlChannelType type)
-    : ObDtlBasicChannel(tenant_id, id, peer, hash_val, type), recv_sqc_fin_res_(false)
+    : ObDtlBasicChannel(tenant_id, id, peer, hash_val, type), recv_sqc_fin_res_(false),
+      encode_stat_(), encode_buf_(nullptr), encode_buf_size_(0)
 {}
 
 ObDtlRpcChannel::~ObDtlRpcChannel()
 {
   destroy();
-  LOG_TRACE("dtl use time", K(times_), K(write_buf_use_time_), K(send_use_time_), K(lbt()));
+  LOG_TRACE("dtl use time", K(times_), K(write_buf_use_time_), K(send_use_time_),
+            K_(encode_stat), K(lbt()));
 }
 
 int ObDtlRpcChannel::init()
@@ -207,6 +210,11 @@ int ObDtlRpcChannel::init()
 void ObDtlRpcChannel::destroy()
 {
   recv_sqc_fin_res_ = false;
+  if (nullptr != encode_buf_) {
+    ob_free(encode_buf_);
+    encode_buf_ = nullptr;
+  }
+  encode_buf_size_ = 0;
 }
 
 int ObDtlRpcChannel::feedup(ObDtlLinkedBuffer *&buffer)
@@ -301,6 +309,11 @@ int ObDtlRpcChannel::send_message(ObDtlLinkedBuffer *&buf)
     if (OB_SUCC(ret) && OB_FAIL(wait_unblocking_if_blocked())) {
       LOG_WARN("failed to block data flow", K(ret));
     }
+    if (OB_SUCC(ret) && enable_vector_encoding_ && !use_interm_result_
+        && buf->is_data_msg() && PX_VECTOR_FIXED == buf->msg_type()
+        && !buf->is_vector_encoded() && OB_FAIL(encode_vectors(*buf))) {
+      LOG_WARN("failed to encode vectors", K(ret));
+    }
   }
   LOG_TRACE("send message:", K(buf->tenant_id()), K(buf->size()), KP(get_id()), K_(peer), K(ret),
     K(get_send_buffer_cnt()), K(belong_to_receive_data()), K(belong_to_transmit_data()),
@@ -351,6 +364,39 @@ int ObDtlRpcChannel::send_message(ObDtlLinkedBuffer *&buf)
   return ret;
 }
 
+int ObDtlRpcChannel::encode_vectors(ObDtlLinkedBuffer &buf)
+{
+  int ret = OB_SUCCESS;
+  if (encode_stat_.need_encode()) {
+    const int64_t raw_size = ObDtlVectorsCodec::get_raw_size(buf.buf());
+    const int64_t max_size = ObDtlVectorsCodec::get_max_encoded_size(buf.buf());
+    int64_t encoded_size = 0;
+    if (max_size > encode_buf_size_) {
+      if (nullptr != encode_buf_) {
+        ob_free(encode_buf_);
+        encode_buf_ = nullptr;
+        encode_buf_size_ = 0;
+      }
+      if (OB_ISNULL(encode_buf_ = static_cast<char *>(ob_malloc(max_size, ObMemAttr(tenant_id_, "DtlVecEncode"))))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc encode buffer", K(ret), K(max_size));
+      } else {
+        encode_buf_size_ = max_size;
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(ObDtlVectorsCodec::encode(buf.buf(), encode_buf_, max_size, encoded_size))) {
+      LOG_WARN("failed to encode vectors", K(ret), K(raw_size), K(max_size));
+    } else if (encode_stat_.update(raw_size, encoded_size)) {
+      // raw size is no more than the payload size, so the encoded one fits in place
+      MEMCPY(buf.buf(), encode_buf_, encoded_size);
+      buf.set_size(encoded_size);
+      buf.set_vector_encoded();
+    }
+  }
+  return ret;
+}
+
 }  // dtl
 }  // sql
 }  // oceanbase
@@ -25,6 +25,7 @@
 #include "observer/ob_server_struct.h"
 #include "sql/dtl/ob_dtl_rpc_proxy.h"
 #include "sql/dtl/ob_dtl_basic_channel.h"
+#include "sql/dtl/ob_dtl_vectors_codec.h"
 
 namespace oceanbase {
 
@@ -100,8 +101,15 @@ public:
   virtual int send_message(ObDtlLinkedBuffer *&buf);
 
   bool recv_sqc_fin_res() { return recv_sqc_fin_res_; }
+private:
+  // encode PX_VECTOR_FIXED buffer in place if it shrinks enough
+  int encode_vectors(ObDtlLinkedBuffer &buf);
 private:
   bool recv_sqc_fin_res_;
+  ObDtlVectorsEncodeStat encode_stat_;
+  // scratch buffer of encode_vectors, reused by every send of the channel
+  char *encode_buf_;
+  int64_t encode_buf_size_;
 };
 
 }  // dtl
@@ -0,0 +1,509 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_DTL
+#include "ob_dtl_vectors_codec.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "sql/dtl/ob_dtl_vectors_buffer.h"
+
+using namespace oceanbase::common;
+
+namespace oceanbase {
+namespace sql {
+namespace dtl {
+
+namespace
+{
+
+const int64_t COL_CNT_OFFSET = sizeof(int32_t);
+const int64_t DECODED_SIZE_OFFSET = ObDtlVectors::HEAD_SIZE;
+const int64_t DICT_HASH_BUCKET_CNT = ObDtlVectorsCodec::MAX_DICT_CNT * 2;
+
+OB_INLINE int32_t get_col_cnt(const char *buf)
+{
+  return *reinterpret_cast<const int32_t *>(buf + COL_CNT_OFFSET);
+}
+
+OB_INLINE int32_t get_row_cnt(const char *buf)
+{
+  return *reinterpret_cast<const int32_t *>(buf + ObDtlVectors::ROW_CNT_OFFSET);
+}
+
+OB_INLINE const VectorInfo *get_infos(const char *buf)
+{
+  return reinterpret_cast<const VectorInfo *>(buf + ObDtlVectors::HEAD_SIZE);
+}
+
+OB_INLINE bool can_bit_pack(const int64_t fixed_len)
+{
+  return sizeof(int8_t) == fixed_len || sizeof(int16_t) == fixed_len
+      || sizeof(int32_t) == fixed_len || sizeof(int64_t) == fixed_len;
+}
+
+OB_INLINE int64_t load_int(const char *ptr, const int64_t fixed_len)
+{
+  int64_t v = 0;
+  switch (fixed_len) {
+    case sizeof(int8_t): { v = *reinterpret_cast<const int8_t *>(ptr); break; }
+    case sizeof(int16_t): { int16_t t = 0; MEMCPY(&t, ptr, sizeof(t)); v = t; break; }
+    case sizeof(int32_t): { int32_t t = 0; MEMCPY(&t, ptr, sizeof(t)); v = t; break; }
+    default: { MEMCPY(&v, ptr, sizeof(v)); break; }
+  }
+  return v;
+}
+
+OB_INLINE uint8_t calc_bit_width(const uint64_t max_value)
+{
+  return 0 == max_value ? 0 : static_cast<uint8_t>(64 - __builtin_clzll(max_value));
+}
+
+OB_INLINE uint64_t bit_mask(const uint8_t bit_width)
+{
+  return bit_width >= 64 ? UINT64_MAX : ((1ULL << bit_width) - 1);
+}
+
+class BitPacker
+{
+public:
+  explicit BitPacker(char *buf) : buf_(buf), pos_(0), word_(0), bits_(0) {}
+  OB_INLINE void append(const uint64_t v, const uint8_t bit_width)
+  {
+    if (bit_width > 0) {
+      word_ |= v << bits_;
+      if (bits_ + bit_width >= 64) {
+        MEMCPY(buf_ + pos_, &word_, sizeof(word_));
+        pos_ += sizeof(word_);
+        const uint8_t used = static_cast<uint8_t>(64 - bits_);
+        word_ = used < 64 ? v >> used : 0;
+        bits_ = static_cast<uint8_t>(bits_ + bit_width - 64);
+      } else {
+        bits_ = static_cast<uint8_t>(bits_ + bit_width);
+      }
+    }
+  }
+  int64_t finish()
+  {
+    if (bits_ > 0) {
+      MEMCPY(buf_ + pos_, &word_, sizeof(word_));
+      pos_ += sizeof(word_);
+      word_ = 0;
+      bits_ = 0;
+    }
+    return pos_;
+  }
+private:
+  char *buf_;
+  int64_t pos_;
+  uint64_t word_;
+  uint8_t bits_;
+};
+
+class BitUnpacker
+{
+public:
+  explicit BitUnpacker(const char *buf) : buf_(buf), pos_(0), word_(0), bits_(0) {}
+  OB_INLINE uint64_t next(const uint8_t bit_width)
+  {
+    uint64_t v = 0;
+    if (0 == bit_width) {
+    } else if (bits_ >= bit_width) {
+      v = word_ & bit_mask(bit_width);
+      word_ = bit_width < 64 ? word_ >> bit_width : 0;
+      bits_ = static_cast<uint8_t>(bits_ - bit_width);
+    } else {
+      uint64_t w = 0;
+      MEMCPY(&w, buf_ + pos_, sizeof(w));
+      pos_ += sizeof(w);
+      v = (word_ | (w << bits_)) & bit_mask(bit_width);
+      const uint8_t consumed = static_cast<uint8_t>(bit_width - bits_);
+      word_ = consumed < 64 ? w >> consumed : 0;
+      bits_ = static_cast<uint8_t>(64 - consumed);
+    }
+    return v;
+  }
+private:
+  const char *buf_;
+  int64_t pos_;
+  uint64_t word_;
+  uint8_t bits_;
+};
+
+// dictionary of the first MAX_DICT_CNT distinct values, referencing the source vector
+class ValueDict
+{
+public:
+  explicit ValueDict(const int64_t fixed_len) : fixed_len_(fixed_len), cnt_(0)
+  {
+    MEMSET(buckets_, -1, sizeof(buckets_));
+  }
+  // return -1 if the value is not in dict and the dict is full
+  OB_INLINE int32_t get_or_add(const char *value)
+  {
+    int32_t code = -1;
+    int64_t idx = murmurhash(value, static_cast<int32_t>(fixed_len_), 0) % DICT_HASH_BUCKET_CNT;
+    for (int64_t i = 0; i < DICT_HASH_BUCKET_CNT; ++i) {
+      int16_t &bucket = buckets_[idx];
+      if (bucket < 0) {
+        if (cnt_ < ObDtlVectorsCodec::MAX_DICT_CNT) {
+          values_[cnt_] = value;
+          bucket = static_cast<int16_t>(cnt_);
+          code = cnt_++;
+        }
+        break;
+      } else if (0 == MEMCMP(values_[bucket], value, fixed_len_)) {
+        code = bucket;
+        break;
+      }
+      idx = (idx + 1) % DICT_HASH_BUCKET_CNT;
+    }
+    return code;
+  }
+  int32_t count() const { return cnt_; }
+  const char *at(const int32_t code) const { return values_[code]; }
+private:
+  int64_t fixed_len_;
+  int32_t cnt_;
+  int16_t buckets_[DICT_HASH_BUCKET_CNT];
+  const char *values_[ObDtlVectorsCodec::MAX_DICT_CNT];
+};
+
+}
+
+int64_t ObDtlVectorsCodec::get_raw_size(const char *vectors_buf)
+{
+  int64_t size = ObDtlVectors::HEAD_SIZE;
+  const int64_t col_cnt = get_col_cnt(vectors_buf);
+  const int64_t row_cnt = get_row_cnt(vectors_buf);
+  if (col_cnt > 0 && row_cnt > 0) {
+    const VectorInfo *infos = get_infos(vectors_buf);
+    size += col_cnt * sizeof(VectorInfo);
+    for (int64_t i = 0; i < col_cnt; ++i) {
+      size += ObBitVector::memory_size(row_cnt) + infos[i].fixed_len_ * row_cnt;
+    }
+  }
+  return size;
+}
+
+int64_t ObDtlVectorsCodec::get_max_encoded_size(const char *vectors_buf)
+{
+  int64_t size = HEAD_SIZE;
+  const int64_t col_cnt = get_col_cnt(vectors_buf);
+  const int64_t row_cnt = get_row_cnt(vectors_buf);
+  if (col_cnt > 0 && row_cnt > 0) {
+    const VectorInfo *infos = get_infos(vectors_buf);
+    for (int64_t i = 0; i < col_cnt; ++i) {
+      size += sizeof(ObDtlEncodedColumnHeader) + ObBitVector::memory_size(row_cnt)
+          + infos[i].fixed_len_ * row_cnt;
+    }
+  }
+  return size;
+}
+
+int ObDtlVectorsCodec::encode(const char *vectors_buf, char *buf, const int64_t buf_len, int64_t &encoded_size)
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = HEAD_SIZE;
+  encoded_size = 0;
+  if (OB_ISNULL(vectors_buf) || OB_ISNULL(buf)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(vectors_buf), KP(buf));
+  } else if (OB_UNLIKELY(ObDtlVectorsBuffer::MAGIC != *reinterpret_cast<const int32_t *>(vectors_buf))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("magic check failed", K(ret), K(*reinterpret_cast<const int32_t *>(vectors_buf)));
+  } else if (OB_UNLIKELY(buf_len < get_max_encoded_size(vectors_buf))) {
+    ret = OB_BUF_NOT_ENOUGH;
+    LOG_WARN("buffer is not enough", K(ret), K(buf_len), K(get_max_encoded_size(vectors_buf)));
+  } else {
+    const int32_t col_cnt = get_col_cnt(vectors_buf);
+    const int32_t row_cnt = get_row_cnt(vectors_buf);
+    *reinterpret_cast<int32_t *>(buf) = ENCODED_MAGIC;
+    *reinterpret_cast<int32_t *>(buf + COL_CNT_OFFSET) = col_cnt;
+    *reinterpret_cast<int32_t *>(buf + ObDtlVectors::ROW_CNT_OFFSET) = row_cnt;
+    *reinterpret_cast<int32_t *>(buf + DECODED_SIZE_OFFSET) = static_cast<int32_t>(get_raw_size(vectors_buf));
+    if (col_cnt > 0 && row_cnt > 0) {
+      for (int64_t i = 0; OB_SUCC(ret) && i < col_cnt; ++i) {
+        if (OB_FAIL(encode_column(vectors_buf, i, row_cnt, buf, buf_len, pos))) {
+          LOG_WARN("failed to encode column", K(ret), K(i), K(row_cnt));
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      encoded_size = pos;
+    }
+  }
+  return ret;
+}
+
+int ObDtlVectorsCodec::encode_column(const char *vectors_buf,
+                                     const int64_t col_idx,
+                                     const int64_t row_cnt,
+                                     char *buf,
+                                     const int64_t buf_len,
+                                     int64_t &pos)
+{
+  int ret = OB_SUCCESS;
+  const VectorInfo &info = get_infos(vectors_buf)[col_idx];
+  const ObBitVector *nulls = to_bit_vector(vectors_buf + info.nulls_offset_);
+  const char *data = vectors_buf + info.data_offset_;
+  const int64_t fixed_len = info.fixed_len_;
+  const int64_t null_cnt = nulls->accumulate_bit_cnt(row_cnt);
+  const int64_t nulls_size = null_cnt > 0 ? ObBitVector::memory_size(row_cnt) : 0;
+  ObDtlEncodedColumnHeader *header = reinterpret_cast<ObDtlEncodedColumnHeader *>(buf + pos);
+  header->format_ = info.format_;
+  header->fixed_len_ = info.fixed_len_;
+  header->encoding_ = ObDtlEncodedColumnHeader::RAW;
+  header->has_null_ = null_cnt > 0;
+  header->bit_width_ = 0;
+  header->reserved_ = 0;
+  header->dict_cnt_ = 0;
+  header->base_ = 0;
+  int64_t data_size = fixed_len * row_cnt;
+  // frame of reference
+  int64_t min_value = INT64_MAX;
+  int64_t max_value = INT64_MIN;
+  uint8_t for_width = UINT8_MAX;
+  if (can_bit_pack(fixed_len)) {
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      if (!nulls->at(i)) {
+        const int64_t v = load_int(data + i * fixed_len, fixed_len);
+        min_value = std::min(min_value, v);
+        max_value = std::max(max_value, v);
+      }
+    }
+    if (null_cnt == row_cnt) {
+      min_value = 0;
+      max_value = 0;
+    }
+    for_width = calc_bit_width(static_cast<uint64_t>(max_value) - static_cast<uint64_t>(min_value));
+    const int64_t for_size = get_packed_size(row_cnt, for_width);
+    if (for_size < data_size) {
+      header->encoding_ = ObDtlEncodedColumnHeader::FOR_BIT_PACKING;
+      header->bit_width_ = for_width;
+      header->base_ = min_value;
+      data_size = for_size;
+    }
+  }
+  // dictionary, only tried when frame of reference can't pack into one byte
+  ValueDict dict(fixed_len);
+  if (for_width > 8 && fixed_len > 0 && null_cnt < row_cnt) {
+    bool dict_full = false;
+    for (int64_t i = 0; !dict_full && i < row_cnt; ++i) {
+      if (!nulls->at(i)) {
+        dict_full = dict.get_or_add(data + i * fixed_len) < 0;
+      }
+    }
+    if (!dict_full) {
+      const uint8_t dict_width = calc_bit_width(dict.count() - 1);
+      const int64_t dict_size = dict.count() * fixed_len + get_packed_size(row_cnt, dict_width);
+      if (dict_size < data_size) {
+        header->encoding_ = ObDtlEncodedColumnHeader::DICT;
+        header->bit_width_ = dict_width;
+        header->dict_cnt_ = dict.count();
+        header->base_ = 0;
+        data_size = dict_size;
+      }
+    }
+  }
+  pos += sizeof(ObDtlEncodedColumnHeader);
+  if (OB_UNLIKELY(pos + nulls_size + data_size > buf_len)) {
+    ret = OB_BUF_NOT_ENOUGH;
+    LOG_WARN("buffer is not enough", K(ret), K(pos), K(nulls_size), K(data_size), K(buf_len));
+  } else {
+    header->data_size_ = nulls_size + data_size;
+    if (nulls_size > 0) {
+      MEMCPY(buf + pos, nulls, nulls_size);
+      pos += nulls_size;
+    }
+    switch (header->encoding_) {
+      case ObDtlEncodedColumnHeader::RAW: {
+        MEMCPY(buf + pos, data, data_size);
+        pos += data_size;
+        break;
+      }
+      case ObDtlEncodedColumnHeader::FOR_BIT_PACKING: {
+        BitPacker packer(buf + pos);
+        for (int64_t i = 0; i < row_cnt; ++i) {
+          const uint64_t delta = nulls->at(i) ? 0
+              : static_cast<uint64_t>(load_int(data + i * fixed_len, fixed_len)) - static_cast<uint64_t>(min_value);
+          packer.append(delta, for_width);
+        }
+        pos += packer.finish();
+        break;
+      }
+      case ObDtlEncodedColumnHeader::DICT: {
+        for (int32_t i = 0; i < dict.count(); ++i) {
+          MEMCPY(buf + pos, dict.at(i), fixed_len);
+          pos += fixed_len;
+        }
+        BitPacker packer(buf + pos);
+        for (int64_t i = 0; i < row_cnt; ++i) {
+          const int32_t code = nulls->at(i) ? 0 : dict.get_or_add(data + i * fixed_len);
+          packer.append(static_cast<uint64_t>(code), header->bit_width_);
+        }
+        pos += packer.finish();
+        break;
+      }
+      default: {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected encoding", K(ret), KPC(header));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObDtlVectorsCodec::get_decoded_size(const char *buf, const int64_t size, int64_t &decoded_size)
+{
+  int ret = OB_SUCCESS;
+  decoded_size = 0;
+  if (OB_ISNULL(buf) || OB_UNLIKELY(size < HEAD_SIZE)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(size));
+  } else if (OB_UNLIKELY(!is_encoded(buf))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("magic check failed", K(ret), K(*reinterpret_cast<const int32_t *>(buf)));
+  } else {
+    decoded_size = *reinterpret_cast<const int32_t *>(buf + DECODED_SIZE_OFFSET);
+  }
+  return ret;
+}
+
+int ObDtlVectorsCodec::decode(const char *buf, const int64_t size, char *vectors_buf, const int64_t vectors_buf_len)
+{
+  int ret = OB_SUCCESS;
+  int64_t decoded_size = 0;
+  if (OB_ISNULL(vectors_buf)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(vectors_buf));
+  } else if (OB_FAIL(get_decoded_size(buf, size, decoded_size))) {
+    LOG_WARN("failed to get decoded size", K(ret), K(size));
+  } else if (OB_UNLIKELY(vectors_buf_len < decoded_size)) {
+    ret = OB_BUF_NOT_ENOUGH;
+    LOG_WARN("buffer is not enough", K(ret), K(vectors_buf_len), K(decoded_size));
+  } else {
+    const int32_t col_cnt = get_col_cnt(buf);
+    const int32_t row_cnt = get_row_cnt(buf);
+    int64_t pos = HEAD_SIZE;
+    int64_t vectors_pos = ObDtlVectors::HEAD_SIZE;
+    *reinterpret_cast<int32_t *>(vectors_buf) = ObDtlVectorsBuffer::MAGIC;
+    *reinterpret_cast<int32_t *>(vectors_buf + COL_CNT_OFFSET) = col_cnt;
+    *reinterpret_cast<int32_t *>(vectors_buf + ObDtlVectors::ROW_CNT_OFFSET) = row_cnt;
+    if (OB_UNLIKELY(col_cnt < 0 || row_cnt < 0 || col_cnt > ObDtlVectorsBuffer::MAX_COL_CNT)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("get unexpected row cnt or col cnt", K(ret), K(col_cnt), K(row_cnt));
+    } else if (col_cnt > 0 && row_cnt > 0) {
+      vectors_pos += col_cnt * sizeof(VectorInfo);
+      for (int64_t i = 0; OB_SUCC(ret) && i < col_cnt; ++i) {
+        if (OB_FAIL(decode_column(buf, size, row_cnt, pos, vectors_buf, decoded_size, i, vectors_pos))) {
+          LOG_WARN("failed to decode column", K(ret), K(i), K(row_cnt));
+        }
+      }
+    }
+    if (OB_SUCC(ret) && OB_UNLIKELY(vectors_pos != decoded_size)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("decoded size mismatch", K(ret), K(vectors_pos), K(decoded_size));
+    }
+  }
+  return ret;
+}
+
+int ObDtlVectorsCodec::decode_column(const char *buf,
+                                     const int64_t size,
+                                     const int64_t row_cnt,
+                                     int64_t &pos,
+                                     char *vectors_buf,
+                                     const int64_t vectors_buf_len,
+                                     const int64_t col_idx,
+                                     int64_t &vectors_pos)
+{
+  int ret = OB_SUCCESS;
+  const ObDtlEncodedColumnHeader *header = reinterpret_cast<const ObDtlEncodedColumnHeader *>(buf + pos);
+  VectorInfo &info = reinterpret_cast<VectorInfo *>(vectors_buf + ObDtlVectors::HEAD_SIZE)[col_idx];
+  const int64_t nulls_size = ObBitVector::memory_size(row_cnt);
+  int64_t expect_data_size = 0;
+  if (OB_UNLIKELY(pos + static_cast<int64_t>(sizeof(ObDtlEncodedColumnHeader)) > size)
+      || OB_UNLIKELY(pos + static_cast<int64_t>(sizeof(ObDtlEncodedColumnHeader)) + header->data_size_ > size)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("encoded column out of buffer", K(ret), K(pos), K(size), K(col_idx));
+  } else if (FALSE_IT(expect_data_size = (header->has_null_ ? nulls_size : 0)
+      + (ObDtlEncodedColumnHeader::RAW == header->encoding_ ? header->fixed_len_ * row_cnt
+      : header->dict_cnt_ * header->fixed_len_ + get_packed_size(row_cnt, header->bit_width_)))) {
+  } else if (OB_UNLIKELY(expect_data_size != header->data_size_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected encoded column size", K(ret), K(expect_data_size), KPC(header));
+  } else if (OB_UNLIKELY(vectors_pos + nulls_size + header->fixed_len_ * row_cnt > vectors_buf_len)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("decoded column out of buffer", K(ret), K(vectors_pos), K(vectors_buf_len), KPC(header));
+  } else {
+    const int64_t fixed_len = header->fixed_len_;
+    pos += sizeof(ObDtlEncodedColumnHeader);
+    info.format_ = static_cast<VectorFormat>(header->format_);
+    info.fixed_len_ = header->fixed_len_;
+    info.offsets_offset_ = 0;
+    info.nulls_offset_ = static_cast<int32_t>(vectors_pos);
+    ObBitVector *nulls = to_bit_vector(vectors_buf + vectors_pos);
+    if (header->has_null_) {
+      MEMCPY(nulls, buf + pos, nulls_size);
+      pos += nulls_size;
+    } else {
+      nulls->reset(row_cnt);
+    }
+    vectors_pos += nulls_size;
+    info.data_offset_ = static_cast<int32_t>(vectors_pos);
+    char *data = vectors_buf + vectors_pos;
+    switch (header->encoding_) {
+      case ObDtlEncodedColumnHeader::RAW: {
+        MEMCPY(data, buf + pos, fixed_len * row_cnt);
+        pos += fixed_len * row_cnt;
+        break;
+      }
+      case ObDtlEncodedColumnHeader::FOR_BIT_PACKING: {
+        BitUnpacker unpacker(buf + pos);
+        const uint64_t base = static_cast<uint64_t>(header->base_);
+        for (int64_t i = 0; i < row_cnt; ++i) {
+          const uint64_t v = base + unpacker.next(header->bit_width_);
+          // little endian, the low bytes hold the value of the fixed length
+          MEMCPY(data + i * fixed_len, &v, fixed_len);
+        }
+        pos += get_packed_size(row_cnt, header->bit_width_);
+        break;
+      }
+      case ObDtlEncodedColumnHeader::DICT: {
+        const char *dict_values = buf + pos;
+        const int32_t dict_cnt = header->dict_cnt_;
+        pos += dict_cnt * fixed_len;
+        BitUnpacker unpacker(buf + pos);
+        for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt; ++i) {
+          const uint64_t code = unpacker.next(header->bit_width_);
+          if (OB_UNLIKELY(code >= static_cast<uint64_t>(dict_cnt))) {
+            ret = OB_ERR_UNEXPECTED;
+            LOG_WARN("invalid dict code", K(ret), K(code), K(dict_cnt));
+          } else {
+            MEMCPY(data + i * fixed_len, dict_values + code * fixed_len, fixed_len);
+          }
+        }
+        pos += get_packed_size(row_cnt, header->bit_width_);
+        break;
+      }
+      default: {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected encoding", K(ret), KPC(header));
+      }
+    }
+    vectors_pos += fixed_len * row_cnt;
+  }
+  return ret;
+}
+
+}  // dtl
+}  // sql
+}  // oceanbase
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_DTL_VECTORS_CODEC_H
+#define OB_DTL_VECTORS_CODEC_H
+
+#include <stdint.h>
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase {
+namespace sql {
+namespace dtl {
+
+/*
+encoded PX_VECTOR_FIXED buffer
+magic_num : 4 (ENCODED_MAGIC)
+col_cnt : 4
+row_cnt : 4
+decoded_size : 4
+(ObDtlEncodedColumnHeader + nulls : to_bit_vector(row_cnt) if has null + dict values + packed data) * col_cnt
+
+row_cnt is kept at the same offset as ObDtlVectors, so ObDtlVectors::decode_row_cnt
+works for both layouts.
+*/
+struct ObDtlEncodedColumnHeader
+{
+  enum Encoding : uint8_t
+  {
+    RAW = 0,
+    // values minus the minimum value, bit packed
+    FOR_BIT_PACKING = 1,
+    // distinct values followed by bit packed dict codes
+    DICT = 2,
+  };
+  TO_STRING_KV(K_(format), K_(fixed_len), K_(encoding), K_(has_null), K_(bit_width),
+               K_(dict_cnt), K_(base), K_(data_size));
+  int32_t format_;
+  int32_t fixed_len_;
+  uint8_t encoding_;
+  uint8_t has_null_;
+  uint8_t bit_width_;
+  uint8_t reserved_;
+  int32_t dict_cnt_;
+  int64_t base_;
+  int64_t data_size_; // size of nulls, dict values and packed data following the header
+} __attribute__((packed));
+
+// Lightweight per column encodings for the fixed length vectors sent by rpc channels,
+// frame of reference with bit packing for integers, dictionary for low cardinality values
+// and null bitmaps only for the columns that do have null.
+class ObDtlVectorsCodec
+{
+public:
+  static const int32_t ENCODED_MAGIC = 0xe02d8537;
+  static const int64_t HEAD_SIZE = sizeof(int32_t) * 4;
+  static const int32_t MAX_DICT_CNT = 256;
+
+  static bool is_encoded(const char *buf)
+  {
+    return nullptr != buf && ENCODED_MAGIC == *reinterpret_cast<const int32_t *>(buf);
+  }
+  // upper bound of the encoded size of the ObDtlVectors in @vectors_buf
+  static int64_t get_max_encoded_size(const char *vectors_buf);
+  // size of the vectors serialized without encoding, see ObDtlLinkedBuffer::serialize_fixed_vector
+  static int64_t get_raw_size(const char *vectors_buf);
+  static int encode(const char *vectors_buf, char *buf, const int64_t buf_len, int64_t &encoded_size);
+  static int get_decoded_size(const char *buf, const int64_t size, int64_t &decoded_size);
+  // decode into the layout of ObDtlLinkedBuffer::serialize_fixed_vector
+  static int decode(const char *buf, const int64_t size, char *vectors_buf, const int64_t vectors_buf_len);
+private:
+  static int encode_column(const char *vectors_buf,
+                           const int64_t col_idx,
+                           const int64_t row_cnt,
+                           char *buf,
+                           const int64_t buf_len,
+                           int64_t &pos);
+  static int decode_column(const char *buf,
+                           const int64_t size,
+                           const int64_t row_cnt,
+                           int64_t &pos,
+                           char *vectors_buf,
+                           const int64_t vectors_buf_len,
+                           const int64_t col_idx,
+                           int64_t &vectors_pos);
+  static int64_t get_packed_size(const int64_t row_cnt, const int64_t bit_width)
+  {
+    return (row_cnt * bit_width + 63) / 64 * sizeof(uint64_t);
+  }
+};
+
+// Encode the remote vectors of one channel only while it pays, after
+// MAX_FAIL_CNT buffers in a row not shrinking to MIN_RATIO_PERCENT of the raw size,
+// the next PROBE_INTERVAL buffers are sent without encoding.
+class ObDtlVectorsEncodeStat
+{
+public:
+  static const int64_t MIN_RATIO_PERCENT = 80;
+  static const int64_t MAX_FAIL_CNT = 4;
+  static const int64_t PROBE_INTERVAL = 64;
+  ObDtlVectorsEncodeStat() : fail_cnt_(0), skip_cnt_(0), raw_bytes_(0), encoded_bytes_(0) {}
+  bool need_encode()
+  {
+    bool need = true;
+    if (skip_cnt_ > 0) {
+      --skip_cnt_;
+      need = false;
+    }
+    return need;
+  }
+  // return whether the encoded buffer is worth sending
+  bool update(const int64_t raw_size, const int64_t encoded_size)
+  {
+    const bool worth = encoded_size * 100 <= raw_size * MIN_RATIO_PERCENT;
+    raw_bytes_ += raw_size;
+    encoded_bytes_ += worth ? encoded_size : raw_size;
+    if (worth) {
+      fail_cnt_ = 0;
+    } else if (++fail_cnt_ >= MAX_FAIL_CNT) {
+      fail_cnt_ = 0;
+      skip_cnt_ = PROBE_INTERVAL;
+    }
+    return worth;
+  }
+  TO_STRING_KV(K_(fail_cnt), K_(skip_cnt), K_(raw_bytes), K_(encoded_bytes));
+private:
+  int64_t fail_cnt_;
+  int64_t skip_cnt_;
+  int64_t raw_bytes_;
+  int64_t encoded_bytes_;
+};
+
+}  // dtl
+}  // sql
+}  // oceanbase
+
+#endif /* OB_DTL_VECTORS_CODEC_H */
@@ -157,7 +157,12 @@ int ObExtendHashTableVec<GroupRowBucket>::process_batch(const common::ObIArray<O
       && OB_FAIL(sstr_aggr_.check_batch_length(gby_exprs, child_brs, is_dumped,
                                                const_cast<uint64_t *> (hash_values), *eval_ctx_))) {
     LOG_WARN("failed to check batch length", K(ret));
-  } else if (!sstr_aggr_.is_valid()) {
+  } else if (sint_aggr_.is_valid()
+             && OB_FAIL(sint_aggr_.check_batch_range(gby_exprs, child_brs, is_dumped,
+                                                     const_cast<uint64_t *> (hash_values),
+                                                     *eval_ctx_))) {
+    LOG_WARN("failed to check batch range", K(ret));
+  } else if (!is_direct_aggr_valid()) {
     new_row_selector_cnt_ = 0;
     // extend bucket to hold whole batch
     while (OB_SUCC(ret) && auto_extend_ && OB_UNLIKELY((size_ + child_brs.size_)
@@ -202,11 +207,18 @@ int ObExtendHashTableVec<GroupRowBucket>::process_batch(const common::ObIArray<O
     }
   } else {
     bool has_new_row = false;
-    if (OB_FAIL(sstr_aggr_.process_batch(gby_exprs, child_brs, item_alloc_,
+    if (sstr_aggr_.is_valid()
+        && OB_FAIL(sstr_aggr_.process_batch(gby_exprs, child_brs, item_alloc_,
                                    *eval_ctx_, batch_old_rows, batch_new_rows,
                                    agg_row_cnt, agg_group_cnt, batch_aggr_rows,
                                    has_new_row))) {
       LOG_WARN("failed to process batch", K(ret));
+    } else if (sint_aggr_.is_valid()
+               && OB_FAIL(sint_aggr_.process_batch(gby_exprs, child_brs, is_dumped,
+                                                   *eval_ctx_, batch_old_rows, batch_new_rows,
+                                                   agg_row_cnt, agg_group_cnt, batch_aggr_rows,
+                                                   has_new_row))) {
+      LOG_WARN("failed to process batch", K(ret));
     } else if (has_new_row) {
       if (OB_FAIL(ShortStringAggregator::fallback_calc_hash_value_batch(gby_exprs, child_brs, *eval_ctx_,
                                                  const_cast<uint64_t *> (hash_values)))) {
@@ -788,7 +800,8 @@ int ObExtendHashTableVec<GroupRowBucket>::init(ObIAllocator *allocator,
                                                bool use_sstr_aggr,
                                                int64_t aggr_row_size,
                                                int64_t initial_size,
-                                               bool auto_extend)
+                                               bool auto_extend,
+                                               bool use_sint_aggr /*false*/)
 {
   int ret = OB_SUCCESS;
   if (initial_size < 2) {
@@ -810,6 +823,9 @@ int ObExtendHashTableVec<GroupRowBucket>::init(ObIAllocator *allocator,
     change_valid_idx_.set_allocator(allocator);
     if (use_sstr_aggr && OB_FAIL(sstr_aggr_.init(allocator_, *eval_ctx, gby_exprs, aggr_row_size))) {
       LOG_WARN("failed to init short string aggr", K(ret));
+    } else if (!use_sstr_aggr && use_sint_aggr
+               && OB_FAIL(sint_aggr_.init(allocator_, *eval_ctx, gby_exprs))) {
+      LOG_WARN("failed to init small int aggr", K(ret));
     } else if (OB_FAIL(vector_ptrs_.prepare_allocate(gby_exprs.count()))) {
       SQL_ENG_LOG(WARN, "failed to alloc ptrs", K(ret));
     } else if (OB_FAIL(new_row_selector_.prepare_allocate(max_batch_size))) {
@@ -1079,7 +1095,7 @@ int ObExtendHashTableVec<GroupRowBucket>::likely_equal_nullable(const RowMeta &r
 template <typename GroupRowBucket>
 void ObExtendHashTableVec<GroupRowBucket>::prefetch(const ObBatchRows &brs, uint64_t *hash_vals) const
 {
-  if (!sstr_aggr_.is_valid()) {
+  if (!is_direct_aggr_valid()) {
     auto mask = get_bucket_num() - 1;
     for(auto i = 0; i < brs.size_; i++) {
       if (brs.skip_->at(i)) {
@@ -507,6 +507,256 @@ private:
   int8_t *ser_num_array_;
 };
 
+// Aggregate by direct indexed array if there is only one integer group by expr and all values
+// fall into a window of MAX_VALUE_CNT values, e.g. status codes or dates.
+// Scope:
+//   - exactly one group by expr, of VEC_TC_INTEGER, VEC_TC_UINTEGER or VEC_TC_DATE, see
+//     is_supported. Multiple keys and other types (decimal, year, time, strings...) always use
+//     hash aggregation, or ShortStringAggregator for short strings.
+//   - the window is centered on the first non-null value and never moves. Values are mapped by
+//     unsigned subtraction, so negatives and the edges of int64/uint64 are handled the same way.
+//   - null keys share one extra bucket, BKT_IDX_FOR_NULL.
+//   - once a value is out of the window, it falls back to hash aggregation for the rest of the
+//     operator, including the rows of the current batch.
+// Same as ShortStringAggregator, new groups are linked into hash table too, so we can fall back
+// to hash aggregation at any batch.
+class SmallIntAggregator
+{
+public:
+  static const int64_t MAX_VALUE_CNT = 1L << 16;
+  static const int32_t BKT_IDX_FOR_NULL = MAX_VALUE_CNT;
+  static const int64_t MAX_BKT_CNT = MAX_VALUE_CNT + 1;
+  SmallIntAggregator(ObTempRowStore &group_store) : alloc_(nullptr), is_valid_(false),
+  has_base_(false), base_(0), bkt_idxes_(nullptr), grs_array_(nullptr), ser_num_array_(nullptr),
+  max_batch_size_(0), size_(0), group_store_(group_store), vector_ptrs_() {}
+
+  static bool is_supported(const common::ObIArray<ObExpr *> &group_exprs)
+  {
+    bool bret = false;
+    if (1 == group_exprs.count() && nullptr != group_exprs.at(0)) {
+      VecValueTypeClass tc = group_exprs.at(0)->get_vec_value_tc();
+      bret = (VEC_TC_INTEGER == tc || VEC_TC_UINTEGER == tc || VEC_TC_DATE == tc);
+    }
+    return bret;
+  }
+
+  // calculate bucket index of each row, fall back to hash aggregation if any value is out of window
+  int check_batch_range(const common::ObIArray<ObExpr *> &gby_exprs,
+                        const ObBatchRows &child_brs,
+                        const bool *is_dumped,
+                        uint64_t *hash_values,
+                        ObEvalCtx &eval_ctx)
+  {
+    int ret = OB_SUCCESS;
+    ObExpr *expr = gby_exprs.at(0);
+    if (OB_ISNULL(expr)) {
+      set_invalid();
+    } else {
+      const bool is_int32 = (VEC_TC_DATE == expr->get_vec_value_tc());
+      switch (expr->get_format(eval_ctx)) {
+        case VEC_FIXED: {
+          ObFixedLengthBase *vec = static_cast<ObFixedLengthBase *>(expr->get_vector(eval_ctx));
+          const sql::ObBitVector *nulls = vec->get_nulls();
+          const bool has_null = vec->has_null();
+          const char *data = vec->get_data();
+          const int64_t len = vec->get_length();
+          for (int64_t i = 0; is_valid() && i < child_brs.size_; ++i) {
+            if (child_brs.skip_->at(i) || is_dumped[i]) {
+              continue;
+            }
+            locate_bucket(i, has_null && nulls->at(i), data + len * i, is_int32);
+          }
+          break;
+        }
+        case VEC_UNIFORM:
+        case VEC_UNIFORM_CONST: {
+          ObUniformBase *vec = static_cast<ObUniformBase *>(expr->get_vector(eval_ctx));
+          const bool is_const = (VEC_UNIFORM_CONST == expr->get_format(eval_ctx));
+          for (int64_t i = 0; is_valid() && i < child_brs.size_; ++i) {
+            if (child_brs.skip_->at(i) || is_dumped[i]) {
+              continue;
+            }
+            const ObDatum &datum = vec->get_datums()[is_const ? 0 : i];
+            locate_bucket(i, datum.is_null(), datum.ptr_, is_int32);
+          }
+          break;
+        }
+        default:
+          set_invalid();
+      }
+    }
+    if (!is_valid()) {
+      LOG_TRACE("small int aggregation falls back to hash aggregation", K_(size), K_(base));
+      //need fall back, recalc hash value firstly
+      OZ (ShortStringAggregator::fallback_calc_hash_value_batch(gby_exprs, child_brs, eval_ctx,
+                                                                hash_values));
+    }
+    return ret;
+  }
+
+  int process_batch(const common::ObIArray<ObExpr *> &gby_exprs,
+                    const ObBatchRows &child_brs,
+                    const bool *is_dumped,
+                    ObEvalCtx &ctx,
+                    char **batch_old_rows,
+                    char **batch_new_rows,
+                    int64_t &agg_row_cnt,
+                    int64_t &agg_group_cnt,
+                    BatchAggrRowsTable *batch_aggr_rows,
+                    bool &has_new_row)
+  {
+    int ret = OB_SUCCESS;
+    has_new_row = false;
+    if (OB_ISNULL(gby_exprs.at(0))) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("get invalid ptr", K(ret));
+    } else {
+      vector_ptrs_.at(0) = gby_exprs.at(0)->get_vector(ctx);
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < child_brs.size_; ++i) {
+      if (child_brs.skip_->at(i) || is_dumped[i]) {
+        continue;
+      }
+      ++agg_row_cnt;
+      const int32_t idx = bkt_idxes_[i];
+      if (OB_ISNULL(grs_array_[idx])) {
+        ObCompactRow *srow = nullptr;
+        uint16_t row_idx = static_cast<uint16_t> (i);
+        if (OB_FAIL(group_store_.add_batch(vector_ptrs_, &row_idx, 1, &srow))) {
+          LOG_WARN("failed to add new rows", K(ret));
+        } else {
+          ObGroupRowItemVec *new_item = static_cast<ObGroupRowItemVec *> (&srow[0]);
+          batch_new_rows[i] = new_item->get_aggr_row(group_store_.get_row_meta());
+          grs_array_[idx] = batch_new_rows[i];
+          ser_num_array_[idx] = static_cast<int8_t>(size_);
+          CK (OB_NOT_NULL(batch_new_rows[i]));
+          has_new_row = true;
+          ++size_;
+          ++agg_group_cnt;
+        }
+      } else {
+        batch_old_rows[i] = grs_array_[idx];
+        if (batch_aggr_rows && batch_aggr_rows->is_valid()) {
+          if (size_ > BatchAggrRowsTable::MAX_REORDER_GROUPS) {
+            batch_aggr_rows->set_invalid();
+          } else {
+            int64_t ser_num = ser_num_array_[idx];
+            batch_aggr_rows->aggr_rows_[ser_num] = batch_old_rows[i];
+            batch_aggr_rows->selectors_[ser_num][batch_aggr_rows->selectors_item_cnt_[ser_num]++] = i;
+          }
+        }
+      }
+    }
+    return ret;
+  }
+
+  int init(ObIAllocator &allocator, ObEvalCtx &eval_ctx, const ObIArray<ObExpr*> &group_exprs)
+  {
+    int ret = OB_SUCCESS;
+    vector_ptrs_.set_allocator(&allocator);
+    if (OB_UNLIKELY(!is_supported(group_exprs))) {
+      ret = OB_ERR_UNEXPECTED;
+      SQL_ENG_LOG(WARN, "only support group by one integer expr", K(ret));
+    } else if (OB_ISNULL(grs_array_ = static_cast<char **>(allocator.alloc(
+                                                  sizeof(char *) * MAX_BKT_CNT)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      SQL_ENG_LOG(WARN, "allocate group row array memory failed", K(ret));
+    } else if (OB_ISNULL(ser_num_array_ = static_cast<int8_t *> (allocator.alloc(
+                                                  sizeof(int8_t) * MAX_BKT_CNT)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      SQL_ENG_LOG(WARN, "allocate ser num array memory failed", K(ret));
+    } else if (OB_ISNULL(bkt_idxes_ = static_cast<int32_t *> (allocator.alloc(
+                                                  sizeof(int32_t) * eval_ctx.max_batch_size_)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      SQL_ENG_LOG(WARN, "allocate bucket index array memory failed", K(ret));
+    } else if (OB_FAIL(vector_ptrs_.prepare_allocate(group_exprs.count()))) {
+      LOG_WARN("failed to init vector ptrs", K(ret));
+    } else {
+      alloc_ = &allocator;
+      is_valid_ = true;
+      max_batch_size_ = eval_ctx.max_batch_size_;
+      MEMSET(bkt_idxes_, 0, sizeof(int32_t) * max_batch_size_);
+      MEMSET(grs_array_, 0, sizeof(char *) * MAX_BKT_CNT);
+      MEMSET(ser_num_array_, 0, sizeof(int8_t) * MAX_BKT_CNT);
+    }
+    if (OB_FAIL(ret)) {
+      destroy_arrays(allocator);
+    }
+    return ret;
+  }
+
+  void reuse()
+  {
+    size_ = 0;
+    has_base_ = false;
+    base_ = 0;
+    MEMSET(grs_array_, 0, sizeof(char *) * MAX_BKT_CNT);
+    MEMSET(ser_num_array_, 0, sizeof(int8_t) * MAX_BKT_CNT);
+  }
+
+  void destroy()
+  {
+    vector_ptrs_.destroy();
+    if (nullptr != alloc_) {
+      destroy_arrays(*alloc_);
+      alloc_ = nullptr;
+    }
+  }
+  bool is_valid() const { return is_valid_; }
+  int64_t size() const { return size_; }
+  void set_invalid() { is_valid_ = false; }
+private:
+  OB_INLINE void locate_bucket(const int64_t batch_idx, const bool is_null, const char *payload,
+                               const bool is_int32)
+  {
+    if (is_null) {
+      bkt_idxes_[batch_idx] = BKT_IDX_FOR_NULL;
+    } else {
+      // unsigned arithmetic, the same for signed and unsigned values
+      const uint64_t val = is_int32
+        ? static_cast<uint64_t>(static_cast<int64_t>(*reinterpret_cast<const int32_t *>(payload)))
+        : *reinterpret_cast<const uint64_t *>(payload);
+      if (OB_UNLIKELY(!has_base_)) {
+        base_ = val - static_cast<uint64_t>(MAX_VALUE_CNT / 2);
+        has_base_ = true;
+      }
+      const uint64_t offset = val - base_;
+      if (offset < static_cast<uint64_t>(MAX_VALUE_CNT)) {
+        bkt_idxes_[batch_idx] = static_cast<int32_t>(offset);
+      } else {
+        set_invalid();
+      }
+    }
+  }
+  void destroy_arrays(ObIAllocator &allocator)
+  {
+    if (nullptr != grs_array_) {
+      allocator.free(grs_array_);
+      grs_array_ = nullptr;
+    }
+    if (nullptr != ser_num_array_) {
+      allocator.free(ser_num_array_);
+      ser_num_array_ = nullptr;
+    }
+    if (nullptr != bkt_idxes_) {
+      allocator.free(bkt_idxes_);
+      bkt_idxes_ = nullptr;
+    }
+  }
+private:
+  ObIAllocator *alloc_;
+  bool is_valid_;
+  bool has_base_;
+  uint64_t base_;
+  int32_t *bkt_idxes_;
+  char **grs_array_;
+  int8_t *ser_num_array_;
+  int64_t max_batch_size_;
+  int64_t size_;
+  ObTempRowStore &group_store_;
+  common::ObFixedArray<ObIVector *, common::ObIAllocator> vector_ptrs_;
+};
+
 // Auto extended hash table, extend to double buckets size if hash table is quarter filled.
 template <typename GroupRowBucket>
 class ObExtendHashTableVec
@@ -563,7 +813,8 @@ public:
       change_valid_idx_cnt_(0),
       srows_(nullptr),
       op_id_(-1),
-      sstr_aggr_(group_store_)
+      sstr_aggr_(group_store_),
+      sint_aggr_(group_store_)
   {
   }
   ~ObExtendHashTableVec() { destroy(); }
@@ -742,7 +993,8 @@ public:
           bool use_sstr_aggr,
           int64_t aggr_row_size,
           int64_t initial_size,
-          bool auto_extend);
+          bool auto_extend,
+          bool use_sint_aggr = false);
   int append_batch(const common::ObIArray<ObExpr *> &gby_exprs,
                    const ObBatchRows &child_brs,
                    const bool *is_dumped,
@@ -883,6 +1135,9 @@ public:
     if (sstr_aggr_.is_valid()) {
       sstr_aggr_.reuse();
     }
+    if (sint_aggr_.is_valid()) {
+      sint_aggr_.reuse();
+    }
     item_alloc_.reset_remain_one_page();
     probe_cnt_ = 0;
   }
@@ -905,6 +1160,7 @@ public:
       srows_ = nullptr;
     }
     sstr_aggr_.destroy();
+    sint_aggr_.destroy();
     vector_ptrs_.destroy();
     new_row_selector_.destroy();
     old_row_selector_.destroy();
@@ -929,9 +1185,10 @@ public:
   {
     return sizeof(GroupRowBucket);
   }
-  inline bool is_sstr_aggr_valid() const
+  // groups are located by direct indexed array, hash values are only calculated for new groups
+  inline bool is_direct_aggr_valid() const
   {
-    return sstr_aggr_.is_valid();
+    return sstr_aggr_.is_valid() || sint_aggr_.is_valid();
   }
   template <typename CB>
   int foreach_bucket_hash(CB &cb) const
@@ -1059,6 +1316,7 @@ protected:
   ObCompactRow **srows_;
   int64_t op_id_;
   ShortStringAggregator sstr_aggr_;
+  SmallIntAggregator sint_aggr_;
 };
 
 template <typename GroupRowBucket>
@@ -59,7 +59,8 @@ struct InitVisitor : public boost::static_visitor<int>
               bool use_sstr_aggr,
               int64_t aggr_row_size,
               int64_t initial_size,
-              bool auto_extend) : allocator_(allocator),
+              bool auto_extend,
+              bool use_sint_aggr) : allocator_(allocator),
                                   mem_attr_(mem_attr),
                                   gby_exprs_(gby_exprs),
                                   hash_expr_cnt_(hash_expr_cnt),
@@ -71,7 +72,8 @@ struct InitVisitor : public boost::static_visitor<int>
                                   aggr_row_size_(aggr_row_size),
                                   use_sstr_aggr_(use_sstr_aggr),
                                   initial_size_(initial_size),
-                                  auto_extend_(auto_extend) {}
+                                  auto_extend_(auto_extend),
+                                  use_sint_aggr_(use_sint_aggr) {}
   template <typename T>
   int operator() (T &t)
   {
@@ -87,7 +89,8 @@ struct InitVisitor : public boost::static_visitor<int>
                    use_sstr_aggr_,
                    aggr_row_size_,
                    initial_size_,
-                   auto_extend_);
+                   auto_extend_,
+                   use_sint_aggr_);
   }
   ObIAllocator *allocator_;
   lib::ObMemAttr &mem_attr_;
@@ -102,6 +105,7 @@ struct InitVisitor : public boost::static_visitor<int>
   bool use_sstr_aggr_;
   int64_t initial_size_;
   bool auto_extend_;
+  bool use_sint_aggr_;
 };
 
 struct GetBktNumVisitor : public boost::static_visitor<int64_t>
@@ -370,12 +374,12 @@ struct GetProbeCntVisitor : public boost::static_visitor<int64_t>
   }
 };
 
-struct IsSstrAggrValidVisitor : public boost::static_visitor<bool>
+struct IsDirectAggrValidVisitor : public boost::static_visitor<bool>
 {
   template <typename T>
   bool operator() (T &t) const
   {
-    return t->is_sstr_aggr_valid();
+    return t->is_direct_aggr_valid();
   }
 };
 
@@ -443,13 +447,14 @@ public:
            bool use_sstr_aggr,
            int64_t aggr_row_size,
            int64_t initial_size,
-           bool auto_extend)
+           bool auto_extend,
+           bool use_sint_aggr = false)
   {
     InitVisitor visitor(allocator, mem_attr, gby_exprs,
                         hash_expr_cnt, eval_ctx, max_batch_size,
                         nullable, all_int64, op_id,
                         use_sstr_aggr, aggr_row_size, initial_size,
-                        auto_extend);
+                        auto_extend, use_sint_aggr);
     return boost::apply_visitor(visitor, hash_table_ptr_);
   }
 
@@ -589,9 +594,9 @@ public:
     return boost::apply_visitor(visitor, hash_table_ptr_);
   }
 
-  bool is_sstr_aggr_valid() const
+  bool is_direct_aggr_valid() const
   {
-    IsSstrAggrValidVisitor visitor;
+    IsDirectAggrValidVisitor visitor;
     return boost::apply_visitor(visitor, hash_table_ptr_);
   }
 
@@ -127,6 +127,10 @@ int ObHashGroupByVecOp::inner_open()
         }
       }
     }
+    // ndv is no more than size of value domain, don't try direct aggregation if ndv is too large
+    bool use_sint_aggr = !use_sstr_aggr_
+                         && MY_SPEC.est_group_cnt_ < SmallIntAggregator::MAX_VALUE_CNT
+                         && SmallIntAggregator::is_supported(MY_SPEC.group_exprs_);
     if (OB_FAIL(local_group_rows_.prepare_hash_table(max_row_size,
                                                      attr.tenant_id_,
                                                      mem_context_->get_arena_allocator()))) {
@@ -175,7 +179,8 @@ int ObHashGroupByVecOp::inner_open()
                 use_sstr_aggr_,
                 aggr_processor_.get_aggregate_row_size() + sizeof(int64_t),
                 init_size,
-                true))) {
+                true,
+                use_sint_aggr))) {
       LOG_WARN("fail to init hash map", K(ret));
     } else if (OB_FAIL(sql_mem_processor_.update_used_mem_size(get_mem_used_size()))) {
       LOG_WARN("fail to update_used_mem_size", "size", get_mem_used_size(), K(ret));
@@ -1483,7 +1488,7 @@ int ObHashGroupByVecOp::load_data_batch(int64_t max_row_cnt)
   }
 
   row_store_iter.reset();
-  if (OB_SUCC(ret) && llc_est_.enabled_ && local_group_rows_.is_sstr_aggr_valid()) {
+  if (OB_SUCC(ret) && llc_est_.enabled_ && local_group_rows_.is_direct_aggr_valid()) {
     llc_est_.enabled_ = false;// do not need llc, ndv must less then 65535
   }
   if (OB_FAIL(ret)) {
@@ -1775,13 +1780,13 @@ int ObHashGroupByVecOp::batch_process_duplicate_data(
       int64_t new_group_cnt = 0;
       memset(static_cast<void *> (batch_old_rows_), 0, sizeof(char *) * MY_SPEC.max_batch_size_);
       memset(static_cast<void *> (batch_new_rows_), 0, sizeof(char *) * MY_SPEC.max_batch_size_);
-      if (nullptr == store_rows && !local_group_rows_.is_sstr_aggr_valid()) {
+      if (nullptr == store_rows && !local_group_rows_.is_direct_aggr_valid()) {
         ret = calc_groupby_exprs_hash_batch(dup_groupby_exprs_, child_brs);
         local_group_rows_.prefetch(child_brs, hash_vals_);
       }
       bool can_append_batch = (NULL == bloom_filter
                               && (!enable_dump_
-                                || local_group_rows_.is_sstr_aggr_valid()
+                                || local_group_rows_.is_direct_aggr_valid()
                                 || local_group_rows_.size() < MIN_INMEM_GROUPS
                                 || process_check_dump
                                 || !need_start_dump(input_rows, est_part_cnt, force_check_dump)));
@@ -2061,7 +2066,7 @@ int ObHashGroupByVecOp::group_child_batch_rows(const ObCompactRow **store_rows,
   } else if ((ObThreeStageAggrStage::SECOND_STAGE == MY_SPEC.aggr_stage_ && !use_distinct_data_)
               && FALSE_IT(aggr_code_vec = aggr_code_expr->get_vector(eval_ctx_))) {
   } else {
-    if (nullptr == store_rows && !local_group_rows_.is_sstr_aggr_valid()) {
+    if (nullptr == store_rows && !local_group_rows_.is_direct_aggr_valid()) {
       ret = calc_groupby_exprs_hash_batch(dup_groupby_exprs_, child_brs);
       local_group_rows_.prefetch(child_brs, hash_vals_);
     }
@@ -2095,7 +2100,7 @@ int ObHashGroupByVecOp::group_child_batch_rows(const ObCompactRow **store_rows,
     }
     bool can_append_batch = (NULL == bloom_filter
                             && (!enable_dump_
-                              || local_group_rows_.is_sstr_aggr_valid()
+                              || local_group_rows_.is_direct_aggr_valid()
                               || local_group_rows_.size() < MIN_INMEM_GROUPS
                               || process_check_dump
                               || !need_start_dump(input_rows, est_part_cnt, force_check_dump)));
@@ -802,6 +802,7 @@ public:
   ~ObBlackFilterExecutor();
 
   OB_INLINE ObPushdownBlackFilterNode &get_filter_node() { return filter_; }
+  OB_INLINE const ObPushdownBlackFilterNode &get_filter_node() const { return filter_; }
   OB_INLINE virtual common::ObIArray<uint64_t> &get_col_ids() override
   { return filter_.get_col_ids(); }
   virtual const common::ObIArray<ObExpr *> *get_cg_col_exprs() const override { return &filter_.column_exprs_; }
@@ -14,7 +14,11 @@
 #define SRC_SQL_ENGINE_JOIN_HASH_JOIN_HASH_TABLE_H_
 
 #include "sql/engine/join/hash_join/ob_hash_join_struct.h"
+#include "sql/engine/join/hash_join/ob_hj_partition_mgr.h"
 #include "lib/atomic/ob_atomic.h"
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
 
 namespace oceanbase
 {
@@ -82,7 +86,7 @@ struct Int128Key {
     data_1_ = *(reinterpret_cast<const int64_t *>(row->get_cell_payload(row_meta, key_proj->at(1))));
   }
   inline bool operator==(const Int128Key &other) const {
-    return data_0_ == other.data_0_ && data_1_ == data_1_;
+    return data_0_ == other.data_0_ && data_1_ == other.data_1_;
   }
   TO_STRING_KV(K_(data_0), K_(data_1));
 
@@ -290,6 +294,10 @@ struct IHashTable {
   virtual int64_t get_one_bucket_size() const = 0;
   virtual int64_t get_normalized_key_size() const = 0;
   virtual void set_diag_info(int64_t used_buckets, int64_t collisions) = 0;
+  // radix partitioned build of the shared table, only supported by GenericRadixSharedHashTable
+  virtual int radix_prepare(JoinTableCtx &ctx) { UNUSED(ctx); return OB_NOT_SUPPORTED; }
+  virtual int build_radix_partitions(JoinTableCtx &ctx) { UNUSED(ctx); return OB_NOT_SUPPORTED; }
+  virtual int build_radix_overflow(JoinTableCtx &ctx) { UNUSED(ctx); return OB_NOT_SUPPORTED; }
 };
 
 // Open addressing hash table implement:
@@ -377,6 +385,12 @@ protected:
     int64_t idx = __sync_fetch_and_add(&item_pos_, 1);
     return &items_->at(idx);
   }
+  // performance critical, do not double check the parameters
+  OB_INLINE void set(JoinTableCtx &ctx,
+                     const uint64_t hash_val,
+                     ObHJStoredRow *row,
+                     int64_t &used_buckets,
+                     int64_t &collisions);
 private:
   int init_probe_key_data(JoinTableCtx &ctx, OutputInfo &output_info);
   Item *new_item() { return &items_->at(item_pos_++); }
@@ -389,12 +403,6 @@ private:
   void get(uint64_t hash_val, Bucket *&bkt, int64_t &bkt_pos);
 
   void get(uint64_t hash_val, Bucket *&bkt);
-  // performance critical, do not double check the parameters
-  OB_INLINE void set(JoinTableCtx &ctx,
-                     const uint64_t hash_val,
-                     ObHJStoredRow *row,
-                     int64_t &used_buckets,
-                     int64_t &collisions);
 
   // mark delete, can not add row again after delete
   void del(const uint64_t hash_val, const RowMeta &row_meta, Item *item);
@@ -438,6 +446,65 @@ private:
                         int64_t &collisions);
 };
 
+// Radix partitioned build of the shared hash table, it avoids the atomic writes and the cache
+// line contention of GenericSharedHashTable when many workers build one table:
+//
+//   1. insert_batch: every worker partitions its build rows into its own ObHJRadixPartitions,
+//      the partition of a row is the high bits of its bucket position, so partition p owns
+//      the buckets [p << part_shift_, (p + 1) << part_shift_).
+//   2. build_radix_partitions: after all workers finish partitioning, worker w inserts the rows
+//      of the partitions p (p % task_cnt == w) of all workers, linear probing is bounded in the
+//      bucket range of the partition, so no bucket is written by two workers.
+//   3. build_radix_overflow: rows can not find a bucket before the end of the range of their
+//      partition are inserted at last by one worker with normal linear probing.
+//
+// Probes are routed to the partition by the same bits of the bucket position, the probe path
+// is the same as GenericTable.
+struct GenericRadixSharedHashTable final : public HashTable<GenericBucket, GenericProber>
+{
+public:
+  // 1024 buckets (16KB) per partition at least, and 1024 partitions at most
+  static const int64_t MIN_PART_BUCKET_BITS = 10;
+  static const int64_t MAX_PART_BITS = 10;
+
+  explicit GenericRadixSharedHashTable(const int64_t task_cnt)
+      : task_cnt_(task_cnt),
+        part_cnt_(0),
+        part_shift_(0),
+        task_parts_(nullptr)
+  {
+  }
+  int init(ObIAllocator &alloc, const int64_t max_batch_size) override;
+  int build_prepare(int64_t row_count, int64_t bucket_count) override;
+  inline int insert_batch(JoinTableCtx &ctx,
+                          ObHJStoredRow **stored_rows,
+                          const int64_t size,
+                          int64_t &used_buckets,
+                          int64_t &collisions) override;
+  inline virtual void set_diag_info(int64_t used_buckets, int64_t collisions) override {
+    ATOMIC_AAF(&used_buckets_, used_buckets);
+    ATOMIC_AAF(&collisions_, collisions);
+  }
+  int radix_prepare(JoinTableCtx &ctx) override;
+  int build_radix_partitions(JoinTableCtx &ctx) override;
+  int build_radix_overflow(JoinTableCtx &ctx) override;
+  void free(ObIAllocator *alloc) override;
+private:
+  // performance critical, do not double check the parameters
+  // return false if no bucket left in the range of %part_idx
+  OB_INLINE bool set_in_part(const RowMeta &row_meta,
+                             const int64_t part_idx,
+                             GenericItem *item,
+                             int64_t &used_buckets,
+                             int64_t &collisions);
+private:
+  int64_t task_cnt_;
+  int64_t part_cnt_;
+  int64_t part_shift_;
+  // radix partitions of every worker, registered by radix_prepare
+  ObHJRadixPartitions **task_parts_;
+};
+
 template <typename Bucket, typename Prober>
 struct NormalizedSharedHashTable final : public HashTable<Bucket, Prober>
 {
@@ -457,6 +524,120 @@ private:
                         ObHJStoredRow *sr, int64_t &used_buckets, int64_t &collisions);
 };
 
+// Tagged open addressing hash table for normalized keys:
+//
+//   tag groups:                              slots:
+//   +-----------------------------+          +-------------------------------+
+//   | t0 | t1 | ...         | t15 |   <==>   | Item0 | Item1 | ...   | Item15|
+//   +-----------------------------+          +-------------------------------+      +------+
+//   | t0 | EMPTY | ...      | t15 |   <==>   | Item0 | ...                   |----->| Item |
+//   +-----------------------------+          +-------------------------------+      +------+
+//   ......
+//
+// Every slot holds one distinct key inline, build rows of the same key are chained from the slot.
+// The tag of a slot is EMPTY or the high 7 bits of the hash value, tags are kept apart from
+// slots so that one SIMD compare filters 16 slots, keys are compared only if tag matched,
+// and a probe touches no stored row memory until the key matched.
+// Only the probe_opt path of normalized keys is supported.
+template <typename T>
+struct TaggedHashTable final : public IHashTable
+{
+  using Item = NormalizedItem<T>;
+  static const int64_t GROUP_SIZE = 16;
+  static const uint8_t EMPTY_TAG = 0x80;
+  struct TagGroup {
+    TagGroup() { MEMSET(tags_, EMPTY_TAG, sizeof(tags_)); }
+    // bitmap of slots whose tag equals to %tag
+    inline uint16_t match(const uint8_t tag) const;
+    inline uint16_t match_empty() const { return match(EMPTY_TAG); }
+    TO_STRING_KV(K(sizeof(tags_)));
+    uint8_t tags_[GROUP_SIZE];
+  };
+
+  TaggedHashTable()
+      : tag_groups_(nullptr),
+        slots_(nullptr),
+        items_(nullptr),
+        ngroups_(0),
+        row_count_(0),
+        collisions_(0),
+        used_buckets_(0),
+        item_pos_(0),
+        inited_(false),
+        ht_alloc_(nullptr)
+  {
+  }
+  int init(ObIAllocator &alloc, const int64_t max_batch_size) override;
+  int build_prepare(int64_t row_count, int64_t bucket_count) override;
+  int insert_batch(JoinTableCtx &ctx,
+                   ObHJStoredRow **stored_rows,
+                   const int64_t size,
+                   int64_t &used_buckets,
+                   int64_t &collisions) override;
+  int probe_prepare(JoinTableCtx &ctx, OutputInfo &output_info) override;
+  int probe_batch(JoinTableCtx &ctx, OutputInfo &output_info) override;
+  int project_matched_rows(JoinTableCtx &ctx, OutputInfo &output_info) override;
+  int get_unmatched_rows(JoinTableCtx &ctx, OutputInfo &output_info) override;
+  void reset() override;
+  void free(ObIAllocator *alloc) override;
+
+  int64_t get_row_count() const override { return row_count_; }
+  int64_t get_used_buckets() const override { return used_buckets_; }
+  int64_t get_nbuckets() const override { return ngroups_ * GROUP_SIZE; }
+  int64_t get_collisions() const override { return collisions_; }
+  int64_t get_mem_used() const override {
+    int64_t size = sizeof(*this);
+    if (NULL != tag_groups_) {
+      size += tag_groups_->mem_used();
+    }
+    if (NULL != slots_) {
+      size += slots_->mem_used();
+    }
+    if (NULL != items_) {
+      size += items_->mem_used();
+    }
+    return size;
+  }
+  int64_t get_one_bucket_size() const override { return sizeof(Item) + sizeof(uint8_t); }
+  int64_t get_normalized_key_size() const override { return sizeof(T); }
+  void set_diag_info(int64_t used_buckets, int64_t collisions) override {
+    used_buckets_ += used_buckets;
+    collisions_ += collisions;
+  }
+  using TagGroupArray =
+    common::ObSegmentArray<TagGroup, OB_MALLOC_MIDDLE_BLOCK_SIZE, common::ModulePageAllocator>;
+  using ItemArray =
+    common::ObSegmentArray<Item, OB_MALLOC_MIDDLE_BLOCK_SIZE, common::ModulePageAllocator>;
+private:
+  // hash values are truncated to HASH_VAL_BIT bits by ObHJStoredRow, take the highest 7 valid bits
+  static inline uint8_t get_tag(const uint64_t hash_val)
+  {
+    return (hash_val >> (ObHJStoredRow::HASH_VAL_BIT - 7)) & 0x7F;
+  }
+  Item *new_item() { return &items_->at(item_pos_++); }
+  // performance critical, do not double check the parameters
+  OB_INLINE void set(JoinTableCtx &ctx,
+                     const uint64_t hash_val,
+                     ObHJStoredRow *row,
+                     int64_t &used_buckets,
+                     int64_t &collisions);
+  // return the slot of %key, or END_ITEM if not found.
+  OB_INLINE Item *find(const uint64_t hash_val, const T &key);
+  int probe_batch_opt(JoinTableCtx &ctx, OutputInfo &output_info);
+private:
+  TagGroupArray *tag_groups_;
+  ItemArray *slots_;
+  // items of duplicated keys, chained from the slot
+  ItemArray *items_;
+  int64_t ngroups_;
+  int64_t row_count_;
+  int64_t collisions_;
+  int64_t used_buckets_;
+  int64_t item_pos_;
+  bool inited_;
+  ModulePageAllocator *ht_alloc_;
+};
+
 //using DirectInt8Table = HashTable<DirectBucket<int8_t>, NormalizedProber<int8_t>>;
 //using DirectInt16Table = HashTable<DirectBucket<int16_t>, NormalizedProber<int16_t>>;
 //using NormalizedInt32Table = HashTable<NormalizedBucket<int32_t>, NormalizedProber<int32_t>>;
@@ -467,6 +648,8 @@ using NormalizedInt128Table = HashTable<NormalizedBucket<Int128Key>, NormalizedP
 using GenericTable = HashTable<GenericBucket, GenericProber>;
 using NormalizedSharedInt64Table = NormalizedSharedHashTable<NormalizedBucket<Int64Key>, NormalizedProber<Int64Key>>;
 using NormalizedSharedInt128Table = NormalizedSharedHashTable<NormalizedBucket<Int128Key>, NormalizedProber<Int128Key>>;
+using NormalizedTaggedInt64Table = TaggedHashTable<Int64Key>;
+using NormalizedTaggedInt128Table = TaggedHashTable<Int128Key>;
 
 } // end namespace sql
 } // end namespace oceanbase
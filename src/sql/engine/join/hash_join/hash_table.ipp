@@ -579,6 +579,372 @@ int HashTable<Bucket, Prober>::get_unmatched_rows(JoinTableCtx &ctx, OutputInfo
   return ret;
 }
 
+template <typename T>
+inline uint16_t TaggedHashTable<T>::TagGroup::match(const uint8_t tag) const
+{
+#if defined(__x86_64__)
+  const __m128i tags = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tags_));
+  return static_cast<uint16_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(tags, _mm_set1_epi8(tag))));
+#else
+  uint16_t mask = 0;
+  for (int64_t i = 0; i < GROUP_SIZE; i++) {
+    mask |= static_cast<uint16_t>(tags_[i] == tag) << i;
+  }
+  return mask;
+#endif
+}
+
+template <typename T>
+int TaggedHashTable<T>::init(ObIAllocator &alloc, const int64_t max_batch_size)
+{
+  int ret = OB_SUCCESS;
+  UNUSED(max_batch_size);
+  if (!inited_) {
+    void *alloc_buf = alloc.alloc(sizeof(ModulePageAllocator));
+    void *group_buf = alloc.alloc(sizeof(TagGroupArray));
+    void *slot_buf = alloc.alloc(sizeof(ItemArray));
+    void *item_buf = alloc.alloc(sizeof(ItemArray));
+    if (OB_ISNULL(alloc_buf) || OB_ISNULL(group_buf) || OB_ISNULL(slot_buf) || OB_ISNULL(item_buf)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      if (OB_NOT_NULL(alloc_buf)) {
+        alloc.free(alloc_buf);
+      }
+      if (OB_NOT_NULL(group_buf)) {
+        alloc.free(group_buf);
+      }
+      if (OB_NOT_NULL(slot_buf)) {
+        alloc.free(slot_buf);
+      }
+      if (OB_NOT_NULL(item_buf)) {
+        alloc.free(item_buf);
+      }
+      LOG_WARN("failed to alloc memory", K(ret));
+    } else {
+      ht_alloc_ = new (alloc_buf) ModulePageAllocator(alloc);
+      ht_alloc_->set_label("HtOpAlloc");
+      tag_groups_ = new (group_buf) TagGroupArray(*ht_alloc_);
+      slots_ = new (slot_buf) ItemArray(*ht_alloc_);
+      items_ = new (item_buf) ItemArray(*ht_alloc_);
+      item_pos_ = 0;
+      inited_ = true;
+    }
+  }
+
+  return ret;
+}
+
+template <typename T>
+int TaggedHashTable<T>::build_prepare(int64_t row_count, int64_t bucket_count)
+{
+  int ret = OB_SUCCESS;
+  // keep at least one empty slot in every probe sequence, the load factor is at most 0.5
+  int64_t nslots = std::max(bucket_count, row_count * 2);
+  nslots = std::max(static_cast<int64_t>(next_pow2(nslots)), GROUP_SIZE);
+  row_count_ = row_count;
+  ngroups_ = std::max(ngroups_, nslots / GROUP_SIZE);
+  collisions_ = 0;
+  used_buckets_ = 0;
+  tag_groups_->reuse();
+  slots_->reuse();
+  items_->reuse();
+  item_pos_ = 0;
+  OZ (tag_groups_->init(ngroups_));
+  OZ (slots_->init(ngroups_ * GROUP_SIZE));
+  OZ (items_->init(row_count));
+
+  LOG_DEBUG("build prepare", K(row_count), K(bucket_count), K_(ngroups), K(sizeof(Item)));
+  return ret;
+}
+
+template <typename T>
+void TaggedHashTable<T>::set(JoinTableCtx &ctx,
+                             const uint64_t hash_val,
+                             ObHJStoredRow *row,
+                             int64_t &used_buckets,
+                             int64_t &collisions)
+{
+  const RowMeta &row_meta = ctx.build_row_meta_;
+  const uint8_t tag = get_tag(hash_val);
+  const uint64_t mask = ngroups_ - 1;
+  T key;
+  key.init_data(ctx.build_key_proj_, row_meta, row);
+  uint64_t group_idx = hash_val & mask;
+  bool done = false;
+  for (int64_t i = 0; !done && i < ngroups_; i += 1, group_idx = ((group_idx + 1) & mask)) {
+    TagGroup &group = tag_groups_->at(group_idx);
+    uint16_t match_mask = group.match(tag);
+    while (0 != match_mask) {
+      const int64_t slot_idx = group_idx * GROUP_SIZE + __builtin_ctz(match_mask);
+      Item &slot = slots_->at(slot_idx);
+      if (slot.key_ == key) {
+        // same key, chain the row after the slot
+        Item *item = new_item();
+        item->init(ctx, row_meta, row, slot.get_next(row_meta));
+        slot.set_next(row_meta, item);
+        done = true;
+        break;
+      }
+      match_mask &= (match_mask - 1);
+    }
+    if (!done) {
+      const uint16_t empty_mask = group.match_empty();
+      if (0 != empty_mask) {
+        const int64_t pos = __builtin_ctz(empty_mask);
+        Item &slot = slots_->at(group_idx * GROUP_SIZE + pos);
+        slot.init(ctx, row_meta, row, reinterpret_cast<Item *>(END_ITEM));
+        group.tags_[pos] = tag;
+        used_buckets += 1;
+        done = true;
+      } else {
+        collisions += 1;
+      }
+    }
+  }
+}
+
+template <typename T>
+OB_INLINE typename TaggedHashTable<T>::Item *TaggedHashTable<T>::find(const uint64_t hash_val,
+                                                                       const T &key)
+{
+  const uint8_t tag = get_tag(hash_val);
+  const uint64_t mask = ngroups_ - 1;
+  Item *item = reinterpret_cast<Item *>(END_ITEM);
+  uint64_t group_idx = hash_val & mask;
+  bool done = false;
+  for (int64_t i = 0; !done && i < ngroups_; i += 1, group_idx = ((group_idx + 1) & mask)) {
+    const TagGroup &group = tag_groups_->at(group_idx);
+    uint16_t match_mask = group.match(tag);
+    while (0 != match_mask) {
+      Item &slot = slots_->at(group_idx * GROUP_SIZE + __builtin_ctz(match_mask));
+      if (slot.key_ == key) {
+        item = &slot;
+        done = true;
+        break;
+      }
+      match_mask &= (match_mask - 1);
+    }
+    // the key can not be in the following groups if this group has empty slot
+    if (!done && 0 != group.match_empty()) {
+      done = true;
+    }
+  }
+  return item;
+}
+
+template <typename T>
+void TaggedHashTable<T>::reset()
+{
+  if (OB_NOT_NULL(tag_groups_)) {
+    tag_groups_->reset();
+  }
+  if (OB_NOT_NULL(slots_)) {
+    slots_->reset();
+  }
+  if (OB_NOT_NULL(items_)) {
+    items_->reset();
+  }
+  ngroups_ = 0;
+  collisions_ = 0;
+  used_buckets_ = 0;
+  item_pos_ = 0;
+}
+
+template <typename T>
+void TaggedHashTable<T>::free(ObIAllocator *alloc)
+{
+  reset();
+  if (OB_NOT_NULL(tag_groups_)) {
+    tag_groups_->destroy();
+    alloc->free(tag_groups_);
+    tag_groups_ = nullptr;
+  }
+  if (OB_NOT_NULL(slots_)) {
+    slots_->destroy();
+    alloc->free(slots_);
+    slots_ = nullptr;
+  }
+  if (OB_NOT_NULL(items_)) {
+    items_->destroy();
+    alloc->free(items_);
+    items_ = nullptr;
+  }
+  if (OB_NOT_NULL(ht_alloc_)) {
+    ht_alloc_->reset();
+    ht_alloc_->~ModulePageAllocator();
+    alloc->free(ht_alloc_);
+    ht_alloc_ = nullptr;
+  }
+  inited_ = false;
+}
+
+template <typename T>
+int TaggedHashTable<T>::insert_batch(JoinTableCtx &ctx,
+                                     ObHJStoredRow **stored_rows,
+                                     const int64_t size,
+                                     int64_t &used_buckets,
+                                     int64_t &collisions)
+{
+  int ret = OB_SUCCESS;
+  const uint64_t mask = ngroups_ - 1;
+  for (int64_t i = 0; i < size; i++) {
+    __builtin_prefetch(&tag_groups_->at(stored_rows[i]->get_hash_value(ctx.build_row_meta_) & mask),
+                       1 /* write */, 3 /* high temporal locality*/);
+  }
+  for (int64_t i = 0; i < size; ++i) {
+    set(ctx, stored_rows[i]->get_hash_value(ctx.build_row_meta_),
+        stored_rows[i], used_buckets, collisions);
+    LOG_DEBUG("build row", K(i), KP(stored_rows[i]),
+        "hash_val", stored_rows[i]->get_hash_value(ctx.build_row_meta_),
+        "row", ToStrCompactRow(ctx.build_row_meta_, *stored_rows[i], ctx.build_output_),
+        "row_meta", ctx.build_row_meta_);
+  }
+
+  return ret;
+}
+
+template <typename T>
+int TaggedHashTable<T>::probe_prepare(JoinTableCtx &ctx, OutputInfo &output_info)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(ctx.probe_batch_rows_->set_key_data(ctx.probe_keys_,
+                                                  ctx.eval_ctx_,
+                                                  output_info))) {
+    LOG_WARN("fail to init probe keys", K(ret));
+  }
+
+  return ret;
+}
+
+template <typename T>
+int TaggedHashTable<T>::probe_batch(JoinTableCtx &ctx, OutputInfo &output_info)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!ctx.probe_opt_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("tagged hash table only support probe opt", K(ret));
+  } else if (OB_FAIL(probe_batch_opt(ctx, output_info))) {
+    LOG_WARN("fail to probe batch", K(ret));
+  }
+
+  return ret;
+}
+
+template <typename T>
+int TaggedHashTable<T>::probe_batch_opt(JoinTableCtx &ctx, OutputInfo &output_info)
+{
+  int ret = OB_SUCCESS;
+  const RowMeta &row_meta = ctx.build_row_meta_;
+  if (output_info.first_probe_) {
+    uint64_t *hash_vals = ctx.probe_batch_rows_->hash_vals_;
+    const T *keys = reinterpret_cast<const T *>(ctx.probe_batch_rows_->key_data_);
+    const uint64_t mask = ngroups_ - 1;
+    // 1. prefetch tag groups of the whole batch
+    for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
+      __builtin_prefetch(&tag_groups_->at(hash_vals[output_info.selector_[i]] & mask),
+                         0, 1 /*low temporal locality*/);
+    }
+    // 2. filter by tags, prefetch the first candidate slot
+    for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
+      const uint64_t hash_val = hash_vals[output_info.selector_[i]];
+      const uint64_t group_idx = hash_val & mask;
+      const uint16_t match_mask = tag_groups_->at(group_idx).match(get_tag(hash_val));
+      if (0 != match_mask) {
+        __builtin_prefetch(&slots_->at(group_idx * GROUP_SIZE + __builtin_ctz(match_mask)),
+                           0, 1 /*low temporal locality*/);
+      }
+    }
+    // 3. compare keys, all items of a slot have the same key
+    int64_t new_selector_cnt = 0;
+    int64_t batch_idx = 0;
+    Item *item = NULL;
+    for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
+      batch_idx = output_info.selector_[i];
+      item = find(hash_vals[batch_idx], keys[batch_idx]);
+      if (END_ITEM != reinterpret_cast<uint64_t>(item)) {
+        output_info.left_result_rows_[new_selector_cnt] = item->get_stored_row();
+        ctx.cur_items_[new_selector_cnt] = item->get_next(row_meta);
+        output_info.selector_[new_selector_cnt++] = batch_idx;
+        if (ctx.need_mark_match()) {
+          item->set_is_match(row_meta, true);
+        }
+      }
+      LOG_DEBUG("first probe", KP(item), K(i), K(new_selector_cnt), K(batch_idx),
+                K(hash_vals[batch_idx]), K(output_info.selector_cnt_));
+    }
+    output_info.selector_cnt_ = new_selector_cnt;
+    output_info.first_probe_ = false;
+  } else {
+    for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
+      if (END_ITEM != reinterpret_cast<uint64_t>(ctx.cur_items_[i])) {
+        __builtin_prefetch(ctx.cur_items_[i], 0 /* for read */, 1 /* low temporal locality */);
+      }
+    }
+    int64_t new_selector_cnt = 0;
+    for (int64_t i = 0; i < output_info.selector_cnt_; i++) {
+      Item *item = reinterpret_cast<Item *>(ctx.cur_items_[i]);
+      OB_ASSERT(NULL != item);
+      if (END_ITEM != reinterpret_cast<uint64_t>(item)) {
+        output_info.left_result_rows_[new_selector_cnt] = item->get_stored_row();
+        ctx.cur_items_[new_selector_cnt] = item->get_next(row_meta);
+        output_info.selector_[new_selector_cnt++] = output_info.selector_[i];
+        if (ctx.need_mark_match()) {
+          item->set_is_match(row_meta, true);
+        }
+      }
+    }
+    output_info.selector_cnt_ = new_selector_cnt;
+  }
+  return ret;
+}
+
+template <typename T>
+int TaggedHashTable<T>::project_matched_rows(JoinTableCtx &ctx, OutputInfo &output_info)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(ObHJStoredRow::attach_rows(*ctx.build_output_,
+                                         *ctx.eval_ctx_,
+                                         ctx.build_row_meta_,
+                                         output_info.left_result_rows_,
+                                         output_info.selector_,
+                                         output_info.selector_cnt_))) {
+    LOG_WARN("fail to attach rows",  K(ret));
+  }
+
+  return ret;
+}
+
+template <typename T>
+int TaggedHashTable<T>::get_unmatched_rows(JoinTableCtx &ctx, OutputInfo &output_info)
+{
+  int ret = OB_SUCCESS;
+  Item *item = reinterpret_cast<Item *>(ctx.cur_tuple_);
+  int64_t batch_idx = 0;
+  const int64_t nslots = ngroups_ * GROUP_SIZE;
+  while (OB_SUCC(ret) && batch_idx < *ctx.max_output_cnt_) {
+    if (END_ITEM != reinterpret_cast<uint64_t>(item)) {
+      if (!item->is_match(ctx.build_row_meta_)) {
+        output_info.left_result_rows_[batch_idx] = item->get_stored_row();
+        batch_idx++;
+      }
+      item = item->get_next(ctx.build_row_meta_);
+    } else {
+      int64_t slot_idx = ctx.cur_bkid_ + 1;
+      if (slot_idx < nslots) {
+        const TagGroup &group = tag_groups_->at(slot_idx / GROUP_SIZE);
+        item = EMPTY_TAG != group.tags_[slot_idx % GROUP_SIZE]
+               ? &slots_->at(slot_idx) : reinterpret_cast<Item *>(END_ITEM);
+        ctx.cur_bkid_ = slot_idx;
+      } else {
+        ret = OB_ITER_END;
+      }
+    }
+  }
+  output_info.selector_cnt_ = batch_idx;
+  ctx.cur_tuple_ = item;
+
+  return ret;
+}
+
 template<typename Item>
 int ProberBase<Item>::calc_join_conditions(JoinTableCtx &ctx,
                                            ObHJStoredRow *left_row,
@@ -707,6 +1073,173 @@ inline int GenericSharedHashTable::atomic_set(const uint64_t hash_val,
   return ret;
 }
 
+inline int GenericRadixSharedHashTable::init(ObIAllocator &alloc, const int64_t max_batch_size)
+{
+  int ret = OB_SUCCESS;
+  if (inited_) {
+    // do nothing
+  } else if (OB_UNLIKELY(task_cnt_ <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid task count", K(ret), K_(task_cnt));
+  } else if (OB_FAIL(HashTable::init(alloc, max_batch_size))) {
+    LOG_WARN("failed to init hash table", K(ret));
+  } else if (OB_ISNULL(task_parts_ = static_cast<ObHJRadixPartitions **>(
+                           alloc.alloc(sizeof(ObHJRadixPartitions *) * task_cnt_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc radix partitions of tasks", K(ret), K_(task_cnt));
+  } else {
+    MEMSET(task_parts_, 0, sizeof(ObHJRadixPartitions *) * task_cnt_);
+  }
+  return ret;
+}
+
+inline int GenericRadixSharedHashTable::build_prepare(int64_t row_count, int64_t bucket_count)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(HashTable::build_prepare(row_count, bucket_count))) {
+    LOG_WARN("failed to prepare hash table", K(ret));
+  } else if (OB_UNLIKELY(nbuckets_ <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected bucket count", K(ret), K_(nbuckets));
+  } else {
+    const int64_t bucket_bits = __builtin_ctzll(nbuckets_);
+    part_shift_ = std::min(bucket_bits, std::max(MIN_PART_BUCKET_BITS, bucket_bits - MAX_PART_BITS));
+    part_cnt_ = 1L << (bucket_bits - part_shift_);
+    LOG_TRACE("radix build prepare", K(row_count), K_(nbuckets), K_(part_cnt), K_(part_shift));
+  }
+  return ret;
+}
+
+inline int GenericRadixSharedHashTable::radix_prepare(JoinTableCtx &ctx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(ctx.radix_parts_)
+      || OB_UNLIKELY(ctx.task_idx_ < 0 || ctx.task_idx_ >= task_cnt_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected radix build context", K(ret), KP(ctx.radix_parts_), K(ctx.task_idx_),
+             K_(task_cnt));
+  } else if (OB_FAIL(ctx.radix_parts_->prepare(part_cnt_))) {
+    LOG_WARN("failed to prepare radix partitions", K(ret), K_(part_cnt));
+  } else {
+    task_parts_[ctx.task_idx_] = ctx.radix_parts_;
+  }
+  return ret;
+}
+
+inline int GenericRadixSharedHashTable::insert_batch(JoinTableCtx &ctx,
+                                                     ObHJStoredRow **stored_rows,
+                                                     const int64_t size,
+                                                     int64_t &used_buckets,
+                                                     int64_t &collisions)
+{
+  int ret = OB_SUCCESS;
+  UNUSED(used_buckets);
+  UNUSED(collisions);
+  const uint64_t mask = nbuckets_ - 1;
+  ObHJRadixPartitions &parts = *ctx.radix_parts_;
+  for (int64_t i = 0; OB_SUCC(ret) && i < size; ++i) {
+    const int64_t part_idx = (stored_rows[i]->get_hash_value(ctx.build_row_meta_) & mask) >> part_shift_;
+    ret = parts.add_row(part_idx, stored_rows[i]);
+  }
+  return ret;
+}
+
+inline bool GenericRadixSharedHashTable::set_in_part(const RowMeta &row_meta,
+                                                     const int64_t part_idx,
+                                                     GenericItem *item,
+                                                     int64_t &used_buckets,
+                                                     int64_t &collisions)
+{
+  bool added = false;
+  GenericBucket new_bucket;
+  new_bucket.hash_value_ = item->get_hash_value(row_meta);
+  const uint64_t end = static_cast<uint64_t>(part_idx + 1) << part_shift_;
+  for (uint64_t pos = new_bucket.hash_value_ & (nbuckets_ - 1); !added && pos < end; ++pos) {
+    GenericBucket &bucket = buckets_->at(pos);
+    if (!bucket.used()) {
+      item->set_next(row_meta, reinterpret_cast<Item *>(END_ITEM));
+      bucket.set_item(item);
+      bucket.hash_value_ = new_bucket.hash_value_;
+      bucket.set_used(true);
+      ++used_buckets;
+      added = true;
+    } else if (bucket.hash_value_ == new_bucket.hash_value_) {
+      item->set_next(row_meta, bucket.get_item());
+      bucket.set_item(item);
+      added = true;
+    } else {
+      ++collisions;
+    }
+  }
+  return added;
+}
+
+inline int GenericRadixSharedHashTable::build_radix_partitions(JoinTableCtx &ctx)
+{
+  int ret = OB_SUCCESS;
+  int64_t used_buckets = 0;
+  int64_t collisions = 0;
+  const RowMeta &row_meta = ctx.build_row_meta_;
+  for (int64_t t = 0; OB_SUCC(ret) && t < task_cnt_; ++t) {
+    if (OB_ISNULL(task_parts_[t]) || OB_UNLIKELY(part_cnt_ != task_parts_[t]->get_part_cnt())) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("radix partitions of task not prepared", K(ret), K(t), K_(part_cnt));
+    }
+  }
+  for (int64_t part_idx = ctx.task_idx_; OB_SUCC(ret) && part_idx < part_cnt_; part_idx += task_cnt_) {
+    for (int64_t t = 0; OB_SUCC(ret) && t < task_cnt_; ++t) {
+      const ObHJRadixPartitions::Block *block = task_parts_[t]->get_part(part_idx);
+      for (; OB_SUCC(ret) && NULL != block; block = block->next_) {
+        for (int64_t i = 0; OB_SUCC(ret) && i < block->cnt_; ++i) {
+          GenericItem *item = static_cast<GenericItem *>(block->rows_[i]);
+          if (i + 1 < block->cnt_) {
+            __builtin_prefetch(block->rows_[i + 1], 0, 3);
+          }
+          if (!set_in_part(row_meta, part_idx, item, used_buckets, collisions)) {
+            ret = ctx.radix_parts_->add_overflow_row(item);
+          }
+        }
+      }
+    }
+  }
+  set_diag_info(used_buckets, collisions);
+  return ret;
+}
+
+// all workers have finished build_radix_partitions, it is safe to write any bucket
+inline int GenericRadixSharedHashTable::build_radix_overflow(JoinTableCtx &ctx)
+{
+  int ret = OB_SUCCESS;
+  int64_t used_buckets = 0;
+  int64_t collisions = 0;
+  for (int64_t t = 0; OB_SUCC(ret) && t < task_cnt_; ++t) {
+    if (OB_ISNULL(task_parts_[t])) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("radix partitions of task not prepared", K(ret), K(t));
+    } else {
+      const ObHJRadixPartitions::Block *block = task_parts_[t]->get_overflow();
+      for (; NULL != block; block = block->next_) {
+        for (int64_t i = 0; i < block->cnt_; ++i) {
+          set(ctx, block->rows_[i]->get_hash_value(ctx.build_row_meta_), block->rows_[i],
+              used_buckets, collisions);
+        }
+      }
+    }
+  }
+  set_diag_info(used_buckets, collisions);
+  LOG_TRACE("radix build overflow", K(used_buckets), K(collisions));
+  return ret;
+}
+
+inline void GenericRadixSharedHashTable::free(ObIAllocator *alloc)
+{
+  if (OB_NOT_NULL(task_parts_)) {
+    alloc->free(task_parts_);
+    task_parts_ = nullptr;
+  }
+  HashTable::free(alloc);
+}
+
 template <typename Bucket, typename Prober>
 inline int NormalizedSharedHashTable<Bucket, Prober>::insert_batch(JoinTableCtx &ctx,
                                                    ObHJStoredRow **stored_rows,
@@ -45,9 +45,11 @@ int JoinHashTable::init(JoinTableCtx &hjt_ctx, ObIAllocator &allocator)
 {
   int ret = OB_SUCCESS;
   bool use_normalized = use_normalized_ht(hjt_ctx);
-  LOG_DEBUG("init join hash table", K(use_normalized), K(hjt_ctx.is_shared_),
-            K(hjt_ctx.build_keys_->count()));
-  if (hjt_ctx.is_shared_) {
+  LOG_DEBUG("init join hash table", K(use_normalized), K(hjt_ctx.is_shared_), K(hjt_ctx.use_tagged_ht_),
+            K(hjt_ctx.use_radix_ht_), K(hjt_ctx.build_keys_->count()));
+  if (hjt_ctx.is_shared_ && hjt_ctx.use_radix_ht_) {
+    hash_table_ = OB_NEWx(GenericRadixSharedHashTable, (&allocator), hjt_ctx.task_cnt_);
+  } else if (hjt_ctx.is_shared_) {
     if (use_normalized ) {
       if (1 == hjt_ctx.build_keys_->count()) {
         //hash_table_ = OB_NEWx(NormalizedSharedInt64Table, (&allocator));
@@ -60,7 +62,13 @@ int JoinHashTable::init(JoinTableCtx &hjt_ctx, ObIAllocator &allocator)
       hash_table_ = OB_NEWx(GenericSharedHashTable, (&allocator));
     }
   } else {
-    if (use_normalized ) {
+    if (use_normalized && hjt_ctx.use_tagged_ht_) {
+      if (1 == hjt_ctx.build_keys_->count()) {
+        hash_table_ = OB_NEWx(NormalizedTaggedInt64Table, (&allocator));
+      } else if (2 == hjt_ctx.build_keys_->count()) {
+        hash_table_ = OB_NEWx(NormalizedTaggedInt128Table, (&allocator));
+      }
+    } else if (use_normalized ) {
       if (1 == hjt_ctx.build_keys_->count()) {
         hash_table_ = OB_NEWx(NormalizedInt64Table, (&allocator));
       } else if (2 == hjt_ctx.build_keys_->count()) {
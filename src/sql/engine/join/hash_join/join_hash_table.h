@@ -34,6 +34,9 @@ public:
     return hash_table_->project_matched_rows(ctx, output_info);
   };
   int get_unmatched_rows(JoinTableCtx &ctx, OutputInfo &output_info);
+  int radix_prepare(JoinTableCtx &ctx) { return hash_table_->radix_prepare(ctx); }
+  int build_radix_partitions(JoinTableCtx &ctx) { return hash_table_->build_radix_partitions(ctx); }
+  int build_radix_overflow(JoinTableCtx &ctx) { return hash_table_->build_radix_overflow(ctx); }
   void reset() {
     if (NULL != hash_table_) {
       hash_table_->reset();
@@ -30,6 +30,8 @@ namespace sql
 
 static const uint64_t END_ITEM = UINT64_MAX >> 1;
 
+class ObHJRadixPartitions;
+
 struct ObHJStoredRow : public ObCompactRow
 {
   const static int64_t HASH_VAL_BIT = 63;
@@ -210,7 +212,8 @@ struct JoinTableCtx {
 public:
   JoinTableCtx() : eval_ctx_(NULL), join_type_(UNKNOWN_JOIN), is_shared_(false),
                    contain_ns_equal_(false), join_conds_(NULL), build_output_(NULL), probe_output_(NULL),
-                   calc_exprs_(NULL), probe_opt_(false), build_keys_(NULL), probe_keys_(NULL),
+                   calc_exprs_(NULL), probe_opt_(false), use_tagged_ht_(false), use_radix_ht_(false),
+                   task_idx_(0), task_cnt_(1), radix_parts_(NULL), build_keys_(NULL), probe_keys_(NULL),
                    build_key_proj_(NULL), probe_key_proj_(NULL), cur_bkid_(-1),
                    cur_tuple_(reinterpret_cast<void *>(END_ITEM)), max_output_cnt_(NULL),
                    cur_items_(NULL), stored_rows_(NULL), max_batch_size_(0),
@@ -255,6 +258,13 @@ public:
   const ExprFixedArray *calc_exprs_;
 
   bool probe_opt_;
+  // use tagged open addressing table for normalized keys, see TaggedHashTable
+  bool use_tagged_ht_;
+  // radix partitioned build of the shared hash table, see GenericRadixSharedHashTable
+  bool use_radix_ht_;
+  int64_t task_idx_;
+  int64_t task_cnt_;
+  ObHJRadixPartitions *radix_parts_;
   const ExprFixedArray *build_keys_;
   const ExprFixedArray *probe_keys_;
   // In opt mode, the project subscript used to store the key in child output
@@ -113,7 +113,8 @@ ObHashJoinVecSpec::ObHashJoinVecSpec(common::ObIAllocator &alloc, const ObPhyOpe
   is_sna_(false),
   is_shared_ht_(false),
   is_ns_equal_cond_(alloc),
-  build_rows_output_(alloc)
+  build_rows_output_(alloc),
+  use_radix_shared_ht_(false)
 {
 }
 
@@ -129,7 +130,8 @@ OB_SERIALIZE_MEMBER((ObHashJoinVecSpec, ObJoinVecSpec),
                     is_shared_ht_,
                     is_ns_equal_cond_,
                     jf_material_control_info_,
-                    build_rows_output_);
+                    build_rows_output_,
+                    use_radix_shared_ht_);
 
 ObHashJoinVecOp::ObHashJoinVecOp(ObExecContext &ctx_, const ObOpSpec &spec, ObOpInput *input)
   : ObJoinVecOp(ctx_, spec, input),
@@ -233,6 +235,7 @@ int ObHashJoinVecOp::inner_open()
       LOG_WARN("fail to alloc mem");
     } else {
       part_mgr_ = new (buf) ObHJPartitionMgr(*alloc_, tenant_id_);
+      jt_ctx_.radix_parts_ = &part_mgr_->get_radix_parts();
     }
   }
   if (OB_SUCC(ret)) {
@@ -294,6 +297,16 @@ int ObHashJoinVecOp::init_join_table_ctx()
     jt_ctx_.output_info_ = &output_info_;
     jt_ctx_.probe_batch_rows_ = &probe_batch_rows_;
     jt_ctx_.probe_opt_ = MY_SPEC.can_prob_opt_;
+    ObTenantConfigGuard tenant_config(TENANT_CONF(ctx_.get_my_session()->get_effective_tenant_id()));
+    if (tenant_config.is_valid()) {
+      jt_ctx_.use_tagged_ht_ = tenant_config->_enable_hash_join_tagged_table;
+    }
+    if (is_shared_) {
+      jt_ctx_.use_radix_ht_ = MY_SPEC.use_radix_shared_ht_;
+      ObHashJoinVecInput *hj_input = static_cast<ObHashJoinVecInput*>(input_);
+      jt_ctx_.task_idx_ = hj_input->get_task_id();
+      jt_ctx_.task_cnt_ = hj_input->get_sqc_thread_count();
+    }
   }
   jt_ctx_.contain_ns_equal_ = false;
   for (int64_t i = 0; !jt_ctx_.contain_ns_equal_ && i < MY_SPEC.is_ns_equal_cond_.count(); i++) {
@@ -1745,25 +1758,56 @@ int ObHashJoinVecOp::sync_wait_init_build_hash(const uint64_t build_ht_thread_pt
   return ret;
 }
 
+// In radix build, the build rows are only partitioned so far, the partitions are inserted
+// after all threads finish partitioning, and the overflow rows are inserted by the last
+// thread reaching the finish barrier.
 int ObHashJoinVecOp::sync_wait_finish_build_hash()
 {
   int ret = OB_SUCCESS;
+  int overflow_ret = OB_SUCCESS;
   ObHashJoinVecInput *hj_input = static_cast<ObHashJoinVecInput*>(input_);
   if (OB_ISNULL(hj_input)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("unexpected status: shared hash join info is null", K(ret));
+  } else if (jt_ctx_.use_radix_ht_ && OB_FAIL(sync_wait_radix_partition())) {
+    LOG_WARN("failed to sync wait radix partition", K(ret));
+  } else if (jt_ctx_.use_radix_ht_ && OB_FAIL(cur_join_table_->build_radix_partitions(jt_ctx_))) {
+    LOG_WARN("failed to build radix partitions", K(ret));
   } else if (OB_FAIL(hj_input->sync_wait(
       ctx_, hj_input->get_process_cnt(),
       [&](int64_t n_times) {
-        UNUSED(n_times);
+        if (jt_ctx_.use_radix_ht_ && hj_input->get_sqc_thread_count() - 1 == n_times) {
+          overflow_ret = cur_join_table_->build_radix_overflow(jt_ctx_);
+        }
       }))) {
     LOG_WARN("failed to sync wait finish build hash table", K(ret));
+  } else if (OB_FAIL(overflow_ret)) {
+    LOG_WARN("failed to build radix overflow rows", K(ret));
   } else {
     LOG_TRACE("debug sync finish build hash", K(cur_join_table_), K(spec_.id_));
   }
   return ret;
 }
 
+int ObHashJoinVecOp::sync_wait_radix_partition()
+{
+  int ret = OB_SUCCESS;
+  ObHashJoinVecInput *hj_input = static_cast<ObHashJoinVecInput*>(input_);
+  if (OB_ISNULL(hj_input)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected status: shared hash join info is null", K(ret));
+  } else if (OB_FAIL(hj_input->sync_wait(
+      ctx_, hj_input->get_process_cnt(),
+      [&](int64_t n_times) {
+        UNUSED(n_times);
+      }))) {
+    LOG_WARN("failed to sync wait radix partition", K(ret));
+  } else {
+    LOG_TRACE("debug sync radix partition", K(cur_join_table_), K(spec_.id_));
+  }
+  return ret;
+}
+
 int ObHashJoinVecOp::sync_wait_fetch_next_batch()
 {
   int ret = OB_SUCCESS;
@@ -2054,6 +2098,9 @@ int ObHashJoinVecOp::prepare_hash_table()
   if (OB_SUCC(ret) && is_shared_ && OB_FAIL(sync_wait_init_build_hash(build_ht_thread_ptr))) {
     LOG_WARN("failed to sync wait init hash table", K(ret));
   }
+  if (OB_SUCC(ret) && jt_ctx_.use_radix_ht_ && OB_FAIL(cur_join_table_->radix_prepare(jt_ctx_))) {
+    LOG_WARN("failed to prepare radix partitions", K(ret));
+  }
 
   return ret;
 }
@@ -303,6 +303,8 @@ public:
   ObJoinFilterMaterialControlInfo jf_material_control_info_;
   // record build row expr, because has key not in left output
   ExprFixedArray build_rows_output_;
+  // build the shared hash table by radix partitions, see GenericRadixSharedHashTable
+  bool use_radix_shared_ht_;
 };
 
 // hash join has no expression result overwrite problem:
@@ -457,6 +459,7 @@ private:
   int sync_wait_basic_info(uint64_t &build_ht_thread_ptr);
   int sync_wait_init_build_hash(const uint64_t build_ht_thread_ptr);
   int sync_wait_finish_build_hash();
+  int sync_wait_radix_partition();
   int sync_wait_fetch_next_batch();
   int sync_check_early_exit(bool &early_exit);
   int sync_set_early_exit();
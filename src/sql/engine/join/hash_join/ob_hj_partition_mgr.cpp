@@ -221,5 +221,83 @@ int ObHJPartitionMgr::get_or_create_part(int32_t level,
   return ret;
 }
 
+void ObHJRadixPartitions::reset()
+{
+  recycle(overflow_);
+  for (int64_t i = 0; i < part_cnt_; ++i) {
+    recycle(heads_[i]);
+  }
+  while (NULL != free_blocks_) {
+    Block *next = free_blocks_->next_;
+    alloc_.free(free_blocks_);
+    free_blocks_ = next;
+  }
+  if (NULL != heads_) {
+    alloc_.free(heads_);
+    heads_ = NULL;
+  }
+  part_cnt_ = 0;
+  part_cap_ = 0;
+}
+
+int ObHJRadixPartitions::prepare(const int64_t part_cnt)
+{
+  int ret = OB_SUCCESS;
+  recycle(overflow_);
+  for (int64_t i = 0; i < part_cnt_; ++i) {
+    recycle(heads_[i]);
+  }
+  part_cnt_ = 0;
+  if (OB_UNLIKELY(part_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid radix partition count", K(ret), K(part_cnt));
+  } else if (part_cnt > part_cap_) {
+    void *buf = alloc_.alloc(sizeof(Block *) * part_cnt);
+    if (OB_ISNULL(buf)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc radix partition heads", K(ret), K(part_cnt));
+    } else {
+      if (NULL != heads_) {
+        alloc_.free(heads_);
+      }
+      heads_ = static_cast<Block **>(buf);
+      part_cap_ = part_cnt;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    MEMSET(heads_, 0, sizeof(Block *) * part_cnt);
+    part_cnt_ = part_cnt;
+  }
+  return ret;
+}
+
+int ObHJRadixPartitions::alloc_block(Block *&head)
+{
+  int ret = OB_SUCCESS;
+  Block *block = free_blocks_;
+  if (NULL != block) {
+    free_blocks_ = block->next_;
+  } else if (OB_ISNULL(block = static_cast<Block *>(alloc_.alloc(sizeof(Block))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc radix partition block", K(ret));
+  }
+  if (OB_SUCC(ret)) {
+    block->next_ = head;
+    block->cnt_ = 0;
+    head = block;
+  }
+  return ret;
+}
+
+void ObHJRadixPartitions::recycle(Block *&head)
+{
+  while (NULL != head) {
+    Block *next = head->next_;
+    head->next_ = free_blocks_;
+    free_blocks_ = head;
+    head = next;
+  }
+}
+
 } // end namespace sql
 } // end namespace oceanbase
@@ -21,6 +21,66 @@ namespace oceanbase
 namespace sql
 {
 
+struct ObHJStoredRow;
+
+// In-memory radix partitions of the build rows of one worker, used by the radix build
+// of the shared hash table (see GenericRadixSharedHashTable). Row pointers of one partition
+// are kept in a list of blocks, the rows themselves stay in the partition store.
+class ObHJRadixPartitions {
+public:
+  static const int64_t BLOCK_ROW_CNT = 62;
+  struct Block {
+    Block *next_;
+    int64_t cnt_;
+    ObHJStoredRow *rows_[BLOCK_ROW_CNT];
+  };
+
+  explicit ObHJRadixPartitions(common::ObIAllocator &alloc) :
+    alloc_(alloc),
+    part_cnt_(0),
+    part_cap_(0),
+    heads_(NULL),
+    overflow_(NULL),
+    free_blocks_(NULL)
+  {}
+  ~ObHJRadixPartitions() { reset(); }
+  void reset();
+  // recycle the rows of last build and prepare %part_cnt empty partitions
+  int prepare(const int64_t part_cnt);
+  inline int add_row(const int64_t part_idx, ObHJStoredRow *row) {
+    return add_row(heads_[part_idx], row);
+  }
+  // rows can not be inserted into the bucket range of their partition
+  inline int add_overflow_row(ObHJStoredRow *row) { return add_row(overflow_, row); }
+  const Block *get_part(const int64_t part_idx) const { return heads_[part_idx]; }
+  const Block *get_overflow() const { return overflow_; }
+  int64_t get_part_cnt() const { return part_cnt_; }
+
+  TO_STRING_KV(K_(part_cnt), K_(part_cap));
+
+private:
+  inline int add_row(Block *&head, ObHJStoredRow *row) {
+    int ret = common::OB_SUCCESS;
+    if (OB_UNLIKELY(NULL == head || BLOCK_ROW_CNT == head->cnt_)) {
+      ret = alloc_block(head);
+    }
+    if (OB_SUCC(ret)) {
+      head->rows_[head->cnt_++] = row;
+    }
+    return ret;
+  }
+  int alloc_block(Block *&head);
+  void recycle(Block *&head);
+
+private:
+  common::ObIAllocator &alloc_;
+  int64_t part_cnt_;
+  int64_t part_cap_;
+  Block **heads_;
+  Block *overflow_;
+  Block *free_blocks_;
+};
+
 struct ObHJPartitionPair
 {
   ObHJPartition *left_;
@@ -37,7 +97,8 @@ public:
     part_count_(0),
     tenant_id_(tenant_id),
     alloc_(alloc),
-    part_pair_list_(alloc)
+    part_pair_list_(alloc),
+    radix_parts_(alloc)
   {}
 
   virtual ~ObHJPartitionMgr();
@@ -76,6 +137,8 @@ public:
     }
   }
 
+  ObHJRadixPartitions &get_radix_parts() { return radix_parts_; }
+
 public:
   int64_t total_dump_count_;
   int64_t total_dump_size_;
@@ -86,6 +149,7 @@ private:
   uint64_t tenant_id_;
   common::ObIAllocator &alloc_;
   ObHJPartitionPairList part_pair_list_;
+  ObHJRadixPartitions radix_parts_;
 };
 
 } // end namespace sql
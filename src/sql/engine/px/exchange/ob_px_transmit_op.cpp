@@ -413,6 +413,7 @@ int ObPxTransmitOp::init_channel(ObPxTransmitOpInput &trans_input)
         ch->set_enable_channel_sync(true);
         ch->set_batch_id(px_batch_id);
         ch->set_compression_type(dfc_.get_compressor_type());
+        ch->set_enable_vector_encoding(dfc_.enable_vector_encoding());
         ch->set_operator_owner();
         ch->set_thread_id(thread_id);
         ch->set_row_meta(params_.meta_);
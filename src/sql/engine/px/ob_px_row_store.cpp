@@ -18,6 +18,7 @@
 #include "common/cell/ob_cell_reader.h"
 #include "sql/dtl/ob_dtl.h"
 #include "sql/dtl/ob_dtl_tenant_mem_manager.h"
+#include "sql/dtl/ob_dtl_vectors_codec.h"
 #include "share/vector/ob_continuous_base.h"
 #include "share/vector/ob_fixed_length_base.h"
 #include "share/vector/ob_uniform_base.h"
@@ -291,8 +292,7 @@ int ObReceiveRowReader::check_and_switch_buffer(dtl::ObDtlLinkedBuffer *&curr)
       case dtl::PX_VECTOR_FIXED :
       case dtl::PX_VECTOR : {
         if (!curr_vector_.is_inited()) {
-          curr_vector_.set_buf(curr->buf(), curr->size());
-          if (OB_FAIL(curr_vector_.decode())) {
+          if (OB_FAIL(init_curr_vector(*curr))) {
             LOG_WARN("failed to decode vector", K(ret), K(curr->msg_type()));
           }
         }
@@ -321,8 +321,7 @@ int ObReceiveRowReader::check_and_switch_buffer(dtl::ObDtlLinkedBuffer *&curr)
         curr = recv_head_;
         dtl::ObDtlMsgType msg_type = recv_head_->msg_type();
         if (dtl::PX_VECTOR_FIXED == msg_type || dtl::PX_VECTOR == msg_type) {
-          curr_vector_.set_buf(recv_head_->buf(), recv_head_->size());
-          if (OB_FAIL(curr_vector_.decode())) {
+          if (OB_FAIL(init_curr_vector(*recv_head_))) {
             LOG_WARN("failed to decode vecotr", K(ret));
           }
         }
@@ -338,6 +337,43 @@ int ObReceiveRowReader::check_and_switch_buffer(dtl::ObDtlLinkedBuffer *&curr)
   return ret;
 }
 
+int ObReceiveRowReader::init_curr_vector(dtl::ObDtlLinkedBuffer &buffer)
+{
+  int ret = OB_SUCCESS;
+  if (!buffer.is_vector_encoded()) {
+    curr_vector_.set_buf(buffer.buf(), buffer.size());
+  } else {
+    int64_t decoded_size = 0;
+    if (OB_FAIL(dtl::ObDtlVectorsCodec::get_decoded_size(buffer.buf(), buffer.size(), decoded_size))) {
+      LOG_WARN("failed to get decoded size", K(ret), K(buffer));
+    } else if (decoded_size > decode_buf_size_) {
+      if (NULL != decode_buf_) {
+        ob_free(decode_buf_);
+        decode_buf_ = NULL;
+        decode_buf_size_ = 0;
+      }
+      if (OB_ISNULL(decode_buf_ = static_cast<char *>(ob_malloc(decoded_size,
+                                      ObMemAttr(buffer.tenant_id(), "DtlVecDecode"))))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc decode buffer", K(ret), K(decoded_size));
+      } else {
+        decode_buf_size_ = decoded_size;
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(dtl::ObDtlVectorsCodec::decode(buffer.buf(), buffer.size(),
+                                                      decode_buf_, decode_buf_size_))) {
+      LOG_WARN("failed to decode encoded vectors", K(ret), K(buffer));
+    } else {
+      curr_vector_.set_buf(decode_buf_, decoded_size);
+    }
+  }
+  if (OB_SUCC(ret) && OB_FAIL(curr_vector_.decode())) {
+    LOG_WARN("failed to decode vector", K(ret));
+  }
+  return ret;
+}
+
 template <typename BLOCK, typename ROW>
 const ROW *ObReceiveRowReader::next_store_row()
 {
@@ -778,6 +814,11 @@ int ObReceiveRowReader::get_next_batch_vec(const ObIArray<ObExpr*> &exprs,
 void ObReceiveRowReader::reset()
 {
   curr_vector_.reset();
+  if (NULL != decode_buf_) {
+    ob_free(decode_buf_);
+    decode_buf_ = NULL;
+    decode_buf_size_ = 0;
+  }
   free_buffer_list(recv_head_);
   recv_head_ = NULL;
   recv_tail_ = NULL;
@@ -44,6 +44,8 @@ public:
       datum_iter_(NULL),
       row_iter_(NULL),
       curr_vector_(),
+      decode_buf_(NULL),
+      decode_buf_size_(0),
       id_(id)
   {
   }
@@ -133,6 +135,8 @@ private:
                             int64_t &read_rows,
                             const ObCompactRow **srows);
   int check_and_switch_buffer(dtl::ObDtlLinkedBuffer *&buffer);
+  // set %buffer to curr_vector_, decode it into decode_buf_ first if encoded by the sender
+  int init_curr_vector(dtl::ObDtlLinkedBuffer &buffer);
   void move_to_iterated(const int64_t rows);
   void free(dtl::ObDtlLinkedBuffer *buf);
   inline void free_iterated_buffers()
@@ -159,6 +163,8 @@ private:
   ObChunkRowStore::Iterator *row_iter_;
   dtl::ObDtlMsgType msg_type_;
   dtl::ObDtlVectors curr_vector_;
+  char *decode_buf_;
+  int64_t decode_buf_size_;
   int64_t id_;
 };
 
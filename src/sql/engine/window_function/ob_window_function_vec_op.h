@@ -29,6 +29,7 @@ namespace winfunc
 {
   template<typename T>
   class WinExprWrapper;
+  class AggrSegmentTree;
 } // end winfunc
 
 class ObWindowFunctionVecOp;
@@ -470,6 +471,7 @@ private:
   friend class winfunc::RowStores;
 
   friend class winfunc::StoreGuard;
+  friend class winfunc::AggrSegmentTree;
 private:
   common::ObArenaAllocator *local_allocator_;
   // this allocator will be reset in rescan
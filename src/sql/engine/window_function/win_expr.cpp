@@ -56,6 +56,16 @@ struct int_trunc
   static int get(const char *payload, const int32_t len,const ObDatumMeta &meta, int64_t &value);
 };
 
+WinExprEvalCtx::~WinExprEvalCtx()
+{
+  if (nullptr != seg_tree_) {
+    seg_tree_->~AggrSegmentTree();
+    seg_tree_ = nullptr;
+  }
+  extra_ = nullptr;
+  allocator_.reset();
+}
+
 // WinExprHelper
 template <typename Derived>
 int WinExprWrapper<Derived>::process_partition(WinExprEvalCtx &ctx, const int64_t part_start,
@@ -80,6 +90,7 @@ int WinExprWrapper<Derived>::process_partition(WinExprEvalCtx &ctx, const int64_
         LOG_WARN("eval lower bound failed", K(ret));
       } else if (is_aggregate_expr()) {
         AggrExpr *agg_expr = reinterpret_cast<AggrExpr *>(this);
+        AggrSegmentTree *seg_tree = nullptr;
         prev_frame = agg_expr->last_valid_frame_;
         if (row_start  > part_start) {
           ctx.win_col_.agg_ctx_->removal_info_ = agg_expr->last_removal_info_;
@@ -109,6 +120,13 @@ int WinExprWrapper<Derived>::process_partition(WinExprEvalCtx &ctx, const int64_
             if (OB_FAIL(copy_aggr_row(ctx, copied_row, agg_row))) {
               LOG_WARN("copy aggr row failed", K(ret));
             }
+          } else if (OB_FAIL(agg_expr->get_segment_tree(ctx, part_start, part_end, cur_frame,
+                                                        seg_tree))) {
+            LOG_WARN("get segment tree failed", K(ret), K(cur_frame));
+          } else if (nullptr != seg_tree) {
+            if (OB_FAIL(seg_tree->query(ctx, *agg_expr->aggr_processor_, cur_frame, agg_row))) {
+              LOG_WARN("query segment tree failed", K(ret), K(cur_frame), KPC(seg_tree));
+            }
           } else if (whole_frame) {
             ctx.win_col_.agg_ctx_->removal_info_.reset_for_new_frame();
             if (OB_FAIL(static_cast<Derived *>(this)->process_window(ctx, cur_frame, row_idx, agg_row, is_null))) {
@@ -1281,6 +1299,30 @@ int AggrExpr::accum_process_window(WinExprEvalCtx &ctx, const Frame &cur_frame,
   return ret;
 }
 
+int AggrExpr::get_segment_tree(WinExprEvalCtx &ctx, const int64_t part_start,
+                               const int64_t part_end, const Frame &frame,
+                               AggrSegmentTree *&seg_tree)
+{
+  int ret = OB_SUCCESS;
+  void *buf = nullptr;
+  seg_tree = ctx.seg_tree_;
+  if (nullptr != seg_tree) {
+    // already built
+  } else if (!AggrSegmentTree::is_applicable(ctx, part_end - part_start, frame.tail_ - frame.head_)) {
+    // do nothing
+  } else if (OB_ISNULL(buf = ctx.allocator_.alloc(sizeof(AggrSegmentTree)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret));
+  } else {
+    seg_tree = new (buf) AggrSegmentTree(ctx.win_col_.op_);
+    ctx.seg_tree_ = seg_tree;
+    if (OB_FAIL(seg_tree->build(ctx, *aggr_processor_, part_start, part_end))) {
+      LOG_WARN("build segment tree failed", K(ret), K(part_start), K(part_end));
+    }
+  }
+  return ret;
+}
+
 void AggrExpr::destroy()
 {
   if (aggr_processor_ != nullptr) {
@@ -1303,6 +1345,174 @@ int AggrExpr::collect_part_results(WinExprEvalCtx &ctx, const int64_t row_start,
   return ret;
 }
 
+AggrSegmentTree::AggrSegmentTree(ObWindowFunctionVecOp &op)
+  : allocator_(op.mem_context_->get_malloc_allocator()),
+    part_start_(0), leaf_cnt_(0), row_size_(0), nodes_(nullptr)
+{
+}
+
+bool AggrSegmentTree::is_applicable(WinExprEvalCtx &ctx, const int64_t part_size,
+                                    const int64_t frame_size)
+{
+  ObWindowFunctionVecOp &op = ctx.win_col_.op_;
+  const ObWindowFunctionVecSpec &spec = static_cast<const ObWindowFunctionVecSpec &>(op.get_spec());
+  const WinFuncInfo &wf_info = ctx.win_col_.wf_info_;
+  aggregate::RuntimeContext &agg_ctx = *ctx.win_col_.agg_ctx_;
+  bool applicable = false;
+  // if upper bound is unbounded, head of frame never moves and accumulated calculation is enough.
+  // narrow frames are cheaper to recalculate than to build and query the tree.
+  if ((T_FUN_MIN == wf_info.func_type_ || T_FUN_MAX == wf_info.func_type_)
+      && !spec.single_part_parallel_
+      && !spec.is_push_down()
+      && !wf_info.upper_.is_unbounded_
+      && part_size >= MIN_PARTITION_SIZE
+      && frame_size >= MIN_FRAME_SIZE
+      && 1 == agg_ctx.aggr_infos_.count()
+      && 0 == agg_ctx.row_meta().extra_cnt_
+      && !agg_ctx.aggr_infos_.at(0).is_implicit_first_aggr()
+      && 1 == agg_ctx.aggr_infos_.at(0).param_exprs_.count()) {
+    // the tree must fit in the work area left by the stored rows, or it falls back.
+    const int64_t mem_size = get_mem_size(part_size, agg_ctx.row_meta().row_size_);
+    const int64_t mem_used = op.sql_mem_processor_.get_data_size() + op.local_mem_used();
+    applicable = mem_used + mem_size <= op.sql_mem_processor_.get_mem_bound();
+    if (!applicable) {
+      LOG_TRACE("segment tree exceeds memory bound", K(part_size), K(mem_size), K(mem_used),
+                K(op.sql_mem_processor_.get_mem_bound()));
+    }
+  }
+  return applicable;
+}
+
+void AggrSegmentTree::destroy()
+{
+  nodes_ = nullptr;
+  leaf_cnt_ = 0;
+  allocator_.reset();
+}
+
+int AggrSegmentTree::build(WinExprEvalCtx &ctx, aggregate::Processor &processor,
+                           const int64_t part_start, const int64_t part_end)
+{
+  int ret = OB_SUCCESS;
+  ObWindowFunctionVecOp &op = ctx.win_col_.op_;
+  ObEvalCtx &eval_ctx = op.get_eval_ctx();
+  aggregate::RuntimeContext &agg_ctx = *ctx.win_col_.agg_ctx_;
+  ObBitVector &eval_skip = *op.get_batch_ctx().bound_eval_skip_;
+  const int64_t max_batch_size = op.get_spec().max_batch_size_;
+  aggregate::IAggregate *iagg = processor.get_aggregates().at(0);
+  aggregate::AggrRowPtr *leaves = nullptr;
+  part_start_ = part_start;
+  leaf_cnt_ = part_end - part_start;
+  row_size_ = agg_ctx.row_meta().row_size_;
+  if (OB_UNLIKELY(leaf_cnt_ <= 0 || max_batch_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(part_start), K(part_end), K(max_batch_size));
+  } else if (OB_ISNULL(nodes_ = static_cast<char *>(
+                         allocator_.alloc(get_mem_size(leaf_cnt_, row_size_))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(leaf_cnt_), K(row_size_));
+  } else if (OB_ISNULL(leaves = static_cast<aggregate::AggrRowPtr *>(
+                         allocator_.alloc(sizeof(aggregate::AggrRowPtr) * max_batch_size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate memory failed", K(ret), K(max_batch_size));
+  }
+  for (int64_t i = 1; OB_SUCC(ret) && i < 2 * leaf_cnt_; i++) {
+    if (OB_FAIL(aggregate::Processor::setup_rt_info(node(i), agg_ctx))) {
+      LOG_WARN("setup runtime info failed", K(ret));
+    }
+  }
+  // step.1: calculate leaves batch by batch, each row is added into its own leaf
+  if (OB_SUCC(ret)) {
+    ObEvalCtx::BatchInfoScopeGuard guard(eval_ctx);
+    ObBatchRows tmp_brs;
+    int64_t batch_size = 0;
+    for (int64_t row_start = part_start; OB_SUCC(ret) && row_start < part_end;
+         row_start += batch_size) {
+      op.clear_evaluated_flag();
+      batch_size = std::min(part_end - row_start, max_batch_size);
+      guard.set_batch_size(batch_size);
+      eval_skip.unset_all(0, batch_size);
+      tmp_brs.size_ = batch_size;
+      tmp_brs.end_ = false;
+      tmp_brs.skip_ = &eval_skip;
+      tmp_brs.all_rows_active_ = true;
+      for (int64_t i = 0; i < batch_size; i++) {
+        leaves[i] = node(leaf_cnt_ + row_start - part_start + i);
+      }
+      if (OB_FAIL(ctx.input_rows_.attach_rows(op.get_all_expr(), op.get_input_row_meta(),
+                                              eval_ctx, row_start, row_start + batch_size,
+                                              false))) {
+        LOG_WARN("attach rows failed", K(ret));
+      } else if (OB_FAIL(processor.eval_aggr_param_batch(tmp_brs))) {
+        LOG_WARN("eval aggr params failed", K(ret));
+      } else if (OB_FAIL(processor.add_batch_for_multi_groups(0, 1, leaves, batch_size))) {
+        LOG_WARN("add batch for multi groups failed", K(ret));
+      }
+      for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; i++) {
+        if (OB_FAIL(deep_copy_leaf(ctx, leaves[i]))) {
+          LOG_WARN("deep copy leaf failed", K(ret));
+        }
+      }
+    }
+  }
+  // step.2: roll up inner nodes from bottom to top
+  for (int64_t i = leaf_cnt_ - 1; OB_SUCC(ret) && i > 0; i--) {
+    if (OB_FAIL(iagg->rollup_aggregation(agg_ctx, 0, node(2 * i), node(i), 0))) {
+      LOG_WARN("rollup aggregation failed", K(ret));
+    } else if (OB_FAIL(iagg->rollup_aggregation(agg_ctx, 0, node(2 * i + 1), node(i), 0))) {
+      LOG_WARN("rollup aggregation failed", K(ret));
+    }
+  }
+  LOG_TRACE("build segment tree", K(ret), K(part_start), K(part_end), K(row_size_));
+  return ret;
+}
+
+int AggrSegmentTree::deep_copy_leaf(WinExprEvalCtx &ctx, aggregate::AggrRowPtr leaf)
+{
+  int ret = OB_SUCCESS;
+  const aggregate::AggrRowMeta &row_meta = ctx.win_col_.agg_ctx_->row_meta();
+  // variable-length result references memory of aggregate context, which is reused for each batch
+  if (row_meta.is_var_len(0) && row_meta.locate_notnulls_bitmap(leaf).at(0)) {
+    char *cell = row_meta.locate_cell_payload(0, leaf);
+    const char *val = reinterpret_cast<const char *>(*reinterpret_cast<int64_t *>(cell));
+    int32_t val_len = row_meta.get_cell_len(0, leaf);
+    char *buf = nullptr;
+    if (val_len <= 0) {
+    } else if (OB_ISNULL(buf = static_cast<char *>(allocator_.alloc(val_len)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(val_len));
+    } else {
+      MEMCPY(buf, val, val_len);
+      *reinterpret_cast<int64_t *>(cell) = reinterpret_cast<int64_t>(buf);
+    }
+  }
+  return ret;
+}
+
+int AggrSegmentTree::query(WinExprEvalCtx &ctx, aggregate::Processor &processor,
+                           const Frame &frame, aggregate::AggrRowPtr agg_row)
+{
+  int ret = OB_SUCCESS;
+  aggregate::RuntimeContext &agg_ctx = *ctx.win_col_.agg_ctx_;
+  aggregate::IAggregate *iagg = processor.get_aggregates().at(0);
+  if (OB_UNLIKELY(frame.head_ < part_start_ || frame.tail_ > part_start_ + leaf_cnt_
+                  || frame.head_ >= frame.tail_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("frame out of partition", K(ret), K(frame), K(part_start_), K(leaf_cnt_));
+  } else {
+    int64_t l = frame.head_ - part_start_ + leaf_cnt_;
+    int64_t r = frame.tail_ - part_start_ + leaf_cnt_;
+    for (; OB_SUCC(ret) && l < r; l >>= 1, r >>= 1) {
+      if ((l & 1) && OB_FAIL(iagg->rollup_aggregation(agg_ctx, 0, node(l++), agg_row, 0))) {
+        LOG_WARN("rollup aggregation failed", K(ret));
+      } else if ((r & 1) && OB_FAIL(iagg->rollup_aggregation(agg_ctx, 0, node(--r), agg_row, 0))) {
+        LOG_WARN("rollup aggregation failed", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
 template <typename ColumnFmt>
 int AggrExpr::set_payload(WinExprEvalCtx &ctx, ColumnFmt *columns, const int64_t idx,
                           const char *payload, int32_t len)
@@ -22,11 +22,13 @@ namespace sql
 {
 class ObCompactRow;
 class WinFuncColExpr;
+class ObWindowFunctionVecOp;
 
 namespace winfunc
 {
 using namespace share;
 class RowStore;
+class AggrSegmentTree;
 
 // copy from` ob_aggregate_processor.h`
 struct RemovalInfo
@@ -142,23 +144,21 @@ struct WinExprEvalCtx
     input_rows_(input_rows), win_col_(win_col),
     allocator_(ObModIds::OB_SQL_WINDOW_LOCAL, OB_MALLOC_NORMAL_BLOCK_SIZE, tenant_id,
                ObCtxIds::WORK_AREA),
-    extra_(nullptr)
+    extra_(nullptr), seg_tree_(nullptr)
   {}
 
   char *reserved_buf(int32_t len)
   {
     return (char *)allocator_.alloc(len);
   }
-  ~WinExprEvalCtx()
-  {
-    extra_ = nullptr;
-    allocator_.reset();
-  }
+  ~WinExprEvalCtx();
   RowStore &input_rows_;
   sql::WinFuncColExpr &win_col_;
   // used for tmp memory allocating during partition process.
   common::ObArenaAllocator allocator_;
   void *extra_; // maybe useless
+  // segment tree of aggregate rows of current partition, see AggrSegmentTree
+  AggrSegmentTree *seg_tree_;
 };
 
 class IWinExpr
@@ -295,10 +295,55 @@ public:
   virtual int generate_extra(ObIAllocator &allocator, void *&extra) override;
 };
 
+// Segment tree of aggregate rows built over the whole partition, used for min/max with sliding
+// frames. Removal of extremum is not supported by min/max, so once the extremum slides out of
+// frame, the whole frame has to be recalculated. With segment tree, each frame is calculated by
+// rolling up O(log n) tree nodes instead.
+// Tree nodes are stored in an array, node i has children 2i and 2i+1, leaves are [n, 2n).
+// Memory of tree is allocated from the memory context of window function operator, and freed
+// with the evaluation context of partition.
+class AggrSegmentTree
+{
+public:
+  static const int64_t MIN_PARTITION_SIZE = 1024;
+  // a query rolls up at most 2 * log2(n) nodes, less than recalculating a frame of 64 rows for
+  // any partition below 2^32 rows.
+  static const int64_t MIN_FRAME_SIZE = 64;
+public:
+  explicit AggrSegmentTree(ObWindowFunctionVecOp &op);
+  ~AggrSegmentTree() { destroy(); }
+  void destroy();
+  // frame_size is the size of the frame to be calculated
+  static bool is_applicable(WinExprEvalCtx &ctx, const int64_t part_size,
+                            const int64_t frame_size);
+  int build(WinExprEvalCtx &ctx, aggregate::Processor &processor, const int64_t part_start,
+            const int64_t part_end);
+  int query(WinExprEvalCtx &ctx, aggregate::Processor &processor, const Frame &frame,
+            aggregate::AggrRowPtr agg_row);
+  TO_STRING_KV(K_(part_start), K_(leaf_cnt), K_(row_size));
+private:
+  inline aggregate::AggrRowPtr node(const int64_t idx) const { return nodes_ + idx * row_size_; }
+  static int64_t get_mem_size(const int64_t leaf_cnt, const int32_t row_size)
+  {
+    return 2 * leaf_cnt * row_size;
+  }
+  int deep_copy_leaf(WinExprEvalCtx &ctx, aggregate::AggrRowPtr leaf);
+private:
+  common::ObArenaAllocator allocator_;
+  int64_t part_start_;
+  int64_t leaf_cnt_;
+  int32_t row_size_;
+  char *nodes_;
+};
+
 class AggrExpr final: public WinExprWrapper<AggrExpr>
 {
 public:
   AggrExpr(): aggr_processor_(nullptr), last_valid_frame_(), last_aggr_row_(nullptr) {}
+  // segment tree is built at the first frame of partition it is applicable to and saved in
+  // `ctx.seg_tree_`, `seg_tree` is null if segment tree is not applicable.
+  int get_segment_tree(WinExprEvalCtx &ctx, const int64_t part_start, const int64_t part_end,
+                       const Frame &frame, AggrSegmentTree *&seg_tree);
   int process_window(WinExprEvalCtx &ctx, const Frame &frame, const int64_t row_idx,
                      char *res, bool &is_null) override;
 
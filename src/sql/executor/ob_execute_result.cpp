@@ -86,6 +86,22 @@ int ObExecuteResult::get_next_row(ObExecContext &ctx, const common::ObNewRow *&r
   return ret;
 }
 
+int ObExecuteResult::get_next_batch(ObExecContext &ctx, const int64_t max_row_cnt, const ObBatchRows *&brs)
+{
+  int ret = OB_SUCCESS;
+  UNUSED(ctx);
+  if (OB_ISNULL(static_engine_root_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(!static_engine_root_->get_spec().is_vectorized())) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("get next batch from non-vectorized plan", K(ret));
+  } else if (OB_FAIL(static_engine_root_->get_next_batch(max_row_cnt, brs))) {
+    LOG_WARN("get next batch failed", K(ret));
+  }
+  return ret;
+}
+
 int ObExecuteResult::close(ObExecContext &ctx)
 {
   int ret = OB_SUCCESS;
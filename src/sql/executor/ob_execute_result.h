@@ -34,6 +34,13 @@ public:
   virtual int open(ObExecContext &ctx) = 0;
   virtual int get_next_row(ObExecContext &ctx, const common::ObNewRow *&row) = 0;
   virtual int close(ObExecContext &ctx) = 0;
+  // batch interface of the vectorized engine, only supported when the plan is executed locally
+  virtual int get_next_batch(ObExecContext &ctx, const int64_t max_row_cnt, const ObBatchRows *&brs)
+  {
+    UNUSEDx(ctx, max_row_cnt, brs);
+    return common::OB_NOT_SUPPORTED;
+  }
+  virtual ObOperator *get_static_engine_root() const { return NULL; }
 };
 
 class ObExecuteResult : public ObIExecuteResult
@@ -49,6 +56,8 @@ public:
   virtual int open(ObExecContext &ctx) override;
   virtual int get_next_row(ObExecContext &ctx, const common::ObNewRow *&row) override;
   virtual int close(ObExecContext &ctx) override;
+  // rows must be fetched either by get_next_row or by get_next_batch in one execution
+  virtual int get_next_batch(ObExecContext &ctx, const int64_t max_row_cnt, const ObBatchRows *&brs) override;
 
   inline int get_err_code() { return err_code_; }
 
@@ -56,7 +65,7 @@ public:
   int open() const;
   int get_next_row() const;
   int close() const;
-  const ObOperator *get_static_engine_root() const { return static_engine_root_; }
+  virtual ObOperator *get_static_engine_root() const override { return static_engine_root_; }
   void set_static_engine_root(ObOperator *op)
   {
     static_engine_root_ = op;
@@ -511,6 +511,25 @@ OB_INLINE int ObResultSet::inner_get_next_row(const common::ObNewRow *&row)
   return ret;
 }
 
+int ObResultSet::get_next_batch(const int64_t max_row_cnt, const ObBatchRows *&brs)
+{
+  LinkExecCtxGuard link_guard(my_session_, get_exec_context());
+  int &ret = errcode_;
+  ObPhysicalPlan* physical_plan_ = static_cast<ObPhysicalPlan*>(cache_obj_guard_.get_cache_obj());
+  if (OB_ISNULL(physical_plan_) || OB_ISNULL(exec_result_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("phy plan or exec result is null", K(ret), KP(physical_plan_), KP_(exec_result));
+  } else if (OB_FAIL(exec_result_->get_next_batch(get_exec_context(), max_row_cnt, brs))) {
+    LOG_WARN("get next batch from exec result failed", K(ret));
+    // marked last execute status
+    physical_plan_->set_is_last_exec_succ(false);
+  } else {
+    return_rows_ += brs->size_ - brs->skip_->accumulate_bit_cnt(brs->size_);
+  }
+  DAS_CTX(get_exec_context()).get_location_router().save_cur_exec_status(ret);
+  return ret;
+}
+
 // 触发本错误的条件： A、B两个SQL，同时修改了某几行数据（修改内容有交集）。
 // 微观上，修改操作要先读出符合条件的行，然后再更新。在读的时候，会记录一个版本号，
 // 更新的时候，会检查版本号是否有变化。如果有变化，则说明在读之后、写之前，数据被其它
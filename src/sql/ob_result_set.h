@@ -123,6 +123,11 @@ public:
   /// get the next result row
   /// @return OB_ITER_END when no more data available
   int get_next_row(const common::ObNewRow *&row);
+  /// get the next batch from the root operator of a local vectorized plan
+  /// @note the end of data is marked by brs->end_ instead of OB_ITER_END
+  int get_next_batch(const int64_t max_row_cnt, const ObBatchRows *&brs);
+  ObOperator *get_static_engine_root() const
+  { return NULL == exec_result_ ? NULL : exec_result_->get_static_engine_root(); }
   /// close the result set after get all the rows
   int close() { return do_close(NULL); }
   // close result set and rewrite the client ret
@@ -862,6 +862,7 @@ int ObDynamicSampling::estimate_table_block_count_and_row_count(const ObDSTableP
   ObSEArray<ObObjectID, 4> partition_ids;
   ObSEArray<EstimateBlockRes, 4> estimate_result;
   ObArray<uint64_t> column_group_ids;
+  ObArray<uint64_t> ndv_sketch_column_ids;
   if (OB_ISNULL(ctx_->get_exec_ctx()) || OB_ISNULL(ctx_->get_session_info())) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("get unexpected null", K(ret), K(ctx_->get_exec_ctx()), K(ctx_->get_session_info()));
@@ -873,6 +874,7 @@ int ObDynamicSampling::estimate_table_block_count_and_row_count(const ObDSTableP
                                                                                   tablet_ids,
                                                                                   partition_ids,
                                                                                   column_group_ids,
+                                                                                  ndv_sketch_column_ids,
                                                                                   estimate_result))) {
     LOG_WARN("failed to do estimate block count and row count", K(ret));
   } else {
@@ -25,6 +25,8 @@ namespace sql
   class ObLogJoin : public ObLogicalOperator
   {
   public:
+    // the atomic insert into the shared hash table contends from about 32 threads per server
+    static const int64_t RADIX_SHARED_HT_MIN_DOP = 32;
     ObLogJoin(ObLogPlan &plan)
       : ObLogicalOperator(plan),
         join_conditions_(),
@@ -64,6 +66,12 @@ namespace sql
     inline DistAlgo get_dist_method() const { return join_dist_algo_; }
     inline bool is_shared_hash_join() const
     { return HASH_JOIN == join_algo_ && DIST_BC2HOST_NONE == join_dist_algo_; }
+    // build the shared hash table by radix partitions when many threads of one server share it
+    inline bool use_radix_shared_hash_table() const
+    {
+      return is_shared_hash_join()
+             && get_parallel() >= RADIX_SHARED_HT_MIN_DOP * std::max(1L, get_server_cnt());
+    }
     int is_left_unique(bool &left_unique) const;
     inline int add_join_condition(ObRawExpr *expr) { return join_conditions_.push_back(expr); }
     inline int add_join_filter(ObRawExpr *expr) { return join_filters_.push_back(expr); }
@@ -211,6 +211,22 @@ int ObStorageEstimator::storage_estimate_block_count_and_row_count(
             LOG_WARN("fail to push micro count", K(ret));
           }
         }
+        if (OB_SUCC(ret) && !arg.ndv_sketch_column_ids_.empty()) {
+          // the caller falls back to scan the table without sketch, so ignore the failure
+          int tmp_ret = OB_SUCCESS;
+          if (OB_TMP_FAIL(access_service->get_column_ndv_sketches(arg.ls_id_,
+                                                                 arg.tablet_id_,
+                                                                 timeout_us,
+                                                                 arg.ndv_sketch_column_ids_,
+                                                                 res.ndv_sketch_column_ids_,
+                                                                 res.column_ndv_sketches_,
+                                                                 res.ndv_sketch_row_count_))) {
+            LOG_WARN("failed to get column ndv sketches", K(tmp_ret), K(arg));
+            res.ndv_sketch_column_ids_.reset();
+            res.column_ndv_sketches_.reset();
+            res.ndv_sketch_row_count_ = 0;
+          }
+        }
       }
     }
   }
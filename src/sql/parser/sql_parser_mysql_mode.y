@@ -323,7 +323,7 @@ END_P SET_VAR DELIMITER
         MULTILINESTRING MULTIPOINT MULTIPOLYGON MULTIVALUE MUTEX MYSQL_ERRNO MIGRATION MAX_USED_PART_ID MAXIMIZE
         MATERIALIZED MEMBER MEMSTORE_PERCENT MINVALUE MY_NAME
 
-        NAME NAMES NAMESPACE NATIONAL NCHAR NDB NDBCLUSTER NESTED NEW NEXT NO NOAUDIT NODEGROUP NONE NORMAL NOW NOWAIT NEVER
+        NAME NAMES NAMESPACE NATIONAL NCHAR NDB NDBCLUSTER NESTED NEW NEXT NGRAM_BLOOM_FILTER NO NOAUDIT NODEGROUP NONE NORMAL NOW NOWAIT NEVER
         NOMINVALUE NOMAXVALUE NOORDER NOCYCLE NOCACHE NO_WAIT NULLS NUMBER NVARCHAR NTILE NTH_VALUE NOARCHIVELOG NETWORK NET_BANDWIDTH_WEIGHT NOPARALLEL
         NULL_IF_EXETERNAL
 
@@ -23507,6 +23507,14 @@ MIN_MAX
 {
   malloc_terminal_node($$, result->malloc_pool_, T_COL_SKIP_INDEX_SUM)
 }
+| BLOOM_FILTER
+{
+  malloc_terminal_node($$, result->malloc_pool_, T_COL_SKIP_INDEX_BLOOM_FILTER);
+}
+| NGRAM_BLOOM_FILTER
+{
+  malloc_terminal_node($$, result->malloc_pool_, T_COL_SKIP_INDEX_NGRAM_BLOOM_FILTER);
+}
 ;
 
 lob_chunk_size:
@@ -23992,6 +24000,7 @@ ACCESS_INFO
 |       NEW
 |       NEVER
 |       NEXT
+|       NGRAM_BLOOM_FILTER
 |       NO
 |       NOARCHIVELOG
 |       NOAUDIT
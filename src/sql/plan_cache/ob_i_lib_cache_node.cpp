@@ -154,7 +154,12 @@ int ObILibCacheNode::lock(bool is_rdlock)
 int ObILibCacheNode::update_node_stat(ObILibCacheCtx &ctx)
 {
   int ret = OB_SUCCESS;
-  ATOMIC_STORE(&(node_stat_.last_active_timestamp_), ObClockGenerator::getClock());
+  // the node stat is shared by all sessions hitting the node, only refresh the timestamp
+  // when it is stale enough to avoid bouncing the cache line on every hit
+  const int64_t cur_ts = ObClockGenerator::getClock();
+  if (cur_ts - ATOMIC_LOAD(&(node_stat_.last_active_timestamp_)) > ACTIVE_TS_REFRESH_INTERVAL) {
+    ATOMIC_STORE(&(node_stat_.last_active_timestamp_), cur_ts);
+  }
   ATOMIC_INC(&(node_stat_.execute_count_));
   return ret;
 }
@@ -191,6 +196,28 @@ int64_t ObILibCacheNode::inc_ref_count(const CacheRefHandleID ref_handle)
   return ATOMIC_AAF(&ref_count_, 1);
 }
 
+bool ObILibCacheNode::try_inc_ref_count(const CacheRefHandleID ref_handle)
+{
+  int ret = OB_SUCCESS;
+  bool bool_ret = false;
+  int64_t ref_count = ATOMIC_LOAD(&ref_count_);
+  while (ref_count > 0 && !bool_ret) {
+    const int64_t old_ref_count = ref_count;
+    if (old_ref_count == (ref_count = ATOMIC_VCAS(&ref_count_, old_ref_count, old_ref_count + 1))) {
+      bool_ret = true;
+    }
+  }
+  if (bool_ret && GCONF._enable_plan_cache_mem_diagnosis) {
+    if (OB_ISNULL(lib_cache_)) {
+      ret = OB_INVALID_ARGUMENT;
+      LOG_ERROR("invalid null lib cache", K(ret));
+    } else {
+      lib_cache_->get_ref_handle_mgr().record_ref_op(ref_handle);
+    }
+  }
+  return bool_ret;
+}
+
 int64_t ObILibCacheNode::dec_ref_count(const CacheRefHandleID ref_handle)
 {
   int ret = OB_SUCCESS;
@@ -211,9 +238,9 @@ int64_t ObILibCacheNode::dec_ref_count(const CacheRefHandleID ref_handle)
       ret = OB_ERR_UNEXPECTED;
       LOG_ERROR("invalid null lib cache");
     } else {
-      ObLCNodeFactory &ln_factory = lib_cache_->get_cache_node_factory();
-      lib_cache_->dec_mem_used(get_mem_size());
-      ln_factory.destroy_cache_node(this);
+      // lock free lookups may still be reading the node before taking a reference,
+      // the node is destroyed after they quit
+      lib_cache_->retire_cache_node(this);
     }
   } else {
     LOG_ERROR("invalid pcv_set ref count", K(ref_count));
@@ -41,7 +41,7 @@ struct StmtStat
   int64_t execute_average_time_;
   int64_t execute_slowest_time_;
   int64_t execute_slowest_timestamp_;
-  int64_t execute_count_;                   // used now
+  int64_t execute_count_;                   // not maintained on the lookup path
   int64_t execute_slow_count_;
   int64_t ps_count_;
   bool to_delete_;
@@ -97,12 +97,16 @@ class ObILibCacheNode
 {
 friend class ObLCNodeFactory;
 public:
+  static const int64_t ACTIVE_TS_REFRESH_INTERVAL = 10 * 1000; // 10ms
   ObILibCacheNode(ObPlanCache *lib_cache, lib::MemoryContext &mem_context)
     : mem_context_(mem_context),
       allocator_(mem_context->get_safe_arena_allocator()),
       rwlock_(),
       ref_count_(0),
       lib_cache_(lib_cache),
+      cache_key_(NULL),
+      is_removed_(false),
+      retire_next_(NULL),
       co_list_lock_(common::ObLatchIds::PLAN_SET_LOCK),
       co_list_(allocator_)
   {
@@ -151,8 +155,13 @@ public:
   virtual int lock(bool is_rdlock);
   virtual int update_node_stat(ObILibCacheCtx &ctx);
   StmtStat *get_node_stat() { return &node_stat_; }
+  int64_t get_last_active_timestamp() const { return ATOMIC_LOAD(&(node_stat_.last_active_timestamp_)); }
   int unlock() { return rwlock_.unlock(); }
   int64_t inc_ref_count(const CacheRefHandleID ref_handle);
+  // take a reference only if the node is still referenced, never blocks. Used inside the
+  // critical section of the lock free lookup, which may see a node whose reference count
+  // has dropped to zero and which is waiting for reclaim
+  bool try_inc_ref_count(const CacheRefHandleID ref_handle);
   int64_t dec_ref_count(const CacheRefHandleID ref_handle);
   int64_t get_ref_count() const { return ATOMIC_LOAD(&ref_count_); }
   common::ObIAllocator *get_allocator() { return &allocator_; }
@@ -160,8 +169,17 @@ public:
   lib::MemoryContext &get_mem_context() { return mem_context_; }
   int64_t get_mem_size();
   ObPlanCache *get_lib_cache() const { return lib_cache_; }
+  // key of the node in cache_key_node_map_, allocated by allocator_
+  void set_cache_key(ObILibCacheKey *cache_key) { cache_key_ = cache_key; }
+  ObILibCacheKey *get_cache_key() const { return cache_key_; }
+  // the node has been erased from cache_key_node_map_ and must not be published to the
+  // lock free lookup slots of ObPlanCache any more
+  void mark_removed() { ATOMIC_STORE(&is_removed_, true); }
+  bool is_removed() const { return ATOMIC_LOAD(&is_removed_); }
+  ObILibCacheNode *get_retire_next() const { return retire_next_; }
+  void set_retire_next(ObILibCacheNode *node) { retire_next_ = node; }
 
-  VIRTUAL_TO_STRING_KV(K_(ref_count), K_(lock_timeout_ts));
+  VIRTUAL_TO_STRING_KV(K_(ref_count), K_(lock_timeout_ts), K_(is_removed));
 
 protected:
   void set_lock_timeout_threshold(int64_t threshold)
@@ -211,6 +229,10 @@ protected:
   ObPlanCache *lib_cache_;
   common::SpinRWLock co_list_lock_;
   CacheObjList co_list_;
+  ObILibCacheKey *cache_key_;
+  bool is_removed_;
+  // link of the nodes waiting for reclaim in ObPlanCache
+  ObILibCacheNode *retire_next_;
 };
 
 } // namespace common
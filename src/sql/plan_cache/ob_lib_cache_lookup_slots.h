@@ -0,0 +1,232 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_PLAN_CACHE_OB_LIB_CACHE_LOOKUP_SLOTS_
+#define OCEANBASE_SQL_PLAN_CACHE_OB_LIB_CACHE_LOOKUP_SLOTS_
+
+#include "lib/allocator/ob_malloc.h"
+#include "lib/allocator/ob_retire_station.h"
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/oblog/ob_log_module.h"
+#include "common/ob_clock_generator.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+// A fixed array of slots, each one caches a node of the lib cache by the hash of its key, so
+// that cache hits need not take the bucket latch of the map. Lookups read the slots inside the
+// critical section of the QClock and only take a reference on the node there. A node is retired when it
+// is no longer referenced, moved to retire_list_ at a quiescent point and reclaimed at the next
+// one, when no lookup can see it any more, the same scheme as RetireStation.
+//
+// Node is required to provide:
+//   const Key *get_cache_key() const;
+//   bool is_removed() const;
+//   void mark_removed();
+//   int64_t get_last_active_timestamp() const;
+//   Node *get_retire_next() const;
+//   void set_retire_next(Node *node);
+template <typename Node, typename Key>
+class ObLCLookupSlots
+{
+public:
+  explicit ObLCLookupSlots(common::QClock &qclock)
+    : qclock_(qclock),
+      slots_(NULL),
+      slot_cnt_(0),
+      replace_interval_(0),
+      retire_lock_(),
+      retire_clock_(0),
+      prepare_list_(NULL),
+      retire_list_(NULL),
+      retire_cnt_(0)
+  {
+  }
+  ~ObLCLookupSlots() { destroy(); }
+  // @slot_cnt must be a power of 2, a slot holding a node which has been active within
+  // @replace_interval(us) is not taken over by other keys hashed to it
+  int init(const int64_t slot_cnt, const int64_t replace_interval, const common::ObMemAttr &attr);
+  // the retired nodes are left to the caller, see reclaim
+  void destroy();
+  bool is_inited() const { return NULL != slots_; }
+  // call @fn(Node &) inside the critical section if the slot of @key holds it, return
+  // OB_ENTRY_NOT_EXIST if the slot does not hold @key. A long critical section delays the
+  // reclaim of every retired node, so @fn must not block and should only take a reference on
+  // the node, which is used after leaving the section
+  template <typename Fn>
+  int lookup(const Key &key, Fn &fn);
+  // @node must be referenced by the caller
+  void publish(Node *node);
+  // called after @node is erased from the map
+  void unpublish(Node *node);
+  // called when @node is no longer referenced, it is passed to reclaim later
+  void retire(Node *node);
+  // call @fn(Node *) on the retired nodes which are invisible to lookups,
+  // wait for the lookups reading them if @force
+  template <typename Fn>
+  void reclaim(const bool force, Fn &fn);
+  // count of the nodes retired but not reclaimed yet
+  int64_t get_retire_cnt() const { return ATOMIC_LOAD(&retire_cnt_); }
+private:
+  Node **locate(const Key &key) const
+  {
+    return slots_ + (key.hash() & (slot_cnt_ - 1));
+  }
+private:
+  common::QClock &qclock_;
+  Node **slots_;
+  int64_t slot_cnt_;
+  int64_t replace_interval_;
+  common::ObSpinLock retire_lock_;
+  uint64_t retire_clock_;
+  Node *prepare_list_;
+  Node *retire_list_;
+  int64_t retire_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObLCLookupSlots);
+};
+
+template <typename Node, typename Key>
+int ObLCLookupSlots<Node, Key>::init(const int64_t slot_cnt,
+                                     const int64_t replace_interval,
+                                     const common::ObMemAttr &attr)
+{
+  int ret = common::OB_SUCCESS;
+  if (OB_NOT_NULL(slots_)) {
+    ret = common::OB_INIT_TWICE;
+    SQL_PC_LOG(WARN, "lookup slots init twice", K(ret));
+  } else if (OB_UNLIKELY(slot_cnt <= 0 || 0 != (slot_cnt & (slot_cnt - 1)) || replace_interval < 0)) {
+    ret = common::OB_INVALID_ARGUMENT;
+    SQL_PC_LOG(WARN, "invalid argument", K(ret), K(slot_cnt), K(replace_interval));
+  } else if (OB_ISNULL(slots_ = static_cast<Node **>(common::ob_malloc(sizeof(Node *) * slot_cnt, attr)))) {
+    ret = common::OB_ALLOCATE_MEMORY_FAILED;
+    SQL_PC_LOG(WARN, "failed to alloc lookup slots", K(ret), K(slot_cnt));
+  } else {
+    MEMSET(slots_, 0, sizeof(Node *) * slot_cnt);
+    slot_cnt_ = slot_cnt;
+    replace_interval_ = replace_interval;
+  }
+  return ret;
+}
+
+template <typename Node, typename Key>
+void ObLCLookupSlots<Node, Key>::destroy()
+{
+  if (OB_NOT_NULL(slots_)) {
+    common::ob_free(slots_);
+    slots_ = NULL;
+  }
+  slot_cnt_ = 0;
+}
+
+template <typename Node, typename Key>
+template <typename Fn>
+int ObLCLookupSlots<Node, Key>::lookup(const Key &key, Fn &fn)
+{
+  int ret = common::OB_ENTRY_NOT_EXIST;
+  if (OB_NOT_NULL(slots_)) {
+    // the node read from the slot is not reclaimed before leaving the critical section
+    common::QClockGuard guard(qclock_);
+    Node *node = ATOMIC_LOAD(locate(key));
+    if (NULL != node
+        && !node->is_removed()
+        && NULL != node->get_cache_key()
+        && *node->get_cache_key() == key) {
+      ret = fn(*node);
+    }
+  }
+  return ret;
+}
+
+template <typename Node, typename Key>
+void ObLCLookupSlots<Node, Key>::publish(Node *node)
+{
+  if (OB_NOT_NULL(slots_) && OB_NOT_NULL(node) && OB_NOT_NULL(node->get_cache_key())) {
+    // the node in the slot may be retired concurrently
+    common::QClockGuard guard(qclock_);
+    Node **slot = locate(*node->get_cache_key());
+    Node *old_node = ATOMIC_LOAD(slot);
+    if (old_node == node || node->is_removed()) {
+      // do nothing
+    } else if (NULL != old_node
+               && !old_node->is_removed()
+               && common::ObClockGenerator::getClock() - old_node->get_last_active_timestamp()
+                  < replace_interval_) {
+      // keep the slot for the active node
+    } else if (ATOMIC_BCAS(slot, old_node, node)) {
+      // the node may be erased from the map concurrently, either this thread sees it
+      // removed or unpublish sees it in the slot
+      if (node->is_removed()) {
+        (void)ATOMIC_BCAS(slot, node, NULL);
+      }
+    }
+  }
+}
+
+template <typename Node, typename Key>
+void ObLCLookupSlots<Node, Key>::unpublish(Node *node)
+{
+  if (OB_NOT_NULL(node)) {
+    node->mark_removed();
+    if (OB_NOT_NULL(slots_) && OB_NOT_NULL(node->get_cache_key())) {
+      (void)ATOMIC_BCAS(locate(*node->get_cache_key()), node, NULL);
+    }
+  }
+}
+
+template <typename Node, typename Key>
+void ObLCLookupSlots<Node, Key>::retire(Node *node)
+{
+  if (OB_NOT_NULL(node)) {
+    unpublish(node);
+    common::ObSpinLockGuard guard(retire_lock_);
+    node->set_retire_next(prepare_list_);
+    prepare_list_ = node;
+    ATOMIC_INC(&retire_cnt_);
+  }
+}
+
+template <typename Node, typename Key>
+template <typename Fn>
+void ObLCLookupSlots<Node, Key>::reclaim(const bool force, Fn &fn)
+{
+  for (int64_t i = 0; i < (force ? 2 : 1); ++i) {
+    Node *reclaim_list = NULL;
+    {
+      common::ObSpinLockGuard guard(retire_lock_);
+      if (NULL == prepare_list_ && NULL == retire_list_) {
+        // do nothing
+      } else if (force) {
+        retire_clock_ = qclock_.wait_quiescent(retire_clock_);
+        reclaim_list = retire_list_;
+        retire_list_ = prepare_list_;
+        prepare_list_ = NULL;
+      } else if (qclock_.try_quiescent(retire_clock_)) {
+        reclaim_list = retire_list_;
+        retire_list_ = prepare_list_;
+        prepare_list_ = NULL;
+      }
+    }
+    while (NULL != reclaim_list) {
+      Node *node = reclaim_list;
+      reclaim_list = node->get_retire_next();
+      node->set_retire_next(NULL);
+      ATOMIC_DEC(&retire_cnt_);
+      fn(node);
+    }
+  }
+}
+
+} // namespace sql
+} // namespace oceanbase
+
+#endif // OCEANBASE_SQL_PLAN_CACHE_OB_LIB_CACHE_LOOKUP_SLOTS_
@@ -372,6 +372,7 @@ ObPlanCache::ObPlanCache()
    ref_handle_mgr_(),
    pcm_(NULL),
    destroy_(0),
+   lookup_slots_(get_lookup_qclock()),
    tg_id_(-1)
 {
 }
@@ -389,6 +390,8 @@ void ObPlanCache::destroy()
     if (OB_SUCCESS != (cache_evict_all_obj())) {
       SQL_PC_LOG_RET(WARN, OB_ERROR, "fail to evict all lib cache cache");
     }
+    reclaim_cache_nodes(true /*force*/);
+    lookup_slots_.destroy();
     if (root_context_ != NULL) {
       DESTROY_CONTEXT(root_context_);
       root_context_ = NULL;
@@ -423,6 +426,9 @@ int ObPlanCache::init(int64_t hash_bucket, uint64_t tenant_id)
       LOG_WARN("failed to schedule refresh task", K(ret));
     } else if (OB_FAIL(set_mem_conf(default_conf))) {
       LOG_WARN("fail to set plan cache memory conf", K(ret));
+    } else if (OB_FAIL(lookup_slots_.init(LOOKUP_SLOT_CNT, LOOKUP_SLOT_REPLACE_INTERVAL,
+                                          ObMemAttr(tenant_id, "PCLookupSlot")))) {
+      LOG_WARN("failed to init lookup slots", K(ret));
     } else {
       evict_task_.plan_cache_ = this;
       cn_factory_.set_lib_cache(this);
@@ -1142,6 +1148,7 @@ int ObPlanCache::add_cache_obj(ObILibCacheCtx &ctx,
     }
     if (OB_SUCC(ret)) {
       cache_node->inc_ref_count(LC_NODE_HANDLE); //inc ref count in block
+      cache_node->set_cache_key(cache_key);
       int hash_err = cache_key_node_map_.set_refactored(cache_key, cache_node);
       if (OB_HASH_EXIST == hash_err) { //may be this node has been set by other thread。
         cache_node->unlock();
@@ -1185,6 +1192,7 @@ int ObPlanCache::add_cache_obj(ObILibCacheCtx &ctx,
             ret = OB_ERR_UNEXPECTED;
             LOG_WARN("unexpected error", K(ret), K(tmp_ret), K(del_node), K(cache_node));
           } else {
+            lookup_slots_.unpublish(cache_node);
             cache_node->unlock();
             cache_node->dec_ref_count(LC_NODE_HANDLE); //cache node dec ref in block
             cache_node->dec_ref_count(LC_NODE_HANDLE); //cache node dec ref in alloc
@@ -1222,12 +1230,20 @@ int ObPlanCache::get_cache_obj(ObILibCacheCtx &ctx,
 {
   int ret = OB_SUCCESS;
   ObILibCacheNode *cache_node = NULL;
-  ObILibCacheObject *cache_obj = NULL;
+  bool is_hit = false;
+  const bool use_lookup_slots = GCONF._enable_plan_cache_lock_free_lookup
+                                && lookup_slots_.is_inited();
   // get the read lock and increase reference count
   ObLibCacheRlockAndRef r_ref_lock(LC_NODE_RD_HANDLE);
   if (OB_ISNULL(key)) {
     ret = OB_INVALID_ARGUMENT;
     SQL_PC_LOG(WARN, "invalid null argument", K(ret), K(key));
+  } else if (use_lookup_slots && OB_FAIL(lock_free_get_cache_obj(ctx, key, guard, is_hit))) {
+    if (OB_SQL_PC_NOT_EXIST != ret) {
+      LOG_DEBUG("failed to get cache obj from lookup slot", K(ret));
+    }
+  } else if (is_hit) {
+    // got from lookup slot
   } else if (OB_FAIL(get_value(key, cache_node, r_ref_lock /*read locked*/))) {
     ret = OB_ERR_UNEXPECTED;
     SQL_PC_LOG(TRACE, "failed to get cache node from lib cache by key", K(ret));
@@ -1236,15 +1252,9 @@ int ObPlanCache::get_cache_obj(ObILibCacheCtx &ctx,
     SQL_PC_LOG(DEBUG, "cache obj does not exist!", K(key));
   } else {
     LOG_DEBUG("inner_get_cache_obj", K(key), K(cache_node));
-    if (OB_FAIL(cache_node->update_node_stat(ctx))) {
-      SQL_PC_LOG(WARN, "failed to update node stat",  K(ret));
-    } else if (OB_FAIL(cache_node->get_cache_obj(ctx, key, cache_obj))) {
-      if (OB_SQL_PC_NOT_EXIST != ret) {
-        LOG_DEBUG("cache_node fail to get cache obj", K(ret));
-      }
-    } else {
-      guard.cache_obj_ = cache_obj;
-      LOG_DEBUG("succ to get cache obj", KPC(key));
+    ret = get_cache_obj_from_node(ctx, key, cache_node, guard);
+    if (use_lookup_slots) {
+      lookup_slots_.publish(cache_node);
     }
     // release lock whatever
     (void)cache_node->unlock();
@@ -1255,6 +1265,96 @@ int ObPlanCache::get_cache_obj(ObILibCacheCtx &ctx,
   return ret;
 }
 
+int ObPlanCache::get_cache_obj_from_node(ObILibCacheCtx &ctx,
+                                         ObILibCacheKey *key,
+                                         ObILibCacheNode *cache_node,
+                                         ObCacheObjGuard &guard)
+{
+  int ret = OB_SUCCESS;
+  ObILibCacheObject *cache_obj = NULL;
+  if (OB_ISNULL(key) || OB_ISNULL(cache_node)) {
+    ret = OB_INVALID_ARGUMENT;
+    SQL_PC_LOG(WARN, "invalid null argument", K(ret), K(key), K(cache_node));
+  } else if (OB_FAIL(cache_node->update_node_stat(ctx))) {
+    SQL_PC_LOG(WARN, "failed to update node stat",  K(ret));
+  } else if (OB_FAIL(cache_node->get_cache_obj(ctx, key, cache_obj))) {
+    if (OB_SQL_PC_NOT_EXIST != ret) {
+      LOG_DEBUG("cache_node fail to get cache obj", K(ret));
+    }
+  } else {
+    guard.cache_obj_ = cache_obj;
+    LOG_DEBUG("succ to get cache obj", KPC(key));
+  }
+  return ret;
+}
+
+int ObPlanCache::lock_free_get_cache_obj(ObILibCacheCtx &ctx,
+                                         ObILibCacheKey *key,
+                                         ObCacheObjGuard &guard,
+                                         bool &is_hit)
+{
+  int ret = OB_SUCCESS;
+  ObILibCacheNode *cache_node = NULL;
+  is_hit = false;
+  // runs inside the critical section of get_lookup_qclock(), which holds back the reclaim of
+  // all retired nodes, so it only takes a reference on the node and the matching is done
+  // after leaving the section
+  auto ref_node = [&](ObILibCacheNode &node) -> int {
+    int tmp_ret = OB_SUCCESS;
+    if (!node.try_inc_ref_count(LC_NODE_RD_HANDLE)) {
+      // the node is retired, look up cache_key_node_map_
+      tmp_ret = OB_ENTRY_NOT_EXIST;
+    } else {
+      cache_node = &node;
+    }
+    return tmp_ret;
+  };
+  if (OB_FAIL(lookup_slots_.lookup(*key, ref_node))) {
+    // miss, look up cache_key_node_map_
+    ret = OB_SUCCESS;
+  } else if (OB_ISNULL(cache_node)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("cache node is null", K(ret));
+  } else {
+    if (OB_FAIL(cache_node->lock(true /*is_rdlock*/))) {
+      LOG_WARN("failed to lock cache node", K(ret));
+    } else {
+      is_hit = true;
+      LOG_DEBUG("lock free get cache obj", K(key), K(cache_node));
+      ret = get_cache_obj_from_node(ctx, key, cache_node, guard);
+      // release lock whatever
+      (void)cache_node->unlock();
+      NG_TRACE(pc_choose_plan);
+    }
+    (void)cache_node->dec_ref_count(LC_NODE_RD_HANDLE);
+  }
+  return ret;
+}
+
+void ObPlanCache::retire_cache_node(ObILibCacheNode *node)
+{
+  if (OB_ISNULL(node)) {
+    // do nothing
+  } else if (!lookup_slots_.is_inited()) {
+    dec_mem_used(node->get_mem_size());
+    cn_factory_.destroy_cache_node(node);
+  } else {
+    // the node is invisible to the eviction once retired, so its memory is released from
+    // mem_used_ now rather than when it is destroyed
+    dec_mem_used(node->get_mem_size());
+    lookup_slots_.retire(node);
+    reclaim_cache_nodes(false /*force*/);
+  }
+}
+
+void ObPlanCache::reclaim_cache_nodes(const bool force)
+{
+  auto destroy_node = [&](ObILibCacheNode *node) {
+    cn_factory_.destroy_cache_node(node);
+  };
+  lookup_slots_.reclaim(force, destroy_node);
+}
+
 int ObPlanCache::cache_node_exists(ObILibCacheKey* key,
                                    bool& is_exists)
 {
@@ -1695,6 +1795,7 @@ int ObPlanCache::remove_cache_node(ObILibCacheKey *key)
   hash_err = cache_key_node_map_.erase_refactored(key, &del_node);
   if (OB_SUCCESS == hash_err) {
     if (NULL != del_node) {
+      lookup_slots_.unpublish(del_node);
       del_node->dec_ref_count(LC_NODE_HANDLE);
     } else {
       ret = OB_ERR_UNEXPECTED;
@@ -2724,6 +2825,8 @@ void ObPlanCacheEliminationTask::run_plan_cache_task()
   if (OB_FAIL(plan_cache_->update_memory_conf())) { //如果失败, 则不更新设置, 也不影响其他流程
     SQL_PC_LOG(WARN, "fail to update plan cache memory sys val", K(ret));
   }
+  // destroy the retired cache nodes left by the last eviction
+  plan_cache_->reclaim_cache_nodes(false /*force*/);
   if (OB_FAIL(plan_cache_->cache_evict())) {
     SQL_PC_LOG(ERROR, "Plan cache evict failed, please check", K(ret));
   }  else if (OB_FAIL(plan_cache_->cache_evict_by_glitch_node())) {
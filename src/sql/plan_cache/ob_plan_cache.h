@@ -16,6 +16,7 @@
 #include "lib/net/ob_addr.h"
 #include "lib/hash/ob_hashmap.h"
 #include "lib/alloc/alloc_func.h"
+#include "lib/allocator/ob_retire_station.h"
 #include "sql/plan_cache/ob_plan_cache_util.h"
 #include "sql/plan_cache/ob_id_manager_allocator.h"
 #include "sql/plan_cache/ob_sql_parameterization.h"
@@ -24,6 +25,7 @@
 #include "sql/plan_cache/ob_lib_cache_key_creator.h"
 #include "sql/plan_cache/ob_lib_cache_node_factory.h"
 #include "sql/plan_cache/ob_lib_cache_object_manager.h"
+#include "sql/plan_cache/ob_lib_cache_lookup_slots.h"
 namespace oceanbase
 {
 namespace observer
@@ -384,6 +386,12 @@ public:
   int remove_cache_node(ObILibCacheKey *key);
   ObLCObjectManager &get_cache_obj_mgr() { return co_mgr_; }
   ObLCNodeFactory &get_cache_node_factory() { return cn_factory_; }
+  // called when the reference count of @node drops to zero, the memory of @node is released
+  // from mem_used_ at once, while @node is destroyed after all the lock free lookups which
+  // may be reading it have quit
+  void retire_cache_node(ObILibCacheNode *node);
+  // destroy the retired nodes which are invisible to lookups, wait for the lookups if @force
+  void reclaim_cache_nodes(const bool force);
   int alloc_cache_obj(ObCacheObjGuard& guard, ObLibCacheNameSpace ns, uint64_t tenant_id);
   void free_cache_obj(ObILibCacheObject *&cache_obj, const CacheRefHandleID ref_handle);
   int destroy_cache_obj(const bool is_leaked, const uint64_t object_id);
@@ -469,11 +477,30 @@ private:
                               const ObILibCacheObject &cache_object);
   int check_after_get_plan(int tmp_ret, ObILibCacheCtx &ctx, ObILibCacheObject *cache_obj);
   int get_normalized_pattern_digest(const ObPlanCacheCtx &pc_ctx, uint64_t &pattern_digest);
+  int get_cache_obj_from_node(ObILibCacheCtx &ctx,
+                              ObILibCacheKey *key,
+                              ObILibCacheNode *cache_node,
+                              ObCacheObjGuard &guard);
+  // look up @key in lookup_slots_ without touching the bucket latch of cache_key_node_map_
+  // and the reference count of the cache node, @is_hit is false if the slot does not hold @key
+  // or the node is write locked
+  int lock_free_get_cache_obj(ObILibCacheCtx &ctx,
+                              ObILibCacheKey *key,
+                              ObCacheObjGuard &guard,
+                              bool &is_hit);
+  static common::QClock &get_lookup_qclock()
+  {
+    static common::QClock lookup_qclock;
+    return lookup_qclock;
+  }
 private:
   enum PlanCacheGCStrategy { INVALID = -1, OFF = 0, REPORT = 1, AUTO = 2};
   static int get_plan_cache_gc_strategy();
 private:
   const static int64_t SLICE_SIZE = 1024; //1k
+  const static int64_t LOOKUP_SLOT_CNT = 1L << 13;
+  // a slot holding an active node is not taken over by other keys hashed to it
+  const static int64_t LOOKUP_SLOT_REPLACE_INTERVAL = 1000L * 1000L; // 1s
 private:
   bool inited_;
   int64_t tenant_id_;
@@ -494,6 +521,9 @@ private:
   ObLCObjectManager co_mgr_;
   ObLCNodeFactory cn_factory_;
   CacheKeyNodeMap cache_key_node_map_;
+  // caches the nodes of cache_key_node_map_ for the lock free lookup, readers are protected
+  // by get_lookup_qclock()
+  ObLCLookupSlots<ObILibCacheNode, ObILibCacheKey> lookup_slots_;
   ObPlanCacheEliminationTask evict_task_;
   int tg_id_;
 };
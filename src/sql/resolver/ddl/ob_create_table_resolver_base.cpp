@@ -237,6 +237,18 @@ int ObCreateTableResolverBase::set_table_option_to_schema(ObTableSchema &table_s
       }
     }
 
+    if (OB_SUCC(ret) && table_schema.get_compressor_type() == ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR) {
+      uint64_t tenant_data_version = 0;
+      if (OB_FAIL(GET_MIN_DATA_VERSION(session_info_->get_effective_tenant_id(), tenant_data_version))) {
+        LOG_WARN("get tenant data version failed", K(ret));
+      } else if (tenant_data_version < DATA_VERSION_4_3_5_0) {
+        ret = OB_NOT_SUPPORTED;
+        LOG_WARN("tenant version is less than 4.3.5, zstd_dict compress method is not supported",
+                 K(ret), K(tenant_data_version));
+        LOG_USER_ERROR(OB_NOT_SUPPORTED, "version is less than 4.3.5, zstd_dict");
+      }
+    }
+
     if (OB_SUCC(ret)) {
       // if lob_inrow_threshold not set, used config default_lob_inrow_threshold
       uint64_t tenant_data_version = 0;
@@ -723,6 +723,7 @@ public:
                                  _query_record_size_limit_(65536),
                                  enable_column_store_(false),
                                  enable_decimal_int_type_(false),
+                                 enable_batch_result_encoding_(false),
                                  print_sample_ppm_(0),
                                  last_check_ec_ts_(0),
                                  sql_plan_management_mode_(0),
@@ -750,6 +751,7 @@ public:
     int64_t get_query_record_size_limit() const { return _query_record_size_limit_; }
     bool get_enable_column_store() const { return enable_column_store_; }
     bool get_enable_decimal_int_type() const { return enable_decimal_int_type_; }
+    bool get_enable_batch_result_encoding() const { return enable_batch_result_encoding_; }
     int64_t get_sql_plan_management_mode() const { return sql_plan_management_mode_; }
   private:
     //租户级别配置项缓存session 上，避免每次获取都需要刷新
@@ -772,6 +774,7 @@ public:
     int64_t _query_record_size_limit_;
     bool enable_column_store_;
     bool enable_decimal_int_type_;
+    bool enable_batch_result_encoding_;
     // for record sys config print_sample_ppm
     int64_t print_sample_ppm_;
     int64_t last_check_ec_ts_;
@@ -1419,6 +1422,11 @@ public:
     cached_tenant_config_info_.refresh();
     return cached_tenant_config_info_.get_enable_decimal_int_type();
   }
+  bool is_enable_batch_result_encoding()
+  {
+    cached_tenant_config_info_.refresh();
+    return cached_tenant_config_info_.get_enable_batch_result_encoding();
+  }
   int64_t get_tenant_query_record_size_limit()
   {
     cached_tenant_config_info_.refresh();
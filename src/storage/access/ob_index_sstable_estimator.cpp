@@ -324,6 +324,7 @@ int ObIndexBlockScanEstimator::prefetch_index_block_data(
     } else if (ObSSTableMicroBlockState::UNKNOWN_STATE == micro_handle.block_state_) {
       micro_handle.tenant_id_ = tenant_id_;
       micro_handle.macro_block_id_ = micro_index_info.get_macro_id();
+      micro_handle.nested_offset_ = micro_index_info.nested_offset_;
       micro_handle.block_state_ = ObSSTableMicroBlockState::IN_BLOCK_IO;
       micro_handle.micro_info_.set(micro_index_info.get_block_offset(),
                                    micro_index_info.get_block_size(),
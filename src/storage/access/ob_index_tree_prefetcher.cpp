@@ -1065,7 +1065,6 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::i
       ret = OB_INVALID_ARGUMENT;
       LOG_WARN("invalid store iterator type", K(ret), K(iter_type));
   }
-  max_rescan_range_cnt_ = max_range_prefetching_cnt_ > max_rescan_range_cnt_ ? max_range_prefetching_cnt_ : max_rescan_range_cnt_;
   bool is_normal_query = !access_ctx_->query_flag_.is_daily_merge() && !access_ctx_->query_flag_.is_multi_version_minor_merge();
   if (OB_FAIL(ret)) {
   } else if (OB_FAIL(iter_param.get_index_read_info(sstable.is_normal_cg_sstable(), index_read_info))) {
@@ -1078,8 +1077,13 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::i
   } else if (1 >= index_tree_height_ || MAX_INDEX_TREE_HEIGHT < index_tree_height_) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("Unexpected index tree height", K(ret), K(index_tree_height_));
+  } else if (is_multi_range_iter(iter_type) && range_count > max_range_prefetching_cnt_) {
+    max_range_prefetching_cnt_ = calc_multi_range_prefetch_cnt(range_count);
+  }
+  if (OB_FAIL(ret)) {
+  } else if (FALSE_IT(max_rescan_range_cnt_ = max_range_prefetching_cnt_ > max_rescan_range_cnt_ ? max_range_prefetching_cnt_ : max_rescan_range_cnt_)) {
   } else if (iter_param.is_use_global_iter_pool()) {
-    max_handle_cnt = DEFAULT_SCAN_RANGE_PREFETCH_CNT;
+    max_handle_cnt = MAX(DEFAULT_SCAN_RANGE_PREFETCH_CNT, max_range_prefetching_cnt_);
     max_height = MAX_INDEX_TREE_HEIGHT;
   } else {
     max_handle_cnt = max_range_prefetching_cnt_;
@@ -1101,6 +1105,34 @@ int ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::i
   return ret;
 }
 
+// Small ranges of batched lookups (e.g. das group scan) end in one or two micro blocks each,
+// with a window of DEFAULT_SCAN_RANGE_PREFETCH_CNT ranges the pipeline drains at every range
+// border. Widen the window so that the leaf blocks of the next ranges are read asynchronously
+// while the current range is consumed. The window is bounded by the micro data handles and by
+// MULTI_RANGE_PREFETCH_MEM_LIMIT of the average micro block size of the sstable.
+template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
+int32_t ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::calc_multi_range_prefetch_cnt(
+    const int32_t range_count) const
+{
+  const ObSSTableMeta &sstable_meta = sstable_meta_handle_.get_sstable_meta();
+  const int64_t avg_micro_size = sstable_meta.get_occupy_size() / MAX(1, sstable_meta.get_data_micro_block_count());
+  return calc_multi_range_prefetch_cnt(range_count, avg_micro_size, max_micro_handle_cnt_, max_range_prefetching_cnt_);
+}
+
+template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
+int32_t ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::calc_multi_range_prefetch_cnt(
+    const int32_t range_count,
+    const int64_t avg_micro_size,
+    const int32_t max_micro_handle_cnt,
+    const int32_t min_prefetch_cnt)
+{
+  int64_t prefetch_cnt = MIN(range_count, MIN(MAX_SCAN_RANGE_PREFETCH_CNT, max_micro_handle_cnt));
+  prefetch_cnt = MIN(prefetch_cnt, MULTI_RANGE_PREFETCH_MEM_LIMIT / MAX(1, avg_micro_size));
+  prefetch_cnt = MAX(prefetch_cnt, min_prefetch_cnt);
+  LOG_DEBUG("multi range prefetch window", K(range_count), K(avg_micro_size), K(max_micro_handle_cnt), K(prefetch_cnt));
+  return static_cast<int32_t>(prefetch_cnt);
+}
+
 template <int32_t DATA_PREFETCH_DEPTH, int32_t INDEX_PREFETCH_DEPTH>
 void ObIndexTreeMultiPassPrefetcher<DATA_PREFETCH_DEPTH, INDEX_PREFETCH_DEPTH>::inc_cur_micro_data_fetch_idx()
 {
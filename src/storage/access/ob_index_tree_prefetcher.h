@@ -527,6 +527,19 @@ protected:
   void reclaim_tree_handles();
   void inner_reset();
   virtual int init_tree_handles(const int64_t count);
+  OB_INLINE static bool is_multi_range_iter(const int iter_type)
+  {
+    return ObStoreRowIterator::IteratorMultiScan == iter_type
+        || ObStoreRowIterator::IteratorCOMultiScan == iter_type
+        || ObStoreRowIterator::IteratorMultiGet == iter_type
+        || ObStoreRowIterator::IteratorCOMultiGet == iter_type;
+  }
+  int32_t calc_multi_range_prefetch_cnt(const int32_t range_count) const;
+  static int32_t calc_multi_range_prefetch_cnt(
+      const int32_t range_count,
+      const int64_t avg_micro_size,
+      const int32_t max_micro_handle_cnt,
+      const int32_t min_prefetch_cnt);
   int get_prefetch_depth(int64_t &depth);
   int prefetch_data_block(
       const int64_t prefetch_idx,
@@ -535,6 +548,9 @@ protected:
   int prefetch_multi_data_block(const int64_t max_prefetch_idx);
 
   static const int32_t DEFAULT_SCAN_RANGE_PREFETCH_CNT = 4;
+  // cross range prefetch window of multi scan/get, see calc_multi_range_prefetch_cnt
+  static const int32_t MAX_SCAN_RANGE_PREFETCH_CNT = 32;
+  static const int64_t MULTI_RANGE_PREFETCH_MEM_LIMIT = 2L << 20; // 2MB
   static const int32_t DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT = DATA_PREFETCH_DEPTH;
   static const int32_t INDEX_TREE_PREFETCH_DEPTH = INDEX_PREFETCH_DEPTH;
   static const int32_t SSTABLE_MICRO_AVG_COUNT = 100;
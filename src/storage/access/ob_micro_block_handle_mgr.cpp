@@ -29,6 +29,7 @@ namespace storage {
 ObMicroBlockDataHandle::ObMicroBlockDataHandle()
   : tenant_id_(OB_INVALID_TENANT_ID),
     macro_block_id_(),
+    nested_offset_(0),
     block_state_(ObSSTableMicroBlockState::UNKNOWN_STATE),
     block_index_(-1),
     micro_info_(),
@@ -52,6 +53,7 @@ ObMicroBlockDataHandle::~ObMicroBlockDataHandle()
 void ObMicroBlockDataHandle::init(
   const uint64_t tenant_id,
   const MacroBlockId &macro_id,
+  const int64_t nested_offset,
   const int64_t offset,
   const int64_t size,
   const ObLogicMicroBlockId &logic_micro_id,
@@ -60,6 +62,7 @@ void ObMicroBlockDataHandle::init(
 {
   tenant_id_ = tenant_id;
   macro_block_id_ = macro_id;
+  nested_offset_ = nested_offset;
   micro_info_.set(offset, size, logic_micro_id, data_checksum);
   handle_mgr_ = handle_mgr;
 }
@@ -73,6 +76,7 @@ void ObMicroBlockDataHandle::reset()
   block_state_ = ObSSTableMicroBlockState::UNKNOWN_STATE;
   tenant_id_ = OB_INVALID_TENANT_ID;
   macro_block_id_.reset();
+  nested_offset_ = 0;
   block_index_ = -1;
   micro_info_.reset();
   cache_handle_.reset();
@@ -116,6 +120,7 @@ int ObMicroBlockDataHandle::get_micro_block_data(
         is_loaded_block_ = true;
         if (OB_FAIL(ObStorageCacheSuite::get_instance().get_micro_block_cache(is_data_block).load_block(
                     micro_block_id,
+                    nested_offset_,
                     des_meta_,
                     micro_info_.logic_micro_id_,
                     micro_info_.data_checksum_,
@@ -172,6 +177,7 @@ ObMicroBlockDataHandle & ObMicroBlockDataHandle::operator=(const ObMicroBlockDat
     reset();
     tenant_id_ = other.tenant_id_;
     macro_block_id_ = other.macro_block_id_;
+    nested_offset_ = other.nested_offset_;
     block_state_ = other.block_state_;
     block_index_ = other.block_index_;
     micro_info_ = other.micro_info_;
@@ -425,7 +431,8 @@ int ObMicroBlockHandleMgr::get_micro_block_handle(
     LOG_WARN("Unexpect null index header", K(ret), KP(idx_header));
   } else if (OB_FAIL(idx_header->fill_micro_des_meta(true /* deep_copy_key */, micro_block_handle.des_meta_))) {
     LOG_WARN("Fail to fill micro block deserialize meta", K(ret));
-  } else if (FALSE_IT(micro_block_handle.init(tenant_id, macro_id, offset, size, index_block_info.get_logic_micro_id(),
+  } else if (FALSE_IT(micro_block_handle.init(tenant_id, macro_id, index_block_info.nested_offset_, offset, size,
+                                              index_block_info.get_logic_micro_id(),
                                               index_block_info.get_data_checksum(), this))) {
   } else if (OB_LIKELY(nullptr != ps_node)
       && OB_SUCC(ps_node->access_mem_ptr(micro_block_handle.cache_handle_))) {
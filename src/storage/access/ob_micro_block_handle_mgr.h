@@ -45,6 +45,7 @@ struct ObMicroBlockDataHandle
   void init(
       const uint64_t tenant_id,
       const blocksstable::MacroBlockId &macro_id,
+      const int64_t nested_offset,
       const int64_t offset,
       const int64_t size,
       const ObLogicMicroBlockId &logic_micro_id,
@@ -65,10 +66,12 @@ struct ObMicroBlockDataHandle
   { return ObSSTableMicroBlockState::IN_BLOCK_CACHE == block_state_ || ObSSTableMicroBlockState::IN_BLOCK_IO == block_state_; }
   OB_INLINE bool need_multi_io() const
   { return ObSSTableMicroBlockState::NEED_MULTI_IO == block_state_; }
-  TO_STRING_KV(K_(tenant_id), K_(macro_block_id), K_(micro_info), K_(is_loaded_block),
+  TO_STRING_KV(K_(tenant_id), K_(macro_block_id), K_(nested_offset), K_(micro_info), K_(is_loaded_block),
                K_(block_state), K_(block_index), K_(cache_handle), K_(io_handle), K_(loaded_block_data), KP_(allocator));
   uint64_t tenant_id_;
   blocksstable::MacroBlockId macro_block_id_;
+  // offset of the sstable in a shared macro block, to locate the compress dict
+  int64_t nested_offset_;
   int32_t block_state_;
   int32_t block_index_;
   blocksstable::ObMicroBlockInfo micro_info_;
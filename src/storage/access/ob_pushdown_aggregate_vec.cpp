@@ -45,7 +45,9 @@ ObAggCellVec::ObAggCellVec(const int64_t agg_idx, const ObAggCellVecBasicInfo &b
   : ObAggCellBase(allocator),
     agg_idx_(agg_idx),
     basic_info_(basic_info),
-    aggregate_(nullptr)
+    aggregate_(nullptr),
+    distinct_ref_bitmap_(nullptr),
+    distinct_ref_bitmap_size_(0)
 {
   result_datum_.set_null();
 }
@@ -107,6 +109,11 @@ void ObAggCellVec::reset()
     allocator_.free(aggregate_);
     aggregate_ = nullptr;
   }
+  if (nullptr != distinct_ref_bitmap_) {
+    allocator_.free(distinct_ref_bitmap_);
+    distinct_ref_bitmap_ = nullptr;
+  }
+  distinct_ref_bitmap_size_ = 0;
 }
 
 void ObAggCellVec::reuse()
@@ -242,6 +249,57 @@ int ObAggCellVec::eval_batch_in_group_by(
   return ret;
 }
 
+int ObAggCellVec::eval_distinct_once_in_group_by(
+    common::ObDatum *datums,
+    const int64_t count,
+    const uint32_t *refs,
+    const int64_t distinct_cnt,
+    const bool is_default_datum)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("ObAggCellVec not inited", K(ret));
+  } else if (OB_UNLIKELY(nullptr == datums || nullptr == refs || distinct_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid arguments", K(ret), KP(datums), KP(refs), K(distinct_cnt));
+  } else if (distinct_cnt > distinct_ref_bitmap_size_) {
+    void *buf = nullptr;
+    if (nullptr != distinct_ref_bitmap_) {
+      allocator_.free(distinct_ref_bitmap_);
+      distinct_ref_bitmap_ = nullptr;
+      distinct_ref_bitmap_size_ = 0;
+    }
+    if (OB_ISNULL(buf = allocator_.alloc(sql::ObBitVector::memory_size(distinct_cnt)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("Failed to alloc memory", K(ret), K(distinct_cnt));
+    } else {
+      distinct_ref_bitmap_ = sql::to_bit_vector(buf);
+      distinct_ref_bitmap_size_ = distinct_cnt;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    // the value of one distinct ref is decoded once in the dictionary, so rows sharing the same ref
+    // contribute the same datum to the same group and only the first of them needs to be aggregated
+    distinct_ref_bitmap_->reset(distinct_cnt);
+    for (int64_t i = 0; OB_SUCC(ret) && i < count; ++i) {
+      const uint32_t distinct_ref = refs[i];
+      if (distinct_ref_bitmap_->at(distinct_ref)) {
+      } else {
+        distinct_ref_bitmap_->set(distinct_ref);
+        blocksstable::ObStorageDatum storage_datum;
+        storage_datum.shallow_copy_from_datum(datums[is_default_datum ? 0 : distinct_ref]);
+        if (OB_FAIL(eval(storage_datum, 1, distinct_ref))) {
+          LOG_WARN("Failed to eval one datum", K(ret), K(storage_datum), K(distinct_ref));
+        }
+      }
+    }
+  }
+  LOG_DEBUG("[GROUP BY PUSHDOWN] eval distinct refs in group by pushdown", K(ret), K(count),
+                K(distinct_cnt), K(is_default_datum), KPC(this));
+  return ret;
+}
+
 int ObAggCellVec::collect_result(
     const bool fill_output,
     const sql::ObExpr* group_by_col_expr,
@@ -656,6 +714,26 @@ ObMaxAggCellVec::ObMaxAggCellVec(
   agg_type_ = PD_MAX;
 }
 
+int ObMaxAggCellVec::eval_batch_in_group_by(
+    common::ObDatum *datums,
+    const int64_t count,
+    const uint32_t *refs,
+    const int64_t distinct_cnt,
+    const bool is_group_by_col,
+    const bool is_default_datum)
+{
+  int ret = OB_SUCCESS;
+  if (is_group_by_col || is_default_datum) {
+    if (OB_FAIL(eval_distinct_once_in_group_by(datums, count, refs, distinct_cnt, is_default_datum))) {
+      LOG_WARN("Failed to eval distinct refs in group by", K(ret), K(count), K(distinct_cnt));
+    }
+  } else if (OB_FAIL(ObAggCellVec::eval_batch_in_group_by(datums, count, refs, distinct_cnt,
+                                                          is_group_by_col, is_default_datum))) {
+    LOG_WARN("Failed to eval batch rows in group by", K(ret), K(count), K(distinct_cnt));
+  }
+  return ret;
+}
+
 ObMinAggCellVec::ObMinAggCellVec(
     const int64_t agg_idx,
     const ObAggCellVecBasicInfo &basic_info,
@@ -665,6 +743,26 @@ ObMinAggCellVec::ObMinAggCellVec(
   agg_type_ = PD_MIN;
 }
 
+int ObMinAggCellVec::eval_batch_in_group_by(
+    common::ObDatum *datums,
+    const int64_t count,
+    const uint32_t *refs,
+    const int64_t distinct_cnt,
+    const bool is_group_by_col,
+    const bool is_default_datum)
+{
+  int ret = OB_SUCCESS;
+  if (is_group_by_col || is_default_datum) {
+    if (OB_FAIL(eval_distinct_once_in_group_by(datums, count, refs, distinct_cnt, is_default_datum))) {
+      LOG_WARN("Failed to eval distinct refs in group by", K(ret), K(count), K(distinct_cnt));
+    }
+  } else if (OB_FAIL(ObAggCellVec::eval_batch_in_group_by(datums, count, refs, distinct_cnt,
+                                                          is_group_by_col, is_default_datum))) {
+    LOG_WARN("Failed to eval batch rows in group by", K(ret), K(count), K(distinct_cnt));
+  }
+  return ret;
+}
+
 ObSumAggCellVec::ObSumAggCellVec(
     const int64_t agg_idx,
     const ObAggCellVecBasicInfo &basic_info,
@@ -129,6 +129,16 @@ protected:
                                const sql::ObExpr *group_by_col_expr,
                                sql::ObEvalCtx &eval_ctx,
                                const int32_t batch_size);
+  // aggregate each distinct ref only once, only for aggregates that ignore duplicate values(MIN/MAX).
+  // It only applies when the datum of a row is determined by its distinct ref, i.e. the aggregated
+  // column is the group by column itself or a column read as its default value. Other aggregated
+  // columns are projected row by row and the scanner does not expose their dictionary refs, so
+  // they go through eval_batch_in_group_by of the base class.
+  int eval_distinct_once_in_group_by(common::ObDatum *datums,
+                                     const int64_t count,
+                                     const uint32_t *refs,
+                                     const int64_t distinct_cnt,
+                                     const bool is_default_datum);
   OB_INLINE virtual bool can_use_index_info() const { return true; }
   OB_INLINE bool is_lob_col()
   {
@@ -143,6 +153,8 @@ protected:
   int64_t agg_idx_;
   ObAggCellVecBasicInfo basic_info_;
   share::aggregate::IAggregate* aggregate_;
+  sql::ObBitVector *distinct_ref_bitmap_;
+  int64_t distinct_ref_bitmap_size_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObAggCellVec);
 };
@@ -196,6 +208,12 @@ public:
   ObMaxAggCellVec(const int64_t agg_idx,
                   const ObAggCellVecBasicInfo &basic_info,
                   common::ObIAllocator &allocator);
+  int eval_batch_in_group_by(common::ObDatum *datums,
+                             const int64_t count,
+                             const uint32_t *refs,
+                             const int64_t distinct_cnt,
+                             const bool is_group_by_col = false,
+                             const bool is_default_datum = false) override;
 };
 
 class ObMinAggCellVec : public ObAggCellVec
@@ -204,6 +222,12 @@ public:
   ObMinAggCellVec(const int64_t agg_idx,
                   const ObAggCellVecBasicInfo &basic_info,
                   common::ObIAllocator &allocator);
+  int eval_batch_in_group_by(common::ObDatum *datums,
+                             const int64_t count,
+                             const uint32_t *refs,
+                             const int64_t distinct_cnt,
+                             const bool is_group_by_col = false,
+                             const bool is_default_datum = false) override;
 };
 
 class ObSumAggCellVec : public ObAggCellVec
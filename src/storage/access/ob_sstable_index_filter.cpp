@@ -160,7 +160,10 @@ int ObSSTableIndexFilter::extract_skipping_filter_from_tree(
 {
   int ret = OB_SUCCESS;
   sql::ObPhysicalFilterExecutor &physical_filter = static_cast<sql::ObPhysicalFilterExecutor &>(filter);
-  if (physical_filter.is_filter_white_node() || static_cast<sql::ObBlackFilterExecutor &>(physical_filter).is_monotonic()) {
+  if (physical_filter.is_filter_white_node()
+      || static_cast<sql::ObBlackFilterExecutor &>(physical_filter).is_monotonic()
+      || blocksstable::ObSkipIndexFilterExecutor::is_ngram_skipping_filter(
+          static_cast<sql::ObBlackFilterExecutor &>(physical_filter))) {
     IndexList index_list;
     if (OB_FAIL(find_skipping_index(read_info, physical_filter, index_list))) {
       LOG_WARN("Fail to find useful skipping index", K(ret));
@@ -203,8 +206,26 @@ int ObSSTableIndexFilter::find_skipping_index(
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("Unexpected column meta", K(column_id), K(index), KPC(read_info));
     } else {
-      const bool has_min_max = column_extend->at(index).skip_index_attr_.has_min_max();
-      if (has_min_max && OB_FAIL(index_list.push_back(blocksstable::ObSkipIndexType::MIN_MAX))) {
+      const ObSkipIndexColumnAttr &skip_index_attr = column_extend->at(index).skip_index_attr_;
+      // the bloom filter of column is also probed by the MIN_MAX skipping filter,
+      // and read info of column group only keeps the min_max attr
+      if (skip_index_attr.has_min_max()) {
+        if (OB_FAIL(index_list.push_back(blocksstable::ObSkipIndexType::MIN_MAX))) {
+          LOG_WARN("Fail to push back skip index type", K(ret));
+        }
+      } else if (skip_index_attr.has_bloom_filter()) {
+        if (OB_FAIL(index_list.push_back(blocksstable::ObSkipIndexType::BLOOM_FILTER))) {
+          LOG_WARN("Fail to push back skip index type", K(ret));
+        }
+      }
+      // the ngram bitmap is only aggregated on string columns with byte comparable collation
+      const bool may_have_ngram = is_cg_
+          ? (read_info->get_columns_desc().count() > index
+             && blocksstable::can_agg_ngram_bloom_filter(read_info->get_columns_desc().at(index).col_type_))
+          : skip_index_attr.has_ngram_bloom_filter();
+      if (OB_FAIL(ret)) {
+      } else if (may_have_ngram
+          && OB_FAIL(index_list.push_back(blocksstable::ObSkipIndexType::NGRAM_BLOOM_FILTER))) {
         LOG_WARN("Fail to push back skip index type", K(ret));
       }
     }
@@ -284,7 +305,28 @@ int ObSSTableIndexFilterExtracter::extract_skipping_filter(
   int ret = OB_SUCCESS;
   switch (skip_index_type) {
     case blocksstable::ObSkipIndexType::MIN_MAX:
-      node.skip_index_type_ = blocksstable::ObSkipIndexType::MIN_MAX;
+      if (filter.is_filter_white_node()
+          || static_cast<const sql::ObBlackFilterExecutor &>(filter).is_monotonic()) {
+        node.skip_index_type_ = blocksstable::ObSkipIndexType::MIN_MAX;
+      }
+      break;
+    case blocksstable::ObSkipIndexType::BLOOM_FILTER:
+      if (filter.is_filter_white_node() && !filter.is_filter_dynamic_node()) {
+        const sql::ObWhiteFilterOperatorType op_type =
+            static_cast<const sql::ObWhiteFilterExecutor &>(filter).get_op_type();
+        if (sql::WHITE_OP_EQ == op_type || sql::WHITE_OP_IN == op_type) {
+          node.skip_index_type_ = blocksstable::ObSkipIndexType::BLOOM_FILTER;
+        }
+      }
+      break;
+    case blocksstable::ObSkipIndexType::NGRAM_BLOOM_FILTER:
+      // one filter node owns one bool mask, so only the black filters without min_max pruning
+      if (filter.is_filter_black_node()
+          && !static_cast<const sql::ObBlackFilterExecutor &>(filter).is_monotonic()
+          && blocksstable::ObSkipIndexFilterExecutor::is_ngram_skipping_filter(
+              static_cast<const sql::ObBlackFilterExecutor &>(filter))) {
+        node.skip_index_type_ = blocksstable::ObSkipIndexType::NGRAM_BLOOM_FILTER;
+      }
       break;
     default:
       // There are more skipping index types in the future.
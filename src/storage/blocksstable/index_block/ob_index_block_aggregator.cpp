@@ -477,6 +477,95 @@ int ObColSumAggregator::eval_double(const common::ObDatum &datum)
   return ret;
 }
 
+int ObColBloomFilterAggregator::init(const ObColDesc &col_desc, ObStorageDatum &result)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(ObIColAggregator::init(col_desc, result))) {
+    LOG_WARN("fail to init ObIColAggregator", K(ret));
+  } else if (!can_agg_type()) {
+    set_not_aggregate();
+    LOG_DEBUG("[SKIP INDEX] init bloom filter agg on unsupported type", K(col_desc), K_(is_ngram));
+  } else {
+    sql::ObExprBasicFuncs *basic_funcs = ObDatumFuncs::get_basic_func(
+        col_desc.col_type_.get_type(), col_desc.col_type_.get_collation_type());
+    hash_func_ = basic_funcs->murmur_hash_v2_;
+    LOG_DEBUG("[SKIP INDEX] init bloom filter aggregator", K(col_desc_), K_(is_ngram));
+  }
+  return ret;
+}
+
+bool ObColBloomFilterAggregator::can_agg_type() const
+{
+  return is_ngram_
+      ? can_agg_ngram_bloom_filter(col_desc_.col_type_)
+      : can_agg_bloom_filter(col_desc_.col_type_.get_type());
+}
+
+void ObColBloomFilterAggregator::reuse()
+{
+  ObIColAggregator::reuse();
+  if (!can_agg_type()) {
+    set_not_aggregate();
+  }
+  MEMSET(bitmap_, 0, sizeof(bitmap_));
+  has_value_ = false;
+}
+
+int ObColBloomFilterAggregator::eval(const ObStorageDatum &datum, const bool is_data)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(result_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not init", K(ret));
+  } else if (!can_aggregate_ || datum.is_nop() || datum.is_null()) {
+    // Skip
+  } else if (OB_UNLIKELY(datum.is_outrow())) {
+    set_not_aggregate();
+  } else if (!is_data) {
+    // union of bitmaps of the lower level
+    if (OB_UNLIKELY(datum.len_ != ObSkipIndexBloomFilter::BLOOM_FILTER_SIZE)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("Unexpected bloom filter datum", K(ret), K(datum), K(col_desc_));
+    } else {
+      for (int64_t i = 0; i < ObSkipIndexBloomFilter::BLOOM_FILTER_SIZE; ++i) {
+        bitmap_[i] |= datum.ptr_[i];
+      }
+      has_value_ = true;
+    }
+  } else if (is_ngram_) {
+    ObSkipIndexBloomFilter::add_ngrams(bitmap_, datum.ptr_, datum.len_);
+    has_value_ = true;
+  } else {
+    uint64_t hash = 0;
+    if (OB_FAIL(hash_func_(datum, 0, hash))) {
+      LOG_WARN("Failed to calc hash", K(ret), K(datum), K(col_desc_));
+    } else {
+      ObSkipIndexBloomFilter::add(bitmap_, hash, ObSkipIndexBloomFilter::VALUE_HASH_CNT);
+      has_value_ = true;
+    }
+  }
+  return ret;
+}
+
+int ObColBloomFilterAggregator::get_result(const ObStorageDatum *&result)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(result_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not init", K(ret));
+  } else {
+    if (!can_aggregate_ || (has_value_ && ObSkipIndexBloomFilter::is_saturated(bitmap_))) {
+      result_->set_nop();
+    } else if (!has_value_) {
+      result_->set_null();
+    } else {
+      result_->set_string(bitmap_, ObSkipIndexBloomFilter::BLOOM_FILTER_SIZE);
+    }
+    result = result_;
+  }
+  return ret;
+}
+
 ObSkipIndexAggregator::ObSkipIndexAggregator()
   : allocator_(nullptr),
     col_aggs_(),
@@ -660,7 +749,7 @@ int ObSkipIndexAggregator::get_aggregated_row(const ObDatumRow *&aggregated_row)
       } else if (OB_ISNULL(result)) {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("Fail to get aggregated column result", K(ret), K(i));
-      } else if (OB_UNLIKELY(result->len_ > ObSkipIndexColMeta::MAX_SKIP_INDEX_COL_LENGTH
+      } else if (OB_UNLIKELY(result->len_ > full_agg_metas_->at(i).get_max_store_length()
           || result->is_outrow())) {
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("Unexpected aggregated result datum", K(ret), K(result), K(i), K_(full_agg_metas));
@@ -726,6 +815,11 @@ int ObSkipIndexAggregator::calc_max_agg_size(
             cur_max_cell_size += sum_store_size;
             break;
           }
+          case ObSkipIndexColType::SK_IDX_BLOOM_FILTER:
+          case ObSkipIndexColType::SK_IDX_NGRAM_BLOOM_FILTER: {
+            cur_max_cell_size += ObSkipIndexBloomFilter::BLOOM_FILTER_SIZE;
+            break;
+          }
           default: {
             ret = OB_NOT_SUPPORTED;
             LOG_WARN("Not support skip index aggregate type", K(ret), K(idx_type));
@@ -792,6 +886,20 @@ int ObSkipIndexAggregator::init_col_aggregators(
         }
         break;
       }
+      case ObSkipIndexColType::SK_IDX_BLOOM_FILTER: {
+        if (OB_FAIL(init_col_aggregator<ObColBloomFilterAggregator>(
+            full_col_descs.at(col_idx), agg_result_->storage_datums_[i], allocator))) {
+          LOG_WARN("Fail to allocate column aggregator", K(ret));
+        }
+        break;
+      }
+      case ObSkipIndexColType::SK_IDX_NGRAM_BLOOM_FILTER: {
+        if (OB_FAIL(init_col_aggregator<ObColNgramBloomFilterAggregator>(
+            full_col_descs.at(col_idx), agg_result_->storage_datums_[i], allocator))) {
+          LOG_WARN("Fail to allocate column aggregator", K(ret));
+        }
+        break;
+      }
       default: {
         ret = OB_NOT_SUPPORTED;
         LOG_WARN("Not supported skip index aggregate type", K(ret), K(idx_type));
@@ -128,6 +128,44 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObColSumAggregator);
 };
 
+// Bitmap of values of a block for SK_IDX_BLOOM_FILTER, the ngram subclass adds every n-gram
+// of the string values instead for SK_IDX_NGRAM_BLOOM_FILTER.
+class ObColBloomFilterAggregator : public ObIColAggregator
+{
+public:
+  ObColBloomFilterAggregator() : ObColBloomFilterAggregator(false) {}
+  virtual ~ObColBloomFilterAggregator() {}
+  int init(const ObColDesc &col_desc, ObStorageDatum &result) override;
+  void reset() override { new (this) ObColBloomFilterAggregator(); }
+  void reuse() override;
+  int eval(const ObStorageDatum &datum, const bool is_data) override;
+  int get_result(const ObStorageDatum *&result) override;
+  INHERIT_TO_STRING_KV("ObIColAggregator", ObIColAggregator, K_(has_value), K_(is_ngram));
+protected:
+  explicit ObColBloomFilterAggregator(const bool is_ngram)
+    : hash_func_(nullptr), has_value_(false), is_ngram_(is_ngram)
+  {
+    MEMSET(bitmap_, 0, sizeof(bitmap_));
+  }
+  bool can_agg_type() const;
+private:
+  sql::ObExprHashFuncType hash_func_;
+  char bitmap_[ObSkipIndexBloomFilter::BLOOM_FILTER_SIZE];
+  bool has_value_;
+  bool is_ngram_;
+  DISALLOW_COPY_AND_ASSIGN(ObColBloomFilterAggregator);
+};
+
+class ObColNgramBloomFilterAggregator final : public ObColBloomFilterAggregator
+{
+public:
+  ObColNgramBloomFilterAggregator() : ObColBloomFilterAggregator(true) {}
+  virtual ~ObColNgramBloomFilterAggregator() {}
+  void reset() override { new (this) ObColNgramBloomFilterAggregator(); }
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObColNgramBloomFilterAggregator);
+};
+
 class ObSkipIndexAggregator final
 {
 public:
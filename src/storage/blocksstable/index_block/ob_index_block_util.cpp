@@ -12,6 +12,7 @@
 
 #define USING_LOG_PREFIX STORAGE
 
+#include "lib/hash_func/murmur_hash.h"
 #include "share/schema/ob_schema_struct.h"
 #include "storage/blocksstable/index_block/ob_index_block_util.h"
 
@@ -48,6 +49,22 @@ int ObSkipIndexColMeta::append_skip_index_meta(
       STORAGE_LOG(WARN, "failed to push null count skip index meta", K(ret));
     } else if (OB_FAIL(skip_idx_metas.push_back(ObSkipIndexColMeta(col_idx, ObSkipIndexColType::SK_IDX_SUM)))) {
       STORAGE_LOG(WARN, "failed to push sum skip index meta", K(ret));
+    } else {
+      has_null_count_column = true;
+    }
+  }
+
+  if (OB_SUCC(ret) && (skip_idx_attr.has_bloom_filter() || skip_idx_attr.has_ngram_bloom_filter())) {
+    // null count tells an absent bitmap of an all null block from an unaggregated one
+    if (!has_null_count_column
+        && OB_FAIL(skip_idx_metas.push_back(ObSkipIndexColMeta(col_idx, ObSkipIndexColType::SK_IDX_NULL_COUNT)))) {
+      STORAGE_LOG(WARN, "failed to push null count skip index meta", K(ret));
+    } else if (skip_idx_attr.has_bloom_filter()
+        && OB_FAIL(skip_idx_metas.push_back(ObSkipIndexColMeta(col_idx, ObSkipIndexColType::SK_IDX_BLOOM_FILTER)))) {
+      STORAGE_LOG(WARN, "failed to push bloom filter skip index meta", K(ret));
+    } else if (skip_idx_attr.has_ngram_bloom_filter()
+        && OB_FAIL(skip_idx_metas.push_back(ObSkipIndexColMeta(col_idx, ObSkipIndexColType::SK_IDX_NGRAM_BLOOM_FILTER)))) {
+      STORAGE_LOG(WARN, "failed to push ngram bloom filter skip index meta", K(ret));
     }
   }
   return ret;
@@ -77,6 +94,15 @@ int ObSkipIndexColMeta::calc_skip_index_maximum_size(
       sum_column_cnt += 1;
       has_null_count_column = true;
     }
+    int64_t bloom_filter_column_cnt = 0;
+    if (skip_idx_attr.has_bloom_filter()) {
+      bloom_filter_column_cnt += 1;
+      has_null_count_column = true;
+    }
+    if (skip_idx_attr.has_ngram_bloom_filter()) {
+      bloom_filter_column_cnt += 1;
+      has_null_count_column = true;
+    }
     const int64_t null_count_column_cnt = has_null_count_column ? 1 : 0;
     uint32_t data_type_upper_size = 0;
     uint32_t null_count_upper_size = 0;
@@ -89,11 +115,44 @@ int ObSkipIndexColMeta::calc_skip_index_maximum_size(
       LOG_WARN("failed to get sum store size", K(ret), K(obj_type));
     } else {
       max_size = normal_agg_column_cnt * data_type_upper_size + sum_column_cnt * sum_store_size
-          + null_count_column_cnt * null_count_upper_size;
+          + null_count_column_cnt * null_count_upper_size
+          + bloom_filter_column_cnt * ObSkipIndexBloomFilter::BLOOM_FILTER_SIZE;
     }
   }
   return ret;
 }
 
+static OB_INLINE uint64_t ngram_hash(const char *gram)
+{
+  return common::murmurhash(gram, ObSkipIndexBloomFilter::NGRAM_LENGTH, 0);
+}
+
+void ObSkipIndexBloomFilter::add_ngrams(char *bitmap, const char *str, const int64_t len)
+{
+  for (int64_t i = 0; i + NGRAM_LENGTH <= len; ++i) {
+    add(bitmap, ngram_hash(str + i), NGRAM_HASH_CNT);
+  }
+}
+
+bool ObSkipIndexBloomFilter::may_contain_ngrams(const char *bitmap, const char *str, const int64_t len)
+{
+  bool contain = true;
+  for (int64_t i = 0; contain && i + NGRAM_LENGTH <= len; ++i) {
+    contain = may_contain(bitmap, ngram_hash(str + i), NGRAM_HASH_CNT);
+  }
+  return contain;
+}
+
+bool ObSkipIndexBloomFilter::is_saturated(const char *bitmap)
+{
+  int64_t set_bits = 0;
+  for (int64_t i = 0; i < BLOOM_FILTER_SIZE; i += sizeof(uint64_t)) {
+    uint64_t word = 0;
+    MEMCPY(&word, bitmap + i, sizeof(word));
+    set_bits += __builtin_popcountll(word);
+  }
+  return set_bits * 100 > BLOOM_FILTER_BITS * MAX_FILL_PERCENT;
+}
+
 } // namespace blocksstable
 } // namespace oceanbase
\ No newline at end of file
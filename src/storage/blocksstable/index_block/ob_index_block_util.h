@@ -27,7 +27,6 @@ struct ObSkipIndexColumnAttr;
 namespace blocksstable
 {
 
-// Only MIN_MAX skipping index is supported now.
 enum ObSkipIndexType : uint8_t
 {
   MIN_MAX,
@@ -43,6 +42,8 @@ enum ObSkipIndexColType : uint8_t
   SK_IDX_MAX,
   SK_IDX_NULL_COUNT,
   SK_IDX_SUM,
+  SK_IDX_BLOOM_FILTER,
+  SK_IDX_NGRAM_BLOOM_FILTER,
   SK_IDX_MAX_COL_TYPE
 };
 
@@ -51,7 +52,7 @@ struct ObSkipIndexColMeta
   // For data with length larger than 40 bytes(normally string), we will store the prefix as min/max
   static constexpr int64_t MAX_SKIP_INDEX_COL_LENGTH = 40;
   static constexpr int64_t SKIP_INDEX_ROW_SIZE_LIMIT = 1 << 10; // 1kb
-  static constexpr int64_t MAX_AGG_COLUMN_PER_ROW = 4; // min / max / null count / sum
+  static constexpr int64_t MAX_AGG_COLUMN_PER_ROW = 6; // min / max / null count / sum / bloom filter / ngram bloom filter
   static constexpr ObObjDatumMapType NULL_CNT_COL_TYPE = OBJ_DATUM_8BYTE_DATA;
   static_assert(common::OBJ_DATUM_NUMBER_RES_SIZE == MAX_SKIP_INDEX_COL_LENGTH,
       "Buffer size of ObStorageDatum and maximum size of skip index data is equal to maximum size of ObNumber");
@@ -59,6 +60,11 @@ struct ObSkipIndexColMeta
   ObSkipIndexColMeta(const uint32_t col_idx, const ObSkipIndexColType col_type)
       : col_idx_(col_idx), col_type_(col_type) {}
   bool is_valid() const { return col_type_ < SK_IDX_MAX_COL_TYPE; }
+  bool is_bloom_filter() const
+  {
+    return SK_IDX_BLOOM_FILTER == col_type_ || SK_IDX_NGRAM_BLOOM_FILTER == col_type_;
+  }
+  int64_t get_max_store_length() const;
   bool operator <(const ObSkipIndexColMeta &rhs) const
   {
     bool ret = false;
@@ -203,6 +209,72 @@ OB_INLINE static int get_sum_store_size(const ObObjType &obj_type, uint32_t &sum
   return ret;
 }
 
+OB_INLINE static bool can_agg_bloom_filter(const ObObjType &obj_type)
+{
+  // equal values must be hashed to the same value under the collation of column
+  const ObObjTypeClass tc = ob_obj_type_class(obj_type);
+  return (ObIntTC == tc || ObUIntTC == tc || ObNumberTC == tc || ObDateTimeTC == tc || ObDateTC == tc
+      || ObTimeTC == tc || ObYearTC == tc || ObBitTC == tc || ObStringTC == tc)
+      && ObCharType != obj_type && ObNCharType != obj_type;
+}
+
+OB_INLINE static bool can_agg_ngram_bloom_filter(const ObObjMeta &obj_meta)
+{
+  // byte n-grams of the stored value only decide LIKE under binary comparison,
+  // and ascii wildcards never appear inside a multi-byte utf8 character
+  const ObObjType obj_type = obj_meta.get_type();
+  const ObCollationType cs_type = obj_meta.get_collation_type();
+  return ob_is_string_tc(obj_type) && ObCharType != obj_type && ObNCharType != obj_type
+      && ObCharset::is_bin_sort(cs_type)
+      && (CS_TYPE_BINARY == cs_type || CHARSET_UTF8MB4 == ObCharset::charset_type_by_coll(cs_type));
+}
+
+// Fixed size bloom filter stored as a skip index column. Bitmap of an index row is the
+// union of bitmaps of its children, so a value absent from it is absent from the whole subtree.
+struct ObSkipIndexBloomFilter final
+{
+public:
+  static constexpr int64_t BLOOM_FILTER_SIZE = 256;
+  static constexpr int64_t BLOOM_FILTER_BITS = BLOOM_FILTER_SIZE * 8;
+  static constexpr int64_t VALUE_HASH_CNT = 3;
+  // every n-gram sets a single bit, which makes the ngram bloom filter a token bitmap
+  static constexpr int64_t NGRAM_HASH_CNT = 1;
+  static constexpr int64_t NGRAM_LENGTH = 3;
+  // bitmap with more bits set can hardly skip anything, it is not stored
+  static constexpr int64_t MAX_FILL_PERCENT = 75;
+
+  OB_INLINE static void add(char *bitmap, const uint64_t hash, const int64_t hash_cnt)
+  {
+    const uint64_t delta = (hash >> 32) | 1;
+    uint64_t h = hash;
+    for (int64_t i = 0; i < hash_cnt; ++i, h += delta) {
+      const uint64_t pos = h & (BLOOM_FILTER_BITS - 1);
+      bitmap[pos >> 3] |= static_cast<char>(1 << (pos & 7));
+    }
+  }
+  OB_INLINE static bool may_contain(const char *bitmap, const uint64_t hash, const int64_t hash_cnt)
+  {
+    bool contain = true;
+    const uint64_t delta = (hash >> 32) | 1;
+    uint64_t h = hash;
+    for (int64_t i = 0; contain && i < hash_cnt; ++i, h += delta) {
+      const uint64_t pos = h & (BLOOM_FILTER_BITS - 1);
+      contain = 0 != (bitmap[pos >> 3] & (1 << (pos & 7)));
+    }
+    return contain;
+  }
+  static void add_ngrams(char *bitmap, const char *str, const int64_t len);
+  // whether every n-gram of the literal @str may be contained, literal shorter than
+  // NGRAM_LENGTH can not be decided
+  static bool may_contain_ngrams(const char *bitmap, const char *str, const int64_t len);
+  static bool is_saturated(const char *bitmap);
+};
+
+OB_INLINE int64_t ObSkipIndexColMeta::get_max_store_length() const
+{
+  return is_bloom_filter() ? ObSkipIndexBloomFilter::BLOOM_FILTER_SIZE : MAX_SKIP_INDEX_COL_LENGTH;
+}
+
 } // blocksstable
 } // oceanbase
 
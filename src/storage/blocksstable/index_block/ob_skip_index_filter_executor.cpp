@@ -12,6 +12,7 @@
 
 #define USING_LOG_PREFIX STORAGE
 #include "storage/blocksstable/index_block/ob_skip_index_filter_executor.h"
+#include "share/datum/ob_datum_funcs.h"
 namespace oceanbase
 {
 namespace blocksstable
@@ -119,6 +120,28 @@ int ObSkipIndexFilterExecutor::falsifiable_pushdown_filter(
         }
         break;
       }
+      case ObSkipIndexType::BLOOM_FILTER: {
+        if (filter.is_filter_white_node() && !filter.is_filter_dynamic_node()) {
+          if (OB_FAIL(filter_on_bloom_filter(col_idx, index_info.get_row_count(), obj_meta,
+              static_cast<sql::ObWhiteFilterExecutor &>(filter)))) {
+            LOG_WARN("Failed to filter on bloom filter", K(ret), K(col_idx));
+          }
+        } else {
+          filter.get_filter_bool_mask().set_uncertain();
+        }
+        break;
+      }
+      case ObSkipIndexType::NGRAM_BLOOM_FILTER: {
+        if (filter.is_filter_black_node()) {
+          if (OB_FAIL(filter_on_ngram_bloom_filter(col_idx, index_info.get_row_count(), obj_meta,
+              static_cast<sql::ObBlackFilterExecutor &>(filter), allocator))) {
+            LOG_WARN("Failed to filter on ngram bloom filter", K(ret), K(col_idx));
+          }
+        } else {
+          filter.get_filter_bool_mask().set_uncertain();
+        }
+        break;
+      }
       default :
         ret = OB_NOT_SUPPORTED;
         LOG_WARN("unsupported skip index type", K(ret), K(index_type));
@@ -272,7 +295,182 @@ int ObSkipIndexFilterExecutor::filter_on_min_max(
         fal_desc.set_uncertain();
       }
     }
+    // min/max can not prune equality on unsorted values, try the bloom filter of the column
+    if (OB_SUCC(ret) && fal_desc.is_uncertain() && !filter.is_filter_dynamic_node()
+        && (sql::WHITE_OP_EQ == op_type || sql::WHITE_OP_IN == op_type)
+        && OB_FAIL(filter_on_bloom_filter(col_idx, row_count, obj_meta, filter))) {
+      LOG_WARN("Failed to filter on bloom filter", K(ret), K(col_idx));
+    }
+  }
+  return ret;
+}
+
+bool ObSkipIndexFilterExecutor::can_probe_bloom_filter(
+    const ObObjMeta &obj_meta,
+    const sql::ObWhiteFilterExecutor &filter)
+{
+  // filter params are hashed by the hash function of column, they must be of the column type
+  bool can_probe = can_agg_bloom_filter(obj_meta.get_type())
+      && filter.get_datums().count() <= MAX_BLOOM_FILTER_PROBE_CNT;
+  const sql::ObExpr *expr = filter.get_filter_node().expr_;
+  if (!can_probe || nullptr == expr) {
+    can_probe = false;
+  } else if (sql::WHITE_OP_IN == filter.get_op_type()) {
+    expr = expr->arg_cnt_ > 1 ? expr->args_[1] : nullptr;
+    can_probe = nullptr != expr;
+  }
+  for (int64_t i = 0; can_probe && i < expr->arg_cnt_; ++i) {
+    const sql::ObExpr *arg = expr->args_[i];
+    if (OB_ISNULL(arg)) {
+      can_probe = false;
+    } else if (T_REF_COLUMN != arg->type_) {
+      can_probe = arg->obj_meta_.get_type() == obj_meta.get_type()
+          && arg->obj_meta_.get_collation_type() == obj_meta.get_collation_type();
+    }
+  }
+  return can_probe;
+}
+
+int ObSkipIndexFilterExecutor::filter_on_bloom_filter(
+    const uint32_t col_idx,
+    const uint64_t row_count,
+    const ObObjMeta &obj_meta,
+    sql::ObWhiteFilterExecutor &filter)
+{
+  int ret = OB_SUCCESS;
+  sql::ObBoolMask &fal_desc = filter.get_filter_bool_mask();
+  ObStorageDatum bloom_datum;
+  ObStorageDatum null_count;
+  sql::ObExprBasicFuncs *basic_funcs = nullptr;
+  fal_desc.set_uncertain();
+  if ((sql::WHITE_OP_EQ != filter.get_op_type() && sql::WHITE_OP_IN != filter.get_op_type())
+      || !can_probe_bloom_filter(obj_meta, filter)) {
+  } else if (FALSE_IT(meta_.col_idx_ = col_idx)) {
+  } else if (FALSE_IT(meta_.col_type_ = SK_IDX_BLOOM_FILTER)) {
+  } else if (OB_FAIL(agg_row_reader_.read(meta_, bloom_datum))) {
+    LOG_WARN("Failed read agg bloom filter", K(ret), K(meta_));
+  } else if (bloom_datum.is_null()) {
+    // no bitmap for all null block, saturated bitmap or column without bloom filter
+    meta_.col_type_ = SK_IDX_NULL_COUNT;
+    if (OB_FAIL(agg_row_reader_.read(meta_, null_count))) {
+      LOG_WARN("Failed read agg null count", K(ret), K(meta_));
+    } else if (!null_count.is_null() && null_count.get_int() == row_count) {
+      fal_desc.set_always_false();
+    }
+  } else if (OB_UNLIKELY(ObSkipIndexBloomFilter::BLOOM_FILTER_SIZE != bloom_datum.len_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected bloom filter datum", K(ret), K(col_idx), K(bloom_datum));
+  } else if (OB_ISNULL(basic_funcs = ObDatumFuncs::get_basic_func(
+      obj_meta.get_type(), obj_meta.get_collation_type()))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected null basic funcs", K(ret), K(obj_meta));
+  } else {
+    const common::ObIArray<common::ObDatum> &datums = filter.get_datums();
+    const sql::ObExprHashFuncType hash_func = basic_funcs->murmur_hash_v2_;
+    bool may_contain = false;
+    for (int64_t i = 0; OB_SUCC(ret) && !may_contain && i < datums.count(); ++i) {
+      uint64_t hash = 0;
+      if (datums.at(i).is_null()) {
+      } else if (OB_FAIL(hash_func(datums.at(i), 0, hash))) {
+        LOG_WARN("Failed to calc hash", K(ret), K(datums.at(i)));
+      } else {
+        may_contain = ObSkipIndexBloomFilter::may_contain(
+            bloom_datum.ptr_, hash, ObSkipIndexBloomFilter::VALUE_HASH_CNT);
+      }
+    }
+    if (OB_SUCC(ret) && !may_contain) {
+      fal_desc.set_always_false();
+    }
+  }
+  LOG_DEBUG("[SKIP INDEX] filter on bloom filter", K(ret), K(col_idx), K(fal_desc), K(null_count), K(row_count));
+  return ret;
+}
+
+bool ObSkipIndexFilterExecutor::is_ngram_skipping_filter(const sql::ObBlackFilterExecutor &filter)
+{
+  // column LIKE const [ESCAPE const]
+  bool is_ngram_filter = false;
+  const sql::ObPushdownBlackFilterNode &filter_node = filter.get_filter_node();
+  if (1 == filter_node.filter_exprs_.count() && nullptr != filter_node.filter_exprs_.at(0)) {
+    const sql::ObExpr *expr = filter_node.filter_exprs_.at(0);
+    is_ngram_filter = T_OP_LIKE == expr->type_ && expr->arg_cnt_ >= 2
+        && nullptr != expr->args_[0] && T_REF_COLUMN == expr->args_[0]->type_
+        && nullptr != expr->args_[1] && expr->args_[1]->is_const_expr()
+        && (expr->arg_cnt_ < 3 || (nullptr != expr->args_[2] && expr->args_[2]->is_const_expr()));
+  }
+  return is_ngram_filter;
+}
+
+int ObSkipIndexFilterExecutor::filter_on_ngram_bloom_filter(
+    const uint32_t col_idx,
+    const uint64_t row_count,
+    const ObObjMeta &obj_meta,
+    sql::ObBlackFilterExecutor &filter,
+    common::ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  sql::ObBoolMask &fal_desc = filter.get_filter_bool_mask();
+  sql::ObEvalCtx &eval_ctx = filter.get_op().get_eval_ctx();
+  const sql::ObExpr *like_expr = nullptr;
+  ObDatum *pattern = nullptr;
+  ObDatum *escape = nullptr;
+  ObStorageDatum bloom_datum;
+  ObStorageDatum null_count;
+  fal_desc.set_uncertain();
+  if (!can_agg_ngram_bloom_filter(obj_meta) || !is_ngram_skipping_filter(filter)) {
+  } else if (FALSE_IT(like_expr = filter.get_filter_node().filter_exprs_.at(0))) {
+  } else if (like_expr->args_[1]->obj_meta_.get_collation_type() != obj_meta.get_collation_type()
+      || !ob_is_string_tc(like_expr->args_[1]->obj_meta_.get_type())) {
+  } else if (OB_FAIL(like_expr->args_[1]->eval(eval_ctx, pattern))) {
+    LOG_WARN("Failed to eval like pattern", K(ret));
+  } else if (like_expr->arg_cnt_ > 2 && OB_FAIL(like_expr->args_[2]->eval(eval_ctx, escape))) {
+    LOG_WARN("Failed to eval like escape", K(ret));
+  } else if (pattern->is_null() || (nullptr != escape && (escape->is_null() || escape->len_ > 1))) {
+  } else if (FALSE_IT(meta_.col_idx_ = col_idx)) {
+  } else if (FALSE_IT(meta_.col_type_ = SK_IDX_NGRAM_BLOOM_FILTER)) {
+  } else if (OB_FAIL(agg_row_reader_.read(meta_, bloom_datum))) {
+    LOG_WARN("Failed read agg ngram bloom filter", K(ret), K(meta_));
+  } else if (bloom_datum.is_null()) {
+    meta_.col_type_ = SK_IDX_NULL_COUNT;
+    if (OB_FAIL(agg_row_reader_.read(meta_, null_count))) {
+      LOG_WARN("Failed read agg null count", K(ret), K(meta_));
+    } else if (!null_count.is_null() && null_count.get_int() == row_count) {
+      fal_desc.set_always_false();
+    }
+  } else if (OB_UNLIKELY(ObSkipIndexBloomFilter::BLOOM_FILTER_SIZE != bloom_datum.len_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected ngram bloom filter datum", K(ret), K(col_idx), K(bloom_datum));
+  } else {
+    // every literal between wildcards must be a substring of some value of the block
+    const char *ptr = pattern->ptr_;
+    const int64_t len = pattern->len_;
+    const bool has_escape = nullptr != escape && 1 == escape->len_;
+    const char escape_char = has_escape ? escape->ptr_[0] : '\\';
+    char *literal = nullptr;
+    int64_t literal_len = 0;
+    bool may_contain = true;
+    if (len < ObSkipIndexBloomFilter::NGRAM_LENGTH) {
+    } else if (OB_ISNULL(literal = static_cast<char *>(allocator.alloc(len)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("Failed to alloc literal buf", K(ret), K(len));
+    } else {
+      for (int64_t i = 0; may_contain && i <= len; ++i) {
+        if (i < len && has_escape && escape_char == ptr[i] && i + 1 < len) {
+          literal[literal_len++] = ptr[++i];
+        } else if (i == len || '%' == ptr[i] || '_' == ptr[i]) {
+          may_contain = ObSkipIndexBloomFilter::may_contain_ngrams(bloom_datum.ptr_, literal, literal_len);
+          literal_len = 0;
+        } else {
+          literal[literal_len++] = ptr[i];
+        }
+      }
+      allocator.free(literal);
+      if (!may_contain) {
+        fal_desc.set_always_false();
+      }
+    }
   }
+  LOG_DEBUG("[SKIP INDEX] filter on ngram bloom filter", K(ret), K(col_idx), K(fal_desc), K(null_count), K(row_count));
   return ret;
 }
 
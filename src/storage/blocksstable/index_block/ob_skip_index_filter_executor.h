@@ -50,8 +50,11 @@ public:
                                   sql::ObPhysicalFilterExecutor &filter,
                                   common::ObIAllocator &allocator,
                                   const bool use_vectorize);
+  // black filter which could be judged by the ngram bloom filter: column LIKE const [ESCAPE const]
+  static bool is_ngram_skipping_filter(const sql::ObBlackFilterExecutor &filter);
 
 private:
+  static const int64_t MAX_BLOOM_FILTER_PROBE_CNT = 64;
   int filter_on_min_max(const uint32_t col_idx,
                         const uint64_t row_count,
                         const ObObjMeta &obj_meta,
@@ -116,6 +119,18 @@ private:
                               sql::ObBlackFilterExecutor &filter,
                               common::ObIAllocator &allocator,
                               const bool use_vectorize);
+
+  static bool can_probe_bloom_filter(const ObObjMeta &obj_meta,
+                                     const sql::ObWhiteFilterExecutor &filter);
+  int filter_on_bloom_filter(const uint32_t col_idx,
+                             const uint64_t row_count,
+                             const ObObjMeta &obj_meta,
+                             sql::ObWhiteFilterExecutor &filter);
+  int filter_on_ngram_bloom_filter(const uint32_t col_idx,
+                                   const uint64_t row_count,
+                                   const ObObjMeta &obj_meta,
+                                   sql::ObBlackFilterExecutor &filter,
+                                   common::ObIAllocator &allocator);
 private:
   ObAggRowReader agg_row_reader_;
   ObSkipIndexColMeta meta_;
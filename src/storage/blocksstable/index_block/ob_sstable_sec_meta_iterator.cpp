@@ -553,6 +553,7 @@ int ObSSTableSecMetaIterator::get_micro_block(
 
   if (OB_SUCC(ret)) {
     data_handle.macro_block_id_ = macro_id;
+    data_handle.nested_offset_ = nested_offset;
     data_handle.micro_info_.set(idx_row_header.get_block_offset() + nested_offset,
                                 idx_row_header.get_block_size(),
                                 idx_row_header.get_logic_micro_id(),
@@ -0,0 +1,188 @@
+//Copyright (c) 2024 OceanBase
+// OceanBase is licensed under Mulan PubL v2.
+// You can use this software according to the terms and conditions of the Mulan PubL v2.
+// You may obtain a copy of Mulan PubL v2 at:
+//          http://license.coscl.org.cn/MulanPubL-2.0
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+// See the Mulan PubL v2 for more details.
+#define USING_LOG_PREFIX STORAGE
+#include "storage/blocksstable/ob_column_ndv_sketch.h"
+#include "lib/allocator/page_arena.h"
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+int ObColumnNdvSketch::reserve(
+  ObArenaAllocator &allocator,
+  const int64_t column_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_empty())) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("have alloc before, can't reserve twice", K(ret), KPC(this));
+  } else if (OB_UNLIKELY(column_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(column_cnt));
+  } else if (OB_ISNULL(column_ids_ = static_cast<uint64_t *>(allocator.alloc(sizeof(uint64_t) * column_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate column id memory", K(ret), K(column_cnt));
+  } else if (OB_ISNULL(registers_ = static_cast<uint8_t *>(allocator.alloc(NUM_REGISTERS * column_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate ndv sketch memory", K(ret), K(column_cnt));
+  } else {
+    MEMSET(column_ids_, 0, sizeof(uint64_t) * column_cnt);
+    MEMSET(registers_, 0, NUM_REGISTERS * column_cnt);
+    count_ = column_cnt;
+  }
+  if (OB_FAIL(ret)) {
+    reset();
+  }
+  return ret;
+}
+
+int64_t ObColumnNdvSketch::find_column(const uint64_t column_id) const
+{
+  int64_t idx = -1;
+  for (int64_t i = 0; -1 == idx && i < count_; ++i) {
+    if (column_ids_[i] == column_id) {
+      idx = i;
+    }
+  }
+  return idx;
+}
+
+int ObColumnNdvSketch::serialize(char *buf, const int64_t buf_len, int64_t &pos) const
+{
+  int ret = OB_SUCCESS;
+  OB_UNIS_ENCODE_ARRAY(column_ids_, count_);
+  if (OB_FAIL(ret) || 0 == count_) {
+  } else if (OB_UNLIKELY(pos + NUM_REGISTERS * count_ > buf_len)) {
+    ret = OB_BUF_NOT_ENOUGH;
+    LOG_WARN("buffer not enough for ndv sketch", K(ret), K(buf_len), K(pos), K_(count));
+  } else {
+    MEMCPY(buf + pos, registers_, NUM_REGISTERS * count_);
+    pos += NUM_REGISTERS * count_;
+  }
+  return ret;
+}
+
+int ObColumnNdvSketch::deserialize(ObArenaAllocator &allocator, const char *buf,
+                const int64_t data_len, int64_t &pos)
+{
+  int ret = OB_SUCCESS;
+  int64_t column_cnt = 0;
+  OB_UNIS_DECODE(column_cnt);
+  if (OB_FAIL(ret) || 0 == column_cnt) {
+  } else if (OB_FAIL(reserve(allocator, column_cnt))) {
+    LOG_WARN("fail to reserve ndv sketch", K(ret), K(column_cnt));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < count_; ++i) {
+      OB_UNIS_DECODE(column_ids_[i]);
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_UNLIKELY(pos + NUM_REGISTERS * count_ > data_len)) {
+      ret = OB_DESERIALIZE_ERROR;
+      LOG_WARN("data not enough for ndv sketch", K(ret), K(data_len), K(pos), K_(count));
+    } else {
+      MEMCPY(registers_, buf + pos, NUM_REGISTERS * count_);
+      pos += NUM_REGISTERS * count_;
+    }
+  }
+  return ret;
+}
+
+int64_t ObColumnNdvSketch::get_serialize_size() const
+{
+  int64_t len = 0;
+  OB_UNIS_ADD_LEN_ARRAY(column_ids_, count_);
+  len += NUM_REGISTERS * count_;
+  return len;
+}
+
+int64_t ObColumnNdvSketch::get_deep_copy_size() const
+{
+  return (sizeof(uint64_t) + NUM_REGISTERS) * count_;
+}
+
+int ObColumnNdvSketch::deep_copy(
+      char *buf,
+      const int64_t buf_len,
+      int64_t &pos,
+      ObColumnNdvSketch &dest) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t deep_copy_size = get_deep_copy_size();
+  if (OB_ISNULL(buf) || OB_UNLIKELY(buf_len < deep_copy_size + pos)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(buf_len), K(deep_copy_size), K(pos));
+  } else {
+    dest.count_ = count_;
+    if (count_ > 0) {
+      dest.column_ids_ = reinterpret_cast<uint64_t *>(buf + pos);
+      MEMCPY(dest.column_ids_, column_ids_, sizeof(uint64_t) * count_);
+      pos += sizeof(uint64_t) * count_;
+      dest.registers_ = reinterpret_cast<uint8_t *>(buf + pos);
+      MEMCPY(dest.registers_, registers_, NUM_REGISTERS * count_);
+      pos += NUM_REGISTERS * count_;
+    } else {
+      dest.column_ids_ = nullptr;
+      dest.registers_ = nullptr;
+    }
+  }
+  return ret;
+}
+
+int ObColumnNdvSketch::assign(
+  ObArenaAllocator &allocator,
+  const ObColumnNdvSketch &other)
+{
+  int ret = OB_SUCCESS;
+  if (this == &other) {
+    // do nothing
+  } else if (OB_UNLIKELY(!other.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(other));
+  } else {
+    reset();
+    if (other.is_empty()) {
+    } else if (OB_FAIL(reserve(allocator, other.count_))) {
+      LOG_WARN("fail to reserve ndv sketch", K(ret), K(other));
+    } else {
+      MEMCPY(column_ids_, other.column_ids_, sizeof(uint64_t) * count_);
+      MEMCPY(registers_, other.registers_, NUM_REGISTERS * count_);
+    }
+  }
+  return ret;
+}
+
+int64_t ObColumnNdvSketch::to_string(char *buf, const int64_t buf_len) const
+{
+  int64_t pos = 0;
+  if (OB_ISNULL(buf) || buf_len <= 0) {
+  } else {
+    J_OBJ_START();
+    J_KV(K_(count));
+    if (count_ > 0) {
+      J_COMMA();
+      J_NAME("column_ids");
+      J_COLON();
+      J_ARRAY_START();
+      for (int64_t i = 0; i < count_; ++i) {
+        if (count_ - 1 != i) {
+          common::databuff_printf(buf, buf_len, pos, "%lu,", column_ids_[i]);
+        } else {
+          common::databuff_printf(buf, buf_len, pos, "%lu", column_ids_[i]);
+        }
+      }
+      J_ARRAY_END();
+    }
+    J_OBJ_END();
+  }
+  return pos;
+}
+
+} // namespace blocksstable
+} // namespace oceanbase
@@ -0,0 +1,104 @@
+//Copyright (c) 2024 OceanBase
+// OceanBase is licensed under Mulan PubL v2.
+// You can use this software according to the terms and conditions of the Mulan PubL v2.
+// You may obtain a copy of Mulan PubL v2 at:
+//          http://license.coscl.org.cn/MulanPubL-2.0
+// THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+// EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+// MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+// See the Mulan PubL v2 for more details.
+#ifndef OB_STORAGE_BLOCKSSTABLE_COLUMN_NDV_SKETCH_H_
+#define OB_STORAGE_BLOCKSSTABLE_COLUMN_NDV_SKETCH_H_
+#include "lib/container/ob_iarray.h"
+namespace oceanbase
+{
+namespace common
+{
+class ObArenaAllocator;
+}
+namespace blocksstable
+{
+
+// Per column HyperLogLog registers built by major compaction.
+// The register layout is the same as the llc bitmap of APPROX_COUNT_DISTINCT_SYNOPSIS,
+// so sketches can be merged with the synopsis gathered by DBMS_STATS directly.
+struct ObColumnNdvSketch final
+{
+public:
+  static const int64_t BUCKET_BITS = 10;
+  static const int64_t NUM_REGISTERS = 1L << BUCKET_BITS;
+  static const int64_t MAX_COLUMN_CNT = 64;
+public:
+  ObColumnNdvSketch()
+    : column_ids_(nullptr),
+      registers_(nullptr),
+      count_(0)
+  {}
+  ~ObColumnNdvSketch() { reset(); }
+  void reset()
+  {
+    count_ = 0;
+    column_ids_ = nullptr;
+    registers_ = nullptr;
+  }
+  bool is_valid() const
+  {
+    return 0 == count_ || (count_ > 0 && NULL != column_ids_ && NULL != registers_);
+  }
+  bool is_empty() const
+  {
+    return 0 == count_;
+  }
+  int assign(common::ObArenaAllocator &allocator, const ObColumnNdvSketch &other);
+  int reserve(common::ObArenaAllocator &allocator, const int64_t column_cnt);
+  int64_t find_column(const uint64_t column_id) const;
+  uint8_t *get_registers(const int64_t idx) const
+  {
+    return registers_ + idx * NUM_REGISTERS;
+  }
+  /* serialize need consider count */
+  int serialize(char *buf, const int64_t buf_len, int64_t &pos) const;
+  int deserialize(common::ObArenaAllocator &allocator, const char *buf,
+                  const int64_t data_len, int64_t &pos);
+  int64_t get_serialize_size() const;
+
+  /* only deep copy array */
+  int64_t get_deep_copy_size() const;
+  int deep_copy(
+      char *buf,
+      const int64_t buf_len,
+      int64_t &pos,
+      ObColumnNdvSketch &dest) const;
+  int64_t to_string(char *buf, const int64_t buf_len) const;
+
+  // same as ObAggregateProcessor::llc_add_value
+  static inline void add_hash(uint8_t *registers, const uint64_t hash)
+  {
+    const uint64_t bucket = hash >> (64 - BUCKET_BITS);
+    const uint64_t value = hash << BUCKET_BITS;
+    uint8_t pmax = 0;
+    if (0 != value) {
+      pmax = static_cast<uint8_t>(MIN(static_cast<uint64_t>(__builtin_clzll(value)), 64 - BUCKET_BITS) + 1);
+    }
+    if (pmax > registers[bucket]) {
+      registers[bucket] = pmax;
+    }
+  }
+  static inline void merge_registers(uint8_t *dst, const uint8_t *src)
+  {
+    for (int64_t i = 0; i < NUM_REGISTERS; ++i) {
+      if (src[i] > dst[i]) {
+        dst[i] = src[i];
+      }
+    }
+  }
+
+  uint64_t *column_ids_;
+  uint8_t *registers_;
+  int64_t count_;
+};
+
+} // namespace blocksstable
+} // namespace oceanbase
+
+#endif // OB_STORAGE_BLOCKSSTABLE_COLUMN_NDV_SKETCH_H_
@@ -45,13 +45,18 @@ ObMicroBlockCompressor::ObMicroBlockCompressor()
   : is_none_(false),
     micro_block_size_(0),
     compressor_(NULL),
+    dict_compressor_(NULL),
     comp_buf_("MicroBlkComp"),
-    decomp_buf_("MicroBlkDecomp")
+    decomp_buf_("MicroBlkDecomp"),
+    dict_buf_("MicroBlkDict"),
+    dict_allocator_(ObMemAttr(MTL_ID(), "MicroBlkDict")),
+    dict_(dict_allocator_)
 {
 }
 
 ObMicroBlockCompressor::~ObMicroBlockCompressor()
 {
+  dict_.reset();
 }
 
 void ObMicroBlockCompressor::reset()
@@ -61,8 +66,10 @@ void ObMicroBlockCompressor::reset()
   if (compressor_ != nullptr) {
     compressor_ = nullptr;
   }
+  dict_compressor_ = nullptr;
   comp_buf_.reuse();
   decomp_buf_.reuse();
+  reset_dict();
 }
 
 int ObMicroBlockCompressor::init(const int64_t micro_block_size, const ObCompressorType comptype)
@@ -81,10 +88,40 @@ int ObMicroBlockCompressor::init(const int64_t micro_block_size, const ObCompres
   } else {
     is_none_ = false;
     micro_block_size_ = micro_block_size;
+    if (ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR == comptype) {
+      dict_compressor_ = static_cast<zstd_1_3_8::ObZstdDictCompressor_1_3_8 *>(compressor_);
+    }
   }
   return ret;
 }
 
+int ObMicroBlockCompressor::set_dict(const char *dict_buf, const int64_t dict_size)
+{
+  int ret = OB_SUCCESS;
+  reset_dict();
+  if (OB_ISNULL(dict_buf) || OB_UNLIKELY(dict_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid dict", K(ret), KP(dict_buf), K(dict_size));
+  } else if (OB_UNLIKELY(!is_dict_compressor())) {
+    ret = OB_NOT_SUPPORTED;
+    STORAGE_LOG(WARN, "compressor does not support dict", K(ret), KP_(compressor));
+  } else if (OB_FAIL(dict_buf_.write(dict_buf, dict_size))) {
+    STORAGE_LOG(WARN, "failed to copy dict content", K(ret), K(dict_size));
+  } else if (OB_FAIL(dict_.init(dict_buf_.data(), dict_size))) {
+    STORAGE_LOG(WARN, "failed to init compress dict", K(ret), K(dict_size));
+  }
+  if (OB_FAIL(ret)) {
+    reset_dict();
+  }
+  return ret;
+}
+
+void ObMicroBlockCompressor::reset_dict()
+{
+  dict_.reset();
+  dict_buf_.reuse();
+}
+
 int ObMicroBlockCompressor::compress(const char *in, const int64_t in_size, const char *&out,
                                      int64_t &out_size)
 {
@@ -105,7 +142,11 @@ int ObMicroBlockCompressor::compress(const char *in, const int64_t in_size, cons
     if (OB_FAIL(comp_buf_.ensure_space(need_size))) {
       STORAGE_LOG(WARN, "macro block writer fail to allocate memory for comp_buf_.", K(ret),
                   K(need_size));
-    } else if (OB_FAIL(compressor_->compress(in, in_size, comp_buf_.data(), max_comp_size, comp_size))) {
+    } else if (has_dict() && OB_FAIL(dict_compressor_->compress(in, in_size, comp_buf_.data(),
+                                                                max_comp_size, comp_size, &dict_))) {
+      STORAGE_LOG(WARN, "compressor fail to compress with dict.", K(in), K(in_size), K_(dict),
+                  "comp_ptr", comp_buf_.data(), K(max_comp_size), K(comp_size));
+    } else if (!has_dict() && OB_FAIL(compressor_->compress(in, in_size, comp_buf_.data(), max_comp_size, comp_size))) {
       STORAGE_LOG(WARN, "compressor fail to compress.", K(in), K(in_size),
                   "comp_ptr", comp_buf_.data(), K(max_comp_size), K(comp_size));
     } else if (comp_size >= in_size) {
@@ -134,7 +175,10 @@ int ObMicroBlockCompressor::decompress(const char *in, const int64_t in_size,
     out_size = in_size;
   } else if (OB_FAIL(decomp_buf_.ensure_space(uncomp_size))) {
     STORAGE_LOG(WARN, "failed to ensure decomp space", K(ret), K(uncomp_size));
-  } else if (OB_FAIL(compressor_->decompress(in, in_size, decomp_buf_.data(), uncomp_size,
+  } else if (is_dict_compressor() && OB_FAIL(dict_compressor_->decompress(in, in_size, decomp_buf_.data(),
+      uncomp_size, decomp_size, dict_buf_.data(), dict_buf_.length()))) {
+    STORAGE_LOG(WARN, "failed to decompress data with dict", K(ret), K(in_size), K(uncomp_size), K_(dict));
+  } else if (!is_dict_compressor() && OB_FAIL(compressor_->decompress(in, in_size, decomp_buf_.data(), uncomp_size,
                                              decomp_size))) {
     STORAGE_LOG(WARN, "failed to decompress data", K(ret), K(in_size), K(uncomp_size));
   } else {
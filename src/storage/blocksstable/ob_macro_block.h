@@ -14,6 +14,7 @@
 #define STORAGE_BLOCKSSTABLE_OB_MACRO_BLOCK_H_
 
 #include "lib/compress/ob_compress_util.h"
+#include "lib/compress/zstd_1_3_8/ob_zstd_dict_compressor_1_3_8.h"
 #include "index_block/ob_index_block_util.h"
 #include "ob_block_sstable_struct.h"
 #include "ob_data_buffer.h"
@@ -44,12 +45,21 @@ public:
   int compress(const char *in, const int64_t in_size, const char *&out, int64_t &out_size);
   int decompress(const char *in, const int64_t in_size, const int64_t uncomp_size,
       const char *&out, int64_t &out_size);
+  // dictionary referenced by the following compress/decompress, only for ZSTD_1_3_8_DICT_COMPRESSOR
+  OB_INLINE bool is_dict_compressor() const { return nullptr != dict_compressor_; }
+  OB_INLINE bool has_dict() const { return dict_.is_valid(); }
+  int set_dict(const char *dict_buf, const int64_t dict_size);
+  void reset_dict();
 private:
   bool is_none_;
   int64_t micro_block_size_;
   common::ObCompressor *compressor_;
+  common::zstd_1_3_8::ObZstdDictCompressor_1_3_8 *dict_compressor_;
   storage::ObCompactionBufferWriter comp_buf_;
   storage::ObCompactionBufferWriter decomp_buf_;
+  storage::ObCompactionBufferWriter dict_buf_;
+  common::ObMalloc dict_allocator_;
+  common::zstd_1_3_8::ObZstdCompressDict_1_3_8 dict_;
 };
 
 
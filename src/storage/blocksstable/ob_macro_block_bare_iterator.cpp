@@ -27,7 +27,7 @@ namespace blocksstable
 
 ObMicroBlockBareIterator::ObMicroBlockBareIterator(const uint64_t tenant_id)
   : allocator_(), macro_block_buf_(nullptr), macro_block_buf_size_(0),
-    macro_reader_(tenant_id), index_reader_(tenant_id), common_header_(),
+    dict_buf_(nullptr), dict_buf_size_(0), macro_reader_(tenant_id), index_reader_(tenant_id), common_header_(),
     macro_block_header_(), reader_(nullptr), micro_reader_helper_(),
     index_rowkey_cnt_(0),
     begin_idx_(0), end_idx_(0), iter_idx_(0), read_pos_(0),
@@ -53,6 +53,9 @@ void ObMicroBlockBareIterator::reset()
   end_idx_ = 0;
   iter_idx_ = 0;
   read_pos_ = 0;
+  macro_reader_.reset_compress_dict();
+  dict_buf_ = nullptr;
+  dict_buf_size_ = 0;
   allocator_.reset();
   is_inited_ = false;
 }
@@ -68,6 +71,7 @@ void ObMicroBlockBareIterator::reuse()
   end_idx_ = 0;
   iter_idx_ = 0;
   read_pos_ = 0;
+  macro_reader_.reset_compress_dict();
   is_inited_ = false;
 }
 
@@ -108,7 +112,11 @@ int ObMicroBlockBareIterator::open(
     begin_idx_ = 0;
     end_idx_ = macro_block_header_.fixed_header_.micro_block_count_ - 1;
     need_deserialize_ = need_deserialize;
-    is_inited_ = true;
+    if (OB_FAIL(prepare_compress_dict())) {
+      LOG_WARN("fail to prepare compress dict", K(ret), K_(macro_block_header));
+    } else {
+      is_inited_ = true;
+    }
   }
   return ret;
 }
@@ -147,6 +155,9 @@ int ObMicroBlockBareIterator::open(
     macro_block_buf_ = macro_block_buf;
     macro_block_buf_size_ = macro_block_buf_size;
     need_deserialize_ = need_deserialize;
+    if (OB_FAIL(prepare_compress_dict())) {
+      LOG_WARN("fail to prepare compress dict", K(ret), K_(macro_block_header));
+    }
   }
 
   if (OB_FAIL(ret)) {
@@ -177,6 +188,43 @@ int ObMicroBlockBareIterator::open(
   return ret;
 }
 
+int ObMicroBlockBareIterator::prepare_compress_dict()
+{
+  int ret = OB_SUCCESS;
+  const int64_t first_micro_offset = macro_block_header_.fixed_header_.micro_block_data_offset_;
+  const char *dict_buf = nullptr;
+  int64_t dict_size = 0;
+  macro_reader_.reset_compress_dict();
+  if (!need_deserialize_
+      || !common_header_.is_sstable_data_block()
+      || ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR != macro_block_header_.fixed_header_.compressor_type_
+      || macro_block_header_.fixed_header_.micro_block_count_ <= 0) {
+    // only micro blocks in data macro block reference the dict
+  } else if (OB_UNLIKELY(first_micro_offset <= 0 || first_micro_offset >= macro_block_buf_size_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected first micro block offset", K(ret), K(first_micro_offset), K_(macro_block_buf_size));
+  } else if (OB_FAIL(macro_reader_.get_compress_dict(macro_block_header_, macro_block_buf_ + first_micro_offset,
+      macro_block_buf_size_ - first_micro_offset, dict_buf, dict_size))) {
+    LOG_WARN("fail to get compress dict", K(ret), K_(macro_block_header));
+  } else {
+    if (dict_buf_size_ < dict_size) {
+      dict_buf_ = nullptr;
+      dict_buf_size_ = 0;
+      if (OB_ISNULL(dict_buf_ = static_cast<char *>(allocator_.alloc(dict_size)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to alloc dict buf", K(ret), K(dict_size));
+      } else {
+        dict_buf_size_ = dict_size;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      MEMCPY(dict_buf_, dict_buf, dict_size);
+      macro_reader_.set_compress_dict(dict_buf_, dict_size);
+    }
+  }
+  return ret;
+}
+
 int ObMicroBlockBareIterator::get_next_micro_block_data_and_offset(ObMicroBlockData &micro_block, int64_t &offset)
 {
   int ret = OB_SUCCESS;
@@ -76,10 +76,13 @@ private:
       const bool is_left_border,
       const bool is_right_border);
   int set_reader(const ObRowStoreType store_type);
+  int prepare_compress_dict();
 private:
   ObArenaAllocator allocator_;
   const char *macro_block_buf_;
   int64_t macro_block_buf_size_;
+  char *dict_buf_;
+  int64_t dict_buf_size_;
   ObMacroBlockReader macro_reader_;
   ObMacroBlockReader index_reader_;
   ObMacroBlockCommonHeader common_header_;
@@ -15,6 +15,7 @@
 #include "storage/blocksstable/encoding/ob_micro_block_decoder.h"
 #include "storage/blocksstable/cs_encoding/ob_cs_micro_block_transformer.h"
 #include "lib/compress/ob_compressor_pool.h"
+#include "lib/compress/zstd_1_3_8/ob_zstd_dict_compressor_1_3_8.h"
 #include "share/ob_encryption_util.h"
 #include "share/rc/ob_tenant_base.h"
 #include "share/scheduler/ob_tenant_dag_scheduler.h"
@@ -40,7 +41,9 @@ ObMacroBlockReader::ObMacroBlockReader(const uint64_t tenant_id)
      decrypt_buf_(NULL),
      decrypt_buf_size_(0),
      allocator_(ObModIds::OB_CS_SSTABLE_READER, OB_MALLOC_NORMAL_BLOCK_SIZE, tenant_id),
-     encryption_(nullptr)
+     encryption_(nullptr),
+     dict_buf_(nullptr),
+     dict_size_(0)
 {
   if (share::is_reserve_mode()) {
     allocator_.set_ctx_id(ObCtxIds::MERGE_RESERVE_CTX_ID);
@@ -147,7 +150,7 @@ int ObMacroBlockReader::decompress_data_buf(
       if (OB_FAIL(alloc_buf(*ext_allocator, uncomp_size, ext_uncomp_buf))) {
         LOG_WARN("Fail to allocate buf", K(ret), K(uncomp_size), K(header));
       } else {
-        if (OB_FAIL(compressor_->decompress(data_buf, data_buf_size,
+        if (OB_FAIL(do_decompress(data_buf, data_buf_size,
             ext_uncomp_buf + header_size, data_length, uncomp_size))) {
           LOG_WARN("compressor fail to decompress.", K(ret));
         } else if (OB_FAIL(header.deep_copy(ext_uncomp_buf, header_size, pos, copied_header))) {
@@ -163,7 +166,7 @@ int ObMacroBlockReader::decompress_data_buf(
       }
     } else if (OB_FAIL(alloc_buf(uncomp_size, uncomp_buf_, uncomp_buf_size_))) {
       LOG_WARN("Fail to allocate buf", K(ret));
-    } else if (OB_FAIL(compressor_->decompress(data_buf, data_buf_size,
+    } else if (OB_FAIL(do_decompress(data_buf, data_buf_size,
         uncomp_buf_ + header_size, data_length, uncomp_size))) {
       LOG_WARN("Fail to decompress", K(ret));
     } else if (OB_FAIL(header.deep_copy(uncomp_buf_, header_size, pos, copied_header))) {
@@ -198,7 +201,7 @@ int ObMacroBlockReader::decompress_payload_buf(
     if (OB_FAIL(ret)) {
     } else if (OB_FAIL(alloc_buf(uncomp_size, uncomp_buf_, uncomp_buf_size_))) {
       LOG_WARN("Fail to allocate buf", K(ret));
-    } else if (OB_FAIL(compressor_->decompress(payload_buf, payload_buf_size,
+    } else if (OB_FAIL(do_decompress(payload_buf, payload_buf_size,
         uncomp_buf_, uncomp_size, real_uncomp_size))) {
       LOG_WARN("Fail to decompress", K(ret));
     } else if (OB_UNLIKELY(uncomp_size != real_uncomp_size)) {
@@ -269,7 +272,7 @@ int ObMacroBlockReader::decompress_data_with_prealloc_buf(
       }
     }
 
-    if (FAILEDx(compressor_->decompress(buf, size, uncomp_buf, uncomp_buf_size, uncomp_size))) {
+    if (FAILEDx(do_decompress(buf, size, uncomp_buf, uncomp_buf_size, uncomp_size))) {
       LOG_WARN("Fail to decompress data", K(ret));
     } else {
       if (OB_UNLIKELY(uncomp_size != uncomp_buf_size)) {
@@ -304,7 +307,7 @@ int ObMacroBlockReader::decompress_data_with_prealloc_buf(
     }
     if (OB_SUCC(ret)) {
       int64_t uncomp_size;
-      if (OB_FAIL(compressor_->decompress(buf, size, uncomp_buf, uncomp_buf_size, uncomp_size))) {
+      if (OB_FAIL(do_decompress(buf, size, uncomp_buf, uncomp_buf_size, uncomp_size))) {
         LOG_WARN("failed to decompress data", K(ret));
       } else {
         if (OB_UNLIKELY(uncomp_size != uncomp_buf_size)) {
@@ -317,6 +320,69 @@ int ObMacroBlockReader::decompress_data_with_prealloc_buf(
   return ret;
 }
 
+int ObMacroBlockReader::get_compress_dict(
+    const ObSSTableMacroBlockHeader &block_header,
+    const char *first_micro_buf,
+    const int64_t first_micro_buf_size,
+    const char *&dict_buf,
+    int64_t &dict_size)
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockHeader header;
+  const char *uncomp_buf = nullptr;
+  int64_t uncomp_size = 0;
+  int64_t pos = 0;
+  bool is_compressed = false;
+  dict_buf = nullptr;
+  dict_size = 0;
+  if (OB_ISNULL(first_micro_buf) || OB_UNLIKELY(!block_header.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(first_micro_buf), K(first_micro_buf_size), K(block_header));
+  } else if (OB_UNLIKELY(ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR != block_header.fixed_header_.compressor_type_)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("macro block is not compressed with dict", K(ret), K(block_header));
+  } else if (OB_FAIL(header.deserialize(first_micro_buf, first_micro_buf_size, pos))) {
+    LOG_WARN("fail to deserialize first micro block header", K(ret), K(first_micro_buf_size));
+  } else if (OB_FAIL(header.check_record(first_micro_buf, header.header_size_ + header.data_zlength_,
+      MICRO_BLOCK_HEADER_MAGIC))) {
+    LOG_WARN("fail to check first micro block record", K(ret), K(header));
+  } else if (FALSE_IT(reset_compress_dict())) {
+    // the first micro block is always compressed without dict
+  } else if (OB_FAIL(decrypt_and_decompress_data(block_header, first_micro_buf,
+      header.header_size_ + header.data_zlength_, uncomp_buf, uncomp_size, is_compressed))) {
+    LOG_WARN("fail to decompress first micro block", K(ret), K(header));
+  } else if (OB_UNLIKELY(uncomp_size != header.header_size_ + header.data_length_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected uncompressed size of first micro block", K(ret), K(uncomp_size), K(header));
+  } else {
+    dict_buf = uncomp_buf + header.header_size_;
+    dict_size = header.data_length_;
+  }
+  return ret;
+}
+
+int ObMacroBlockReader::do_decompress(
+    const char *src_buf,
+    const int64_t src_size,
+    char *dst_buf,
+    const int64_t dst_buf_size,
+    int64_t &dst_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(compressor_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected null compressor", K(ret));
+  } else if (ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR == compressor_->get_compressor_type()) {
+    if (OB_FAIL(static_cast<zstd_1_3_8::ObZstdDictCompressor_1_3_8 *>(compressor_)->decompress(
+        src_buf, src_size, dst_buf, dst_buf_size, dst_size, dict_buf_, dict_size_))) {
+      LOG_WARN("fail to decompress with dict", K(ret), K(src_size), KP_(dict_buf), K_(dict_size));
+    }
+  } else if (OB_FAIL(compressor_->decompress(src_buf, src_size, dst_buf, dst_buf_size, dst_size))) {
+    LOG_WARN("fail to decompress", K(ret), K(src_size), K(dst_buf_size));
+  }
+  return ret;
+}
+
 int ObMacroBlockReader::alloc_buf(const int64_t req_size, char *&buf, int64_t &buf_size)
 {
   int ret = OB_SUCCESS;
@@ -126,7 +126,29 @@ public:
       const char *&decrypt_buf,
       int64_t &decrypt_size);
 #endif
+  // Dictionary of the micro blocks compressed by ZSTD_1_3_8_DICT_COMPRESSOR, which is the raw content
+  // of the first micro block in the macro block. The caller keeps @dict_buf alive until reset.
+  OB_INLINE void set_compress_dict(const char *dict_buf, const int64_t dict_size)
+  {
+    dict_buf_ = dict_buf;
+    dict_size_ = dict_size;
+  }
+  OB_INLINE void reset_compress_dict() { set_compress_dict(nullptr, 0); }
+  // decompress the first micro block of a data macro block into the dictionary,
+  // @dict_buf points to the inner buffer and is valid until the next decompress
+  int get_compress_dict(
+      const ObSSTableMacroBlockHeader &block_header,
+      const char *first_micro_buf,
+      const int64_t first_micro_buf_size,
+      const char *&dict_buf,
+      int64_t &dict_size);
 private:
+  int do_decompress(
+      const char *src_buf,
+      const int64_t src_size,
+      char *dst_buf,
+      const int64_t dst_buf_size,
+      int64_t &dst_size);
   int alloc_buf(const int64_t req_size, char *&buf, int64_t &buf_size);
   int alloc_buf(ObIAllocator &allocator, const int64_t buf_size, char *&buf);
 #ifdef OB_BUILD_TDE_SECURITY
@@ -141,6 +163,8 @@ private:
   int64_t decrypt_buf_size_;
   common::ObArenaAllocator allocator_;
   ObMicroBlockEncryption *encryption_;
+  const char *dict_buf_;
+  int64_t dict_size_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObMacroBlockReader);
 };
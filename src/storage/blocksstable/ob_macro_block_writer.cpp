@@ -53,7 +53,12 @@ ObMicroBlockBufferHelper::ObMicroBlockBufferHelper()
     check_reader_helper_(),
     checksum_helper_(),
     check_datum_row_(),
-    allocator_("BlockBufHelper")
+    allocator_("BlockBufHelper"),
+    use_compress_dict_(false),
+    dict_macro_seq_(-1),
+    last_raw_buf_(nullptr),
+    last_raw_size_(0),
+    last_dict_compressed_buf_(nullptr)
 {
 }
 
@@ -94,6 +99,7 @@ int ObMicroBlockBufferHelper::open(
   } else {
     data_store_desc_ = &data_store_desc;
     micro_block_merge_verify_level_ = GCONF.micro_block_merge_verify_level;
+    use_compress_dict_ = compressor_.is_dict_compressor() && !data_store_desc.is_for_index_or_meta();
   }
   return ret;
 }
@@ -103,6 +109,11 @@ void ObMicroBlockBufferHelper::reset()
   data_store_desc_ = nullptr;
   micro_block_merge_verify_level_ = 0;
   compressor_.reset();
+  use_compress_dict_ = false;
+  dict_macro_seq_ = -1;
+  last_raw_buf_ = nullptr;
+  last_raw_size_ = 0;
+  last_dict_compressed_buf_ = nullptr;
 #ifdef OB_BUILD_TDE_SECURITY
   encryption_.reset();
 #endif
@@ -122,6 +133,9 @@ int ObMicroBlockBufferHelper::compress_encrypt_micro_block(ObMicroBlockDesc &mic
   if (OB_UNLIKELY(!micro_block_desc.is_valid())) {
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN, "invalid micro block desc", K(ret), K(micro_block_desc));
+  } else if (FALSE_IT(last_dict_compressed_buf_ = nullptr)) {
+  } else if (compressor_.has_dict() && dict_macro_seq_ != seq && FALSE_IT(compressor_.reset_dict())) {
+    // never reference the dict of another macro block
   } else if (OB_FAIL(compressor_.compress(block_buffer, block_size, compress_buf, compress_buf_size))) {
     STORAGE_LOG(WARN, "macro block writer fail to compress.",
         K(ret), K(OB_P(block_buffer)), K(block_size));
@@ -148,6 +162,47 @@ int ObMicroBlockBufferHelper::compress_encrypt_micro_block(ObMicroBlockDesc &mic
     header->data_checksum_ = ob_crc64_sse42(0, micro_block_desc.buf_, micro_block_desc.buf_size_);
     header->original_length_ = micro_block_desc.original_size_;
     header->set_header_checksum();
+    last_raw_buf_ = block_buffer;
+    last_raw_size_ = block_size;
+    if (compressor_.has_dict() && compress_buf_size < block_size) {
+      last_dict_compressed_buf_ = micro_block_desc.buf_;
+    }
+  }
+  return ret;
+}
+
+int ObMicroBlockBufferHelper::update_compress_dict(const int64_t macro_seq)
+{
+  int ret = OB_SUCCESS;
+  if (!use_compress_dict_) {
+  } else if (OB_ISNULL(last_raw_buf_) || OB_UNLIKELY(last_raw_size_ <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "unexpected empty raw micro block", K(ret), KP_(last_raw_buf), K_(last_raw_size));
+  } else if (OB_FAIL(compressor_.set_dict(last_raw_buf_, last_raw_size_))) {
+    STORAGE_LOG(WARN, "failed to set compress dict", K(ret), K_(last_raw_size));
+  } else {
+    dict_macro_seq_ = macro_seq;
+  }
+  return ret;
+}
+
+int ObMicroBlockBufferHelper::recompress_for_new_macro(
+    ObMicroBlockDesc &micro_block_desc,
+    const int64_t macro_seq,
+    const int64_t micro_offset)
+{
+  int ret = OB_SUCCESS;
+  if (nullptr == last_dict_compressed_buf_ || last_dict_compressed_buf_ != micro_block_desc.buf_) {
+    // not compressed with dict, no need to compress again
+  } else if (OB_UNLIKELY(dict_macro_seq_ == macro_seq)) {
+    ret = OB_ERR_UNEXPECTED;
+    STORAGE_LOG(WARN, "macro block is not switched", K(ret), K(macro_seq), K_(dict_macro_seq));
+  } else {
+    micro_block_desc.buf_ = last_raw_buf_;
+    micro_block_desc.buf_size_ = last_raw_size_;
+    if (OB_FAIL(compress_encrypt_micro_block(micro_block_desc, macro_seq, micro_offset))) {
+      STORAGE_LOG(WARN, "failed to compress micro block again", K(ret), K(micro_block_desc));
+    }
   }
   return ret;
 }
@@ -1174,6 +1229,10 @@ int ObMacroBlockWriter::build_micro_block()
     } else {
       if (OB_FAIL(write_micro_block(micro_block_desc))) {
         STORAGE_LOG(WARN, "fail to write micro block ", K(ret), K(micro_block_desc));
+      } else if (micro_helper_.use_compress_dict()
+          && 1 == macro_blocks_[current_index_].get_micro_block_count()
+          && OB_FAIL(micro_helper_.update_compress_dict(macro_blocks_[current_index_].get_current_macro_seq()))) {
+        STORAGE_LOG(WARN, "fail to update compress dict", K(ret), K(micro_block_desc));
       } else if (OB_FAIL(micro_block_adaptive_splitter_.update_compression_info(micro_block_desc.row_count_,
           block_size, micro_block_desc.buf_size_))) {
         STORAGE_LOG(WARN, "Fail to update_compression_info", K(ret), K(micro_block_desc));
@@ -1388,6 +1447,10 @@ int ObMacroBlockWriter::write_micro_block(ObMicroBlockDesc &micro_block_desc)
         STORAGE_LOG(WARN, "Fail to switch macro block, ", K(ret));
       } else if (OB_FAIL(alloc_block())) {
         STORAGE_LOG(WARN, "Fail to pre-alloc block", K(ret));
+      } else if (OB_FAIL(micro_helper_.recompress_for_new_macro(micro_block_desc,
+                                                                 macro_blocks_[current_index_].get_current_macro_seq(),
+                                                                 macro_blocks_[current_index_].get_data_size()))) {
+        STORAGE_LOG(WARN, "Fail to compress micro block for new macro block", K(ret));
       } else {
         micro_block_desc.macro_id_ = macro_handles_[current_index_].get_macro_id();
         micro_block_desc.block_offset_ = macro_blocks_[current_index_].get_data_size();
@@ -1417,6 +1480,10 @@ int ObMacroBlockWriter::write_micro_block(ObMicroBlockDesc &micro_block_desc)
           STORAGE_LOG(WARN, "Fail to switch macro block, ", K(ret));
         } else if (OB_FAIL(alloc_block())) {
           STORAGE_LOG(WARN, "Fail to pre-alloc block", K(ret));
+        } else if (OB_FAIL(micro_helper_.recompress_for_new_macro(micro_block_desc,
+                                                                   macro_blocks_[current_index_].get_current_macro_seq(),
+                                                                   macro_blocks_[current_index_].get_data_size()))) {
+          STORAGE_LOG(WARN, "Fail to compress micro block for new macro block", K(ret));
         } else if (OB_FAIL(macro_blocks_[current_index_].write_micro_block(micro_block_desc, data_offset))) {
           STORAGE_LOG(WARN, "Fail to write micro block, ", K(ret));
         }
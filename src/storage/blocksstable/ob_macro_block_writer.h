@@ -75,6 +75,14 @@ public:
       const ObDataStoreDesc &data_store_desc,
       common::ObIAllocator &allocator);
   int compress_encrypt_micro_block(ObMicroBlockDesc &micro_block_desc, const int64_t macro_seq, const int64_t micro_offset);
+  // With ZSTD_1_3_8_DICT_COMPRESSOR, the raw content of the first data micro block in a macro block
+  // is the dictionary of the following micro blocks in the same macro block.
+  // Called after the first micro block of macro @macro_seq is written.
+  int update_compress_dict(const int64_t macro_seq);
+  // the micro block compressed with the dict of the previous macro block has to be compressed again
+  // after switching macro block, it becomes the dictionary of the new macro block.
+  int recompress_for_new_macro(ObMicroBlockDesc &micro_block_desc, const int64_t macro_seq, const int64_t micro_offset);
+  OB_INLINE bool use_compress_dict() const { return use_compress_dict_; }
   int dump_micro_block_writer_buffer(const char *buf, const int64_t size);
   void reset();
 private:
@@ -103,6 +111,12 @@ private:
   ObMicroBlockChecksumHelper checksum_helper_;
   blocksstable::ObDatumRow check_datum_row_;
   compaction::ObLocalArena allocator_;
+  bool use_compress_dict_;
+  int64_t dict_macro_seq_;
+  // raw content of the last compressed micro block, valid until the micro writer is reused
+  const char *last_raw_buf_;
+  int64_t last_raw_size_;
+  const char *last_dict_compressed_buf_;
 };
 
 class ObMicroBlockAdaptiveSplitter
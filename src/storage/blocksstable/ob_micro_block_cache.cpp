@@ -18,6 +18,7 @@
 #include "storage/blocksstable/ob_macro_block_handle.h"
 #include "storage/blocksstable/ob_shared_macro_block_manager.h"
 #include "storage/blocksstable/cs_encoding/ob_cs_micro_block_transformer.h"
+#include "storage/blocksstable/ob_storage_cache_suite.h"
 
 namespace oceanbase
 {
@@ -298,6 +299,7 @@ void ObMultiBlockIOParam::reset()
   micro_block_count_ = 0;
   io_read_batch_size_ = 0;
   io_read_gap_size_ = 0;
+  nested_offset_ = 0;
   row_header_ = nullptr;
   prefetch_idx_.reset();
   micro_infos_.reset();
@@ -307,6 +309,7 @@ void ObMultiBlockIOParam::reuse()
 {
   data_cache_size_ = 0;
   micro_block_count_ = 0;
+  nested_offset_ = 0;
   row_header_ = nullptr;
 }
 
@@ -348,6 +351,7 @@ bool ObMultiBlockIOParam::add_micro_data(const ObMicroIndexInfo &index_info,
   need_split = false;
   if (0 == micro_block_count_) {
     row_header_ = index_info.row_header_;
+    nested_offset_ = index_info.nested_offset_;
     size = index_info.get_block_size();
   } else if (!is_reverse_) {
     size = index_info.get_block_offset() + index_info.get_block_size() - micro_infos_[0].offset_;
@@ -385,7 +389,9 @@ ObIMicroBlockIOCallback::ObIMicroBlockIOCallback(const ObIOCallbackType type)
     data_checksum_(0),
     block_des_meta_(),
     use_block_cache_(true),
-    rowkey_col_descs_(nullptr)
+    rowkey_col_descs_(nullptr),
+    dict_handle_(),
+    dict_nested_offset_(-1)
 {
   MEMSET(encrypt_key_, 0, sizeof(encrypt_key_));
   block_des_meta_.encrypt_key_ = encrypt_key_;
@@ -412,6 +418,47 @@ void ObIMicroBlockIOCallback::set_micro_des_meta(const ObIndexBlockRowHeader *id
   MEMCPY(encrypt_key_, idx_row_header->get_encrypt_key(), share::OB_MAX_TABLESPACE_ENCRYPT_KEY_LENGTH);
 }
 
+int ObIMicroBlockIOCallback::prepare_compress_dict(
+    const uint64_t tenant_id,
+    const MacroBlockId &macro_id,
+    const int64_t nested_offset,
+    const bool is_data_block,
+    const bool allow_sync_io)
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockDictCache &dict_cache = OB_STORE_CACHE.get_micro_block_dict_cache();
+  dict_handle_.reset();
+  dict_nested_offset_ = -1;
+  if (!is_data_block || ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR != block_des_meta_.compressor_type_) {
+    // index and meta micro blocks never reference dict
+  } else if (allow_sync_io) {
+    if (OB_FAIL(dict_cache.get_dict(tenant_id, macro_id, nested_offset, dict_handle_))) {
+      LOG_WARN("fail to get micro block dict", K(ret), K(tenant_id), K(macro_id), K(nested_offset));
+    }
+  } else if (OB_FAIL(dict_cache.get_cached_dict(tenant_id, macro_id, nested_offset, dict_handle_))) {
+    if (OB_ENTRY_NOT_EXIST == ret) {
+      ret = OB_SUCCESS;
+      dict_nested_offset_ = nested_offset;
+    } else {
+      LOG_WARN("fail to get cached micro block dict", K(ret), K(tenant_id), K(macro_id), K(nested_offset));
+    }
+  }
+  return ret;
+}
+
+int ObIMicroBlockIOCallback::load_compress_dict(const char *io_buf, const int64_t io_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!need_load_compress_dict())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected load dict", K(ret), K_(dict_nested_offset));
+  } else if (OB_FAIL(OB_STORE_CACHE.get_micro_block_dict_cache().put_dict(
+      tenant_id_, block_id_, dict_nested_offset_, io_buf, io_size, dict_handle_))) {
+    LOG_WARN("fail to put micro block dict", K(ret), K_(tenant_id), K_(block_id), K_(dict_nested_offset), K(io_size));
+  }
+  return ret;
+}
+
 int ObIMicroBlockIOCallback::alloc_data_buf(const char *io_data_buffer, const int64_t data_size)
 {
   //UNUSED NOW
@@ -464,6 +511,7 @@ int ObIMicroBlockIOCallback::process_block(
     LOG_ERROR("Micro block data is corrupted", K(ret), K_(block_id), K(offset),
         K(size), K_(tenant_id), KP(buffer), KP(this));
   } else {
+    reader->set_compress_dict(dict_handle_.get_dict_buf(), dict_handle_.get_dict_size());
     if (OB_UNLIKELY(!use_block_cache_)) {
       // Won't put in cache
       if (OB_FAIL(read_block_and_copy(header, *reader, buffer, size, block_data, micro_block, cache_handle))) {
@@ -487,6 +535,7 @@ int ObIMicroBlockIOCallback::process_block(
     // NOTE: if block has column level compress and don't use kvcache,
     // the block not be full transformed here and left to be part transformed in
     // cs micro block decoder.
+    reader->reset_compress_dict();
   }
   return ret;
 }
@@ -613,9 +662,16 @@ int ObAsyncSingleMicroBlockIOCallback::process(
     LOG_WARN("invalid data buffer size", K(ret), K(size), KP(data_buffer));
   } else {
     ObMacroBlockReader *reader = nullptr;
-    if (OB_FAIL(get_macro_block_reader(use_tl_reader, reader))) {
+    // the io starts from the nested offset if the dict is read along with the micro block
+    const int64_t skip_size = need_load_compress_dict() ? offset_ - dict_nested_offset_ : 0;
+    if (OB_UNLIKELY(skip_size < 0 || skip_size >= size)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("unexpected io range", K(ret), K(skip_size), K(size), K_(offset), K_(dict_nested_offset));
+    } else if (OB_FAIL(get_macro_block_reader(use_tl_reader, reader))) {
       LOG_WARN("get macro block reader failed", K(ret), K(use_tl_reader));
-    } else if (OB_FAIL(process_block(reader, data_buffer, offset_, size, logic_micro_id_,
+    } else if (need_load_compress_dict() && OB_FAIL(load_compress_dict(data_buffer, size))) {
+      LOG_WARN("load compress dict failed", K(ret));
+    } else if (OB_FAIL(process_block(reader, data_buffer + skip_size, offset_, size - skip_size, logic_micro_id_,
                                      data_checksum_, micro_block_, cache_handle_))) {
       LOG_WARN("process_block failed", K(ret));
     }
@@ -690,6 +746,8 @@ int ObMultiDataBlockIOCallback::process(
       LOG_WARN("get macro block reader failed", K(ret), K(use_tl_reader));
     } else if (OB_FAIL(alloc_result())) {
       LOG_WARN("alloc_result failed", K(ret));
+    } else if (need_load_compress_dict() && OB_FAIL(load_compress_dict(data_buffer, size))) {
+      LOG_WARN("load compress dict failed", K(ret));
     }
 
     const int64_t block_count = io_ctx_.micro_block_count_;
@@ -863,11 +921,13 @@ int ObSyncSingleMicroBLockIOCallback::inner_process(const char *data_buffer, con
           LOG_WARN("fail to decrypt_and_full_transform_data", K(ret), K(header), K(block_des_meta_), K(is_data_block_));
         }
       } else { // not cs_encoding
+        macro_reader_->set_compress_dict(dict_handle_.get_dict_buf(), dict_handle_.get_dict_size());
         if (OB_FAIL(macro_reader_->do_decrypt_and_decompress_data(
             header, block_des_meta_, src_block_buf, src_buf_size, block_data_->get_buf(),
             block_data_->get_buf_size(), is_compressed, true /* need_deep_copy */, allocator_))) {
           LOG_WARN("Fail to decrypt and decompress micro block data buf", K(ret));
         }
+        macro_reader_->reset_compress_dict();
       }
     }
   }
@@ -988,7 +1048,20 @@ int ObIMicroBlockCache::prefetch(
       read_info.is_major_macro_preread_ = true;
     }
 
-    if (OB_FAIL(ObObjectManager::async_read_object(read_info, macro_handle))) {
+    if (OB_FAIL(callback.prepare_compress_dict(tenant_id, macro_id, idx_row.nested_offset_,
+        ObMicroBlockData::DATA_BLOCK == get_type(), false/*allow_sync_io*/))) {
+      LOG_WARN("Fail to prepare compress dict", K(ret), K(macro_id));
+    } else if (callback.need_load_compress_dict()) {
+      // read from the head of the sstable in macro block to take the dict along,
+      // the io no longer matches a single micro block
+      read_info.offset_ = idx_row.nested_offset_;
+      read_info.size_ = idx_row.get_block_offset() + idx_row.get_block_size() - idx_row.nested_offset_;
+      read_info.logic_micro_id_.reset();
+      read_info.micro_crc_ = 0;
+      read_info.bypass_micro_cache_ = true;
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(ObObjectManager::async_read_object(read_info, macro_handle))) {
       STORAGE_LOG(WARN, "Fail to async read block, ", K(ret), K(read_info));
     } else {
       EVENT_INC(ObStatEventIds::IO_READ_PREFETCH_MICRO_COUNT);
@@ -1034,7 +1107,17 @@ int ObIMicroBlockCache::prefetch(
   // only prefetch_multi_block need preread major macro
   read_info.is_major_macro_preread_ = true;
 
-  if (OB_FAIL(ObObjectManager::async_read_object(read_info, macro_handle))) {
+  if (OB_FAIL(callback.prepare_compress_dict(tenant_id, macro_id, io_param.nested_offset_,
+      ObMicroBlockData::DATA_BLOCK == get_type(), false/*allow_sync_io*/))) {
+    LOG_WARN("Fail to prepare compress dict", K(ret), K(macro_id));
+  } else if (callback.need_load_compress_dict()) {
+    // read from the head of the sstable in macro block to take the dict along
+    read_info.offset_ = io_param.nested_offset_;
+    read_info.size_ = offset + size - io_param.nested_offset_;
+    callback.offset_ = io_param.nested_offset_;
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(ObObjectManager::async_read_object(read_info, macro_handle))) {
     STORAGE_LOG(WARN, "Fail to async read block, ", K(ret), K(read_info));
   } else {
     EVENT_ADD(ObStatEventIds::IO_READ_PREFETCH_MICRO_COUNT, io_param.micro_block_count_);
@@ -1227,6 +1310,7 @@ int ObDataMicroBlockCache::prefetch_multi_block(
 
 int ObDataMicroBlockCache::load_block(
     const ObMicroBlockId &micro_block_id,
+    const int64_t nested_offset,
     const ObMicroBlockDesMeta &des_meta,
     const ObLogicMicroBlockId &logic_micro_id,
     const int64_t data_checksum,
@@ -1270,7 +1354,10 @@ int ObDataMicroBlockCache::load_block(
       macro_read_info.logic_micro_id_ = logic_micro_id;
       macro_read_info.micro_crc_ = data_checksum;
 
-      if (OB_FAIL(ObObjectManager::read_object(macro_read_info, macro_handle))) {
+      if (OB_FAIL(callback->prepare_compress_dict(MTL_ID(), micro_block_id.macro_id_, nested_offset,
+          true/*is_data_block*/, true/*allow_sync_io*/))) {
+        LOG_WARN("Fail to prepare compress dict", K(ret), K(micro_block_id));
+      } else if (OB_FAIL(ObObjectManager::read_object(macro_read_info, macro_handle))) {
         LOG_WARN("Fail to sync read block", K(ret), K(macro_read_info));
       } else {
         block_data.type_ = ObMicroBlockData::DATA_BLOCK;
@@ -1527,6 +1614,7 @@ int ObIndexMicroBlockCache::init(const char *cache_name, const int64_t priority)
 
 int ObIndexMicroBlockCache::load_block(
     const ObMicroBlockId &micro_block_id,
+    const int64_t nested_offset,
     const ObMicroBlockDesMeta &des_meta,
     const ObLogicMicroBlockId &logic_micro_id,
     const int64_t data_checksum,
@@ -1535,6 +1623,7 @@ int ObIndexMicroBlockCache::load_block(
     ObIAllocator *allocator)
 {
   UNUSED(macro_reader);
+  UNUSED(nested_offset);
   int ret = OB_SUCCESS;
   ObStorageObjectReadInfo macro_read_info;
   ObStorageObjectHandle macro_handle;
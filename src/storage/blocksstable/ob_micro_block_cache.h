@@ -16,6 +16,7 @@
 #include "share/cache/ob_kv_storecache.h"
 #include "ob_block_sstable_struct.h"
 #include "ob_macro_block_reader.h"
+#include "ob_micro_block_dict_cache.h"
 #include "index_block/ob_index_block_row_scanner.h"
 #include "storage/ob_i_table.h"
 #include "storage/blocksstable/ob_micro_block_info.h"
@@ -163,6 +164,7 @@ public:
       micro_block_count_(0),
       io_read_batch_size_(0),
       io_read_gap_size_(0),
+      nested_offset_(0),
       row_header_(nullptr),
       prefetch_idx_(),
       micro_infos_()
@@ -201,13 +203,14 @@ public:
   inline int64_t get_data_cache_size() const
   { return data_cache_size_; }
   TO_STRING_KV(K_(is_reverse), K_(data_cache_size), K_(io_read_batch_size),
-               K_(io_read_gap_size), K_(micro_block_count));
+               K_(io_read_gap_size), K_(micro_block_count), K_(nested_offset));
 
   bool is_reverse_;
   int64_t data_cache_size_;
   int64_t micro_block_count_;
   int64_t io_read_batch_size_;
   int64_t io_read_gap_size_;
+  int64_t nested_offset_;
   const ObIndexBlockRowHeader *row_header_;
   ObReallocatedFixedArray<int64_t> prefetch_idx_;
   ObReallocatedFixedArray<ObMicroBlockInfo> micro_infos_;
@@ -252,6 +255,16 @@ public:
   {
     rowkey_col_descs_ = rowkey_col_descs;
   }
+  // hold the compress dict of data macro block compressed by ZSTD_1_3_8_DICT_COMPRESSOR before io.
+  // If the dict is not cached, read it synchronously when @allow_sync_io, otherwise the io has to
+  // start from @nested_offset to take the dict along, and the dict is loaded in callback process.
+  int prepare_compress_dict(
+      const uint64_t tenant_id,
+      const MacroBlockId &macro_id,
+      const int64_t nested_offset,
+      const bool is_data_block,
+      const bool allow_sync_io);
+  OB_INLINE bool need_load_compress_dict() const { return dict_nested_offset_ >= 0; }
 protected:
   friend class ObIMicroBlockCache;
   friend class ObDataMicroBlockCache;
@@ -265,6 +278,8 @@ protected:
       const ObMicroBlockCacheValue *&micro_block,
       common::ObKVCacheHandle &cache_handle);
   int get_macro_block_reader(const bool use_tl_reader, ObMacroBlockReader *&reader);
+  // load the dict from the head of io buffer, which is read from dict_nested_offset_
+  int load_compress_dict(const char *io_buf, const int64_t io_size);
 private:
   int read_block_and_copy(
       const ObMicroBlockHeader &header,
@@ -290,6 +305,9 @@ protected:
   bool use_block_cache_;
   char encrypt_key_[share::OB_MAX_TABLESPACE_ENCRYPT_KEY_LENGTH];
   const ObIArray<share::schema::ObColDesc> *rowkey_col_descs_;
+  ObMicroBlockDictHandle dict_handle_;
+  // nested offset of the sstable whose dict is read along with the micro blocks, -1 if not needed
+  int64_t dict_nested_offset_;
   DISALLOW_COPY_AND_ASSIGN(ObIMicroBlockIOCallback);
 };
 
@@ -396,6 +414,7 @@ public:
       const bool is_major_macro_preread = false);
   virtual int load_block(
       const ObMicroBlockId &micro_block_id,
+      const int64_t nested_offset,
       const ObMicroBlockDesMeta &des_meta,
       const ObLogicMicroBlockId &logic_micro_id,
       const int64_t data_checksum,
@@ -464,6 +483,7 @@ public:
       ObStorageObjectHandle &macro_handle);
   int load_block(
       const ObMicroBlockId &micro_block_id,
+      const int64_t nested_offset,
       const ObMicroBlockDesMeta &des_meta,
       const ObLogicMicroBlockId &logic_micro_id,
       const int64_t data_checksum,
@@ -514,6 +534,7 @@ public:
   int init(const char *cache_name, const int64_t priority = 10);
   int load_block(
       const ObMicroBlockId &micro_block_id,
+      const int64_t nested_offset,
       const ObMicroBlockDesMeta &des_meta,
       const ObLogicMicroBlockId &logic_micro_id,
       const int64_t data_checksum,
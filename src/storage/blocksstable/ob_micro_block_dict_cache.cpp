@@ -0,0 +1,277 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+#include "ob_micro_block_dict_cache.h"
+#include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "lib/stat/ob_diagnose_info.h"
+#include "lib/worker.h"
+#include "share/config/ob_server_config.h"
+#include "share/rc/ob_tenant_base.h"
+#include "storage/blocksstable/ob_macro_block_common_header.h"
+#include "storage/blocksstable/ob_macro_block_reader.h"
+#include "storage/blocksstable/ob_micro_block_header.h"
+#include "storage/blocksstable/ob_object_manager.h"
+#include "storage/blocksstable/ob_sstable_macro_block_header.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace blocksstable
+{
+
+/**
+ * -----------------------------------------ObMicroBlockDictCacheKey-----------------------------------------
+ */
+ObMicroBlockDictCacheKey::ObMicroBlockDictCacheKey(
+    const uint64_t tenant_id,
+    const MacroBlockId &macro_id,
+    const int64_t nested_offset)
+  : tenant_id_(tenant_id), macro_id_(macro_id), nested_offset_(nested_offset)
+{
+}
+
+bool ObMicroBlockDictCacheKey::operator ==(const ObIKVCacheKey &other) const
+{
+  const ObMicroBlockDictCacheKey &other_key = reinterpret_cast<const ObMicroBlockDictCacheKey &>(other);
+  return tenant_id_ == other_key.tenant_id_
+      && macro_id_ == other_key.macro_id_
+      && nested_offset_ == other_key.nested_offset_;
+}
+
+uint64_t ObMicroBlockDictCacheKey::hash() const
+{
+  uint64_t hash_value = murmurhash(&tenant_id_, sizeof(tenant_id_), macro_id_.hash());
+  return murmurhash(&nested_offset_, sizeof(nested_offset_), hash_value);
+}
+
+int ObMicroBlockDictCacheKey::deep_copy(char *buf, const int64_t buf_len, ObIKVCacheKey *&key) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(NULL == buf || buf_len < size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(buf_len));
+  } else if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid dict cache key", K(ret), K(*this));
+  } else {
+    key = new (buf) ObMicroBlockDictCacheKey(tenant_id_, macro_id_, nested_offset_);
+  }
+  return ret;
+}
+
+/**
+ * -----------------------------------------ObMicroBlockDictCacheValue-----------------------------------------
+ */
+ObMicroBlockDictCacheValue::ObMicroBlockDictCacheValue(const char *dict_buf, const int64_t dict_size)
+  : dict_buf_(dict_buf), dict_size_(dict_size)
+{
+}
+
+int ObMicroBlockDictCacheValue::deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(NULL == buf || buf_len < size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(buf), K(buf_len));
+  } else if (OB_ISNULL(dict_buf_) || OB_UNLIKELY(dict_size_ <= 0)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid dict cache value", K(ret), K(*this));
+  } else {
+    char *new_dict_buf = buf + sizeof(ObMicroBlockDictCacheValue);
+    MEMCPY(new_dict_buf, dict_buf_, dict_size_);
+    value = new (buf) ObMicroBlockDictCacheValue(new_dict_buf, dict_size_);
+  }
+  return ret;
+}
+
+/**
+ * -----------------------------------------ObMicroBlockDictCache-----------------------------------------
+ */
+int ObMicroBlockDictCache::get_dict(
+    const uint64_t tenant_id,
+    const MacroBlockId &macro_id,
+    const int64_t nested_offset,
+    ObMicroBlockDictHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(get_cached_dict(tenant_id, macro_id, nested_offset, handle))) {
+    if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != ret)) {
+      LOG_WARN("fail to get cached dict", K(ret), K(tenant_id), K(macro_id), K(nested_offset));
+    } else if (OB_FAIL(load_dict(ObMicroBlockDictCacheKey(tenant_id, macro_id, nested_offset), handle))) {
+      LOG_WARN("fail to load dict", K(ret), K(tenant_id), K(macro_id), K(nested_offset));
+    }
+  }
+  if (OB_FAIL(ret)) {
+    handle.reset();
+  }
+  return ret;
+}
+
+int ObMicroBlockDictCache::get_cached_dict(
+    const uint64_t tenant_id,
+    const MacroBlockId &macro_id,
+    const int64_t nested_offset,
+    ObMicroBlockDictHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockDictCacheKey key(tenant_id, macro_id, nested_offset);
+  handle.reset();
+  if (OB_UNLIKELY(!key.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key));
+  } else if (OB_FAIL(get(key, handle.value_, handle.handle_))) {
+    if (OB_UNLIKELY(OB_ENTRY_NOT_EXIST != ret)) {
+      LOG_WARN("fail to get dict from cache", K(ret), K(key));
+    }
+    handle.reset();
+  }
+  return ret;
+}
+
+int ObMicroBlockDictCache::put_dict(
+    const uint64_t tenant_id,
+    const MacroBlockId &macro_id,
+    const int64_t nested_offset,
+    const char *buf,
+    const int64_t buf_size,
+    ObMicroBlockDictHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  ObMicroBlockDictCacheKey key(tenant_id, macro_id, nested_offset);
+  int64_t required_size = 0;
+  handle.reset();
+  if (OB_UNLIKELY(!key.is_valid() || nullptr == buf || buf_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(key), KP(buf), K(buf_size));
+  } else if (OB_FAIL(parse_and_put_dict(key, buf, buf_size, required_size, handle))) {
+    LOG_WARN("fail to parse and put dict", K(ret), K(key), K(buf_size), K(required_size));
+  }
+  return ret;
+}
+
+int ObMicroBlockDictCache::load_dict(const ObMicroBlockDictCacheKey &key, ObMicroBlockDictHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator allocator(ObMemAttr(key.get_tenant_id(), "MicroBlkDict"));
+  const char *buf = nullptr;
+  int64_t buf_size = 0;
+  int64_t required_size = 0;
+  const MacroBlockId &macro_id = key.get_macro_id();
+  const int64_t nested_offset = key.get_nested_offset();
+  if (OB_FAIL(read_macro_block(macro_id, nested_offset, DICT_PROBE_READ_SIZE, allocator, buf, buf_size))) {
+    LOG_WARN("fail to read macro block", K(ret), K(key));
+  } else if (OB_SUCC(parse_and_put_dict(key, buf, buf_size, required_size, handle))) {
+  } else if (OB_UNLIKELY(OB_BUF_NOT_ENOUGH != ret)) {
+    LOG_WARN("fail to parse and put dict", K(ret), K(key));
+  } else if (OB_FAIL(read_macro_block(macro_id, nested_offset, required_size, allocator, buf, buf_size))) {
+    LOG_WARN("fail to read first micro block", K(ret), K(key), K(required_size));
+  } else if (OB_FAIL(parse_and_put_dict(key, buf, buf_size, required_size, handle))) {
+    LOG_WARN("fail to parse and put dict", K(ret), K(key), K(required_size));
+  }
+  return ret;
+}
+
+int ObMicroBlockDictCache::parse_and_put_dict(
+    const ObMicroBlockDictCacheKey &key,
+    const char *buf,
+    const int64_t buf_size,
+    int64_t &required_size,
+    ObMicroBlockDictHandle &handle)
+{
+  int ret = OB_SUCCESS;
+  int64_t pos = 0;
+  int64_t first_micro_pos = 0;
+  ObMacroBlockCommonHeader common_header;
+  ObSSTableMacroBlockHeader macro_header;
+  ObMicroBlockHeader micro_header;
+  ObMacroBlockReader macro_reader;
+  const char *dict_buf = nullptr;
+  int64_t dict_size = 0;
+  required_size = 0;
+  if (OB_FAIL(common_header.deserialize(buf, buf_size, pos))) {
+    LOG_WARN("fail to deserialize common header", K(ret), K(key));
+  } else if (OB_FAIL(common_header.check_integrity())) {
+    LOG_ERROR("invalid common header", K(ret), K(key), K(common_header));
+  } else if (OB_UNLIKELY(!common_header.is_sstable_data_block())) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("only data macro block has dict", K(ret), K(key), K(common_header));
+  } else if (OB_FAIL(macro_header.deserialize(buf, buf_size, pos))) {
+    LOG_WARN("fail to deserialize macro block header", K(ret), K(key));
+  } else if (FALSE_IT(first_micro_pos = macro_header.fixed_header_.micro_block_data_offset_)) {
+  } else if (FALSE_IT(pos = first_micro_pos)) {
+  } else if (OB_FAIL(micro_header.deserialize(buf, buf_size, pos))) {
+    LOG_WARN("fail to deserialize first micro block header", K(ret), K(key), K(macro_header));
+  } else if (FALSE_IT(required_size = first_micro_pos + micro_header.header_size_ + micro_header.data_zlength_)) {
+  } else if (required_size > buf_size) {
+    ret = OB_BUF_NOT_ENOUGH;
+  } else if (OB_FAIL(macro_reader.get_compress_dict(macro_header, buf + first_micro_pos,
+      buf_size - first_micro_pos, dict_buf, dict_size))) {
+    LOG_WARN("fail to get compress dict", K(ret), K(key), K(macro_header));
+  } else {
+    // dict_buf points into the macro reader, which is deep copied into the cache
+    ObMicroBlockDictCacheValue value(dict_buf, dict_size);
+    if (OB_FAIL(put_and_fetch(key, value, handle.value_, handle.handle_, false/*overwrite*/))) {
+      if (OB_ENTRY_EXIST == ret) {
+        // loaded by another thread concurrently
+        if (OB_FAIL(get(key, handle.value_, handle.handle_))) {
+          LOG_WARN("fail to get dict from cache", K(ret), K(key));
+        }
+      } else {
+        LOG_WARN("fail to put dict into cache", K(ret), K(key), K(value));
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+    handle.reset();
+  }
+  return ret;
+}
+
+int ObMicroBlockDictCache::read_macro_block(
+    const MacroBlockId &macro_id,
+    const int64_t offset,
+    const int64_t read_size,
+    ObIAllocator &allocator,
+    const char *&buf,
+    int64_t &buf_size)
+{
+  int ret = OB_SUCCESS;
+  ObStorageObjectReadInfo read_info;
+  ObStorageObjectHandle macro_handle;
+  const int64_t macro_block_size = OB_STORAGE_OBJECT_MGR.get_macro_block_size();
+  read_info.macro_block_id_ = macro_id;
+  read_info.io_desc_.set_mode(ObIOMode::READ);
+  read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_DATA_READ);
+  read_info.io_desc_.set_resource_group_id(THIS_WORKER.get_group_id());
+  read_info.io_desc_.set_sys_module_id(ObIOModule::MICRO_BLOCK_CACHE_IO);
+  read_info.offset_ = offset;
+  read_info.size_ = MIN(read_size, macro_block_size - offset);
+  read_info.io_timeout_ms_ = GCONF._data_storage_io_timeout / 1000L;
+  read_info.mtl_tenant_id_ = MTL_ID();
+  if (OB_UNLIKELY(offset < 0 || read_info.size_ <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(macro_id), K(offset), K(read_size));
+  } else if (OB_ISNULL(read_info.buf_ = static_cast<char *>(allocator.alloc(read_info.size_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc read buf", K(ret), K(read_info));
+  } else if (OB_FAIL(ObObjectManager::read_object(read_info, macro_handle))) {
+    LOG_WARN("fail to read macro block", K(ret), K(read_info));
+  } else {
+    buf = read_info.buf_;
+    buf_size = macro_handle.get_data_size();
+  }
+  return ret;
+}
+
+} // namespace blocksstable
+} // namespace oceanbase
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_BLOCKSSTABLE_OB_MICRO_BLOCK_DICT_CACHE_H_
+#define OCEANBASE_BLOCKSSTABLE_OB_MICRO_BLOCK_DICT_CACHE_H_
+
+#include "share/cache/ob_kv_storecache.h"
+#include "storage/blocksstable/ob_macro_block_id.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// Compress dictionary of the data macro blocks compressed by ZSTD_1_3_8_DICT_COMPRESSOR,
+// i.e. the raw content of the first micro block of the sstable in the macro block.
+// Small sstables share macro blocks, so the dict is identified by the nested offset of the
+// sstable in the macro block as well.
+class ObMicroBlockDictCacheKey : public common::ObIKVCacheKey
+{
+public:
+  ObMicroBlockDictCacheKey(const uint64_t tenant_id, const MacroBlockId &macro_id, const int64_t nested_offset);
+  virtual ~ObMicroBlockDictCacheKey() = default;
+  virtual bool operator ==(const common::ObIKVCacheKey &other) const override;
+  virtual uint64_t get_tenant_id() const override { return tenant_id_; }
+  virtual uint64_t hash() const override;
+  virtual int64_t size() const override { return sizeof(*this); }
+  virtual int deep_copy(char *buf, const int64_t buf_len, common::ObIKVCacheKey *&key) const override;
+  OB_INLINE const MacroBlockId &get_macro_id() const { return macro_id_; }
+  OB_INLINE int64_t get_nested_offset() const { return nested_offset_; }
+  bool is_valid() const
+  {
+    return common::OB_INVALID_TENANT_ID != tenant_id_ && macro_id_.is_valid() && nested_offset_ >= 0;
+  }
+  TO_STRING_KV(K_(tenant_id), K_(macro_id), K_(nested_offset));
+private:
+  uint64_t tenant_id_;
+  MacroBlockId macro_id_;
+  int64_t nested_offset_;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockDictCacheKey);
+};
+
+class ObMicroBlockDictCacheValue : public common::ObIKVCacheValue
+{
+public:
+  ObMicroBlockDictCacheValue(const char *dict_buf, const int64_t dict_size);
+  virtual ~ObMicroBlockDictCacheValue() = default;
+  virtual int64_t size() const override { return sizeof(*this) + dict_size_; }
+  virtual int deep_copy(char *buf, const int64_t buf_len, common::ObIKVCacheValue *&value) const override;
+  OB_INLINE const char *get_dict_buf() const { return dict_buf_; }
+  OB_INLINE int64_t get_dict_size() const { return dict_size_; }
+  TO_STRING_KV(KP_(dict_buf), K_(dict_size));
+private:
+  const char *dict_buf_;
+  int64_t dict_size_;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockDictCacheValue);
+};
+
+class ObMicroBlockDictHandle
+{
+public:
+  ObMicroBlockDictHandle() : value_(nullptr), handle_() {}
+  ~ObMicroBlockDictHandle() = default;
+  void reset() { value_ = nullptr; handle_.reset(); }
+  OB_INLINE bool is_valid() const { return nullptr != value_ && handle_.is_valid(); }
+  OB_INLINE const char *get_dict_buf() const { return is_valid() ? value_->get_dict_buf() : nullptr; }
+  OB_INLINE int64_t get_dict_size() const { return is_valid() ? value_->get_dict_size() : 0; }
+  TO_STRING_KV(KPC_(value), K_(handle));
+private:
+  friend class ObMicroBlockDictCache;
+  const ObMicroBlockDictCacheValue *value_;
+  common::ObKVCacheHandle handle_;
+};
+
+class ObMicroBlockDictCache : public common::ObKVCache<ObMicroBlockDictCacheKey, ObMicroBlockDictCacheValue>
+{
+public:
+  ObMicroBlockDictCache() = default;
+  virtual ~ObMicroBlockDictCache() = default;
+  // get the dict of the sstable at @nested_offset of @macro_id,
+  // read it from the macro block synchronously if not cached
+  int get_dict(
+      const uint64_t tenant_id,
+      const MacroBlockId &macro_id,
+      const int64_t nested_offset,
+      ObMicroBlockDictHandle &handle);
+  // get the dict without io, return OB_ENTRY_NOT_EXIST if not cached
+  int get_cached_dict(
+      const uint64_t tenant_id,
+      const MacroBlockId &macro_id,
+      const int64_t nested_offset,
+      ObMicroBlockDictHandle &handle);
+  // parse the dict from @buf, which is read from @nested_offset of @macro_id and covers
+  // the first micro block of the sstable, and put it into cache
+  int put_dict(
+      const uint64_t tenant_id,
+      const MacroBlockId &macro_id,
+      const int64_t nested_offset,
+      const char *buf,
+      const int64_t buf_size,
+      ObMicroBlockDictHandle &handle);
+private:
+  int load_dict(const ObMicroBlockDictCacheKey &key, ObMicroBlockDictHandle &handle);
+  // return OB_BUF_NOT_ENOUGH with @required_size if @buf does not cover the first micro block
+  int parse_and_put_dict(
+      const ObMicroBlockDictCacheKey &key,
+      const char *buf,
+      const int64_t buf_size,
+      int64_t &required_size,
+      ObMicroBlockDictHandle &handle);
+  int read_macro_block(
+      const MacroBlockId &macro_id,
+      const int64_t offset,
+      const int64_t read_size,
+      common::ObIAllocator &allocator,
+      const char *&buf,
+      int64_t &buf_size);
+  // enough for the macro block header and the first micro block in most cases
+  static const int64_t DICT_PROBE_READ_SIZE = 64L << 10;
+  DISALLOW_COPY_AND_ASSIGN(ObMicroBlockDictCache);
+};
+
+} // namespace blocksstable
+} // namespace oceanbase
+
+#endif // OCEANBASE_BLOCKSSTABLE_OB_MICRO_BLOCK_DICT_CACHE_H_
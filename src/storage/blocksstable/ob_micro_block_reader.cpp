@@ -261,9 +261,15 @@ int ObMicroBlockGetReader::locate_rowkey(const ObDatumRowkey &rowkey, int64_t &r
     LOG_WARN("faile to locate rowkey by hash index", K(ret));
   } else if (need_binary_search) {
     bool is_equal = false;
-    if (OB_FAIL(ObIMicroBlockFlatReader::find_bound_(rowkey, true/*lower_bound*/, 0, row_count_,
+    int64_t begin_idx = 0;
+    int64_t end_idx = row_count_;
+    bool end_equal = false;
+    if (OB_FAIL(locate_range_by_interpolation(rowkey, begin_idx, end_idx, end_equal))) {
+      LOG_WARN("fail to locate range by interpolation", K(ret), K(rowkey));
+    } else if (OB_FAIL(ObIMicroBlockFlatReader::find_bound_(rowkey, true/*lower_bound*/, begin_idx, end_idx,
         read_info_->get_datum_utils(), row_idx, is_equal))) {
       LOG_WARN("fail to lower_bound rowkey", K(ret));
+    } else if (FALSE_IT(is_equal = (end_idx == row_idx && end_idx < row_count_) ? end_equal : is_equal)) {
     } else if (row_count_ == row_idx || !is_equal) {
       row_idx = ObIMicroBlockReaderInfo::INVALID_ROW_INDEX;
       ret = OB_BEYOND_THE_RANGE;
@@ -327,6 +333,122 @@ int ObMicroBlockGetReader::locate_rowkey_fast_path(const ObDatumRowkey &rowkey,
   return ret;
 }
 
+int ObMicroBlockGetReader::compare_row(const ObDatumRowkey &rowkey, const int64_t row_idx, int32_t &cmp_result)
+{
+  return flat_row_reader_.compare_meta_rowkey(rowkey,
+                                              read_info_->get_datum_utils(),
+                                              data_begin_ + index_data_[row_idx],
+                                              index_data_[row_idx + 1] - index_data_[row_idx],
+                                              cmp_result);
+}
+
+int ObMicroBlockGetReader::get_interpolation_key(
+    const int64_t row_idx,
+    const ObObjTypeClass type_class,
+    int64_t &key,
+    bool &valid)
+{
+  int ret = OB_SUCCESS;
+  ObStorageDatum datum;
+  valid = false;
+  if (OB_FAIL(flat_row_reader_.read_column(data_begin_ + index_data_[row_idx],
+                                           index_data_[row_idx + 1] - index_data_[row_idx],
+                                           0,
+                                           datum))) {
+    LOG_WARN("fail to read first rowkey column", K(ret), K(row_idx));
+  } else if (datum.is_null() || datum.is_ext() || sizeof(int64_t) != datum.len_) {
+  } else {
+    // unsigned values are compared in signed order after flipping the sign bit
+    key = ObUIntTC == type_class ? static_cast<int64_t>(datum.get_uint64() ^ (1ULL << 63)) : datum.get_int();
+    valid = true;
+  }
+  return ret;
+}
+
+int ObMicroBlockGetReader::locate_range_by_interpolation(
+    const ObDatumRowkey &rowkey,
+    int64_t &begin_idx,
+    int64_t &end_idx,
+    bool &end_equal)
+{
+  int ret = OB_SUCCESS;
+  begin_idx = 0;
+  end_idx = row_count_;
+  end_equal = false;
+  const ObObjTypeClass type_class = read_info_->get_columns_desc().count() > 0
+      ? read_info_->get_columns_desc().at(0).col_type_.get_type_class() : ObMaxTC;
+  const ObStorageDatum &search_datum = rowkey.datums_[0];
+  if (row_count_ < INTERPOLATION_SEARCH_MIN_ROW_COUNT || rowkey.get_datum_cnt() <= 0
+      || (ObIntTC != type_class && ObUIntTC != type_class && ObDateTimeTC != type_class)
+      || search_datum.is_null() || search_datum.is_ext() || sizeof(int64_t) != search_datum.len_) {
+    // not monotonic integer rowkey, binary search the whole micro block
+  } else {
+    const int64_t search_key = ObUIntTC == type_class
+        ? static_cast<int64_t>(search_datum.get_uint64() ^ (1ULL << 63)) : search_datum.get_int();
+    int64_t first_key = 0;
+    int64_t last_key = 0;
+    bool first_valid = false;
+    bool last_valid = false;
+    if (OB_FAIL(get_interpolation_key(0, type_class, first_key, first_valid))) {
+      LOG_WARN("fail to get first interpolation key", K(ret));
+    } else if (!first_valid) {
+    } else if (OB_FAIL(get_interpolation_key(row_count_ - 1, type_class, last_key, last_valid))) {
+      LOG_WARN("fail to get last interpolation key", K(ret));
+    } else if (!last_valid || first_key >= last_key || search_key < first_key || search_key > last_key) {
+    } else {
+      // the rows are ordered by rowkey, so the first column is non-decreasing, guess the position
+      // linearly and then gallop from it until the lower bound is bracketed
+      const double ratio = (static_cast<double>(search_key) - static_cast<double>(first_key))
+          / (static_cast<double>(last_key) - static_cast<double>(first_key));
+      const int64_t guess_idx = MIN(row_count_ - 1, MAX(0, static_cast<int64_t>(ratio * (row_count_ - 1))));
+      int32_t cmp_result = 0;
+      int64_t step = 1;
+      if (OB_FAIL(compare_row(rowkey, guess_idx, cmp_result))) {
+        LOG_WARN("fail to compare row", K(ret), K(guess_idx));
+      } else if (cmp_result < 0) {
+        begin_idx = guess_idx + 1;
+        int64_t probe_idx = begin_idx;
+        while (OB_SUCC(ret) && probe_idx < row_count_) {
+          if (OB_FAIL(compare_row(rowkey, probe_idx, cmp_result))) {
+            LOG_WARN("fail to compare row", K(ret), K(probe_idx));
+          } else if (cmp_result >= 0) {
+            end_idx = probe_idx;
+            end_equal = 0 == cmp_result;
+            break;
+          } else {
+            begin_idx = probe_idx + 1;
+            probe_idx += step;
+            step <<= 1;
+          }
+        }
+      } else {
+        end_idx = guess_idx;
+        end_equal = 0 == cmp_result;
+        int64_t probe_idx = guess_idx - step;
+        while (OB_SUCC(ret) && probe_idx >= 0) {
+          if (OB_FAIL(compare_row(rowkey, probe_idx, cmp_result))) {
+            LOG_WARN("fail to compare row", K(ret), K(probe_idx));
+          } else if (cmp_result < 0) {
+            begin_idx = probe_idx + 1;
+            break;
+          } else {
+            end_idx = probe_idx;
+            end_equal = 0 == cmp_result;
+            step <<= 1;
+            probe_idx -= step;
+          }
+        }
+      }
+      if (OB_FAIL(ret)) {
+        begin_idx = 0;
+        end_idx = row_count_;
+        end_equal = false;
+      }
+    }
+  }
+  return ret;
+}
+
 int ObMicroBlockGetReader::get_row(
     const ObMicroBlockData &block_data,
     const ObITableReadInfo &read_info,
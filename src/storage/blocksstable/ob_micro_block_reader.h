@@ -227,7 +227,16 @@ private:
                               int64_t &row_idx,
                               bool &need_binary_search,
                               bool &found);
+  // narrow the range of binary search by interpolating the first rowkey column,
+  // the lower bound of rowkey is in [begin_idx, end_idx]
+  int locate_range_by_interpolation(const ObDatumRowkey &rowkey,
+                                    int64_t &begin_idx,
+                                    int64_t &end_idx,
+                                    bool &end_equal);
+  int get_interpolation_key(const int64_t row_idx, const ObObjTypeClass type_class, int64_t &key, bool &valid);
+  int compare_row(const ObDatumRowkey &rowkey, const int64_t row_idx, int32_t &cmp_result);
 private:
+  static const int64_t INTERPOLATION_SEARCH_MIN_ROW_COUNT = 32;
   ObMicroBlockHashIndex hash_index_;
 };
 
@@ -583,6 +583,7 @@ ObSSTableMeta::ObSSTableMeta()
     cg_sstables_(),
     column_ckm_struct_(),
     tx_ctx_(),
+    column_ndv_sketch_(),
     is_inited_(false)
 {
 }
@@ -616,6 +617,7 @@ void ObSSTableMeta::reset()
   column_ckm_struct_.reset();
   cg_sstables_.reset();
   tx_ctx_.reset();
+  column_ndv_sketch_.reset();
   is_inited_ = false;
 }
 
@@ -668,6 +670,8 @@ int ObSSTableMeta::init_base_meta(
     basic_meta_.length_ = basic_meta_.get_serialize_size();
     if (OB_FAIL(column_ckm_struct_.assign(allocator, param.column_checksums_))) {
       LOG_WARN("fail to prepare column checksum", K(ret), K(param));
+    } else if (OB_FAIL(column_ndv_sketch_.assign(allocator, param.column_ndv_sketch_))) {
+      LOG_WARN("fail to prepare column ndv sketch", K(ret), K(param));
     }
   }
   return ret;
@@ -785,7 +789,8 @@ int ObSSTableMeta::serialize(char *buf, const int64_t buf_len, int64_t &pos) con
   } else {
     int64_t tmp_pos = 0;
     const int64_t len = get_serialize_size_();
-    OB_UNIS_ENCODE(SSTABLE_META_VERSION);
+    const int64_t version = get_meta_version();
+    OB_UNIS_ENCODE(version);
     OB_UNIS_ENCODE(len);
     if (OB_FAIL(ret)) {
     } else if (OB_FAIL(serialize_(buf + pos, buf_len, tmp_pos))) {
@@ -815,6 +820,8 @@ int ObSSTableMeta::serialize_(char *buf, const int64_t buf_len, int64_t &pos) co
     LOG_WARN("fail to serialize cg sstables", K(ret), K(buf_len), K(pos), K(cg_sstables_));
   } else if (OB_FAIL(tx_ctx_.serialize(buf, buf_len, pos))) {
     LOG_WARN("fail to serialize tx ids", K(ret), K(buf_len), K(pos), K(tx_ctx_));
+  } else if (!column_ndv_sketch_.is_empty() && OB_FAIL(column_ndv_sketch_.serialize(buf, buf_len, pos))) {
+    LOG_WARN("fail to serialize column ndv sketch", K(ret), K(buf_len), K(pos), K(column_ndv_sketch_));
   }
   return ret;
 }
@@ -839,10 +846,10 @@ int ObSSTableMeta::deserialize(
     OB_UNIS_DECODE(version);
     OB_UNIS_DECODE(len);
     if (OB_FAIL(ret)) {
-    } else if (OB_UNLIKELY(version != SSTABLE_META_VERSION)) {
+    } else if (OB_UNLIKELY(version != SSTABLE_META_VERSION && version != SSTABLE_META_VERSION_V2)) {
       ret = OB_NOT_SUPPORTED;
       LOG_WARN("object version mismatch", K(ret), K(version));
-    } else if (OB_FAIL(deserialize_(allocator, buf + pos, len, tmp_pos))) {
+    } else if (OB_FAIL(deserialize_(allocator, version, buf + pos, len, tmp_pos))) {
       LOG_WARN("fail to deserialize_", K(ret), K(data_len), K(tmp_pos), K(pos));
     } else if (OB_UNLIKELY(len != tmp_pos)) {
       ret = OB_ERR_UNEXPECTED;
@@ -860,6 +867,7 @@ int ObSSTableMeta::deserialize(
 
 int ObSSTableMeta::deserialize_(
     common::ObArenaAllocator &allocator,
+    const int64_t version,
     const char *buf,
     const int64_t data_len,
     int64_t &pos)
@@ -883,6 +891,8 @@ int ObSSTableMeta::deserialize_(
       LOG_WARN("fail to deserialize cg sstables", K(ret), K(data_len), K(pos));
     } else if (pos < data_len && OB_FAIL(tx_ctx_.deserialize(allocator, buf, data_len, pos))) {
       LOG_WARN("fail to deserialize tx ids", K(ret), K(data_len), K(pos));
+    } else if (SSTABLE_META_VERSION_V2 == version && OB_FAIL(column_ndv_sketch_.deserialize(allocator, buf, data_len, pos))) {
+      LOG_WARN("fail to deserialize column ndv sketch", K(ret), K(data_len), K(pos));
     }
   }
   return ret;
@@ -892,7 +902,8 @@ int64_t ObSSTableMeta::get_serialize_size() const
 {
   int64_t len = 0;
   const int64_t payload_size = get_serialize_size_();
-  OB_UNIS_ADD_LEN(SSTABLE_META_VERSION);
+  const int64_t version = get_meta_version();
+  OB_UNIS_ADD_LEN(version);
   OB_UNIS_ADD_LEN(payload_size);
   len += get_serialize_size_();
   return len;
@@ -907,6 +918,9 @@ int64_t ObSSTableMeta::get_serialize_size_() const
   len += macro_info_.get_serialize_size();
   len += cg_sstables_.get_serialize_size();
   len += tx_ctx_.get_serialize_size();
+  if (!column_ndv_sketch_.is_empty()) {
+    len += column_ndv_sketch_.get_serialize_size();
+  }
   return len;
 }
 
@@ -916,7 +930,8 @@ int64_t ObSSTableMeta::get_variable_size() const
        + data_root_info_.get_variable_size()
        + macro_info_.get_variable_size()
        + cg_sstables_.get_deep_copy_size()
-       + tx_ctx_.get_variable_size();
+       + tx_ctx_.get_variable_size()
+       + column_ndv_sketch_.get_deep_copy_size();
 }
 
 int ObSSTableMeta::deep_copy(
@@ -946,6 +961,8 @@ int ObSSTableMeta::deep_copy(
       LOG_WARN("fail to deep copy cg sstables", K(ret), KP(buf), K(buf_len), K(pos), K(cg_sstables_));
     } else if (OB_FAIL(tx_ctx_.deep_copy(buf, buf_len, pos, dest->tx_ctx_))) {
       LOG_WARN("fail to deep copy tx context", K(ret), K(tx_ctx_));
+    } else if (OB_FAIL(column_ndv_sketch_.deep_copy(buf, buf_len, pos, dest->column_ndv_sketch_))) {
+      LOG_WARN("fail to deep copy column ndv sketch", K(ret), K(column_ndv_sketch_));
     // TODO (jiahua.cjh): add defend code back
     // } else if (deep_size != pos - tmp_pos) {
     //  ret = OB_ERR_UNEXPECTED;
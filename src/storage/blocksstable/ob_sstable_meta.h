@@ -22,6 +22,7 @@
 #include "storage/tablet/ob_table_store_util.h"
 #include "storage/blocksstable/ob_table_flag.h"
 #include "storage/blocksstable/ob_column_checksum_struct.h"
+#include "storage/blocksstable/ob_column_ndv_sketch.h"
 namespace oceanbase
 {
 namespace storage
@@ -219,6 +220,7 @@ public:
   OB_INLINE int64_t *get_col_checksum() const { return column_ckm_struct_.column_checksums_; }
   OB_INLINE int64_t get_tx_id_count() const { return tx_ctx_.get_count(); }
   OB_INLINE int64_t get_tx_ids(const int64_t idx) const { return tx_ctx_.get_tx_id(idx); }
+  OB_INLINE const ObColumnNdvSketch &get_column_ndv_sketch() const { return column_ndv_sketch_; }
   OB_INLINE int64_t get_data_checksum() const { return basic_meta_.data_checksum_; }
   OB_INLINE int64_t get_rowkey_column_count() const { return basic_meta_.rowkey_column_count_; }
   OB_INLINE int64_t get_column_count() const { return basic_meta_.column_cnt_; }
@@ -310,7 +312,7 @@ public:
       int64_t &pos,
       ObSSTableMeta *&dest) const;
   bool is_shared_table() const;
-  TO_STRING_KV(K_(basic_meta), K_(column_ckm_struct), K_(data_root_info), K_(macro_info), K_(cg_sstables), K_(tx_ctx), K_(is_inited));
+  TO_STRING_KV(K_(basic_meta), K_(column_ckm_struct), K_(data_root_info), K_(macro_info), K_(cg_sstables), K_(tx_ctx), K_(column_ndv_sketch), K_(is_inited));
 private:
   bool check_meta() const;
   int init_base_meta(const ObTabletCreateSSTableParam &param, common::ObArenaAllocator &allocator);
@@ -323,13 +325,21 @@ private:
   int serialize_(char *buf, const int64_t buf_len, int64_t &pos) const;
   int deserialize_(
       common::ObArenaAllocator &allocator,
+      const int64_t version,
       const char *buf,
       const int64_t data_len,
       int64_t &pos);
   int64_t get_serialize_size_() const;
+  // V2 is only written when the meta carries a column ndv sketch, so metas without it
+  // keep the V1 format and stay readable by older observers
+  OB_INLINE int64_t get_meta_version() const
+  {
+    return column_ndv_sketch_.is_empty() ? SSTABLE_META_VERSION : SSTABLE_META_VERSION_V2;
+  }
 private:
   friend class ObSSTable;
   static const int64_t SSTABLE_META_VERSION = 1;
+  static const int64_t SSTABLE_META_VERSION_V2 = 2; // with column ndv sketch
 private:
   ObSSTableBasicMeta basic_meta_;
   ObRootBlockInfo data_root_info_;
@@ -337,6 +347,7 @@ private:
   ObSSTableArray cg_sstables_;
   ObColumnCkmStruct column_ckm_struct_;
   ObTxContext tx_ctx_;
+  ObColumnNdvSketch column_ndv_sketch_;
   // The following fields don't to persist
   bool is_inited_;
   DISALLOW_COPY_AND_ASSIGN(ObSSTableMeta);
@@ -26,6 +26,7 @@ ObStorageCacheSuite::ObStorageCacheSuite()
     fuse_row_cache_(),
     storage_meta_cache_(),
     multi_version_fuse_row_cache_(),
+    micro_block_dict_cache_(),
     is_inited_(false)
 {
 }
@@ -70,6 +71,8 @@ int ObStorageCacheSuite::init(
     STORAGE_LOG(ERROR, "fail to init storage meta cache", K(ret), K(storage_meta_cache_priority));
   } else if (OB_FAIL(multi_version_fuse_row_cache_.init("multi_version_fuse_row_cache", fuse_row_cache_priority))) {
     STORAGE_LOG(ERROR, "fail to init multi version fuse row cache", K(ret));
+  } else if (OB_FAIL(micro_block_dict_cache_.init("micro_block_dict_cache", user_block_cache_priority))) {
+    STORAGE_LOG(ERROR, "fail to init micro block dict cache", K(ret));
   } else {
     is_inited_ = true;
   }
@@ -107,6 +110,8 @@ int ObStorageCacheSuite::reset_priority(
     STORAGE_LOG(ERROR, "fail to set priority for storage cache", K(ret), K(storage_meta_cache_priority));
   } else if (OB_FAIL(multi_version_fuse_row_cache_.set_priority(fuse_row_cache_priority))) {
     STORAGE_LOG(ERROR, "fail to set priority for multi version fuse row cache", K(ret));
+  } else if (OB_FAIL(micro_block_dict_cache_.set_priority(user_block_cache_priority))) {
+    STORAGE_LOG(ERROR, "fail to set priority for micro block dict cache", K(ret));
   }
   return ret;
 }
@@ -129,6 +134,7 @@ void ObStorageCacheSuite::destroy()
   fuse_row_cache_.destroy();
   storage_meta_cache_.destory();
   multi_version_fuse_row_cache_.destroy();
+  micro_block_dict_cache_.destroy();
   is_inited_ = false;
 }
 
@@ -16,6 +16,7 @@
 #include "storage/meta_mem/ob_storage_meta_cache.h"
 #include "share/schema/ob_table_schema.h"
 #include "ob_micro_block_cache.h"
+#include "ob_micro_block_dict_cache.h"
 #include "ob_row_cache.h"
 #include "ob_fuse_row_cache.h"
 #include "ob_bloom_filter_cache.h"
@@ -56,6 +57,7 @@ public:
   ObFuseRowCache &get_fuse_row_cache() { return fuse_row_cache_; }
   ObMultiVersionFuseRowCache &get_multi_version_fuse_row_cache() { return multi_version_fuse_row_cache_; }
   ObStorageMetaCache &get_storage_meta_cache() { return storage_meta_cache_; }
+  ObMicroBlockDictCache &get_micro_block_dict_cache() { return micro_block_dict_cache_; }
   void destroy();
   inline bool is_inited() const { return is_inited_; }
   TO_STRING_KV(K(is_inited_));
@@ -69,6 +71,7 @@ private:
   ObFuseRowCache fuse_row_cache_;
   ObStorageMetaCache storage_meta_cache_;
   ObMultiVersionFuseRowCache multi_version_fuse_row_cache_;
+  ObMicroBlockDictCache micro_block_dict_cache_;
   bool is_inited_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObStorageCacheSuite);
@@ -947,18 +947,20 @@ int ObCOSSTableRowScanner::get_next_group_size(const ObCSRowId begin, int64_t &g
 {
   int ret = OB_SUCCESS;
   group_size = 0;
+  // the rows filter widens its window for selective filters
+  const int64_t filter_window_size = nullptr == rows_filter_ ? batch_size_ : rows_filter_->get_filter_window_size();
   if (reverse_scan_) {
     if (begin < end_) {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("Unexpected rowid", K(begin), K(end_));
     } else {
-      group_size = MIN(batch_size_, begin - end_ + 1);
+      group_size = MIN(filter_window_size, begin - end_ + 1);
     }
   } else if (begin > end_) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("Unexpected rowid", K(begin), K(end_));
   } else {
-    group_size = MIN(batch_size_, end_ - begin + 1);
+    group_size = MIN(filter_window_size, end_ - begin + 1);
   }
   return ret;
 }
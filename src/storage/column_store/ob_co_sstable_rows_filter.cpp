@@ -30,6 +30,7 @@ ObCOSSTableRowsFilter::ObCOSSTableRowsFilter()
     subtree_filter_iter_to_locate_(0),
     subtree_filter_iter_to_filter_(0),
     batch_size_(1),
+    filter_window_size_(1),
     iter_param_(nullptr),
     access_ctx_(nullptr),
     co_sstable_(nullptr),
@@ -72,6 +73,7 @@ int ObCOSSTableRowsFilter::init(
     iter_param_ = &param;
     allocator_ = context.stmt_allocator_;
     batch_size_ = param.get_storage_rowsets_size();
+    filter_window_size_ = batch_size_;
     if (nullptr != param.pushdown_filter_ && OB_FAIL(rewrite_filter(depth))) {
       LOG_WARN("Failed rewriter filter", K(ret), KPC(block_row_store), KPC_(filter));
     } else if (nullptr != context.sample_filter_
@@ -145,6 +147,7 @@ int ObCOSSTableRowsFilter::switch_context(
     iter_param_ = &param;
     access_ctx_ = &context;
     batch_size_ = param.get_storage_rowsets_size();
+    filter_window_size_ = batch_size_;
     common::ObSEArray<ObTableIterParam*, 8> iter_params;
     for (int64_t i = 0; i < iter_filter_node_.count(); i++) {
       sql::ObPushdownFilterExecutor *filter = iter_filter_node_.at(i);
@@ -171,6 +174,7 @@ void ObCOSSTableRowsFilter::reset()
   subtree_filter_iter_to_locate_ = 0;
   subtree_filter_iter_to_filter_ = 0;
   batch_size_ = 1;
+  filter_window_size_ = 1;
   iter_param_ = nullptr;
   access_ctx_ = nullptr;
   co_sstable_ = nullptr;
@@ -766,9 +770,27 @@ int ObCOSSTableRowsFilter::assign_common_col_groups(
   return ret;
 }
 
+// Late materialization: while the filter is selective, widen the window filtered at once so
+// that the project column groups are located over a large range with a sparse bitmap, and the
+// micro blocks without any surviving row are skipped by the prefetcher of the project iter.
 void ObCOSSTableRowsFilter::adjust_batch_size()
 {
-  // TODO(hanling): Optimize in the future.
+  const ObCGBitmap *result_bitmap = bitmap_buffer_.count() > 0 ? bitmap_buffer_[0] : nullptr;
+  const int64_t row_count = nullptr == result_bitmap ? 0 : result_bitmap->size();
+  // upper bound of the window, a rowsets size configured beyond the cap wins so that
+  // a widened window is never smaller than one batch
+  const int64_t max_window_size = MAX(MAX_FILTER_WINDOW_SIZE, static_cast<int64_t>(batch_size_));
+  if (OB_ISNULL(result_bitmap) || OB_ISNULL(access_ctx_)) {
+    filter_window_size_ = batch_size_;
+  } else if (nullptr != access_ctx_->limit_param_) {
+    // rows after limit would be filtered in vain
+  } else if (row_count < filter_window_size_) {
+    // tail of the scan range, says nothing about the selectivity
+  } else if (static_cast<int64_t>(result_bitmap->popcnt()) * SELECTIVE_FILTER_RATIO <= row_count) {
+    filter_window_size_ = MIN(filter_window_size_ * 2, max_window_size);
+  } else {
+    filter_window_size_ = batch_size_;
+  }
 }
 
 OB_INLINE ObCGBitmap* ObCOSSTableRowsFilter::get_child_bitmap(uint32_t depth)
@@ -31,6 +31,9 @@ class ObCOSSTableRowsFilter
 {
 public:
   static constexpr uint32_t MAX_NUM_OF_CG_ITER_TO_LOCATE_IN_ADVANCE = 2;
+  // the filter window grows while no more than 1/SELECTIVE_FILTER_RATIO rows survive
+  static constexpr int64_t SELECTIVE_FILTER_RATIO = 8;
+  static constexpr int64_t MAX_FILTER_WINDOW_SIZE = 64 * 1024;
   static constexpr uint8_t filter_tree_merge_status[sql::ObCommonFilterTreeStatus::MAX_STATUS][sql::ObCommonFilterTreeStatus::MAX_STATUS] =
   { {0, 0, 0, 0}, \
     {0, 1, 0, 0}, \
@@ -65,7 +68,8 @@ public:
       const bool col_cnt_changed,
       ObICGIterator *&cg_iter);
   inline bool can_continuous_filter() const { return can_continuous_filter_; }
-  TO_STRING_KV(K_(is_inited), K_(subtree_filter_iter_to_locate), K_(batch_size),
+  OB_INLINE int64_t get_filter_window_size() const { return filter_window_size_; }
+  TO_STRING_KV(K_(is_inited), K_(subtree_filter_iter_to_locate), K_(batch_size), K_(filter_window_size),
       KPC_(iter_param), KP_(access_ctx), KP_(co_sstable), K_(filter), K_(filter_iters),
       K_(iter_filter_node), K_(bitmap_buffer), K_(pd_filter_info));
 
@@ -133,6 +137,7 @@ private:
   uint32_t subtree_filter_iter_to_locate_;
   uint32_t subtree_filter_iter_to_filter_;
   uint32_t batch_size_;
+  int64_t filter_window_size_;
   const ObTableIterParam *iter_param_;  // row store iter param
   ObTableAccessContext* access_ctx_;
   ObCOSSTableV2* co_sstable_;
@@ -282,6 +282,9 @@ int ObStaticMergeParam::cal_major_merge_param(
       // ATTENTION! Critical diagnostic log, DO NOT CHANGE!!!
       LOG_INFO("set merge_level to MACRO_BLOCK_MERGE_LEVEL", K_(is_schema_changed), K(force_full_merge),
         K(is_full_merge_), K(full_stored_col_cnt), K(sstable_meta_hdl.get_sstable_meta().get_column_count()));
+    } else if (ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR == schema_->get_compressor_type()) {
+      // micro blocks compressed with dict can not be reused in another macro block
+      merge_level_ = MACRO_BLOCK_MERGE_LEVEL;
     }
   }
   return ret;
@@ -302,7 +305,8 @@ ObMergeLevel ObStaticMergeParam::get_merge_level_for_sstable(
 {
   ObMergeLevel ret_merge_level = merge_level_;
   if (!is_full_merge_ && data_version_ >= DATA_VERSION_4_3_3_0) { // expect full merge
-    if (MACRO_BLOCK_MERGE_LEVEL == ret_merge_level && sstable.is_cg_sstable()) {
+    if (MACRO_BLOCK_MERGE_LEVEL == ret_merge_level && sstable.is_cg_sstable()
+        && (nullptr == schema_ || ObCompressorType::ZSTD_1_3_8_DICT_COMPRESSOR != schema_->get_compressor_type())) {
       ret_merge_level = MICRO_BLOCK_MERGE_LEVEL;
       LOG_INFO("for cg sstable, ignore macro merge level when progressive", K(sstable), K(ret_merge_level));
 #ifdef ERRSIM
@@ -26,7 +26,8 @@ using namespace oceanbase::share::schema;
 
 ObColumnChecksumCalculator::ObColumnChecksumCalculator()
   : is_inited_(false), allocator_(ObModIds::OB_SSTABLE_CHECKSUM_CALCULATOR),
-    column_checksum_(NULL), column_cnt_(0)
+    column_checksum_(NULL), column_cnt_(0), crc_bufs_(NULL), crc_lens_(NULL), crc_values_(NULL),
+    crc_col_idxs_(NULL)
 {
 }
 
@@ -41,6 +42,10 @@ int ObColumnChecksumCalculator::init(const int64_t column_cnt)
   if (is_inited_) {
     column_cnt_ = 0;
     column_checksum_ = NULL;
+    crc_bufs_ = NULL;
+    crc_lens_ = NULL;
+    crc_values_ = NULL;
+    crc_col_idxs_ = NULL;
     is_inited_ = false;
     allocator_.reuse();
   }
@@ -51,6 +56,12 @@ int ObColumnChecksumCalculator::init(const int64_t column_cnt)
   } else if (OB_ISNULL(column_checksum_ = static_cast<int64_t *>(allocator_.alloc(column_cnt * sizeof(int64_t))))) {
     ret = OB_ALLOCATE_MEMORY_FAILED;
     LOG_WARN("fail to allocate memory for column checksum", K(ret), K(column_cnt));
+  } else if (OB_ISNULL(crc_bufs_ = static_cast<const char **>(allocator_.alloc(column_cnt * sizeof(char *))))
+      || OB_ISNULL(crc_lens_ = static_cast<int64_t *>(allocator_.alloc(column_cnt * sizeof(int64_t))))
+      || OB_ISNULL(crc_values_ = static_cast<uint64_t *>(allocator_.alloc(column_cnt * sizeof(uint64_t))))
+      || OB_ISNULL(crc_col_idxs_ = static_cast<int64_t *>(allocator_.alloc(column_cnt * sizeof(int64_t))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate memory for batch crc", K(ret), K(column_cnt));
   } else {
     column_cnt_ = column_cnt;
     MEMSET(column_checksum_, 0, column_cnt * sizeof(int64_t));
@@ -129,17 +140,32 @@ int ObColumnChecksumCalculator::calc_column_checksum(
     STORAGE_LOG(WARN, "row was invalid", K(ret), KP(column_checksum), K(new_row), K_(row.count),
          K_(column_cnt), KP(column_changed), K(row.is_valid()), K(row));
   } else {
-    int64_t tmp_checksum = 0;
+    // same as ObDatum::checksum(0) of every column, but the crc of the columns are calculated in batch
+    int64_t crc_cnt = 0;
     for (int64_t i = 0; i < row.count_; ++i) {
       const share::schema::ObColDesc &col_desc = col_descs.at(i);
       if ((NULL != column_changed && !column_changed[i]) || col_desc.col_type_.is_lob_storage()) {
         continue;
       }
-      tmp_checksum = row.storage_datums_[i].checksum(0);
+      crc_bufs_[crc_cnt] = reinterpret_cast<const char *>(&row.storage_datums_[i].pack_);
+      crc_lens_[crc_cnt] = sizeof(row.storage_datums_[i].pack_);
+      crc_values_[crc_cnt] = 0;
+      crc_col_idxs_[crc_cnt] = i;
+      ++crc_cnt;
+    }
+    ob_crc64_sse42_batch(crc_cnt, crc_bufs_, crc_lens_, crc_values_);
+    for (int64_t i = 0; i < crc_cnt; ++i) {
+      const ObStorageDatum &datum = row.storage_datums_[crc_col_idxs_[i]];
+      crc_bufs_[i] = datum.ptr_;
+      crc_lens_[i] = datum.len_;
+    }
+    ob_crc64_sse42_batch(crc_cnt, crc_bufs_, crc_lens_, crc_values_);
+    for (int64_t i = 0; i < crc_cnt; ++i) {
+      const int64_t tmp_checksum = static_cast<int64_t>(crc_values_[i]);
       if (new_row) {
-        column_checksum[i] += tmp_checksum;
+        column_checksum[crc_col_idxs_[i]] += tmp_checksum;
       } else {
-        column_checksum[i] -= tmp_checksum;
+        column_checksum[crc_col_idxs_[i]] -= tmp_checksum;
       }
     }
   }
@@ -50,6 +50,11 @@ private:
   common::ObArenaAllocator allocator_;
   int64_t *column_checksum_;
   int64_t column_cnt_;
+  // buffers of ob_crc64_sse42_batch for one row
+  const char **crc_bufs_;
+  int64_t *crc_lens_;
+  uint64_t *crc_values_;
+  int64_t *crc_col_idxs_;
 };
 
 class ObColumnChecksumAccumulator
@@ -0,0 +1,239 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_column_ndv_sketch_calculator.h"
+#include "share/datum/ob_datum_funcs.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::blocksstable;
+using namespace oceanbase::compaction;
+using namespace oceanbase::share::schema;
+
+ObColumnNdvSketchCalculator::ObColumnNdvSketchCalculator()
+  : is_inited_(false), allocator_("NdvSketchCalc"), sketch_(),
+    col_idxs_(NULL), hash_funcs_(NULL), column_valid_(NULL)
+{
+}
+
+ObColumnNdvSketchCalculator::~ObColumnNdvSketchCalculator()
+{
+  reset();
+}
+
+void ObColumnNdvSketchCalculator::reset()
+{
+  is_inited_ = false;
+  sketch_.reset();
+  col_idxs_ = NULL;
+  hash_funcs_ = NULL;
+  column_valid_ = NULL;
+  allocator_.reset();
+}
+
+int ObColumnNdvSketchCalculator::init(const ObIArray<ObColDesc> &col_descs)
+{
+  int ret = OB_SUCCESS;
+  int64_t sketch_col_cnt = 0;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("ObColumnNdvSketchCalculator has been inited twice", K(ret));
+  } else {
+    // the registers take 1KB per column, only the leading columns are collected on wide tables
+    for (int64_t i = 0; i < col_descs.count() && sketch_col_cnt < ObColumnNdvSketch::MAX_COLUMN_CNT; ++i) {
+      const ObColDesc &col_desc = col_descs.at(i);
+      // multi version columns and lob columns are not collected
+      if (OB_HIDDEN_TRANS_VERSION_COLUMN_ID != col_desc.col_id_
+          && OB_HIDDEN_SQL_SEQUENCE_COLUMN_ID != col_desc.col_id_
+          && !col_desc.col_type_.is_lob_storage()) {
+        ++sketch_col_cnt;
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_UNLIKELY(0 == sketch_col_cnt)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("no column need ndv sketch", K(ret), K(col_descs));
+  } else if (OB_FAIL(sketch_.reserve(allocator_, sketch_col_cnt))) {
+    LOG_WARN("fail to reserve ndv sketch", K(ret), K(sketch_col_cnt));
+  } else if (OB_ISNULL(col_idxs_ = static_cast<int64_t *>(allocator_.alloc(sizeof(int64_t) * sketch_col_cnt)))
+      || OB_ISNULL(hash_funcs_ = static_cast<sql::ObExprHashFuncType *>(
+          allocator_.alloc(sizeof(sql::ObExprHashFuncType) * sketch_col_cnt)))
+      || OB_ISNULL(column_valid_ = static_cast<bool *>(allocator_.alloc(sizeof(bool) * sketch_col_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to allocate memory", K(ret), K(sketch_col_cnt));
+  } else {
+    int64_t idx = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < col_descs.count() && idx < sketch_col_cnt; ++i) {
+      const ObColDesc &col_desc = col_descs.at(i);
+      if (OB_HIDDEN_TRANS_VERSION_COLUMN_ID == col_desc.col_id_
+          || OB_HIDDEN_SQL_SEQUENCE_COLUMN_ID == col_desc.col_id_
+          || col_desc.col_type_.is_lob_storage()) {
+        continue;
+      }
+      // same hash function as the synopsis of APPROX_COUNT_DISTINCT gathered by DBMS_STATS
+      sql::ObExprBasicFuncs *basic_funcs = ObDatumFuncs::get_basic_func(
+          col_desc.col_type_.get_type(), col_desc.col_type_.get_collation_type(),
+          col_desc.col_type_.get_scale(), lib::is_oracle_mode(), col_desc.col_type_.has_lob_header(),
+          col_desc.col_type_.is_decimal_int() ? col_desc.col_type_.get_stored_precision() : PRECISION_UNKNOWN_YET);
+      if (OB_ISNULL(basic_funcs) || OB_ISNULL(basic_funcs->murmur_hash_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("unexpected null basic funcs", K(ret), K(col_desc));
+      } else {
+        sketch_.column_ids_[idx] = col_desc.col_id_;
+        col_idxs_[idx] = i;
+        hash_funcs_[idx] = basic_funcs->murmur_hash_;
+        column_valid_[idx] = true;
+        ++idx;
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+    reset();
+  } else {
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int ObColumnNdvSketchCalculator::add_row(const ObDatumRow &row)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("ObColumnNdvSketchCalculator has not been inited", K(ret));
+  } else {
+    uint64_t hash = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < sketch_.count_; ++i) {
+      if (OB_UNLIKELY(col_idxs_[i] >= row.count_)) {
+        ret = OB_INVALID_ARGUMENT;
+        LOG_WARN("column count of row is not match", K(ret), K(i), K(col_idxs_[i]), K(row));
+      } else {
+        const ObStorageDatum &datum = row.storage_datums_[col_idxs_[i]];
+        if (datum.is_null() || datum.is_nop()) {
+        } else if (OB_FAIL(hash_funcs_[i](datum, 0, hash))) {
+          LOG_WARN("fail to calc hash", K(ret), K(i), K(datum));
+        } else {
+          ObColumnNdvSketch::add_hash(sketch_.get_registers(i), hash);
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObColumnNdvSketchCalculator::add_base_sketch(const ObColumnNdvSketch &base_sketch)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("ObColumnNdvSketchCalculator has not been inited", K(ret));
+  } else if (OB_UNLIKELY(!base_sketch.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(base_sketch));
+  } else {
+    for (int64_t i = 0; i < sketch_.count_; ++i) {
+      const int64_t base_idx = base_sketch.find_column(sketch_.column_ids_[i]);
+      if (base_idx < 0) {
+        // column added after the base sstable was built, the values in reused blocks are unknown
+        column_valid_[i] = false;
+      } else {
+        ObColumnNdvSketch::merge_registers(sketch_.get_registers(i), base_sketch.get_registers(base_idx));
+      }
+    }
+  }
+  return ret;
+}
+
+ObColumnNdvSketchAccumulator::ObColumnNdvSketchAccumulator()
+  : allocator_("NdvSketchAcc"), sketch_(), column_valid_(NULL), task_cnt_(0), lock_()
+{
+}
+
+ObColumnNdvSketchAccumulator::~ObColumnNdvSketchAccumulator()
+{
+  reset();
+}
+
+void ObColumnNdvSketchAccumulator::reset()
+{
+  sketch_.reset();
+  column_valid_ = NULL;
+  task_cnt_ = 0;
+  allocator_.reset();
+}
+
+int ObColumnNdvSketchAccumulator::add_task_sketch(const ObColumnNdvSketchCalculator &calculator)
+{
+  int ret = OB_SUCCESS;
+  const ObColumnNdvSketch &task_sketch = calculator.get_sketch();
+  if (OB_UNLIKELY(!calculator.is_inited())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(calculator));
+  } else {
+    lib::ObMutexGuard guard(lock_);
+    if (sketch_.is_empty()) {
+      if (OB_FAIL(sketch_.reserve(allocator_, task_sketch.count_))) {
+        LOG_WARN("fail to reserve ndv sketch", K(ret), K(task_sketch));
+      } else if (OB_ISNULL(column_valid_ = static_cast<bool *>(allocator_.alloc(sizeof(bool) * task_sketch.count_)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to allocate memory", K(ret), K(task_sketch));
+      } else {
+        MEMCPY(sketch_.column_ids_, task_sketch.column_ids_, sizeof(uint64_t) * task_sketch.count_);
+        for (int64_t i = 0; i < task_sketch.count_; ++i) {
+          column_valid_[i] = true;
+        }
+      }
+    } else if (OB_UNLIKELY(sketch_.count_ != task_sketch.count_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("column count of task sketch is not match", K(ret), K_(sketch), K(task_sketch));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < sketch_.count_; ++i) {
+      ObColumnNdvSketch::merge_registers(sketch_.get_registers(i), task_sketch.get_registers(i));
+      column_valid_[i] = column_valid_[i] && calculator.get_column_valid()[i];
+    }
+    if (OB_SUCC(ret)) {
+      ++task_cnt_;
+    }
+  }
+  return ret;
+}
+
+int ObColumnNdvSketchAccumulator::get_sketch(
+    ObArenaAllocator &allocator,
+    ObColumnNdvSketch &sketch)
+{
+  int ret = OB_SUCCESS;
+  lib::ObMutexGuard guard(lock_);
+  int64_t valid_cnt = 0;
+  sketch.reset();
+  for (int64_t i = 0; i < sketch_.count_; ++i) {
+    if (column_valid_[i]) {
+      ++valid_cnt;
+    }
+  }
+  if (0 == valid_cnt) {
+  } else if (OB_FAIL(sketch.reserve(allocator, valid_cnt))) {
+    LOG_WARN("fail to reserve ndv sketch", K(ret), K(valid_cnt));
+  } else {
+    int64_t idx = 0;
+    for (int64_t i = 0; i < sketch_.count_; ++i) {
+      if (column_valid_[i]) {
+        sketch.column_ids_[idx] = sketch_.column_ids_[i];
+        MEMCPY(sketch.get_registers(idx), sketch_.get_registers(i), ObColumnNdvSketch::NUM_REGISTERS);
+        ++idx;
+      }
+    }
+  }
+  return ret;
+}
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_COMPACTION_OB_COLUMN_NDV_SKETCH_CALCULATOR_H_
+#define OCEANBASE_COMPACTION_OB_COLUMN_NDV_SKETCH_CALCULATOR_H_
+
+#include "storage/ob_i_store.h"
+#include "storage/blocksstable/ob_column_ndv_sketch.h"
+#include "sql/engine/expr/ob_expr.h"
+
+namespace oceanbase
+{
+namespace compaction
+{
+
+// Builds the ndv sketch of the rows output by one merge task.
+class ObColumnNdvSketchCalculator
+{
+public:
+  ObColumnNdvSketchCalculator();
+  virtual ~ObColumnNdvSketchCalculator();
+  int init(const ObIArray<share::schema::ObColDesc> &col_descs);
+  void reset();
+  bool is_inited() const { return is_inited_; }
+  int add_row(const blocksstable::ObDatumRow &row);
+  // rows of the reused macro/micro blocks are not visited, take the sketch of the base sstable instead
+  int add_base_sketch(const blocksstable::ObColumnNdvSketch &base_sketch);
+  const blocksstable::ObColumnNdvSketch &get_sketch() const { return sketch_; }
+  const bool *get_column_valid() const { return column_valid_; }
+  TO_STRING_KV(K_(is_inited), K_(sketch));
+private:
+  bool is_inited_;
+  common::ObArenaAllocator allocator_;
+  blocksstable::ObColumnNdvSketch sketch_;
+  int64_t *col_idxs_;
+  sql::ObExprHashFuncType *hash_funcs_;
+  bool *column_valid_;
+};
+
+class ObColumnNdvSketchAccumulator
+{
+public:
+  ObColumnNdvSketchAccumulator();
+  virtual ~ObColumnNdvSketchAccumulator();
+  void reset();
+  int add_task_sketch(const ObColumnNdvSketchCalculator &calculator);
+  int64_t get_task_count() const { return task_cnt_; }
+  // only columns that are valid in all tasks are output
+  int get_sketch(
+      common::ObArenaAllocator &allocator,
+      blocksstable::ObColumnNdvSketch &sketch);
+private:
+  common::ObArenaAllocator allocator_;
+  blocksstable::ObColumnNdvSketch sketch_;
+  bool *column_valid_;
+  int64_t task_cnt_;
+  lib::ObMutex lock_;
+};
+
+}  // end namespace compaction
+}  // end namespace oceanbase
+
+#endif  // OCEANBASE_COMPACTION_OB_COLUMN_NDV_SKETCH_CALCULATOR_H_
@@ -23,6 +23,7 @@
 #include "storage/blocksstable/ob_sstable_private_object_cleaner.h"
 #include "storage/tablet/ob_tablet.h"
 #include "storage/column_store/ob_column_oriented_sstable.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase
 {
@@ -169,7 +170,9 @@ ObPartitionMerger::ObPartitionMerger(
     minimum_iters_(DEFAULT_ITER_ARRAY_SIZE, ModulePageAllocator(allocator)),
     progressive_merge_helper_(),
     filter_statistics_(),
-    validator_(nullptr)
+    validator_(nullptr),
+    ndv_sketch_calc_(),
+    reused_base_block_(false)
 {
 }
 
@@ -189,6 +192,8 @@ void ObPartitionMerger::reset()
     macro_writer_ = nullptr;
   }
   progressive_merge_helper_.reset();
+  ndv_sketch_calc_.reset();
+  reused_base_block_ = false;
   ObMerger::reset();
   if (OB_NOT_NULL(validator_)) {
     validator_->~ObIMacroBlockValidator();
@@ -286,12 +291,41 @@ int ObPartitionMerger::inner_open_macro_writer(
 int ObPartitionMerger::close()
 {
   int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
   if (OB_FAIL(macro_writer_->close())) {
     STORAGE_LOG(WARN, "Failed to close macro block writer", K(ret));
   } else if (OB_FAIL(merge_ctx_->update_block_info(
     macro_writer_->get_merge_block_info(),
     ObTimeUtility::fast_current_time() - start_time_))) {
     STORAGE_LOG(WARN, "Failed to add macro blocks", K(ret));
+  } else if (ndv_sketch_calc_.is_inited() && OB_TMP_FAIL(close_ndv_sketch())) {
+    // the ndv sketch is only for statistics, the tablet goes without it if any task fails
+    STORAGE_LOG(WARN, "Failed to close ndv sketch, drop it", K(tmp_ret), K_(task_idx));
+    ndv_sketch_calc_.reset();
+  }
+  return ret;
+}
+
+int ObPartitionMerger::close_ndv_sketch()
+{
+  int ret = OB_SUCCESS;
+  if (reused_base_block_) {
+    // rows in reused blocks are not iterated, so take the sketch of base sstable,
+    // values deleted from these blocks may still be counted
+    const ObSSTable *base_sstable = static_cast<const ObSSTable *>(merge_ctx_->get_tables_handle().get_table(0));
+    ObSSTableMetaHandle meta_handle;
+    if (OB_ISNULL(base_sstable)) {
+      ret = OB_ERR_UNEXPECTED;
+      STORAGE_LOG(WARN, "base sstable is null", K(ret));
+    } else if (OB_FAIL(base_sstable->get_meta(meta_handle))) {
+      STORAGE_LOG(WARN, "failed to get base sstable meta", K(ret), KPC(base_sstable));
+    } else if (OB_FAIL(ndv_sketch_calc_.add_base_sketch(meta_handle.get_sstable_meta().get_column_ndv_sketch()))) {
+      STORAGE_LOG(WARN, "failed to add base ndv sketch", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(static_cast<ObTabletMergeCtx *>(merge_ctx_)->get_merge_info().add_column_ndv_sketch(ndv_sketch_calc_))) {
+    STORAGE_LOG(WARN, "failed to add task ndv sketch", K(ret), K_(task_idx));
   }
   return ret;
 }
@@ -333,6 +367,7 @@ int ObPartitionMerger::process(
   } else if (OB_FAIL(macro_writer_->append_macro_block(macro_desc, micro_block_data))) {
     LOG_WARN("Failed to append to macro block writer", K(ret));
   } else {
+    reused_base_block_ = true;
     LOG_DEBUG("Success to append macro block", K(ret), K(macro_desc));
   }
   return ret;
@@ -350,6 +385,7 @@ int ObPartitionMerger::process(const ObMicroBlock &micro_block)
   } else if (OB_FAIL(macro_writer_->append_micro_block(micro_block, macro_desc))) {
     STORAGE_LOG(WARN, "Failed to append micro block to macro block writer", K(ret), K(micro_block));
   } else {
+    reused_base_block_ = true;
     LOG_DEBUG("append micro block", K(ret), K(micro_block));
   }
 
@@ -510,12 +546,31 @@ int ObPartitionMajorMerger::inner_init()
       STORAGE_LOG(WARN, "Failed to allocate memory for partition helper", K(ret));
     } else if (OB_FAIL(merge_helper_->init(merge_param_))) {
       STORAGE_LOG(WARN, "Failed to init merge helper", K(ret));
+    } else if (OB_FAIL(init_ndv_sketch_calc())) {
+      STORAGE_LOG(WARN, "Failed to init ndv sketch calculator", K(ret));
     }
   }
 
   return ret;
 }
 
+int ObPartitionMajorMerger::init_ndv_sketch_calc()
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+  // only row store major sstable of user table is supported
+  if (!tenant_config.is_valid() || !tenant_config->_enable_column_ndv_sketch) {
+  } else if (merge_param_.static_param_.data_version_ < DATA_VERSION_4_3_5_0) {
+    // sstable meta with ndv sketch can not be read by older observer
+  } else if (!data_store_desc_.is_major_merge_type() || !data_store_desc_.get_tablet_id().is_user_tablet()) {
+  } else if (OB_TMP_FAIL(ndv_sketch_calc_.init(data_store_desc_.get_col_desc_array()))) {
+    // the merge goes on without the ndv sketch
+    STORAGE_LOG(WARN, "Failed to init ndv sketch calculator", K(tmp_ret), K_(data_store_desc));
+  }
+  return ret;
+}
+
 #ifdef ERRSIM
 void write_wrong_row(const ObTabletID &tablet_id, const ObDatumRow &row)
 {
@@ -548,6 +603,13 @@ int ObPartitionMajorMerger::inner_process(const ObDatumRow &row)
       STORAGE_LOG(WARN, "Failed to get base iter macro", K(ret));
     } else if (OB_FAIL(macro_writer_->append_row(row, macro_desc))) {
       STORAGE_LOG(WARN, "Failed to append row to macro writer", K(ret));
+    } else if (ndv_sketch_calc_.is_inited()) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_TMP_FAIL(ndv_sketch_calc_.add_row(row))) {
+        // the ndv sketch is only for statistics, drop it rather than fail the merge
+        STORAGE_LOG(WARN, "Failed to add row to ndv sketch, drop it", K(tmp_ret), K(row));
+        ndv_sketch_calc_.reset();
+      }
     }
   }
 
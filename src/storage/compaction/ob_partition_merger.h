@@ -33,6 +33,7 @@
 #include "storage/blocksstable/ob_data_store_desc.h"
 #include "storage/compaction/ob_tablet_merge_info.h"
 #include "storage/compaction/ob_progressive_merge_helper.h"
+#include "storage/compaction/ob_column_ndv_sketch_calculator.h"
 
 namespace oceanbase
 {
@@ -145,6 +146,7 @@ protected:
   virtual int merge_same_rowkey_iters(MERGE_ITER_ARRAY &merge_iters) = 0;
   int check_row_columns(const blocksstable::ObDatumRow &row);
   int try_filter_row(const blocksstable::ObDatumRow &row, ObICompactionFilter::ObFilterRet &filter_ret);
+  int close_ndv_sketch();
 
 private:
   int inner_open_macro_writer(ObBasicTabletMergeCtx &ctx, ObMergeParameter &merge_param);
@@ -160,6 +162,8 @@ protected:
   ObProgressiveMergeHelper progressive_merge_helper_;
   ObICompactionFilter::ObFilterStatistics filter_statistics_;
   ObIMacroBlockValidator *validator_;
+  ObColumnNdvSketchCalculator ndv_sketch_calc_;
+  bool reused_base_block_;
 };
 
 class ObPartitionMajorMerger : public ObPartitionMerger
@@ -178,6 +182,7 @@ protected:
 private:
   virtual int inner_init() override;
   int init_progressive_merge_helper();
+  int init_ndv_sketch_calc();
   virtual int rewrite_macro_block(MERGE_ITER_ARRAY &minimum_iters) override;
   virtual int merge_same_rowkey_iters(MERGE_ITER_ARRAY &merge_iters) override;
   int merge_micro_block_iter(ObPartitionMergeIter &iter, int64_t &reuse_row_cnt);
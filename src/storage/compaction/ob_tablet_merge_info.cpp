@@ -27,7 +27,8 @@ namespace compaction
 ObTabletMergeInfo::ObTabletMergeInfo()
   :  is_inited_(false),
      merge_history_(),
-     sstable_builder_()
+     sstable_builder_(),
+     ndv_sketch_accumulator_()
 {
 }
 
@@ -42,6 +43,7 @@ void ObTabletMergeInfo::destroy()
   is_inited_ = false;
   merge_history_.reset();
   sstable_builder_.reset();
+  ndv_sketch_accumulator_.reset();
 }
 
 int ObTabletMergeInfo::init(const ObMergeStaticInfo &static_history)
@@ -208,6 +210,16 @@ int ObTabletMergeInfo::create_sstable(
       } else if (FALSE_IT(res.root_macro_seq_ = new_root_macro_seq)) {
       } else if (OB_FAIL(build_create_sstable_param(ctx, res, param, cg_schema, column_group_idx))) {
         LOG_WARN("fail to build create sstable param", K(ret));
+      } else if (NULL == cg_schema && ndv_sketch_accumulator_.get_task_count() == ctx.get_concurrent_cnt()) {
+        // the ndv sketch is only for statistics, ignore the failure
+        int tmp_ret = OB_SUCCESS;
+        if (OB_TMP_FAIL(ndv_sketch_accumulator_.get_sketch(ctx.mem_ctx_.get_allocator(), param.column_ndv_sketch_))) {
+          LOG_WARN("fail to get column ndv sketch", K(tmp_ret));
+          param.column_ndv_sketch_.reset();
+        }
+      }
+
+      if (OB_FAIL(ret)) {
       } else if (is_main_table) { // should build co sstable
         if (OB_FAIL(ObTabletCreateDeleteHelper::create_sstable<ObCOSSTableV2>(param,
                                                                               ctx.mem_ctx_.get_allocator(),
@@ -11,6 +11,7 @@
 #define OB_STORAGE_COMPACTION_TABLET_MERGE_INFO_H_
 #include "storage/compaction/ob_sstable_merge_history.h"
 #include "storage/compaction/ob_sstable_builder.h"
+#include "storage/compaction/ob_column_ndv_sketch_calculator.h"
 namespace oceanbase
 {
 namespace blocksstable
@@ -39,6 +40,8 @@ public:
   ObSSTableMergeHistory &get_merge_history() { return merge_history_; }
   blocksstable::ObWholeDataStoreDesc &get_sstable_build_desc() { return sstable_builder_.get_data_desc(); }
   blocksstable::ObSSTableIndexBuilder *get_index_builder() { return sstable_builder_.get_index_builder(); }
+  int add_column_ndv_sketch(const ObColumnNdvSketchCalculator &calculator)
+  { return ndv_sketch_accumulator_.add_task_sketch(calculator); }
   void destroy();
   int build_sstable_merge_res(
     const ObStaticMergeParam &merge_param,
@@ -59,6 +62,7 @@ private:
   bool is_inited_;
   ObSSTableMergeHistory merge_history_;
   ObSSTableBuilder sstable_builder_;
+  ObColumnNdvSketchAccumulator ndv_sketch_accumulator_;
 };
 
 } // namespace compaction
@@ -140,7 +140,10 @@ int ObStorageHAMacroBlockWriter::process(
   ObStorageObjectOpt opt;
   blocksstable::ObDatumRow macro_meta_row;
   blocksstable::ObStorageObjectWriteInfo write_info;
-  blocksstable::ObStorageObjectHandle write_handle;
+  // the io manager copies the data of write io, so the reader buffer can be reused before
+  // the write finishes, keep up to MAX_IN_FLIGHT_WRITE_NUM writes in flight
+  blocksstable::ObStorageObjectHandle write_handles[MAX_IN_FLIGHT_WRITE_NUM];
+  int64_t write_handle_idx = 0;
   ObICopyMacroBlockReader::CopyMacroBlockReadData read_data;
   copied_ctx.reset();
   int64_t write_count = 0;
@@ -216,11 +219,12 @@ int ObStorageHAMacroBlockWriter::process(
         if (OB_FAIL(check_macro_block_(data))) {
           STORAGE_LOG(WARN, "failed to check macro block, fatal error", K(ret), K(write_count), K(data));
           ret = OB_INVALID_DATA;// overwrite ret
-        } else if (!write_handle.is_empty() && OB_FAIL(write_handle.wait())) {
-          STORAGE_LOG(WARN, "failed to wait write handle", K(ret), K(write_info));
+        } else if (FALSE_IT(write_handle_idx = write_count % MAX_IN_FLIGHT_WRITE_NUM)) {
+        } else if (!write_handles[write_handle_idx].is_empty() && OB_FAIL(write_handles[write_handle_idx].wait())) {
+          STORAGE_LOG(WARN, "failed to wait write handle", K(ret), K(write_info), K(write_handle_idx));
         } else if (OB_FAIL(set_macro_write_info_(macro_block_id, write_info, opt)))  {
           LOG_WARN("failed to set macro write info", K(ret), K(macro_block_id));
-        } else if (OB_FAIL(write_macro_block_(opt, write_info, write_handle, copied_ctx, data))) {
+        } else if (OB_FAIL(write_macro_block_(opt, write_info, write_handles[write_handle_idx], copied_ctx, data))) {
           LOG_WARN("failed to write macro block", K(ret), K(opt), K(macro_block_id));
         } else {
           ObTaskController::get().allow_next_syslog();
@@ -234,12 +238,14 @@ int ObStorageHAMacroBlockWriter::process(
       }
     }
 
-    if (!write_handle.is_empty()) {
-      int tmp_ret = write_handle.wait();
-      if (OB_SUCCESS != tmp_ret) {
-        LOG_WARN("failed to wait write handle", K(ret), K(tmp_ret), K(write_info));
-        if (OB_SUCC(ret)) {
-          ret = tmp_ret;
+    for (int64_t i = 0; i < MAX_IN_FLIGHT_WRITE_NUM; ++i) {
+      if (!write_handles[i].is_empty()) {
+        int tmp_ret = write_handles[i].wait();
+        if (OB_SUCCESS != tmp_ret) {
+          LOG_WARN("failed to wait write handle", K(ret), K(tmp_ret), K(write_info), K(i));
+          if (OB_SUCC(ret)) {
+            ret = tmp_ret;
+          }
         }
       }
     }
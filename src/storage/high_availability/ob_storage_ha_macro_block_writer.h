@@ -72,6 +72,7 @@ protected:
       const blocksstable::MacroBlockId &macro_id) = 0;
 
 private:
+  static const int64_t MAX_IN_FLIGHT_WRITE_NUM = 4;
   int check_macro_block_(
       const blocksstable::ObBufferReader &data);
   int write_macro_block_(
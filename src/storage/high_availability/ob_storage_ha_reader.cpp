@@ -1023,7 +1023,7 @@ ObCopyMacroBlockObProducer::ObCopyMacroBlockObProducer()
     copy_macro_range_info_(),
     data_version_(0),
     macro_idx_(0),
-    handle_idx_(0),
+    prefetch_idx_(0),
     prefetch_meta_time_(0),
     tablet_allocator_(),
     tablet_handle_(),
@@ -1123,8 +1123,8 @@ int ObCopyMacroBlockObProducer::init(
       LOG_WARN("failed to open second meta iterator", K(ret), K(ls_id), K(table_key), K(copy_macro_range_info));
     } else {
       data_version_ = data_version;
-      macro_idx_ = -1;
-      handle_idx_ = 0;
+      macro_idx_ = 0;
+      prefetch_idx_ = 0;
       is_inited_ = true;
       LOG_INFO("succeed to init macro block producer",
           K(table_key), K(data_version), K(backfill_tx_scn), K(copy_macro_range_info));
@@ -1140,9 +1140,9 @@ int ObCopyMacroBlockObProducer::init(
     }
   }
 
-  if (OB_SUCC(ret)) {
+  for (int64_t i = 0; OB_SUCC(ret) && i < MAX_PREFETCH_MACRO_BLOCK_NUM - 1; ++i) {
     if (OB_FAIL(prefetch_())) {
-      LOG_WARN("failed to prefetch", K(ret));
+      LOG_WARN("failed to prefetch", K(ret), K(i));
     }
   }
   return ret;
@@ -1156,40 +1156,42 @@ int ObCopyMacroBlockObProducer::get_next_macro_block(
   copy_macro_block_header.reset();
   meta_row_buf_.reuse();
   int64_t occupy_size = 0;
+  const int64_t handle_idx = macro_idx_ % MAX_PREFETCH_MACRO_BLOCK_NUM;
 
   if (!is_inited_) {
     ret = OB_NOT_INIT;
     LOG_WARN("not inited", K(ret));
-  } else if (macro_idx_ < 0 || macro_idx_ > copy_macro_range_info_.macro_block_count_) {
+  } else if (macro_idx_ < 0 || macro_idx_ > copy_macro_range_info_.macro_block_count_
+      || macro_idx_ > prefetch_idx_) {
     ret = OB_ERR_UNEXPECTED;
-    LOG_WARN("invalid macro_idx_", K(ret), K(macro_idx_), K(copy_macro_range_info_));
+    LOG_WARN("invalid macro_idx_", K(ret), K(macro_idx_), K(prefetch_idx_), K(copy_macro_range_info_));
   } else if (copy_macro_range_info_.macro_block_count_ == macro_idx_) {
     ret = OB_ITER_END;
     LOG_INFO("get next macro block end");
-  } else if (!copy_macro_block_handle_[handle_idx_].is_valid()) {
+  } else if (!copy_macro_block_handle_[handle_idx].is_valid()) {
     ret = OB_ERR_UNEXPECTED;
-    LOG_WARN("copy macro block handle is not valid, cannot wait", K(ret), K(handle_idx_));
-  } else if (!copy_macro_block_handle_[handle_idx_].is_reuse_macro_block_
-      && OB_FAIL(copy_macro_block_handle_[handle_idx_].read_handle_.wait())) {
+    LOG_WARN("copy macro block handle is not valid, cannot wait", K(ret), K(handle_idx));
+  } else if (!copy_macro_block_handle_[handle_idx].is_reuse_macro_block_
+      && OB_FAIL(copy_macro_block_handle_[handle_idx].read_handle_.wait())) {
     LOG_WARN("failed to wait read handle", K(ret));
   } else {
-    if (copy_macro_block_handle_[handle_idx_].is_reuse_macro_block_) {
+    if (copy_macro_block_handle_[handle_idx].is_reuse_macro_block_) {
       // only copy macro meta when reuse macro block
       blocksstable::ObDatumRow macro_meta_row;
       common::ObArenaAllocator meta_row_allocator; // use temporary allocator to get datum row
       int64_t pos = 0;
 
-      if (OB_ISNULL(copy_macro_block_handle_[handle_idx_].macro_meta_)) {
+      if (OB_ISNULL(copy_macro_block_handle_[handle_idx].macro_meta_)) {
         ret = OB_ERR_UNEXPECTED;
-        LOG_WARN("macro meta is null", K(ret), K(handle_idx_));
-      } else if (!copy_macro_block_handle_[handle_idx_].macro_meta_->is_valid()) {
+        LOG_WARN("macro meta is null", K(ret), K(handle_idx));
+      } else if (!copy_macro_block_handle_[handle_idx].macro_meta_->is_valid()) {
         ret = OB_INVALID_ARGUMENT;
-        LOG_WARN("macro meta is not valid", K(ret), KPC(copy_macro_block_handle_[handle_idx_].macro_meta_));
-      } else if (OB_FAIL(macro_meta_row.init(copy_macro_block_handle_[handle_idx_].macro_meta_->get_meta_val().rowkey_count_ + 1))) {
+        LOG_WARN("macro meta is not valid", K(ret), KPC(copy_macro_block_handle_[handle_idx].macro_meta_));
+      } else if (OB_FAIL(macro_meta_row.init(copy_macro_block_handle_[handle_idx].macro_meta_->get_meta_val().rowkey_count_ + 1))) {
         // meta row's cell: all row keys (key) + value column
-        LOG_WARN("failed to init macro meta row", K(ret), KPC(copy_macro_block_handle_[handle_idx_].macro_meta_));
-      } else if (OB_FAIL(copy_macro_block_handle_[handle_idx_].macro_meta_->build_row(macro_meta_row, meta_row_allocator))) {
-        LOG_WARN("failed to build macro row", K(ret), KPC(copy_macro_block_handle_[handle_idx_].macro_meta_));
+        LOG_WARN("failed to init macro meta row", K(ret), KPC(copy_macro_block_handle_[handle_idx].macro_meta_));
+      } else if (OB_FAIL(copy_macro_block_handle_[handle_idx].macro_meta_->build_row(macro_meta_row, meta_row_allocator))) {
+        LOG_WARN("failed to build macro row", K(ret), KPC(copy_macro_block_handle_[handle_idx].macro_meta_));
       } else if (OB_FAIL(meta_row_buf_.write_serialize(macro_meta_row))) {
         LOG_WARN("failed to write serialize macro meta row into meta row buf", K(ret), K(macro_meta_row), K_(meta_row_buf));
       } else if (FALSE_IT(occupy_size = meta_row_buf_.length())) {
@@ -1204,16 +1206,16 @@ int ObCopyMacroBlockObProducer::get_next_macro_block(
       int64_t pos = 0;
 
       if (OB_FAIL(common_header.deserialize(
-          copy_macro_block_handle_[handle_idx_].read_handle_.get_buffer(),
-          copy_macro_block_handle_[handle_idx_].read_handle_.get_data_size(), pos))) {
+          copy_macro_block_handle_[handle_idx].read_handle_.get_buffer(),
+          copy_macro_block_handle_[handle_idx].read_handle_.get_data_size(), pos))) {
         STORAGE_LOG(ERROR, "Deserialize common header failed, ", K(ret), "read handle",
-            copy_macro_block_handle_[handle_idx_].read_handle_, K(pos), K(common_header));
+            copy_macro_block_handle_[handle_idx].read_handle_, K(pos), K(common_header));
       } else if (OB_FAIL(common_header.check_integrity())) {
         ret = OB_INVALID_DATA;
         STORAGE_LOG(ERROR, "Invalid common header, ", K(ret), K(common_header));
       } else {
         occupy_size = common_header.get_header_size() + common_header.get_payload_size();
-        data.assign(copy_macro_block_handle_[handle_idx_].read_handle_.get_buffer(), occupy_size);
+        data.assign(copy_macro_block_handle_[handle_idx].read_handle_.get_buffer(), occupy_size);
         copy_macro_block_header.is_reuse_macro_block_ = false;
         copy_macro_block_header.occupy_size_ = occupy_size;
         copy_macro_block_header.data_type_ = ObCopyMacroBlockHeader::DataType::MACRO_DATA;
@@ -1222,6 +1224,7 @@ int ObCopyMacroBlockObProducer::get_next_macro_block(
   }
 
   if (OB_SUCC(ret)) {
+    ++macro_idx_;
     if (OB_FAIL(prefetch_())) {
       LOG_WARN("failed to do prefetch", K(ret));
     }
@@ -1234,37 +1237,37 @@ int ObCopyMacroBlockObProducer::prefetch_()
   int ret = OB_SUCCESS;
   blocksstable::ObStorageObjectReadInfo read_info;
   prefetch_meta_time_ = ObTimeUtility::current_time();
-  ++macro_idx_;
-  handle_idx_ = (handle_idx_ + 1) % MAX_PREFETCH_MACRO_BLOCK_NUM;
-  copy_macro_block_handle_[handle_idx_].reset();
+  const int64_t handle_idx = prefetch_idx_ % MAX_PREFETCH_MACRO_BLOCK_NUM;
   ObDataMacroBlockMeta macro_meta;
 
   if (!is_inited_) {
     ret = OB_NOT_INIT;
     LOG_WARN("not inited", K(ret));
-  } else if (macro_idx_ < 0 || macro_idx_ > copy_macro_range_info_.macro_block_count_) {
+  } else if (prefetch_idx_ < macro_idx_ || prefetch_idx_ > copy_macro_range_info_.macro_block_count_
+      || prefetch_idx_ - macro_idx_ >= MAX_PREFETCH_MACRO_BLOCK_NUM) {
     ret = OB_ERR_UNEXPECTED;
-    LOG_WARN("invalid macro_idx_", K(ret), K(macro_idx_), K(copy_macro_range_info_));
-  } else if (macro_idx_ == copy_macro_range_info_.macro_block_count_) {
+    LOG_WARN("invalid prefetch_idx_", K(ret), K(prefetch_idx_), K(macro_idx_), K(copy_macro_range_info_));
+  } else if (prefetch_idx_ == copy_macro_range_info_.macro_block_count_) {
     // no need to
-    LOG_INFO("has finish, no need do prefetch", K(macro_idx_), K(copy_macro_range_info_));
+    LOG_INFO("has finish, no need do prefetch", K(prefetch_idx_), K(copy_macro_range_info_));
   } else {
+    copy_macro_block_handle_[handle_idx].reset();
     int64_t copy_snapshot_version = 0;
 
     if (OB_FAIL(second_meta_iterator_.get_next(macro_meta))) {
       LOG_WARN("failed to get next macro meta", K(ret), K(macro_idx_), K(copy_macro_range_info_));
-    } else if (OB_FAIL(copy_macro_block_handle_[handle_idx_].set_macro_meta(macro_meta))) {
+    } else if (OB_FAIL(copy_macro_block_handle_[handle_idx].set_macro_meta(macro_meta))) {
       LOG_WARN("failed to set macro meta", K(ret), K(macro_meta));
     } else if (macro_meta.get_logic_id().logic_version_ <= data_version_
                || macro_meta.get_macro_id().is_backup_id()) {
-      copy_macro_block_handle_[handle_idx_].is_reuse_macro_block_ = true;
+      copy_macro_block_handle_[handle_idx].is_reuse_macro_block_ = true;
       // if macro block is local, reset macro meta id to default
       // DEFAULT_IDX_ROW_MACRO_ID is also local id
       if (macro_meta.get_macro_id().is_local_id()) {
-        copy_macro_block_handle_[handle_idx_].macro_meta_->val_.macro_id_ = ObIndexBlockRowHeader::DEFAULT_IDX_ROW_MACRO_ID;
+        copy_macro_block_handle_[handle_idx].macro_meta_->val_.macro_id_ = ObIndexBlockRowHeader::DEFAULT_IDX_ROW_MACRO_ID;
       }
     } else {
-      copy_macro_block_handle_[handle_idx_].is_reuse_macro_block_ = false;
+      copy_macro_block_handle_[handle_idx].is_reuse_macro_block_ = false;
 
       read_info.macro_block_id_ = macro_meta.get_macro_id();
       read_info.offset_ = sstable_->get_macro_offset();
@@ -1272,17 +1275,18 @@ int ObCopyMacroBlockObProducer::prefetch_()
       read_info.io_desc_.set_mode(ObIOMode::READ);
       read_info.io_desc_.set_wait_event(ObWaitEventIds::DB_FILE_MIGRATE_READ);
       read_info.io_timeout_ms_ = GCONF._data_storage_io_timeout / 1000L;
-      read_info.buf_ = io_buf_[handle_idx_];
+      read_info.buf_ = io_buf_[handle_idx];
       read_info.mtl_tenant_id_ = MTL_ID();
       read_info.io_desc_.set_resource_group_id(THIS_WORKER.get_group_id());
       read_info.io_desc_.set_sys_module_id(ObIOModule::HA_COPY_MACRO_BLOCK_IO);
-      if (OB_FAIL(ObObjectManager::async_read_object(read_info, copy_macro_block_handle_[handle_idx_].read_handle_))) {
+      if (OB_FAIL(ObObjectManager::async_read_object(read_info, copy_macro_block_handle_[handle_idx].read_handle_))) {
         STORAGE_LOG(WARN, "Fail to async read block, ", K(ret), K(read_info));
       }
     }
 
     if (OB_SUCC(ret)) {
-      LOG_INFO("do prefetch", K(macro_idx_), "macro block count",copy_macro_range_info_.macro_block_count_ ,
+      ++prefetch_idx_;
+      LOG_INFO("do prefetch", K(prefetch_idx_), "macro block count",copy_macro_range_info_.macro_block_count_ ,
           "logical id", macro_meta.get_logic_id(), "physical id", macro_meta.get_macro_id(), K(data_version_), "src macro version", copy_snapshot_version);
     }
   }
@@ -258,15 +258,17 @@ private:
   int prefetch_();
 
 private:
-  static const int64_t MAX_PREFETCH_MACRO_BLOCK_NUM = 2;
+  // at most MAX_PREFETCH_MACRO_BLOCK_NUM - 1 macro blocks are read ahead, the remaining handle holds
+  // the macro block returned by the last get_next_macro_block, which is still being sent
+  static const int64_t MAX_PREFETCH_MACRO_BLOCK_NUM = 4;
   static const int64_t MACRO_META_RESERVE_TIME = 60 * 1000 * 1000LL; // 1minutes
 
   bool is_inited_;
   ObCopyMacroRangeInfo copy_macro_range_info_;
   int64_t data_version_;
-  int64_t macro_idx_;
+  int64_t macro_idx_; // next macro block to return
   ObCopyMacroBlockHandle copy_macro_block_handle_[MAX_PREFETCH_MACRO_BLOCK_NUM];
-  int64_t handle_idx_;
+  int64_t prefetch_idx_; // next macro block to prefetch
   int64_t prefetch_meta_time_;
   common::ObArenaAllocator tablet_allocator_;
   ObTabletHandle tablet_handle_;
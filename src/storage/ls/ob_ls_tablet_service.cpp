@@ -6627,6 +6627,64 @@ int ObLSTabletService::estimate_block_count_and_row_count(
   return ret;
 }
 
+int ObLSTabletService::get_column_ndv_sketches(
+    const common::ObTabletID &tablet_id,
+    const int64_t timeout_us,
+    const common::ObIArray<uint64_t> &column_ids,
+    common::ObIArray<uint64_t> &sketch_column_ids,
+    common::ObIArray<uint8_t> &ndv_sketches,
+    int64_t &major_row_count)
+{
+  int ret = OB_SUCCESS;
+  ObTabletHandle tablet_handle;
+  ObTabletMemberWrapper<ObTabletTableStore> table_store_wrapper;
+  ObITable *last_major = nullptr;
+  ObSSTableMetaHandle sst_meta_hdl;
+  sketch_column_ids.reset();
+  ndv_sketches.reset();
+  major_row_count = 0;
+
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not inited", K(ret), K_(is_inited));
+  } else if (OB_UNLIKELY(!tablet_id.is_valid() || column_ids.empty())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(tablet_id), K(column_ids));
+  } else if (OB_FAIL(ls_->get_tablet(tablet_id, tablet_handle, timeout_us, ObMDSGetTabletMode::READ_READABLE_COMMITED))) {
+    LOG_WARN("failed to get tablet", K(ret), K(tablet_id));
+  } else if (OB_FAIL(tablet_handle.get_obj()->fetch_table_store(table_store_wrapper))) {
+    LOG_WARN("fail to fetch table store", K(ret));
+  } else if (OB_ISNULL(last_major = table_store_wrapper.get_member()->get_major_sstables().get_boundary_table(true/*last*/))
+      || last_major->is_co_sstable()) {
+    // no sketch for columnar major sstable
+  } else if (OB_FAIL(static_cast<ObSSTable *>(last_major)->get_meta(sst_meta_hdl))) {
+    LOG_WARN("fail to get sstable meta handle", K(ret), KPC(last_major));
+  } else {
+    const ObColumnNdvSketch &sketch = sst_meta_hdl.get_sstable_meta().get_column_ndv_sketch();
+    for (int64_t i = 0; OB_SUCC(ret) && i < column_ids.count(); ++i) {
+      const int64_t idx = sketch.find_column(column_ids.at(i));
+      if (idx < 0) {
+      } else if (OB_FAIL(sketch_column_ids.push_back(column_ids.at(i)))) {
+        LOG_WARN("fail to push back column id", K(ret));
+      } else {
+        const uint8_t *registers = sketch.get_registers(idx);
+        for (int64_t j = 0; OB_SUCC(ret) && j < ObColumnNdvSketch::NUM_REGISTERS; ++j) {
+          if (OB_FAIL(ndv_sketches.push_back(registers[j]))) {
+            LOG_WARN("fail to push back ndv sketch", K(ret));
+          }
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      major_row_count = sst_meta_hdl.get_sstable_meta().get_row_count();
+    } else {
+      sketch_column_ids.reset();
+      ndv_sketches.reset();
+    }
+  }
+  return ret;
+}
+
 int ObLSTabletService::get_tx_data_memtable_mgr(ObMemtableMgrHandle &mgr_handle)
 {
   mgr_handle.reset();
@@ -430,6 +430,14 @@ public:
       int64_t &memtable_row_count,
       common::ObIArray<int64_t> &cg_macro_cnt_arr,
       common::ObIArray<int64_t> &cg_micro_cnt_arr);
+  // get the ndv sketches of the last major sstable for the columns having sketch
+  int get_column_ndv_sketches(
+      const common::ObTabletID &tablet_id,
+      const int64_t timeout_us,
+      const common::ObIArray<uint64_t> &column_ids,
+      common::ObIArray<uint64_t> &sketch_column_ids,
+      common::ObIArray<uint8_t> &ndv_sketches,
+      int64_t &major_row_count);
 
   // iterator
   int build_tablet_iter(ObLSTabletIterator &iter, const bool except_ls_inner_tablet = false);
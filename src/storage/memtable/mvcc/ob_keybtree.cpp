@@ -24,6 +24,10 @@ using namespace oceanbase::common;
 template<typename BtreeKey, typename BtreeVal>
 void BtreeNode<BtreeKey, BtreeVal>::reset()
 {
+  KeyHead *key_head = get_key_head();
+  if (OB_NOT_NULL(key_head)) {
+    key_head->reset_key_head();
+  }
   index_.reset();
   magic_num_ = MAGIC_NUM;
   level_ = 0;
@@ -48,6 +52,7 @@ int BtreeNode<BtreeKey, BtreeVal>::make_new_root(BtreeKey key1, BtreeNode *node_
     } else {
       index_.inc_count(2);
     }
+    build_key_head();
   }
   return ret;
 }
@@ -82,6 +87,16 @@ void BtreeNode<BtreeKey, BtreeVal>::print(FILE *file, const int depth) const
   }
 }
 
+template<typename BtreeKey, typename BtreeVal>
+void BtreeNode<BtreeKey, BtreeVal>::build_key_head()
+{
+  const int count = size();
+  KeyHead *key_head = get_key_head();
+  if (count > 0 && OB_NOT_NULL(key_head)) {
+    key_head->build_key_head(kvs_, count, get_key(0), get_key(count - 1));
+  }
+}
+
 template<typename BtreeKey, typename BtreeVal>
 int BtreeNode<BtreeKey, BtreeVal>::get_next_active_child(int pos)
 {
@@ -130,6 +145,7 @@ void BtreeNode<BtreeKey, BtreeVal>::replace_child(BtreeNode *new_node, const int
   new_node->level_ = level_;
   copy(*new_node, 0, 0, size());
   new_node->set_val(pos, (BtreeVal)child);
+  new_node->build_key_head();
 }
 
 template<typename BtreeKey, typename BtreeVal>
@@ -138,6 +154,7 @@ void BtreeNode<BtreeKey, BtreeVal>::replace_child_and_key(BtreeNode *new_node, c
   new_node->level_ = level_;
   copy(*new_node, 0, 0, size());
   new_node->insert_into_node(pos, key, (BtreeVal)child);
+  new_node->build_key_head();
 }
 
 template<typename BtreeKey, typename BtreeVal>
@@ -148,6 +165,7 @@ void BtreeNode<BtreeKey, BtreeVal>::split_child_no_overflow(BtreeNode *new_node,
 {
   new_node->level_ = level_;
   copy_and_insert(*new_node, 0, size(), pos, key_1, val_1, key_2, val_2);
+  new_node->build_key_head();
 }
 
 template<typename BtreeKey, typename BtreeVal>
@@ -169,6 +187,8 @@ void BtreeNode<BtreeKey, BtreeVal>::split_child_cause_recursive_split(BtreeNode
     copy(*new_node_1, 0, 0, half_limit);
     copy_and_insert(*new_node_2, half_limit, size(), pos, key_1, val_1, key_2, val_2);
   }
+  new_node_1->build_key_head();
+  new_node_2->build_key_head();
 }
 
 template<typename BtreeKey, typename BtreeVal>
@@ -552,6 +572,7 @@ int WriteHandle<BtreeKey, BtreeVal>::insert_and_split_upward(BtreeKey key, Btree
       ret = OB_ALLOCATE_MEMORY_FAILED;
     } else {
       new_node_1->insert_into_node(0, key, val);
+      new_node_1->build_key_head();
     }
   } else if (this->path_.get_is_found()) {
     ret = OB_ENTRY_EXIST;
@@ -1202,7 +1223,8 @@ template<typename BtreeKey, typename BtreeVal>
 int BtreeNodeAllocator<BtreeKey, BtreeVal>::pop(BtreeNode*& p)
 {
   int64_t pop_list_idx = pop_idx();
-  const int64_t NODE_SIZE = sizeof(BtreeNode);
+  const bool with_key_head = ATOMIC_LOAD(&enable_key_head_);
+  const int64_t NODE_SIZE = BtreeNode::get_alloc_size(with_key_head);
   if (OB_ISNULL(p = free_list_array_[pop_list_idx].pop())) {
     // queue is empty, fill nodes.
     char *block = nullptr;
@@ -1210,8 +1232,11 @@ int BtreeNodeAllocator<BtreeKey, BtreeVal>::pop(BtreeNode*& p)
       int64_t pushed_node_cnt = 0;
       // init all nodes
       for (int64_t idx = 0; (idx + 1) <= NODE_COUNT_PER_ALLOC; ++idx) {
-        (new(block + idx * NODE_SIZE) BtreeNode())->next_ =
-          reinterpret_cast<BtreeNode *>(block + (idx + 1) * NODE_SIZE);
+        BtreeNode *node = new(block + idx * NODE_SIZE) BtreeNode();
+        if (with_key_head) {
+          node->init_key_head();
+        }
+        node->next_ = reinterpret_cast<BtreeNode *>(block + (idx + 1) * NODE_SIZE);
       }
       // return first node
       p = reinterpret_cast<BtreeNode *>(block);
@@ -1406,8 +1431,11 @@ template<typename BtreeKey, typename BtreeVal>
 bool BtreeRawIterator<BtreeKey, BtreeVal>::is_reverse_scan() const { return iter_->is_reverse_scan(); }
 
 template<typename BtreeKey, typename BtreeVal>
-int ObKeyBtree<BtreeKey, BtreeVal>::init()
+int ObKeyBtree<BtreeKey, BtreeVal>::init(const bool enable_key_head)
 {
+  enable_key_head_ = enable_key_head && BtreeNode::is_key_head_supported();
+  // nodes allocated from now on carry key heads
+  node_allocator_.set_key_head_enabled(enable_key_head_);
   UNUSED(update_split_info(NODE_KEY_COUNT / 2));
   return OB_SUCCESS;
 }
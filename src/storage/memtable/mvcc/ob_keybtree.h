@@ -53,6 +53,68 @@ struct BtreeKV
   BtreeVal val_; // 8byte
 };
 
+// The head of ObStoreRowkey is the first column after the node prefix, which is
+// normalized only for integer types. A key which doesn't share the node prefix is
+// less or greater than all the keys sharing it, so its head is 0 or UINT64_MAX.
+template<>
+struct KeyHeadHelper<memtable::ObStoreRowkeyWrapper>
+{
+  static const bool SUPPORTED = true;
+  static int64_t get_prefix_cnt(const memtable::ObStoreRowkeyWrapper &key1,
+                                const memtable::ObStoreRowkeyWrapper &key2)
+  {
+    const common::ObObj *objs1 = key1.get_rowkey()->get_obj_ptr();
+    const common::ObObj *objs2 = key2.get_rowkey()->get_obj_ptr();
+    // the column after the prefix is required for the head
+    const int64_t max_cnt = std::min(key1.get_rowkey()->get_obj_cnt(),
+                                     key2.get_rowkey()->get_obj_cnt()) - 1;
+    int64_t prefix_cnt = 0;
+    while (prefix_cnt < max_cnt
+           && !objs1[prefix_cnt].is_ext()
+           && 0 == objs1[prefix_cnt].compare(objs2[prefix_cnt])) {
+      prefix_cnt++;
+    }
+    return prefix_cnt;
+  }
+  static bool get_head(const memtable::ObStoreRowkeyWrapper &key,
+                       const memtable::ObStoreRowkeyWrapper &prefix_key,
+                       const int64_t prefix_cnt,
+                       uint64_t &head)
+  {
+    bool bret = true;
+    const common::ObObj *objs = key.get_rowkey()->get_obj_ptr();
+    const common::ObObj *prefix_objs = prefix_key.get_rowkey()->get_obj_ptr();
+    const int64_t obj_cnt = key.get_rowkey()->get_obj_cnt();
+    int cmp = 0;
+    // compare as ObRowkey::fast_compare, the shorter key is less if the prefix is equal
+    for (int64_t i = 0; 0 == cmp && i < prefix_cnt && i < obj_cnt; i++) {
+      cmp = objs[i].compare(prefix_objs[i]);
+    }
+    if (cmp < 0 || (0 == cmp && obj_cnt <= prefix_cnt)) {
+      head = 0;
+    } else if (cmp > 0) {
+      head = UINT64_MAX;
+    } else {
+      const common::ObObj &obj = objs[prefix_cnt];
+      const uint64_t sign_bit = 1ULL << 63;
+      if (obj.is_min_value()) {
+        head = 0;
+      } else if (obj.is_max_value()) {
+        head = UINT64_MAX;
+      } else if (common::ObIntTC == obj.get_type_class()) {
+        head = static_cast<uint64_t>(obj.get_int()) ^ sign_bit;
+      } else if (common::ObUIntTC == obj.get_type_class()) {
+        // keep the order with signed integers
+        head = obj.get_uint64() > INT64_MAX ? UINT64_MAX : (obj.get_uint64() ^ sign_bit);
+      } else {
+        // null and other types, the order is decided by the comparator
+        bret = false;
+      }
+    }
+    return bret;
+  }
+};
+
 // Linked node list which supports concurrent access
 template<typename BtreeKey, typename BtreeVal>
 struct BtreeNodeList
@@ -85,9 +147,13 @@ private:
     MAX_LIST_COUNT = MAX_CPU_NUM
   };
 public:
-  BtreeNodeAllocator(common::ObIAllocator &allocator) : allocator_(allocator), alloc_memory_(0) {}
+  BtreeNodeAllocator(common::ObIAllocator &allocator)
+    : allocator_(allocator), alloc_memory_(0), enable_key_head_(false) {}
   virtual ~BtreeNodeAllocator() {}
   int64_t get_allocated() const { return ATOMIC_LOAD(&alloc_memory_) + sizeof(*this); }
+  // Nodes filled after it is set are allocated with key heads. Cached nodes
+  // keep their layout, every node knows whether it carries key heads.
+  void set_key_head_enabled(const bool enable) { ATOMIC_STORE(&enable_key_head_, enable); }
   inline BtreeNode *alloc_node()
   {
     BtreeNode *p = nullptr;
@@ -133,6 +199,7 @@ private:
 private:
   common::ObIAllocator &allocator_;
   int64_t alloc_memory_;
+  bool enable_key_head_;
   // free lists partitioned by cpu to archive better scalability
   BtreeNodeList free_list_array_[MAX_LIST_COUNT] CACHE_ALIGNED;
 };
@@ -266,9 +333,13 @@ public:
     : split_info_(0),
       size_(),
       node_allocator_(node_allocator),
-      root_(nullptr) {}
+      root_(nullptr),
+      enable_key_head_(false) {}
   ~ObKeyBtree() {}
-  int init();
+  // enable_key_head: whether nodes maintain key heads to reduce full key
+  // compares, see BtreeNodeKeyHead.
+  int init(const bool enable_key_head = false);
+  bool is_key_head_enabled() const { return enable_key_head_; }
   int64_t size() const { return size_.value(); }
   int destroy(const bool is_batch_destroy);
   int pre_batch_destroy();
@@ -309,6 +380,7 @@ private:
   common::ObSimpleCounter size_;
   BtreeNodeAllocator &node_allocator_;
   BtreeNode *root_;
+  bool enable_key_head_;
   DISALLOW_COPY_AND_ASSIGN(ObKeyBtree);
 };
 
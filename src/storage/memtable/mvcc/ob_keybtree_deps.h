@@ -15,6 +15,10 @@
 
 #include "lib/ob_abort.h"
 #include "lib/allocator/ob_retire_station.h"
+#include "common/ob_target_specific.h"
+#if OB_USE_MULTITARGET_CODE
+#include <immintrin.h>
+#endif
 
 #define BTREE_ASSERT(x) if (OB_UNLIKELY(!(x))) { ob_abort(); }
 
@@ -53,6 +57,167 @@ struct CompHelper
   }
 };
 
+// Key head is a fixed width normalized head of the key, heads are compared as
+// uint64_t and must keep the order of keys: key1 < key2 => head(key1) <= head(key2).
+// The node shares one prefix key and prefix column count between all its keys,
+// and the head is normalized from the first column after the prefix, so keys
+// differing only in the columns after the prefix can be ordered by heads.
+// Specialize it for the key type to enable the head search of BtreeNode, keys
+// with the same head are still compared by CompHelper.
+template<typename BtreeKey>
+struct KeyHeadHelper
+{
+  static const bool SUPPORTED = false;
+  // the count of leading columns shared by key1 and key2
+  static int64_t get_prefix_cnt(const BtreeKey &key1, const BtreeKey &key2)
+  {
+    UNUSED(key1);
+    UNUSED(key2);
+    return 0;
+  }
+  // return false if the key can not be normalized
+  static bool get_head(const BtreeKey &key, const BtreeKey &prefix_key, const int64_t prefix_cnt, uint64_t &head)
+  {
+    UNUSED(key);
+    UNUSED(prefix_key);
+    UNUSED(prefix_cnt);
+    head = 0;
+    return false;
+  }
+};
+
+OB_DECLARE_DEFAULT_CODE(
+// count the heads in [0, cnt) which are less than head and not greater than head
+inline void count_key_heads(const uint64_t *heads, const int cnt, const uint64_t head,
+                            int &lt_cnt, int &le_cnt)
+{
+  lt_cnt = 0;
+  le_cnt = 0;
+  for (int i = 0; i < cnt; i++) {
+    lt_cnt += (heads[i] < head);
+    le_cnt += (heads[i] <= head);
+  }
+}
+)
+
+OB_DECLARE_AVX2_SPECIFIC_CODE(
+// heads must be readable up to the multiple of 4 of cnt
+inline void count_key_heads(const uint64_t *heads, const int cnt, const uint64_t head,
+                            int &lt_cnt, int &le_cnt)
+{
+  // there is no unsigned 64-bit compare, flip the sign bit and compare as signed
+  const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+  const __m256i target = _mm256_xor_si256(_mm256_set1_epi64x(head), sign);
+  uint32_t lt_mask = 0;
+  uint32_t gt_mask = 0;
+  for (int i = 0; i < cnt; i += 4) {
+    const __m256i vals = _mm256_xor_si256(_mm256_loadu_si256((const __m256i *)(heads + i)), sign);
+    lt_mask |= (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(target, vals))) << i;
+    gt_mask |= (uint32_t)_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(vals, target))) << i;
+  }
+  const uint32_t valid_mask = (1U << cnt) - 1;
+  lt_cnt = __builtin_popcount(lt_mask & valid_mask);
+  le_cnt = cnt - __builtin_popcount(gt_mask & valid_mask);
+}
+)
+
+// Optional key heads of BtreeNode, see KeyHeadHelper. Heads are indexed by the
+// physical position of kvs, they are built when the node is created by copy on
+// write, and maintained by the append of leaf node. Once a key can not be
+// normalized, heads are invalidated and the node falls back to binary search.
+// Heads are stored right behind the BtreeNode and only allocated by the
+// BtreeNodeAllocator of a btree which enables key head, so the nodes of other
+// btrees keep their size.
+template<typename BtreeKey, typename BtreeVal, bool SUPPORTED = KeyHeadHelper<BtreeKey>::SUPPORTED>
+class BtreeNodeKeyHead
+{
+private:
+  typedef BtreeKV<BtreeKey, BtreeVal> BtreeKV;
+  typedef KeyHeadHelper<BtreeKey> KeyHeadHelper;
+  static const int64_t INVALID_PREFIX_CNT = -1;
+public:
+  BtreeNodeKeyHead(): prefix_cnt_(INVALID_PREFIX_CNT), prefix_key_() {}
+  OB_INLINE void reset_key_head() { prefix_cnt_ = INVALID_PREFIX_CNT; }
+  OB_INLINE bool has_key_head() const { return ATOMIC_LOAD(&prefix_cnt_) >= 0; }
+  // must be called before the node is visible, first_key and last_key are the
+  // min and max key among the cnt kvs.
+  void build_key_head(const BtreeKV *kvs, const int cnt, const BtreeKey &first_key, const BtreeKey &last_key)
+  {
+    const int64_t prefix_cnt = KeyHeadHelper::get_prefix_cnt(first_key, last_key);
+    bool is_valid = true;
+    prefix_key_ = first_key;
+    for (int i = 0; is_valid && i < cnt; i++) {
+      is_valid = KeyHeadHelper::get_head(kvs[i].key_, prefix_key_, prefix_cnt, heads_[i]);
+    }
+    prefix_cnt_ = is_valid ? prefix_cnt : INVALID_PREFIX_CNT;
+  }
+  // must be called before the physical position is published by index
+  OB_INLINE void set_key_head(const int pos, const BtreeKey &key)
+  {
+    const int64_t prefix_cnt = ATOMIC_LOAD(&prefix_cnt_);
+    if (prefix_cnt >= 0 && !KeyHeadHelper::get_head(key, prefix_key_, prefix_cnt, heads_[pos])) {
+      ATOMIC_STORE(&prefix_cnt_, INVALID_PREFIX_CNT);
+    }
+  }
+  // The node keys are ordered, so keys whose head is less than the head of the
+  // search key are exactly the first lt_cnt keys, and keys whose head is greater
+  // are the keys after le_cnt, only keys within [lt_cnt, le_cnt) need compare.
+  OB_INLINE bool search_key_head(const BtreeKey &key, const int cnt, int &lt_cnt, int &le_cnt) const
+  {
+    bool bret = false;
+    uint64_t head = 0;
+    const int64_t prefix_cnt = ATOMIC_LOAD(&prefix_cnt_);
+    if (prefix_cnt >= 0 && KeyHeadHelper::get_head(key, prefix_key_, prefix_cnt, head)) {
+#if OB_USE_MULTITARGET_CODE
+      if (common::is_arch_supported(common::ObTargetArch::AVX2)) {
+        specific::avx2::count_key_heads(heads_, cnt, head, lt_cnt, le_cnt);
+      } else {
+        specific::normal::count_key_heads(heads_, cnt, head, lt_cnt, le_cnt);
+      }
+#else
+      specific::normal::count_key_heads(heads_, cnt, head, lt_cnt, le_cnt);
+#endif
+      bret = true;
+    }
+    return bret;
+  }
+private:
+  int64_t prefix_cnt_; // 8byte
+  BtreeKey prefix_key_; // 8byte
+  // one more slot so that simd can load the heads by 4
+  uint64_t heads_[NODE_KEY_COUNT + 1]; // 8 * 16 = 128byte
+};
+
+template<typename BtreeKey, typename BtreeVal>
+class BtreeNodeKeyHead<BtreeKey, BtreeVal, false>
+{
+private:
+  typedef BtreeKV<BtreeKey, BtreeVal> BtreeKV;
+public:
+  OB_INLINE void reset_key_head() {}
+  OB_INLINE bool has_key_head() const { return false; }
+  void build_key_head(const BtreeKV *kvs, const int cnt, const BtreeKey &first_key, const BtreeKey &last_key)
+  {
+    UNUSED(kvs);
+    UNUSED(cnt);
+    UNUSED(first_key);
+    UNUSED(last_key);
+  }
+  OB_INLINE void set_key_head(const int pos, const BtreeKey &key)
+  {
+    UNUSED(pos);
+    UNUSED(key);
+  }
+  OB_INLINE bool search_key_head(const BtreeKey &key, const int cnt, int &lt_cnt, int &le_cnt) const
+  {
+    UNUSED(key);
+    UNUSED(cnt);
+    UNUSED(lt_cnt);
+    UNUSED(le_cnt);
+    return false;
+  }
+};
+
 class RWLock
 {
 public:
@@ -180,6 +345,7 @@ class BtreeNode: public common::ObLink
 private:
   friend class ScanHandle<BtreeKey, BtreeVal>;
   typedef BtreeKV<BtreeKey, BtreeVal> BtreeKV;
+  typedef BtreeNodeKeyHead<BtreeKey, BtreeVal> KeyHead;
   typedef ObKeyBtree<BtreeKey, BtreeVal> ObKeyBtree;
   typedef CompHelper<BtreeKey, BtreeVal> CompHelper;
 private:
@@ -187,9 +353,29 @@ private:
     MAGIC_NUM = 0xb7ee //47086
   };
 public:
-  BtreeNode(): host_(nullptr), level_(0), magic_num_(MAGIC_NUM), lock_(), index_() {}
+  BtreeNode(): host_(nullptr), level_(0), with_key_head_(false), magic_num_(MAGIC_NUM), lock_(), index_() {}
   ~BtreeNode() {}
   void reset();
+  // size of memory to hold the node, including key heads if needed
+  static int64_t get_alloc_size(const bool with_key_head)
+  {
+    return sizeof(BtreeNode) + (with_key_head ? sizeof(KeyHead) : 0);
+  }
+  static bool is_key_head_supported() { return KeyHeadHelper<BtreeKey>::SUPPORTED; }
+  // must be called when the node is constructed on memory of get_alloc_size(true)
+  OB_INLINE void init_key_head()
+  {
+    new (this + 1) KeyHead();
+    with_key_head_ = true;
+  }
+  OB_INLINE KeyHead *get_key_head()
+  {
+    return with_key_head_ ? reinterpret_cast<KeyHead *>(this + 1) : nullptr;
+  }
+  OB_INLINE const KeyHead *get_key_head() const
+  {
+    return with_key_head_ ? reinterpret_cast<const KeyHead *>(this + 1) : nullptr;
+  }
   OB_INLINE void *get_host() { return host_; }
   OB_INLINE void set_host(void *host) { host_ = host; }
   OB_INLINE MultibitSet& get_index() { return this->index_; }
@@ -240,10 +426,16 @@ public:
     pos -= 1;
     return ret;
   }
+  // build key heads of the new node if the btree enables it
+  void build_key_head();
   int get_next_active_child(int pos);
   int get_prev_active_child(int pos);
   OB_INLINE void set_key_value(int pos, BtreeKey key, BtreeVal val)
   {
+    KeyHead *key_head = get_key_head();
+    if (OB_NOT_NULL(key_head)) {
+      key_head->set_key_head(pos, key);
+    }
     kvs_[pos].key_ = key;
     ATOMIC_STORE(&kvs_[pos].val_, val);
   }
@@ -291,6 +483,14 @@ protected:
       end = size();
     }
     is_equal = false;
+    int lt_cnt = 0;
+    int le_cnt = 0;
+    const KeyHead *key_head = get_key_head();
+    if (OB_NOT_NULL(key_head) && key_head->search_key_head(key, end, lt_cnt, le_cnt)) {
+      // only keys with the same head as the search key need full compare
+      start = lt_cnt;
+      end = le_cnt;
+    }
     while (OB_SUCC(ret) && start < end && !is_equal) {
       int mid = start + (end - start) / 2;
       __builtin_prefetch(get_key(start + (mid - start) / 2, index).get_ptr(), 0, 3);
@@ -329,7 +529,9 @@ private:
   // The btree that contains the node
   void *host_;  // 8byte
   // level_ presents the btree height. The leaf's level_ is 0
-  int16_t level_; // 2byte
+  int8_t level_; // 1byte
+  // whether key heads are allocated behind the node, never changed once constructed
+  bool with_key_head_; // 1byte
   uint16_t magic_num_; // 2byte
   RWLock lock_; // 4byte
   // leaf's key-value is unordered, so index contains the real position of
@@ -14,6 +14,7 @@
 #include "storage/memtable/ob_memtable_data.h"
 #include "common/ob_store_range.h"
 #include "storage/blocksstable/ob_row_reader.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase
 {
@@ -162,10 +163,15 @@ int64_t ObQueryEngine::btree_alloc_memory() const
 int ObQueryEngine::init()
 {
   int ret = OB_SUCCESS;
+  bool enable_key_head = false;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+  if (tenant_config.is_valid()) {
+    enable_key_head = tenant_config->_enable_memtable_key_head;
+  }
   if (OB_UNLIKELY(is_inited_)) {
     TRANS_LOG(WARN, "init twice", K(this));
     ret = OB_INIT_TWICE;
-  } else if (OB_FAIL(keybtree_.init())) {
+  } else if (OB_FAIL(keybtree_.init(enable_key_head))) {
     TRANS_LOG(WARN, "keybtree init fail", KR(ret));
   } else {
     is_inited_ = true;
@@ -62,6 +62,7 @@ ObTabletCreateSSTableParam::ObTabletCreateSSTableParam()
     rowkey_column_cnt_(0),
     column_cnt_(0),
     full_column_cnt_(0),
+    column_ndv_sketch_(),
     data_checksum_(0),
     occupy_size_(0),
     original_size_(0),
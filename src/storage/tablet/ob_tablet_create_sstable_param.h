@@ -21,6 +21,7 @@
 #include "share/scn.h"
 #include "storage/ddl/ob_ddl_struct.h"
 #include "storage/blocksstable/ob_table_flag.h"
+#include "storage/blocksstable/ob_column_ndv_sketch.h"
 
 namespace oceanbase
 {
@@ -121,6 +122,7 @@ public:
       K_(column_cnt),
       K_(full_column_cnt),
       K_(column_checksums),
+      K_(column_ndv_sketch),
       K_(data_checksum),
       K_(occupy_size),
       K_(original_size),
@@ -172,6 +174,7 @@ public:
   int64_t column_cnt_;
   int64_t full_column_cnt_;
   common::ObSEArray<int64_t, common::OB_ROW_DEFAULT_COLUMNS_COUNT> column_checksums_;
+  blocksstable::ObColumnNdvSketch column_ndv_sketch_; // only hold the memory of merge ctx
   int64_t data_checksum_;
   int64_t occupy_size_;
   int64_t original_size_;
@@ -1816,8 +1816,9 @@ int ObTransService::acquire_global_snapshot__(const int64_t expire_ts,
   const MonotonicTs request_time_base = get_req_receive_mts_();
   const MonotonicTs request_time = request_time_base - MonotonicTs(gts_ahead);
   const int64_t current_time = ObClockGenerator::getClock();
-  // occupy current worker thread for at most 1s
-  const int64_t MAX_WAIT_TIME_US = 1 * 1000 * 1000;
+  // occupy current worker thread for at most 1s, a retryable request may
+  // yield the worker earlier and wait gts in the tenant retry queue
+  const int64_t MAX_WAIT_TIME_US = min(1 * 1000 * 1000L, THIS_WORKER.get_yield_wait_us());
   MonotonicTs gts_receive_ts(0);
   const int64_t timeout_us = min(MAX_WAIT_TIME_US, expire_ts - current_time);
   if (current_time >= expire_ts) {
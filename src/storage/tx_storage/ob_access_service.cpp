@@ -1265,6 +1265,36 @@ int ObAccessService::estimate_block_count_and_row_count(
   return ret;
 }
 
+int ObAccessService::get_column_ndv_sketches(
+    const share::ObLSID &ls_id,
+    const common::ObTabletID &tablet_id,
+    const int64_t timeout_us,
+    const common::ObIArray<uint64_t> &column_ids,
+    common::ObIArray<uint64_t> &sketch_column_ids,
+    common::ObIArray<uint8_t> &ndv_sketches,
+    int64_t &major_row_count) const
+{
+  int ret = OB_SUCCESS;
+  ObLSHandle ls_handle;
+  ObLS *ls = nullptr;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("ob access service is not running.", K(ret));
+  } else if (OB_UNLIKELY(!ls_id.is_valid() || !tablet_id.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ls_id), K(tablet_id), K(ret));
+  } else if (OB_FAIL(ls_svr_->get_ls(ls_id, ls_handle, ObLSGetMod::DAS_MOD))) {
+    LOG_WARN("failed to get log stream", K(ret), K(ls_id));
+  } else if (nullptr == (ls = ls_handle.get_ls())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("ls is unexpected null", K(ret));
+  } else if (OB_FAIL(ls->get_tablet_svr()->get_column_ndv_sketches(
+      tablet_id, timeout_us, column_ids, sketch_column_ids, ndv_sketches, major_row_count))) {
+    LOG_WARN("failed to get column ndv sketches", K(ret), K(ls_id), K(tablet_id), K(timeout_us));
+  }
+  return ret;
+}
+
 int ObAccessService::get_multi_ranges_cost(
     const share::ObLSID &ls_id,
     const common::ObTabletID &tablet_id,
@@ -217,6 +217,14 @@ public:
       int64_t &memtable_row_count,
       common::ObIArray<int64_t> &cg_macro_cnt_arr,
       common::ObIArray<int64_t> &cg_micro_cnt_arr) const;
+  int get_column_ndv_sketches(
+      const share::ObLSID &ls_id,
+      const common::ObTabletID &tablet_id,
+      const int64_t timeout_us,
+      const common::ObIArray<uint64_t> &column_ids,
+      common::ObIArray<uint64_t> &sketch_column_ids,
+      common::ObIArray<uint8_t> &ndv_sketches,
+      int64_t &major_row_count) const;
 protected:
   int check_tenant_out_of_memstore_limit_(bool &is_out_of_mem);
   int check_data_disk_full_(
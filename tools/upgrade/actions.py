@@ -18,8 +18,8 @@ class SqlItem:
     self.action_sql = action_sql
     self.rollback_sql = rollback_sql
 
-current_cluster_version = "4.3.4.0"
-current_data_version = "4.3.4.0"
+current_cluster_version = "4.3.5.0"
+current_data_version = "4.3.5.0"
 g_succ_sql_list = []
 g_commit_sql_list = []
 
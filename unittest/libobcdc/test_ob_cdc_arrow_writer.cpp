@@ -0,0 +1,228 @@
+/**
+ * Copyright (c) 2023 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "lib/oblog/ob_log.h"
+#include <gtest/gtest.h>
+#include <arrow/api.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/reader.h>
+#define private public
+#include "ob_cdc_arrow_writer.h"
+#include "ob_log_binlog_record.h"
+#undef private
+
+namespace oceanbase
+{
+using namespace common;
+
+namespace libobcdc
+{
+
+static int64_t g_batch_count = 0;
+
+int count_arrow_batch(const ObCDCArrowBatch &batch, void *cb_arg)
+{
+  UNUSED(batch);
+  UNUSED(cb_arg);
+  g_batch_count++;
+  return OB_SUCCESS;
+}
+
+// keep the IPC stream which is only valid during callback
+int copy_arrow_batch(const ObCDCArrowBatch &batch, void *cb_arg)
+{
+  std::string *data = static_cast<std::string *>(cb_arg);
+  data->assign(batch.data_, batch.data_len_);
+  g_batch_count++;
+  return OB_SUCCESS;
+}
+
+static void append_col_meta(ITableMeta &table_meta, const char *col_name)
+{
+  IColMeta *col_meta = DRCMessageFactory::createColMeta();
+  ASSERT_TRUE(NULL != col_meta);
+  col_meta->setName(col_name);
+  ASSERT_EQ(0, table_meta.append(col_name, col_meta));
+}
+
+TEST(ObCDCArrowWriter, native_type)
+{
+  ObObjMeta meta;
+
+  meta.set_int();
+  EXPECT_TRUE(ObCDCArrowWriter::is_native_type(meta));
+  meta.set_utinyint();
+  EXPECT_TRUE(ObCDCArrowWriter::is_native_type(meta));
+  meta.set_double();
+  EXPECT_TRUE(ObCDCArrowWriter::is_native_type(meta));
+  meta.set_datetime();
+  EXPECT_TRUE(ObCDCArrowWriter::is_native_type(meta));
+  meta.set_timestamp();
+  EXPECT_TRUE(ObCDCArrowWriter::is_native_type(meta));
+  meta.set_varchar();
+  EXPECT_TRUE(ObCDCArrowWriter::is_native_type(meta));
+
+  // converted to string
+  meta.set_number();
+  EXPECT_FALSE(ObCDCArrowWriter::is_native_type(meta));
+  meta.set_json();
+  EXPECT_FALSE(ObCDCArrowWriter::is_native_type(meta));
+  meta.set_year();
+  EXPECT_FALSE(ObCDCArrowWriter::is_native_type(meta));
+}
+
+TEST(ObCDCArrowWriter, init_and_flush)
+{
+  ObCDCArrowWriter writer;
+  ObLogBR br;
+  transaction::ObTransID trans_id(1);
+
+  EXPECT_EQ(OB_NOT_INIT, writer.flush());
+  EXPECT_EQ(OB_INVALID_ARGUMENT, writer.init(0));
+  EXPECT_EQ(OB_SUCCESS, writer.init(16));
+  EXPECT_EQ(OB_INIT_TWICE, writer.init(16));
+
+  EXPECT_FALSE(writer.is_callback_set());
+  writer.set_callback(count_arrow_batch, NULL);
+  EXPECT_TRUE(writer.is_callback_set());
+
+  // binlog record without arrow row
+  EXPECT_EQ(OB_INVALID_ARGUMENT, writer.append(br, trans_id));
+
+  // nothing to deliver
+  EXPECT_EQ(OB_SUCCESS, writer.flush());
+  EXPECT_EQ(0, g_batch_count);
+
+  writer.destroy();
+  EXPECT_EQ(OB_NOT_INIT, writer.flush());
+}
+
+
+TEST(ObCDCArrowWriter, ipc_round_trip)
+{
+  ObCDCArrowWriter writer;
+  transaction::ObTransID trans_id(1001);
+  std::string data;
+  ITableMeta *table_meta = DRCMessageFactory::createTableMeta();
+  ASSERT_TRUE(NULL != table_meta);
+  table_meta->setName("t1");
+  append_col_meta(*table_meta, "id");
+  append_col_meta(*table_meta, "c");
+  append_col_meta(*table_meta, "t");
+  append_col_meta(*table_meta, "n");
+
+  // UPDATE t1 SET id = 2, t = '-01:00:00' WHERE id = 1
+  ObObj new_id;
+  ObObj old_id;
+  ObObj new_t;
+  ObObj null_obj;
+  ObString c_str("abc");
+  new_id.set_int(2);
+  old_id.set_int(1);
+  new_t.set_time(-3600L * 1000 * 1000);
+  null_obj.set_null();
+
+  ObCDCArrowRow::Cell cells[4];
+  ObCDCArrowRow::Cell old_rowkey_cells[1];
+  int64_t rowkey_idxs[1] = {0};
+  cells[0].meta_.set_int();
+  cells[0].obj_ = &new_id;
+  cells[0].str_ = NULL;
+  // string of the unchanged column, e.g. the original default value
+  cells[1].meta_.set_varchar();
+  cells[1].meta_.set_collation_type(CS_TYPE_UTF8MB4_GENERAL_CI);
+  cells[1].obj_ = NULL;
+  cells[1].str_ = &c_str;
+  cells[2].meta_.set_time();
+  cells[2].obj_ = &new_t;
+  cells[2].str_ = NULL;
+  cells[3].meta_.set_int();
+  cells[3].obj_ = &null_obj;
+  cells[3].str_ = NULL;
+  old_rowkey_cells[0].meta_.set_int();
+  old_rowkey_cells[0].obj_ = &old_id;
+  old_rowkey_cells[0].str_ = NULL;
+
+  ObCDCArrowRow row;
+  row.table_id_ = 500001;
+  row.table_schema_version_ = 100;
+  row.record_type_ = EUPDATE;
+  row.column_num_ = 4;
+  row.cells_ = cells;
+  row.rowkey_num_ = 1;
+  row.rowkey_idxs_ = rowkey_idxs;
+  row.old_rowkey_cells_ = old_rowkey_cells;
+
+  {
+    ObLogBR br;
+    br.tenant_id_ = 1002;
+    br.commit_version_ = 12345;
+    ASSERT_EQ(OB_SUCCESS, br.set_table_meta(table_meta));
+    br.set_arrow_row(&row);
+
+    g_batch_count = 0;
+    ASSERT_EQ(OB_SUCCESS, writer.init(16));
+    writer.set_callback(copy_arrow_batch, &data);
+    ASSERT_EQ(OB_SUCCESS, writer.append(br, trans_id));
+    ASSERT_EQ(OB_SUCCESS, writer.flush());
+    ASSERT_EQ(1, g_batch_count);
+    writer.destroy();
+  }
+  DRCMessageFactory::destroy(table_meta);
+
+  // read the record batch back by the Arrow IPC stream reader
+  arrow::io::BufferReader input(arrow::Buffer::FromString(data));
+  arrow::Result<std::shared_ptr<arrow::ipc::RecordBatchStreamReader>> reader =
+      arrow::ipc::RecordBatchStreamReader::Open(&input);
+  ASSERT_TRUE(reader.ok());
+  std::shared_ptr<arrow::Schema> schema = reader.ValueUnsafe()->schema();
+  ASSERT_EQ(8, schema->num_fields());
+  EXPECT_EQ("__record_type", schema->field(0)->name());
+  EXPECT_EQ("__commit_version", schema->field(1)->name());
+  EXPECT_EQ("__trans_id", schema->field(2)->name());
+  EXPECT_EQ("id", schema->field(3)->name());
+  EXPECT_EQ("c", schema->field(4)->name());
+  EXPECT_EQ("t", schema->field(5)->name());
+  EXPECT_EQ("n", schema->field(6)->name());
+  EXPECT_EQ("__old_id", schema->field(7)->name());
+  EXPECT_EQ(arrow::Type::STRING, schema->field(4)->type()->id());
+  EXPECT_EQ(arrow::Type::DURATION, schema->field(5)->type()->id());
+
+  std::shared_ptr<arrow::RecordBatch> record_batch;
+  ASSERT_TRUE(reader.ValueUnsafe()->ReadNext(&record_batch).ok());
+  ASSERT_TRUE(NULL != record_batch);
+  ASSERT_EQ(1, record_batch->num_rows());
+  EXPECT_EQ(EUPDATE, std::static_pointer_cast<arrow::Int8Array>(record_batch->column(0))->Value(0));
+  EXPECT_EQ(12345, std::static_pointer_cast<arrow::Int64Array>(record_batch->column(1))->Value(0));
+  EXPECT_EQ(1001, std::static_pointer_cast<arrow::Int64Array>(record_batch->column(2))->Value(0));
+  EXPECT_EQ(2, std::static_pointer_cast<arrow::Int64Array>(record_batch->column(3))->Value(0));
+  EXPECT_EQ("abc", std::static_pointer_cast<arrow::StringArray>(record_batch->column(4))->GetString(0));
+  EXPECT_EQ(-3600L * 1000 * 1000,
+      std::static_pointer_cast<arrow::DurationArray>(record_batch->column(5))->Value(0));
+  EXPECT_TRUE(record_batch->column(6)->IsNull(0));
+  EXPECT_EQ(1, std::static_pointer_cast<arrow::Int64Array>(record_batch->column(7))->Value(0));
+
+  // end of stream
+  ASSERT_TRUE(reader.ValueUnsafe()->ReadNext(&record_batch).ok());
+  EXPECT_TRUE(NULL == record_batch);
+}
+
+} // namespace libobcdc
+} // ns oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("DEBUG");
+  OB_LOGGER.set_log_level("DEBUG");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,444 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#include "logservice/cdcservice/ob_cdc_tablet_filter.h"
+#include "logservice/cdcservice/ob_cdc_fetcher.h"
+#undef private
+#include "logservice/ob_log_base_header.h"
+#include "logservice/palf/log_entry_header.h"
+#include "logservice/palf/log_group_entry_header.h"
+#include "logservice/palf/log_writer_utils.h"
+#include "storage/tx/ob_tx_log.h"
+#include "storage/tx/ob_clog_encrypt_info.h"
+#include "storage/memtable/ob_memtable_mutator.h"
+#include "storage/memtable/ob_memtable_context.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace palf;
+using namespace memtable;
+using namespace transaction;
+using namespace obrpc;
+using namespace cdc;
+
+namespace unittest
+{
+const uint64_t CLUSTER_ID = 1;
+const int64_t GROUP_BUF_SIZE = 1 << 16;
+// the size of a mocked row body, including the row size encoded at its beginning
+const int32_t ROW_BODY_SIZE = 16;
+
+struct MockRow
+{
+  MutatorType mutator_type_;
+  uint64_t tablet_id_;
+};
+
+// Build a LogGroupEntry from transaction logs, each ObTxLogBlock is one LogEntry of it.
+class MockGroupEntryBuilder
+{
+public:
+  MockGroupEntryBuilder() : pos_(LogGroupEntryHeader::HEADER_SER_SIZE), entry_offsets_(), group_header_()
+  {
+    MEMSET(buf_, 0, sizeof(buf_));
+  }
+
+  void init_block(ObTxLogBlock &block, const int64_t tx_id)
+  {
+    block.reset();
+    block.get_header().init(CLUSTER_ID, DATA_VERSION_4_3_0_0, 0, ObTransID(tx_id), ObAddr());
+    ASSERT_EQ(OB_SUCCESS, block.init_for_fill());
+  }
+
+  void fill_redo(ObTxLogBlock &block,
+      const MockRow *rows,
+      const int64_t row_count,
+      const uint8_t row_flag = ObTransRowFlag::NORMAL_ROW)
+  {
+    ObTxRedoLogTempRef redo_ref;
+    ObTxRedoLog redo_log(redo_ref);
+    ObMutatorWriter writer;
+    ObCLogEncryptInfo encrypt_info;
+    int64_t mutator_size = 0;
+
+    ASSERT_EQ(OB_SUCCESS, block.prepare_mutator_buf(redo_log));
+    ASSERT_EQ(OB_SUCCESS, writer.set_buffer(redo_log.get_mutator_buf(), redo_log.get_mutator_size()));
+    for (int64_t i = 0; i < row_count; i++) {
+      char row_buf[64];
+      int64_t row_pos = 0;
+      ObMutatorRowHeader row_header;
+      row_header.mutator_type_ = rows[i].mutator_type_;
+      row_header.tablet_id_ = ObTabletID(rows[i].tablet_id_);
+      MEMSET(row_buf, 0, sizeof(row_buf));
+      ASSERT_EQ(OB_SUCCESS, row_header.serialize(row_buf, sizeof(row_buf), row_pos));
+      int64_t body_pos = row_pos;
+      ASSERT_EQ(OB_SUCCESS, serialization::encode_i32(row_buf, sizeof(row_buf), body_pos, ROW_BODY_SIZE));
+      ASSERT_EQ(OB_SUCCESS, writer.append_row_buf(row_buf, row_pos + ROW_BODY_SIZE));
+    }
+    ASSERT_EQ(OB_SUCCESS, writer.serialize(row_flag, mutator_size, encrypt_info));
+    ASSERT_EQ(OB_SUCCESS, block.finish_mutator_buf(redo_log, mutator_size));
+  }
+
+  void fill_commit_info(ObTxLogBlock &block)
+  {
+    ObTxCommitInfoLogTempRef commit_info_ref;
+    ObTxCommitInfoLog commit_info_log(commit_info_ref);
+    ASSERT_EQ(OB_SUCCESS, block.add_new_log(commit_info_log));
+  }
+
+  void append_block(ObTxLogBlock &block)
+  {
+    ASSERT_EQ(OB_SUCCESS, block.seal(1));
+    append_log_entry(block.get_buf(), block.get_size());
+  }
+
+  // a LogEntry of other module, e.g. the offline log of GC
+  void append_gc_log()
+  {
+    char data[64];
+    int64_t data_len = 0;
+    logservice::ObLogBaseHeader base_header(logservice::ObLogBaseType::GC_LS_LOG_BASE_TYPE,
+        logservice::ObReplayBarrierType::NO_NEED_BARRIER, 1);
+    ASSERT_EQ(OB_SUCCESS, base_header.serialize(data, sizeof(data), data_len));
+    append_log_entry(data, data_len);
+  }
+
+  void append_log_entry(const char *data, const int64_t data_len)
+  {
+    LogEntryHeader entry_header;
+    ASSERT_EQ(OB_SUCCESS, entry_header.generate_header(data, data_len, share::SCN::base_scn()));
+    ASSERT_EQ(OB_SUCCESS, entry_offsets_.push_back(pos_ - LogGroupEntryHeader::HEADER_SER_SIZE));
+    ASSERT_EQ(OB_SUCCESS, entry_header.serialize(buf_, GROUP_BUF_SIZE, pos_));
+    ASSERT_LE(pos_ + data_len, GROUP_BUF_SIZE);
+    MEMCPY(buf_ + pos_, data, data_len);
+    pos_ += data_len;
+  }
+
+  void build(LogGroupEntry &group_entry, const bool is_padding_log = false)
+  {
+    LogWriteBuf write_buf;
+    int64_t data_checksum = 0;
+    const int64_t data_len = pos_ - LogGroupEntryHeader::HEADER_SER_SIZE;
+    ASSERT_EQ(OB_SUCCESS, write_buf.push_back(buf_, pos_));
+    ASSERT_EQ(OB_SUCCESS, group_header_.generate(false, is_padding_log, write_buf, data_len,
+        share::SCN::base_scn(), 1, LSN(0), 1, data_checksum));
+    group_header_.update_header_checksum();
+    ASSERT_EQ(OB_SUCCESS, group_entry.generate(group_header_, buf_ + LogGroupEntryHeader::HEADER_SER_SIZE));
+  }
+
+  // offset of the LogEntry in the data of LogGroupEntry
+  int64_t get_entry_offset(const int64_t idx) const { return entry_offsets_.at(idx); }
+
+private:
+  char buf_[GROUP_BUF_SIZE];
+  int64_t pos_;
+  ObSEArray<int64_t, 4> entry_offsets_;
+  LogGroupEntryHeader group_header_;
+};
+
+class TestCdcTabletFilter : public ::testing::Test
+{
+public:
+  virtual void SetUp() override
+  {
+    ObCdcLSFetchLogReq::TabletWhiteList white_list;
+    // unsorted on purpose
+    ASSERT_EQ(OB_SUCCESS, white_list.push_back(ObTabletID(200010)));
+    ASSERT_EQ(OB_SUCCESS, white_list.push_back(ObTabletID(200002)));
+    ASSERT_EQ(OB_SUCCESS, filter_.init(white_list, ObTabletID(200020)));
+  }
+  virtual void TearDown() override { filter_.reset(); }
+
+  void check_filtered(MockGroupEntryBuilder &builder, const bool expect_filtered)
+  {
+    LogGroupEntry group_entry;
+    bool is_filtered = ! expect_filtered;
+    ObCdcLSFetchLogResp::FilteredRedoArray redo_arr;
+    builder.build(group_entry);
+    ASSERT_EQ(OB_SUCCESS, filter_.filter_group_entry(LSN(4096), group_entry, is_filtered, redo_arr));
+    ASSERT_EQ(expect_filtered, is_filtered);
+    if (! expect_filtered) {
+      ASSERT_EQ(0, redo_arr.count());
+    }
+  }
+
+protected:
+  ObCdcTabletFilter filter_;
+};
+
+TEST_F(TestCdcTabletFilter, init)
+{
+  ObCdcTabletFilter filter;
+  ObCdcLSFetchLogReq::TabletWhiteList white_list;
+  EXPECT_FALSE(filter.is_enabled());
+  ASSERT_EQ(OB_SUCCESS, white_list.push_back(ObTabletID(200001)));
+  // the white list can't be used without the max tablet id known by the client
+  EXPECT_EQ(OB_INVALID_ARGUMENT, filter.init(white_list, ObTabletID()));
+  EXPECT_FALSE(filter.is_enabled());
+  // an empty white list means no filter
+  white_list.reset();
+  EXPECT_EQ(OB_SUCCESS, filter.init(white_list, ObTabletID(200001)));
+  EXPECT_FALSE(filter.is_enabled());
+
+  EXPECT_TRUE(filter_.is_enabled());
+  EXPECT_EQ(ObTabletID(200002), filter_.tablet_ids_.at(0));
+  EXPECT_EQ(ObTabletID(200010), filter_.tablet_ids_.at(1));
+}
+
+TEST_F(TestCdcTabletFilter, is_subscribed)
+{
+  EXPECT_TRUE(filter_.is_subscribed_(ObTabletID(200002)));
+  EXPECT_TRUE(filter_.is_subscribed_(ObTabletID(200010)));
+  EXPECT_FALSE(filter_.is_subscribed_(ObTabletID(200001)));
+  EXPECT_FALSE(filter_.is_subscribed_(ObTabletID(200005)));
+  EXPECT_FALSE(filter_.is_subscribed_(ObTabletID(200020)));
+  // created after the client built the white list
+  EXPECT_TRUE(filter_.is_subscribed_(ObTabletID(200021)));
+  // inner tablets and invalid tablet
+  EXPECT_TRUE(filter_.is_subscribed_(ObTabletID(1)));
+  EXPECT_TRUE(filter_.is_subscribed_(ObTabletID(ObTabletID::MIN_USER_TABLET_ID - 1)));
+  EXPECT_TRUE(filter_.is_subscribed_(ObTabletID()));
+}
+
+TEST_F(TestCdcTabletFilter, filter_unsubscribed_redo)
+{
+  MockGroupEntryBuilder builder;
+  ObTxLogBlock block;
+  const MockRow rows1[] = {{MutatorType::MUTATOR_ROW, 200001}, {MutatorType::MUTATOR_ROW, 200005}};
+  const MockRow rows2[] = {{MutatorType::MUTATOR_ROW, 200003}};
+  builder.init_block(block, 1001);
+  builder.fill_redo(block, rows1, 2);
+  builder.fill_redo(block, rows2, 1);
+  builder.append_block(block);
+  builder.init_block(block, 1002);
+  builder.fill_redo(block, rows2, 1);
+  builder.append_block(block);
+
+  const LSN group_lsn(4096);
+  LogGroupEntry group_entry;
+  bool is_filtered = false;
+  ObCdcLSFetchLogResp::FilteredRedoArray redo_arr;
+  builder.build(group_entry);
+  ASSERT_EQ(OB_SUCCESS, filter_.filter_group_entry(group_lsn, group_entry, is_filtered, redo_arr));
+  ASSERT_TRUE(is_filtered);
+  ASSERT_EQ(2, redo_arr.count());
+  const LSN data_lsn = group_lsn + group_entry.get_header_size();
+  EXPECT_EQ(data_lsn + builder.get_entry_offset(0), redo_arr.at(0).lsn_);
+  EXPECT_EQ(1001, redo_arr.at(0).tx_id_);
+  EXPECT_EQ(CLUSTER_ID, redo_arr.at(0).cluster_id_);
+  EXPECT_EQ(data_lsn + builder.get_entry_offset(1), redo_arr.at(1).lsn_);
+  EXPECT_EQ(1002, redo_arr.at(1).tx_id_);
+
+  // the disabled filter sends everything
+  ObCdcTabletFilter disabled_filter;
+  is_filtered = true;
+  ASSERT_EQ(OB_SUCCESS, disabled_filter.filter_group_entry(group_lsn, group_entry, is_filtered, redo_arr));
+  EXPECT_FALSE(is_filtered);
+  EXPECT_EQ(0, redo_arr.count());
+}
+
+TEST_F(TestCdcTabletFilter, mixed_group)
+{
+  const MockRow unsubscribed_rows[] = {{MutatorType::MUTATOR_ROW, 200001}};
+  const MockRow subscribed_rows[] = {{MutatorType::MUTATOR_ROW, 200010}};
+  const MockRow mixed_rows[] = {{MutatorType::MUTATOR_ROW, 200001}, {MutatorType::MUTATOR_ROW, 200002}};
+  // a subscribed LogEntry after an unsubscribed one
+  {
+    MockGroupEntryBuilder builder;
+    ObTxLogBlock block;
+    builder.init_block(block, 1001);
+    builder.fill_redo(block, unsubscribed_rows, 1);
+    builder.append_block(block);
+    builder.init_block(block, 1002);
+    builder.fill_redo(block, subscribed_rows, 1);
+    builder.append_block(block);
+    check_filtered(builder, false);
+  }
+  // a subscribed redo after an unsubscribed one in the same LogEntry
+  {
+    MockGroupEntryBuilder builder;
+    ObTxLogBlock block;
+    builder.init_block(block, 1001);
+    builder.fill_redo(block, unsubscribed_rows, 1);
+    builder.fill_redo(block, subscribed_rows, 1);
+    builder.append_block(block);
+    check_filtered(builder, false);
+  }
+  // a subscribed row after an unsubscribed one in the same redo
+  {
+    MockGroupEntryBuilder builder;
+    ObTxLogBlock block;
+    builder.init_block(block, 1001);
+    builder.fill_redo(block, mixed_rows, 2);
+    builder.append_block(block);
+    check_filtered(builder, false);
+  }
+}
+
+TEST_F(TestCdcTabletFilter, table_lock)
+{
+  // table lock of a subscribed tablet is useless for the client
+  const MockRow lock_rows[] = {{MutatorType::MUTATOR_TABLE_LOCK, 200002}, {MutatorType::MUTATOR_ROW, 200001}};
+  // the row of a subscribed tablet is still sent with the table lock
+  const MockRow rows[] = {{MutatorType::MUTATOR_TABLE_LOCK, 200001}, {MutatorType::MUTATOR_ROW, 200002}};
+  {
+    MockGroupEntryBuilder builder;
+    ObTxLogBlock block;
+    builder.init_block(block, 1001);
+    builder.fill_redo(block, lock_rows, 2);
+    builder.append_block(block);
+    check_filtered(builder, true);
+  }
+  {
+    MockGroupEntryBuilder builder;
+    ObTxLogBlock block;
+    builder.init_block(block, 1001);
+    builder.fill_redo(block, rows, 2);
+    builder.append_block(block);
+    check_filtered(builder, false);
+  }
+}
+
+TEST_F(TestCdcTabletFilter, always_sent)
+{
+  const MockRow unsubscribed_rows[] = {{MutatorType::MUTATOR_ROW, 200001}};
+  // redo with commit info keeps the transaction boundary
+  {
+    MockGroupEntryBuilder builder;
+    ObTxLogBlock block;
+    builder.init_block(block, 1001);
+    builder.fill_redo(block, unsubscribed_rows, 1);
+    builder.fill_commit_info(block);
+    builder.append_block(block);
+    check_filtered(builder, false);
+  }
+  // commit info without redo
+  {
+    MockGroupEntryBuilder builder;
+    ObTxLogBlock block;
+    builder.init_block(block, 1001);
+    builder.fill_commit_info(block);
+    builder.append_block(block);
+    check_filtered(builder, false);
+  }
+  // LogEntry of other modules
+  {
+    MockGroupEntryBuilder builder;
+    ObTxLogBlock block;
+    builder.init_block(block, 1001);
+    builder.fill_redo(block, unsubscribed_rows, 1);
+    builder.append_block(block);
+    builder.append_gc_log();
+    check_filtered(builder, false);
+  }
+  // big row is split into several redo, the client reassembles it
+  {
+    MockGroupEntryBuilder builder;
+    ObTxLogBlock block;
+    builder.init_block(block, 1001);
+    builder.fill_redo(block, unsubscribed_rows, 1, ObTransRowFlag::BIG_ROW_NEW);
+    builder.append_block(block);
+    check_filtered(builder, false);
+  }
+  // tablets unknown to the client and inner tablets
+  {
+    const MockRow rows[] = {{MutatorType::MUTATOR_ROW, 200001}, {MutatorType::MUTATOR_ROW, 200021}};
+    MockGroupEntryBuilder builder;
+    ObTxLogBlock block;
+    builder.init_block(block, 1001);
+    builder.fill_redo(block, rows, 2);
+    builder.append_block(block);
+    check_filtered(builder, false);
+  }
+  {
+    const MockRow rows[] = {{MutatorType::MUTATOR_ROW, 200001}, {MutatorType::MUTATOR_ROW, 3}};
+    MockGroupEntryBuilder builder;
+    ObTxLogBlock block;
+    builder.init_block(block, 1001);
+    builder.fill_redo(block, rows, 2);
+    builder.append_block(block);
+    check_filtered(builder, false);
+  }
+  // padding LogGroupEntry
+  {
+    MockGroupEntryBuilder builder;
+    ObTxLogBlock block;
+    LogGroupEntry group_entry;
+    bool is_filtered = true;
+    ObCdcLSFetchLogResp::FilteredRedoArray redo_arr;
+    builder.init_block(block, 1001);
+    builder.fill_redo(block, unsubscribed_rows, 1);
+    builder.append_block(block);
+    builder.build(group_entry, true);
+    ASSERT_EQ(OB_SUCCESS, filter_.filter_group_entry(LSN(4096), group_entry, is_filtered, redo_arr));
+    EXPECT_FALSE(is_filtered);
+  }
+}
+
+TEST_F(TestCdcTabletFilter, filter_resp_with_group_entry)
+{
+  const MockRow unsubscribed_rows[] = {{MutatorType::MUTATOR_ROW, 200001}};
+  const MockRow subscribed_rows[] = {{MutatorType::MUTATOR_ROW, 200002}};
+  const share::ObLSID ls_id(1001);
+  ObCdcFetcher fetcher;
+  ObCdcLSFetchLogResp resp;
+  bool is_filtered = false;
+  LSN lsn(4096);
+
+  // elided LogGroupEntry moves the progress of the client
+  MockGroupEntryBuilder builder1;
+  LogGroupEntry group_entry1;
+  ObTxLogBlock block;
+  builder1.init_block(block, 1001);
+  builder1.fill_redo(block, unsubscribed_rows, 1);
+  builder1.append_block(block);
+  builder1.init_block(block, 1002);
+  builder1.fill_redo(block, unsubscribed_rows, 1);
+  builder1.append_block(block);
+  builder1.build(group_entry1);
+  fetcher.filter_resp_with_group_entry_(ls_id, lsn, group_entry1, filter_, resp, is_filtered);
+  ASSERT_TRUE(is_filtered);
+  ASSERT_EQ(1, resp.get_filtered_group_arr().count());
+  EXPECT_EQ(lsn, resp.get_filtered_group_arr().at(0).lsn_);
+  EXPECT_EQ(group_entry1.get_serialize_size(), resp.get_filtered_group_arr().at(0).group_size_);
+  EXPECT_EQ(2, resp.get_filtered_redo_arr().count());
+  EXPECT_EQ(1002, resp.get_filtered_redo_arr().at(1).tx_id_);
+  EXPECT_EQ(lsn + group_entry1.get_serialize_size(), resp.get_next_req_lsn());
+
+  // LogGroupEntry needed by the client is left to the caller
+  MockGroupEntryBuilder builder2;
+  LogGroupEntry group_entry2;
+  lsn = lsn + group_entry1.get_serialize_size();
+  builder2.init_block(block, 1003);
+  builder2.fill_redo(block, subscribed_rows, 1);
+  builder2.append_block(block);
+  builder2.build(group_entry2);
+  fetcher.filter_resp_with_group_entry_(ls_id, lsn, group_entry2, filter_, resp, is_filtered);
+  ASSERT_FALSE(is_filtered);
+  EXPECT_EQ(1, resp.get_filtered_group_arr().count());
+  EXPECT_EQ(2, resp.get_filtered_redo_arr().count());
+  EXPECT_EQ(lsn, resp.get_next_req_lsn());
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_cdc_tablet_filter.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/ob_define.h"
+#include "logservice/palf/log_io_batch_controller.h"
+
+namespace oceanbase
+{
+namespace palf
+{
+using namespace common;
+using namespace palf;
+
+TEST(TestLogIOBatchController, test_disabled)
+{
+  LogIOBatchController controller;
+  EXPECT_EQ(OB_INVALID_ARGUMENT, controller.init(0, 1000));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, controller.init(1024, -1));
+  EXPECT_EQ(OB_SUCCESS, controller.init(1024, 0));
+  EXPECT_EQ(OB_INIT_TWICE, controller.init(1024, 0));
+  EXPECT_FALSE(controller.is_enabled());
+  controller.on_arrival(100);
+  controller.on_arrival(101);
+  controller.on_batch_flushed(1024, 1000 * 1000);
+  EXPECT_EQ(1024, controller.get_batch_limit());
+  EXPECT_EQ(0, controller.get_wait_time_us(1, 100, 101));
+}
+
+TEST(TestLogIOBatchController, test_batch_limit)
+{
+  const int64_t max_batch_size = 1024;
+  const int64_t latency_target_us = 1000;
+  LogIOBatchController controller;
+  EXPECT_EQ(OB_SUCCESS, controller.init(max_batch_size, latency_target_us));
+  EXPECT_TRUE(controller.is_enabled());
+  EXPECT_EQ(max_batch_size, controller.get_batch_limit());
+  // the baseline cost(fsync) of a single task exceeds latency target, no decrease
+  const int64_t baseline_io_cost_us = 3 * latency_target_us;
+  controller.on_batch_flushed(1, baseline_io_cost_us);
+  EXPECT_EQ(baseline_io_cost_us, controller.get_baseline_io_cost_us());
+  controller.on_batch_flushed(max_batch_size, baseline_io_cost_us + latency_target_us / 2);
+  EXPECT_EQ(max_batch_size, controller.get_batch_limit());
+  // multiplicative decrease when the cost beyond baseline exceeds latency target
+  controller.on_batch_flushed(max_batch_size, baseline_io_cost_us + 2 * latency_target_us);
+  EXPECT_EQ(max_batch_size / 2, controller.get_batch_limit());
+  controller.on_batch_flushed(10, baseline_io_cost_us + 2 * latency_target_us);
+  EXPECT_EQ(max_batch_size / 4, controller.get_batch_limit());
+  // the baseline rises slowly
+  EXPECT_LT(baseline_io_cost_us, controller.get_baseline_io_cost_us());
+  EXPECT_GT(baseline_io_cost_us + latency_target_us, controller.get_baseline_io_cost_us());
+  for (int64_t i = 0; i < 10; i++) {
+    controller.on_batch_flushed(10, baseline_io_cost_us + 2 * latency_target_us);
+  }
+  EXPECT_LT(0, controller.get_batch_limit());
+  const int64_t min_batch_limit = controller.get_batch_limit();
+  // no increase when the batch has not been limited
+  controller.on_batch_flushed(1, baseline_io_cost_us);
+  EXPECT_EQ(min_batch_limit, controller.get_batch_limit());
+  // additive increase when the batch has been limited within latency target
+  controller.on_batch_flushed(min_batch_limit, baseline_io_cost_us);
+  EXPECT_LT(min_batch_limit, controller.get_batch_limit());
+  EXPECT_GE(2 * min_batch_limit, controller.get_batch_limit());
+  for (int64_t i = 0; i < max_batch_size; i++) {
+    controller.on_batch_flushed(controller.get_batch_limit(), baseline_io_cost_us);
+  }
+  EXPECT_EQ(max_batch_size, controller.get_batch_limit());
+}
+
+TEST(TestLogIOBatchController, test_wait_time)
+{
+  const int64_t latency_target_us = 1000;
+  LogIOBatchController controller;
+  EXPECT_EQ(OB_SUCCESS, controller.init(1024, latency_target_us));
+  int64_t curr_ts = 1000 * 1000;
+  // low load, tasks arrive each 10ms, flush immediately
+  for (int64_t i = 0; i < 100; i++) {
+    curr_ts += 10 * 1000;
+    controller.on_arrival(curr_ts);
+  }
+  EXPECT_EQ(0, controller.get_wait_time_us(1, curr_ts, curr_ts));
+  // high load, tasks arrive each 10us, wait for next task
+  for (int64_t i = 0; i < 100; i++) {
+    curr_ts += 10;
+    controller.on_arrival(curr_ts);
+  }
+  const int64_t wait_time_us = controller.get_wait_time_us(1, curr_ts, curr_ts);
+  EXPECT_LT(0, wait_time_us);
+  EXPECT_GE(latency_target_us, wait_time_us);
+  // the deadline of oldest task has been reached
+  EXPECT_EQ(0, controller.get_wait_time_us(1, curr_ts - latency_target_us, curr_ts));
+  // the batch has reached the limit
+  EXPECT_EQ(0, controller.get_wait_time_us(controller.get_batch_limit(), curr_ts, curr_ts));
+  // the io cost takes up the latency target
+  for (int64_t i = 0; i < 100; i++) {
+    controller.on_batch_flushed(1, latency_target_us);
+  }
+  EXPECT_EQ(0, controller.get_wait_time_us(1, curr_ts, curr_ts));
+}
+
+TEST(TestLogIOBatchController, test_histogram)
+{
+  LogIOBatchHistogram histogram;
+  EXPECT_EQ(0, histogram.get_flush_latency_percentile(99));
+  histogram.record_batch(0, 100);
+  histogram.record_batch(1, -1);
+  EXPECT_EQ(0, histogram.get_batch_count());
+  histogram.record_batch(1, 30);
+  histogram.record_batch(100, 3000);
+  EXPECT_EQ(2, histogram.get_batch_count());
+  EXPECT_EQ(101, histogram.get_task_count());
+  // 99 tasks within 50us, 1 task within 5ms
+  histogram.record_flush_latency(99, 40);
+  histogram.record_flush_latency(1, 4000);
+  EXPECT_EQ(50, histogram.get_flush_latency_percentile(50));
+  EXPECT_EQ(50, histogram.get_flush_latency_percentile(99));
+  EXPECT_EQ(5000, histogram.get_flush_latency_percentile(100));
+  histogram.record_flush_latency(1, 1000 * 1000);
+  EXPECT_EQ(INT64_MAX, histogram.get_flush_latency_percentile(100));
+  PALF_LOG(INFO, "histogram", K(histogram));
+  histogram.reset();
+  EXPECT_EQ(0, histogram.get_batch_count());
+  EXPECT_EQ(0, histogram.get_flush_latency_percentile(99));
+}
+
+} // end namespace palf
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_log_io_batch_controller.log", true);
+  OB_LOGGER.set_log_level("TRACE");
+  PALF_LOG(INFO, "begin unittest::test_log_io_batch_controller");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "observer/omt/ob_th_worker.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::omt;
+
+static const int64_t YIELD_WAIT_US = 1000L;
+
+TEST(TestThWorkerYield, yield_disabled)
+{
+  // worker yield off for the tenant
+  ASSERT_EQ(INT64_MAX, ObThWorker::calc_yield_wait_us(true, INT64_MAX, 0));
+  ASSERT_EQ(INT64_MAX, ObThWorker::calc_yield_wait_us(true, 0, 0));
+  // request can not be thrown back to the tenant queue
+  ASSERT_EQ(INT64_MAX, ObThWorker::calc_yield_wait_us(false, YIELD_WAIT_US, 0));
+}
+
+TEST(TestThWorkerYield, backoff)
+{
+  ASSERT_EQ(YIELD_WAIT_US, ObThWorker::calc_yield_wait_us(true, YIELD_WAIT_US, 0));
+  int64_t last_wait_us = 0;
+  for (int32_t i = 0; i < ObThWorker::MAX_YIELD_RETRY_TIMES; ++i) {
+    const int64_t wait_us = ObThWorker::calc_yield_wait_us(true, YIELD_WAIT_US, i);
+    ASSERT_EQ(YIELD_WAIT_US << i, wait_us);
+    ASSERT_GT(wait_us, last_wait_us);
+    last_wait_us = wait_us;
+  }
+}
+
+TEST(TestThWorkerYield, fallback_to_blocking_wait)
+{
+  const int32_t max_times = ObThWorker::MAX_YIELD_RETRY_TIMES;
+  ASSERT_NE(INT64_MAX, ObThWorker::calc_yield_wait_us(true, YIELD_WAIT_US, max_times - 1));
+  ASSERT_EQ(INT64_MAX, ObThWorker::calc_yield_wait_us(true, YIELD_WAIT_US, max_times));
+  ASSERT_EQ(INT64_MAX, ObThWorker::calc_yield_wait_us(true, YIELD_WAIT_US, max_times + 100));
+  ASSERT_EQ(INT64_MAX, ObThWorker::calc_yield_wait_us(true, YIELD_WAIT_US, -1));
+  // a huge threshold must not overflow into a short wait
+  ASSERT_EQ(INT64_MAX, ObThWorker::calc_yield_wait_us(true, INT64_MAX - 1, 1));
+}
+
+int main(int argc, char *argv[])
+{
+  OB_LOGGER.set_file_name("test_th_worker_yield.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
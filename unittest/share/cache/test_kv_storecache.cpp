@@ -1086,6 +1086,164 @@ TEST_F(TestKVCache, compute_wash_size_when_min_wash_negative)
   ASSERT_TRUE(tenant_wash_info->wash_size_ >= 0);
 }
 
+TEST(ObKVCacheAdmission, policy)
+{
+  ASSERT_EQ(ADMISSION_TINY_LFU, get_kvcache_admission_policy("tiny_lfu"));
+  ASSERT_EQ(ADMISSION_CLOCK_PRO, get_kvcache_admission_policy("CLOCK_PRO"));
+  ASSERT_EQ(ADMISSION_NONE, get_kvcache_admission_policy("lru"));
+  ASSERT_EQ(ADMISSION_NONE, get_kvcache_admission_policy(NULL));
+  ASSERT_EQ(ADMISSION_TINY_LFU, get_cache_admission_policy("user_block_cache"));
+  ASSERT_EQ(ADMISSION_NONE, get_cache_admission_policy("index_block_cache"));
+  ASSERT_EQ(ADMISSION_NONE, get_cache_admission_policy("test"));
+
+  const int64_t key_cnt = 1000;
+  const uint64_t tenant_id = 1;
+  ObKVCacheAdmission tiny_lfu;
+  int64_t admit_cnt = 0;
+  for (int64_t i = 0; i < key_cnt; ++i) {
+    admit_cnt += tiny_lfu.admit(tenant_id, ADMISSION_TINY_LFU, i) ? 1 : 0;
+  }
+  // only the false positive of doorkeeper can be admitted on the first put
+  ASSERT_LT(admit_cnt, key_cnt / 100);
+  ASSERT_EQ(ADMISSION_TINY_LFU, tiny_lfu.get_policy());
+  for (int64_t i = 0; i < key_cnt; ++i) {
+    ASSERT_TRUE(tiny_lfu.admit(tenant_id, ADMISSION_TINY_LFU, i));
+  }
+  // a put of other policy is not filtered
+  ASSERT_TRUE(tiny_lfu.admit(tenant_id, ADMISSION_CLOCK_PRO, key_cnt + 1));
+  // history fades out after the window
+  for (int64_t i = 0; i < ObKVCacheAdmission::WINDOW_SIZE; ++i) {
+    tiny_lfu.admit(tenant_id, ADMISSION_TINY_LFU, key_cnt + i);
+  }
+  ASSERT_LT(tiny_lfu.window_put_cnt_, ObKVCacheAdmission::WINDOW_SIZE);
+  tiny_lfu.destroy();
+
+  ObKVCacheAdmission clock_pro;
+  admit_cnt = 0;
+  for (int64_t i = 0; i < key_cnt; ++i) {
+    admit_cnt += clock_pro.admit(tenant_id, ADMISSION_CLOCK_PRO, i) ? 1 : 0;
+  }
+  ASSERT_EQ(0, admit_cnt);
+  for (int64_t i = 0; i < key_cnt; ++i) {
+    ASSERT_TRUE(clock_pro.admit(tenant_id, ADMISSION_CLOCK_PRO, i));
+  }
+  // a scan much larger than the ghost clock pushes the cold keys out of their test period
+  for (int64_t i = 0; i < key_cnt; ++i) {
+    clock_pro.admit(tenant_id, ADMISSION_CLOCK_PRO, i);
+  }
+  const int64_t scan_cnt = 4 * ObKVCacheAdmission::GHOST_SETS * ObKVCacheAdmission::GHOST_WAYS;
+  for (int64_t i = 0; i < scan_cnt; ++i) {
+    ASSERT_FALSE(clock_pro.admit(tenant_id, ADMISSION_CLOCK_PRO, key_cnt + i));
+  }
+  admit_cnt = 0;
+  for (int64_t i = 0; i < key_cnt; ++i) {
+    admit_cnt += clock_pro.admit(tenant_id, ADMISSION_CLOCK_PRO, i) ? 1 : 0;
+  }
+  ASSERT_LT(admit_cnt, key_cnt / 10);
+}
+
+TEST_F(TestKVCache, admission)
+{
+  static const int64_t K_SIZE = 16;
+  static const int64_t V_SIZE = 64;
+  typedef TestKVCacheKey<K_SIZE> TestKey;
+  typedef TestKVCacheValue<V_SIZE> TestValue;
+
+  ObKVCache<TestKey, TestValue> cache;
+  TestKey key;
+  TestValue value;
+  const TestValue *pvalue = NULL;
+  ObKVCacheHandle handle;
+  ASSERT_NE(OB_SUCCESS, cache.set_admission_policy(ADMISSION_TINY_LFU));
+  ASSERT_EQ(OB_SUCCESS, cache.init("test_admission"));
+  ASSERT_NE(OB_SUCCESS, cache.set_admission_policy(MAX_ADMISSION_POLICY));
+  ASSERT_EQ(OB_SUCCESS, cache.set_admission_policy(ADMISSION_TINY_LFU));
+
+  key.tenant_id_ = tenant_id_;
+  key.v_ = 1;
+  value.v_ = 1;
+  // rejected on the first put, but the value is still returned to the caller
+  ASSERT_EQ(OB_SUCCESS, cache.put_and_fetch(key, value, pvalue, handle));
+  ASSERT_TRUE(handle.is_valid());
+  ASSERT_EQ(value.v_, pvalue->v_);
+  handle.reset();
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(key, pvalue, handle));
+  // admitted on the second put
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(value.v_, pvalue->v_);
+  handle.reset();
+
+  ObKVCacheInstKey inst_key(cache.cache_id_, tenant_id_);
+  ObKVCacheInstHandle inst_handle;
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().insts_.get_cache_inst(inst_key, inst_handle));
+  ASSERT_EQ(1, inst_handle.get_inst()->status_.admission_reject_cnt_.value());
+  ASSERT_EQ(1, inst_handle.get_inst()->status_.total_put_cnt_.value());
+
+  // turn off the admission, every put goes into the map
+  ASSERT_EQ(OB_SUCCESS, cache.set_admission_policy(ADMISSION_NONE));
+  key.v_ = 2;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  handle.reset();
+  ASSERT_EQ(1, inst_handle.get_inst()->status_.admission_reject_cnt_.value());
+  inst_handle.reset();
+  cache.destroy();
+}
+
+TEST_F(TestKVCache, admission_overwrite)
+{
+  static const int64_t K_SIZE = 16;
+  static const int64_t V_SIZE = 64;
+  typedef TestKVCacheKey<K_SIZE> TestKey;
+  typedef TestKVCacheValue<V_SIZE> TestValue;
+
+  ObKVCache<TestKey, TestValue> cache;
+  TestKey key;
+  TestValue value;
+  const TestValue *pvalue = NULL;
+  ObKVCacheHandle handle;
+  ASSERT_EQ(OB_SUCCESS, cache.init("test_admission_overwrite"));
+
+  key.tenant_id_ = tenant_id_;
+  key.v_ = 1;
+  value.v_ = 1;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(1, pvalue->v_);
+  handle.reset();
+
+  ObKVCacheInstKey inst_key(cache.cache_id_, tenant_id_);
+  ObKVCacheInstHandle inst_handle;
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().insts_.get_cache_inst(inst_key, inst_handle));
+  ASSERT_EQ(1, inst_handle.get_inst()->status_.kv_cnt_);
+
+  // the overwrite is rejected, and the old value must not be hit anymore
+  ASSERT_EQ(OB_SUCCESS, cache.set_admission_policy(ADMISSION_TINY_LFU));
+  value.v_ = 2;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(key, pvalue, handle));
+  ASSERT_EQ(1, inst_handle.get_inst()->status_.admission_reject_cnt_.value());
+  ASSERT_EQ(0, inst_handle.get_inst()->status_.kv_cnt_);
+
+  // a rejected put without overwrite leaves nothing behind
+  key.v_ = 2;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value, false /*overwrite*/));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(key, pvalue, handle));
+  ASSERT_EQ(2, inst_handle.get_inst()->status_.admission_reject_cnt_.value());
+
+  // admitted on the second put
+  key.v_ = 1;
+  ASSERT_EQ(OB_SUCCESS, cache.put(key, value));
+  ASSERT_EQ(OB_SUCCESS, cache.get(key, pvalue, handle));
+  ASSERT_EQ(2, pvalue->v_);
+  handle.reset();
+  ASSERT_EQ(OB_ENTRY_EXIST, cache.put(key, value, false /*overwrite*/));
+  ASSERT_EQ(1, inst_handle.get_inst()->status_.kv_cnt_);
+  inst_handle.reset();
+  cache.destroy();
+}
+
 TEST_F(TestKVCache, get_mb_list)
 {
   ObKVCacheInstMap &inst_map = ObKVGlobalCache::get_instance().insts_;
@@ -0,0 +1,181 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+
+#include "share/stat/ob_stat_item.h"
+#include "share/stat/ob_basic_stats_estimator.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace share
+{
+
+const int64_t NUM_LLC_BUCKET = ObOptColumnStat::NUM_LLC_BUCKET;
+
+// every register of the column is set to @value
+static void append_sketch(const uint64_t column_id, const uint8_t value,
+                          ObIArray<uint64_t> &column_ids, ObIArray<uint8_t> &sketches)
+{
+  ASSERT_EQ(OB_SUCCESS, column_ids.push_back(column_id));
+  for (int64_t i = 0; i < NUM_LLC_BUCKET; ++i) {
+    ASSERT_EQ(OB_SUCCESS, sketches.push_back(value));
+  }
+}
+
+static void check_sketch(const ObIArray<uint8_t> &sketches, const int64_t idx, const uint8_t value)
+{
+  ASSERT_LE((idx + 1) * NUM_LLC_BUCKET, sketches.count());
+  for (int64_t i = 0; i < NUM_LLC_BUCKET; ++i) {
+    ASSERT_EQ(value, sketches.at(idx * NUM_LLC_BUCKET + i));
+  }
+}
+
+TEST(TestNdvSketchStat, add_ndv_sketches)
+{
+  ObGlobalTableStat global_stat;
+  ObArray<uint64_t> column_ids;
+  ObArray<uint8_t> sketches;
+  // registers do not match columns
+  ASSERT_EQ(OB_SUCCESS, column_ids.push_back(16));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, global_stat.add_ndv_sketches(column_ids, sketches));
+  ASSERT_EQ(0, global_stat.ndv_sketch_part_cnt_);
+
+  // the first partition is taken as it is
+  column_ids.reset();
+  append_sketch(16, 3, column_ids, sketches);
+  append_sketch(17, 5, column_ids, sketches);
+  append_sketch(18, 1, column_ids, sketches);
+  ASSERT_EQ(OB_SUCCESS, global_stat.add_ndv_sketches(column_ids, sketches));
+  ASSERT_EQ(3, global_stat.get_ndv_sketch_column_ids().count());
+  ASSERT_EQ(3 * NUM_LLC_BUCKET, global_stat.get_column_ndv_sketches().count());
+
+  // the second partition lacks column 17 and has column 19, in another order
+  column_ids.reset();
+  sketches.reset();
+  append_sketch(19, 7, column_ids, sketches);
+  append_sketch(18, 4, column_ids, sketches);
+  append_sketch(16, 2, column_ids, sketches);
+  ASSERT_EQ(OB_SUCCESS, global_stat.add_ndv_sketches(column_ids, sketches));
+  ASSERT_EQ(2, global_stat.get_ndv_sketch_column_ids().count());
+  ASSERT_EQ(16, global_stat.get_ndv_sketch_column_ids().at(0));
+  ASSERT_EQ(18, global_stat.get_ndv_sketch_column_ids().at(1));
+  ASSERT_EQ(2 * NUM_LLC_BUCKET, global_stat.get_column_ndv_sketches().count());
+  check_sketch(global_stat.get_column_ndv_sketches(), 0, 3);
+  check_sketch(global_stat.get_column_ndv_sketches(), 1, 4);
+
+  // registers are merged by max bucket by bucket
+  column_ids.reset();
+  sketches.reset();
+  append_sketch(16, 0, column_ids, sketches);
+  append_sketch(18, 0, column_ids, sketches);
+  sketches.at(1) = 9;
+  sketches.at(NUM_LLC_BUCKET + 2) = 6;
+  ASSERT_EQ(OB_SUCCESS, global_stat.add_ndv_sketches(column_ids, sketches));
+  ASSERT_EQ(2, global_stat.get_ndv_sketch_column_ids().count());
+  ASSERT_EQ(3, global_stat.get_column_ndv_sketches().at(0));
+  ASSERT_EQ(9, global_stat.get_column_ndv_sketches().at(1));
+  ASSERT_EQ(4, global_stat.get_column_ndv_sketches().at(NUM_LLC_BUCKET + 1));
+  ASSERT_EQ(6, global_stat.get_column_ndv_sketches().at(NUM_LLC_BUCKET + 2));
+
+  // a partition without sketch leaves no column
+  column_ids.reset();
+  sketches.reset();
+  ASSERT_EQ(OB_SUCCESS, global_stat.add_ndv_sketches(column_ids, sketches));
+  ASSERT_EQ(0, global_stat.get_ndv_sketch_column_ids().count());
+  ASSERT_EQ(0, global_stat.get_column_ndv_sketches().count());
+  append_sketch(16, 3, column_ids, sketches);
+  ASSERT_EQ(OB_SUCCESS, global_stat.add_ndv_sketches(column_ids, sketches));
+  ASSERT_EQ(0, global_stat.get_ndv_sketch_column_ids().count());
+  ASSERT_EQ(5, global_stat.ndv_sketch_part_cnt_);
+}
+
+TEST(TestNdvSketchStat, fill_ndv_sketch)
+{
+  ObArray<uint64_t> column_ids;
+  ObArray<uint8_t> sketches;
+  append_sketch(16, 3, column_ids, sketches);
+  append_sketch(17, 5, column_ids, sketches);
+
+  // an empty partition gets zero registers for all columns
+  {
+    EstimateBlockRes res;
+    BlockNumStat block_num_stat;
+    ASSERT_EQ(OB_SUCCESS, ObBasicStatsEstimator::fill_ndv_sketch(column_ids, res, block_num_stat));
+    ASSERT_EQ(2, block_num_stat.ndv_sketch_column_ids_.count());
+    check_sketch(block_num_stat.column_ndv_sketches_, 0, 0);
+    check_sketch(block_num_stat.column_ndv_sketches_, 1, 0);
+    ASSERT_NE(nullptr, block_num_stat.get_ndv_sketch(17));
+    ASSERT_EQ(nullptr, block_num_stat.get_ndv_sketch(18));
+  }
+  // no sketch or a broken one
+  {
+    EstimateBlockRes res;
+    BlockNumStat block_num_stat;
+    res.sstable_row_count_ = 100;
+    res.ndv_sketch_row_count_ = 100;
+    ASSERT_EQ(OB_SUCCESS, ObBasicStatsEstimator::fill_ndv_sketch(column_ids, res, block_num_stat));
+    ASSERT_EQ(0, block_num_stat.ndv_sketch_column_ids_.count());
+    ASSERT_EQ(OB_SUCCESS, res.ndv_sketch_column_ids_.assign(column_ids));
+    ASSERT_EQ(OB_SUCCESS, res.column_ndv_sketches_.push_back(1));
+    ASSERT_EQ(OB_SUCCESS, ObBasicStatsEstimator::fill_ndv_sketch(column_ids, res, block_num_stat));
+    ASSERT_EQ(0, block_num_stat.ndv_sketch_column_ids_.count());
+    ASSERT_EQ(nullptr, block_num_stat.get_ndv_sketch(16));
+  }
+  // rows out of the major sstable exceed 10%
+  {
+    EstimateBlockRes res;
+    BlockNumStat block_num_stat;
+    ASSERT_EQ(OB_SUCCESS, res.ndv_sketch_column_ids_.assign(column_ids));
+    ASSERT_EQ(OB_SUCCESS, res.column_ndv_sketches_.assign(sketches));
+    res.sstable_row_count_ = 1000;
+    res.memtable_row_count_ = 101;
+    res.ndv_sketch_row_count_ = 1000;
+    ASSERT_EQ(OB_SUCCESS, ObBasicStatsEstimator::fill_ndv_sketch(column_ids, res, block_num_stat));
+    ASSERT_EQ(0, block_num_stat.ndv_sketch_column_ids_.count());
+    res.sstable_row_count_ = 1050;
+    res.memtable_row_count_ = 51;
+    ASSERT_EQ(OB_SUCCESS, ObBasicStatsEstimator::fill_ndv_sketch(column_ids, res, block_num_stat));
+    ASSERT_EQ(0, block_num_stat.ndv_sketch_column_ids_.count());
+  }
+  // fresh enough
+  {
+    EstimateBlockRes res;
+    BlockNumStat block_num_stat;
+    ASSERT_EQ(OB_SUCCESS, res.ndv_sketch_column_ids_.assign(column_ids));
+    ASSERT_EQ(OB_SUCCESS, res.column_ndv_sketches_.assign(sketches));
+    res.sstable_row_count_ = 1050;
+    res.memtable_row_count_ = 50;
+    res.ndv_sketch_row_count_ = 1000;
+    ASSERT_EQ(OB_SUCCESS, ObBasicStatsEstimator::fill_ndv_sketch(column_ids, res, block_num_stat));
+    ASSERT_EQ(2, block_num_stat.ndv_sketch_column_ids_.count());
+    check_sketch(block_num_stat.column_ndv_sketches_, 0, 3);
+    check_sketch(block_num_stat.column_ndv_sketches_, 1, 5);
+    const char *sketch = block_num_stat.get_ndv_sketch(17);
+    ASSERT_NE(nullptr, sketch);
+    ASSERT_EQ(5, sketch[NUM_LLC_BUCKET - 1]);
+  }
+}
+
+} // namespace share
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_ndv_sketch_stat.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,176 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+#include "lib/allocator/page_arena.h"
+#include "sql/dtl/ob_dtl_vectors_buffer.h"
+#include "sql/dtl/ob_dtl_vectors_codec.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+using namespace oceanbase::sql::dtl;
+
+class TestDtlVectorsCodec : public ::testing::Test
+{
+public:
+  TestDtlVectorsCodec() : allocator_(ObModIds::TEST) {}
+  // build vectors in the layout of ObDtlLinkedBuffer::serialize_fixed_vector,
+  // @gen fills the value of one row, return false for null
+  char *build_vectors(const int32_t row_cnt,
+                      const std::vector<int32_t> &fixed_lens,
+                      const std::function<bool(int64_t, int64_t, char *)> &gen)
+  {
+    const int32_t col_cnt = static_cast<int32_t>(fixed_lens.size());
+    int64_t size = ObDtlVectors::HEAD_SIZE + col_cnt * sizeof(VectorInfo);
+    for (int64_t i = 0; i < col_cnt; ++i) {
+      size += ObBitVector::memory_size(row_cnt) + fixed_lens[i] * row_cnt;
+    }
+    char *buf = static_cast<char *>(allocator_.alloc(size));
+    MEMSET(buf, 0, size);
+    *reinterpret_cast<int32_t *>(buf) = ObDtlVectorsBuffer::MAGIC;
+    *reinterpret_cast<int32_t *>(buf + sizeof(int32_t)) = col_cnt;
+    *reinterpret_cast<int32_t *>(buf + ObDtlVectors::ROW_CNT_OFFSET) = row_cnt;
+    VectorInfo *infos = reinterpret_cast<VectorInfo *>(buf + ObDtlVectors::HEAD_SIZE);
+    int64_t pos = ObDtlVectors::HEAD_SIZE + col_cnt * sizeof(VectorInfo);
+    for (int64_t i = 0; i < col_cnt; ++i) {
+      infos[i].format_ = VEC_FIXED;
+      infos[i].fixed_len_ = fixed_lens[i];
+      infos[i].nulls_offset_ = static_cast<int32_t>(pos);
+      ObBitVector *nulls = to_bit_vector(buf + pos);
+      pos += ObBitVector::memory_size(row_cnt);
+      infos[i].data_offset_ = static_cast<int32_t>(pos);
+      for (int64_t j = 0; j < row_cnt; ++j) {
+        if (!gen(i, j, buf + pos + j * fixed_lens[i])) {
+          nulls->set(j);
+        }
+      }
+      pos += fixed_lens[i] * row_cnt;
+    }
+    return buf;
+  }
+  void check_round_trip(char *vectors_buf, const bool expect_shrink)
+  {
+    const int64_t raw_size = ObDtlVectorsCodec::get_raw_size(vectors_buf);
+    const int64_t max_size = ObDtlVectorsCodec::get_max_encoded_size(vectors_buf);
+    char *encoded = static_cast<char *>(allocator_.alloc(max_size));
+    int64_t encoded_size = 0;
+    ASSERT_EQ(OB_SUCCESS, ObDtlVectorsCodec::encode(vectors_buf, encoded, max_size, encoded_size));
+    ASSERT_TRUE(ObDtlVectorsCodec::is_encoded(encoded));
+    ASSERT_EQ(ObDtlVectors::decode_row_cnt(vectors_buf), ObDtlVectors::decode_row_cnt(encoded));
+    if (expect_shrink) {
+      ASSERT_LT(encoded_size, raw_size);
+    }
+    int64_t decoded_size = 0;
+    ASSERT_EQ(OB_SUCCESS, ObDtlVectorsCodec::get_decoded_size(encoded, encoded_size, decoded_size));
+    ASSERT_EQ(raw_size, decoded_size);
+    char *decoded = static_cast<char *>(allocator_.alloc(decoded_size));
+    ASSERT_EQ(OB_SUCCESS, ObDtlVectorsCodec::decode(encoded, encoded_size, decoded, decoded_size));
+
+    ObDtlVectors src;
+    ObDtlVectors dst;
+    src.set_buf(vectors_buf, static_cast<int32_t>(raw_size));
+    dst.set_buf(decoded, static_cast<int32_t>(decoded_size));
+    ASSERT_EQ(OB_SUCCESS, src.decode());
+    ASSERT_EQ(OB_SUCCESS, dst.decode());
+    ASSERT_EQ(src.get_col_cnt(), dst.get_col_cnt());
+    ASSERT_EQ(src.get_row_cnt(), dst.get_row_cnt());
+    for (int64_t i = 0; i < src.get_col_cnt(); ++i) {
+      const int64_t fixed_len = src.get_fixed_length(i);
+      ASSERT_EQ(fixed_len, dst.get_fixed_length(i));
+      ASSERT_EQ(src.get_format(i), dst.get_format(i));
+      for (int64_t j = 0; j < src.get_row_cnt(); ++j) {
+        ASSERT_EQ(src.get_nulls(i)->at(j), dst.get_nulls(i)->at(j));
+        if (!src.get_nulls(i)->at(j)) {
+          ASSERT_EQ(0, MEMCMP(src.get_data(i) + j * fixed_len, dst.get_data(i) + j * fixed_len, fixed_len));
+        }
+      }
+    }
+    // damaged buffer is rejected
+    ASSERT_NE(OB_SUCCESS, ObDtlVectorsCodec::decode(encoded, encoded_size - 1, decoded, decoded_size));
+  }
+protected:
+  ObArenaAllocator allocator_;
+};
+
+TEST_F(TestDtlVectorsCodec, for_bit_packing)
+{
+  std::mt19937_64 rand(0);
+  char *buf = build_vectors(500, {8, 4, 2, 1}, [&](int64_t col, int64_t row, char *v) {
+    bool not_null = 0 != row % 7;
+    switch (col) {
+      case 0: { int64_t t = 1000000007L + rand() % 1000; MEMCPY(v, &t, 8); break; }
+      case 1: { int32_t t = -static_cast<int32_t>(rand() % 100); MEMCPY(v, &t, 4); break; }
+      case 2: { int16_t t = 42; MEMCPY(v, &t, 2); break; }
+      default: { *v = static_cast<char>(rand() % 3); not_null = true; break; }
+    }
+    return not_null;
+  });
+  check_round_trip(buf, true);
+}
+
+TEST_F(TestDtlVectorsCodec, dict)
+{
+  std::mt19937_64 rand(1);
+  char *buf = build_vectors(512, {16, 8}, [&](int64_t col, int64_t row, char *v) {
+    const uint64_t key = rand() % 10;
+    if (0 == col) {
+      uint64_t t[2] = {key * 0x9e3779b97f4a7c15ULL, ~key};
+      MEMCPY(v, t, sizeof(t));
+    } else {
+      double t = static_cast<double>(key) / 3;
+      MEMCPY(v, &t, sizeof(t));
+    }
+    return 0 != row % 11;
+  });
+  check_round_trip(buf, true);
+}
+
+TEST_F(TestDtlVectorsCodec, raw_and_all_null)
+{
+  std::mt19937_64 rand(2);
+  char *buf = build_vectors(333, {8, 12, 4}, [&](int64_t col, int64_t row, char *v) {
+    bool not_null = true;
+    if (2 == col) {
+      not_null = false;
+    } else {
+      for (int64_t i = 0; i < (0 == col ? 8 : 12); ++i) {
+        v[i] = static_cast<char>(rand());
+      }
+    }
+    UNUSED(row);
+    return not_null;
+  });
+  check_round_trip(buf, false);
+}
+
+TEST_F(TestDtlVectorsCodec, encode_stat)
+{
+  ObDtlVectorsEncodeStat stat;
+  ASSERT_TRUE(stat.need_encode());
+  ASSERT_TRUE(stat.update(100, 50));
+  for (int64_t i = 0; i < ObDtlVectorsEncodeStat::MAX_FAIL_CNT; ++i) {
+    ASSERT_TRUE(stat.need_encode());
+    ASSERT_FALSE(stat.update(100, 95));
+  }
+  for (int64_t i = 0; i < ObDtlVectorsEncodeStat::PROBE_INTERVAL; ++i) {
+    ASSERT_FALSE(stat.need_encode());
+  }
+  ASSERT_TRUE(stat.need_encode());
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,352 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include <gtest/gtest.h>
+#include <vector>
+#define private public
+#define protected public
+#include "sql/engine/join/hash_join/hash_table.h"
+#undef private
+#undef protected
+#include "lib/allocator/page_arena.h"
+#include "lib/hash_func/murmur_hash.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+// build rows of two int64 columns: (key, row id), hash value is set by caller.
+class TestTaggedHashTable : public ::testing::Test
+{
+public:
+  static const int64_t MAX_BATCH_SIZE = 256;
+  using Table = NormalizedTaggedInt64Table;
+  using Item = Table::Item;
+
+  TestTaggedHashTable() : alloc_(), key_proj_(alloc_) {}
+  virtual void SetUp() override;
+  virtual void TearDown() override;
+
+  static uint64_t hash_of(const int64_t key)
+  {
+    return murmurhash(&key, sizeof(key), 0) & ObHJStoredRow::HASH_VAL_MASK;
+  }
+  ObHJStoredRow *new_row(const int64_t key, const int64_t row_id, const uint64_t hash_val);
+  int64_t get_key(const ObHJStoredRow *row) const
+  {
+    return *reinterpret_cast<const int64_t *>(row->get_cell_payload(ctx_.build_row_meta_, 0));
+  }
+  int64_t get_row_id(const ObHJStoredRow *row) const
+  {
+    return *reinterpret_cast<const int64_t *>(row->get_cell_payload(ctx_.build_row_meta_, 1));
+  }
+  void build(Table &table, const ObIArray<ObHJStoredRow *> &rows);
+  // probe %keys with %hash_vals, return the row ids matched by each key
+  void probe(Table &table, const int64_t *keys, const uint64_t *hash_vals, const int64_t cnt,
+             std::vector<std::vector<int64_t>> &matched);
+
+protected:
+  ObArenaAllocator alloc_;
+  ObExpr exprs_[2];
+  ObSEArray<ObExpr *, 2> expr_ptrs_;
+  ObFixedArray<int64_t, ObIAllocator> key_proj_;
+  JoinTableCtx ctx_;
+  ProbeBatchRows probe_rows_;
+  OutputInfo output_info_;
+  uint64_t hash_vals_[MAX_BATCH_SIZE];
+  int64_t key_data_[MAX_BATCH_SIZE];
+  uint16_t selector_[MAX_BATCH_SIZE];
+  const ObHJStoredRow *result_rows_[MAX_BATCH_SIZE];
+  void *cur_items_[MAX_BATCH_SIZE];
+  int64_t max_output_cnt_;
+};
+
+void TestTaggedHashTable::SetUp()
+{
+  ASSERT_EQ(OB_SUCCESS, expr_ptrs_.push_back(&exprs_[0]));
+  ASSERT_EQ(OB_SUCCESS, expr_ptrs_.push_back(&exprs_[1]));
+  ASSERT_EQ(OB_SUCCESS, ctx_.build_row_meta_.init(expr_ptrs_, sizeof(ObHJStoredRow::ExtraInfo),
+                                                   false /*reorder_fixed_expr*/));
+  ASSERT_EQ(OB_SUCCESS, key_proj_.init(1));
+  ASSERT_EQ(OB_SUCCESS, key_proj_.push_back(0));
+  ctx_.build_key_proj_ = &key_proj_;
+  ctx_.join_type_ = INNER_JOIN;
+  ctx_.probe_opt_ = true;
+  ctx_.use_tagged_ht_ = true;
+  ctx_.max_batch_size_ = MAX_BATCH_SIZE;
+  ctx_.cur_items_ = cur_items_;
+  max_output_cnt_ = MAX_BATCH_SIZE;
+  ctx_.max_output_cnt_ = &max_output_cnt_;
+  probe_rows_.hash_vals_ = hash_vals_;
+  probe_rows_.key_data_ = reinterpret_cast<char *>(key_data_);
+  ctx_.probe_batch_rows_ = &probe_rows_;
+  output_info_.selector_ = selector_;
+  output_info_.left_result_rows_ = result_rows_;
+  ctx_.output_info_ = &output_info_;
+}
+
+void TestTaggedHashTable::TearDown()
+{
+  ctx_.reset();
+  alloc_.reset();
+}
+
+ObHJStoredRow *TestTaggedHashTable::new_row(const int64_t key, const int64_t row_id, const uint64_t hash_val)
+{
+  const RowMeta &row_meta = ctx_.build_row_meta_;
+  const int64_t row_size = row_meta.get_row_fixed_size() + 2 * sizeof(int64_t);
+  ObHJStoredRow *row = static_cast<ObHJStoredRow *>(alloc_.alloc(row_size));
+  OB_ASSERT(nullptr != row);
+  new (row) ObHJStoredRow();
+  row->init(row_meta);
+  row->set_row_size(static_cast<uint32_t>(row_size));
+  row->set_cell_payload(row_meta, 0, reinterpret_cast<const char *>(&key), sizeof(key));
+  row->set_cell_payload(row_meta, 1, reinterpret_cast<const char *>(&row_id), sizeof(row_id));
+  row->set_hash_value(row_meta, hash_val);
+  return row;
+}
+
+void TestTaggedHashTable::build(Table &table, const ObIArray<ObHJStoredRow *> &rows)
+{
+  ASSERT_EQ(OB_SUCCESS, table.build_prepare(rows.count(), 0 /*bucket_count*/));
+  int64_t used_buckets = 0;
+  int64_t collisions = 0;
+  for (int64_t i = 0; i < rows.count(); i += MAX_BATCH_SIZE) {
+    ObHJStoredRow **batch = const_cast<ObHJStoredRow **>(&rows.at(i));
+    const int64_t size = std::min(MAX_BATCH_SIZE, rows.count() - i);
+    ASSERT_EQ(OB_SUCCESS, table.insert_batch(ctx_, batch, size, used_buckets, collisions));
+  }
+  table.set_diag_info(used_buckets, collisions);
+}
+
+void TestTaggedHashTable::probe(Table &table, const int64_t *keys, const uint64_t *hash_vals,
+                                const int64_t cnt, std::vector<std::vector<int64_t>> &matched)
+{
+  matched.assign(cnt, std::vector<int64_t>());
+  for (int64_t begin = 0; begin < cnt; begin += MAX_BATCH_SIZE) {
+    const int64_t size = std::min(MAX_BATCH_SIZE, cnt - begin);
+    output_info_.reuse();
+    for (int64_t i = 0; i < size; i++) {
+      hash_vals_[i] = hash_vals[begin + i];
+      key_data_[i] = keys[begin + i];
+      selector_[i] = static_cast<uint16_t>(i);
+    }
+    output_info_.selector_cnt_ = static_cast<uint16_t>(size);
+    // the first call finds the slot of each key, the following calls walk the chains
+    do {
+      ASSERT_EQ(OB_SUCCESS, table.probe_batch(ctx_, output_info_));
+      for (int64_t i = 0; i < output_info_.selector_cnt_; i++) {
+        const int64_t idx = begin + selector_[i];
+        ASSERT_EQ(keys[idx], get_key(result_rows_[i]));
+        matched[idx].push_back(get_row_id(result_rows_[i]));
+      }
+    } while (output_info_.selector_cnt_ > 0);
+  }
+}
+
+TEST_F(TestTaggedHashTable, insert_lookup)
+{
+  Table table;
+  ASSERT_EQ(OB_SUCCESS, table.init(alloc_, MAX_BATCH_SIZE));
+  // 250 distinct keys, 4 rows for each
+  const int64_t key_cnt = 250;
+  const int64_t dup_cnt = 4;
+  ObSEArray<ObHJStoredRow *, 1024> rows;
+  for (int64_t i = 0; i < key_cnt * dup_cnt; i++) {
+    const int64_t key = i % key_cnt;
+    ASSERT_EQ(OB_SUCCESS, rows.push_back(new_row(key, i, hash_of(key))));
+  }
+  build(table, rows);
+  ASSERT_EQ(key_cnt * dup_cnt, table.get_row_count());
+  ASSERT_EQ(key_cnt, table.get_used_buckets());
+  // load factor is at most 0.5
+  ASSERT_GE(table.get_nbuckets(), 2 * key_cnt * dup_cnt);
+
+  // probe the keys built and the same count of absent keys
+  int64_t keys[2 * key_cnt];
+  uint64_t hash_vals[2 * key_cnt];
+  for (int64_t i = 0; i < 2 * key_cnt; i++) {
+    keys[i] = i;
+    hash_vals[i] = hash_of(i);
+  }
+  std::vector<std::vector<int64_t>> matched;
+  probe(table, keys, hash_vals, 2 * key_cnt, matched);
+  for (int64_t i = 0; i < 2 * key_cnt; i++) {
+    if (i < key_cnt) {
+      ASSERT_EQ(dup_cnt, matched[i].size()) << "key " << i;
+      for (int64_t j = 0; j < dup_cnt; j++) {
+        ASSERT_EQ(i, matched[i][j] % key_cnt);
+      }
+    } else {
+      ASSERT_EQ(0, matched[i].size()) << "key " << i;
+    }
+  }
+  table.free(&alloc_);
+}
+
+TEST_F(TestTaggedHashTable, tag_collision)
+{
+  Table table;
+  ASSERT_EQ(OB_SUCCESS, table.init(alloc_, MAX_BATCH_SIZE));
+  // 40 distinct keys with the same hash value: the same tag and the same start group,
+  // they overflow the first group and keys are compared for every tag match.
+  const int64_t key_cnt = 40;
+  const uint64_t same_hash = hash_of(12345);
+  ObSEArray<ObHJStoredRow *, 64> rows;
+  for (int64_t i = 0; i < key_cnt; i++) {
+    ASSERT_EQ(OB_SUCCESS, rows.push_back(new_row(i, i, same_hash)));
+  }
+  // keys whose hash differ only in tag, they share the start group with the keys above
+  const uint64_t other_tag_hash = same_hash ^ (1ULL << (ObHJStoredRow::HASH_VAL_BIT - 1));
+  ASSERT_NE(Table::get_tag(same_hash), Table::get_tag(other_tag_hash));
+  for (int64_t i = 0; i < 4; i++) {
+    ASSERT_EQ(OB_SUCCESS, rows.push_back(new_row(1000 + i, key_cnt + i, other_tag_hash)));
+  }
+  build(table, rows);
+  ASSERT_EQ(key_cnt + 4, table.get_used_buckets());
+  ASSERT_LT(0, table.get_collisions());
+
+  for (int64_t i = 0; i < key_cnt; i++) {
+    Item *item = table.find(same_hash, Int64Key{i});
+    ASSERT_NE(END_ITEM, reinterpret_cast<uint64_t>(item));
+    ASSERT_EQ(i, get_row_id(item->get_stored_row()));
+    ASSERT_EQ(END_ITEM, reinterpret_cast<uint64_t>(item->get_next(ctx_.build_row_meta_)));
+    // the same key with another tag is not found
+    ASSERT_EQ(END_ITEM, reinterpret_cast<uint64_t>(table.find(other_tag_hash, Int64Key{i})));
+  }
+  for (int64_t i = 0; i < 4; i++) {
+    Item *item = table.find(other_tag_hash, Int64Key{1000 + i});
+    ASSERT_NE(END_ITEM, reinterpret_cast<uint64_t>(item));
+    ASSERT_EQ(key_cnt + i, get_row_id(item->get_stored_row()));
+  }
+  // absent key with a colliding hash value
+  ASSERT_EQ(END_ITEM, reinterpret_cast<uint64_t>(table.find(same_hash, Int64Key{key_cnt})));
+
+  // batch probe goes through the same path
+  int64_t keys[key_cnt + 1];
+  uint64_t hash_vals[key_cnt + 1];
+  for (int64_t i = 0; i <= key_cnt; i++) {
+    keys[i] = i;
+    hash_vals[i] = same_hash;
+  }
+  std::vector<std::vector<int64_t>> matched;
+  probe(table, keys, hash_vals, key_cnt + 1, matched);
+  for (int64_t i = 0; i < key_cnt; i++) {
+    ASSERT_EQ(1, matched[i].size());
+    ASSERT_EQ(i, matched[i][0]);
+  }
+  ASSERT_EQ(0, matched[key_cnt].size());
+  table.free(&alloc_);
+}
+
+TEST_F(TestTaggedHashTable, resize)
+{
+  Table table;
+  ASSERT_EQ(OB_SUCCESS, table.init(alloc_, MAX_BATCH_SIZE));
+  // build of the first partition
+  ObSEArray<ObHJStoredRow *, 16> small_rows;
+  for (int64_t i = 0; i < 10; i++) {
+    ASSERT_EQ(OB_SUCCESS, small_rows.push_back(new_row(i, i, hash_of(i))));
+  }
+  build(table, small_rows);
+  const int64_t small_nbuckets = table.get_nbuckets();
+  ASSERT_GE(small_nbuckets, 2 * small_rows.count());
+  ASSERT_EQ(0, small_nbuckets % Table::GROUP_SIZE);
+  ASSERT_NE(END_ITEM, reinterpret_cast<uint64_t>(table.find(hash_of(5), Int64Key{5})));
+
+  // a larger partition grows the table, rows of the previous build are gone
+  const int64_t large_cnt = 10000;
+  ObSEArray<ObHJStoredRow *, 1024> large_rows;
+  for (int64_t i = 0; i < large_cnt; i++) {
+    const int64_t key = 100 + i;
+    ASSERT_EQ(OB_SUCCESS, large_rows.push_back(new_row(key, i, hash_of(key))));
+  }
+  table.reset();
+  build(table, large_rows);
+  ASSERT_LT(small_nbuckets, table.get_nbuckets());
+  ASSERT_GE(table.get_nbuckets(), 2 * large_cnt);
+  ASSERT_EQ(large_cnt, table.get_used_buckets());
+  ASSERT_EQ(END_ITEM, reinterpret_cast<uint64_t>(table.find(hash_of(5), Int64Key{5})));
+  for (int64_t i = 0; i < large_cnt; i++) {
+    const int64_t key = 100 + i;
+    Item *item = table.find(hash_of(key), Int64Key{key});
+    ASSERT_NE(END_ITEM, reinterpret_cast<uint64_t>(item));
+    ASSERT_EQ(i, get_row_id(item->get_stored_row()));
+  }
+
+  // rebuild without reset keeps the capacity and clears the tags
+  build(table, small_rows);
+  ASSERT_LE(2 * large_cnt, table.get_nbuckets());
+  ASSERT_EQ(10, table.get_row_count());
+  ASSERT_EQ(END_ITEM, reinterpret_cast<uint64_t>(table.find(hash_of(100), Int64Key{100})));
+  for (int64_t i = 0; i < 10; i++) {
+    ASSERT_NE(END_ITEM, reinterpret_cast<uint64_t>(table.find(hash_of(i), Int64Key{i})));
+  }
+  table.free(&alloc_);
+}
+
+// The tagged table never unlinks build rows: the probe opt path does not delete matched rows,
+// anti and outer joins mark the matched rows and scan the unmatched ones instead.
+TEST_F(TestTaggedHashTable, mark_match_and_unmatched_rows)
+{
+  Table table;
+  ASSERT_EQ(OB_SUCCESS, table.init(alloc_, MAX_BATCH_SIZE));
+  ctx_.join_type_ = LEFT_ANTI_JOIN;
+  ASSERT_TRUE(ctx_.need_mark_match());
+  const int64_t key_cnt = 100;
+  ObSEArray<ObHJStoredRow *, 256> rows;
+  for (int64_t i = 0; i < 2 * key_cnt; i++) {
+    const int64_t key = i % key_cnt;
+    ASSERT_EQ(OB_SUCCESS, rows.push_back(new_row(key, i, hash_of(key))));
+  }
+  build(table, rows);
+  // probe the even keys, both rows of each even key are matched
+  int64_t keys[key_cnt / 2];
+  uint64_t hash_vals[key_cnt / 2];
+  for (int64_t i = 0; i < key_cnt / 2; i++) {
+    keys[i] = 2 * i;
+    hash_vals[i] = hash_of(2 * i);
+  }
+  std::vector<std::vector<int64_t>> matched;
+  probe(table, keys, hash_vals, key_cnt / 2, matched);
+  for (int64_t i = 0; i < key_cnt / 2; i++) {
+    ASSERT_EQ(2, matched[i].size());
+  }
+  // the odd keys are returned as unmatched rows
+  ctx_.reuse();
+  int64_t unmatched_cnt = 0;
+  int ret = OB_SUCCESS;
+  while (OB_SUCC(ret)) {
+    ret = table.get_unmatched_rows(ctx_, output_info_);
+    ASSERT_TRUE(OB_SUCCESS == ret || OB_ITER_END == ret);
+    for (int64_t i = 0; i < output_info_.selector_cnt_; i++) {
+      ASSERT_EQ(1, get_key(result_rows_[i]) % 2);
+      unmatched_cnt++;
+    }
+  }
+  ASSERT_EQ(key_cnt, unmatched_cnt);
+  table.free(&alloc_);
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,247 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "sql/plan_cache/ob_lib_cache_lookup_slots.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "lib/time/ob_time_utility.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+struct MockKey
+{
+  explicit MockKey(const int64_t v) : v_(v) {}
+  uint64_t hash() const { return murmurhash(&v_, sizeof(v_), 0); }
+  bool operator==(const MockKey &other) const { return v_ == other.v_; }
+  int64_t v_;
+};
+
+struct MockNode
+{
+  static const int64_t ALIVE = 0x414c495645;
+  static const int64_t DEAD = 0x44454144;
+  explicit MockNode(const int64_t key)
+    : magic_(ALIVE), key_(key), is_removed_(false), last_active_ts_(0), retire_next_(NULL) {}
+  const MockKey *get_cache_key() const { return &key_; }
+  bool is_removed() const { return ATOMIC_LOAD(&is_removed_); }
+  void mark_removed() { ATOMIC_STORE(&is_removed_, true); }
+  int64_t get_last_active_timestamp() const { return ATOMIC_LOAD(&last_active_ts_); }
+  MockNode *get_retire_next() const { return retire_next_; }
+  void set_retire_next(MockNode *node) { retire_next_ = node; }
+  int64_t magic_;
+  MockKey key_;
+  bool is_removed_;
+  int64_t last_active_ts_;
+  MockNode *retire_next_;
+};
+
+typedef ObLCLookupSlots<MockNode, MockKey> MockLookupSlots;
+
+// the reclaimed nodes are poisoned rather than freed, so that a lookup reading a reclaimed
+// node is detected instead of crashing
+struct MockReclaim
+{
+  void operator()(MockNode *node)
+  {
+    ATOMIC_STORE(&node->magic_, MockNode::DEAD);
+    reclaimed_.push_back(node);
+  }
+  std::vector<MockNode *> reclaimed_;
+};
+
+struct MockLookup
+{
+  MockLookup() : node_(NULL), dead_cnt_(0) {}
+  int operator()(MockNode &node)
+  {
+    node_ = &node;
+    if (MockNode::ALIVE != ATOMIC_LOAD(&node.magic_)) {
+      ++dead_cnt_;
+    }
+    return OB_SUCCESS;
+  }
+  MockNode *node_;
+  int64_t dead_cnt_;
+};
+
+class TestLCLookupSlots : public ::testing::Test
+{
+public:
+  static const int64_t SLOT_CNT = 1L << 10;
+  static QClock &get_qclock()
+  {
+    static QClock qclock;
+    return qclock;
+  }
+};
+
+TEST_F(TestLCLookupSlots, init)
+{
+  MockLookupSlots slots(get_qclock());
+  MockLookup lookup;
+  MockKey key(1);
+  EXPECT_FALSE(slots.is_inited());
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, slots.lookup(key, lookup));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, slots.init(0, 0, ObMemAttr(OB_SERVER_TENANT_ID, "LCLookupSlot")));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, slots.init(1000, 0, ObMemAttr(OB_SERVER_TENANT_ID, "LCLookupSlot")));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, slots.init(SLOT_CNT, -1, ObMemAttr(OB_SERVER_TENANT_ID, "LCLookupSlot")));
+  EXPECT_EQ(OB_SUCCESS, slots.init(SLOT_CNT, 0, ObMemAttr(OB_SERVER_TENANT_ID, "LCLookupSlot")));
+  EXPECT_EQ(OB_INIT_TWICE, slots.init(SLOT_CNT, 0, ObMemAttr(OB_SERVER_TENANT_ID, "LCLookupSlot")));
+  EXPECT_TRUE(slots.is_inited());
+  slots.destroy();
+  EXPECT_FALSE(slots.is_inited());
+}
+
+TEST_F(TestLCLookupSlots, publish_and_retire)
+{
+  MockLookupSlots slots(get_qclock());
+  MockReclaim reclaim;
+  ASSERT_EQ(OB_SUCCESS, slots.init(SLOT_CNT, 1000 * 1000, ObMemAttr(OB_SERVER_TENANT_ID, "LCLookupSlot")));
+  MockNode node(1);
+  MockKey key(1);
+  MockLookup lookup;
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, slots.lookup(key, lookup));
+  slots.publish(&node);
+  EXPECT_EQ(OB_SUCCESS, slots.lookup(key, lookup));
+  EXPECT_EQ(&node, lookup.node_);
+  // the error of fn is passed through
+  auto fail_lookup = [](MockNode &) -> int { return OB_EAGAIN; };
+  EXPECT_EQ(OB_EAGAIN, slots.lookup(key, fail_lookup));
+
+  // a key hashed to the same slot does not take over an active node
+  int64_t conflict_v = 2;
+  while ((MockKey(conflict_v).hash() & (SLOT_CNT - 1)) != (key.hash() & (SLOT_CNT - 1))) {
+    ++conflict_v;
+  }
+  MockNode conflict_node(conflict_v);
+  MockKey conflict_key(conflict_v);
+  node.last_active_ts_ = ObClockGenerator::getClock();
+  slots.publish(&conflict_node);
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, slots.lookup(conflict_key, lookup));
+  EXPECT_EQ(OB_SUCCESS, slots.lookup(key, lookup));
+  // but takes over an idle one
+  node.last_active_ts_ = 0;
+  slots.publish(&conflict_node);
+  EXPECT_EQ(OB_SUCCESS, slots.lookup(conflict_key, lookup));
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, slots.lookup(key, lookup));
+
+  // a removed node is neither looked up nor published
+  slots.unpublish(&conflict_node);
+  EXPECT_TRUE(conflict_node.is_removed());
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, slots.lookup(conflict_key, lookup));
+  slots.publish(&conflict_node);
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, slots.lookup(conflict_key, lookup));
+
+  // retired nodes are reclaimed after two quiescent points
+  slots.publish(&node);
+  EXPECT_EQ(OB_SUCCESS, slots.lookup(key, lookup));
+  slots.retire(&node);
+  slots.retire(&conflict_node);
+  EXPECT_EQ(2, slots.get_retire_cnt());
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, slots.lookup(key, lookup));
+  slots.reclaim(true /*force*/, reclaim);
+  EXPECT_EQ(0, slots.get_retire_cnt());
+  EXPECT_EQ(2, reclaim.reclaimed_.size());
+  EXPECT_EQ(MockNode::DEAD, node.magic_);
+  EXPECT_EQ(MockNode::DEAD, conflict_node.magic_);
+}
+
+// readers look up hot keys while writers keep replacing the nodes of the keys, the way
+// ObPlanCache erases a node from the map and retires it once unreferenced. No reader may
+// see a node after it has been reclaimed.
+TEST_F(TestLCLookupSlots, concurrent_retire)
+{
+  const int64_t KEY_CNT = 16;
+  const int64_t READER_CNT = 8;
+  const int64_t WRITER_CNT = 2;
+  const int64_t REPLACE_CNT = 20000;
+  MockLookupSlots slots(get_qclock());
+  ASSERT_EQ(OB_SUCCESS, slots.init(SLOT_CNT, 0, ObMemAttr(OB_SERVER_TENANT_ID, "LCLookupSlot")));
+  // one reclaim functor per writer, reclaim is called by all of them
+  std::vector<MockReclaim> reclaims(WRITER_CNT + 1);
+  MockNode *nodes[KEY_CNT];
+  for (int64_t i = 0; i < KEY_CNT; ++i) {
+    nodes[i] = new MockNode(i);
+    slots.publish(nodes[i]);
+  }
+  bool stop = false;
+  int64_t dead_cnt = 0;
+  int64_t hit_cnt = 0;
+  std::vector<std::thread> readers;
+  for (int64_t t = 0; t < READER_CNT; ++t) {
+    readers.emplace_back([&, t]() {
+      MockLookup lookup;
+      int64_t hit = 0;
+      for (int64_t i = t; !ATOMIC_LOAD(&stop); ++i) {
+        MockKey key(i % KEY_CNT);
+        if (OB_SUCCESS == slots.lookup(key, lookup)) {
+          ++hit;
+        }
+      }
+      ATOMIC_AAF(&dead_cnt, lookup.dead_cnt_);
+      ATOMIC_AAF(&hit_cnt, hit);
+    });
+  }
+  std::vector<std::thread> writers;
+  for (int64_t t = 0; t < WRITER_CNT; ++t) {
+    writers.emplace_back([&, t]() {
+      for (int64_t i = 0; i < REPLACE_CNT; ++i) {
+        // each writer owns the keys of its own parity
+        const int64_t k = (i * WRITER_CNT + t) % KEY_CNT;
+        MockNode *new_node = new MockNode(k);
+        MockNode *old_node = nodes[k];
+        nodes[k] = new_node;
+        slots.unpublish(old_node);
+        slots.publish(new_node);
+        slots.retire(old_node);
+        if (0 == i % 64) {
+          slots.reclaim(false /*force*/, reclaims.at(t));
+        }
+      }
+    });
+  }
+  for (std::thread &th : writers) {
+    th.join();
+  }
+  ATOMIC_STORE(&stop, true);
+  for (std::thread &th : readers) {
+    th.join();
+  }
+  for (int64_t i = 0; i < KEY_CNT; ++i) {
+    slots.retire(nodes[i]);
+  }
+  slots.reclaim(true /*force*/, reclaims.at(WRITER_CNT));
+  EXPECT_EQ(0, slots.get_retire_cnt());
+  EXPECT_EQ(0, dead_cnt);
+  EXPECT_LT(0, hit_cnt);
+  int64_t reclaimed_cnt = 0;
+  for (MockReclaim &reclaim : reclaims) {
+    reclaimed_cnt += reclaim.reclaimed_.size();
+    for (MockNode *node : reclaim.reclaimed_) {
+      delete node;
+    }
+  }
+  EXPECT_EQ(WRITER_CNT * REPLACE_CNT + KEY_CNT, reclaimed_cnt);
+  slots.destroy();
+}
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_lc_lookup_slots.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,187 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+// Microbenchmark of the plan cache hit path against thread count, it compares
+//   map:       bucket latch of the hashmap + node reference count + node stat update,
+//              i.e. ObPlanCache::get_value with ObLibCacheRlockAndRef
+//   lock free: QClock critical section + lookup slot + node reference count taken inside the
+//              section + throttled node stat update, i.e. ObPlanCache::lock_free_get_cache_obj
+// both paths take the TCRWLock read lock of the node as the real one does.
+//
+// usage: ./test_pc_lookup_perf [max_thread_cnt] [lookup_cnt_per_thread]
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "lib/allocator/ob_retire_station.h"
+#include "lib/cpu/ob_cpu_topology.h"
+#include "lib/hash/ob_hashmap.h"
+#include "lib/lock/ob_tc_rwlock.h"
+#include "lib/time/ob_time_utility.h"
+#include "common/ob_clock_generator.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+
+static int64_t g_max_thread_cnt = 0;
+static int64_t g_lookup_cnt = 1000000;
+
+struct MockNode
+{
+  MockNode(const uint64_t key) : rwlock_(), ref_count_(0), key_(key), last_active_ts_(0), execute_count_(0) {}
+  TCRWLock rwlock_;
+  int64_t ref_count_;
+  uint64_t key_;
+  int64_t last_active_ts_;
+  int64_t execute_count_;
+};
+
+typedef hash::ObHashMap<uint64_t, MockNode *> MockNodeMap;
+
+struct MockRlockAndRef
+{
+  MockRlockAndRef() : node_(nullptr) {}
+  void operator()(hash::HashMapPair<uint64_t, MockNode *> &entry)
+  {
+    node_ = entry.second;
+    ATOMIC_AAF(&node_->ref_count_, 1);
+  }
+  MockNode *node_;
+};
+
+class TestPCLookupPerf : public ::testing::Test
+{
+public:
+  static const int64_t KEY_CNT = 64;
+  static const int64_t SLOT_CNT = 1L << 13;
+  virtual void SetUp() override
+  {
+    ASSERT_EQ(OB_SUCCESS, map_.create(hash::cal_next_prime(1024), "PCLookupPerf"));
+    MEMSET(slots_, 0, sizeof(slots_));
+    for (int64_t i = 0; i < KEY_CNT; ++i) {
+      MockNode *node = new MockNode(murmurhash(&i, sizeof(i), 0));
+      // referenced by the map
+      node->ref_count_ = 1;
+      nodes_.push_back(node);
+      ASSERT_EQ(OB_SUCCESS, map_.set_refactored(node->key_, node));
+      slots_[node->key_ & (SLOT_CNT - 1)] = node;
+    }
+  }
+  virtual void TearDown() override
+  {
+    map_.destroy();
+    for (MockNode *node : nodes_) {
+      delete node;
+    }
+    nodes_.clear();
+  }
+  bool map_lookup(const uint64_t key)
+  {
+    bool found = false;
+    MockRlockAndRef op;
+    if (OB_SUCCESS == map_.read_atomic(key, op) && nullptr != op.node_) {
+      MockNode *node = op.node_;
+      node->rwlock_.rdlock();
+      ATOMIC_STORE(&node->last_active_ts_, ObClockGenerator::getClock());
+      ATOMIC_INC(&node->execute_count_);
+      found = true;
+      node->rwlock_.rdunlock();
+      ATOMIC_SAF(&node->ref_count_, 1);
+    }
+    return found;
+  }
+  bool lock_free_lookup(const uint64_t key)
+  {
+    bool found = false;
+    MockNode *node = nullptr;
+    {
+      // only take a reference inside the critical section
+      QClockGuard guard(qclock_);
+      MockNode *slot_node = ATOMIC_LOAD(&slots_[key & (SLOT_CNT - 1)]);
+      if (nullptr != slot_node && key == slot_node->key_) {
+        int64_t ref_count = ATOMIC_LOAD(&slot_node->ref_count_);
+        while (ref_count > 0 && nullptr == node) {
+          const int64_t old_ref_count = ref_count;
+          if (old_ref_count == (ref_count = ATOMIC_VCAS(&slot_node->ref_count_, old_ref_count, old_ref_count + 1))) {
+            node = slot_node;
+          }
+        }
+      }
+    }
+    if (nullptr != node) {
+      node->rwlock_.rdlock();
+      const int64_t cur_ts = ObClockGenerator::getClock();
+      if (cur_ts - ATOMIC_LOAD(&node->last_active_ts_) > 10 * 1000) {
+        ATOMIC_STORE(&node->last_active_ts_, cur_ts);
+      }
+      ATOMIC_INC(&node->execute_count_);
+      found = true;
+      node->rwlock_.rdunlock();
+      ATOMIC_SAF(&node->ref_count_, 1);
+    }
+    return found;
+  }
+  // return average latency of one hit in ns
+  template <typename Lookup>
+  int64_t run(const int64_t thread_cnt, Lookup lookup)
+  {
+    std::vector<std::thread> threads;
+    int64_t miss_cnt = 0;
+    const int64_t start_ts = ObTimeUtility::current_time();
+    for (int64_t t = 0; t < thread_cnt; ++t) {
+      threads.emplace_back([&, t]() {
+        int64_t miss = 0;
+        for (int64_t i = 0; i < g_lookup_cnt; ++i) {
+          // point queries concentrated on a few hot statements
+          if (!lookup(nodes_[(i + t) % 4]->key_)) {
+            ++miss;
+          }
+        }
+        ATOMIC_AAF(&miss_cnt, miss);
+      });
+    }
+    for (std::thread &th : threads) {
+      th.join();
+    }
+    const int64_t elapsed_us = ObTimeUtility::current_time() - start_ts;
+    EXPECT_EQ(0, miss_cnt);
+    return elapsed_us * 1000 / g_lookup_cnt;
+  }
+protected:
+  MockNodeMap map_;
+  std::vector<MockNode *> nodes_;
+  MockNode *slots_[SLOT_CNT];
+  QClock qclock_;
+};
+
+TEST_F(TestPCLookupPerf, hit_latency)
+{
+  const int64_t max_thread_cnt = g_max_thread_cnt > 0 ? g_max_thread_cnt : get_cpu_count();
+  fprintf(stdout, "%10s %16s %16s\n", "threads", "map(ns/hit)", "lock_free(ns/hit)");
+  for (int64_t thread_cnt = 1; thread_cnt <= max_thread_cnt; thread_cnt *= 2) {
+    const int64_t map_ns = run(thread_cnt, [this](const uint64_t key) { return map_lookup(key); });
+    const int64_t lock_free_ns = run(thread_cnt, [this](const uint64_t key) { return lock_free_lookup(key); });
+    fprintf(stdout, "%10ld %16ld %16ld\n", thread_cnt, map_ns, lock_free_ns);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  if (argc > 1) {
+    g_max_thread_cnt = atoll(argv[1]);
+  }
+  if (argc > 2) {
+    g_lookup_cnt = std::max(1LL, atoll(argv[2]));
+  }
+  return RUN_ALL_TESTS();
+}
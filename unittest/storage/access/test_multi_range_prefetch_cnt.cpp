@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2024 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#define USING_LOG_PREFIX STORAGE
+#include "storage/access/ob_index_tree_prefetcher.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace storage;
+namespace unittest
+{
+
+typedef ObIndexTreeMultiPassPrefetcher<> Prefetcher;
+typedef ObIndexTreeMultiPassPrefetcher<2, 2> SmallPrefetcher;
+
+class TestMultiRangePrefetchCnt : public ::testing::Test
+{
+public:
+  static constexpr int32_t MIN_CNT = Prefetcher::DEFAULT_SCAN_RANGE_PREFETCH_CNT;
+  static constexpr int32_t MAX_CNT = Prefetcher::MAX_SCAN_RANGE_PREFETCH_CNT;
+  static constexpr int32_t HANDLE_CNT = Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+  static constexpr int32_t SMALL_MIN_CNT = SmallPrefetcher::DEFAULT_SCAN_RANGE_PREFETCH_CNT;
+  static constexpr int32_t SMALL_HANDLE_CNT = SmallPrefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+  static constexpr int64_t MEM_LIMIT = Prefetcher::MULTI_RANGE_PREFETCH_MEM_LIMIT;
+  static constexpr int64_t MICRO_SIZE = 16L << 10;
+};
+
+TEST_F(TestMultiRangePrefetchCnt, grow_with_range_count)
+{
+  int32_t last_cnt = MIN_CNT;
+  for (int32_t range_count = MIN_CNT + 1; range_count <= MAX_CNT; ++range_count) {
+    const int32_t cnt = Prefetcher::calc_multi_range_prefetch_cnt(range_count, MICRO_SIZE, HANDLE_CNT, MIN_CNT);
+    ASSERT_EQ(range_count, cnt);
+    ASSERT_GT(cnt, last_cnt);
+    last_cnt = cnt;
+  }
+}
+
+TEST_F(TestMultiRangePrefetchCnt, shrink_with_micro_size)
+{
+  const int32_t range_count = MAX_CNT * 4;
+  ASSERT_EQ(MAX_CNT, Prefetcher::calc_multi_range_prefetch_cnt(range_count, MICRO_SIZE, HANDLE_CNT, MIN_CNT));
+  // window holds at most MEM_LIMIT of micro blocks
+  ASSERT_EQ(MEM_LIMIT / (128L << 10), Prefetcher::calc_multi_range_prefetch_cnt(range_count, 128L << 10, HANDLE_CNT, MIN_CNT));
+  ASSERT_EQ(MEM_LIMIT / (256L << 10), Prefetcher::calc_multi_range_prefetch_cnt(range_count, 256L << 10, HANDLE_CNT, MIN_CNT));
+  // bounded by the micro data handle ring
+  ASSERT_EQ(MIN_CNT + 2, Prefetcher::calc_multi_range_prefetch_cnt(range_count, MICRO_SIZE, MIN_CNT + 2, MIN_CNT));
+}
+
+TEST_F(TestMultiRangePrefetchCnt, clamp_at_bounds)
+{
+  // upper bound
+  ASSERT_EQ(MAX_CNT, Prefetcher::calc_multi_range_prefetch_cnt(MAX_CNT + 1, MICRO_SIZE, HANDLE_CNT, MIN_CNT));
+  ASSERT_EQ(MAX_CNT, Prefetcher::calc_multi_range_prefetch_cnt(INT32_MAX, 1, INT32_MAX, MIN_CNT));
+  // lower bound, never below the default window
+  ASSERT_EQ(MIN_CNT, Prefetcher::calc_multi_range_prefetch_cnt(1, MICRO_SIZE, HANDLE_CNT, MIN_CNT));
+  ASSERT_EQ(MIN_CNT, Prefetcher::calc_multi_range_prefetch_cnt(MAX_CNT, MEM_LIMIT * 2, HANDLE_CNT, MIN_CNT));
+  ASSERT_EQ(MIN_CNT, Prefetcher::calc_multi_range_prefetch_cnt(MAX_CNT, MICRO_SIZE, 1, MIN_CNT));
+  ASSERT_EQ(SMALL_MIN_CNT, SmallPrefetcher::calc_multi_range_prefetch_cnt(MAX_CNT, MICRO_SIZE, SMALL_HANDLE_CNT, SMALL_MIN_CNT));
+  // empty sstable
+  ASSERT_EQ(MAX_CNT, Prefetcher::calc_multi_range_prefetch_cnt(MAX_CNT, 0, HANDLE_CNT, MIN_CNT));
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_multi_range_prefetch_cnt.log*");
+  OB_LOGGER.set_file_name("test_multi_range_prefetch_cnt.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,354 @@
+/**
+ * Copyright (c) 2024 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#define USING_LOG_PREFIX STORAGE
+#include "share/rc/ob_tenant_base.h"
+#include "sql/engine/ob_exec_context.h"
+#include "storage/access/ob_pushdown_aggregate_vec.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+using namespace storage;
+namespace unittest
+{
+
+// aggregate cells: MIN/MAX over the group by column, MIN/MAX over another column
+class TestPushdownAggregateVec : public ::testing::Test
+{
+public:
+  static const int64_t BATCH_SIZE = 256;
+  static const int64_t AGG_CNT = 4;
+  static const int32_t GROUP_BY_COL_OFFSET = 0;
+  static const int32_t OTHER_COL_OFFSET = 1;
+  TestPushdownAggregateVec()
+    : allocator_(),
+      tenant_base_(OB_SYS_TENANT_ID),
+      exec_ctx_(allocator_),
+      eval_ctx_(exec_ctx_),
+      pd_agg_ctx_(nullptr),
+      frame_(nullptr)
+  {}
+  virtual ~TestPushdownAggregateVec() {}
+  virtual void SetUp() override;
+  virtual void TearDown() override;
+  void prepare_col_expr();
+  void prepare_agg_expr(sql::ObExpr &agg_expr, const ObItemType type, sql::ObExpr **arg);
+  void init_agg_cells(const int64_t distinct_cnt);
+  void set_col_values(const int64_t *values, const int64_t count);
+  bool get_result(const int64_t agg_idx, const int64_t ref, int64_t &value);
+protected:
+  ObArenaAllocator allocator_;
+  ObTenantBase tenant_base_;
+  sql::ObExecContext exec_ctx_;
+  sql::ObEvalCtx eval_ctx_;
+  ObPushdownAggContext *pd_agg_ctx_;
+  ObTableAccessParam access_param_;
+  ObSEArray<sql::ObExpr *, AGG_CNT> agg_exprs_;
+  ObSEArray<int32_t, AGG_CNT> agg_cols_project_;
+  sql::ObExpr group_by_expr_;
+  sql::ObExpr col_expr_;
+  sql::ObExpr *group_by_expr_ptr_;
+  sql::ObExpr *col_expr_ptr_;
+  sql::ObExpr agg_expr_buf_[AGG_CNT];
+  ObAggCellVec *agg_cells_[AGG_CNT];
+  char *frame_;
+};
+
+void TestPushdownAggregateVec::SetUp()
+{
+  ObTenantEnv::set_tenant(&tenant_base_);
+  void *skip_buf = allocator_.alloc(sql::ObBitVector::memory_size(BATCH_SIZE));
+  void *ctx_buf = allocator_.alloc(sizeof(ObPushdownAggContext));
+  ASSERT_NE(nullptr, skip_buf);
+  ASSERT_NE(nullptr, ctx_buf);
+  sql::ObBitVector *skip_bit = sql::to_bit_vector(skip_buf);
+  skip_bit->reset(BATCH_SIZE);
+  pd_agg_ctx_ = new (ctx_buf) ObPushdownAggContext(BATCH_SIZE, eval_ctx_, skip_bit, allocator_);
+
+  group_by_expr_.reset();
+  group_by_expr_.datum_meta_.type_ = ObIntType;
+  group_by_expr_.obj_meta_.set_int();
+  group_by_expr_ptr_ = &group_by_expr_;
+  prepare_col_expr();
+  col_expr_ptr_ = &col_expr_;
+
+  prepare_agg_expr(agg_expr_buf_[0], T_FUN_MIN, &group_by_expr_ptr_);
+  prepare_agg_expr(agg_expr_buf_[1], T_FUN_MAX, &group_by_expr_ptr_);
+  prepare_agg_expr(agg_expr_buf_[2], T_FUN_MIN, &col_expr_ptr_);
+  prepare_agg_expr(agg_expr_buf_[3], T_FUN_MAX, &col_expr_ptr_);
+  for (int64_t i = 0; i < AGG_CNT; ++i) {
+    ASSERT_EQ(OB_SUCCESS, agg_exprs_.push_back(&agg_expr_buf_[i]));
+    ASSERT_EQ(OB_SUCCESS, agg_cols_project_.push_back(i < 2 ? GROUP_BY_COL_OFFSET : OTHER_COL_OFFSET));
+    agg_cells_[i] = nullptr;
+  }
+  access_param_.aggregate_exprs_ = &agg_exprs_;
+  access_param_.iter_param_.agg_cols_project_ = &agg_cols_project_;
+}
+
+void TestPushdownAggregateVec::TearDown()
+{
+  for (int64_t i = 0; i < AGG_CNT; ++i) {
+    if (nullptr != agg_cells_[i]) {
+      agg_cells_[i]->~ObAggCellVec();
+      agg_cells_[i] = nullptr;
+    }
+  }
+  if (nullptr != pd_agg_ctx_) {
+    pd_agg_ctx_->~ObPushdownAggContext();
+    pd_agg_ctx_ = nullptr;
+  }
+  agg_exprs_.reset();
+  agg_cols_project_.reset();
+  allocator_.reset();
+  ObTenantEnv::set_tenant(nullptr);
+}
+
+// the column not grouped by is projected into a uniform vector, same as ObVectorStore does
+void TestPushdownAggregateVec::prepare_col_expr()
+{
+  int64_t cur_total_size = 0;
+  col_expr_.reset();
+  col_expr_.batch_result_ = 1;
+  col_expr_.frame_idx_ = 0;
+  col_expr_.res_buf_len_ = sizeof(int64_t);
+  col_expr_.datum_meta_.type_ = ObIntType;
+  col_expr_.obj_meta_.set_int();
+  col_expr_.vec_value_tc_ = VEC_TC_INTEGER;
+  col_expr_.is_fixed_length_data_ = true;
+  col_expr_.datum_off_ = cur_total_size;
+  cur_total_size += sizeof(ObDatum) * BATCH_SIZE;
+  col_expr_.pvt_skip_off_ = cur_total_size;
+  cur_total_size += sql::ObBitVector::memory_size(BATCH_SIZE);
+  col_expr_.vector_header_off_ = cur_total_size;
+  cur_total_size += sizeof(sql::VectorHeader);
+  col_expr_.null_bitmap_off_ = cur_total_size;
+  cur_total_size += sql::ObBitVector::memory_size(BATCH_SIZE);
+  col_expr_.eval_info_off_ = cur_total_size;
+  cur_total_size += sizeof(sql::ObEvalInfo);
+  col_expr_.eval_flags_off_ = cur_total_size;
+  cur_total_size += sql::ObBitVector::memory_size(BATCH_SIZE);
+  col_expr_.dyn_buf_header_offset_ = cur_total_size;
+  col_expr_.res_buf_off_ = cur_total_size;
+  cur_total_size += col_expr_.res_buf_len_ * BATCH_SIZE;
+
+  char **frame_arr = static_cast<char **>(allocator_.alloc(sizeof(char *)));
+  frame_ = static_cast<char *>(allocator_.alloc(cur_total_size));
+  ASSERT_NE(nullptr, frame_arr);
+  ASSERT_NE(nullptr, frame_);
+  MEMSET(frame_, 0, cur_total_size);
+  eval_ctx_.frames_ = frame_arr;
+  eval_ctx_.frames_[0] = frame_;
+  eval_ctx_.batch_size_ = BATCH_SIZE;
+  eval_ctx_.max_batch_size_ = BATCH_SIZE;
+  ASSERT_EQ(OB_SUCCESS, col_expr_.init_vector(eval_ctx_, VEC_UNIFORM, BATCH_SIZE));
+  col_expr_.reset_datums_ptr(frame_, BATCH_SIZE);
+}
+
+void TestPushdownAggregateVec::prepare_agg_expr(sql::ObExpr &agg_expr, const ObItemType type, sql::ObExpr **arg)
+{
+  agg_expr.reset();
+  agg_expr.type_ = type;
+  agg_expr.datum_meta_.type_ = ObIntType;
+  agg_expr.obj_meta_.set_int();
+  agg_expr.arg_cnt_ = 1;
+  agg_expr.args_ = arg;
+}
+
+void TestPushdownAggregateVec::init_agg_cells(const int64_t distinct_cnt)
+{
+  ASSERT_EQ(OB_SUCCESS, pd_agg_ctx_->init(access_param_, distinct_cnt));
+  for (int64_t i = 0; i < AGG_CNT; ++i) {
+    ObAggCellVecBasicInfo basic_info(pd_agg_ctx_->agg_ctx_, pd_agg_ctx_->rows_, pd_agg_ctx_->row_meta_,
+                                     pd_agg_ctx_->batch_rows_, agg_cols_project_.at(i), nullptr, false);
+    void *buf = nullptr;
+    if (T_FUN_MIN == agg_exprs_.at(i)->type_) {
+      ASSERT_NE(nullptr, buf = allocator_.alloc(sizeof(ObMinAggCellVec)));
+      agg_cells_[i] = new (buf) ObMinAggCellVec(i, basic_info, allocator_);
+    } else {
+      ASSERT_NE(nullptr, buf = allocator_.alloc(sizeof(ObMaxAggCellVec)));
+      agg_cells_[i] = new (buf) ObMaxAggCellVec(i, basic_info, allocator_);
+    }
+    ASSERT_EQ(OB_SUCCESS, agg_cells_[i]->init());
+  }
+}
+
+void TestPushdownAggregateVec::set_col_values(const int64_t *values, const int64_t count)
+{
+  ObDatum *datums = col_expr_.locate_batch_datums(eval_ctx_);
+  for (int64_t i = 0; i < count; ++i) {
+    if (values[i] < 0) {
+      datums[i].set_null();
+    } else {
+      datums[i].set_int(values[i]);
+    }
+  }
+}
+
+bool TestPushdownAggregateVec::get_result(const int64_t agg_idx, const int64_t ref, int64_t &value)
+{
+  aggregate::AggrRowPtr row = static_cast<char *>(pd_agg_ctx_->rows_[ref]->get_extra_payload(pd_agg_ctx_->row_meta_));
+  char *cell = pd_agg_ctx_->agg_ctx_.row_meta().locate_cell_payload(agg_idx, row);
+  value = *reinterpret_cast<const int64_t *>(cell);
+  return pd_agg_ctx_->agg_ctx_.locate_notnulls_bitmap(agg_idx, cell).at(agg_idx);
+}
+
+TEST_F(TestPushdownAggregateVec, group_by_column)
+{
+  // distinct values of the group by column: 100, 101, ..., 108, NULL
+  const int64_t DISTINCT_CNT = 10;
+  const int64_t LARGE_DISTINCT_CNT = 50;
+  const int64_t ROW_CNT = 200;
+  init_agg_cells(LARGE_DISTINCT_CNT);
+  ObDatum distinct_datums[DISTINCT_CNT];
+  int64_t distinct_vals[DISTINCT_CNT];
+  for (int64_t i = 0; i < DISTINCT_CNT; ++i) {
+    distinct_vals[i] = 100 + i;
+    distinct_datums[i].ptr_ = reinterpret_cast<const char *>(&distinct_vals[i]);
+    distinct_datums[i].pack_ = sizeof(int64_t);
+  }
+  distinct_datums[DISTINCT_CNT - 1].set_null();
+  // ref 3 does not appear in this batch
+  uint32_t refs[ROW_CNT];
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    refs[i] = (i * 7) % DISTINCT_CNT;
+    if (3 == refs[i]) {
+      refs[i] = 4;
+    }
+  }
+  for (int64_t i = 0; i < 2; ++i) {
+    ASSERT_EQ(OB_SUCCESS, agg_cells_[i]->eval_batch_in_group_by(distinct_datums, ROW_CNT, refs, DISTINCT_CNT, true, false));
+    ASSERT_EQ(DISTINCT_CNT, agg_cells_[i]->distinct_ref_bitmap_size_);
+  }
+  int64_t value = 0;
+  for (int64_t ref = 0; ref < DISTINCT_CNT; ++ref) {
+    for (int64_t i = 0; i < 2; ++i) {
+      if (3 == ref || DISTINCT_CNT - 1 == ref) {
+        ASSERT_FALSE(get_result(i, ref, value)) << "agg_idx=" << i << " ref=" << ref;
+      } else {
+        ASSERT_TRUE(get_result(i, ref, value)) << "agg_idx=" << i << " ref=" << ref;
+        ASSERT_EQ(distinct_vals[ref], value);
+      }
+    }
+  }
+
+  // a larger dictionary in the next micro block grows the bitmap, results are accumulated
+  ObDatum large_datums[LARGE_DISTINCT_CNT];
+  int64_t large_vals[LARGE_DISTINCT_CNT];
+  for (int64_t i = 0; i < LARGE_DISTINCT_CNT; ++i) {
+    large_vals[i] = 1000 - i;
+    large_datums[i].ptr_ = reinterpret_cast<const char *>(&large_vals[i]);
+    large_datums[i].pack_ = sizeof(int64_t);
+  }
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    refs[i] = i % LARGE_DISTINCT_CNT;
+  }
+  ASSERT_EQ(OB_SUCCESS, agg_cells_[0]->eval_batch_in_group_by(large_datums, ROW_CNT, refs, LARGE_DISTINCT_CNT, true, false));
+  ASSERT_EQ(LARGE_DISTINCT_CNT, agg_cells_[0]->distinct_ref_bitmap_size_);
+  ASSERT_TRUE(get_result(0, 0, value));
+  ASSERT_EQ(100, value);
+  ASSERT_TRUE(get_result(0, 3, value));
+  ASSERT_EQ(997, value);
+  ASSERT_TRUE(get_result(0, LARGE_DISTINCT_CNT - 1, value));
+  ASSERT_EQ(1000 - LARGE_DISTINCT_CNT + 1, value);
+
+  ASSERT_EQ(OB_INVALID_ARGUMENT, agg_cells_[0]->eval_batch_in_group_by(large_datums, ROW_CNT, nullptr, LARGE_DISTINCT_CNT, true, false));
+}
+
+TEST_F(TestPushdownAggregateVec, default_datum)
+{
+  // the column is not in the sstable, every row reads the default value
+  const int64_t DISTINCT_CNT = 8;
+  const int64_t ROW_CNT = 100;
+  init_agg_cells(DISTINCT_CNT);
+  ObDatum default_datum;
+  int64_t default_val = 7;
+  default_datum.ptr_ = reinterpret_cast<const char *>(&default_val);
+  default_datum.pack_ = sizeof(int64_t);
+  uint32_t refs[ROW_CNT];
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    refs[i] = i % (DISTINCT_CNT - 1);
+  }
+  for (int64_t i = 2; i < AGG_CNT; ++i) {
+    ASSERT_EQ(OB_SUCCESS, agg_cells_[i]->eval_batch_in_group_by(&default_datum, ROW_CNT, refs, DISTINCT_CNT, false, true));
+  }
+  int64_t value = 0;
+  for (int64_t ref = 0; ref < DISTINCT_CNT; ++ref) {
+    for (int64_t i = 2; i < AGG_CNT; ++i) {
+      if (DISTINCT_CNT - 1 == ref) {
+        ASSERT_FALSE(get_result(i, ref, value));
+      } else {
+        ASSERT_TRUE(get_result(i, ref, value));
+        ASSERT_EQ(default_val, value);
+      }
+    }
+  }
+}
+
+TEST_F(TestPushdownAggregateVec, other_column)
+{
+  // the column is not grouped by, its values are aggregated row by row into the group of each ref
+  const int64_t DISTINCT_CNT = 5;
+  const int64_t ROW_CNT = 200;
+  init_agg_cells(DISTINCT_CNT);
+  int64_t values[ROW_CNT];
+  uint32_t refs[ROW_CNT];
+  int64_t expect_min[DISTINCT_CNT];
+  int64_t expect_max[DISTINCT_CNT];
+  for (int64_t ref = 0; ref < DISTINCT_CNT; ++ref) {
+    expect_min[ref] = INT64_MAX;
+    expect_max[ref] = -1;
+  }
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    refs[i] = i % DISTINCT_CNT;
+    // all values of ref 4 are null, rows of the same ref carry different values
+    values[i] = 4 == refs[i] ? -1 : (i * 37) % 101;
+    if (values[i] >= 0) {
+      expect_min[refs[i]] = MIN(expect_min[refs[i]], values[i]);
+      expect_max[refs[i]] = MAX(expect_max[refs[i]], values[i]);
+    }
+  }
+  set_col_values(values, ROW_CNT);
+  for (int64_t i = 2; i < AGG_CNT; ++i) {
+    ASSERT_EQ(OB_SUCCESS, agg_cells_[i]->eval_batch_in_group_by(nullptr, ROW_CNT, refs, DISTINCT_CNT, false, false));
+    // the per ref path is not taken
+    ASSERT_EQ(0, agg_cells_[i]->distinct_ref_bitmap_size_);
+  }
+  int64_t value = 0;
+  for (int64_t ref = 0; ref < DISTINCT_CNT; ++ref) {
+    if (4 == ref) {
+      ASSERT_FALSE(get_result(2, ref, value));
+      ASSERT_FALSE(get_result(3, ref, value));
+    } else {
+      ASSERT_TRUE(get_result(2, ref, value));
+      ASSERT_EQ(expect_min[ref], value) << "ref=" << ref;
+      ASSERT_TRUE(get_result(3, ref, value));
+      ASSERT_EQ(expect_max[ref], value) << "ref=" << ref;
+    }
+  }
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_pushdown_aggregate_vec.log*");
+  OB_LOGGER.set_file_name("test_pushdown_aggregate_vec.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,7 @@
 #define private public
 #include "lib/string/ob_sql_string.h"
 #include "storage/blocksstable/index_block/ob_index_block_aggregator.h"
+#include "share/datum/ob_datum_funcs.h"
 #include "ob_row_generate.h"
 
 
@@ -619,6 +620,80 @@ TEST_F(TestIndexBlockAggregator, test_sum)
   }
 }
 
+TEST_F(TestIndexBlockAggregator, test_bloom_filter)
+{
+  static const int64_t test_column_cnt = 2;
+  const int64_t test_row_cnt = 20;
+  ObObjType col_obj_types[test_column_cnt];
+  col_obj_types[0] = ObIntType;
+  col_obj_types[1] = ObIntType;
+  init_schema(test_column_cnt, col_obj_types);
+  ObSkipIndexColMeta meta;
+  meta.col_idx_ = 0;
+  meta.col_type_ = SK_IDX_NULL_COUNT;
+  ASSERT_EQ(OB_SUCCESS, full_agg_metas_.push_back(meta));
+  meta.col_type_ = SK_IDX_BLOOM_FILTER;
+  ASSERT_EQ(OB_SUCCESS, full_agg_metas_.push_back(meta));
+
+  ObSkipIndexAggregator data_aggregator;
+  ObSkipIndexAggregator index_aggregator;
+  ObDatumRow data_agg_result;
+  ObDatumRow index_agg_result;
+  ASSERT_EQ(OB_SUCCESS, data_agg_result.init(full_agg_metas_.count()));
+  ASSERT_EQ(OB_SUCCESS, index_agg_result.init(full_agg_metas_.count()));
+  ASSERT_EQ(OB_SUCCESS, data_aggregator.init(full_agg_metas_, col_descs_, true, data_agg_result, allocator_));
+  ASSERT_EQ(OB_SUCCESS, index_aggregator.init(full_agg_metas_, col_descs_, false, index_agg_result, allocator_));
+
+  const sql::ObExprHashFuncType hash_func = ObDatumFuncs::get_basic_func(
+      col_descs_.at(0).col_type_.get_type(), col_descs_.at(0).col_type_.get_collation_type())->murmur_hash_v2_;
+  ObSEArray<uint64_t, test_row_cnt> hashes;
+  const ObDatumRow *data_agg_row = nullptr;
+  const ObDatumRow *index_agg_row = nullptr;
+  ObDatumRow generate_row;
+  ASSERT_EQ(OB_SUCCESS, generate_row.init(full_column_count_));
+  for (int64_t i = 0; i < test_row_cnt; ++i) {
+    uint64_t hash = 0;
+    generate_row_by_seed(i * 2, generate_row);
+    ASSERT_EQ(OB_SUCCESS, hash_func(generate_row.storage_datums_[0], 0, hash));
+    ASSERT_EQ(OB_SUCCESS, hashes.push_back(hash));
+    ASSERT_EQ(OB_SUCCESS, data_aggregator.eval(generate_row));
+    if (1 == i % 5) {
+      // flush a data block every 5 rows
+      ASSERT_EQ(OB_SUCCESS, data_aggregator.get_aggregated_row(data_agg_row));
+      ASSERT_EQ(OB_SUCCESS, index_aggregator.eval(*data_agg_row));
+      data_aggregator.reuse();
+    }
+  }
+  ASSERT_EQ(OB_SUCCESS, data_aggregator.get_aggregated_row(data_agg_row));
+  ASSERT_EQ(OB_SUCCESS, index_aggregator.eval(*data_agg_row));
+  ASSERT_EQ(OB_SUCCESS, index_aggregator.get_aggregated_row(index_agg_row));
+  const ObStorageDatum &bloom_datum = index_agg_row->storage_datums_[1];
+  ASSERT_EQ(ObSkipIndexBloomFilter::BLOOM_FILTER_SIZE, bloom_datum.len_);
+  for (int64_t i = 0; i < hashes.count(); ++i) {
+    ASSERT_TRUE(ObSkipIndexBloomFilter::may_contain(bloom_datum.ptr_, hashes.at(i),
+        ObSkipIndexBloomFilter::VALUE_HASH_CNT));
+  }
+  int64_t false_positive_cnt = 0;
+  for (int64_t i = 0; i < test_row_cnt; ++i) {
+    uint64_t hash = 0;
+    generate_row_by_seed(i * 2 + 1, generate_row);
+    ASSERT_EQ(OB_SUCCESS, hash_func(generate_row.storage_datums_[0], 0, hash));
+    if (ObSkipIndexBloomFilter::may_contain(bloom_datum.ptr_, hash, ObSkipIndexBloomFilter::VALUE_HASH_CNT)) {
+      ++false_positive_cnt;
+    }
+  }
+  ASSERT_LT(false_positive_cnt, test_row_cnt / 2);
+
+  // ngram bloom filter
+  char bitmap[ObSkipIndexBloomFilter::BLOOM_FILTER_SIZE];
+  MEMSET(bitmap, 0, sizeof(bitmap));
+  ObSkipIndexBloomFilter::add_ngrams(bitmap, "oceanbase", 9);
+  ASSERT_TRUE(ObSkipIndexBloomFilter::may_contain_ngrams(bitmap, "eanba", 5));
+  ASSERT_TRUE(ObSkipIndexBloomFilter::may_contain_ngrams(bitmap, "xy", 2));
+  ASSERT_FALSE(ObSkipIndexBloomFilter::may_contain_ngrams(bitmap, "mysql", 5));
+  ASSERT_FALSE(ObSkipIndexBloomFilter::is_saturated(bitmap));
+}
+
 }
 }
 
@@ -0,0 +1,437 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <algorithm>
+
+#define private public
+#define protected public
+#include "storage/blocksstable/ob_micro_block_writer.h"
+#include "storage/blocksstable/ob_micro_block_reader.h"
+#include "storage/access/ob_table_read_info.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+using namespace storage;
+using namespace share::schema;
+
+namespace unittest
+{
+const int64_t ROWKEY_CNT = 2;
+// rowkey columns, trans version, sql sequence and a value column holding the row index
+const int64_t STORE_COLUMN_CNT = ROWKEY_CNT + 3;
+const int64_t READ_COLUMN_CNT = ROWKEY_CNT + 1;
+const int64_t SNAPSHOT_VERSION = 2;
+const int64_t MICRO_BLOCK_SIZE = 2L * 1024 * 1024L;
+
+// the first rowkey column is compared as @type, the second one is always int
+struct Key
+{
+  Key(const int64_t c1, const int64_t c2) : c1_(c1), c2_(c2) {}
+  int64_t c1_;
+  int64_t c2_;
+};
+
+class TestMicroBlockGetReader : public ::testing::Test
+{
+public:
+  TestMicroBlockGetReader() : allocator_(ObModIds::TEST), type_(ObIntType), first_null_(false) {}
+  virtual void SetUp() {}
+  virtual void TearDown() {}
+protected:
+  // build a flat micro block of @keys, which must be in rowkey order, the first
+  // column of the first row is null if @first_null
+  void prepare(const ObObjType type, const std::vector<Key> &keys, const bool first_null = false);
+  void set_first_column(const int64_t c1, ObStorageDatum &datum);
+  bool less(const Key &left, const Key &right) const;
+  int64_t lower_bound(const Key &key) const;
+  // the rowkey is got with the right row or OB_BEYOND_THE_RANGE
+  void check_get(const Key &key);
+  // the range located by interpolation brackets the lower bound of the rowkey,
+  // or covers the whole block if @expect_full
+  void check_range(const Key &key, const bool expect_full);
+  void check_all(const Key &key, const bool expect_full)
+  {
+    check_range(key, expect_full);
+    check_get(key);
+  }
+protected:
+  ObArenaAllocator allocator_;
+  ObObjType type_;
+  bool first_null_;
+  std::vector<Key> keys_;
+  ObMicroBlockWriter writer_;
+  ObMicroBlockData block_;
+  ObTableReadInfo read_info_;
+};
+
+void TestMicroBlockGetReader::set_first_column(const int64_t c1, ObStorageDatum &datum)
+{
+  if (ObUInt64Type == type_) {
+    datum.set_uint(static_cast<uint64_t>(c1));
+  } else if (ObDateTimeType == type_) {
+    datum.set_datetime(c1);
+  } else if (ObVarcharType == type_) {
+    char *buf = static_cast<char *>(allocator_.alloc(32));
+    ASSERT_NE(nullptr, buf);
+    const int64_t len = snprintf(buf, 32, "%020ld", c1);
+    datum.set_string(ObString(len, buf));
+  } else {
+    datum.set_int(c1);
+  }
+}
+
+void TestMicroBlockGetReader::prepare(const ObObjType type, const std::vector<Key> &keys, const bool first_null)
+{
+  type_ = type;
+  first_null_ = first_null;
+  keys_ = keys;
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, STORE_COLUMN_CNT));
+  writer_.data_buffer_.allocator_.set_tenant_id(500);
+  writer_.index_buffer_.allocator_.set_tenant_id(500);
+  ASSERT_EQ(OB_SUCCESS, writer_.init(MICRO_BLOCK_SIZE, ROWKEY_CNT + 2, STORE_COLUMN_CNT));
+  for (int64_t i = 0; i < static_cast<int64_t>(keys.size()); ++i) {
+    if (0 == i && first_null) {
+      row.storage_datums_[0].set_null();
+    } else {
+      set_first_column(keys.at(i).c1_, row.storage_datums_[0]);
+    }
+    row.storage_datums_[1].set_int(keys.at(i).c2_);
+    row.storage_datums_[2].set_int(-SNAPSHOT_VERSION);
+    row.storage_datums_[3].set_int(0);
+    row.storage_datums_[4].set_int(i);
+    row.row_flag_.set_flag(ObDmlFlag::DF_INSERT);
+    ASSERT_EQ(OB_SUCCESS, writer_.append_row(row));
+  }
+  char *buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, writer_.build_block(buf, size));
+  block_ = ObMicroBlockData(buf, size);
+
+  ObArray<ObColDesc> cols_desc;
+  ObColDesc col_desc;
+  col_desc.col_id_ = OB_APP_MIN_COLUMN_ID;
+  col_desc.col_type_.set_type(type);
+  col_desc.col_type_.set_collation_type(ObVarcharType == type ? CS_TYPE_UTF8MB4_BIN : CS_TYPE_BINARY);
+  ASSERT_EQ(OB_SUCCESS, cols_desc.push_back(col_desc));
+  for (int64_t i = 1; i < READ_COLUMN_CNT; ++i) {
+    col_desc.col_id_ = OB_APP_MIN_COLUMN_ID + i;
+    col_desc.col_type_.set_int();
+    col_desc.col_type_.set_collation_type(CS_TYPE_BINARY);
+    ASSERT_EQ(OB_SUCCESS, cols_desc.push_back(col_desc));
+  }
+  read_info_.reset();
+  ASSERT_EQ(OB_SUCCESS, read_info_.init(allocator_, READ_COLUMN_CNT, ROWKEY_CNT,
+      lib::is_oracle_mode(), cols_desc, nullptr/*storage_cols_index*/));
+}
+
+bool TestMicroBlockGetReader::less(const Key &left, const Key &right) const
+{
+  bool bret = false;
+  if (left.c1_ != right.c1_) {
+    bret = ObUInt64Type == type_
+        ? static_cast<uint64_t>(left.c1_) < static_cast<uint64_t>(right.c1_)
+        : left.c1_ < right.c1_;
+  } else {
+    bret = left.c2_ < right.c2_;
+  }
+  return bret;
+}
+
+int64_t TestMicroBlockGetReader::lower_bound(const Key &key) const
+{
+  // the null first column is less than any key searched
+  int64_t idx = first_null_ ? 1 : 0;
+  while (idx < static_cast<int64_t>(keys_.size()) && less(keys_.at(idx), key)) {
+    ++idx;
+  }
+  return idx;
+}
+
+void TestMicroBlockGetReader::check_get(const Key &key)
+{
+  ObStorageDatum datums[ROWKEY_CNT];
+  ObDatumRowkey rowkey;
+  set_first_column(key.c1_, datums[0]);
+  datums[1].set_int(key.c2_);
+  ASSERT_EQ(OB_SUCCESS, rowkey.assign(datums, ROWKEY_CNT));
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, READ_COLUMN_CNT));
+  ObMicroBlockGetReader reader;
+  const int64_t idx = lower_bound(key);
+  const bool exist = idx < static_cast<int64_t>(keys_.size())
+      && !less(key, keys_.at(idx)) && !(first_null_ && 0 == idx);
+  const int ret = reader.get_row(block_, rowkey, read_info_, row);
+  if (exist) {
+    ASSERT_EQ(OB_SUCCESS, ret) << "c1: " << key.c1_ << " c2: " << key.c2_;
+    ASSERT_EQ(idx, row.storage_datums_[ROWKEY_CNT].get_int()) << "c1: " << key.c1_ << " c2: " << key.c2_;
+  } else {
+    ASSERT_EQ(OB_BEYOND_THE_RANGE, ret) << "c1: " << key.c1_ << " c2: " << key.c2_;
+  }
+}
+
+void TestMicroBlockGetReader::check_range(const Key &key, const bool expect_full)
+{
+  ObStorageDatum datums[ROWKEY_CNT];
+  ObDatumRowkey rowkey;
+  set_first_column(key.c1_, datums[0]);
+  datums[1].set_int(key.c2_);
+  ASSERT_EQ(OB_SUCCESS, rowkey.assign(datums, ROWKEY_CNT));
+  ObMicroBlockGetReader reader;
+  int64_t begin_idx = -1;
+  int64_t end_idx = -1;
+  bool end_equal = false;
+  ASSERT_EQ(OB_SUCCESS, reader.inner_init(block_, read_info_, rowkey));
+  ASSERT_EQ(OB_SUCCESS, reader.locate_range_by_interpolation(rowkey, begin_idx, end_idx, end_equal));
+  const int64_t row_count = static_cast<int64_t>(keys_.size());
+  if (expect_full) {
+    ASSERT_EQ(0, begin_idx) << "c1: " << key.c1_ << " c2: " << key.c2_;
+    ASSERT_EQ(row_count, end_idx) << "c1: " << key.c1_ << " c2: " << key.c2_;
+    ASSERT_FALSE(end_equal);
+  } else {
+    const int64_t idx = lower_bound(key);
+    ASSERT_LE(0, begin_idx);
+    ASSERT_LE(end_idx, row_count);
+    ASSERT_LE(begin_idx, idx) << "c1: " << key.c1_ << " c2: " << key.c2_;
+    ASSERT_LE(idx, end_idx) << "c1: " << key.c1_ << " c2: " << key.c2_;
+    if (end_equal) {
+      ASSERT_EQ(idx, end_idx) << "c1: " << key.c1_ << " c2: " << key.c2_;
+      ASSERT_FALSE(less(key, keys_.at(idx)));
+    }
+  }
+}
+
+TEST_F(TestMicroBlockGetReader, dense_keys)
+{
+  std::vector<Key> keys;
+  for (int64_t i = 0; i < 200; ++i) {
+    keys.push_back(Key(1000 + i, 0));
+  }
+  prepare(ObIntType, keys);
+  for (int64_t i = 1000; i < 1200; ++i) {
+    check_all(Key(i, 0), false);
+    check_all(Key(i, -1), false);
+    check_all(Key(i, 1), false);
+  }
+  // bounds of the block
+  check_all(Key(1000, INT64_MIN), false);
+  check_all(Key(1199, INT64_MAX), false);
+}
+
+TEST_F(TestMicroBlockGetReader, sparse_keys)
+{
+  std::vector<Key> keys;
+  for (int64_t i = 0; i < 100; ++i) {
+    keys.push_back(Key(i * 10, 0));
+  }
+  prepare(ObIntType, keys);
+  // keys between the rows are not found, whichever side the guess lands on
+  for (int64_t i = 0; i <= 990; ++i) {
+    check_all(Key(i, 0), false);
+  }
+}
+
+TEST_F(TestMicroBlockGetReader, duplicate_first_column)
+{
+  std::vector<Key> keys;
+  for (int64_t i = 0; i < 200; ++i) {
+    keys.push_back(Key(i / 10, i % 10));
+  }
+  prepare(ObIntType, keys);
+  for (int64_t c1 = 0; c1 < 20; ++c1) {
+    for (int64_t c2 = -1; c2 <= 10; ++c2) {
+      check_all(Key(c1, c2), false);
+    }
+  }
+  // a few distinct values, each repeated through a large part of the block
+  keys.clear();
+  for (int64_t i = 0; i < 100; ++i) {
+    keys.push_back(Key(i < 90 ? 1 : 2 + i / 5, i));
+  }
+  prepare(ObIntType, keys);
+  for (int64_t i = 0; i < 100; ++i) {
+    check_all(keys.at(i), false);
+    check_all(Key(1, i + 1000), false);
+    check_all(Key(keys.at(i).c1_, -1), false);
+  }
+}
+
+TEST_F(TestMicroBlockGetReader, skewed_keys)
+{
+  std::vector<Key> keys;
+  // two far away clusters, the guess of the first cluster is always at the beginning
+  for (int64_t i = 0; i < 100; ++i) {
+    keys.push_back(Key(i < 60 ? i : (1L << 40) + i, 0));
+  }
+  prepare(ObIntType, keys);
+  for (int64_t i = 0; i < 100; ++i) {
+    check_all(keys.at(i), false);
+    check_all(Key(keys.at(i).c1_ + 1, 0), false);
+    check_all(Key(keys.at(i).c1_ - 1, 0), false);
+  }
+  check_all(Key(1L << 39, 0), false);
+
+  // exponential keys
+  keys.clear();
+  for (int64_t i = 0; i < 120; ++i) {
+    keys.push_back(Key(1L << (i / 2), i % 2));
+  }
+  prepare(ObIntType, keys);
+  for (int64_t i = 0; i < 120; ++i) {
+    check_all(keys.at(i), false);
+    check_all(Key(keys.at(i).c1_ + 1, 0), false);
+    check_all(Key(keys.at(i).c1_, 2), false);
+  }
+
+  // extreme values at both ends
+  keys.clear();
+  keys.push_back(Key(INT64_MIN, 0));
+  for (int64_t i = 1; i < 99; ++i) {
+    keys.push_back(Key(i, 0));
+  }
+  keys.push_back(Key(INT64_MAX, 0));
+  prepare(ObIntType, keys);
+  for (int64_t i = 0; i < 100; ++i) {
+    check_all(keys.at(i), false);
+  }
+  check_all(Key(INT64_MIN + 1, 0), false);
+  check_all(Key(INT64_MAX - 1, 0), false);
+  check_all(Key(1000, 0), false);
+}
+
+TEST_F(TestMicroBlockGetReader, unsigned_and_datetime)
+{
+  std::vector<Key> keys;
+  // unsigned keys crossing the sign bit of int64
+  const uint64_t base = (1ULL << 63) - 50;
+  for (int64_t i = 0; i < 100; ++i) {
+    keys.push_back(Key(static_cast<int64_t>(base + i), 0));
+  }
+  prepare(ObUInt64Type, keys);
+  for (int64_t i = -1; i <= 100; ++i) {
+    check_all(Key(static_cast<int64_t>(base + i), 0), i < 0 || i >= 100);
+  }
+  check_all(Key(0, 0), true);
+  check_all(Key(static_cast<int64_t>(UINT64_MAX), 0), true);
+
+  keys.clear();
+  const int64_t usec = 1700000000L * 1000000L;
+  for (int64_t i = 0; i < 100; ++i) {
+    keys.push_back(Key(usec + i * 1000000L, 0));
+  }
+  prepare(ObDateTimeType, keys);
+  for (int64_t i = 0; i < 100; ++i) {
+    check_all(keys.at(i), false);
+    check_all(Key(keys.at(i).c1_ + 1, 0), false);
+  }
+}
+
+TEST_F(TestMicroBlockGetReader, out_of_range)
+{
+  std::vector<Key> keys;
+  for (int64_t i = 0; i < 100; ++i) {
+    keys.push_back(Key(100 + i, 0));
+  }
+  prepare(ObIntType, keys);
+  // the first column out of the block is searched as before
+  check_all(Key(99, 0), true);
+  check_all(Key(200, 0), true);
+  check_all(Key(INT64_MIN, 0), true);
+  check_all(Key(INT64_MAX, 0), true);
+  // the first column at the bounds but the whole rowkey out of the block
+  check_all(Key(100, -1), false);
+  check_all(Key(199, 1), false);
+}
+
+TEST_F(TestMicroBlockGetReader, binary_search_fallback)
+{
+  std::vector<Key> keys;
+  // too few rows
+  for (int64_t i = 0; i < 31; ++i) {
+    keys.push_back(Key(i * 3, 0));
+  }
+  prepare(ObIntType, keys);
+  for (int64_t i = -1; i <= 93; ++i) {
+    check_all(Key(i, 0), true);
+  }
+  keys.push_back(Key(93, 0));
+  prepare(ObIntType, keys);
+  for (int64_t i = 0; i <= 93; ++i) {
+    check_all(Key(i, 0), false);
+  }
+
+  // the first column is the same in all rows
+  keys.clear();
+  for (int64_t i = 0; i < 100; ++i) {
+    keys.push_back(Key(7, i));
+  }
+  prepare(ObIntType, keys);
+  for (int64_t i = -1; i <= 100; ++i) {
+    check_all(Key(7, i), true);
+  }
+
+  // null first column in the first row
+  keys.clear();
+  for (int64_t i = 0; i < 100; ++i) {
+    keys.push_back(Key(i, 0));
+  }
+  prepare(ObIntType, keys, true/*first_null*/);
+  for (int64_t i = 0; i < 100; ++i) {
+    check_all(Key(i, 0), true);
+  }
+
+  // not an integer column
+  prepare(ObVarcharType, keys);
+  for (int64_t i = 0; i <= 100; ++i) {
+    check_all(Key(i, 0), true);
+  }
+}
+
+TEST_F(TestMicroBlockGetReader, null_rowkey)
+{
+  std::vector<Key> keys;
+  for (int64_t i = 0; i < 100; ++i) {
+    keys.push_back(Key(i, 0));
+  }
+  prepare(ObIntType, keys);
+  ObStorageDatum datums[ROWKEY_CNT];
+  ObDatumRowkey rowkey;
+  datums[0].set_null();
+  datums[1].set_int(0);
+  ASSERT_EQ(OB_SUCCESS, rowkey.assign(datums, ROWKEY_CNT));
+  ObMicroBlockGetReader reader;
+  int64_t begin_idx = -1;
+  int64_t end_idx = -1;
+  bool end_equal = false;
+  ASSERT_EQ(OB_SUCCESS, reader.inner_init(block_, read_info_, rowkey));
+  ASSERT_EQ(OB_SUCCESS, reader.locate_range_by_interpolation(rowkey, begin_idx, end_idx, end_equal));
+  ASSERT_EQ(0, begin_idx);
+  ASSERT_EQ(100, end_idx);
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, READ_COLUMN_CNT));
+  ASSERT_EQ(OB_BEYOND_THE_RANGE, reader.get_row(block_, rowkey, read_info_, row));
+}
+
+}//end namespace unittest
+}//end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_micro_block_get_reader.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
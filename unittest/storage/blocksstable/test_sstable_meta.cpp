@@ -809,6 +809,58 @@ TEST_F(TestSSTableMeta, test_empty_sstable_serialize_and_deserialize)
   free(buf);
 }
 
+TEST_F(TestSSTableMeta, test_column_ndv_sketch_serialize_and_deserialize)
+{
+  // without ndv sketch, the meta keeps the V1 format
+  ObSSTableMeta sstable_meta;
+  ASSERT_EQ(OB_SUCCESS, sstable_meta.init(param_, allocator_));
+  ASSERT_TRUE(sstable_meta.get_column_ndv_sketch().is_empty());
+  ASSERT_EQ(ObSSTableMeta::SSTABLE_META_VERSION, sstable_meta.get_meta_version());
+  int64_t pos = 0;
+  int64_t version = 0;
+  const int64_t buf_len = sstable_meta.get_serialize_size();
+  char *buf = static_cast<char *>(allocator_.alloc(buf_len));
+  ASSERT_NE(nullptr, buf);
+  ASSERT_EQ(OB_SUCCESS, sstable_meta.serialize(buf, buf_len, pos));
+  ASSERT_EQ(buf_len, pos);
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, serialization::decode(buf, buf_len, pos, version));
+  ASSERT_EQ(ObSSTableMeta::SSTABLE_META_VERSION, version);
+  ObSSTableMeta tmp_meta;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, tmp_meta.deserialize(allocator_, buf, buf_len, pos));
+  ASSERT_EQ(buf_len, pos);
+  ASSERT_TRUE(tmp_meta.get_column_ndv_sketch().is_empty());
+
+  // with ndv sketch, the meta is upgraded to V2
+  ASSERT_EQ(OB_SUCCESS, param_.column_ndv_sketch_.reserve(allocator_, 2));
+  param_.column_ndv_sketch_.column_ids_[0] = 16;
+  param_.column_ndv_sketch_.column_ids_[1] = 17;
+  ObColumnNdvSketch::add_hash(param_.column_ndv_sketch_.get_registers(1), 1UL << 40);
+  ObSSTableMeta sketch_meta;
+  ASSERT_EQ(OB_SUCCESS, sketch_meta.init(param_, allocator_));
+  ASSERT_EQ(ObSSTableMeta::SSTABLE_META_VERSION_V2, sketch_meta.get_meta_version());
+  const int64_t sketch_buf_len = sketch_meta.get_serialize_size();
+  ASSERT_EQ(buf_len + param_.column_ndv_sketch_.get_serialize_size(), sketch_buf_len);
+  char *sketch_buf = static_cast<char *>(allocator_.alloc(sketch_buf_len));
+  ASSERT_NE(nullptr, sketch_buf);
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, sketch_meta.serialize(sketch_buf, sketch_buf_len, pos));
+  ASSERT_EQ(sketch_buf_len, pos);
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, serialization::decode(sketch_buf, sketch_buf_len, pos, version));
+  ASSERT_EQ(ObSSTableMeta::SSTABLE_META_VERSION_V2, version);
+  ObSSTableMeta tmp_sketch_meta;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, tmp_sketch_meta.deserialize(allocator_, sketch_buf, sketch_buf_len, pos));
+  ASSERT_EQ(sketch_buf_len, pos);
+  const ObColumnNdvSketch &sketch = tmp_sketch_meta.get_column_ndv_sketch();
+  ASSERT_EQ(2, sketch.count_);
+  ASSERT_EQ(1, sketch.find_column(17));
+  ASSERT_EQ(0, MEMCMP(param_.column_ndv_sketch_.registers_, sketch.registers_, ObColumnNdvSketch::NUM_REGISTERS * 2));
+  param_.column_ndv_sketch_.reset();
+}
+
 TEST_F(TestSSTableMeta, test_sstable_deep_copy)
 {
   ObSSTable full_sstable;
@@ -34,6 +34,7 @@
 #include "storage/schema_utils.h"
 #include "storage/tablet/ob_table_store_util.h"
 #include "storage/column_store/ob_co_sstable_rows_filter.h"
+#include "storage/column_store/ob_co_sstable_row_scanner.h"
 
 namespace oceanbase
 {
@@ -160,6 +161,7 @@ public:
   void init_multi_white_and_black_filter_case_one();
   void init_multi_white_and_black_filter_case_two();
   void reset_filter();
+  void fill_result_bitmap(const ObCSRowId start, const int64_t row_count, const int64_t popcnt);
   ObPushdownFilterExecutor* create_physical_filter(
       const ObSEArray<uint32_t, 4> &_cg_idxes,
       bool is_white);
@@ -448,6 +450,24 @@ void TestCOSSTableRowsFilter::reset_filter()
   co_filter_.reset();
 }
 
+// simulate the result of one filter window, the first popcnt rows in scan order survive
+void TestCOSSTableRowsFilter::fill_result_bitmap(
+    const ObCSRowId start,
+    const int64_t row_count,
+    const int64_t popcnt)
+{
+  const bool is_reverse = context_.query_flag_.is_reverse_scan();
+  ObCGBitmap *bitmap = co_filter_.bitmap_buffer_[0];
+  ASSERT_NE(nullptr, bitmap);
+  ASSERT_EQ(OB_SUCCESS, bitmap->switch_context(row_count, is_reverse));
+  bitmap->reuse(is_reverse ? start - row_count + 1 : start, false);
+  for (int64_t i = 0; i < popcnt; ++i) {
+    ASSERT_EQ(OB_SUCCESS, bitmap->set(is_reverse ? start - i : start + i));
+  }
+  ASSERT_EQ(popcnt, bitmap->popcnt());
+  ASSERT_EQ(row_count, bitmap->size());
+}
+
 TEST_F(TestCOSSTableRowsFilter, co_sstable_rows_filter_test_init)
 {
   int ret = OB_SUCCESS;
@@ -564,6 +584,92 @@ TEST_F(TestCOSSTableRowsFilter, co_sstable_rows_filter_test_rewrite_filter_case_
   reset_filter();
 }
 
+TEST_F(TestCOSSTableRowsFilter, co_sstable_rows_filter_test_adjust_filter_window)
+{
+  const int64_t batch_size = 256;
+  const int64_t max_window_size = ObCOSSTableRowsFilter::MAX_FILTER_WINDOW_SIZE;
+  init_all();
+  init_single_white_filter();
+  co_filter_.batch_size_ = batch_size;
+
+  // no result bitmap yet
+  co_filter_.filter_window_size_ = batch_size * 2;
+  co_filter_.adjust_batch_size();
+  ASSERT_EQ(batch_size, co_filter_.get_filter_window_size());
+
+  for (int64_t round = 0; round < 2; ++round) {
+    const bool is_reverse = 1 == round;
+    if (is_reverse) {
+      reset_filter();
+      context_.query_flag_.scan_order_ = ObQueryFlag::Reverse;
+      init_single_white_filter();
+      co_filter_.batch_size_ = batch_size;
+    }
+    ASSERT_EQ(OB_SUCCESS, co_filter_.rewrite_filter());
+    ASSERT_EQ(1, co_filter_.bitmap_buffer_.count());
+    co_filter_.filter_window_size_ = batch_size;
+    // scan over several windows, forward from row 0 or backward from the last row
+    ObCSRowId cur = is_reverse ? 10 * max_window_size : 0;
+
+    // selective filter widens the window up to the cap
+    int64_t expect_window_size = batch_size;
+    while (expect_window_size < max_window_size) {
+      const int64_t window_size = co_filter_.get_filter_window_size();
+      fill_result_bitmap(cur, window_size, 1);
+      cur = is_reverse ? cur - window_size : cur + window_size;
+      co_filter_.adjust_batch_size();
+      expect_window_size = MIN(expect_window_size * 2, max_window_size);
+      ASSERT_EQ(expect_window_size, co_filter_.get_filter_window_size());
+    }
+    fill_result_bitmap(cur, max_window_size, 0);
+    cur = is_reverse ? cur - max_window_size : cur + max_window_size;
+    co_filter_.adjust_batch_size();
+    ASSERT_EQ(max_window_size, co_filter_.get_filter_window_size());
+
+    // tail of the range says nothing about the selectivity
+    fill_result_bitmap(cur, batch_size, batch_size);
+    co_filter_.adjust_batch_size();
+    ASSERT_EQ(max_window_size, co_filter_.get_filter_window_size());
+
+    // the reverse scanner takes the widened window as group size, clamped by the range end
+    ObCOSSTableRowScanner row_scanner;
+    int64_t group_size = 0;
+    row_scanner.rows_filter_ = &co_filter_;
+    row_scanner.batch_size_ = batch_size;
+    row_scanner.reverse_scan_ = is_reverse;
+    row_scanner.end_ = is_reverse ? 0 : 10 * max_window_size;
+    ASSERT_EQ(OB_SUCCESS, row_scanner.get_next_group_size(cur, group_size));
+    ASSERT_EQ(max_window_size, group_size);
+    ASSERT_EQ(OB_SUCCESS, row_scanner.get_next_group_size(is_reverse ? 10 : row_scanner.end_ - 10, group_size));
+    ASSERT_EQ(11, group_size);
+    row_scanner.rows_filter_ = nullptr;
+
+    // non selective filter falls back to the batch size at once
+    fill_result_bitmap(cur, max_window_size, max_window_size / 2);
+    co_filter_.adjust_batch_size();
+    ASSERT_EQ(batch_size, co_filter_.get_filter_window_size());
+
+    // never widen under limit
+    ObLimitParam limit_param;
+    limit_param.limit_ = 10;
+    context_.limit_param_ = &limit_param;
+    fill_result_bitmap(cur, batch_size, 0);
+    co_filter_.adjust_batch_size();
+    ASSERT_EQ(batch_size, co_filter_.get_filter_window_size());
+    context_.limit_param_ = nullptr;
+
+    // a rowsets size beyond the cap is kept as the window
+    co_filter_.batch_size_ = max_window_size * 2;
+    co_filter_.filter_window_size_ = max_window_size * 2;
+    fill_result_bitmap(cur, max_window_size * 2, 1);
+    co_filter_.adjust_batch_size();
+    ASSERT_EQ(max_window_size * 2, co_filter_.get_filter_window_size());
+    co_filter_.batch_size_ = batch_size;
+  }
+  context_.query_flag_.scan_order_ = ObQueryFlag::Forward;
+  reset_filter();
+}
+
 } //namespace unittest
 } //namespace oceanbase
 
@@ -0,0 +1,407 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+
+#define USING_LOG_PREFIX STORAGE
+#define protected public
+#define private public
+
+#include "storage/blocksstable/ob_column_ndv_sketch.h"
+#include "storage/blocksstable/ob_datum_row.h"
+#include "storage/compaction/ob_column_ndv_sketch_calculator.h"
+#include "sql/engine/expr/ob_expr_estimate_ndv.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+using namespace compaction;
+using namespace share::schema;
+
+namespace unittest
+{
+
+// columns of the merged rows: c1(rowkey), trans version, sql sequence, c2 int, c3 varchar, c4 longtext
+const int64_t COLUMN_CNT = 6;
+const int64_t SKETCH_COLUMN_CNT = 3;
+const uint64_t C1_ID = 16;
+const uint64_t C2_ID = 17;
+const uint64_t C3_ID = 18;
+const uint64_t C4_ID = 19;
+// 1024 registers give a standard error about 1.04 / sqrt(1024) = 3.25%
+const double MAX_ERROR_RATIO = 0.1;
+
+class TestColumnNdvSketch : public ::testing::Test
+{
+public:
+  TestColumnNdvSketch() : allocator_("TestNdvSketch") {}
+  virtual void SetUp() override
+  {
+    ObColDesc col_desc;
+    col_desc.col_id_ = C1_ID;
+    col_desc.col_type_.set_int();
+    ASSERT_EQ(OB_SUCCESS, col_descs_.push_back(col_desc));
+    col_desc.col_id_ = OB_HIDDEN_TRANS_VERSION_COLUMN_ID;
+    ASSERT_EQ(OB_SUCCESS, col_descs_.push_back(col_desc));
+    col_desc.col_id_ = OB_HIDDEN_SQL_SEQUENCE_COLUMN_ID;
+    ASSERT_EQ(OB_SUCCESS, col_descs_.push_back(col_desc));
+    col_desc.col_id_ = C2_ID;
+    ASSERT_EQ(OB_SUCCESS, col_descs_.push_back(col_desc));
+    col_desc.col_id_ = C3_ID;
+    col_desc.col_type_.set_varchar();
+    col_desc.col_type_.set_collation_type(CS_TYPE_UTF8MB4_BIN);
+    ASSERT_EQ(OB_SUCCESS, col_descs_.push_back(col_desc));
+    col_desc.col_id_ = C4_ID;
+    col_desc.col_type_.set_type(ObLongTextType);
+    col_desc.col_type_.set_collation_type(CS_TYPE_UTF8MB4_BIN);
+    ASSERT_EQ(OB_SUCCESS, col_descs_.push_back(col_desc));
+    ASSERT_EQ(OB_SUCCESS, row_.init(allocator_, COLUMN_CNT));
+  }
+  virtual void TearDown() override
+  {
+    row_.reset();
+    col_descs_.reset();
+    allocator_.reset();
+  }
+  // c1 = pk, c2 = c2_val, c3 = string of c2_val, null when c2_val < 0
+  void add_row(ObColumnNdvSketchCalculator &calculator, const int64_t pk, const int64_t c2_val)
+  {
+    row_.storage_datums_[0].set_int(pk);
+    row_.storage_datums_[1].set_int(-1);
+    row_.storage_datums_[2].set_int(0);
+    if (c2_val < 0) {
+      row_.storage_datums_[3].set_null();
+      row_.storage_datums_[4].set_null();
+    } else {
+      int64_t len = snprintf(str_buf_, sizeof(str_buf_), "v%ld", c2_val);
+      row_.storage_datums_[3].set_int(c2_val);
+      row_.storage_datums_[4].set_string(str_buf_, static_cast<int32_t>(len));
+    }
+    row_.storage_datums_[5].set_nop();
+    ASSERT_EQ(OB_SUCCESS, calculator.add_row(row_));
+  }
+  static double estimate(const ObColumnNdvSketch &sketch, const uint64_t column_id)
+  {
+    double ndv = 0;
+    const int64_t idx = sketch.find_column(column_id);
+    EXPECT_LE(0, idx);
+    if (idx >= 0) {
+      ObString bitmap(ObColumnNdvSketch::NUM_REGISTERS, reinterpret_cast<char *>(sketch.get_registers(idx)));
+      EXPECT_EQ(OB_SUCCESS, sql::ObExprEstimateNdv::llc_estimate_ndv(ndv, bitmap));
+    }
+    return ndv;
+  }
+  static void check_ndv(const ObColumnNdvSketch &sketch, const uint64_t column_id, const int64_t real_ndv)
+  {
+    const double ndv = estimate(sketch, column_id);
+    EXPECT_GE(real_ndv * MAX_ERROR_RATIO, std::abs(ndv - real_ndv)) << "column_id=" << column_id << " ndv=" << ndv;
+  }
+  static bool is_zero(const uint8_t *registers)
+  {
+    bool zero = true;
+    for (int64_t i = 0; zero && i < ObColumnNdvSketch::NUM_REGISTERS; ++i) {
+      zero = 0 == registers[i];
+    }
+    return zero;
+  }
+protected:
+  ObArenaAllocator allocator_;
+  ObSEArray<ObColDesc, COLUMN_CNT> col_descs_;
+  ObDatumRow row_;
+  char str_buf_[32];
+};
+
+TEST_F(TestColumnNdvSketch, sketch)
+{
+  ObColumnNdvSketch sketch;
+  EXPECT_TRUE(sketch.is_empty());
+  EXPECT_TRUE(sketch.is_valid());
+  EXPECT_EQ(OB_INVALID_ARGUMENT, sketch.reserve(allocator_, 0));
+  ASSERT_EQ(OB_SUCCESS, sketch.reserve(allocator_, 2));
+  EXPECT_EQ(OB_INIT_TWICE, sketch.reserve(allocator_, 2));
+  sketch.column_ids_[0] = C1_ID;
+  sketch.column_ids_[1] = C2_ID;
+  EXPECT_EQ(0, sketch.find_column(C1_ID));
+  EXPECT_EQ(1, sketch.find_column(C2_ID));
+  EXPECT_EQ(-1, sketch.find_column(C3_ID));
+
+  // registers keep the max leading zeros of each bucket
+  uint8_t *registers = sketch.get_registers(1);
+  ObColumnNdvSketch::add_hash(registers, (1UL << 63) | (1UL << 53));
+  EXPECT_EQ(1, registers[ObColumnNdvSketch::NUM_REGISTERS / 2]);
+  ObColumnNdvSketch::add_hash(registers, 1UL << 40);
+  EXPECT_EQ(14, registers[0]);
+  ObColumnNdvSketch::add_hash(registers, 1UL << 50);
+  EXPECT_EQ(14, registers[0]);
+  // the bits out of the bucket are all zero
+  ObColumnNdvSketch::add_hash(registers, 1UL << 54);
+  EXPECT_EQ(0, registers[1]);
+  EXPECT_TRUE(is_zero(sketch.get_registers(0)));
+  ObColumnNdvSketch::merge_registers(sketch.get_registers(0), registers);
+  EXPECT_EQ(0, MEMCMP(sketch.get_registers(0), registers, ObColumnNdvSketch::NUM_REGISTERS));
+
+  // serialize
+  const int64_t buf_len = sketch.get_serialize_size();
+  char *buf = static_cast<char *>(allocator_.alloc(buf_len));
+  int64_t pos = 0;
+  ASSERT_NE(nullptr, buf);
+  EXPECT_EQ(OB_BUF_NOT_ENOUGH, sketch.serialize(buf, buf_len - 1, pos));
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, sketch.serialize(buf, buf_len, pos));
+  EXPECT_EQ(buf_len, pos);
+  ObColumnNdvSketch des_sketch;
+  pos = 0;
+  EXPECT_EQ(OB_DESERIALIZE_ERROR, des_sketch.deserialize(allocator_, buf, buf_len - 1, pos));
+  des_sketch.reset();
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, des_sketch.deserialize(allocator_, buf, buf_len, pos));
+  EXPECT_EQ(buf_len, pos);
+  EXPECT_EQ(2, des_sketch.count_);
+  EXPECT_EQ(0, MEMCMP(sketch.column_ids_, des_sketch.column_ids_, sizeof(uint64_t) * 2));
+  EXPECT_EQ(0, MEMCMP(sketch.registers_, des_sketch.registers_, ObColumnNdvSketch::NUM_REGISTERS * 2));
+
+  // deep copy and assign
+  const int64_t copy_size = sketch.get_deep_copy_size();
+  char *copy_buf = static_cast<char *>(allocator_.alloc(copy_size));
+  ObColumnNdvSketch copy_sketch;
+  pos = 0;
+  EXPECT_EQ(OB_INVALID_ARGUMENT, sketch.deep_copy(copy_buf, copy_size - 1, pos, copy_sketch));
+  ASSERT_EQ(OB_SUCCESS, sketch.deep_copy(copy_buf, copy_size, pos, copy_sketch));
+  EXPECT_EQ(copy_size, pos);
+  EXPECT_EQ(0, MEMCMP(sketch.registers_, copy_sketch.registers_, ObColumnNdvSketch::NUM_REGISTERS * 2));
+  ObColumnNdvSketch assign_sketch;
+  ASSERT_EQ(OB_SUCCESS, assign_sketch.assign(allocator_, sketch));
+  EXPECT_EQ(1, assign_sketch.find_column(C2_ID));
+  EXPECT_EQ(0, MEMCMP(sketch.registers_, assign_sketch.registers_, ObColumnNdvSketch::NUM_REGISTERS * 2));
+
+  // empty sketch
+  ObColumnNdvSketch empty_sketch;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, empty_sketch.serialize(buf, buf_len, pos));
+  EXPECT_EQ(empty_sketch.get_serialize_size(), pos);
+  ObColumnNdvSketch des_empty_sketch;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, des_empty_sketch.deserialize(allocator_, buf, empty_sketch.get_serialize_size(), pos));
+  EXPECT_TRUE(des_empty_sketch.is_empty());
+  ASSERT_EQ(OB_SUCCESS, assign_sketch.assign(allocator_, empty_sketch));
+  EXPECT_TRUE(assign_sketch.is_empty());
+}
+
+TEST_F(TestColumnNdvSketch, calculator)
+{
+  ObColumnNdvSketchCalculator calculator;
+  EXPECT_EQ(OB_NOT_INIT, calculator.add_row(row_));
+  ASSERT_EQ(OB_SUCCESS, calculator.init(col_descs_));
+  EXPECT_EQ(OB_INIT_TWICE, calculator.init(col_descs_));
+  // multi version and lob columns are skipped
+  const ObColumnNdvSketch &sketch = calculator.get_sketch();
+  ASSERT_EQ(SKETCH_COLUMN_CNT, sketch.count_);
+  EXPECT_EQ(0, sketch.find_column(C1_ID));
+  EXPECT_EQ(1, sketch.find_column(C2_ID));
+  EXPECT_EQ(2, sketch.find_column(C3_ID));
+  EXPECT_EQ(-1, sketch.find_column(C4_ID));
+  EXPECT_EQ(-1, sketch.find_column(OB_HIDDEN_TRANS_VERSION_COLUMN_ID));
+
+  // nulls are not counted
+  for (int64_t i = 0; i < 100; ++i) {
+    add_row(calculator, i, -1);
+  }
+  EXPECT_FALSE(is_zero(sketch.get_registers(0)));
+  EXPECT_TRUE(is_zero(sketch.get_registers(1)));
+  EXPECT_TRUE(is_zero(sketch.get_registers(2)));
+
+  // small ndv is estimated by linear count
+  for (int64_t i = 0; i < 100; ++i) {
+    add_row(calculator, 100 + i, i % 10);
+  }
+  check_ndv(sketch, C1_ID, 200);
+  check_ndv(sketch, C2_ID, 10);
+  check_ndv(sketch, C3_ID, 10);
+
+  // large ndv
+  const int64_t ROW_CNT = 200000;
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    add_row(calculator, 200 + i, i / 4);
+  }
+  check_ndv(sketch, C1_ID, ROW_CNT + 200);
+  check_ndv(sketch, C2_ID, ROW_CNT / 4);
+  check_ndv(sketch, C3_ID, ROW_CNT / 4);
+
+  // a row with less columns is rejected
+  ObDatumRow short_row;
+  ASSERT_EQ(OB_SUCCESS, short_row.init(allocator_, 2));
+  short_row.storage_datums_[0].set_int(1);
+  short_row.storage_datums_[1].set_int(1);
+  EXPECT_EQ(OB_INVALID_ARGUMENT, calculator.add_row(short_row));
+
+  calculator.reset();
+  EXPECT_FALSE(calculator.is_inited());
+  EXPECT_TRUE(calculator.get_sketch().is_empty());
+
+  // no column to build sketch
+  ObSEArray<ObColDesc, 2> multi_version_descs;
+  ASSERT_EQ(OB_SUCCESS, multi_version_descs.push_back(col_descs_.at(1)));
+  ASSERT_EQ(OB_SUCCESS, multi_version_descs.push_back(col_descs_.at(2)));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, calculator.init(multi_version_descs));
+  EXPECT_FALSE(calculator.is_inited());
+}
+
+TEST_F(TestColumnNdvSketch, wide_table)
+{
+  // only the leading columns of a wide table are collected
+  const int64_t WIDE_COLUMN_CNT = ObColumnNdvSketch::MAX_COLUMN_CNT * 2;
+  ObSEArray<ObColDesc, 16> wide_descs;
+  ObColDesc col_desc;
+  col_desc.col_type_.set_int();
+  for (int64_t i = 0; i < WIDE_COLUMN_CNT; ++i) {
+    col_desc.col_id_ = C1_ID + i;
+    ASSERT_EQ(OB_SUCCESS, wide_descs.push_back(col_desc));
+    if (0 == i) {
+      ASSERT_EQ(OB_SUCCESS, wide_descs.push_back(col_descs_.at(1)));
+      ASSERT_EQ(OB_SUCCESS, wide_descs.push_back(col_descs_.at(2)));
+    }
+  }
+  ObColumnNdvSketchCalculator calculator;
+  ASSERT_EQ(OB_SUCCESS, calculator.init(wide_descs));
+  const ObColumnNdvSketch &sketch = calculator.get_sketch();
+  ASSERT_EQ(ObColumnNdvSketch::MAX_COLUMN_CNT, sketch.count_);
+  EXPECT_EQ(0, sketch.find_column(C1_ID));
+  EXPECT_EQ(ObColumnNdvSketch::MAX_COLUMN_CNT - 1, sketch.find_column(C1_ID + ObColumnNdvSketch::MAX_COLUMN_CNT - 1));
+  EXPECT_EQ(-1, sketch.find_column(C1_ID + ObColumnNdvSketch::MAX_COLUMN_CNT));
+
+  ObDatumRow wide_row;
+  ASSERT_EQ(OB_SUCCESS, wide_row.init(allocator_, wide_descs.count()));
+  for (int64_t r = 0; r < 1000; ++r) {
+    for (int64_t i = 0; i < wide_descs.count(); ++i) {
+      wide_row.storage_datums_[i].set_int(r);
+    }
+    ASSERT_EQ(OB_SUCCESS, calculator.add_row(wide_row));
+  }
+  check_ndv(sketch, C1_ID, 1000);
+  check_ndv(sketch, C1_ID + ObColumnNdvSketch::MAX_COLUMN_CNT - 1, 1000);
+}
+
+TEST_F(TestColumnNdvSketch, base_sketch)
+{
+  ObColumnNdvSketchCalculator base_calculator;
+  ObColumnNdvSketchCalculator calculator;
+  ASSERT_EQ(OB_SUCCESS, base_calculator.init(col_descs_));
+  ASSERT_EQ(OB_SUCCESS, calculator.init(col_descs_));
+  const int64_t ROW_CNT = 100000;
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    add_row(base_calculator, i, i);
+  }
+  // the base sstable was built before c3 was added
+  ObColumnNdvSketch base_sketch;
+  ASSERT_EQ(OB_SUCCESS, base_sketch.reserve(allocator_, 2));
+  base_sketch.column_ids_[0] = C2_ID;
+  base_sketch.column_ids_[1] = C1_ID;
+  MEMCPY(base_sketch.get_registers(0), base_calculator.get_sketch().get_registers(1), ObColumnNdvSketch::NUM_REGISTERS);
+  MEMCPY(base_sketch.get_registers(1), base_calculator.get_sketch().get_registers(0), ObColumnNdvSketch::NUM_REGISTERS);
+
+  // half of the rows overlap with the reused blocks
+  for (int64_t i = ROW_CNT / 2; i < ROW_CNT * 3 / 2; ++i) {
+    add_row(calculator, i, i);
+  }
+  ObColumnNdvSketch invalid_sketch;
+  invalid_sketch.count_ = 1;
+  EXPECT_EQ(OB_INVALID_ARGUMENT, calculator.add_base_sketch(invalid_sketch));
+  ASSERT_EQ(OB_SUCCESS, calculator.add_base_sketch(base_sketch));
+  check_ndv(calculator.get_sketch(), C1_ID, ROW_CNT * 3 / 2);
+  check_ndv(calculator.get_sketch(), C2_ID, ROW_CNT * 3 / 2);
+  EXPECT_TRUE(calculator.get_column_valid()[0]);
+  EXPECT_TRUE(calculator.get_column_valid()[1]);
+  EXPECT_FALSE(calculator.get_column_valid()[2]);
+}
+
+TEST_F(TestColumnNdvSketch, accumulator)
+{
+  const int64_t TASK_CNT = 4;
+  const int64_t ROW_CNT_PER_TASK = 50000;
+  ObColumnNdvSketchCalculator calculators[TASK_CNT];
+  ObColumnNdvSketchAccumulator accumulator;
+  ObColumnNdvSketch sketch;
+  EXPECT_EQ(OB_INVALID_ARGUMENT, accumulator.add_task_sketch(calculators[0]));
+  // each task owns a range of rowkeys, while c2 values of tasks overlap by half
+  for (int64_t t = 0; t < TASK_CNT; ++t) {
+    ASSERT_EQ(OB_SUCCESS, calculators[t].init(col_descs_));
+    for (int64_t i = 0; i < ROW_CNT_PER_TASK; ++i) {
+      add_row(calculators[t], t * ROW_CNT_PER_TASK + i, t * ROW_CNT_PER_TASK / 2 + i);
+    }
+  }
+  for (int64_t t = 0; t < TASK_CNT; ++t) {
+    ASSERT_EQ(OB_SUCCESS, accumulator.add_task_sketch(calculators[t]));
+  }
+  EXPECT_EQ(TASK_CNT, accumulator.get_task_count());
+  ASSERT_EQ(OB_SUCCESS, accumulator.get_sketch(allocator_, sketch));
+  ASSERT_EQ(SKETCH_COLUMN_CNT, sketch.count_);
+  check_ndv(sketch, C1_ID, TASK_CNT * ROW_CNT_PER_TASK);
+  check_ndv(sketch, C2_ID, (TASK_CNT + 1) * ROW_CNT_PER_TASK / 2);
+  check_ndv(sketch, C3_ID, (TASK_CNT + 1) * ROW_CNT_PER_TASK / 2);
+
+  // the merged sketch is the same as the one built by a single task
+  ObColumnNdvSketchCalculator single_calculator;
+  ASSERT_EQ(OB_SUCCESS, single_calculator.init(col_descs_));
+  for (int64_t t = 0; t < TASK_CNT; ++t) {
+    for (int64_t i = 0; i < ROW_CNT_PER_TASK; ++i) {
+      add_row(single_calculator, t * ROW_CNT_PER_TASK + i, t * ROW_CNT_PER_TASK / 2 + i);
+    }
+  }
+  EXPECT_EQ(0, MEMCMP(single_calculator.get_sketch().registers_, sketch.registers_,
+                      ObColumnNdvSketch::NUM_REGISTERS * SKETCH_COLUMN_CNT));
+
+  // a column invalid in any task is dropped
+  ObColumnNdvSketch base_sketch;
+  ASSERT_EQ(OB_SUCCESS, base_sketch.reserve(allocator_, 2));
+  base_sketch.column_ids_[0] = C1_ID;
+  base_sketch.column_ids_[1] = C3_ID;
+  ASSERT_EQ(OB_SUCCESS, calculators[0].add_base_sketch(base_sketch));
+  ASSERT_EQ(OB_SUCCESS, accumulator.add_task_sketch(calculators[0]));
+  ObColumnNdvSketch valid_sketch;
+  ASSERT_EQ(OB_SUCCESS, accumulator.get_sketch(allocator_, valid_sketch));
+  ASSERT_EQ(2, valid_sketch.count_);
+  EXPECT_EQ(-1, valid_sketch.find_column(C2_ID));
+  EXPECT_EQ(0, MEMCMP(sketch.get_registers(sketch.find_column(C3_ID)),
+                      valid_sketch.get_registers(valid_sketch.find_column(C3_ID)),
+                      ObColumnNdvSketch::NUM_REGISTERS));
+
+  // column count of tasks must match
+  ObColumnNdvSketchCalculator other_calculator;
+  ObSEArray<ObColDesc, 2> other_descs;
+  ASSERT_EQ(OB_SUCCESS, other_descs.push_back(col_descs_.at(0)));
+  ASSERT_EQ(OB_SUCCESS, other_calculator.init(other_descs));
+  EXPECT_EQ(OB_ERR_UNEXPECTED, accumulator.add_task_sketch(other_calculator));
+
+  // no sketch when every column is invalid
+  accumulator.reset();
+  ObColumnNdvSketch empty_base_sketch;
+  ASSERT_EQ(OB_SUCCESS, empty_base_sketch.reserve(allocator_, 1));
+  empty_base_sketch.column_ids_[0] = C4_ID;
+  ASSERT_EQ(OB_SUCCESS, calculators[1].add_base_sketch(empty_base_sketch));
+  ASSERT_EQ(OB_SUCCESS, accumulator.add_task_sketch(calculators[1]));
+  ASSERT_EQ(OB_SUCCESS, accumulator.get_sketch(allocator_, valid_sketch));
+  EXPECT_TRUE(valid_sketch.is_empty());
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_column_ndv_sketch.log*");
+  OB_LOGGER.set_file_name("test_column_ndv_sketch.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,328 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+#define private public
+#define protected public
+#include "storage/memtable/mvcc/ob_keybtree.h"
+
+#include "common/object/ob_object.h"
+#include "common/rowkey/ob_store_rowkey.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/random/ob_random.h"
+#include "lib/time/ob_time_utility.h"
+#include "storage/memtable/ob_memtable_key.h"
+#include "storage/memtable/mvcc/ob_mvcc_row.h"
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace oceanbase::common;
+using namespace oceanbase::keybtree;
+using namespace oceanbase::memtable;
+
+typedef ObKeyBtree<ObStoreRowkeyWrapper, ObMvccRow *> Btree;
+typedef BtreeNodeAllocator<ObStoreRowkeyWrapper, ObMvccRow *> NodeAllocator;
+typedef BtreeIterator<ObStoreRowkeyWrapper, ObMvccRow *> Iter;
+typedef KeyHeadHelper<ObStoreRowkeyWrapper> HeadHelper;
+
+const char *attr = ObModIds::TEST;
+// rowkey is (tenant_id, user_id, ts), tenant_id is the same for all rows
+constexpr int64_t ROWKEY_CNT = 3;
+constexpr int64_t TENANT_ID = 1001;
+constexpr int64_t USER_CNT = 1000;
+
+class FakeAllocator : public ObIAllocator
+{
+public:
+  void *alloc(int64_t size) override { return ob_malloc(size, attr); }
+  void *alloc(const int64_t size, const ObMemAttr &attr) override
+  {
+    UNUSED(attr);
+    return alloc(size);
+  }
+  void free(void *ptr) override { ob_free(ptr); }
+  static FakeAllocator *get_instance()
+  {
+    static FakeAllocator allocator;
+    return &allocator;
+  }
+};
+
+struct TestKey
+{
+  ObObj objs_[ROWKEY_CNT];
+  ObStoreRowkey rowkey_;
+  ObStoreRowkeyWrapper wrapper_;
+};
+
+TestKey *alloc_key(const int64_t user_id, const int64_t ts, const int64_t obj_cnt = ROWKEY_CNT)
+{
+  TestKey *key = new (ob_malloc(sizeof(TestKey), attr)) TestKey();
+  key->objs_[0].set_int(TENANT_ID);
+  key->objs_[1].set_int(user_id);
+  key->objs_[2].set_int(ts);
+  key->rowkey_.assign(key->objs_, obj_cnt);
+  key->wrapper_.rowkey_ = &key->rowkey_;
+  return key;
+}
+
+void free_keys(std::vector<TestKey *> &keys)
+{
+  for (int64_t i = 0; i < keys.size(); i++) {
+    keys.at(i)->~TestKey();
+    ob_free(keys.at(i));
+  }
+  keys.clear();
+}
+
+void gen_keys(const int64_t count, std::vector<TestKey *> &keys)
+{
+  for (int64_t i = 0; i < count; i++) {
+    keys.push_back(alloc_key(ObRandom::rand(0, USER_CNT - 1), 1700000000000000L + i * 7));
+  }
+  std::mt19937 rng(static_cast<uint32_t>(count));
+  std::shuffle(keys.begin(), keys.end(), rng);
+}
+
+ObMvccRow *get_value(const int64_t idx)
+{
+  return (ObMvccRow *)((idx + 1) << 3);
+}
+
+bool key_less(const TestKey *l, const TestKey *r)
+{
+  return l->rowkey_.compare(r->rowkey_) < 0;
+}
+
+TEST(TestKeyBtreeKeyHead, head_order)
+{
+  std::vector<TestKey *> keys;
+  gen_keys(10000, keys);
+  keys.push_back(alloc_key(0, INT64_MIN));
+  keys.push_back(alloc_key(USER_CNT, INT64_MAX));
+  keys.push_back(alloc_key(1, 0, 2 /*obj_cnt*/));
+  std::sort(keys.begin(), keys.end(), key_less);
+  TestKey *min_key = alloc_key(0, 0);
+  TestKey *max_key = alloc_key(0, 0);
+  min_key->objs_[0].set_min_value();
+  max_key->objs_[0].set_max_value();
+  keys.insert(keys.begin(), min_key);
+  keys.push_back(max_key);
+
+  // the prefix of whole keys is tenant_id, the prefix of one user is (tenant_id, user_id)
+  const int64_t begin = keys.size() / 3;
+  const int64_t end = begin + 2;
+  for (int64_t idx = 0; idx < 2; idx++) {
+    const ObStoreRowkeyWrapper &first = keys.at(0 == idx ? 1 : begin)->wrapper_;
+    const ObStoreRowkeyWrapper &last = keys.at(0 == idx ? keys.size() - 2 : end)->wrapper_;
+    const int64_t prefix_cnt = HeadHelper::get_prefix_cnt(first, last);
+    ASSERT_LE(1, prefix_cnt);
+    uint64_t prev_head = 0;
+    for (int64_t i = 0; i < keys.size(); i++) {
+      uint64_t head = 0;
+      ASSERT_TRUE(HeadHelper::get_head(keys.at(i)->wrapper_, first, prefix_cnt, head));
+      ASSERT_LE(prev_head, head);
+      prev_head = head;
+    }
+  }
+  ASSERT_EQ(2, HeadHelper::get_prefix_cnt(keys.at(begin)->wrapper_, keys.at(begin)->wrapper_));
+
+  // null can not be normalized
+  uint64_t head = 0;
+  TestKey *null_key = alloc_key(0, 0);
+  null_key->objs_[1].set_null();
+  ASSERT_FALSE(HeadHelper::get_head(null_key->wrapper_, keys.at(begin)->wrapper_, 1, head));
+  keys.push_back(null_key);
+  free_keys(keys);
+}
+
+void check_tree(Btree &btree, std::vector<TestKey *> &keys)
+{
+  ObMvccRow *val = nullptr;
+  for (int64_t i = 0; i < keys.size(); i++) {
+    ASSERT_EQ(OB_SUCCESS, btree.get(keys.at(i)->wrapper_, val));
+    ASSERT_EQ(get_value(i), val);
+  }
+  TestKey *not_exist = alloc_key(USER_CNT / 2, 1);
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, btree.get(not_exist->wrapper_, val));
+  ob_free(not_exist);
+
+  std::vector<TestKey *> sorted(keys);
+  std::sort(sorted.begin(), sorted.end(), key_less);
+  // full scan
+  {
+    Iter iter;
+    ObStoreRowkeyWrapper min_key(&ObStoreRowkey::MIN_STORE_ROWKEY);
+    ObStoreRowkeyWrapper max_key(&ObStoreRowkey::MAX_STORE_ROWKEY);
+    ObStoreRowkeyWrapper key;
+    int64_t cnt = 0;
+    ASSERT_EQ(OB_SUCCESS, btree.set_key_range(iter, min_key, false, max_key, false));
+    while (OB_SUCCESS == iter.get_next(key, val)) {
+      ASSERT_EQ(0, key.get_rowkey()->compare(sorted.at(cnt)->rowkey_));
+      cnt++;
+    }
+    ASSERT_EQ(sorted.size(), cnt);
+  }
+  // scan one user by prefix keys
+  for (int64_t round = 0; round < 100; round++) {
+    const int64_t user_id = ObRandom::rand(0, USER_CNT - 1);
+    TestKey *start = alloc_key(user_id, 0, 2);
+    TestKey *end = alloc_key(user_id, 0, 2);
+    end->objs_[2].set_max_value();
+    end->rowkey_.assign(end->objs_, ROWKEY_CNT);
+    Iter iter;
+    ObStoreRowkeyWrapper key;
+    int64_t cnt = 0;
+    ASSERT_EQ(OB_SUCCESS, btree.set_key_range(iter, start->wrapper_, false, end->wrapper_, false));
+    while (OB_SUCCESS == iter.get_next(key, val)) {
+      ASSERT_EQ(user_id, key.get_rowkey()->get_obj_ptr()[1].get_int());
+      cnt++;
+    }
+    int64_t expect = 0;
+    for (int64_t i = 0; i < keys.size(); i++) {
+      expect += (user_id == keys.at(i)->objs_[1].get_int());
+    }
+    ASSERT_EQ(expect, cnt);
+    ob_free(start);
+    ob_free(end);
+  }
+}
+
+TEST(TestKeyBtreeKeyHead, node_layout)
+{
+  typedef BtreeNode<ObStoreRowkeyWrapper, ObMvccRow *> Node;
+  // key heads are not embedded, the node keeps its size without key head
+  ASSERT_EQ(8 /*next_*/ + 8 /*host_*/ + 8 /*level_ ~ lock_*/ + 8 /*index_*/
+            + NODE_KEY_COUNT * sizeof(BtreeKV<ObStoreRowkeyWrapper, ObMvccRow *>), sizeof(Node));
+  ASSERT_EQ(sizeof(Node), Node::get_alloc_size(false));
+  ASSERT_LT(sizeof(Node), Node::get_alloc_size(true));
+  for (int64_t enable = 0; enable < 2; enable++) {
+    NodeAllocator allocator(*FakeAllocator::get_instance());
+    Btree btree(allocator);
+    ASSERT_EQ(OB_SUCCESS, btree.init(1 == enable));
+    Node *node_1 = btree.alloc_node();
+    Node *node_2 = btree.alloc_node();
+    ASSERT_TRUE(OB_NOT_NULL(node_1) && OB_NOT_NULL(node_2));
+    ASSERT_EQ(1 == enable, OB_NOT_NULL(node_1->get_key_head()));
+    ASSERT_EQ(1 == enable, OB_NOT_NULL(node_2->get_key_head()));
+    // reset keeps the key head slot
+    node_1->reset();
+    ASSERT_EQ(1 == enable, OB_NOT_NULL(node_1->get_key_head()));
+    btree.free_node(node_1);
+    btree.free_node(node_2);
+  }
+}
+
+TEST(TestKeyBtreeKeyHead, insert_and_scan)
+{
+  constexpr int64_t KEY_CNT = 200000;
+  constexpr int64_t THREAD_CNT = 4;
+  std::vector<TestKey *> keys;
+  gen_keys(KEY_CNT, keys);
+  for (int64_t enable = 0; enable < 2; enable++) {
+    NodeAllocator allocator(*FakeAllocator::get_instance());
+    Btree btree(allocator);
+    ASSERT_EQ(OB_SUCCESS, btree.init(1 == enable));
+    std::thread threads[THREAD_CNT];
+    for (int64_t t = 0; t < THREAD_CNT; t++) {
+      threads[t] = std::thread([&, t]() {
+        for (int64_t i = t; i < KEY_CNT; i += THREAD_CNT) {
+          ObMvccRow *val = get_value(i);
+          if (OB_SUCCESS != btree.insert(keys.at(i)->wrapper_, val)) {
+            ob_abort();
+          }
+        }
+      });
+    }
+    for (int64_t t = 0; t < THREAD_CNT; t++) {
+      threads[t].join();
+    }
+    check_tree(btree, keys);
+    btree.destroy(false /*is_batch_destroy*/);
+  }
+  free_keys(keys);
+}
+
+// Baseline is the binary search with full rowkey compare.
+TEST(TestKeyBtreeKeyHead, perf_compare)
+{
+  constexpr int64_t KEY_CNT = 1 << 20;
+  std::vector<TestKey *> keys;
+  gen_keys(KEY_CNT, keys);
+  for (int64_t enable = 0; enable < 2; enable++) {
+    NodeAllocator allocator(*FakeAllocator::get_instance());
+    Btree btree(allocator);
+    ASSERT_EQ(OB_SUCCESS, btree.init(1 == enable));
+    int64_t start_ts = ObTimeUtility::current_time();
+    for (int64_t i = 0; i < KEY_CNT; i++) {
+      ObMvccRow *val = get_value(i);
+      ASSERT_EQ(OB_SUCCESS, btree.insert(keys.at(i)->wrapper_, val));
+    }
+    const int64_t insert_us = ObTimeUtility::current_time() - start_ts;
+
+    start_ts = ObTimeUtility::current_time();
+    for (int64_t i = 0; i < KEY_CNT; i++) {
+      ObMvccRow *val = nullptr;
+      ASSERT_EQ(OB_SUCCESS, btree.get(keys.at(i)->wrapper_, val));
+    }
+    const int64_t get_us = ObTimeUtility::current_time() - start_ts;
+
+    constexpr int64_t SCAN_CNT = 10000;
+    int64_t row_cnt = 0;
+    start_ts = ObTimeUtility::current_time();
+    for (int64_t i = 0; i < SCAN_CNT; i++) {
+      const int64_t user_id = i % USER_CNT;
+      TestKey *start = alloc_key(user_id, 0, 2);
+      TestKey *end = alloc_key(user_id, 0, 2);
+      end->objs_[2].set_max_value();
+      end->rowkey_.assign(end->objs_, ROWKEY_CNT);
+      Iter iter;
+      ObStoreRowkeyWrapper key;
+      ObMvccRow *val = nullptr;
+      ASSERT_EQ(OB_SUCCESS, btree.set_key_range(iter, start->wrapper_, false, end->wrapper_, false));
+      // short range scan, the cost is dominated by locating the start key
+      for (int64_t j = 0; j < 10 && OB_SUCCESS == iter.get_next(key, val); j++) {
+        row_cnt++;
+      }
+      iter.reset();
+      ob_free(start);
+      ob_free(end);
+    }
+    const int64_t scan_us = ObTimeUtility::current_time() - start_ts;
+    const int64_t node_size = BtreeNode<ObStoreRowkeyWrapper, ObMvccRow *>::get_alloc_size(1 == enable);
+    fprintf(stdout, "[%s] node_size=%ld insert=%.0f/s get=%.0f/s scan=%.0f/s(%ld rows)\n",
+            1 == enable ? "key head" : "baseline", node_size,
+            KEY_CNT * 1000000.0 / std::max(insert_us, 1L),
+            KEY_CNT * 1000000.0 / std::max(get_us, 1L),
+            SCAN_CNT * 1000000.0 / std::max(scan_us, 1L), row_cnt);
+    btree.destroy(false /*is_batch_destroy*/);
+  }
+  free_keys(keys);
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_keybtree_key_head.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,427 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include <gtest/gtest.h>
+#include <sys/resource.h>
+#define private public
+#define protected public
+#include "share/ob_local_device.h"
+#include "share/ob_local_uring_device.h"
+#undef private
+#undef protected
+#include "share/ob_io_device_helper.h"
+#include "lib/random/ob_random.h"
+#include "lib/time/ob_time_utility.h"
+
+#define ASSERT_SUCC(ret) ASSERT_EQ((ret), ::oceanbase::common::OB_SUCCESS)
+
+using namespace oceanbase::common;
+using namespace oceanbase::share;
+
+namespace oceanbase
+{
+namespace unittest
+{
+
+static const char *TEST_FILE_PATH = "./test_local_uring_device_file";
+static const int64_t TEST_FILE_SIZE = 64L * 1024L * 1024L; // 64MB
+static const int64_t IO_SIZE = 4096L;
+static const int64_t IO_DEPTH = 64L;
+static const int64_t PERF_IO_COUNT = 200000L;
+
+struct PerfResult
+{
+  PerfResult() : io_count_(0), cost_us_(0), cpu_us_(0) {}
+  int64_t iops() const { return cost_us_ > 0 ? io_count_ * 1000000L / cost_us_ : 0; }
+  double cpu_us_per_io() const { return io_count_ > 0 ? static_cast<double>(cpu_us_) / io_count_ : 0; }
+  TO_STRING_KV(K_(io_count), K_(cost_us), K_(cpu_us), "iops", iops(), "cpu_us_per_io", cpu_us_per_io());
+  int64_t io_count_;
+  int64_t cost_us_;
+  int64_t cpu_us_;
+};
+
+static int64_t get_process_cpu_us()
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec * 1000000L + usage.ru_utime.tv_usec
+       + usage.ru_stime.tv_sec * 1000000L + usage.ru_stime.tv_usec;
+}
+
+class TestLocalUringDevice : public ::testing::Test
+{
+public:
+  TestLocalUringDevice() : buf_(nullptr) {}
+  virtual ~TestLocalUringDevice() = default;
+  virtual void SetUp() override;
+  virtual void TearDown() override;
+  int init_device(ObLocalDevice &device);
+  // submit random aligned reads with fixed io depth and reap them in the same thread,
+  // each block read is checked against the data written by SetUp
+  int run_random_read(ObLocalDevice &device, PerfResult &result);
+  // the first bytes of each block hold its block index
+  static int64_t get_block_mark(const char *buf) { return *reinterpret_cast<const int64_t *>(buf); }
+protected:
+  ObIOFd fd_;
+  char *buf_;
+};
+
+void TestLocalUringDevice::SetUp()
+{
+  buf_ = static_cast<char *>(ob_malloc_align(IO_SIZE, IO_SIZE * IO_DEPTH, ObMemAttr(OB_SERVER_TENANT_ID, "TestUring")));
+  ASSERT_TRUE(nullptr != buf_);
+  ASSERT_SUCC(ObIODeviceLocalFileOp::open(TEST_FILE_PATH, O_CREAT | O_RDWR | O_DIRECT, 0644, fd_));
+  ASSERT_SUCC(ObIODeviceLocalFileOp::fallocate(fd_, 0, 0, TEST_FILE_SIZE));
+  // fill the file with known data, so that reads can be verified
+  const int64_t chunk_size = IO_SIZE * IO_DEPTH;
+  for (int64_t offset = 0; offset < TEST_FILE_SIZE; offset += chunk_size) {
+    for (int64_t i = 0; i < IO_DEPTH; ++i) {
+      char *block = buf_ + i * IO_SIZE;
+      MEMSET(block, 'a' + i % 26, IO_SIZE);
+      *reinterpret_cast<int64_t *>(block) = (offset + i * IO_SIZE) / IO_SIZE;
+    }
+    int64_t write_size = 0;
+    ASSERT_SUCC(ObIODeviceLocalFileOp::pwrite_impl(fd_.second_id_, buf_, chunk_size, offset, write_size));
+    ASSERT_EQ(chunk_size, write_size);
+  }
+}
+
+void TestLocalUringDevice::TearDown()
+{
+  ObIODeviceLocalFileOp::close(fd_);
+  ObIODeviceLocalFileOp::unlink(TEST_FILE_PATH);
+  if (nullptr != buf_) {
+    ob_free_align(buf_);
+    buf_ = nullptr;
+  }
+}
+
+int TestLocalUringDevice::init_device(ObLocalDevice &device)
+{
+  // no option means a device without block file, io goes to normal files
+  ObIODOpts opts;
+  opts.opts_ = nullptr;
+  opts.opt_cnt_ = 0;
+  return device.init(opts);
+}
+
+int TestLocalUringDevice::run_random_read(ObLocalDevice &device, PerfResult &result)
+{
+  int ret = OB_SUCCESS;
+  ObIOContext *io_context = nullptr;
+  ObIOEvents *io_events = nullptr;
+  ObIOCB *iocbs[IO_DEPTH];
+  int64_t block_ids[IO_DEPTH];
+  MEMSET(iocbs, 0, sizeof(iocbs));
+  MEMSET(block_ids, 0, sizeof(block_ids));
+  struct timespec timeout = {1, 0};
+  if (OB_FAIL(device.io_setup(IO_DEPTH, io_context))) {
+    LOG_WARN("io setup failed", K(ret));
+  } else if (OB_ISNULL(io_events = device.alloc_io_events(IO_DEPTH))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc io events failed", K(ret));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < IO_DEPTH; ++i) {
+    if (OB_ISNULL(iocbs[i] = device.alloc_iocb(OB_SERVER_TENANT_ID))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc iocb failed", K(ret), K(i));
+    }
+  }
+
+  const int64_t block_cnt = TEST_FILE_SIZE / IO_SIZE;
+  const int64_t start_us = ObTimeUtility::current_time();
+  const int64_t start_cpu_us = get_process_cpu_us();
+  int64_t submit_cnt = 0;
+  int64_t complete_cnt = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && i < IO_DEPTH && submit_cnt < PERF_IO_COUNT; ++i, ++submit_cnt) {
+    block_ids[i] = ObRandom::rand(0, block_cnt - 1);
+    const int64_t offset = block_ids[i] * IO_SIZE;
+    if (OB_FAIL(device.io_prepare_pread(fd_, buf_ + i * IO_SIZE, IO_SIZE, offset, iocbs[i], reinterpret_cast<void *>(i)))) {
+      LOG_WARN("prepare pread failed", K(ret), K(i));
+    } else if (OB_FAIL(device.io_submit(io_context, iocbs[i]))) {
+      LOG_WARN("submit failed", K(ret), K(i));
+    }
+  }
+  while (OB_SUCC(ret) && complete_cnt < submit_cnt) {
+    if (OB_FAIL(device.io_getevents(io_context, 1, io_events, &timeout))) {
+      LOG_WARN("get events failed", K(ret));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < io_events->get_complete_cnt(); ++i) {
+      const int64_t idx = reinterpret_cast<int64_t>(io_events->get_ith_data(i));
+      ++complete_cnt;
+      if (OB_UNLIKELY(0 != io_events->get_ith_ret_code(i) || IO_SIZE != io_events->get_ith_ret_bytes(i))) {
+        ret = OB_IO_ERROR;
+        LOG_WARN("io failed", K(ret), K(idx), "ret_code", io_events->get_ith_ret_code(i));
+      } else if (OB_UNLIKELY(block_ids[idx] != get_block_mark(buf_ + idx * IO_SIZE))) {
+        ret = OB_CHECKSUM_ERROR;
+        LOG_WARN("read wrong data", K(ret), K(idx), "block_id", block_ids[idx],
+            "mark", get_block_mark(buf_ + idx * IO_SIZE));
+      } else if (submit_cnt < PERF_IO_COUNT) {
+        block_ids[idx] = ObRandom::rand(0, block_cnt - 1);
+        const int64_t offset = block_ids[idx] * IO_SIZE;
+        if (OB_FAIL(device.io_prepare_pread(fd_, buf_ + idx * IO_SIZE, IO_SIZE, offset, iocbs[idx], reinterpret_cast<void *>(idx)))) {
+          LOG_WARN("prepare pread failed", K(ret), K(idx));
+        } else if (OB_FAIL(device.io_submit(io_context, iocbs[idx]))) {
+          LOG_WARN("submit failed", K(ret), K(idx));
+        } else {
+          ++submit_cnt;
+        }
+      }
+    }
+  }
+  result.io_count_ = complete_cnt;
+  result.cost_us_ = ObTimeUtility::current_time() - start_us;
+  result.cpu_us_ = get_process_cpu_us() - start_cpu_us;
+
+  for (int64_t i = 0; i < IO_DEPTH; ++i) {
+    if (nullptr != iocbs[i]) {
+      device.free_iocb(iocbs[i]);
+    }
+  }
+  if (nullptr != io_events) {
+    device.free_io_events(io_events);
+  }
+  if (nullptr != io_context) {
+    device.io_destroy(io_context);
+  }
+  return ret;
+}
+
+TEST_F(TestLocalUringDevice, read_write)
+{
+  ObLocalUringDevice device;
+  ASSERT_SUCC(init_device(device));
+  ObIOContext *io_context = nullptr;
+  int ret = device.io_setup(IO_DEPTH, io_context);
+  if (OB_SUCCESS != ret) {
+    LOG_WARN("io_uring is not available, skip", K(ret));
+    return;
+  }
+  ObIOEvents *io_events = device.alloc_io_events(IO_DEPTH);
+  ObIOCB *iocb = device.alloc_iocb(OB_SERVER_TENANT_ID);
+  ASSERT_TRUE(nullptr != io_events);
+  ASSERT_TRUE(nullptr != iocb);
+  ASSERT_EQ(ObIOCBType::IOCB_TYPE_LOCAL_URING, iocb->get_type());
+  struct timespec timeout = {1, 0};
+
+  // read back the data written by SetUp
+  char *read_buf = buf_ + IO_SIZE;
+  MEMSET(read_buf, 0, IO_SIZE);
+  ASSERT_SUCC(device.io_prepare_pread(fd_, read_buf, IO_SIZE, 5 * IO_SIZE, iocb, read_buf));
+  ASSERT_SUCC(device.io_submit(io_context, iocb));
+  ASSERT_SUCC(device.io_getevents(io_context, 1, io_events, &timeout));
+  ASSERT_EQ(1, io_events->get_complete_cnt());
+  ASSERT_EQ(0, io_events->get_ith_ret_code(0));
+  ASSERT_EQ(IO_SIZE, io_events->get_ith_ret_bytes(0));
+  ASSERT_EQ(5, get_block_mark(read_buf));
+  ASSERT_EQ('a' + 5, read_buf[IO_SIZE - 1]);
+
+  // overwrite a block and read it back
+  MEMSET(buf_, 'x', IO_SIZE);
+  ASSERT_SUCC(device.io_prepare_pwrite(fd_, buf_, IO_SIZE, IO_SIZE, iocb, buf_));
+  ASSERT_SUCC(device.io_submit(io_context, iocb));
+  ASSERT_SUCC(device.io_getevents(io_context, 1, io_events, &timeout));
+  ASSERT_EQ(1, io_events->get_complete_cnt());
+  ASSERT_EQ(0, io_events->get_ith_ret_code(0));
+  ASSERT_EQ(IO_SIZE, io_events->get_ith_ret_bytes(0));
+  ASSERT_EQ(buf_, io_events->get_ith_data(0));
+
+  MEMSET(read_buf, 0, IO_SIZE);
+  ASSERT_SUCC(device.io_prepare_pread(fd_, read_buf, IO_SIZE, IO_SIZE, iocb, read_buf));
+  ASSERT_SUCC(device.io_submit(io_context, iocb));
+  ASSERT_SUCC(device.io_getevents(io_context, 1, io_events, &timeout));
+  ASSERT_EQ(1, io_events->get_complete_cnt());
+  ASSERT_EQ(IO_SIZE, io_events->get_ith_ret_bytes(0));
+  ASSERT_EQ(0, MEMCMP(buf_, read_buf, IO_SIZE));
+
+  // cancel is not supported, caller should wait for the completion
+  ASSERT_EQ(OB_NOT_SUPPORTED, device.io_cancel(io_context, iocb));
+  // nothing in flight, timed wait returns without events
+  timeout.tv_sec = 0;
+  timeout.tv_nsec = 1000L * 1000L;
+  ASSERT_SUCC(device.io_getevents(io_context, 1, io_events, &timeout));
+  ASSERT_EQ(0, io_events->get_complete_cnt());
+
+  device.free_iocb(iocb);
+  device.free_io_events(io_events);
+  ASSERT_SUCC(device.io_destroy(io_context));
+  device.destroy();
+}
+
+TEST_F(TestLocalUringDevice, block_file)
+{
+  ObLocalUringDevice device;
+  ASSERT_SUCC(init_device(device));
+  ObIOContext *io_context = nullptr;
+  // io channels are set up before the block file is opened
+  int ret = device.io_setup(IO_DEPTH, io_context);
+  if (OB_SUCCESS != ret) {
+    LOG_WARN("io_uring is not available, skip", K(ret));
+    return;
+  }
+  ObLocalUringIOContext *uring_context = static_cast<ObLocalUringIOContext *>(io_context);
+  ASSERT_EQ(ObLocalUringIOContext::FIXED_FILE_UNREGISTERED, uring_context->fixed_file_state_);
+  // open the test file as block file
+  device.block_fd_ = static_cast<int>(fd_.second_id_);
+  device.block_size_ = IO_SIZE;
+  ObIOFd block_fd(&device, 1/*first_id*/, 7/*second_id, block index*/);
+  ASSERT_TRUE(block_fd.is_block_file());
+  ObIOEvents *io_events = device.alloc_io_events(IO_DEPTH);
+  ObIOCB *iocb = device.alloc_iocb(OB_SERVER_TENANT_ID);
+  ASSERT_TRUE(nullptr != io_events);
+  ASSERT_TRUE(nullptr != iocb);
+  struct timespec timeout = {1, 0};
+
+  // the first io registers the block file
+  MEMSET(buf_, 0, IO_SIZE);
+  ASSERT_SUCC(device.io_prepare_pread(block_fd, buf_, IO_SIZE, 0, iocb, buf_));
+  ASSERT_SUCC(device.io_submit(io_context, iocb));
+  ASSERT_SUCC(device.io_getevents(io_context, 1, io_events, &timeout));
+  ASSERT_EQ(1, io_events->get_complete_cnt());
+  ASSERT_EQ(0, io_events->get_ith_ret_code(0));
+  ASSERT_EQ(7, get_block_mark(buf_));
+  ASSERT_NE(ObLocalUringIOContext::FIXED_FILE_UNREGISTERED, uring_context->fixed_file_state_);
+  if (ObLocalUringIOContext::FIXED_FILE_REGISTERED == uring_context->fixed_file_state_) {
+    ASSERT_EQ(device.block_fd_, uring_context->fixed_file_fd_);
+  }
+  // write and read through the registered file
+  MEMSET(buf_, 'y', IO_SIZE);
+  ASSERT_SUCC(device.io_prepare_pwrite(block_fd, buf_, IO_SIZE, 0, iocb, buf_));
+  ASSERT_SUCC(device.io_submit(io_context, iocb));
+  ASSERT_SUCC(device.io_getevents(io_context, 1, io_events, &timeout));
+  ASSERT_EQ(1, io_events->get_complete_cnt());
+  ASSERT_EQ(0, io_events->get_ith_ret_code(0));
+  char *read_buf = buf_ + IO_SIZE;
+  MEMSET(read_buf, 0, IO_SIZE);
+  ASSERT_SUCC(device.io_prepare_pread(fd_, read_buf, IO_SIZE, 7 * IO_SIZE, iocb, read_buf));
+  ASSERT_SUCC(device.io_submit(io_context, iocb));
+  ASSERT_SUCC(device.io_getevents(io_context, 1, io_events, &timeout));
+  ASSERT_EQ(1, io_events->get_complete_cnt());
+  ASSERT_EQ(0, MEMCMP(buf_, read_buf, IO_SIZE));
+
+  device.free_iocb(iocb);
+  device.free_io_events(io_events);
+  ASSERT_SUCC(device.io_destroy(io_context));
+  // the test file is closed by TearDown
+  device.block_fd_ = 0;
+  device.destroy();
+}
+
+TEST_F(TestLocalUringDevice, fail_pending_sqes)
+{
+  ObLocalUringDevice device;
+  ASSERT_SUCC(init_device(device));
+  ObIOContext *io_context = nullptr;
+  int ret = device.io_setup(IO_DEPTH, io_context);
+  if (OB_SUCCESS != ret) {
+    LOG_WARN("io_uring is not available, skip", K(ret));
+    return;
+  }
+  ObLocalUringIOContext *uring_context = static_cast<ObLocalUringIOContext *>(io_context);
+  ObIOEvents *io_events = device.alloc_io_events(IO_DEPTH);
+  ObIOCB *iocbs[3];
+  for (int64_t i = 0; i < 3; ++i) {
+    ASSERT_TRUE(nullptr != (iocbs[i] = device.alloc_iocb(OB_SERVER_TENANT_ID)));
+    ASSERT_SUCC(device.io_prepare_pread(fd_, buf_ + i * IO_SIZE, IO_SIZE, i * IO_SIZE, iocbs[i],
+        reinterpret_cast<void *>(i + 1)));
+    // queue the sqe without submitting it, as if kernel refused the submission
+    ASSERT_SUCC(device.push_sqe_(*uring_context, *static_cast<ObLocalUringIOCB *>(iocbs[i])));
+  }
+  ASSERT_EQ(3, uring_context->to_submit_);
+  device.fail_pending_sqes_(*uring_context, EIO);
+  ASSERT_EQ(0, uring_context->to_submit_);
+  ASSERT_EQ(3, uring_context->failed_cnt_);
+  // failed sqes take up the slots of sq until reported
+  uring_context->failed_cnt_ = uring_context->sq_entries_;
+  ASSERT_EQ(OB_EAGAIN, device.push_sqe_(*uring_context, *static_cast<ObLocalUringIOCB *>(iocbs[0])));
+  uring_context->failed_cnt_ = 3;
+
+  // every pending sqe is reported as a failed event without blocking
+  struct timespec timeout = {10, 0};
+  const int64_t start_us = ObTimeUtility::current_time();
+  ASSERT_SUCC(device.io_getevents(io_context, 3, io_events, &timeout));
+  ASSERT_GT(1000L * 1000L, ObTimeUtility::current_time() - start_us);
+  ASSERT_EQ(3, io_events->get_complete_cnt());
+  for (int64_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(EIO, io_events->get_ith_ret_code(i));
+    ASSERT_EQ(0, io_events->get_ith_ret_bytes(i));
+    ASSERT_EQ(reinterpret_cast<void *>(i + 1), io_events->get_ith_data(i));
+  }
+  ASSERT_EQ(0, uring_context->failed_cnt_);
+
+  // the ring works as usual after that
+  ASSERT_SUCC(device.io_prepare_pread(fd_, buf_, IO_SIZE, 9 * IO_SIZE, iocbs[0], buf_));
+  ASSERT_SUCC(device.io_submit(io_context, iocbs[0]));
+  timeout.tv_sec = 1;
+  ASSERT_SUCC(device.io_getevents(io_context, 1, io_events, &timeout));
+  ASSERT_EQ(1, io_events->get_complete_cnt());
+  ASSERT_EQ(0, io_events->get_ith_ret_code(0));
+  ASSERT_EQ(9, get_block_mark(buf_));
+
+  for (int64_t i = 0; i < 3; ++i) {
+    device.free_iocb(iocbs[i]);
+  }
+  device.free_io_events(io_events);
+  ASSERT_SUCC(device.io_destroy(io_context));
+  device.destroy();
+}
+
+TEST_F(TestLocalUringDevice, perf_compare_with_aio)
+{
+  PerfResult aio_result;
+  PerfResult uring_result;
+  PerfResult uring_sqpoll_result;
+  {
+    ObLocalDevice device;
+    ASSERT_SUCC(init_device(device));
+    ASSERT_SUCC(run_random_read(device, aio_result));
+  }
+  {
+    ObLocalUringDevice device;
+    ASSERT_SUCC(init_device(device));
+    ObIOContext *io_context = nullptr;
+    if (OB_SUCCESS != device.io_setup(IO_DEPTH, io_context)) {
+      LOG_WARN_RET(OB_NOT_SUPPORTED, "io_uring is not available, skip");
+      return;
+    }
+    device.io_destroy(io_context);
+    ASSERT_SUCC(run_random_read(device, uring_result));
+  }
+  {
+    ObLocalUringDevice device;
+    device.set_use_sqpoll(true);
+    ASSERT_SUCC(init_device(device));
+    int ret = run_random_read(device, uring_sqpoll_result);
+    if (OB_SUCCESS != ret) {
+      // SQPOLL may need CAP_SYS_NICE on older kernels
+      LOG_WARN("io_uring sqpoll is not available", K(ret));
+    }
+  }
+  LOG_INFO("local device random read 4K perf", K(aio_result), K(uring_result), K(uring_sqpoll_result));
+  std::cout << "aio:             iops=" << aio_result.iops() << " cpu_us_per_io=" << aio_result.cpu_us_per_io() << std::endl;
+  std::cout << "io_uring:        iops=" << uring_result.iops() << " cpu_us_per_io=" << uring_result.cpu_us_per_io() << std::endl;
+  std::cout << "io_uring sqpoll: iops=" << uring_sqpoll_result.iops() << " cpu_us_per_io=" << uring_sqpoll_result.cpu_us_per_io() << std::endl;
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f ./test_local_uring_device.log*");
+  OB_LOGGER.set_file_name("test_local_uring_device.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}